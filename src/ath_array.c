@@ -18,6 +18,21 @@
  * - array = (Real ***)calloc_3d_array(nt,nr,nc,sizeof(Real));
  * - free_3d_array(array);
  *
+ * The elements of all arrays start on a 64-byte boundary, so that loops over
+ *   them can use aligned vector loads.  With OpenMP the elements of 3D arrays
+ *   are zeroed by all threads, plane by plane with the same static schedule
+ *   as the loops over k in the integrators, so on NUMA nodes each page is
+ *   first touched by (and placed close to) the thread that later updates it.
+ *
+ * With ARRAY_PADDING every row of a 3D array starts on a 64-byte boundary,
+ *   and row or plane strides that are a multiple of 4 KB are padded by one
+ *   more cache line, to avoid conflicts in the cache sets when accessing
+ *   neighbours in j or k.  Rows are then not contiguous in memory, so
+ *   array[k][j]+nc must not be assumed to be array[k][j+1].
+ *
+ * With HUGE_PAGES arrays of 2 MB or more are aligned to 2 MB and advised to
+ *   be backed by transparent huge pages, to reduce TLB misses.
+ *
  * CONTAINS PUBLIC FUNCTIONS: 
  *   - calloc_1d_array() - creates 1D array
  *   - calloc_2d_array() - creates 2D array
@@ -28,8 +43,25 @@
 /*============================================================================*/
 
 #include <stdlib.h>
+#include <string.h>
+#ifdef HUGE_PAGES
+#include <sys/mman.h>
+#endif
 #include "prototypes.h"
 
+/* alignment of the elements of all arrays, size of a huge page, and page size
+ * at which strides cause cache-set conflicts */
+#define ARRAY_ALIGN 64
+#define HUGE_PAGE_SIZE 2097152
+#define CONFLICT_STRIDE 4096
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ *   aligned_alloc_bytes() - allocates aligned (but not zeroed) memory
+ *============================================================================*/
+
+static void *aligned_alloc_bytes(size_t nbytes);
+
 /*----------------------------------------------------------------------------*/
 /*! \fn void* calloc_1d_array(size_t nc, size_t size)
  *  \brief Construct 1D array = array[nc]  */
@@ -37,11 +69,12 @@ void* calloc_1d_array(size_t nc, size_t size)
 {
   void *array;
   
-  if ((array = (void *)calloc(nc,size)) == NULL) {
+  if ((array = aligned_alloc_bytes(nc*size)) == NULL) {
     ath_error("[calloc_1d] failed to allocate memory (%d of size %d)\n",
               (int)nc,(int)size);
     return NULL;
   }
+  memset(array,0,nc*size);
   return array;
 }
 
@@ -58,12 +91,13 @@ void** calloc_2d_array(size_t nr, size_t nc, size_t size)
     return NULL;
   }
 
-  if((array[0] = (void *)calloc(nr*nc,size)) == NULL){
+  if((array[0] = aligned_alloc_bytes(nr*nc*size)) == NULL){
     ath_error("[calloc_2d] failed to allocate memory (%d X %d of size %d)\n",
               (int)nr,(int)nc,(int)size);
     free((void *)array);
     return NULL;
   }
+  memset(array[0],0,nr*nc*size);
 
   for(i=1; i<nr; i++){
     array[i] = (void *)((unsigned char *)array[0] + i*nc*size);
@@ -78,7 +112,9 @@ void** calloc_2d_array(size_t nr, size_t nc, size_t size)
 void*** calloc_3d_array(size_t nt, size_t nr, size_t nc, size_t size)
 {
   void ***array;
-  size_t i,j;
+  unsigned char *base;
+  size_t i,j,rowb,planeb;
+  long k;
 
   if((array = (void ***)calloc(nt,sizeof(void**))) == NULL){
     ath_error("[calloc_3d] failed to allocate memory for %d 1st-pointers\n",
@@ -97,22 +133,39 @@ void*** calloc_3d_array(size_t nt, size_t nr, size_t nc, size_t size)
     array[i] = (void **)((unsigned char *)array[0] + i*nr*sizeof(void*));
   }
 
-  if((array[0][0] = (void *)calloc(nt*nr*nc,size)) == NULL){
+/* Strides (in bytes) between rows and planes of elements */
+  rowb = nc*size;
+#ifdef ARRAY_PADDING
+  rowb = ((rowb + ARRAY_ALIGN - 1)/ARRAY_ALIGN)*ARRAY_ALIGN;
+  if (nr > 1 && rowb % CONFLICT_STRIDE == 0) rowb += ARRAY_ALIGN;
+#endif
+  planeb = nr*rowb;
+#ifdef ARRAY_PADDING
+  if (nt > 1 && planeb % CONFLICT_STRIDE == 0) planeb += ARRAY_ALIGN;
+#endif
+
+  if((array[0][0] = aligned_alloc_bytes(nt*planeb)) == NULL){
     ath_error("[calloc_3d] failed to alloc. memory (%d X %d X %d of size %d)\n",
               (int)nt,(int)nr,(int)nc,(int)size);
     free((void *)array[0]);
     free((void *)array);
     return NULL;
   }
+  base = (unsigned char *)array[0][0];
+
+/* Zero the elements plane by plane, so that with OpenMP each plane is first
+ * touched by the thread that updates it in the integrators */
 
-  for(j=1; j<nr; j++){
-    array[0][j] = (void **)((unsigned char *)array[0][j-1] + nc*size);
+#ifdef OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(k=0; k<(long)nt; k++){
+    memset(base + k*planeb, 0, planeb);
   }
 
-  for(i=1; i<nt; i++){
-    array[i][0] = (void **)((unsigned char *)array[i-1][0] + nr*nc*size);
-    for(j=1; j<nr; j++){
-      array[i][j] = (void **)((unsigned char *)array[i][j-1] + nc*size);
+  for(i=0; i<nt; i++){
+    for(j=0; j<nr; j++){
+      array[i][j] = (void *)(base + i*planeb + j*rowb);
     }
   }
 
@@ -149,3 +202,27 @@ void free_3d_array(void *array)
   free(ta[0]);
   free(array);
 }
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn static void *aligned_alloc_bytes(size_t nbytes)
+ *  \brief Allocates nbytes aligned to ARRAY_ALIGN (or to a huge page with
+ *   HUGE_PAGES if nbytes is large enough).  Memory is not zeroed, and is
+ *   released with free().  Returns NULL on failure. */
+
+static void *aligned_alloc_bytes(size_t nbytes)
+{
+  void *p = NULL;
+  size_t align = ARRAY_ALIGN;
+
+  if (nbytes == 0) nbytes = 1;
+#ifdef HUGE_PAGES
+  if (nbytes >= HUGE_PAGE_SIZE) align = HUGE_PAGE_SIZE;
+#endif
+  if (posix_memalign(&p, align, nbytes) != 0) return NULL;
+#if defined(HUGE_PAGES) && defined(MADV_HUGEPAGE)
+  if (nbytes >= HUGE_PAGE_SIZE) madvise(p, nbytes, MADV_HUGEPAGE);
+#endif
+
+  return p;
+}
@@ -0,0 +1,279 @@
+#include "copyright.h"
+/*============================================================================*/
+/*! \file ath_perf.c
+ *  \brief Hardware performance counters around the main hydro kernels.
+ *
+ * PURPOSE: Hardware performance counters around the main hydro kernels,
+ *   read with the Linux perf_event_open() system call.  Compiled only with
+ *   --enable-perf-counters, and active only with perf_counters=1 in the <log>
+ *   block.  Counters are read at the start and end of each call to the 3D
+ *   integrators, lr_states() and fluxes_pencil(), and the differences are
+ *   accumulated per kernel.  Calls may be nested (lr_states and fluxes are
+ *   also counted in the integrator).
+ *
+ *   The events are CPU cycles, instructions, and last-level cache misses.
+ *   Since there is no generic event for floating-point operations, a raw
+ *   event can be given with perf_fp_event (e.g. perf_fp_event = 0x01c7 for
+ *   FP_ARITH_INST_RETIRED.SCALAR_DOUBLE on recent Intel CPUs; see the output
+ *   of "perf list --details").  At the end of the run ath_perf_report()
+ *   prints, summed over all ranks, the IPC and the memory traffic estimated
+ *   as 64 bytes per LLC miss, and if an FP event was given the bytes/flop
+ *   of each kernel.  Kernels with many more bytes/flop than the machine
+ *   balance (peak bandwidth / peak flop rate) are memory-bound.
+ *
+ *   Counters measure only the thread that opened them, so with OpenMP only
+ *   calls made by thread 0 are counted.  If perf_event_open() fails (e.g. no
+ *   PMU in a VM, or kernel.perf_event_paranoid > 2), a warning is printed
+ *   and counting is turned off.
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - ath_perf_init()   - opens counters if perf_counters=1 in <log> block
+ * - ath_perf_start()  - reads counters at start of a kernel
+ * - ath_perf_stop()   - reads counters at end of a kernel and accumulates
+ * - ath_perf_report() - prints per-kernel summary and closes counters        */
+/*============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include "defs.h"
+#include "athena.h"
+#include "globals.h"
+#include "prototypes.h"
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+#ifdef PERF_COUNTERS
+#include <linux/perf_event.h>
+
+/* counters: cycles, instructions, LLC misses, and optional raw FP event */
+enum {PERF_CYC, PERF_INS, PERF_LLC, PERF_FP, NCOUNTER};
+
+/* bytes moved from memory per last-level cache miss */
+#define LINE_BYTES 64.0
+
+/* names of kernels, in the order of enum PerfKernel in athena.h */
+static const char *kernel_name[NPERF] = {"integrate_3d", "lr_states",
+  "fluxes"};
+
+static int perf_on = 0;           /* set to 1 if all counters opened */
+static int nopen = 0;             /* number of counters opened */
+static int fd[NCOUNTER];          /* file descriptors of counters */
+static double cnt_start[NPERF][NCOUNTER]; /* counts at start of kernel */
+static double cnt_sum[NPERF][NCOUNTER];   /* accumulated counts */
+static double ncall[NPERF];                /* number of calls */
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - open_counter()  - opens one counter in the group led by fd[0]
+ * - read_counters() - reads all counters in the group
+ *============================================================================*/
+
+static int open_counter(const unsigned int type, const unsigned long config,
+                        const int group_fd);
+static int read_counters(double *cnt);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_perf_init(void)
+ *  \brief Opens the counters as one group if perf_counters=1 in <log>
+ *   block, so that all are scheduled on the PMU together and read with a
+ *   single system call. */
+void ath_perf_init(void)
+{
+  int n, m;
+  char *fp_event;
+  unsigned long fp_config = 0;
+
+  perf_on = 0;
+  nopen = 0;
+  if (par_geti_def("log","perf_counters",0) == 0) return;
+
+  if (par_exist("log","perf_fp_event")) {
+    fp_event = par_gets("log","perf_fp_event");
+    fp_config = strtoul(fp_event, NULL, 0);
+    free(fp_event);
+  }
+
+  fd[PERF_CYC] = open_counter(PERF_TYPE_HARDWARE,PERF_COUNT_HW_CPU_CYCLES,-1);
+  if (fd[PERF_CYC] < 0) {
+    ath_perr(-1,"[ath_perf_init]: perf_event_open failed, counters off\n");
+    return;
+  }
+  fd[PERF_INS] = open_counter(PERF_TYPE_HARDWARE,PERF_COUNT_HW_INSTRUCTIONS,
+                              fd[PERF_CYC]);
+  fd[PERF_LLC] = open_counter(PERF_TYPE_HARDWARE,PERF_COUNT_HW_CACHE_MISSES,
+                              fd[PERF_CYC]);
+  if (fd[PERF_INS] < 0 || fd[PERF_LLC] < 0) {
+    ath_perr(-1,"[ath_perf_init]: perf_event_open failed, counters off\n");
+    for (n=0; n<PERF_FP; n++) if (fd[n] >= 0) close(fd[n]);
+    return;
+  }
+  nopen = PERF_FP;
+
+  if (fp_config != 0) {
+    fd[PERF_FP] = open_counter(PERF_TYPE_RAW, fp_config, fd[PERF_CYC]);
+    if (fd[PERF_FP] >= 0)
+      nopen++;
+    else
+      ath_perr(-1,"[ath_perf_init]: cannot open FP event 0x%lx\n",fp_config);
+  }
+
+  for (n=0; n<NPERF; n++) {
+    ncall[n] = 0.0;
+    for (m=0; m<NCOUNTER; m++) cnt_sum[n][m] = 0.0;
+  }
+
+  ioctl(fd[PERF_CYC], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fd[PERF_CYC], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  perf_on = 1;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_perf_start(const enum PerfKernel k)
+ *  \brief Reads counters at start of kernel k. */
+void ath_perf_start(const enum PerfKernel k)
+{
+  if (!perf_on) return;
+#ifdef OPENMP
+  if (omp_get_thread_num() != 0) return;
+#endif
+
+  read_counters(cnt_start[k]);
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_perf_stop(const enum PerfKernel k)
+ *  \brief Reads counters at end of kernel k and adds differences to sums. */
+void ath_perf_stop(const enum PerfKernel k)
+{
+  double cnt[NCOUNTER];
+  int m;
+
+  if (!perf_on) return;
+#ifdef OPENMP
+  if (omp_get_thread_num() != 0) return;
+#endif
+
+  if (read_counters(cnt) != 0) return;
+  for (m=0; m<nopen; m++) cnt_sum[k][m] += cnt[m] - cnt_start[k][m];
+  ncall[k] += 1.0;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_perf_report(void)
+ *  \brief Prints counts summed over ranks, IPC, estimated memory traffic
+ *   and bytes/flop for each kernel, then closes counters.  Must be called by
+ *   all ranks (contains collective MPI operations) if counters are used. */
+void ath_perf_report(void)
+{
+  double my_cnt[NPERF*(NCOUNTER+1)], cnt[NPERF*(NCOUNTER+1)];
+  double *c, bytes;
+  int n, m, my_nopen, all_nopen;
+#ifdef MPI_PARALLEL
+  int ierr;
+#endif
+
+  my_nopen = perf_on ? nopen : 0;
+#ifdef MPI_PARALLEL
+  ierr = MPI_Allreduce(&my_nopen, &all_nopen, 1, MPI_INT, MPI_MIN,
+                       MPI_COMM_WORLD);
+#else
+  all_nopen = my_nopen;
+#endif
+  if (all_nopen == 0) {
+    if (perf_on) ath_perr(-1,"[ath_perf_report]: counters off on some rank\n");
+    goto on_close;
+  }
+
+  for (n=0; n<NPERF; n++) {
+    for (m=0; m<NCOUNTER; m++) my_cnt[n*(NCOUNTER+1)+m] = cnt_sum[n][m];
+    my_cnt[n*(NCOUNTER+1)+NCOUNTER] = ncall[n];
+  }
+#ifdef MPI_PARALLEL
+  ierr = MPI_Reduce(my_cnt, cnt, NPERF*(NCOUNTER+1), MPI_DOUBLE, MPI_SUM, 0,
+                    MPI_COMM_WORLD);
+#else
+  for (n=0; n<NPERF*(NCOUNTER+1); n++) cnt[n] = my_cnt[n];
+#endif
+
+  ath_pout(0,"\nHardware counters per kernel (summed over ranks):\n");
+  ath_pout(0,"  %-12s %9s %11s %11s %6s %11s %11s %11s %9s\n","kernel",
+           "calls","cycles","instr","IPC","LLC miss","bytes","FP ops",
+           "bytes/FP");
+  for (n=0; n<NPERF; n++) {
+    c = &(cnt[n*(NCOUNTER+1)]);
+    if (c[NCOUNTER] == 0.0) continue;
+    bytes = LINE_BYTES*c[PERF_LLC];
+    ath_pout(0,"  %-12s %9.3e %11.4e %11.4e %6.2f %11.4e %11.4e",
+             kernel_name[n],c[NCOUNTER],c[PERF_CYC],c[PERF_INS],
+             (c[PERF_CYC] > 0.0 ? c[PERF_INS]/c[PERF_CYC] : 0.0),
+             c[PERF_LLC],bytes);
+    if (all_nopen > PERF_FP && c[PERF_FP] > 0.0)
+      ath_pout(0," %11.4e %9.3f\n",c[PERF_FP],bytes/c[PERF_FP]);
+    else
+      ath_pout(0," %11s %9s\n","n/a","n/a");
+  }
+
+on_close:
+  if (perf_on) {
+    ioctl(fd[PERF_CYC], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (m=0; m<nopen; m++) close(fd[m]);
+  }
+  perf_on = 0;
+  nopen = 0;
+
+  return;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int open_counter(const unsigned int type,
+ *                              const unsigned long config, const int group_fd)
+ *  \brief Opens a user-space counter for the calling thread, as the disabled
+ *   leader of a new group if group_fd=-1.  Returns the file descriptor, or -1
+ *   on failure. */
+static int open_counter(const unsigned int type, const unsigned long config,
+                        const int group_fd)
+{
+  struct perf_event_attr pe;
+
+  memset(&pe, 0, sizeof(struct perf_event_attr));
+  pe.type = type;
+  pe.size = sizeof(struct perf_event_attr);
+  pe.config = config;
+  pe.disabled = (group_fd == -1) ? 1 : 0;
+  pe.exclude_kernel = 1;
+  pe.exclude_hv = 1;
+  pe.read_format = PERF_FORMAT_GROUP;
+
+  return (int)syscall(__NR_perf_event_open, &pe, 0, -1, group_fd, 0);
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int read_counters(double *cnt)
+ *  \brief Reads the nopen counters of the group into cnt[].  Returns 0 on
+ *   success. */
+static int read_counters(double *cnt)
+{
+  unsigned long long buf[1+NCOUNTER];
+  int m;
+
+  if (read(fd[PERF_CYC], buf, sizeof(buf)) < (ssize_t)(sizeof(buf[0])*2))
+    return 1;
+  for (m=0; m<nopen; m++) cnt[m] = (double)buf[1+m];
+
+  return 0;
+}
+
+#endif /* PERF_COUNTERS */
@@ -0,0 +1,206 @@
+#include "copyright.h"
+/*============================================================================*/
+/*! \file ath_timer.c
+ *  \brief Wall-clock timers for the phases of the main integration loop.
+ *
+ * PURPOSE: Wall-clock timers for the phases of the main integration loop.
+ *   main() brackets each phase (integrator, boundary values, SMR restriction
+ *   and prolongation, self-gravity, new_dt, diffusion, cooling, particles and
+ *   data output) with ath_timer_start()/ath_timer_stop().  The cost is two
+ *   clock reads per call, which is negligible compared to any phase.  Each
+ *   phase is also recorded as an event by the tracer in ath_trace.c.
+ *
+ *   Every timer_ncycle cycles (parameter in the <log> block) the time spent
+ *   in each phase since the previous report is printed, with the min, mean
+ *   and max over all MPI ranks.  A summary over the whole run is always
+ *   printed at the end unless timer_ncycle < 0.  The row "other" is the loop
+ *   wall time not covered by any phase (e.g. Userwork_in_loop), so a large
+ *   max/min ratio in bvals or other usually points to load imbalance.
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - ath_timer_init()   - sets report cadence and resets all timers
+ * - ath_timer_start()  - starts timer for one phase
+ * - ath_timer_stop()   - stops timer for one phase and accumulates
+ * - ath_timer_report() - prints min/mean/max over ranks at report cadence    */
+/*============================================================================*/
+
+#include <stdio.h>
+#include <sys/time.h>
+#include "defs.h"
+#include "athena.h"
+#include "globals.h"
+#include "prototypes.h"
+
+/* names of phases, in the order of enum TimerPhase in athena.h */
+static const char *phase_name[NTIMER] = {"integrate", "bvals", "smr",
+  "selfg", "new_dt", "diffusion", "cooling", "particles", "output"};
+
+/* time accumulated in each phase since last report and since init, and time
+ * at which each phase was started (all in seconds) */
+static double t_phase[NTIMER], t_phase_run[NTIMER], t_start[NTIMER];
+
+/* wall time at last report and at init, and nstep of each */
+static double t_last, t_init;
+static int nstep_last, nstep_init;
+
+/* report every ncycle cycles; 0 = only at end of run; <0 = never */
+static int ncycle = 0;
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - wtime()        - returns wall time in seconds
+ * - print_report() - reduces timers over ranks and prints table
+ *============================================================================*/
+
+static double wtime(void);
+static void print_report(const double *t, const double twall,
+                         const int n0, const int n1);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_timer_init(const int nrep, const int nstep)
+ *  \brief Sets report cadence and resets all timers.  Called just before
+ *   the main loop is entered, with nstep the current cycle number. */
+void ath_timer_init(const int nrep, const int nstep)
+{
+  int n;
+
+  ncycle = nrep;
+  for (n=0; n<NTIMER; n++) {
+    t_phase[n] = 0.0;
+    t_phase_run[n] = 0.0;
+    t_start[n] = 0.0;
+  }
+  t_init = t_last = wtime();
+  nstep_init = nstep_last = nstep;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_timer_start(const enum TimerPhase n)
+ *  \brief Starts timer for phase n. */
+void ath_timer_start(const enum TimerPhase n)
+{
+  ath_trace_begin(phase_name[n]);
+  t_start[n] = wtime();
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_timer_stop(const enum TimerPhase n)
+ *  \brief Stops timer for phase n and adds elapsed time to its totals. */
+void ath_timer_stop(const enum TimerPhase n)
+{
+  double dt = wtime() - t_start[n];
+
+  t_phase[n] += dt;
+  t_phase_run[n] += dt;
+  ath_trace_end(phase_name[n]);
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_timer_report(const int nstep, const int final)
+ *  \brief Prints time in each phase since last report if nstep is a multiple
+ *   of the cadence, or the summary over the whole run if final=1.
+ *
+ *   Must be called by all ranks with the same arguments, since it contains
+ *   collective MPI operations. */
+void ath_timer_report(const int nstep, const int final)
+{
+  int n;
+  double t;
+
+  if (ncycle < 0) return;
+
+  if (final) {
+    t = wtime();
+    ath_pout(0,"\nTiming breakdown for cycles %d-%d (wall seconds):\n",
+             nstep_init,nstep);
+    print_report(t_phase_run, t - t_init, nstep_init, nstep);
+    return;
+  }
+
+  if (ncycle == 0 || nstep % ncycle != 0 || nstep == nstep_last) return;
+
+  t = wtime();
+  ath_pout(0,"Timing breakdown for cycles %d-%d (wall seconds):\n",
+           nstep_last,nstep);
+  print_report(t_phase, t - t_last, nstep_last, nstep);
+
+  for (n=0; n<NTIMER; n++) t_phase[n] = 0.0;
+  t_last = t;
+  nstep_last = nstep;
+
+  return;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double wtime(void)
+ *  \brief Returns wall time in seconds. */
+static double wtime(void)
+{
+#ifdef MPI_PARALLEL
+  return MPI_Wtime();
+#else
+  struct timeval tv;
+
+  gettimeofday(&tv,NULL);
+  return (double)tv.tv_sec + 1.0e-6*(double)tv.tv_usec;
+#endif /* MPI_PARALLEL */
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void print_report(const double *t, const double twall,
+ *                               const int n0, const int n1)
+ *  \brief Reduces phase times t[] and the wall time twall over all ranks,
+ *   and prints min/mean/max of each, with the mean percentage of wall time
+ *   and the mean time per cycle.  Phases that took no time are skipped. */
+static void print_report(const double *t, const double twall,
+                         const int n0, const int n1)
+{
+  double my_t[NTIMER+2], tmin[NTIMER+2], tmax[NTIMER+2], tsum[NTIMER+2];
+  double tmean, pct, ncyc = (double)(n1 > n0 ? n1 - n0 : 1);
+  int n, nproc=1;
+#ifdef MPI_PARALLEL
+  int ierr;
+#endif
+
+/* pack the phases, the remainder of the wall time, and the wall time */
+
+  my_t[NTIMER] = twall;
+  for (n=0; n<NTIMER; n++) {
+    my_t[n] = t[n];
+    my_t[NTIMER] -= t[n];
+  }
+  my_t[NTIMER+1] = twall;
+
+#ifdef MPI_PARALLEL
+  ierr = MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+  ierr = MPI_Reduce(my_t, tmin, NTIMER+2, MPI_DOUBLE, MPI_MIN, 0,
+                    MPI_COMM_WORLD);
+  ierr = MPI_Reduce(my_t, tmax, NTIMER+2, MPI_DOUBLE, MPI_MAX, 0,
+                    MPI_COMM_WORLD);
+  ierr = MPI_Reduce(my_t, tsum, NTIMER+2, MPI_DOUBLE, MPI_SUM, 0,
+                    MPI_COMM_WORLD);
+  if (myID_Comm_world != 0) return;
+#else
+  for (n=0; n<NTIMER+2; n++) tmin[n] = tmax[n] = tsum[n] = my_t[n];
+#endif /* MPI_PARALLEL */
+
+  ath_pout(0,"  %-10s %11s %11s %11s %7s %11s\n",
+           "phase","min","mean","max","%","per cycle");
+  for (n=0; n<NTIMER+2; n++) {
+    if (n < NTIMER && tmax[n] == 0.0) continue;
+    tmean = tsum[n]/(double)nproc;
+    pct = tsum[NTIMER+1] > 0.0 ? 100.0*tsum[n]/tsum[NTIMER+1] : 0.0;
+    ath_pout(0,"  %-10s %11.4e %11.4e %11.4e %7.2f %11.4e\n",
+             (n < NTIMER ? phase_name[n] : (n == NTIMER ? "other" : "total")),
+             tmin[n],tmean,tmax[n],pct,tmean/ncyc);
+  }
+
+  return;
+}
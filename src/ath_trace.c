@@ -0,0 +1,209 @@
+#include "copyright.h"
+/*============================================================================*/
+/*! \file ath_trace.c
+ *  \brief Records begin/end events and writes them as trace-event JSON.
+ *
+ * PURPOSE: Records begin/end events and writes them as trace-event JSON,
+ *   which can be opened in chrome://tracing or ui.perfetto.dev to show what
+ *   each rank was doing over time.  Tracing is turned on with trace=1 in the
+ *   <log> block of the input file.  When off, ath_trace_begin() and
+ *   ath_trace_end() return immediately, so the calls may be left in place.
+ *
+ *   Events are recorded for each phase timed by ath_timer_start()/stop() in
+ *   the main loop, for bvals_mhd() and each pack/unpack of MPI buffers, and
+ *   for the MPI waits in RestrictCorrect() and Prolongate().  They are kept
+ *   in a buffer which is written out when full and at ath_trace_close().
+ *
+ *   Each rank writes <problem_id>.trace.json in its own run directory, using
+ *   the rank as the "pid" of its events.  Only rank 0 writes the opening
+ *   bracket, and the closing bracket is optional in this format, so the
+ *   files from all ranks merge into one timeline with, e.g.
+ *     cat id?/<id>.trace.json id??/<id>.trace.json > <id>.trace.json
+ *   Time stamps (in microseconds) are measured from a barrier in
+ *   ath_trace_init(), so they are consistent across ranks to within the
+ *   latency of the barrier.
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - ath_trace_init()  - turns tracing on/off and sets time origin
+ * - ath_trace_begin() - records start of an event
+ * - ath_trace_end()   - records end of an event
+ * - ath_trace_close() - writes remaining events and closes trace file        */
+/*============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "defs.h"
+#include "athena.h"
+#include "globals.h"
+#include "prototypes.h"
+
+/* number of events buffered before they are written to the file */
+#define TRACE_NBUF 65536
+
+/*! \struct TraceEvent
+ *  \brief One begin ('B') or end ('E') event.  The name must be a string
+ *   constant, since only the pointer is stored. */
+typedef struct TraceEvent_s{
+  const char *name;
+  double ts;
+  char ph;
+}TraceEvent;
+
+static int trace_on = 0;            /* set to 1 if trace=1 in <log> block */
+static TraceEvent *trace_buf = NULL;
+static int nevent = 0;              /* number of events in trace_buf */
+static double t0;                   /* time origin, set in ath_trace_init() */
+static int my_id = 0;               /* rank, used as pid of events */
+static char *trace_fname = NULL;
+static FILE *trace_fp = NULL;
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - wtime()       - returns wall time in seconds
+ * - trace_flush() - writes buffered events to trace file
+ *============================================================================*/
+
+static double wtime(void);
+static void trace_flush(void);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_trace_init(const int on, const char *basename)
+ *  \brief Turns tracing on if on=1, with events written to
+ *   <basename>.trace.json.  Must be called by all ranks.
+ *
+ *   The file is opened on the first write, so it is created in the run
+ *   directory even though this function is called before change_rundir(). */
+void ath_trace_init(const int on, const char *basename)
+{
+  trace_on = 0;
+  if (!on) return;
+
+#ifdef MPI_PARALLEL
+  my_id = myID_Comm_world;
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  t0 = wtime();
+
+  if ((trace_buf = (TraceEvent*)calloc(TRACE_NBUF,sizeof(TraceEvent)))
+      == NULL) {
+    ath_perr(-1,"[ath_trace_init]: malloc returned a NULL pointer\n");
+    return;
+  }
+  if ((trace_fname = (char*)malloc(strlen(basename)+12)) == NULL) {
+    free(trace_buf);  trace_buf = NULL;
+    ath_perr(-1,"[ath_trace_init]: malloc returned a NULL pointer\n");
+    return;
+  }
+  sprintf(trace_fname,"%s.trace.json",basename);
+
+  nevent = 0;
+  trace_on = 1;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_trace_begin(const char *name)
+ *  \brief Records start of event name (a string constant). */
+void ath_trace_begin(const char *name)
+{
+  if (!trace_on) return;
+
+  if (nevent == TRACE_NBUF) trace_flush();
+  trace_buf[nevent].name = name;
+  trace_buf[nevent].ts = wtime();
+  trace_buf[nevent].ph = 'B';
+  nevent++;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_trace_end(const char *name)
+ *  \brief Records end of event name (a string constant). */
+void ath_trace_end(const char *name)
+{
+  if (!trace_on) return;
+
+  if (nevent == TRACE_NBUF) trace_flush();
+  trace_buf[nevent].name = name;
+  trace_buf[nevent].ts = wtime();
+  trace_buf[nevent].ph = 'E';
+  nevent++;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_trace_close(void)
+ *  \brief Writes remaining events, closes trace file and frees memory. */
+void ath_trace_close(void)
+{
+  if (!trace_on) return;
+
+  trace_flush();
+  if (trace_fp != NULL) {
+    fclose(trace_fp);
+    trace_fp = NULL;
+  }
+  free(trace_buf);    trace_buf = NULL;
+  free(trace_fname);  trace_fname = NULL;
+  trace_on = 0;
+
+  return;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double wtime(void)
+ *  \brief Returns wall time in seconds. */
+static double wtime(void)
+{
+#ifdef MPI_PARALLEL
+  return MPI_Wtime();
+#else
+  struct timeval tv;
+
+  gettimeofday(&tv,NULL);
+  return (double)tv.tv_sec + 1.0e-6*(double)tv.tv_usec;
+#endif /* MPI_PARALLEL */
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void trace_flush(void)
+ *  \brief Writes buffered events to the trace file, opening it (and writing
+ *   the header) on the first call.  Tracing is turned off if the file cannot
+ *   be opened. */
+static void trace_flush(void)
+{
+  int n;
+
+  if (trace_fp == NULL) {
+    if ((trace_fp = fopen(trace_fname,"w")) == NULL) {
+      ath_perr(-1,"[ath_trace]: Unable to open trace file %s\n",trace_fname);
+      free(trace_buf);    trace_buf = NULL;
+      free(trace_fname);  trace_fname = NULL;
+      trace_on = 0;
+      return;
+    }
+    if (my_id == 0) fprintf(trace_fp,"[\n");
+    fprintf(trace_fp,"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"tid\":0,\"args\":{\"name\":\"rank %d\"}},\n",my_id,my_id);
+    fprintf(trace_fp,"{\"name\":\"process_sort_index\",\"ph\":\"M\","
+            "\"pid\":%d,\"tid\":0,\"args\":{\"sort_index\":%d}},\n",
+            my_id,my_id);
+  }
+
+  for (n=0; n<nevent; n++) {
+    fprintf(trace_fp,"{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,"
+            "\"pid\":%d,\"tid\":0},\n",trace_buf[n].name,trace_buf[n].ph,
+            1.0e6*(trace_buf[n].ts - t0),my_id);
+  }
+  nevent = 0;
+
+  return;
+}
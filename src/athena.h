@@ -7,6 +7,7 @@
  * PURPOSE: Contains definitions of the following data types and structures:
  * - Real    - either float or double, depending on configure option
  * - ConsS   - cell-centered conserved variables
+ * - ConsArrS - conserved variables on a Grid as structure-of-arrays
  * - PrimS   - cell-centered primitive variables
  * - Cons1DS - conserved variables in 1D: same as ConsS minus Bx
  * - Prim1DS - primitive variables in 1D: same as PrimS minus Bx
@@ -36,6 +37,27 @@ typedef double Real;
 # error "Not a valid precision flag"
 #endif
 
+/*! \typedef GReal
+ *  \brief Type of the field arrays stored on Grids (U with --enable-soa,
+ *   B1i..B3i, Phi and Phi_old) and of the MPI buffers used to exchange them.
+ *   The same as Real, unless configured with --enable-mixed, in which case
+ *   they are stored in single precision while all arithmetic is done in Real.
+ */
+#if defined(MIXED_PREC)
+#if defined(SINGLE_PREC) || !defined(CONS_SOA)
+#error: mixed precision requires double precision and --enable-soa
+#endif
+typedef float GReal;
+#ifdef MPI_PARALLEL
+#define MPI_GREAL MPI_FLOAT
+#endif
+#else
+typedef Real GReal;
+#ifdef MPI_PARALLEL
+#define MPI_GREAL MPI_DOUBLE
+#endif
+#endif /* MIXED_PREC */
+
 #if defined(STS)
 #if !defined(THERMAL_CONDUCTION) && !defined(RESISTIVITY) && !defined(VISCOSITY)
 #error: STS require explicit diffusion
@@ -104,6 +126,69 @@ typedef struct Cons_s{
 #endif
 }ConsS;
 
+/*! \def NCONS
+ *  \brief Number of Real elements in ConsS */
+#define NCONS ((int)(sizeof(ConsS)/sizeof(Real)))
+
+#ifdef CONS_SOA
+/*----------------------------------------------------------------------------*/
+/*! \struct ConsArrS
+ *  \brief Conserved variables on a Grid stored as structure-of-arrays: one
+ *   contiguous 3D array per variable, in the same order as ConsS.  Used for
+ *   GridS.U when configured with --enable-soa.
+ *  IMPORTANT!! The order of the elements in ConsArrS CANNOT be changed.
+ */
+typedef struct ConsArr_s{
+  GReal ***d;
+  GReal ***M1;
+  GReal ***M2;
+  GReal ***M3;
+#ifndef BAROTROPIC
+  GReal ***E;
+#endif /* BAROTROPIC */
+#ifdef MHD
+  GReal ***B1c;
+  GReal ***B2c;
+  GReal ***B3c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+  GReal ***s[NSCALARS];
+#endif
+#ifdef CYLINDRICAL
+  GReal ***Pflux;
+#endif
+}ConsArrS;
+#endif /* CONS_SOA */
+
+/*----------------------------------------------------------------------------*/
+/*! \def UVAR
+ *  \brief Accessors for the conserved variables of a Grid, which work with
+ *   both storage orders of GridS.U:
+ *   - UVAR(U,k,j,i,v)        - member v (d,M1,...,s[n]) of cell k,j,i
+ *   - UVARN(U,k,j,i,n)       - n-th member (in ConsS order) of cell k,j,i
+ *   - UCELL(U,k,j,i)         - copy of cell k,j,i as a ConsS
+ *   - UCELL_SET(U,k,j,i,C)   - set cell k,j,i from ConsS C
+ *   - UCOPY(U,k,j,i,kk,jj,ii) - copy cell kk,jj,ii into cell k,j,i
+ *   - UZERO(U,k,j,i)         - set all variables of cell k,j,i to zero
+ *   With --enable-soa, loops over i of UVAR() are unit stride. */
+#ifdef CONS_SOA
+#define UVAR(U,k,j,i,v)  ((U).v[k][j][i])
+#define UVARN(U,k,j,i,n) (((GReal****)&(U))[n][k][j][i])
+#define UCELL(U,k,j,i)   cons_gather(&(U),(k),(j),(i))
+#define UCELL_SET(U,k,j,i,C) cons_scatter(&(U),(k),(j),(i),(C))
+#define UCOPY(U,k,j,i,kk,jj,ii) do { int n_; for (n_=0; n_<NCONS; n_++) \
+  UVARN(U,k,j,i,n_) = UVARN(U,kk,jj,ii,n_); } while (0)
+#define UZERO(U,k,j,i) do { int n_; for (n_=0; n_<NCONS; n_++) \
+  UVARN(U,k,j,i,n_) = 0.0; } while (0)
+#else
+#define UVAR(U,k,j,i,v)  ((U)[k][j][i].v)
+#define UVARN(U,k,j,i,n) (((Real*)&((U)[k][j][i]))[n])
+#define UCELL(U,k,j,i)   ((U)[k][j][i])
+#define UCELL_SET(U,k,j,i,C) ((U)[k][j][i] = (C))
+#define UCOPY(U,k,j,i,kk,jj,ii) ((U)[k][j][i] = (U)[kk][jj][ii])
+#define UZERO(U,k,j,i) memset(&((U)[k][j][i]),0,sizeof(ConsS))
+#endif /* CONS_SOA */
+
 /*----------------------------------------------------------------------------*/
 /*! \struct PrimS
  *  \brief Primitive variables.
@@ -293,15 +378,23 @@ typedef struct GridOvrlp_s{
  *   for a given cell in memory.  */
 
 typedef struct Grid_s{
-  ConsS ***U;                /*!< conserved variables */
+#ifdef CONS_SOA
+  ConsArrS U;                /*!< conserved variables (use UVAR() etc.) */
+#else
+  ConsS ***U;                /*!< conserved variables (use UVAR() etc.) */
+#endif
+#ifdef PRIM_CACHE
+  PrimS ***W;   /*!< primitives, filled by 3D integrators and new_dt() */
+  int W_valid;  /*!< 1 if W holds primitives of U in active cells */
+#endif
 #ifdef MHD
-  Real ***B1i,***B2i,***B3i;    /*!< interface magnetic fields */
+  GReal ***B1i,***B2i,***B3i;   /*!< interface magnetic fields */
 #ifdef RESISTIVITY
   Real ***eta_Ohm,***eta_Hall,***eta_AD; /*!< magnetic diffusivities */ 
 #endif
 #endif /* MHD */
 #ifdef SELF_GRAVITY
-  Real ***Phi, ***Phi_old;      /*!< gravitational potential */
+  GReal ***Phi, ***Phi_old;     /*!< gravitational potential */
   Real ***x1MassFlux;           /*!< x1 mass flux for source term correction */
   Real ***x2MassFlux;           /*!< x2 mass flux for source term correction */
   Real ***x3MassFlux;           /*!< x3 mass flux for source term correction */
@@ -552,4 +645,16 @@ typedef Real (*TSFun_t)(GridS *pG, int type, Real rho, Real cs, Real vd);
  *  \brief Directions for the set_bvals_fun() function */
 enum BCDirection {left_x1, right_x1, left_x2, right_x2, left_x3, right_x3};
 
+/*----------------------------------------------------------------------------*/
+/*! \enum TimerPhase
+ *  \brief Phases of the main loop timed by the ath_timer functions */
+enum TimerPhase {integrate_timer, bvals_timer, smr_timer, selfg_timer,
+  newdt_timer, diff_timer, cooling_timer, particle_timer, output_timer,
+  NTIMER};
+
+/*----------------------------------------------------------------------------*/
+/*! \enum PerfKernel
+ *  \brief Kernels measured by the ath_perf hardware counter functions */
+enum PerfKernel {integrate_3d_perf, lr_states_perf, fluxes_perf, NPERF};
+
 #endif /* ATHENA_H */
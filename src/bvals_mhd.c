@@ -33,6 +33,28 @@
  *   - 2) Pack and send data to the Grids on both L and R
  *   - 3) Check for receives and unpack data in order of first to finish
  *   If the Grid is at the edge of the Domain, we set BCs as in case (1) or (3).
+ *   The x1-exchange can be split into bvals_mhd_start() (steps 1-2) and
+ *   bvals_mhd_finish() (step 3), so that work that needs only the active zones
+ *   can be done while messages are in flight.
+ *   This is done in the order x1-x2-x3, so that corner cells are relayed
+ *   through the face neighbours.  With single_phase_bvals=1 in the <job>
+ *   block, Domains whose boundaries are all periodic or MPI instead exchange
+ *   with all face, edge and corner neighbours at once, using persistent
+ *   requests, in one round of messages rather than three.  This is also
+ *   used with overlap_bvals=1, so that all messages are in flight between
+ *   bvals_mhd_start() and bvals_mhd_finish() while main() updates the
+ *   interior of the Grid (see integrate_3d_blocked.c).  Domains with
+ *   physical boundaries still send only the x1-data in bvals_mhd_start().
+ *   With shmem_bvals=1 in the <job> block (needs MPI-3), the send buffers are
+ *   allocated in a shared-memory window on each node, and Grids read the
+ *   packed boundary data of neighbours on the same node directly into their
+ *   ghost zones, synchronised by flags in the window.  Faces shared with
+ *   Grids on other nodes still use messages.
+ *   With halo_compress=1 in the <job> block, messages carry floats rather
+ *   than doubles, and with halo_compress=2 floats scaled by the largest
+ *   value on each face (so values outside the range of a float are sent);
+ *   the receiver restores doubles before unpacking.  This halves halo bytes
+ *   at the cost of rounding ghost zones to float precision.
  *
  * For case (3) -- INTERNAL GRID LEVEL BOUNDARIES
  *   This step is complicated and must be handled separately, in the function
@@ -44,8 +66,14 @@
  *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - bvals_mhd()      - calls appropriate functions to set ghost cells
+ * - bvals_mhd_start() - starts MPI exchange and sets physical BCs in x1
+ * - bvals_mhd_finish() - completes x1 exchange and sets BCs in x2 and x3
+ * - bvals_mhd_destruct() - frees MPI buffers and persistent requests
  * - bvals_mhd_init() - sets function pointers used by bvals_mhd()
  * - bvals_mhd_fun()  - enrolls a pointer to a user-defined BC function
+ * - halo_msg_type()  - count and datatype of MPI message of cnt words
+ * - halo_compress()  - converts packed buffer to float before send
+ * - halo_expand()    - restores packed buffer to double after receive
  *
  * PRIVATE FUNCTION PROTOTYPES:
  * - reflect_ix1()  - reflecting BCs at boundary ix1
@@ -88,6 +116,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
 #include "defs.h"
 #include "athena.h"
 #include "globals.h"
@@ -95,9 +126,71 @@
 
 #ifdef MPI_PARALLEL
 /* MPI send and receive buffers */
-static double **send_buf = NULL, **recv_buf = NULL;
-static MPI_Request *recv_rq, *send_rq;
+static GReal **send_buf = NULL, **recv_buf = NULL;
+/* requests of the Domain and direction being updated, from persist_rq */
+static MPI_Request *recv_rq = NULL, *send_rq = NULL;
+/* halo_compress in <job> block: 0 = off, 1 = float, 2 = scaled float */
+static int halo_mode = 0;
+
+/*! \struct Halo26S
+ *  \brief Persistent requests and buffers for the single-phase exchange
+ *   with the face, edge and corner neighbours of the Grid in one Domain. */
+typedef struct Halo26_s{
+  DomainS *pD;                /*!< Domain using single-phase exchange */
+  int nnb;                    /*!< number of neighbours (2, 8 or 26) */
+  int off[26][3];             /*!< offsets (-1,0,1) of neighbours in x1,x2,x3 */
+  GReal *send[26], *recv[26]; /*!< buffers for each neighbour */
+  MPI_Request rq[52];         /*!< receive requests, then send requests */
+}Halo26S;
+
+/* Domains using single-phase exchange (with single_phase_bvals=1 in <job>) */
+static Halo26S *halo26 = NULL;
+static int nhalo26 = 0;
+
+/*! \struct PersistRqS
+ *  \brief Persistent requests for the exchange with the L and R Grids in
+ *   each direction, for the Grid in one Domain. */
+typedef struct PersistRq_s{
+  DomainS *pD;                /*!< Domain of Grid */
+  int cnt[3];                 /*!< words passed in x1,x2,x3 */
+  MPI_Request recv_rq[3][2];  /*!< receives from L,R Grids in x1,x2,x3 */
+  MPI_Request send_rq[3][2];  /*!< sends to L,R Grids in x1,x2,x3 */
+}PersistRqS;
+
+/* Domains using three-phase exchange */
+static PersistRqS *persist_rq = NULL;
+static int npersist_rq = 0;
+
+/* shared-memory windows need MPI-3 */
+#if MPI_VERSION >= 3
+#define SHM_BVALS
+
+/*! \struct ShmS
+ *  \brief Shared-memory exchange with the face neighbours on the same node
+ *   of the Grid in one Domain.  Faces are numbered f=2*dir+(0 for L, 1 for R).
+ */
+typedef struct Shm_s{
+  DomainS *pD;                /*!< Domain using shared-memory exchange */
+  int g;                      /*!< index of Domain in flags of each window */
+  long seq;                   /*!< number of exchanges started */
+  GReal *nbr_buf[6];          /*!< send buffer of neighbour, NULL if off node */
+  volatile long *nbr_flag[6]; /*!< ready and ack flags of neighbour for face */
+}ShmS;
+
+/* index in window of ready flag of face f of Domain g; ack flag follows */
+#define SHM_FLAG(g,f) (1 + 2*(6*(g) + (f)))
+
+static MPI_Comm comm_node = MPI_COMM_NULL; /* ranks sharing memory */
+static MPI_Win shm_win = MPI_WIN_NULL;     /* window holding send_buf */
+static MPI_Aint shm_hdr = 0;    /* bytes of flags at start of each segment */
+static volatile long *shm_flag = NULL;     /* flags in own segment */
+/* Domains using shared-memory exchange (with shmem_bvals=1 in <job>) */
+static ShmS *shm = NULL;
+static int nshm = 0;
+#endif /* MPI_VERSION >= 3 */
 #endif /* MPI_PARALLEL */
+/* Domain of exchange started by bvals_mhd_start(), or NULL */
+static DomainS *pD_started = NULL;
 
 /*==============================================================================
  * PRIVATE FUNCTION PROTOTYPES:
@@ -107,6 +200,20 @@ static MPI_Request *recv_rq, *send_rq;
  *   conduct_???()  - conducting BCs at boundary ???
  *   pack_???()     - pack data for MPI non-blocking send at ??? boundary
  *   unpack_???()   - unpack data for MPI non-blocking receive at ??? boundary
+ *   persist_init()  - creates persistent requests for one Domain
+ *   persist_find()  - returns persistent requests of Domain
+ *   shm_alloc()     - allocates send buffers in shared-memory window
+ *   shm_init()      - sets up shared-memory exchange for one Domain
+ *   shm_find()      - returns shared-memory exchange of Domain, or NULL
+ *   shm_post()      - starts exchange in one direction
+ *   shm_complete()  - completes exchange in one direction
+ *   shm_wait()      - waits for flag in shared memory
+ *   halo26_init()   - sets up single-phase exchange for one Domain
+ *   halo26_find()   - returns single-phase exchange of Domain, or NULL
+ *   halo26_range()  - index range of region sent to/received from neighbour
+ *   halo26_count()  - number of words sent to/received from neighbour
+ *   halo26_pack()   - pack data for neighbour at offset (o1,o2,o3)
+ *   halo26_unpack() - unpack data from neighbour at offset (o1,o2,o3)
  *============================================================================*/
 
 static void reflect_ix1(GridS *pG);
@@ -153,6 +260,25 @@ static void unpack_ix2(GridS *pG);
 static void unpack_ox2(GridS *pG);
 static void unpack_ix3(GridS *pG);
 static void unpack_ox3(GridS *pG);
+
+static void persist_init(DomainS *pD);
+static PersistRqS *persist_find(const DomainS *pD);
+#ifdef SHM_BVALS
+static void shm_alloc(MeshS *pM, const int size);
+static void shm_init(DomainS *pD, const int g);
+static ShmS *shm_find(const DomainS *pD);
+static void shm_post(DomainS *pD, ShmS *pS, PersistRqS *pR, const int dir);
+static void shm_complete(DomainS *pD, ShmS *pS, PersistRqS *pR,
+                         const int dir);
+static void shm_wait(volatile long *flag, const long seq);
+#endif
+static void halo26_init(DomainS *pD);
+static Halo26S *halo26_find(const DomainS *pD);
+static void halo26_range(const GridS *pG, const int dir, const int o,
+                         const int stag, const int snd, int *lo, int *hi);
+static int halo26_count(const GridS *pG, const int *o, const int snd);
+static void halo26_pack(GridS *pG, const int *o, GReal *pSnd);
+static void halo26_unpack(GridS *pG, const int *o, GReal *pRcv);
 #endif /* MPI_PARALLEL */
 
 /*=========================== PUBLIC FUNCTIONS ===============================*/
@@ -172,56 +298,232 @@ static void unpack_ox3(GridS *pG);
  */
 
 void bvals_mhd(DomainS *pD)
+{
+  ath_trace_begin("bvals_mhd");
+  bvals_mhd_start(pD);
+  bvals_mhd_finish(pD);
+  ath_trace_end("bvals_mhd");
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void bvals_mhd_start(DomainS *pD)
+ *  \brief First half of split-phase bvals_mhd(): posts receives, packs and
+ *   sends the x1-boundary data, and sets physical x1-boundaries.
+ *
+ *   Work that reads only active zones may be done before the matching call
+ *   to bvals_mhd_finish(), while messages are in flight; it may change active
+ *   zones more than nghost cells from the edges of the Grid, which are not
+ *   read by the x2- and x3-steps or physical BCs.  Only one exchange may be
+ *   in progress at a time, since all Domains share the same MPI buffers.
+ *   The x2- and x3-boundaries cannot be started early, since they copy
+ *   corner cells filled by the x1-exchange; with the single-phase exchange
+ *   all messages are sent here.
+ */
+
+void bvals_mhd_start(DomainS *pD)
 {
   GridS *pGrid = (pD->Grid);
-#ifdef SHEARING_BOX
-  int myL,myM,myN,BCFlag;
+#ifdef MPI_PARALLEL
+  int ierr, n;
+  Halo26S *pH;
+  PersistRqS *pR;
+#ifdef SHM_BVALS
+  ShmS *pS;
 #endif
+#endif /* MPI_PARALLEL */
+
+  if (pD_started != NULL)
+    ath_error("[bvals_mhd_start]: exchange on level %d domain %d not finished\n",
+      pD_started->Level,pD_started->DomNumber);
+  pD_started = pD;
+
+  ath_trace_begin("bvals_mhd_start");
+
 #ifdef MPI_PARALLEL
-  int cnt, cnt2, cnt3, ierr, mIndex;
+/* With the single-phase exchange, start receives from all neighbours, and
+ * pack and send data to each in turn */
+
+  if ((pH = halo26_find(pD)) != NULL) {
+    ierr = MPI_Startall(pH->nnb, pH->rq);
+    for (n=0; n<pH->nnb; n++) {
+      halo26_pack(pGrid, pH->off[n], pH->send[n]);
+      halo_compress(pH->send[n], halo26_count(pGrid, pH->off[n], 1));
+      ierr = MPI_Start(&(pH->rq[pH->nnb+n]));
+    }
+    ath_trace_end("bvals_mhd_start");
+    return;
+  }
+  pR = persist_find(pD);
+
+/* With the shared-memory exchange, publish x1 data for neighbours on this
+ * node and send it to the others */
+
+#ifdef SHM_BVALS
+  if ((pS = shm_find(pD)) != NULL) {
+    pS->seq++;
+    if (pGrid->Nx[0] > 1) shm_post(pD, pS, pR, 0);
+    ath_trace_end("bvals_mhd_start");
+    return;
+  }
+#endif
 #endif /* MPI_PARALLEL */
 
-/*--- Step 1. ------------------------------------------------------------------
- * Boundary Conditions in x1-direction */
+/*--- Step 1a. -----------------------------------------------------------------
+ * Start boundary conditions in x1-direction */
 
   if (pGrid->Nx[0] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt = nghost*(pGrid->Nx[1])*(pGrid->Nx[2])*(NVAR);
-#ifdef MHD
-    cnt2 = (pGrid->Nx[1] > 1) ? (pGrid->Nx[1] + 1) : 1;
-    cnt3 = (pGrid->Nx[2] > 1) ? (pGrid->Nx[2] + 1) : 1;
-    cnt += (nghost-1)*(pGrid->Nx[1])*(pGrid->Nx[2]);
-    cnt += nghost*cnt2*(pGrid->Nx[2]);
-    cnt += nghost*(pGrid->Nx[1])*cnt3;
-#endif
+    recv_rq = pR->recv_rq[0];
+    send_rq = pR->send_rq[0];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx1_id >= 0 && pGrid->lx1_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_ix1(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_ox1(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[1]));
+
+    }
+
+/* Physical boundary on left, MPI block on right */
+    if (pGrid->rx1_id >= 0 && pGrid->lx1_id < 0) {
+
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
+
+      /* pack and send data R */
+      pack_ox1(pGrid); 
+      halo_compress(send_buf[1], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[1]));
+
+      /* set physical boundary */
+      (*(pD->ix1_BCFun))(pGrid);
+
+    }
+
+/* MPI block on left, Physical boundary on right */
+    if (pGrid->rx1_id < 0 && pGrid->lx1_id >= 0) {
+
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
+
+      /* pack and send data L */
+      pack_ix1(pGrid); 
+      halo_compress(send_buf[0], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[0]));
+
+      /* set physical boundary */
+      (*(pD->ox1_BCFun))(pGrid);
+
+    }
+#endif /* MPI_PARALLEL */
+
+/* Physical boundaries on both left and right */
+    if (pGrid->rx1_id < 0 && pGrid->lx1_id < 0) {
+      (*(pD->ix1_BCFun))(pGrid);
+      (*(pD->ox1_BCFun))(pGrid);
+    } 
+
+  }
+
+  ath_trace_end("bvals_mhd_start");
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void bvals_mhd_finish(DomainS *pD)
+ *  \brief Second half of split-phase bvals_mhd(): waits for and unpacks the
+ *   x1-boundary data, then sets the x2- and x3-boundaries.  Must follow a
+ *   call to bvals_mhd_start() with the same Domain.
+ */
+
+void bvals_mhd_finish(DomainS *pD)
+{
+  GridS *pGrid = (pD->Grid);
+#ifdef SHEARING_BOX
+  int myL,myM,myN,BCFlag;
+#endif
+#ifdef MPI_PARALLEL
+  int ierr, mIndex, n;
+  Halo26S *pH;
+  PersistRqS *pR;
+#ifdef SHM_BVALS
+  ShmS *pS;
+  int dir;
+#endif
+#endif /* MPI_PARALLEL */
+
+  if (pD_started != pD)
+    ath_error("[bvals_mhd_finish]: exchange was not started on this domain\n");
+  pD_started = NULL;
+
+  ath_trace_begin("bvals_mhd_finish");
+
+#ifdef MPI_PARALLEL
+/* With the single-phase exchange, unpack data from neighbours in order of
+ * first to arrive.  All ghost zones, including edges and corners, are set. */
+
+  if ((pH = halo26_find(pD)) != NULL) {
+    for (n=0; n<pH->nnb; n++) {
+      ierr = MPI_Waitany(pH->nnb, pH->rq, &mIndex, MPI_STATUS_IGNORE);
+      halo_expand(pH->recv[mIndex], halo26_count(pGrid, pH->off[mIndex], 0));
+      halo26_unpack(pGrid, pH->off[mIndex], pH->recv[mIndex]);
+    }
+    ierr = MPI_Waitall(pH->nnb, &(pH->rq[pH->nnb]), MPI_STATUSES_IGNORE);
+    ath_trace_end("bvals_mhd_finish");
+    return;
+  }
+  pR = persist_find(pD);
+
+/* With the shared-memory exchange, complete x1 and exchange x2 and x3 in
+ * turn.  Not used with the shearing box, so no remap is needed. */
+
+#ifdef SHM_BVALS
+  if ((pS = shm_find(pD)) != NULL) {
+    if (pGrid->Nx[0] > 1) shm_complete(pD, pS, pR, 0);
+    for (dir=1; dir<3; dir++) {
+      if (pGrid->Nx[dir] == 1) continue;
+      shm_post(pD, pS, pR, dir);
+      shm_complete(pD, pS, pR, dir);
+    }
+    ath_trace_end("bvals_mhd_finish");
+    return;
+  }
+#endif
+#endif /* MPI_PARALLEL */
+
+/*--- Step 1b. -----------------------------------------------------------------
+ * Finish boundary conditions in x1-direction */
+
+#ifdef MPI_PARALLEL
+  if (pGrid->Nx[0] > 1){
+    recv_rq = pR->recv_rq[0];
+    send_rq = pR->send_rq[0];
+
+/* MPI blocks to both left and right */
+    if (pGrid->rx1_id >= 0 && pGrid->lx1_id >= 0) {
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[0]);
       if (mIndex == 0) unpack_ix1(pGrid);
       if (mIndex == 1) unpack_ox1(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[0]);
       if (mIndex == 0) unpack_ix1(pGrid);
       if (mIndex == 1) unpack_ox1(pGrid);
 
@@ -230,23 +532,12 @@ void bvals_mhd(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx1_id >= 0 && pGrid->lx1_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
-
-      /* pack and send data R */
-      pack_ox1(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
-
-      /* set physical boundary */
-      (*(pD->ix1_BCFun))(pGrid);
-
       /* check non-blocking send has completed. */
       ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[0]);
       unpack_ox1(pGrid);
 
     }
@@ -254,35 +545,18 @@ void bvals_mhd(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx1_id < 0 && pGrid->lx1_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-
-      /* pack and send data L */
-      pack_ix1(pGrid); 
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
-
-      /* set physical boundary */
-      (*(pD->ox1_BCFun))(pGrid);
-
       /* check non-blocking send has completed. */
       ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[0]);
       unpack_ix1(pGrid);
 
     }
-#endif /* MPI_PARALLEL */
-
-/* Physical boundaries on both left and right */
-    if (pGrid->rx1_id < 0 && pGrid->lx1_id < 0) {
-      (*(pD->ix1_BCFun))(pGrid);
-      (*(pD->ox1_BCFun))(pGrid);
-    } 
 
   }
+#endif /* MPI_PARALLEL */
 
 /*--- Step 2. ------------------------------------------------------------------
  * Boundary Conditions in x2-direction */
@@ -290,40 +564,35 @@ void bvals_mhd(DomainS *pD)
   if (pGrid->Nx[1] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt = (pGrid->Nx[0] + 2*nghost)*nghost*(pGrid->Nx[2])*(NVAR);
-#ifdef MHD
-    cnt3 = (pGrid->Nx[2] > 1) ? (pGrid->Nx[2] + 1) : 1;
-    cnt += (pGrid->Nx[0] + 2*nghost - 1)*nghost*(pGrid->Nx[2]);
-    cnt += (pGrid->Nx[0] + 2*nghost)*(nghost-1)*(pGrid->Nx[2]);
-    cnt += (pGrid->Nx[0] + 2*nghost)*nghost*cnt3;
-#endif
+    recv_rq = pR->recv_rq[1];
+    send_rq = pR->send_rq[1];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx2_id >= 0 && pGrid->lx2_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_ix2(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_ox2(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[1]);
       if (mIndex == 0) unpack_ix2(pGrid);
       if (mIndex == 1) unpack_ox2(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[1]);
       if (mIndex == 0) unpack_ix2(pGrid);
       if (mIndex == 1) unpack_ox2(pGrid);
 
@@ -332,14 +601,13 @@ void bvals_mhd(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx2_id >= 0 && pGrid->lx2_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data R */
       pack_ox2(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* set physical boundary */
       (*(pD->ix2_BCFun))(pGrid);
@@ -349,6 +617,7 @@ void bvals_mhd(DomainS *pD)
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[1]);
       unpack_ox2(pGrid);
 
     }
@@ -356,14 +625,13 @@ void bvals_mhd(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx2_id < 0 && pGrid->lx2_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
 
       /* pack and send data L */
       pack_ix2(pGrid); 
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       /* set physical boundary */
       (*(pD->ox2_BCFun))(pGrid);
@@ -373,6 +641,7 @@ void bvals_mhd(DomainS *pD)
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[1]);
       unpack_ix2(pGrid);
 
     }
@@ -407,39 +676,35 @@ void bvals_mhd(DomainS *pD)
   if (pGrid->Nx[2] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt = (pGrid->Nx[0] + 2*nghost)*(pGrid->Nx[1] + 2*nghost)*nghost*(NVAR);
-#ifdef MHD
-    cnt += (pGrid->Nx[0] + 2*nghost - 1)*(pGrid->Nx[1] + 2*nghost)*nghost;
-    cnt += (pGrid->Nx[0] + 2*nghost)*(pGrid->Nx[1] + 2*nghost - 1)*nghost;
-    cnt += (pGrid->Nx[0] + 2*nghost)*(pGrid->Nx[1] + 2*nghost)*(nghost-1);
-#endif
+    recv_rq = pR->recv_rq[2];
+    send_rq = pR->send_rq[2];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx3_id >= 0 && pGrid->lx3_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_ix3(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_ox3(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[2]);
       if (mIndex == 0) unpack_ix3(pGrid);
       if (mIndex == 1) unpack_ox3(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[2]);
       if (mIndex == 0) unpack_ix3(pGrid);
       if (mIndex == 1) unpack_ox3(pGrid);
 
@@ -448,14 +713,13 @@ void bvals_mhd(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx3_id >= 0 && pGrid->lx3_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data R */
       pack_ox3(pGrid); 
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* set physical boundary */
       (*(pD->ix3_BCFun))(pGrid);
@@ -465,6 +729,7 @@ void bvals_mhd(DomainS *pD)
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[2]);
       unpack_ox3(pGrid);
 
     }
@@ -472,14 +737,13 @@ void bvals_mhd(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx3_id < 0 && pGrid->lx3_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
 
       /* pack and send data L */
       pack_ix3(pGrid); 
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       /* set physical boundary */
       (*(pD->ox3_BCFun))(pGrid);
@@ -489,6 +753,7 @@ void bvals_mhd(DomainS *pD)
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[2]);
       unpack_ix3(pGrid);
 
     }
@@ -502,6 +767,7 @@ void bvals_mhd(DomainS *pD)
 
   }
 
+  ath_trace_end("bvals_mhd_finish");
   return;
 }
 
@@ -521,6 +787,20 @@ void bvals_mhd_init(MeshS *pM)
   int x1cnt=0, x2cnt=0, x3cnt=0; /* Number of words passed in x1/x2/x3-dir. */
 #endif /* MPI_PARALLEL */
 
+#ifdef MPI_PARALLEL
+/* Precision of ghost-zone messages, needed before requests are created */
+
+  halo_mode = par_geti_def("job","halo_compress",0);
+  if (halo_mode < 0 || halo_mode > 2)
+    ath_error("[bvals_mhd_init]: halo_compress=%d must be 0, 1 or 2\n",
+      halo_mode);
+  if (halo_mode != 0 && sizeof(GReal) == sizeof(float)) {
+    if (myID_Comm_world == 0)
+      ath_perr(-1,"[bvals_mhd_init]: halo_compress ignored, Grid arrays already single precision\n");
+    halo_mode = 0;
+  }
+#endif /* MPI_PARALLEL */
+
 /* Cycle through all the Domains that have active Grids on this proc */
 
   for (nl=0; nl<(pM->NLevels); nl++){
@@ -875,6 +1155,13 @@ void bvals_mhd_init(MeshS *pM)
     }}
 #endif /* MPI_PARALLEL */
 
+/* Set up single-phase exchange with all neighbours if requested -----------*/
+
+#ifdef MPI_PARALLEL
+    if (par_geti_def("job","single_phase_bvals",0) != 0 ||
+        par_geti_def("job","overlap_bvals",0) != 0) halo26_init(pD);
+#endif /* MPI_PARALLEL */
+
   }}}  /* End loop over all Domains with active Grids -----------------------*/
 
 #ifdef MPI_PARALLEL
@@ -889,24 +1176,107 @@ void bvals_mhd_init(MeshS *pM)
   size *= nghost*(NVAR);
 #endif
 
+/* With shmem_bvals=1, send buffers are allocated in shared memory */
+
+  if (par_geti_def("job","shmem_bvals",0) != 0) {
+#if defined(SHEARING_BOX)
+    if (myID_Comm_world == 0)
+      ath_perr(-1,"[bvals_mhd_init]: shmem_bvals ignored with shearing box\n");
+#elif !defined(SHM_BVALS)
+    if (myID_Comm_world == 0)
+      ath_perr(-1,"[bvals_mhd_init]: shmem_bvals ignored, needs MPI-3\n");
+#else
+    shm_alloc(pM, size);
+#endif
+  }
+
   if (size > 0) {
-    if((send_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    if (send_buf == NULL &&
+       (send_buf = (GReal**)calloc_2d_array(2,size,sizeof(GReal))) == NULL)
       ath_error("[bvals_init]: Failed to allocate send buffer\n");
 
-    if((recv_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    if((recv_buf = (GReal**)calloc_2d_array(2,size,sizeof(GReal))) == NULL)
       ath_error("[bvals_init]: Failed to allocate recv buffer\n");
   }
 
-  if((recv_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
-    ath_error("[bvals_init]: Failed to allocate recv MPI_Request array\n");
-  if((send_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
-    ath_error("[bvals_init]: Failed to allocate send MPI_Request array\n");
+/* Create persistent requests for Domains not using single-phase exchange,
+ * and find neighbours on the same node for the shared-memory exchange */
+
+  n = 0;
+  for (nl=0; nl<(pM->NLevels); nl++){
+    for (nd=0; nd<(pM->DomainsPerLevel[nl]); nd++){
+      pD = (DomainS*)&(pM->Domain[nl][nd]);
+      if (pD->Grid != NULL && halo26_find(pD) == NULL) {
+        persist_init(pD);
+#ifdef SHM_BVALS
+        if (shm_win != MPI_WIN_NULL) shm_init(pD, n);
+#endif
+      }
+      n++;
+    }
+  }
 
 #endif /* MPI_PARALLEL */
 
   return;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \fn void bvals_mhd_destruct(void)
+ *  \brief Frees MPI send/receive buffers and persistent requests, the
+ *   buffers of the single-phase exchange, and the shared-memory window.
+ */
+
+void bvals_mhd_destruct(void)
+{
+#ifdef MPI_PARALLEL
+  int n,m;
+
+  for (n=0; n<nhalo26; n++) {
+    for (m=0; m<2*(halo26[n].nnb); m++) MPI_Request_free(&(halo26[n].rq[m]));
+    free_1d_array(halo26[n].send[0]);
+    free_1d_array(halo26[n].recv[0]);
+  }
+  if (halo26 != NULL) free(halo26);
+  halo26 = NULL;
+  nhalo26 = 0;
+
+  for (n=0; n<npersist_rq; n++) {
+    for (m=0; m<6; m++) {
+      if (persist_rq[n].recv_rq[m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(persist_rq[n].recv_rq[m/2][m%2]));
+      if (persist_rq[n].send_rq[m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(persist_rq[n].send_rq[m/2][m%2]));
+    }
+  }
+  if (persist_rq != NULL) free(persist_rq);
+  persist_rq = NULL;
+  npersist_rq = 0;
+
+#ifdef SHM_BVALS
+  if (shm != NULL) free(shm);
+  shm = NULL;
+  nshm = 0;
+  if (shm_win != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(shm_win);
+    MPI_Win_free(&shm_win);
+    MPI_Comm_free(&comm_node);
+    shm_flag = NULL;
+/* only the row pointers of send_buf were allocated with calloc */
+    if (send_buf != NULL) free_1d_array(send_buf);
+    send_buf = NULL;
+  }
+#endif
+
+  if (send_buf != NULL) free_2d_array(send_buf);
+  if (recv_buf != NULL) free_2d_array(recv_buf);
+  send_buf = recv_buf = NULL;
+  recv_rq = send_rq = NULL;
+#endif /* MPI_PARALLEL */
+
+  return;
+}
+
 /*----------------------------------------------------------------------------*/
 /*! \fn void bvals_mhd_fun(DomainS *pD, enum BCDirection dir, VGFun_t prob_bc)
  *  \brief Sets function ptrs for user-defined BCs.
@@ -940,6 +1310,86 @@ void bvals_mhd_fun(DomainS *pD, enum BCDirection dir, VGFun_t prob_bc)
   return;
 }
 
+#ifdef MPI_PARALLEL
+/*----------------------------------------------------------------------------*/
+/*! \fn void halo_msg_type(const int cnt, int *count, MPI_Datatype *type)
+ *  \brief Returns the count and datatype of the MPI message that carries a
+ *   packed buffer of cnt words, depending on halo_compress: cnt MPI_GREAL,
+ *   cnt MPI_FLOAT, or cnt MPI_FLOAT plus a double scale (as two floats).
+ */
+
+void halo_msg_type(const int cnt, int *count, MPI_Datatype *type)
+{
+  *count = cnt;
+  *type = MPI_GREAL;
+  if (halo_mode == 0) return;
+
+  *type = MPI_FLOAT;
+  if (halo_mode == 2) *count = cnt + sizeof(double)/sizeof(float);
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void halo_compress(GReal *buf, const int cnt)
+ *  \brief Converts the cnt words packed in buf to floats in place, at the
+ *   start of buf, before it is sent.  With halo_compress=2 they are divided
+ *   by the largest absolute value, which is stored as a double after them.
+ *   Each float is stored with memcpy() after its word is read, so the
+ *   overlapping stores are safe.  Does nothing with halo_compress=0.
+ */
+
+void halo_compress(GReal *buf, const int cnt)
+{
+  double scale = 1.0, amax = 0.0;
+  float v;
+  int n;
+
+  if (halo_mode == 0) return;
+
+  if (halo_mode == 2) {
+    for (n=0; n<cnt; n++) if (fabs(buf[n]) > amax) amax = fabs(buf[n]);
+    if (amax > 0.0 && amax <= DBL_MAX) scale = amax;
+  }
+
+  for (n=0; n<cnt; n++) {
+    v = (float)(buf[n]/scale);
+    memcpy((char*)buf + n*sizeof(float), &v, sizeof(float));
+  }
+  if (halo_mode == 2)
+    memcpy((char*)buf + cnt*sizeof(float), &scale, sizeof(double));
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void halo_expand(GReal *buf, const int cnt)
+ *  \brief Restores the cnt words received in buf from the floats written by
+ *   halo_compress(), in place.  Words are restored from the end of buf, so
+ *   each float is read before it is overwritten.  Does nothing with
+ *   halo_compress=0.
+ */
+
+void halo_expand(GReal *buf, const int cnt)
+{
+  double scale = 1.0;
+  float v;
+  int n;
+
+  if (halo_mode == 0) return;
+
+  if (halo_mode == 2)
+    memcpy(&scale, (char*)buf + cnt*sizeof(float), sizeof(double));
+
+  for (n=cnt-1; n>=0; n--) {
+    memcpy(&v, (char*)buf + n*sizeof(float), sizeof(float));
+    buf[n] = (GReal)(scale*(double)v);
+  }
+
+  return;
+}
+#endif /* MPI_PARALLEL */
+
 /*=========================== PRIVATE FUNCTIONS ==============================*/
 /* Following are the functions:
  *   reflecting_???:   where ???=[ix1,ox1,ix2,ox2,ix3,ox3]
@@ -967,10 +1417,10 @@ static void reflect_ix1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][is-i]    =  pGrid->U[k][j][is+(i-1)];
-        pGrid->U[k][j][is-i].M1 = -pGrid->U[k][j][is-i].M1; /* reflect 1-mom. */
+        UCOPY(pGrid->U,k,j,is-i,k,j,is+(i-1));
+        UVAR(pGrid->U,k,j,is-i,M1) = -UVAR(pGrid->U,k,j,is-i,M1); /* reflect 1-mom. */
 #ifdef MHD
-        pGrid->U[k][j][is-i].B1c= -pGrid->U[k][j][is-i].B1c;/* reflect 1-fld. */
+        UVAR(pGrid->U,k,j,is-i,B1c)= -UVAR(pGrid->U,k,j,is-i,B1c);/* reflect 1-fld. */
 #endif
       }
     }
@@ -1026,10 +1476,10 @@ static void reflect_ox1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][ie+i]    =  pGrid->U[k][j][ie-(i-1)];
-        pGrid->U[k][j][ie+i].M1 = -pGrid->U[k][j][ie+i].M1; /* reflect 1-mom. */
+        UCOPY(pGrid->U,k,j,ie+i,k,j,ie-(i-1));
+        UVAR(pGrid->U,k,j,ie+i,M1) = -UVAR(pGrid->U,k,j,ie+i,M1); /* reflect 1-mom. */
 #ifdef MHD
-        pGrid->U[k][j][ie+i].B1c= -pGrid->U[k][j][ie+i].B1c;/* reflect 1-fld. */
+        UVAR(pGrid->U,k,j,ie+i,B1c)= -UVAR(pGrid->U,k,j,ie+i,B1c);/* reflect 1-fld. */
 #endif
       }
     }
@@ -1085,10 +1535,10 @@ static void reflect_ix2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][js-j][i]    =  pGrid->U[k][js+(j-1)][i];
-        pGrid->U[k][js-j][i].M2 = -pGrid->U[k][js-j][i].M2; /* reflect 2-mom. */
+        UCOPY(pGrid->U,k,js-j,i,k,js+(j-1),i);
+        UVAR(pGrid->U,k,js-j,i,M2) = -UVAR(pGrid->U,k,js-j,i,M2); /* reflect 2-mom. */
 #ifdef MHD
-        pGrid->U[k][js-j][i].B2c= -pGrid->U[k][js-j][i].B2c;/* reflect 2-fld. */
+        UVAR(pGrid->U,k,js-j,i,B2c)= -UVAR(pGrid->U,k,js-j,i,B2c);/* reflect 2-fld. */
 #endif
       }
     }
@@ -1146,10 +1596,10 @@ static void reflect_ox2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][je+j][i]    =  pGrid->U[k][je-(j-1)][i];
-        pGrid->U[k][je+j][i].M2 = -pGrid->U[k][je+j][i].M2; /* reflect 2-mom. */
+        UCOPY(pGrid->U,k,je+j,i,k,je-(j-1),i);
+        UVAR(pGrid->U,k,je+j,i,M2) = -UVAR(pGrid->U,k,je+j,i,M2); /* reflect 2-mom. */
 #ifdef MHD
-        pGrid->U[k][je+j][i].B2c= -pGrid->U[k][je+j][i].B2c;/* reflect 2-fld. */
+        UVAR(pGrid->U,k,je+j,i,B2c)= -UVAR(pGrid->U,k,je+j,i,B2c);/* reflect 2-fld. */
 #endif
       }
     }
@@ -1204,10 +1654,10 @@ static void reflect_ix3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ks-k][j][i]    =  pGrid->U[ks+(k-1)][j][i];
-        pGrid->U[ks-k][j][i].M3 = -pGrid->U[ks-k][j][i].M3; /* reflect 3-mom. */
+        UCOPY(pGrid->U,ks-k,j,i,ks+(k-1),j,i);
+        UVAR(pGrid->U,ks-k,j,i,M3) = -UVAR(pGrid->U,ks-k,j,i,M3); /* reflect 3-mom. */
 #ifdef MHD
-        pGrid->U[ks-k][j][i].B3c= -pGrid->U[ks-k][j][i].B3c;/* reflect 3-fld.*/
+        UVAR(pGrid->U,ks-k,j,i,B3c)= -UVAR(pGrid->U,ks-k,j,i,B3c);/* reflect 3-fld.*/
 #endif
       }
     }
@@ -1264,10 +1714,10 @@ static void reflect_ox3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ke+k][j][i]    =  pGrid->U[ke-(k-1)][j][i];
-        pGrid->U[ke+k][j][i].M3 = -pGrid->U[ke+k][j][i].M3; /* reflect 3-mom. */
+        UCOPY(pGrid->U,ke+k,j,i,ke-(k-1),j,i);
+        UVAR(pGrid->U,ke+k,j,i,M3) = -UVAR(pGrid->U,ke+k,j,i,M3); /* reflect 3-mom. */
 #ifdef MHD
-        pGrid->U[ke+k][j][i].B3c= -pGrid->U[ke+k][j][i].B3c;/* reflect 3-fld. */
+        UVAR(pGrid->U,ke+k,j,i,B3c)= -UVAR(pGrid->U,ke+k,j,i,B3c);/* reflect 3-fld. */
 #endif
       }
     }
@@ -1327,7 +1777,7 @@ static void outflow_ix1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][is-i] = pGrid->U[k][j][is];
+        UCOPY(pGrid->U,k,j,is-i,k,j,is);
       }
     }
   }
@@ -1381,7 +1831,7 @@ static void outflow_ox1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][ie+i] = pGrid->U[k][j][ie];
+        UCOPY(pGrid->U,k,j,ie+i,k,j,ie);
       }
     }
   }
@@ -1435,7 +1885,7 @@ static void outflow_ix2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][js-j][i] = pGrid->U[k][js][i];
+        UCOPY(pGrid->U,k,js-j,i,k,js,i);
       }
     }
   }
@@ -1489,7 +1939,7 @@ static void outflow_ox2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][je+j][i] = pGrid->U[k][je][i];
+        UCOPY(pGrid->U,k,je+j,i,k,je,i);
       }
     }
   }
@@ -1540,7 +1990,7 @@ static void outflow_ix3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ks-k][j][i] = pGrid->U[ks][j][i];
+        UCOPY(pGrid->U,ks-k,j,i,ks,j,i);
       }
     }
   }
@@ -1591,7 +2041,7 @@ static void outflow_ox3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ke+k][j][i] = pGrid->U[ke][j][i];
+        UCOPY(pGrid->U,ke+k,j,i,ke,j,i);
       }
     }
   }
@@ -1645,7 +2095,7 @@ static void periodic_ix1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][is-i] = pGrid->U[k][j][ie-(i-1)];
+        UCOPY(pGrid->U,k,j,is-i,k,j,ie-(i-1));
       }
     }
   }
@@ -1699,7 +2149,7 @@ static void periodic_ox1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][ie+i] = pGrid->U[k][j][is+(i-1)];
+        UCOPY(pGrid->U,k,j,ie+i,k,j,is+(i-1));
       }
     }
   }
@@ -1753,7 +2203,7 @@ static void periodic_ix2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][js-j][i] = pGrid->U[k][je-(j-1)][i];
+        UCOPY(pGrid->U,k,js-j,i,k,je-(j-1),i);
       }
     }
   }
@@ -1807,7 +2257,7 @@ static void periodic_ox2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][je+j][i] = pGrid->U[k][js+(j-1)][i];
+        UCOPY(pGrid->U,k,je+j,i,k,js+(j-1),i);
       }
     }
   }
@@ -1858,7 +2308,7 @@ static void periodic_ix3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ks-k][j][i] = pGrid->U[ke-(k-1)][j][i];
+        UCOPY(pGrid->U,ks-k,j,i,ke-(k-1),j,i);
       }
     }
   }
@@ -1909,7 +2359,7 @@ static void periodic_ox3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ke+k][j][i] = pGrid->U[ks+(k-1)][j][i];
+        UCOPY(pGrid->U,ke+k,j,i,ks+(k-1),j,i);
       }
     }
   }
@@ -1963,11 +2413,11 @@ static void conduct_ix1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][is-i]    =  pGrid->U[k][j][is+(i-1)];
-        pGrid->U[k][j][is-i].M1 = -pGrid->U[k][j][is-i].M1; /* reflect 1-mom. */
+        UCOPY(pGrid->U,k,j,is-i,k,j,is+(i-1));
+        UVAR(pGrid->U,k,j,is-i,M1) = -UVAR(pGrid->U,k,j,is-i,M1); /* reflect 1-mom. */
 #ifdef MHD
-        pGrid->U[k][j][is-i].B2c= -pGrid->U[k][j][is-i].B2c;/* reflect fld */
-        pGrid->U[k][j][is-i].B3c= -pGrid->U[k][j][is-i].B3c;
+        UVAR(pGrid->U,k,j,is-i,B2c)= -UVAR(pGrid->U,k,j,is-i,B2c);/* reflect fld */
+        UVAR(pGrid->U,k,j,is-i,B3c)= -UVAR(pGrid->U,k,j,is-i,B3c);
 #endif
       }
     }
@@ -2022,11 +2472,11 @@ static void conduct_ox1(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=1; i<=nghost; i++) {
-        pGrid->U[k][j][ie+i]    =  pGrid->U[k][j][ie-(i-1)];
-        pGrid->U[k][j][ie+i].M1 = -pGrid->U[k][j][ie+i].M1; /* reflect 1-mom. */
+        UCOPY(pGrid->U,k,j,ie+i,k,j,ie-(i-1));
+        UVAR(pGrid->U,k,j,ie+i,M1) = -UVAR(pGrid->U,k,j,ie+i,M1); /* reflect 1-mom. */
 #ifdef MHD
-        pGrid->U[k][j][ie+i].B2c= -pGrid->U[k][j][ie+i].B2c;/* reflect fld */
-        pGrid->U[k][j][ie+i].B3c= -pGrid->U[k][j][ie+i].B3c;
+        UVAR(pGrid->U,k,j,ie+i,B2c)= -UVAR(pGrid->U,k,j,ie+i,B2c);/* reflect fld */
+        UVAR(pGrid->U,k,j,ie+i,B3c)= -UVAR(pGrid->U,k,j,ie+i,B3c);
 #endif
       }
     }
@@ -2081,11 +2531,11 @@ static void conduct_ix2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][js-j][i]    =  pGrid->U[k][js+(j-1)][i];
-        pGrid->U[k][js-j][i].M2 = -pGrid->U[k][js-j][i].M2; /* reflect 2-mom. */
+        UCOPY(pGrid->U,k,js-j,i,k,js+(j-1),i);
+        UVAR(pGrid->U,k,js-j,i,M2) = -UVAR(pGrid->U,k,js-j,i,M2); /* reflect 2-mom. */
 #ifdef MHD
-        pGrid->U[k][js-j][i].B1c= -pGrid->U[k][js-j][i].B1c;/* reflect fld */
-        pGrid->U[k][js-j][i].B3c= -pGrid->U[k][js-j][i].B3c;
+        UVAR(pGrid->U,k,js-j,i,B1c)= -UVAR(pGrid->U,k,js-j,i,B1c);/* reflect fld */
+        UVAR(pGrid->U,k,js-j,i,B3c)= -UVAR(pGrid->U,k,js-j,i,B3c);
 #endif
       }
     }
@@ -2140,11 +2590,11 @@ static void conduct_ox2(GridS *pGrid)
   for (k=ks; k<=ke; k++) {
     for (j=1; j<=nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[k][je+j][i]    =  pGrid->U[k][je-(j-1)][i];
-        pGrid->U[k][je+j][i].M2 = -pGrid->U[k][je+j][i].M2; /* reflect 2-mom. */
+        UCOPY(pGrid->U,k,je+j,i,k,je-(j-1),i);
+        UVAR(pGrid->U,k,je+j,i,M2) = -UVAR(pGrid->U,k,je+j,i,M2); /* reflect 2-mom. */
 #ifdef MHD
-        pGrid->U[k][je+j][i].B1c= -pGrid->U[k][je+j][i].B1c;/* reflect fld */
-        pGrid->U[k][je+j][i].B3c= -pGrid->U[k][je+j][i].B3c;
+        UVAR(pGrid->U,k,je+j,i,B1c)= -UVAR(pGrid->U,k,je+j,i,B1c);/* reflect fld */
+        UVAR(pGrid->U,k,je+j,i,B3c)= -UVAR(pGrid->U,k,je+j,i,B3c);
 #endif
       }
     }
@@ -2196,11 +2646,11 @@ static void conduct_ix3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ks-k][j][i]    =  pGrid->U[ks+(k-1)][j][i];
-        pGrid->U[ks-k][j][i].M3 = -pGrid->U[ks-k][j][i].M3; /* reflect 3-mom. */
+        UCOPY(pGrid->U,ks-k,j,i,ks+(k-1),j,i);
+        UVAR(pGrid->U,ks-k,j,i,M3) = -UVAR(pGrid->U,ks-k,j,i,M3); /* reflect 3-mom. */
 #ifdef MHD
-        pGrid->U[ks-k][j][i].B1c= -pGrid->U[ks-k][j][i].B1c;/* reflect fld */
-        pGrid->U[ks-k][j][i].B2c= -pGrid->U[ks-k][j][i].B2c;
+        UVAR(pGrid->U,ks-k,j,i,B1c)= -UVAR(pGrid->U,ks-k,j,i,B1c);/* reflect fld */
+        UVAR(pGrid->U,ks-k,j,i,B2c)= -UVAR(pGrid->U,ks-k,j,i,B2c);
 #endif
       }
     }
@@ -2252,11 +2702,11 @@ static void conduct_ox3(GridS *pGrid)
   for (k=1; k<=nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pGrid->U[ke+k][j][i]    =  pGrid->U[ke-(k-1)][j][i];
-        pGrid->U[ke+k][j][i].M3 = -pGrid->U[ke+k][j][i].M3; /* reflect 3-mom. */
+        UCOPY(pGrid->U,ke+k,j,i,ke-(k-1),j,i);
+        UVAR(pGrid->U,ke+k,j,i,M3) = -UVAR(pGrid->U,ke+k,j,i,M3); /* reflect 3-mom. */
 #ifdef MHD
-        pGrid->U[ke+k][j][i].B1c= -pGrid->U[ke+k][j][i].B1c;/* reflect fld */
-        pGrid->U[ke+k][j][i].B2c= -pGrid->U[ke+k][j][i].B2c;
+        UVAR(pGrid->U,ke+k,j,i,B1c)= -UVAR(pGrid->U,ke+k,j,i,B1c);/* reflect fld */
+        UVAR(pGrid->U,ke+k,j,i,B2c)= -UVAR(pGrid->U,ke+k,j,i,B2c);
 #endif
       }
     }
@@ -2324,26 +2774,28 @@ static void pack_ix1(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
+
+  ath_trace_begin("pack_ix1");
 
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=is+(nghost-1); i++){
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2378,6 +2830,7 @@ static void pack_ix1(GridS *pG)
   }
 #endif
 
+  ath_trace_end("pack_ix1");
   return;
 }
 
@@ -2397,26 +2850,28 @@ static void pack_ox1(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
+
+  ath_trace_begin("pack_ox1");
 
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=ie-(nghost-1); i<=ie; i++){
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2450,6 +2905,7 @@ static void pack_ox1(GridS *pG)
     }
   }
 #endif /* MHD */
+  ath_trace_end("pack_ox1");
   return;
 }
 
@@ -2469,26 +2925,28 @@ static void pack_ix2(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
+
+  ath_trace_begin("pack_ix2");
 
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=js+(nghost-1); j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2523,6 +2981,7 @@ static void pack_ix2(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("pack_ix2");
   return;
 }
 
@@ -2542,26 +3001,28 @@ static void pack_ox2(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
+
+  ath_trace_begin("pack_ox2");
 
   for (k=ks; k<=ke; k++){
     for (j=je-(nghost-1); j<=je; j++){
       for (i=is-nghost; i<=ie+nghost; i++){
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2596,6 +3057,7 @@ static void pack_ox2(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("pack_ox2");
   return;
 }
 
@@ -2612,26 +3074,28 @@ static void pack_ix3(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
+
+  ath_trace_begin("pack_ix3");
 
   for (k=ks; k<=ks+(nghost-1); k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2666,6 +3130,7 @@ static void pack_ix3(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("pack_ix3");
   return;
 }
 
@@ -2682,26 +3147,28 @@ static void pack_ox3(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
+
+  ath_trace_begin("pack_ox3");
 
   for (k=ke-(nghost-1); k<=ke; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        *(pSnd++) = pG->U[k][j][i].d;
-        *(pSnd++) = pG->U[k][j][i].M1;
-        *(pSnd++) = pG->U[k][j][i].M2;
-        *(pSnd++) = pG->U[k][j][i].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) *(pSnd++) = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
       }
     }
@@ -2736,6 +3203,7 @@ static void pack_ox3(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("pack_ox3");
   return;
 }
 
@@ -2755,26 +3223,28 @@ static void unpack_ix1(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
+
+  ath_trace_begin("unpack_ix1");
 
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is-nghost; i<=is-1; i++){
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -2809,6 +3279,7 @@ static void unpack_ix1(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ix1");
   return;
 }
 
@@ -2828,26 +3299,28 @@ static void unpack_ox1(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
+
+  ath_trace_begin("unpack_ox1");
 
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=ie+1; i<=ie+nghost; i++) {
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -2882,6 +3355,7 @@ static void unpack_ox1(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ox1");
   return;
 }
 
@@ -2901,26 +3375,28 @@ static void unpack_ix2(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
+
+  ath_trace_begin("unpack_ix2");
 
   for (k=ks; k<=ke; k++) {
     for (j=js-nghost; j<=js-1; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -2955,6 +3431,7 @@ static void unpack_ix2(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ix2");
   return;
 }
 
@@ -2974,26 +3451,28 @@ static void unpack_ox2(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
+
+  ath_trace_begin("unpack_ox2");
 
   for (k=ks; k<=ke; k++) {
     for (j=je+1; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -3028,6 +3507,7 @@ static void unpack_ox2(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ox2");
   return;
 }
 
@@ -3044,26 +3524,28 @@ static void unpack_ix3(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
+
+  ath_trace_begin("unpack_ix3");
 
   for (k=ks-nghost; k<=ks-1; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -3098,6 +3580,7 @@ static void unpack_ix3(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ix3");
   return;
 }
 
@@ -3114,26 +3597,28 @@ static void unpack_ox3(GridS *pG)
 #if (NSCALARS > 0)
   int n;
 #endif
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
+
+  ath_trace_begin("unpack_ox3");
 
   for (k=ke+1; k<=ke+nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        pG->U[k][j][i].d  = *(pRcv++);
-        pG->U[k][j][i].M1 = *(pRcv++);
-        pG->U[k][j][i].M2 = *(pRcv++);
-        pG->U[k][j][i].M3 = *(pRcv++);
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  = *(pRcv++);
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-        pG->U[k][j][i].B1c = *(pRcv++);
-        pG->U[k][j][i].B2c = *(pRcv++);
-        pG->U[k][j][i].B3c = *(pRcv++);
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
       }
     }
@@ -3168,6 +3653,692 @@ static void unpack_ox3(GridS *pG)
   }
 #endif /* MHD */
 
+  ath_trace_end("unpack_ox3");
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void persist_init(DomainS *pD)
+ *  \brief Creates persistent requests for the exchange of the Grid in Domain
+ *   pD with its L and R Grids in each direction.  These are restarted with
+ *   MPI_Start() on every call to bvals_mhd(), so the same peers, sizes and
+ *   send/receive buffers are used each time. */
+
+static void persist_init(DomainS *pD)
+{
+  GridS *pG = pD->Grid;
+  PersistRqS *pR;
+  MPI_Datatype type;
+  int cnt[3],lid[3],rid[3],dir,n,ierr;
+#ifdef MHD
+  int cnt2,cnt3;
+#endif
+
+  if ((persist_rq = (PersistRqS*)realloc(persist_rq,
+       (npersist_rq+1)*sizeof(PersistRqS))) == NULL)
+    ath_error("[bvals_init]: Failed to allocate MPI_Request arrays\n");
+  pR = &(persist_rq[npersist_rq++]);
+  pR->pD = pD;
+
+  lid[0] = pG->lx1_id;  rid[0] = pG->rx1_id;
+  lid[1] = pG->lx2_id;  rid[1] = pG->rx2_id;
+  lid[2] = pG->lx3_id;  rid[2] = pG->rx3_id;
+
+/* Number of words passed in x1/x2/x3-direction by pack_???() */
+
+  cnt[0] = nghost*(pG->Nx[1])*(pG->Nx[2])*(NVAR);
+#ifdef MHD
+  cnt2 = (pG->Nx[1] > 1) ? (pG->Nx[1] + 1) : 1;
+  cnt3 = (pG->Nx[2] > 1) ? (pG->Nx[2] + 1) : 1;
+  cnt[0] += (nghost-1)*(pG->Nx[1])*(pG->Nx[2]);
+  cnt[0] += nghost*cnt2*(pG->Nx[2]);
+  cnt[0] += nghost*(pG->Nx[1])*cnt3;
+#endif
+
+  cnt[1] = (pG->Nx[0] + 2*nghost)*nghost*(pG->Nx[2])*(NVAR);
+#ifdef MHD
+  cnt3 = (pG->Nx[2] > 1) ? (pG->Nx[2] + 1) : 1;
+  cnt[1] += (pG->Nx[0] + 2*nghost - 1)*nghost*(pG->Nx[2]);
+  cnt[1] += (pG->Nx[0] + 2*nghost)*(nghost-1)*(pG->Nx[2]);
+  cnt[1] += (pG->Nx[0] + 2*nghost)*nghost*cnt3;
+#endif
+
+  cnt[2] = (pG->Nx[0] + 2*nghost)*(pG->Nx[1] + 2*nghost)*nghost*(NVAR);
+#ifdef MHD
+  cnt[2] += (pG->Nx[0] + 2*nghost - 1)*(pG->Nx[1] + 2*nghost)*nghost;
+  cnt[2] += (pG->Nx[0] + 2*nghost)*(pG->Nx[1] + 2*nghost - 1)*nghost;
+  cnt[2] += (pG->Nx[0] + 2*nghost)*(pG->Nx[1] + 2*nghost)*(nghost-1);
+#endif
+
+  for (dir=0; dir<3; dir++) {
+    pR->cnt[dir] = cnt[dir];
+    pR->recv_rq[dir][0] = pR->recv_rq[dir][1] = MPI_REQUEST_NULL;
+    pR->send_rq[dir][0] = pR->send_rq[dir][1] = MPI_REQUEST_NULL;
+    if (pG->Nx[dir] == 1) continue;
+
+    halo_msg_type(cnt[dir], &n, &type);
+    if (lid[dir] >= 0) {
+      ierr = MPI_Recv_init(&(recv_buf[0][0]),n,type,lid[dir],
+        LtoR_tag, pD->Comm_Domain, &(pR->recv_rq[dir][0]));
+      ierr = MPI_Send_init(&(send_buf[0][0]),n,type,lid[dir],
+        RtoL_tag, pD->Comm_Domain, &(pR->send_rq[dir][0]));
+    }
+    if (rid[dir] >= 0) {
+      ierr = MPI_Recv_init(&(recv_buf[1][0]),n,type,rid[dir],
+        RtoL_tag, pD->Comm_Domain, &(pR->recv_rq[dir][1]));
+      ierr = MPI_Send_init(&(send_buf[1][0]),n,type,rid[dir],
+        LtoR_tag, pD->Comm_Domain, &(pR->send_rq[dir][1]));
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static PersistRqS *persist_find(const DomainS *pD)
+ *  \brief Returns persistent requests created for Domain pD. */
+
+static PersistRqS *persist_find(const DomainS *pD)
+{
+  int n;
+
+  for (n=0; n<npersist_rq; n++)
+    if (persist_rq[n].pD == pD) return &(persist_rq[n]);
+  ath_error("[bvals_mhd]: no MPI requests for level %d domain %d\n",
+    pD->Level,pD->DomNumber);
+  return NULL;
+}
+
+#ifdef SHM_BVALS
+/*----------------------------------------------------------------------------*/
+/*! \fn static void shm_alloc(MeshS *pM, const int size)
+ *  \brief Allocates the two send buffers of this rank, each of size words,
+ *   in a window shared by all ranks on the node, after a header of ready
+ *   and ack flags for each face of each Domain.  The first word of the
+ *   header is size, so neighbours can find the buffers.  Collective over
+ *   MPI_COMM_WORLD.
+ */
+
+static void shm_alloc(MeshS *pM, const int size)
+{
+  MPI_Aint bytes;
+  void *base;
+  int nl,ndom=0,n,ierr;
+
+  for (nl=0; nl<(pM->NLevels); nl++) ndom += pM->DomainsPerLevel[nl];
+
+/* round header up to a cache line, so buffers are aligned */
+  shm_hdr = (1 + 12*ndom)*sizeof(long);
+  shm_hdr = 64*((shm_hdr + 63)/64);
+  bytes = shm_hdr + 2*(MPI_Aint)size*sizeof(GReal);
+
+  ierr = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+    MPI_INFO_NULL, &comm_node);
+  ierr = MPI_Win_allocate_shared(bytes, 1, MPI_INFO_NULL, comm_node, &base,
+    &shm_win);
+  if (ierr != MPI_SUCCESS)
+    ath_error("[bvals_init]: Failed to allocate shared-memory window\n");
+  ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK, shm_win);
+
+  shm_flag = (volatile long*)base;
+  shm_flag[0] = size;
+  for (n=1; n<=12*ndom; n++) shm_flag[n] = 0;
+
+  if (size > 0) {
+    if ((send_buf = (GReal**)calloc_1d_array(2,sizeof(GReal*))) == NULL)
+      ath_error("[bvals_init]: Failed to allocate send buffer\n");
+    send_buf[0] = (GReal*)((char*)base + shm_hdr);
+    send_buf[1] = send_buf[0] + size;
+  }
+
+/* make headers visible before neighbours read them in shm_init() */
+  ierr = MPI_Win_sync(shm_win);
+  ierr = MPI_Barrier(comm_node);
+  ierr = MPI_Win_sync(shm_win);
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void shm_init(DomainS *pD, const int g)
+ *  \brief Finds the face neighbours of the Grid in Domain pD (the g-th
+ *   Domain of the Mesh) that are on the same node, and the addresses of
+ *   their send buffers and flags.  If there are none the Domain uses only
+ *   messages.
+ */
+
+static void shm_init(DomainS *pD, const int g)
+{
+  GridS *pG = pD->Grid;
+  ShmS *pS;
+  MPI_Group grp_dom, grp_node;
+  MPI_Aint sz;
+  char *base;
+  int id[6],rk[6],f,nnode=0,du,ierr;
+
+  id[0] = pG->lx1_id;  id[1] = pG->rx1_id;
+  id[2] = pG->lx2_id;  id[3] = pG->rx2_id;
+  id[4] = pG->lx3_id;  id[5] = pG->rx3_id;
+
+  ierr = MPI_Comm_group(pD->Comm_Domain, &grp_dom);
+  ierr = MPI_Comm_group(comm_node, &grp_node);
+  for (f=0; f<6; f++) {
+    rk[f] = MPI_UNDEFINED;
+    if (pG->Nx[f/2] == 1 || id[f] < 0) continue;
+    ierr = MPI_Group_translate_ranks(grp_dom, 1, &(id[f]), grp_node, &(rk[f]));
+    if (rk[f] != MPI_UNDEFINED) nnode++;
+  }
+  ierr = MPI_Group_free(&grp_dom);
+  ierr = MPI_Group_free(&grp_node);
+  if (nnode == 0) return;
+
+  if ((shm = (ShmS*)realloc(shm, (nshm+1)*sizeof(ShmS))) == NULL)
+    ath_error("[bvals_init]: Failed to allocate shared-memory exchange\n");
+  pS = &(shm[nshm++]);
+  pS->pD = pD;
+  pS->g = g;
+  pS->seq = 0;
+
+/* The neighbour at face f sends from its face f^1, so its flags for that
+ * face are read, and its send buffer 1-(f%2) is unpacked */
+
+  for (f=0; f<6; f++) {
+    pS->nbr_buf[f] = NULL;
+    pS->nbr_flag[f] = NULL;
+    if (rk[f] == MPI_UNDEFINED) continue;
+    ierr = MPI_Win_shared_query(shm_win, rk[f], &sz, &du, &base);
+    pS->nbr_flag[f] = (volatile long*)base + SHM_FLAG(g,f^1);
+    pS->nbr_buf[f] = (GReal*)(base + shm_hdr) +
+      (1 - f%2)*((volatile long*)base)[0];
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static ShmS *shm_find(const DomainS *pD)
+ *  \brief Returns shared-memory exchange set up for Domain pD, or NULL. */
+
+static ShmS *shm_find(const DomainS *pD)
+{
+  int n;
+
+  for (n=0; n<nshm; n++) if (shm[n].pD == pD) return &(shm[n]);
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void shm_post(DomainS *pD, ShmS *pS, PersistRqS *pR,
+ *                           const int dir)
+ *  \brief Starts the exchange in direction dir: starts receives from Grids
+ *   on other nodes, packs data for both neighbours and either sets the
+ *   ready flag (same node) or starts the send, then sets physical BCs.
+ */
+
+static void shm_post(DomainS *pD, ShmS *pS, PersistRqS *pR, const int dir)
+{
+  GridS *pG = pD->Grid;
+  static void (*const pack[6])(GridS *pG) = {pack_ix1, pack_ox1,
+    pack_ix2, pack_ox2, pack_ix3, pack_ox3};
+  VGFun_t bc[2];
+  int id[2],lr,ierr;
+
+  switch (dir) {
+  case 0:
+    id[0] = pG->lx1_id;  id[1] = pG->rx1_id;
+    bc[0] = pD->ix1_BCFun;  bc[1] = pD->ox1_BCFun;
+    break;
+  case 1:
+    id[0] = pG->lx2_id;  id[1] = pG->rx2_id;
+    bc[0] = pD->ix2_BCFun;  bc[1] = pD->ox2_BCFun;
+    break;
+  default:
+    id[0] = pG->lx3_id;  id[1] = pG->rx3_id;
+    bc[0] = pD->ix3_BCFun;  bc[1] = pD->ox3_BCFun;
+  }
+
+  for (lr=0; lr<2; lr++)
+    if (id[lr] >= 0 && pS->nbr_buf[2*dir+lr] == NULL)
+      ierr = MPI_Start(&(pR->recv_rq[dir][lr]));
+
+  for (lr=0; lr<2; lr++) {
+    if (id[lr] < 0) continue;
+    (*(pack[2*dir+lr]))(pG);
+    if (pS->nbr_buf[2*dir+lr] == NULL) {
+      halo_compress(send_buf[lr], pR->cnt[dir]);
+      ierr = MPI_Start(&(pR->send_rq[dir][lr]));
+    } else {
+      ierr = MPI_Win_sync(shm_win);
+      shm_flag[SHM_FLAG(pS->g,2*dir+lr)] = pS->seq;
+    }
+  }
+
+  for (lr=0; lr<2; lr++) if (id[lr] < 0) (*(bc[lr]))(pG);
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void shm_complete(DomainS *pD, ShmS *pS, PersistRqS *pR,
+ *                               const int dir)
+ *  \brief Completes the exchange in direction dir started by shm_post().
+ *   Messages are received first, and sends completed before waiting for
+ *   neighbours on the node to read this rank's send buffers, so that ranks
+ *   spinning on flags never hold up messages to other nodes.
+ */
+
+static void shm_complete(DomainS *pD, ShmS *pS, PersistRqS *pR,
+                         const int dir)
+{
+  GridS *pG = pD->Grid;
+  static void (*const unpack[6])(GridS *pG) = {unpack_ix1, unpack_ox1,
+    unpack_ix2, unpack_ox2, unpack_ix3, unpack_ox3};
+  GReal *pRcv;
+  int id[2],lr,f,ierr;
+
+  switch (dir) {
+  case 0:  id[0] = pG->lx1_id;  id[1] = pG->rx1_id;  break;
+  case 1:  id[0] = pG->lx2_id;  id[1] = pG->rx2_id;  break;
+  default: id[0] = pG->lx3_id;  id[1] = pG->rx3_id;
+  }
+
+/* receive and unpack data from Grids on other nodes */
+
+  for (lr=0; lr<2; lr++) {
+    f = 2*dir + lr;
+    if (id[lr] < 0 || pS->nbr_buf[f] != NULL) continue;
+    ierr = MPI_Wait(&(pR->recv_rq[dir][lr]), MPI_STATUS_IGNORE);
+    halo_expand(recv_buf[lr], pR->cnt[dir]);
+    (*(unpack[f]))(pG);
+  }
+
+/* unpack data of Grids on this node from their send buffer, by pointing
+ * recv_buf at it, and tell them it has been read */
+
+  for (lr=0; lr<2; lr++) {
+    f = 2*dir + lr;
+    if (id[lr] < 0 || pS->nbr_buf[f] == NULL) continue;
+    shm_wait(pS->nbr_flag[f], pS->seq);
+    pRcv = recv_buf[lr];
+    recv_buf[lr] = pS->nbr_buf[f];
+    (*(unpack[f]))(pG);
+    recv_buf[lr] = pRcv;
+    ierr = MPI_Win_sync(shm_win);
+    pS->nbr_flag[f][1] = pS->seq;
+  }
+
+/* send buffers can be reused once sends are complete and read on node */
+
+  for (lr=0; lr<2; lr++) {
+    f = 2*dir + lr;
+    if (id[lr] < 0 || pS->nbr_buf[f] != NULL) continue;
+    ierr = MPI_Wait(&(pR->send_rq[dir][lr]), MPI_STATUS_IGNORE);
+  }
+  for (lr=0; lr<2; lr++) {
+    f = 2*dir + lr;
+    if (id[lr] < 0 || pS->nbr_buf[f] == NULL) continue;
+    shm_wait(&(shm_flag[SHM_FLAG(pS->g,f)+1]), pS->seq);
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void shm_wait(volatile long *flag, const long seq)
+ *  \brief Spins until a flag in the shared-memory window reaches seq.  The
+ *   MPI_Win_sync() calls order the flag with the data written before it.
+ */
+
+static void shm_wait(volatile long *flag, const long seq)
+{
+  while (*flag < seq) MPI_Win_sync(shm_win);
+  MPI_Win_sync(shm_win);
+
+  return;
+}
+#endif /* SHM_BVALS */
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void halo26_init(DomainS *pD)
+ *  \brief Sets up the single-phase exchange for the Grid in Domain pD, with
+ *   persistent requests to and from each of its 2 (1D), 8 (2D) or 26 (3D)
+ *   face, edge and corner neighbours.
+ *
+ *   Corner cells are received directly from the diagonal neighbours instead
+ *   of being relayed through the x1-x2-x3 sequence, so every boundary of
+ *   every Grid in the Domain must be an MPI boundary, or periodic with one
+ *   Grid in that direction (the Grid is then its own neighbour).  Otherwise
+ *   (physical or fine/coarse boundaries, or the shearing box, which remaps
+ *   ghost zones between the x2 and x3 steps) a warning is printed and the
+ *   Domain uses the three-phase exchange.  Collective over pD->Comm_Domain.
+ */
+
+static void halo26_init(DomainS *pD)
+{
+  GridS *pG = pD->Grid;
+  Halo26S *pH;
+  MPI_Datatype type;
+  int myL,myM,myN,l,m,n,nb,id,ierr,ok,all_ok,rank,cnt;
+  int o[3],scnt[26],rcnt[26],ssize=0,rsize=0;
+
+/* Check all boundaries of all Grids in Domain are periodic or MPI */
+
+  ok = 1;
+#ifdef SHEARING_BOX
+  ok = 0;
+#endif
+  if (pG->Nx[0] > 1) {
+    if (pG->lx1_id < 0 && !(pD->NGrid[0] == 1 && pD->ix1_BCFun == periodic_ix1))
+      ok = 0;
+    if (pG->rx1_id < 0 && !(pD->NGrid[0] == 1 && pD->ox1_BCFun == periodic_ox1))
+      ok = 0;
+  }
+  if (pG->Nx[1] > 1) {
+    if (pG->lx2_id < 0 && !(pD->NGrid[1] == 1 && pD->ix2_BCFun == periodic_ix2))
+      ok = 0;
+    if (pG->rx2_id < 0 && !(pD->NGrid[1] == 1 && pD->ox2_BCFun == periodic_ox2))
+      ok = 0;
+  }
+  if (pG->Nx[2] > 1) {
+    if (pG->lx3_id < 0 && !(pD->NGrid[2] == 1 && pD->ix3_BCFun == periodic_ix3))
+      ok = 0;
+    if (pG->rx3_id < 0 && !(pD->NGrid[2] == 1 && pD->ox3_BCFun == periodic_ox3))
+      ok = 0;
+  }
+
+  ierr = MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, pD->Comm_Domain);
+  if (all_ok == 0) {
+    ierr = MPI_Comm_rank(pD->Comm_Domain, &rank);
+    if (rank == 0)
+      ath_perr(-1,"[bvals_mhd_init]: single-phase exchange not used on level %d domain %d, not all boundaries periodic or MPI\n",
+        pD->Level,pD->DomNumber);
+    return;
+  }
+
+/* List neighbours, with number of words passed to and from each */
+
+  nb = 0;
+  for (o[2]=-1; o[2]<=1; o[2]++) {
+  for (o[1]=-1; o[1]<=1; o[1]++) {
+  for (o[0]=-1; o[0]<=1; o[0]++) {
+    if (o[0] == 0 && o[1] == 0 && o[2] == 0) continue;
+    if ((o[0] != 0 && pG->Nx[0] == 1) || (o[1] != 0 && pG->Nx[1] == 1) ||
+        (o[2] != 0 && pG->Nx[2] == 1)) continue;
+    scnt[nb] = halo26_count(pG, o, 1);
+    rcnt[nb] = halo26_count(pG, o, 0);
+    ssize += scnt[nb];
+    rsize += rcnt[nb];
+    nb++;
+  }}}
+
+  if ((halo26 = (Halo26S*)realloc(halo26, (nhalo26+1)*sizeof(Halo26S)))
+      == NULL)
+    ath_error("[bvals_init]: Failed to allocate single-phase exchange\n");
+  pH = &(halo26[nhalo26++]);
+  pH->pD = pD;
+  pH->nnb = nb;
+
+  if ((pH->send[0] = (GReal*)calloc_1d_array(ssize,sizeof(GReal))) == NULL)
+    ath_error("[bvals_init]: Failed to allocate single-phase send buffer\n");
+  if ((pH->recv[0] = (GReal*)calloc_1d_array(rsize,sizeof(GReal))) == NULL)
+    ath_error("[bvals_init]: Failed to allocate single-phase recv buffer\n");
+
+/* Create persistent requests.  Tags are halo26_tag plus the index of the
+ * direction of travel, so messages between the same two Grids in different
+ * directions (with two or one Grids in a periodic direction) are distinct. */
+
+  get_myGridIndex(pD, myID_Comm_world, &myL, &myM, &myN);
+  nb = 0;
+  for (o[2]=-1; o[2]<=1; o[2]++) {
+  for (o[1]=-1; o[1]<=1; o[1]++) {
+  for (o[0]=-1; o[0]<=1; o[0]++) {
+    if (o[0] == 0 && o[1] == 0 && o[2] == 0) continue;
+    if ((o[0] != 0 && pG->Nx[0] == 1) || (o[1] != 0 && pG->Nx[1] == 1) ||
+        (o[2] != 0 && pG->Nx[2] == 1)) continue;
+
+    pH->off[nb][0] = o[0];
+    pH->off[nb][1] = o[1];
+    pH->off[nb][2] = o[2];
+    if (nb > 0) {
+      pH->send[nb] = pH->send[nb-1] + scnt[nb-1];
+      pH->recv[nb] = pH->recv[nb-1] + rcnt[nb-1];
+    }
+
+    l = (myL + o[0] + pD->NGrid[0]) % pD->NGrid[0];
+    m = (myM + o[1] + pD->NGrid[1]) % pD->NGrid[1];
+    n = (myN + o[2] + pD->NGrid[2]) % pD->NGrid[2];
+    id = pD->GData[n][m][l].ID_Comm_Domain;
+
+    halo_msg_type(rcnt[nb], &cnt, &type);
+    ierr = MPI_Recv_init(pH->recv[nb], cnt, type, id,
+      halo26_tag + (1-o[0]) + 3*(1-o[1]) + 9*(1-o[2]), pD->Comm_Domain,
+      &(pH->rq[nb]));
+    halo_msg_type(scnt[nb], &cnt, &type);
+    ierr = MPI_Send_init(pH->send[nb], cnt, type, id,
+      halo26_tag + (1+o[0]) + 3*(1+o[1]) + 9*(1+o[2]), pD->Comm_Domain,
+      &(pH->rq[pH->nnb+nb]));
+    nb++;
+  }}}
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static Halo26S *halo26_find(const DomainS *pD)
+ *  \brief Returns single-phase exchange set up for Domain pD, or NULL. */
+
+static Halo26S *halo26_find(const DomainS *pD)
+{
+  int n;
+
+  for (n=0; n<nhalo26; n++) if (halo26[n].pD == pD) return &(halo26[n]);
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void halo26_range(const GridS *pG, const int dir, const int o,
+ *                               const int stag, const int snd, int *lo,
+ *                               int *hi)
+ *  \brief Sets [lo,hi], the range of indices in direction dir (0,1,2 for
+ *   x1,x2,x3) of the region sent to (snd=1) or received from (snd=0) the
+ *   neighbour at offset o (-1,0,1) in that direction.
+ *
+ *   With stag=1 the range is for the face-centered field normal to dir.  The
+ *   ranges are the same as those of the pack_???() and unpack_???()
+ *   functions, so the ghost zones set are the same as with bvals_mhd(): the
+ *   face shared with a neighbour is not passed, and B1i is not set at
+ *   i=is-nghost (and similarly B2i, B3i).
+ */
+
+static void halo26_range(const GridS *pG, const int dir, const int o,
+                         const int stag, const int snd, int *lo, int *hi)
+{
+  int s = (dir == 0) ? pG->is : ((dir == 1) ? pG->js : pG->ks);
+  int e = (dir == 0) ? pG->ie : ((dir == 1) ? pG->je : pG->ke);
+
+  if (o == 0) {
+    *lo = s;
+    *hi = (stag && pG->Nx[dir] > 1) ? e+1 : e;
+  } else if (snd) {
+    *lo = (o < 0) ? s + stag : e-(nghost-1) + stag;
+    *hi = (o < 0) ? s+(nghost-1) : e;
+  } else {
+    *lo = (o < 0) ? s-nghost + stag : e+1 + stag;
+    *hi = (o < 0) ? s-1 : e+nghost;
+  }
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int halo26_count(const GridS *pG, const int *o, const int snd)
+ *  \brief Number of words sent to (snd=1) or received from (snd=0) the
+ *   neighbour at offset (o[0],o[1],o[2]). */
+
+static int halo26_count(const GridS *pG, const int *o, const int snd)
+{
+  int lo[3],hi[3],dir,cnt;
+#ifdef MHD
+  int stag;
+#endif
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],0,snd,&lo[dir],&hi[dir]);
+  cnt = (NVAR)*(hi[0]-lo[0]+1)*(hi[1]-lo[1]+1)*(hi[2]-lo[2]+1);
+
+#ifdef MHD
+  for (stag=0; stag<3; stag++) {
+    for (dir=0; dir<3; dir++)
+      halo26_range(pG,dir,o[dir],(dir == stag),snd,&lo[dir],&hi[dir]);
+    cnt += (hi[0]-lo[0]+1)*(hi[1]-lo[1]+1)*(hi[2]-lo[2]+1);
+  }
+#endif
+
+  return cnt;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void halo26_pack(GridS *pG, const int *o, GReal *pSnd)
+ *  \brief PACK data for MPI_Start, neighbour at offset (o[0],o[1],o[2]) */
+
+static void halo26_pack(GridS *pG, const int *o, GReal *pSnd)
+{
+  int lo[3],hi[3],dir,i,j,k;
+#if (NSCALARS > 0)
+  int n;
+#endif
+
+  ath_trace_begin("halo26_pack");
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],0,1,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        *(pSnd++) = UVAR(pG->U,k,j,i,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3);
+#ifndef BAROTROPIC
+        *(pSnd++) = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
+#endif
+      }
+    }
+  }
+
+#ifdef MHD
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==0),1,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        *(pSnd++) = pG->B1i[k][j][i];
+      }
+    }
+  }
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==1),1,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        *(pSnd++) = pG->B2i[k][j][i];
+      }
+    }
+  }
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==2),1,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        *(pSnd++) = pG->B3i[k][j][i];
+      }
+    }
+  }
+#endif /* MHD */
+
+  ath_trace_end("halo26_pack");
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void halo26_unpack(GridS *pG, const int *o, GReal *pRcv)
+ *  \brief UNPACK data from MPI_Start, neighbour at offset (o[0],o[1],o[2]) */
+
+static void halo26_unpack(GridS *pG, const int *o, GReal *pRcv)
+{
+  int lo[3],hi[3],dir,i,j,k;
+#if (NSCALARS > 0)
+  int n;
+#endif
+
+  ath_trace_begin("halo26_unpack");
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],0,0,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+        UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+        UVAR(pG->U,k,j,i,M3) = *(pRcv++);
+#ifndef BAROTROPIC
+        UVAR(pG->U,k,j,i,E)  = *(pRcv++);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+        UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
+#endif
+      }
+    }
+  }
+
+#ifdef MHD
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==0),0,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        pG->B1i[k][j][i] = *(pRcv++);
+      }
+    }
+  }
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==1),0,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        pG->B2i[k][j][i] = *(pRcv++);
+      }
+    }
+  }
+
+  for (dir=0; dir<3; dir++)
+    halo26_range(pG,dir,o[dir],(dir==2),0,&lo[dir],&hi[dir]);
+  for (k=lo[2]; k<=hi[2]; k++) {
+    for (j=lo[1]; j<=hi[1]; j++) {
+      for (i=lo[0]; i<=hi[0]; i++) {
+        pG->B3i[k][j][i] = *(pRcv++);
+      }
+    }
+  }
+#endif /* MHD */
+
+  ath_trace_end("halo26_unpack");
   return;
 }
 #endif /* MPI_PARALLEL */
@@ -155,7 +155,6 @@ void ShearingSheet_ix1(DomainS *pD)
   int ierr,sendto_id,getfrom_id;
   double *pSnd,*pRcv;
   Remap *pRemap;
-  ConsS *pCons;
   MPI_Request rq;
 #endif
 
@@ -196,26 +195,26 @@ void ShearingSheet_ix1(DomainS *pD)
     for(j=js-nghost; j<=je+nghost; j++){
       for(i=0; i<nghost; i++){
         ii = is-nghost+i;
-        GhstZns[k][i][j].U[0] = pG->U[k][j][ii].d;
-        GhstZns[k][i][j].U[1] = pG->U[k][j][ii].M1;
-        GhstZns[k][i][j].U[2] = pG->U[k][j][ii].M2;
+        GhstZns[k][i][j].U[0] = UVAR(pG->U,k,j,ii,d);
+        GhstZns[k][i][j].U[1] = UVAR(pG->U,k,j,ii,M1);
+        GhstZns[k][i][j].U[2] = UVAR(pG->U,k,j,ii,M2);
 #ifndef FARGO
-        GhstZns[k][i][j].U[2] += qomL*pG->U[k][j][ii].d;
+        GhstZns[k][i][j].U[2] += qomL*UVAR(pG->U,k,j,ii,d);
 #endif
-        GhstZns[k][i][j].U[3] = pG->U[k][j][ii].M3;
+        GhstZns[k][i][j].U[3] = UVAR(pG->U,k,j,ii,M3);
 #ifdef ADIABATIC
 /* No change in the internal energy */
-        GhstZns[k][i][j].U[4] = pG->U[k][j][ii].E + (0.5/GhstZns[k][i][j].U[0])*
-          (SQR(GhstZns[k][i][j].U[2]) - SQR(pG->U[k][j][ii].M2));
+        GhstZns[k][i][j].U[4] = UVAR(pG->U,k,j,ii,E) + (0.5/GhstZns[k][i][j].U[0])*
+          (SQR(GhstZns[k][i][j].U[2]) - SQR(UVAR(pG->U,k,j,ii,M2)));
 #endif /* ADIABATIC */
 #ifdef MHD
-        GhstZns[k][i][j].U[NREMAP-4] = pG->U[k][j][ii].B1c;
+        GhstZns[k][i][j].U[NREMAP-4] = UVAR(pG->U,k,j,ii,B1c);
         GhstZns[k][i][j].U[NREMAP-3] = pG->B1i[k][j][ii];
         GhstZns[k][i][j].U[NREMAP-2] = pG->B2i[k][j][ii];
         GhstZns[k][i][j].U[NREMAP-1] = pG->B3i[k][j][ii];
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for(n=0; n<NSCALARS; n++) GhstZns[k][i][j].s[n] = pG->U[k][j][ii].s[n];
+        for(n=0; n<NSCALARS; n++) GhstZns[k][i][j].s[n] = UVAR(pG->U,k,j,ii,s[n]);
 #endif
       }
     }
@@ -442,22 +441,22 @@ void ShearingSheet_ix1(DomainS *pD)
   for(k=ks; k<=ke; k++) {
     for(j=js; j<=je; j++){
       for(i=0; i<nghost; i++){
-        pG->U[k][j][is-nghost+i].d  = GhstZns[k][i][j].U[0];
-        pG->U[k][j][is-nghost+i].M1 = GhstZns[k][i][j].U[1];
-        pG->U[k][j][is-nghost+i].M2 = GhstZns[k][i][j].U[2];
-        pG->U[k][j][is-nghost+i].M3 = GhstZns[k][i][j].U[3];
+        UVAR(pG->U,k,j,is-nghost+i,d)  = GhstZns[k][i][j].U[0];
+        UVAR(pG->U,k,j,is-nghost+i,M1) = GhstZns[k][i][j].U[1];
+        UVAR(pG->U,k,j,is-nghost+i,M2) = GhstZns[k][i][j].U[2];
+        UVAR(pG->U,k,j,is-nghost+i,M3) = GhstZns[k][i][j].U[3];
 #ifdef ADIABATIC
-        pG->U[k][j][is-nghost+i].E  = GhstZns[k][i][j].U[4];
+        UVAR(pG->U,k,j,is-nghost+i,E)  = GhstZns[k][i][j].U[4];
 #endif /* ADIABATIC */
 #ifdef MHD
-        pG->U[k][j][is-nghost+i].B1c = GhstZns[k][i][j].U[NREMAP-4];
+        UVAR(pG->U,k,j,is-nghost+i,B1c) = GhstZns[k][i][j].U[NREMAP-4];
         pG->B1i[k][j][is-nghost+i] = GhstZns[k][i][j].U[NREMAP-3];
         pG->B2i[k][j][is-nghost+i] = GhstZns[k][i][j].U[NREMAP-2];
         pG->B3i[k][j][is-nghost+i] = GhstZns[k][i][j].U[NREMAP-1];
 #endif /* MHD */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) {
-          pG->U[k][j][is-nghost+i].s[n] = GhstZns[k][i][j].s[n];
+          UVAR(pG->U,k,j,is-nghost+i,s[n]) = GhstZns[k][i][j].s[n];
         }
 #endif
       }
@@ -484,7 +483,7 @@ void ShearingSheet_ix1(DomainS *pD)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for(i=is-nghost; i<is; i++){
-        pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i]+pG->B2i[k][j+1][i]);
+        UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i]+pG->B2i[k][j+1][i]);
       }
     }
   }
@@ -492,7 +491,7 @@ void ShearingSheet_ix1(DomainS *pD)
     for (k=ks; k<=ke; k++) {
       for (j=js; j<=je; j++) {
         for(i=is-nghost; i<is; i++){
-          pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i]+pG->B3i[k+1][j][i]);
+          UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i]+pG->B3i[k+1][j][i]);
         }
       }
     }
@@ -508,8 +507,8 @@ void ShearingSheet_ix1(DomainS *pD)
     for(k=ks; k<=ke; k++) {
       for(j=1; j<=nghost; j++){
         for(i=is-nghost; i<is; i++){
-          pG->U[k][js-j][i] = pG->U[k][je-(j-1)][i];
-          pG->U[k][je+j][i] = pG->U[k][js+(j-1)][i];
+          UCOPY(pG->U,k,js-j,i,k,je-(j-1),i);
+          UCOPY(pG->U,k,je+j,i,k,js+(j-1),i);
 #ifdef MHD
           pG->B1i[k][js-j][i] = pG->B1i[k][je-(j-1)][i];
           pG->B2i[k][js-j][i] = pG->B2i[k][je-(j-1)][i];
@@ -550,26 +549,23 @@ void ShearingSheet_ix1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=je-nghost+1; j<=je; j++){
         for (i=is-nghost; i<is; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          *(pSnd++) = pCons->d;
-          *(pSnd++) = pCons->M1;
-          *(pSnd++) = pCons->M2;
-          *(pSnd++) = pCons->M3;
+          *(pSnd++) = UVAR(pG->U,k,j,i,d);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) = pCons->E;
+          *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          *(pSnd++) = pCons->B1c;
-          *(pSnd++) = pCons->B2c;
-          *(pSnd++) = pCons->B3c;
+          *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
           *(pSnd++) = pG->B1i[k][j][i];
           *(pSnd++) = pG->B2i[k][j][i];
           *(pSnd++) = pG->B3i[k][j][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) *(pSnd++) = pCons->s[n];
+          for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
         }
       }
@@ -586,26 +582,23 @@ void ShearingSheet_ix1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=js-nghost; j<=js-1; j++){
         for (i=is-nghost; i<is; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          pCons->d  = *(pRcv++);
-          pCons->M1 = *(pRcv++);
-          pCons->M2 = *(pRcv++);
-          pCons->M3 = *(pRcv++);
+          UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+          UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-          pCons->E  = *(pRcv++);
+          UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          pCons->B1c = *(pRcv++);
-          pCons->B2c = *(pRcv++);
-          pCons->B3c = *(pRcv++);
+          UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
           pG->B1i[k][j][i] = *(pRcv++);
           pG->B2i[k][j][i] = *(pRcv++);
           pG->B3i[k][j][i] = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) pCons->s[n] = *(pRcv++);
+          for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
         }
       }
@@ -619,26 +612,23 @@ void ShearingSheet_ix1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=js; j<=js+nghost-1; j++){
         for (i=is-nghost; i<is; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          *(pSnd++) = pCons->d;
-          *(pSnd++) = pCons->M1;
-          *(pSnd++) = pCons->M2;
-          *(pSnd++) = pCons->M3;
+          *(pSnd++) = UVAR(pG->U,k,j,i,d);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) = pCons->E;
+          *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          *(pSnd++) = pCons->B1c;
-          *(pSnd++) = pCons->B2c;
-          *(pSnd++) = pCons->B3c;
+          *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
           *(pSnd++) = pG->B1i[k][j][i];
           *(pSnd++) = pG->B2i[k][j][i];
           *(pSnd++) = pG->B3i[k][j][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) *(pSnd++) = pCons->s[n];
+          for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
         }
       }
@@ -655,26 +645,23 @@ void ShearingSheet_ix1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=je+1; j<=je+nghost; j++){
         for (i=is-nghost; i<is; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          pCons->d  = *(pRcv++);
-          pCons->M1 = *(pRcv++);
-          pCons->M2 = *(pRcv++);
-          pCons->M3 = *(pRcv++);
+          UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+          UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-          pCons->E  = *(pRcv++);
+          UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          pCons->B1c = *(pRcv++);
-          pCons->B2c = *(pRcv++);
-          pCons->B3c = *(pRcv++);
+          UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
           pG->B1i[k][j][i] = *(pRcv++);
           pG->B2i[k][j][i] = *(pRcv++);
           pG->B3i[k][j][i] = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) pCons->s[n] = *(pRcv++);
+          for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
         }
       }
@@ -689,8 +676,8 @@ void ShearingSheet_ix1(DomainS *pD)
 #ifdef MHD
   for (k=ks; k<=ke; k++) {
     for(i=is-nghost; i<is; i++){
-      pG->U[k][je  ][i].B2c = 0.5*(pG->B2i[k][je+1][i]+pG->B2i[k][je][i]);
-      pG->U[k][js-1][i].B2c = 0.5*(pG->B2i[k][js-1][i]+pG->B2i[k][js][i]);
+      UVAR(pG->U,k,je,i,B2c) = 0.5*(pG->B2i[k][je+1][i]+pG->B2i[k][je][i]);
+      UVAR(pG->U,k,js-1,i,B2c) = 0.5*(pG->B2i[k][js-1][i]+pG->B2i[k][js][i]);
     }
   }
 #endif /* MHD */
@@ -709,11 +696,11 @@ void ShearingSheet_ix1(DomainS *pD)
       for (i=1; i<=nghost; i++) {
 #ifdef ADIABATIC
 /* No change in the internal energy */
-        pG->U[ks][j][is-i].E += (0.5/pG->U[ks][j][is-i].d)*
-         (SQR((pG->U[ks][j][is-i].M3 + qomL*pG->U[ks][j][is-i].d))
-        - SQR(pG->U[ks][j][is-i].M3));
+        UVAR(pG->U,ks,j,is-i,E) += (0.5/UVAR(pG->U,ks,j,is-i,d))*
+         (SQR((UVAR(pG->U,ks,j,is-i,M3) + qomL*UVAR(pG->U,ks,j,is-i,d)))
+        - SQR(UVAR(pG->U,ks,j,is-i,M3)));
 #endif
-        pG->U[ks][j][is-i].M3 += qomL*pG->U[ks][j][is-i].d;
+        UVAR(pG->U,ks,j,is-i,M3) += qomL*UVAR(pG->U,ks,j,is-i,d);
       }
     }
 
@@ -749,7 +736,6 @@ void ShearingSheet_ox1(DomainS *pD)
   int ierr,sendto_id,getfrom_id;
   double *pSnd,*pRcv;
   Remap *pRemap;
-  ConsS *pCons;
   MPI_Request rq;
 #endif
 
@@ -790,26 +776,26 @@ void ShearingSheet_ox1(DomainS *pD)
     for(j=js-nghost; j<=je+nghost; j++){
       for(i=0; i<nghost; i++){
         ii = ie+1+i;
-        GhstZns[k][i][j].U[0] = pG->U[k][j][ii].d;
-        GhstZns[k][i][j].U[1] = pG->U[k][j][ii].M1;
-        GhstZns[k][i][j].U[2] = pG->U[k][j][ii].M2;
+        GhstZns[k][i][j].U[0] = UVAR(pG->U,k,j,ii,d);
+        GhstZns[k][i][j].U[1] = UVAR(pG->U,k,j,ii,M1);
+        GhstZns[k][i][j].U[2] = UVAR(pG->U,k,j,ii,M2);
 #ifndef FARGO
-        GhstZns[k][i][j].U[2] -= qomL*pG->U[k][j][ii].d;
+        GhstZns[k][i][j].U[2] -= qomL*UVAR(pG->U,k,j,ii,d);
 #endif
-        GhstZns[k][i][j].U[3] = pG->U[k][j][ii].M3;
+        GhstZns[k][i][j].U[3] = UVAR(pG->U,k,j,ii,M3);
 #ifdef ADIABATIC
 /* No change in the internal energy */
-        GhstZns[k][i][j].U[4] = pG->U[k][j][ii].E + (0.5/GhstZns[k][i][j].U[0])*
-          (SQR(GhstZns[k][i][j].U[2]) - SQR(pG->U[k][j][ii].M2));
+        GhstZns[k][i][j].U[4] = UVAR(pG->U,k,j,ii,E) + (0.5/GhstZns[k][i][j].U[0])*
+          (SQR(GhstZns[k][i][j].U[2]) - SQR(UVAR(pG->U,k,j,ii,M2)));
 #endif /* ADIABATIC */
 #ifdef MHD
-        GhstZns[k][i][j].U[NREMAP-4] = pG->U[k][j][ii].B1c;
+        GhstZns[k][i][j].U[NREMAP-4] = UVAR(pG->U,k,j,ii,B1c);
         GhstZns[k][i][j].U[NREMAP-3] = pG->B1i[k][j][ii];
         GhstZns[k][i][j].U[NREMAP-2] = pG->B2i[k][j][ii];
         GhstZns[k][i][j].U[NREMAP-1] = pG->B3i[k][j][ii];
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for(n=0; n<NSCALARS; n++) GhstZns[k][i][j].s[n] = pG->U[k][j][ii].s[n];
+        for(n=0; n<NSCALARS; n++) GhstZns[k][i][j].s[n] = UVAR(pG->U,k,j,ii,s[n]);
 #endif
       }
     }
@@ -1038,22 +1024,22 @@ void ShearingSheet_ox1(DomainS *pD)
   for(k=ks; k<=ke; k++) {
     for(j=js; j<=je; j++){
       for(i=0; i<nghost; i++){
-        pG->U[k][j][ie+1+i].d  = GhstZns[k][i][j].U[0];
-        pG->U[k][j][ie+1+i].M1 = GhstZns[k][i][j].U[1];
-        pG->U[k][j][ie+1+i].M2 = GhstZns[k][i][j].U[2];
-        pG->U[k][j][ie+1+i].M3 = GhstZns[k][i][j].U[3];
+        UVAR(pG->U,k,j,ie+1+i,d)  = GhstZns[k][i][j].U[0];
+        UVAR(pG->U,k,j,ie+1+i,M1) = GhstZns[k][i][j].U[1];
+        UVAR(pG->U,k,j,ie+1+i,M2) = GhstZns[k][i][j].U[2];
+        UVAR(pG->U,k,j,ie+1+i,M3) = GhstZns[k][i][j].U[3];
 #ifdef ADIABATIC
-        pG->U[k][j][ie+1+i].E  = GhstZns[k][i][j].U[4];
+        UVAR(pG->U,k,j,ie+1+i,E)  = GhstZns[k][i][j].U[4];
 #endif /* ADIABATIC */
 #ifdef MHD
-        pG->U[k][j][ie+1+i].B1c = GhstZns[k][i][j].U[NREMAP-4];
+        UVAR(pG->U,k,j,ie+1+i,B1c) = GhstZns[k][i][j].U[NREMAP-4];
         if(i>0) pG->B1i[k][j][ie+1+i] = GhstZns[k][i][j].U[NREMAP-3];
         pG->B2i[k][j][ie+1+i] = GhstZns[k][i][j].U[NREMAP-2];
         pG->B3i[k][j][ie+1+i] = GhstZns[k][i][j].U[NREMAP-1];
 #endif /* MHD */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) {
-          pG->U[k][j][ie+1+i].s[n] = GhstZns[k][i][j].s[n];
+          UVAR(pG->U,k,j,ie+1+i,s[n]) = GhstZns[k][i][j].s[n];
         }
 #endif
       }
@@ -1080,7 +1066,7 @@ void ShearingSheet_ox1(DomainS *pD)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for(i=ie+1; i<=ie+nghost; i++){
-        pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i]+pG->B2i[k][j+1][i]);
+        UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i]+pG->B2i[k][j+1][i]);
       }
     }
   }
@@ -1088,7 +1074,7 @@ void ShearingSheet_ox1(DomainS *pD)
     for (k=ks; k<=ke; k++) {
       for (j=js; j<=je; j++) {
         for(i=ie+1; i<=ie+nghost; i++){
-          pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i]+pG->B3i[k+1][j][i]);
+          UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i]+pG->B3i[k+1][j][i]);
         }
       }
     }
@@ -1104,8 +1090,8 @@ void ShearingSheet_ox1(DomainS *pD)
     for(k=ks; k<=ke; k++) {
       for(j=1; j<=nghost; j++){
         for(i=ie+1; i<=ie+nghost; i++){
-          pG->U[k][js-j][i] = pG->U[k][je-(j-1)][i];
-          pG->U[k][je+j][i] = pG->U[k][js+(j-1)][i];
+          UCOPY(pG->U,k,js-j,i,k,je-(j-1),i);
+          UCOPY(pG->U,k,je+j,i,k,js+(j-1),i);
 #ifdef MHD
           pG->B1i[k][js-j][i] = pG->B1i[k][je-(j-1)][i];
           pG->B2i[k][js-j][i] = pG->B2i[k][je-(j-1)][i];
@@ -1146,26 +1132,23 @@ void ShearingSheet_ox1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=je-nghost+1; j<=je; j++){
         for (i=ie+1; i<=ie+nghost; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          *(pSnd++) = pCons->d;
-          *(pSnd++) = pCons->M1;
-          *(pSnd++) = pCons->M2;
-          *(pSnd++) = pCons->M3;
+          *(pSnd++) = UVAR(pG->U,k,j,i,d);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) = pCons->E;
+          *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          *(pSnd++) = pCons->B1c;
-          *(pSnd++) = pCons->B2c;
-          *(pSnd++) = pCons->B3c;
+          *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
           *(pSnd++) = pG->B1i[k][j][i];
           *(pSnd++) = pG->B2i[k][j][i];
           *(pSnd++) = pG->B3i[k][j][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) *(pSnd++) = pCons->s[n];
+          for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
         }
       }
@@ -1182,26 +1165,23 @@ void ShearingSheet_ox1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=js-nghost; j<=js-1; j++){
         for (i=ie+1; i<=ie+nghost; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          pCons->d  = *(pRcv++);
-          pCons->M1 = *(pRcv++);
-          pCons->M2 = *(pRcv++);
-          pCons->M3 = *(pRcv++);
+          UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+          UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-          pCons->E  = *(pRcv++);
+          UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          pCons->B1c = *(pRcv++);
-          pCons->B2c = *(pRcv++);
-          pCons->B3c = *(pRcv++);
+          UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
           pG->B1i[k][j][i] = *(pRcv++);
           pG->B2i[k][j][i] = *(pRcv++);
           pG->B3i[k][j][i] = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) pCons->s[n] = *(pRcv++);
+          for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
         }
       }
@@ -1215,26 +1195,23 @@ void ShearingSheet_ox1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=js; j<=js+nghost-1; j++){
         for (i=ie+1; i<=ie+nghost; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          *(pSnd++) = pCons->d;
-          *(pSnd++) = pCons->M1;
-          *(pSnd++) = pCons->M2;
-          *(pSnd++) = pCons->M3;
+          *(pSnd++) = UVAR(pG->U,k,j,i,d);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+          *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) = pCons->E;
+          *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          *(pSnd++) = pCons->B1c;
-          *(pSnd++) = pCons->B2c;
-          *(pSnd++) = pCons->B3c;
+          *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+          *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
           *(pSnd++) = pG->B1i[k][j][i];
           *(pSnd++) = pG->B2i[k][j][i];
           *(pSnd++) = pG->B3i[k][j][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) *(pSnd++) = pCons->s[n];
+          for (n=0; n<NSCALARS; n++) *(pSnd++) = UVAR(pG->U,k,j,i,s[n]);
 #endif
         }
       }
@@ -1251,26 +1228,23 @@ void ShearingSheet_ox1(DomainS *pD)
     for (k=ks; k<=ku; k++){
       for (j=je+1; j<=je+nghost; j++){
         for (i=ie+1; i<=ie+nghost; i++){
-          /* Get a pointer to the ConsS cell */
-          pCons = &(pG->U[k][j][i]);
-
-          pCons->d  = *(pRcv++);
-          pCons->M1 = *(pRcv++);
-          pCons->M2 = *(pRcv++);
-          pCons->M3 = *(pRcv++);
+          UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+          UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+          UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-          pCons->E  = *(pRcv++);
+          UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-          pCons->B1c = *(pRcv++);
-          pCons->B2c = *(pRcv++);
-          pCons->B3c = *(pRcv++);
+          UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+          UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
           pG->B1i[k][j][i] = *(pRcv++);
           pG->B2i[k][j][i] = *(pRcv++);
           pG->B3i[k][j][i] = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-          for (n=0; n<NSCALARS; n++) pCons->s[n] = *(pRcv++);
+          for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
         }
       }
@@ -1285,8 +1259,8 @@ void ShearingSheet_ox1(DomainS *pD)
 #ifdef MHD
   for (k=ks; k<=ke; k++) {
     for (i=ie+1; i<=ie+nghost; i++){
-      pG->U[k][je  ][i].B2c = 0.5*(pG->B2i[k][je+1][i]+pG->B2i[k][je][i]);
-      pG->U[k][js-1][i].B2c = 0.5*(pG->B2i[k][js-1][i]+pG->B2i[k][js][i]);
+      UVAR(pG->U,k,je,i,B2c) = 0.5*(pG->B2i[k][je+1][i]+pG->B2i[k][je][i]);
+      UVAR(pG->U,k,js-1,i,B2c) = 0.5*(pG->B2i[k][js-1][i]+pG->B2i[k][js][i]);
     }
   }
 #endif /* MHD */
@@ -1305,11 +1279,11 @@ void ShearingSheet_ox1(DomainS *pD)
       for (i=1; i<=nghost; i++) {
 #ifdef ADIABATIC
 /* No change in the internal energy */
-        pG->U[ks][j][ie+i].E += (0.5/pG->U[ks][j][ie+i].d)*
-          (SQR((pG->U[ks][j][ie+i].M3 - qomL*pG->U[ks][j][ie+i].d))
-         - SQR(pG->U[ks][j][ie+i].M3));
+        UVAR(pG->U,ks,j,ie+i,E) += (0.5/UVAR(pG->U,ks,j,ie+i,d))*
+          (SQR((UVAR(pG->U,ks,j,ie+i,M3) - qomL*UVAR(pG->U,ks,j,ie+i,d)))
+         - SQR(UVAR(pG->U,ks,j,ie+i,M3)));
 #endif
-        pG->U[ks][j][ie+i].M3 -= qomL*pG->U[ks][j][ie+i].d;
+        UVAR(pG->U,ks,j,ie+i,M3) -= qomL*UVAR(pG->U,ks,j,ie+i,d);
       }
     }
 
@@ -4998,19 +4972,19 @@ void Fargo(DomainS *pD)
     for(j=jfs; j<=jfe+1; j++){
       for(i=is; i<=ie+1; i++){
         jj = j-(jfs-js);
-        FargoVars[k][i][j].U[0] = pG->U[k][jj][i].d;
-        FargoVars[k][i][j].U[1] = pG->U[k][jj][i].M1;
-        FargoVars[k][i][j].U[2] = pG->U[k][jj][i].M2;
-        FargoVars[k][i][j].U[3] = pG->U[k][jj][i].M3;
+        FargoVars[k][i][j].U[0] = UVAR(pG->U,k,jj,i,d);
+        FargoVars[k][i][j].U[1] = UVAR(pG->U,k,jj,i,M1);
+        FargoVars[k][i][j].U[2] = UVAR(pG->U,k,jj,i,M2);
+        FargoVars[k][i][j].U[3] = UVAR(pG->U,k,jj,i,M3);
 #if defined(ADIABATIC) && defined(SHEARING_BOX)
 #ifdef MHD
 /* Add energy equation source term in MHD */
-        pG->U[k][jj][i].E -= qom_dt*pG->U[k][jj][i].B1c*
-         (pG->U[k][jj][i].B2c - (qom_dt/2.)*pG->U[k][jj][i].B1c);
+        UVAR(pG->U,k,jj,i,E) -= qom_dt*UVAR(pG->U,k,jj,i,B1c)*
+         (UVAR(pG->U,k,jj,i,B2c) - (qom_dt/2.)*UVAR(pG->U,k,jj,i,B1c));
 #endif /* MHD */
-	pG->U[k][jj][i].E += qom_dt*pG->U[k][jj][i].M1*
-	  pG->U[k][jj][i].M2/pG->U[k][jj][i].d;
-        FargoVars[k][i][j].U[4] = pG->U[k][jj][i].E;
+	UVAR(pG->U,k,jj,i,E) += qom_dt*UVAR(pG->U,k,jj,i,M1)*
+	  UVAR(pG->U,k,jj,i,M2)/UVAR(pG->U,k,jj,i,d);
+        FargoVars[k][i][j].U[4] = UVAR(pG->U,k,jj,i,E);
 #endif /* ADIABATIC */
 
 #if defined(ADIABATIC) && defined(CYLINDRICAL)
@@ -5018,12 +4992,12 @@ void Fargo(DomainS *pD)
         qsh = (*ShearProfile)(r[i]);
 #ifdef MHD
 /* Add energy equation source term in MHD */
-        pG->U[k][jj][i].E -= qsh*Om*pG->dt*pG->U[k][jj][i].B1c*
-         (pG->U[k][jj][i].B2c - (qsh*Om*pG->dt/2.)*pG->U[k][jj][i].B1c);
+        UVAR(pG->U,k,jj,i,E) -= qsh*Om*pG->dt*UVAR(pG->U,k,jj,i,B1c)*
+         (UVAR(pG->U,k,jj,i,B2c) - (qsh*Om*pG->dt/2.)*UVAR(pG->U,k,jj,i,B1c));
 #endif /* MHD */
-        pG->U[k][jj][i].E += qsh*Om*pG->dt*pG->U[k][jj][i].M1*
-          pG->U[k][jj][i].M2/pG->U[k][jj][i].d;
-        FargoVars[k][i][j].U[4] = pG->U[k][jj][i].E;
+        UVAR(pG->U,k,jj,i,E) += qsh*Om*pG->dt*UVAR(pG->U,k,jj,i,M1)*
+          UVAR(pG->U,k,jj,i,M2)/UVAR(pG->U,k,jj,i,d);
+        FargoVars[k][i][j].U[4] = UVAR(pG->U,k,jj,i,E);
 #endif /* ADIABATIC AND CYLINDRICAL */
 
 /* Only store Bz and Bx in that order.  This is to match order in FargoFlx:
@@ -5034,7 +5008,7 @@ void Fargo(DomainS *pD)
         FargoVars[k][i][j].U[NFARGO-1] = pG->B1i[k][jj][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for(n=0;n<NSCALARS;n++) FargoVars[k][i][j].s[n] = pG->U[k][jj][i].s[n];
+        for(n=0;n<NSCALARS;n++) FargoVars[k][i][j].s[n] = UVAR(pG->U,k,jj,i,s[n]);
 #endif
       }
     }
@@ -5266,16 +5240,16 @@ void Fargo(DomainS *pD)
       ath_error("[bvals_shear]: FARGO fluxes not periodic in Y\n");
 **********************/
       for(i=is; i<=ie; i++){
-        pG->U[k][j][i].d  -=(FargoFlx[k][i][jj+1].U[0]-FargoFlx[k][i][jj].U[0]);
-        pG->U[k][j][i].M1 -=(FargoFlx[k][i][jj+1].U[1]-FargoFlx[k][i][jj].U[1]);
-        pG->U[k][j][i].M2 -=(FargoFlx[k][i][jj+1].U[2]-FargoFlx[k][i][jj].U[2]);
-        pG->U[k][j][i].M3 -=(FargoFlx[k][i][jj+1].U[3]-FargoFlx[k][i][jj].U[3]);
+        UVAR(pG->U,k,j,i,d)  -=(FargoFlx[k][i][jj+1].U[0]-FargoFlx[k][i][jj].U[0]);
+        UVAR(pG->U,k,j,i,M1) -=(FargoFlx[k][i][jj+1].U[1]-FargoFlx[k][i][jj].U[1]);
+        UVAR(pG->U,k,j,i,M2) -=(FargoFlx[k][i][jj+1].U[2]-FargoFlx[k][i][jj].U[2]);
+        UVAR(pG->U,k,j,i,M3) -=(FargoFlx[k][i][jj+1].U[3]-FargoFlx[k][i][jj].U[3]);
 #ifdef ADIABATIC
-        pG->U[k][j][i].E  -=(FargoFlx[k][i][jj+1].U[4]-FargoFlx[k][i][jj].U[4]);
+        UVAR(pG->U,k,j,i,E)  -=(FargoFlx[k][i][jj+1].U[4]-FargoFlx[k][i][jj].U[4]);
 #endif /* ADIABATIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) {
-         pG->U[k][j][i].s[n]-=FargoFlx[k][i][jj+1].s[n]-FargoFlx[k][i][jj].s[n];
+         UVAR(pG->U,k,j,i,s[n])-=FargoFlx[k][i][jj+1].s[n]-FargoFlx[k][i][jj].s[n];
         }
 #endif
       }
@@ -5382,10 +5356,10 @@ void Fargo(DomainS *pD)
 #ifdef CYLINDRICAL
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-        pG->U[k][j][i].B1c = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
-        pG->U[k][j][i].B2c = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
+        UVAR(pG->U,k,j,i,B1c) = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
+        UVAR(pG->U,k,j,i,B2c) = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
         if (pG->Nx[2]>1) {
-          pG->U[k][j][i].B3c = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
+          UVAR(pG->U,k,j,i,B3c) = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
         }
       }
     }
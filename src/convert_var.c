@@ -10,6 +10,9 @@
  *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - Cons_to_Prim()     - converts Cons type to Prim type
+ * - Cons_to_Prim_Grid() - fills cache of primitives on a Grid (PRIM_CACHE)
+ * - Cons_to_Prim_Stage() - fills cache for first stage of a 3D integrator
+ * - Cons_to_Prim_Array() - fills cache of primitives from array of ConsS
  * - Cons1D_to_Prim1D() - converts 1D vector (Bx passed through arguments)
  * - Prim1D_to_Cons1D() - converts 1D vector (Bx passed through arguments)
  * - cfast()            - computes fast magnetosonic speed
@@ -203,6 +206,97 @@ ConsS Prim_to_Cons (const PrimS *pW)
   return Cons;
 }
 
+#ifdef PRIM_CACHE
+/*----------------------------------------------------------------------------*/
+/*! \fn void Cons_to_Prim_Grid(GridS *pG, int il, int iu, int jl, int ju,
+ *                             int kl, int ku)
+ *  \brief Fills the cache of primitive variables pG->W from pG->U in cells
+ *   il..iu, jl..ju, kl..ku, so the 3D integrators and new_dt() convert each
+ *   cell only once per stage.  Same result as Cons_to_Prim() cell by cell.
+ */
+
+void Cons_to_Prim_Grid(GridS *pG, int il, int iu, int jl, int ju,
+                       int kl, int ku)
+{
+  int i,j,k;
+  ConsS U;
+  PrimS *W;
+
+  for (k=kl; k<=ku; k++) {
+    for (j=jl; j<=ju; j++) {
+      W = pG->W[k][j];
+SIMD_IVDEP
+      for (i=il; i<=iu; i++) {
+        U = UCELL(pG->U,k,j,i);
+        W[i] = Cons_to_Prim(&U);
+      }
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void Cons_to_Prim_Stage(GridS *pG)
+ *  \brief Fills the cache over the Grid and its ghost zones for the first
+ *   stage of a 3D integrator.  If new_dt() has already filled the active
+ *   cells from the same U (pG->W_valid), only the ghost zones are converted.
+ *   Clears W_valid, since the integrator then changes U.
+ */
+
+void Cons_to_Prim_Stage(GridS *pG)
+{
+  int is=pG->is, ie=pG->ie, js=pG->js, je=pG->je, ks=pG->ks, ke=pG->ke;
+
+  if (pG->W_valid == 0) {
+    Cons_to_Prim_Grid(pG,is-nghost,ie+nghost,js-nghost,je+nghost,
+                      ks-nghost,ke+nghost);
+    return;
+  }
+
+/* x3-ghost planes, then x2-ghost rows and x1-ghost cells of active planes */
+  Cons_to_Prim_Grid(pG,is-nghost,ie+nghost,js-nghost,je+nghost,
+                    ks-nghost,ks-1);
+  Cons_to_Prim_Grid(pG,is-nghost,ie+nghost,js-nghost,je+nghost,
+                    ke+1,ke+nghost);
+  Cons_to_Prim_Grid(pG,is-nghost,ie+nghost,js-nghost,js-1,ks,ke);
+  Cons_to_Prim_Grid(pG,is-nghost,ie+nghost,je+1,je+nghost,ks,ke);
+  Cons_to_Prim_Grid(pG,is-nghost,is-1,js,je,ks,ke);
+  Cons_to_Prim_Grid(pG,ie+1,ie+nghost,js,je,ks,ke);
+  pG->W_valid = 0;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void Cons_to_Prim_Array(ConsS ***U, PrimS ***W, int il, int iu,
+ *                              int jl, int ju, int kl, int ku)
+ *  \brief Same as Cons_to_Prim_Grid(), for an array of ConsS such as the
+ *   half-step variables of the VL integrator.
+ */
+
+void Cons_to_Prim_Array(ConsS ***U, PrimS ***W, int il, int iu,
+                        int jl, int ju, int kl, int ku)
+{
+  int i,j,k;
+  ConsS *Urow;
+  PrimS *Wrow;
+
+  for (k=kl; k<=ku; k++) {
+    for (j=jl; j<=ju; j++) {
+      Urow = U[k][j];
+      Wrow = W[k][j];
+SIMD_IVDEP
+      for (i=il; i<=iu; i++) {
+        Wrow[i] = Cons_to_Prim(&Urow[i]);
+      }
+    }
+  }
+
+  return;
+}
+#endif /* PRIM_CACHE */
+
 #ifdef SPECIAL_RELATIVITY /* special relativity only */
 #ifdef MHD /* MHD only */
 /*----------------------------------------------------------------------------*/
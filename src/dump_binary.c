@@ -30,6 +30,7 @@
 void dump_binary(MeshS *pM, OutputS *pOut)
 {
   GridS *pGrid;
+  ConsS U;
   PrimS ***W;
   FILE *p_binfile;
   char *fname,*plev=NULL,*pdom=NULL;
@@ -85,7 +86,8 @@ void dump_binary(MeshS *pM, OutputS *pOut)
           for (k=kl; k<=ku; k++) {
           for (j=jl; j<=ju; j++) {
           for (i=il; i<=iu; i++) {
-            W[k-kl][j-jl][i-il] = Cons_to_Prim(&(pGrid->U[k][j][i]));
+            U = UCELL(pGrid->U,k,j,i);
+            W[k-kl][j-jl][i-il] = Cons_to_Prim(&U);
           }}}
         }
 
@@ -199,11 +201,11 @@ void dump_binary(MeshS *pM, OutputS *pOut)
             for (i=0; i<ndata[0]; i++) {
 
               if (strcmp(pOut->out,"cons") == 0){
-                pData = ((Real*)&(pGrid->U[k+kl][j+jl][i+il])) + n;
+                datax[i] = (Real)UVARN(pGrid->U,k+kl,j+jl,i+il,n);
               } else if(strcmp(pOut->out,"prim") == 0) {
                 pData = ((Real*)&(W[k][j][i])) + n;
+                datax[i] = (Real)(*pData);
               }
-              datax[i] = (Real)(*pData);
 
             }
             fwrite(datax,sizeof(Real),(size_t)ndata[0],p_binfile);
@@ -215,8 +217,7 @@ void dump_binary(MeshS *pM, OutputS *pOut)
         for (k=0; k<ndata[2]; k++) {
         for (j=0; j<ndata[1]; j++) {
           for (i=0; i<ndata[0]; i++) {
-            pData = &(pGrid->Phi[k+kl][j+jl][i+il]);
-            datax[i] = (Real)(*pData);
+            datax[i] = (Real)pGrid->Phi[k+kl][j+jl][i+il];
           }
           fwrite(datax,sizeof(Real),(size_t)ndata[0],p_binfile);
         }}
@@ -28,6 +28,7 @@
 void dump_vtk(MeshS *pM, OutputS *pOut)
 {
   GridS *pGrid;
+  ConsS U;
   PrimS ***W;
   FILE *pfile;
   char *fname,*plev=NULL,*pdom=NULL;
@@ -85,7 +86,8 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
           for (k=kl; k<=ku; k++) {
           for (j=jl; j<=ju; j++) {
           for (i=il; i<=iu; i++) {
-            W[k-kl][j-jl][i-il] = Cons_to_Prim(&(pGrid->U[k][j][i]));
+            U = UCELL(pGrid->U,k,j,i);
+            W[k-kl][j-jl][i-il] = Cons_to_Prim(&U);
           }}}
         }
 
@@ -166,7 +168,7 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
           for (j=jl; j<=ju; j++) {
             for (i=il; i<=iu; i++) {
               if (strcmp(pOut->out,"cons") == 0){
-                data[i-il] = (float)pGrid->U[k][j][i].d;
+                data[i-il] = (float)UVAR(pGrid->U,k,j,i,d);
               } else if(strcmp(pOut->out,"prim") == 0) {
                 data[i-il] = (float)W[k-kl][j-jl][i-il].d;
               }
@@ -187,9 +189,9 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
           for (j=jl; j<=ju; j++) {
             for (i=il; i<=iu; i++) {
               if (strcmp(pOut->out,"cons") == 0){
-                data[3*(i-il)  ] = (float)pGrid->U[k][j][i].M1;
-                data[3*(i-il)+1] = (float)pGrid->U[k][j][i].M2;
-                data[3*(i-il)+2] = (float)pGrid->U[k][j][i].M3;
+                data[3*(i-il)  ] = (float)UVAR(pGrid->U,k,j,i,M1);
+                data[3*(i-il)+1] = (float)UVAR(pGrid->U,k,j,i,M2);
+                data[3*(i-il)+2] = (float)UVAR(pGrid->U,k,j,i,M3);
               } else if(strcmp(pOut->out,"prim") == 0) {
                 data[3*(i-il)  ] = (float)W[k-kl][j-jl][i-il].V1;
                 data[3*(i-il)+1] = (float)W[k-kl][j-jl][i-il].V2;
@@ -214,7 +216,7 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
           for (j=jl; j<=ju; j++) {
             for (i=il; i<=iu; i++) {
               if (strcmp(pOut->out,"cons") == 0){
-                data[i-il] = (float)pGrid->U[k][j][i].E;
+                data[i-il] = (float)UVAR(pGrid->U,k,j,i,E);
               } else if(strcmp(pOut->out,"prim") == 0) {
                 data[i-il] = (float)W[k-kl][j-jl][i-il].P;
               }
@@ -232,9 +234,9 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
         for (k=kl; k<=ku; k++) {
           for (j=jl; j<=ju; j++) {
             for (i=il; i<=iu; i++) {
-              data[3*(i-il)] = (float)pGrid->U[k][j][i].B1c;
-              data[3*(i-il)+1] = (float)pGrid->U[k][j][i].B2c;
-              data[3*(i-il)+2] = (float)pGrid->U[k][j][i].B3c;
+              data[3*(i-il)] = (float)UVAR(pGrid->U,k,j,i,B1c);
+              data[3*(i-il)+1] = (float)UVAR(pGrid->U,k,j,i,B2c);
+              data[3*(i-il)+2] = (float)UVAR(pGrid->U,k,j,i,B3c);
             }
             if(!big_end) ath_bswap(data,sizeof(float),3*(iu-il+1));
             fwrite(data,sizeof(float),(size_t)(3*ndata0),pfile);
@@ -302,7 +304,7 @@ void dump_vtk(MeshS *pM, OutputS *pOut)
             for (j=jl; j<=ju; j++) {
               for (i=il; i<=iu; i++) {
                 if (strcmp(pOut->out,"cons") == 0){
-                  data[i-il] = (float)pGrid->U[k][j][i].s[n];
+                  data[i-il] = (float)UVAR(pGrid->U,k,j,i,s[n]);
                 } else if(strcmp(pOut->out,"prim") == 0) {
                   data[i-il] = (float)W[k-kl][j-jl][i-il].r[n];
                 }
@@ -16,14 +16,27 @@
  * - ath_3d_fft()              - perform a 3D FFT
  * - ath_3d_fft_free()         - free memory for 3D FFT data
  * - ath_3d_fft_destroy_plan() - free up memory
+ * - ath_3d_fft_r2c_quick_plan()  - create a real-to-complex plan for 3D grid
+ * - ath_3d_fft_r2c_create_plan() - create a more flexible real-to-complex plan
+ * - ath_3d_fft_r2c_malloc()   - allocate memory for complex r2c FFT data
+ * - ath_3d_fft_real_malloc()  - allocate memory for real r2c FFT data
+ * - ath_3d_fft_r2c()          - perform a real-to-complex 3D FFT
+ * - ath_3d_fft_c2r()          - perform a complex-to-real 3D FFT
+ * - ath_3d_fft_real_free()    - free memory for real r2c FFT data
+ * - ath_3d_fft_r2c_destroy_plan() - free up memory
  * - ath_2d_fft_quick_plan()   - create a plan for global 2D grid (Nx3=1)
  * - ath_2d_fft_create_plan()  - create a more flexible plan for 2D FFT
  * - ath_2d_fft_malloc()       - allocate memory for 2D FFT data
  * - ath_2d_fft()              - perform a 2D FFT
  * - ath_2d_fft_free()         - free memory for 2D FFT data
- * - ath_2d_fft_destroy_plan() - free up memory				      */
+ * - ath_2d_fft_destroy_plan() - free up memory
+ *
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - ath_fft_wisdom()          - import/export FFTW wisdom in output directory
+ *                               (single processor only) */
 /*============================================================================*/
 
+#include <stdio.h>
 #include <stdlib.h>
 #include "../defs.h"
 #include "../athena.h"
@@ -36,11 +49,23 @@
 /* Include Steve Plimpton's FFTW interface code */
 #include "fft_3d.h"
 #include "fft_2d.h"
+#ifdef FFT_PENCIL
+#include "pencil_3d.h"
+#endif /* FFT_PENCIL */
 #else /* FFT_BLOCK_DECOMP */
 /* For a single processor, use FFTW directly */
 #include "fftw3.h"
 #endif /* FFT_BLOCK_DECOMP */
 
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ *   ath_fft_wisdom() - import/export FFTW wisdom in output directory
+ *============================================================================*/
+
+#ifndef FFT_BLOCK_DECOMP
+static void ath_fft_wisdom(DomainS *pD, int import);
+#endif
+
 /**************************************************************************
  *
  *  Athena 3D FFT functions
@@ -133,6 +158,8 @@ struct ath_3d_fft_plan *ath_3d_fft_create_plan(DomainS *pD, int gnx3, int gnx2,
 			    		gks, gke, gjs, gje, gis, gie, 
                             		0, 0, &nbuf);
 #else /* FFT_BLOCK_DECOMP */
+  /* Reuse any FFTW wisdom from previous runs */
+  ath_fft_wisdom(pD, 1);
   if (dir == ATH_FFT_FORWARD) {
     ath_plan->plan = fftw_plan_dft_3d(gnx1, gnx2, gnx3, data, data,
 					FFTW_FORWARD, FFTW_MEASURE);
@@ -140,6 +167,7 @@ struct ath_3d_fft_plan *ath_3d_fft_create_plan(DomainS *pD, int gnx3, int gnx2,
     ath_plan->plan = fftw_plan_dft_3d(gnx1, gnx2, gnx3, data, data,
 					FFTW_BACKWARD, FFTW_MEASURE);
   }
+  ath_fft_wisdom(pD, 0);
 #endif /* FFT_BLOCK_DECOMP */
 
   if (tmp) ath_3d_fft_free(data);
@@ -201,6 +229,228 @@ void ath_3d_fft_destroy_plan(struct ath_3d_fft_plan *ath_plan)
   return;
 }
 
+/*! \fn struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_quick_plan(DomainS *pD)
+ *  \brief Sets up a real-to-complex FFT plan for the entire 3D grid, using
+ *      ath_3d_fft_r2c_create_plan()
+ */
+
+struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_quick_plan(DomainS *pD)
+{
+  GridS *pGrid = (pD->Grid);
+  /* Get size of global FFT grid */
+  int gnx1 = pD->Nx[0];
+  int gnx2 = pD->Nx[1];
+  int gnx3 = pD->Nx[2];
+
+  /* Get extents of local FFT grid in global coordinates */
+  int gis = pGrid->Disp[0] - pD->Disp[0];
+  int gie = pGrid->Disp[0] - pD->Disp[0] + pGrid->Nx[0] - 1;
+  int gjs = pGrid->Disp[1] - pD->Disp[1];
+  int gje = pGrid->Disp[1] - pD->Disp[1] + pGrid->Nx[1] - 1;
+  int gks = pGrid->Disp[2] - pD->Disp[2];
+  int gke = pGrid->Disp[2] - pD->Disp[2] + pGrid->Nx[2] - 1;
+
+  return ath_3d_fft_r2c_create_plan(pD, gnx3, gnx2, gnx1, gks, gke, gjs, gje,
+				   gis, gie);
+}
+
+/*! \fn struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_create_plan(DomainS *pD,
+ *				int gnx3, int gnx2, int gnx1,
+ *				int gks, int gke, int gjs, int gje,
+ *				int gis, int gie)
+ *  \brief Sets up a plan for real-to-complex and complex-to-real 3D FFTs
+ *
+ *  - gnx3, gnx2, gnx1 are the dimensions of the GLOBAL data
+ *  - gks, gke, gjs, gje, gis, gie are the starting and ending indices of
+ *      the LOCAL real data in GLOBAL coordinates
+ *  The real data is indexed with F3DI(), the complex data with F3DK().
+ *  FFTs are done out of place, and the complex-to-real FFT overwrites its
+ *  input.  Unlike the complex FFTs, only about half as many complex values
+ *  are stored, transformed and communicated.
+ */
+
+struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_create_plan(DomainS *pD,
+				int gnx3, int gnx2, int gnx1,
+				int gks, int gke, int gjs, int gje,
+				int gis, int gie)
+{
+  struct ath_3d_fft_r2c_plan *ath_plan;
+#ifdef FFT_BLOCK_DECOMP
+  int nbuf;
+#else
+  ath_fft_real *rdata;
+  ath_fft_data *cdata;
+#endif
+
+  /* Allocate memory for the plan */
+  ath_plan = (struct ath_3d_fft_r2c_plan *)
+    malloc(sizeof(struct ath_3d_fft_r2c_plan));
+  if (ath_plan == NULL) {
+    ath_error("Couldn't malloc for FFT plan.");
+  }
+  ath_plan->rcnt = (gke-gks+1)*(gje-gjs+1)*(gie-gis+1);
+  ath_plan->gcnt = gnx3*gnx2*gnx1;
+
+#ifdef FFT_BLOCK_DECOMP
+  /* Complex data is left with the x1 direction on-processor, stored with
+   * x1 varying fastest, then x3, then x2 */
+#ifdef FFT_PENCIL
+  /* Transposes are split into <fft>nchunk pieces overlapped with the FFTs */
+  ath_plan->plan = pencil_3d_create_plan(pD->Comm_Domain, gnx3, gnx2, gnx1,
+					gks, gke, gjs, gje, gis, gie,
+				par_geti_def("fft","nchunk",PENCIL_NCHUNK), &nbuf);
+#else /* FFT_PENCIL */
+  ath_plan->plan = fft_3d_r2c_create_plan(pD->Comm_Domain, gnx3, gnx2, gnx1,
+					gks, gke, gjs, gje, gis, gie, &nbuf);
+#endif /* FFT_PENCIL */
+  if (ath_plan->plan == NULL)
+    ath_error("Couldn't create real-to-complex FFT plan.");
+
+  ath_plan->kis = ath_plan->plan->out_klo;
+  ath_plan->kie = ath_plan->plan->out_khi;
+  ath_plan->kjs = ath_plan->plan->out_jlo;
+  ath_plan->kje = ath_plan->plan->out_jhi;
+  ath_plan->kks = ath_plan->plan->out_ilo;
+  ath_plan->kke = ath_plan->plan->out_ihi;
+  ath_plan->ksi = 1;
+  ath_plan->ksk = gnx1;
+  ath_plan->ksj = gnx1*(ath_plan->kke - ath_plan->kks + 1);
+#else /* FFT_BLOCK_DECOMP */
+  /* Complex data is stored in the same order as the real data */
+  ath_plan->kis = 0;
+  ath_plan->kie = gnx1-1;
+  ath_plan->kjs = 0;
+  ath_plan->kje = gnx2-1;
+  ath_plan->kks = 0;
+  ath_plan->kke = gnx3/2;
+  ath_plan->ksk = 1;
+  ath_plan->ksj = gnx3/2+1;
+  ath_plan->ksi = (gnx3/2+1)*gnx2;
+#endif /* FFT_BLOCK_DECOMP */
+  ath_plan->cnt = (long)(ath_plan->kie - ath_plan->kis + 1)*
+    (ath_plan->kje - ath_plan->kjs + 1)*(ath_plan->kke - ath_plan->kks + 1);
+
+#ifndef FFT_BLOCK_DECOMP
+  /* Plan with temporary arrays, since FFTW_MEASURE trashes them, reusing
+   * any FFTW wisdom from previous runs */
+  ath_fft_wisdom(pD, 1);
+  rdata = ath_3d_fft_real_malloc(ath_plan);
+  cdata = ath_3d_fft_r2c_malloc(ath_plan);
+  if (rdata == NULL || cdata == NULL)
+    ath_error("Couln't malloc for FFT plan data.");
+
+  ath_plan->fplan = fftw_plan_dft_r2c_3d(gnx1, gnx2, gnx3, rdata, cdata,
+					FFTW_MEASURE);
+  ath_plan->bplan = fftw_plan_dft_c2r_3d(gnx1, gnx2, gnx3, cdata, rdata,
+					FFTW_MEASURE);
+
+  ath_3d_fft_real_free(rdata);
+  ath_3d_fft_free(cdata);
+  ath_fft_wisdom(pD, 0);
+#endif /* FFT_BLOCK_DECOMP */
+
+  return ath_plan;
+}
+
+/*! \fn ath_fft_data *ath_3d_fft_r2c_malloc(struct ath_3d_fft_r2c_plan
+ *                                          *ath_plan)
+ *  \brief Allocation of complex data array needed for a real-to-complex plan
+ */
+
+ath_fft_data *ath_3d_fft_r2c_malloc(struct ath_3d_fft_r2c_plan *ath_plan)
+{
+  return (ath_fft_data *)fftw_malloc(sizeof(ath_fft_data)*
+				     (ath_plan->cnt > 0 ? ath_plan->cnt : 1));
+}
+
+/*! \fn ath_fft_real *ath_3d_fft_real_malloc(struct ath_3d_fft_r2c_plan
+ *                                          *ath_plan)
+ *  \brief Allocation of real data array needed for a real-to-complex plan
+ */
+
+ath_fft_real *ath_3d_fft_real_malloc(struct ath_3d_fft_r2c_plan *ath_plan)
+{
+  return (ath_fft_real *)fftw_malloc(sizeof(ath_fft_real) * ath_plan->rcnt);
+}
+
+/*! \fn void ath_3d_fft_r2c(struct ath_3d_fft_r2c_plan *ath_plan,
+ *                          ath_fft_real *in, ath_fft_data *out)
+ *  \brief Performs a forward real-to-complex 3D FFT (unnormalized)
+ */
+
+void ath_3d_fft_r2c(struct ath_3d_fft_r2c_plan *ath_plan, ath_fft_real *in,
+				ath_fft_data *out)
+{
+#ifdef FFT_BLOCK_DECOMP
+#ifdef FFT_PENCIL
+  pencil_3d_r2c(in, out, ath_plan->plan);
+#else /* FFT_PENCIL */
+  fft_3d_r2c(in, out, ath_plan->plan);
+#endif /* FFT_PENCIL */
+#else /* FFT_BLOCK_DECOMP */
+  fftw_execute_dft_r2c(ath_plan->fplan, in, out);
+#endif /* FFT_BLOCK_DECOMP */
+
+  return;
+}
+
+/*! \fn void ath_3d_fft_c2r(struct ath_3d_fft_r2c_plan *ath_plan,
+ *                          ath_fft_data *in, ath_fft_real *out)
+ *  \brief Performs a backward complex-to-real 3D FFT (unnormalized).  The
+ *   input array is overwritten.
+ */
+
+void ath_3d_fft_c2r(struct ath_3d_fft_r2c_plan *ath_plan, ath_fft_data *in,
+				ath_fft_real *out)
+{
+#ifdef FFT_BLOCK_DECOMP
+#ifdef FFT_PENCIL
+  pencil_3d_c2r(in, out, ath_plan->plan);
+#else /* FFT_PENCIL */
+  fft_3d_c2r(in, out, ath_plan->plan);
+#endif /* FFT_PENCIL */
+#else /* FFT_BLOCK_DECOMP */
+  fftw_execute_dft_c2r(ath_plan->bplan, in, out);
+#endif /* FFT_BLOCK_DECOMP */
+
+  return;
+}
+
+/*! \fn void ath_3d_fft_real_free(ath_fft_real *data)
+ *  \brief Frees memory used to hold real data for 3D FFT
+ */
+
+void ath_3d_fft_real_free(ath_fft_real *data)
+{
+  if (data != NULL) fftw_free((void*)data);
+
+  return;
+}
+
+/*! \fn void ath_3d_fft_r2c_destroy_plan(struct ath_3d_fft_r2c_plan
+ *                                       *ath_plan)
+ *  \brief Frees a 3D real-to-complex FFT plan
+ */
+
+void ath_3d_fft_r2c_destroy_plan(struct ath_3d_fft_r2c_plan *ath_plan)
+{
+  if (ath_plan != NULL) {
+#ifdef FFT_BLOCK_DECOMP
+#ifdef FFT_PENCIL
+    pencil_3d_destroy_plan(ath_plan->plan);
+#else /* FFT_PENCIL */
+    fft_3d_r2c_destroy_plan(ath_plan->plan);
+#endif /* FFT_PENCIL */
+#else /* FFT_BLOCK_DECOMP */
+    fftw_destroy_plan(ath_plan->fplan);
+    fftw_destroy_plan(ath_plan->bplan);
+#endif /* FFT_BLOCK_DECOMP */
+    free(ath_plan);
+  }
+
+  return;
+}
+
 /**************************************************************************
  *
  *  Athena 2D FFT functions
@@ -289,6 +539,8 @@ struct ath_2d_fft_plan *ath_2d_fft_create_plan(DomainS *pD, int gnx2, int gnx1,
 					gis, gie, gjs, gje, gis, gie, 
                             		0, 0, &nbuf);
 #else /* FFT_BLOCK_DECOMP */
+  /* Reuse any FFTW wisdom from previous runs */
+  ath_fft_wisdom(pD, 1);
   if (dir == ATH_FFT_FORWARD) {
     ath_plan->plan = fftw_plan_dft_2d(gnx1, gnx2, data, data, FFTW_FORWARD,
 					FFTW_MEASURE);
@@ -296,6 +548,7 @@ struct ath_2d_fft_plan *ath_2d_fft_create_plan(DomainS *pD, int gnx2, int gnx1,
     ath_plan->plan = fftw_plan_dft_2d(gnx1, gnx2, data, data, FFTW_BACKWARD,
 					FFTW_MEASURE);
   }
+  ath_fft_wisdom(pD, 0);
 #endif /* FFT_BLOCK_DECOMP */
 
   if (tmp) ath_2d_fft_free(data);
@@ -358,4 +611,67 @@ void ath_2d_fft_destroy_plan(struct ath_2d_fft_plan *ath_plan)
   return;
 }
 
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn static void ath_fft_wisdom(DomainS *pD, int import)
+ *  \brief Imports (import=1) or exports (import=0) FFTW wisdom.
+ *
+ *  Planning with FFTW_MEASURE can take minutes on large grids.  The wisdom
+ *  accumulated by the planner is kept in a file in the output directory of
+ *  each process, named by the global and local grid sizes and the number of
+ *  processes, so that later jobs and restarts with the same decomposition
+ *  can skip the measurements.  Wisdom is only imported once per process,
+ *  and exported after every new plan.  Set <fft>wisdom=0 to disable.
+ *
+ *  Not used with the block decomposition (MPI) library, whose only FFTW
+ *  plans are the 1D transforms inside fft_3d.c, fft_2d.c and pencil_3d.c.
+ *  These are planned with FFTW_ESTIMATE, which takes no measurements and
+ *  so gains nothing from wisdom.
+ */
+
+#ifndef FFT_BLOCK_DECOMP
+static void ath_fft_wisdom(DomainS *pD, int import)
+{
+  static int imported = 0;
+  GridS *pGrid = (pD->Grid);
+  char key[80], *basename, *fname;
+  FILE *fp;
+  int nproc = 1;
+
+  if (par_geti_def("fft","wisdom",1) == 0) return;
+  if (import && imported) return;
+
+#ifdef MPI_PARALLEL
+  MPI_Comm_size(pD->Comm_Domain, &nproc);
+#endif
+  sprintf(key,"fftw-%dx%dx%d-%dx%dx%d-np%d",pD->Nx[0],pD->Nx[1],pD->Nx[2],
+	  pGrid->Nx[0],pGrid->Nx[1],pGrid->Nx[2],nproc);
+  basename = par_gets("job","problem_id");
+  fname = ath_fname(NULL,basename,NULL,NULL,0,0,key,"wisdom");
+  free(basename);
+  if (fname == NULL) return;
+
+  if (import) {
+    imported = 1;
+    if ((fp = fopen(fname,"r")) != NULL) {
+      if (fftw_import_wisdom_from_file(fp))
+	ath_pout(0,"[ath_fft]: imported FFTW wisdom from %s\n",fname);
+      else
+	ath_perr(0,"[ath_fft]: could not import FFTW wisdom from %s\n",fname);
+      fclose(fp);
+    }
+  } else {
+    if ((fp = fopen(fname,"w")) != NULL) {
+      fftw_export_wisdom_to_file(fp);
+      fclose(fp);
+    }
+    else
+      ath_perr(0,"[ath_fft]: could not write FFTW wisdom to %s\n",fname);
+  }
+
+  free(fname);
+  return;
+}
+#endif /* FFT_BLOCK_DECOMP */
+
 #endif /* FFT_ENABLED */
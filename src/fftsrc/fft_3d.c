@@ -485,3 +485,384 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
 
   free(plan);
 }
+
+/* ------------------------------------------------------------------- */
+/* Perform 3d real-to-complex FFT (always forward, unscaled) */
+
+/* Arguments:
+
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this
+                  proc will be placed (must not overlap in)
+                  bounds of output are plan->out_ilo,...,out_khi,
+                  stored with slow index varying fastest, then fast index,
+                  then mid index
+   plan         plan returned by previous call to fft_3d_r2c_create_plan
+*/
+
+void fft_3d_r2c(double *in, FFT_DATA *out, struct fft_plan_3d_r2c *plan)
+
+{
+  double *rdata;
+  FFT_DATA *copy;
+
+/* pre-remap of real data to prepare for 1st FFTs if needed */
+
+  if (plan->pre_plan) {
+    remap_3d(in, plan->rcopy, (double *) plan->scratch, plan->pre_plan);
+    rdata = plan->rcopy;
+  }
+  else
+    rdata = in;
+
+/* 1d real-to-complex FFTs along fast axis */
+
+  if (plan->total1)
+    fftw_execute_dft_r2c(plan->plan_fast_r2c,rdata,plan->copy);
+
+/* 1st mid-remap to prepare for 2nd FFTs
+   copy = loc for remap result */
+
+  if (plan->mid1_target == 0)
+    copy = out;
+  else
+    copy = plan->copy;
+  remap_3d((double *) plan->copy, (double *) copy, (double *) plan->scratch,
+	   plan->mid1_plan);
+
+/* 1d FFTs along mid axis */
+
+  if (plan->total2)
+    fftw_execute_dft(plan->plan_mid_forward,copy,copy);
+
+/* 2nd mid-remap to prepare for 3rd FFTs, result is final distribution */
+
+  remap_3d((double *) copy, (double *) out, (double *) plan->scratch,
+	   plan->mid2_plan);
+
+/* 1d FFTs along slow axis */
+
+  if (plan->total3)
+    fftw_execute_dft(plan->plan_slow_forward,out,out);
+}
+
+/* ------------------------------------------------------------------- */
+/* Perform 3d complex-to-real FFT (always backward, unscaled) */
+
+/* Arguments:
+
+   in           starting address of complex input data on this proc,
+                  in the same distribution as output of fft_3d_r2c()
+                  (contents are overwritten)
+   out          starting address of where real output data for this proc
+                  will be placed, in the distribution of input to fft_3d_r2c()
+   plan         plan returned by previous call to fft_3d_r2c_create_plan
+*/
+
+void fft_3d_c2r(FFT_DATA *in, double *out, struct fft_plan_3d_r2c *plan)
+
+{
+  double *rdata;
+
+/* 1d FFTs along slow axis */
+
+  if (plan->total3)
+    fftw_execute_dft(plan->plan_slow_backward,in,in);
+
+/* inverse of 2nd mid-remap */
+
+  remap_3d((double *) in, (double *) plan->copy, (double *) plan->scratch,
+	   plan->mid2_back);
+
+/* 1d FFTs along mid axis */
+
+  if (plan->total2)
+    fftw_execute_dft(plan->plan_mid_backward,plan->copy,plan->copy);
+
+/* inverse of 1st mid-remap */
+
+  remap_3d((double *) plan->copy, (double *) plan->copy,
+	   (double *) plan->scratch, plan->mid1_back);
+
+/* 1d complex-to-real FFTs along fast axis, and post-remap if needed */
+
+  if (plan->post_plan)
+    rdata = plan->rcopy;
+  else
+    rdata = out;
+
+  if (plan->total1)
+    fftw_execute_dft_c2r(plan->plan_fast_c2r,plan->copy,rdata);
+
+  if (plan->post_plan)
+    remap_3d(rdata, out, (double *) plan->scratch, plan->post_plan);
+}
+
+/* ------------------------------------------------------------------- */
+/* Create plan for performing a 3d real-to-complex FFT */
+
+/* Arguments:
+
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d real matrix
+   in_ilo,in_ihi        input bounds of real data I own in fast index
+   in_jlo,in_jhi        input bounds of real data I own in mid index
+   in_klo,in_khi        input bounds of real data I own in slow index
+   nbuf                 returns size of internal storage buffers used by FFT
+
+   The complex output holds nfast/2+1 values along the fast index, and is
+   left in the distribution used for the 3rd FFTs (each proc owns the
+   entire slow axis) to avoid a final remap.  Its bounds are returned in
+   plan->out_ilo,...,out_khi.  The real data uses the same distribution on
+   input to fft_3d_r2c() and output from fft_3d_c2r().
+*/
+
+struct fft_plan_3d_r2c *fft_3d_r2c_create_plan(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi, int *nbuf)
+
+{
+  struct fft_plan_3d_r2c *plan;
+  int me,nprocs,nhalf;
+  int flag,remapflag;
+  int first_jlo,first_jhi,first_klo,first_khi;
+  int second_ilo,second_ihi,second_klo,second_khi;
+  int third_ilo,third_ihi,third_jlo,third_jhi;
+  int in_size,rfirst_size,first_size,second_size,third_size;
+  int copy_size,scratch_size;
+  int np1,np2,ip1,ip2;
+
+/* query MPI info */
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+/* compute division of procs in 2 dimensions not on-processor */
+
+  bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+/* allocate memory for plan data struct */
+
+  plan = (struct fft_plan_3d_r2c *) malloc(sizeof(struct fft_plan_3d_r2c));
+  if (plan == NULL) return NULL;
+
+  nhalf = nfast/2 + 1;
+  plan->nhalf = nhalf;
+
+/* remap real data from initial distribution to layout needed for 1st set
+   of 1d FFTs, not needed if all procs own entire fast axis initially */
+
+  if (in_ilo == 0 && in_ihi == nfast-1)
+    flag = 0;
+  else
+    flag = 1;
+
+  MPI_Allreduce(&flag,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  if (remapflag == 0) {
+    first_jlo = in_jlo;
+    first_jhi = in_jhi;
+    first_klo = in_klo;
+    first_khi = in_khi;
+    plan->pre_plan = NULL;
+    plan->post_plan = NULL;
+  }
+  else {
+    first_jlo = ip1*nmid/np1;
+    first_jhi = (ip1+1)*nmid/np1 - 1;
+    first_klo = ip2*nslow/np2;
+    first_khi = (ip2+1)*nslow/np2 - 1;
+    plan->pre_plan =
+      remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+			   0,nfast-1,first_jlo,first_jhi,first_klo,first_khi,
+			   1,0,0,2);
+    if (plan->pre_plan == NULL) return NULL;
+    plan->post_plan =
+      remap_3d_create_plan(comm,0,nfast-1,first_jlo,first_jhi,
+			   first_klo,first_khi,
+			   in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+			   1,0,0,2);
+    if (plan->post_plan == NULL) return NULL;
+  }
+
+/* 1d FFTs along fast axis */
+
+  plan->length1 = nfast;
+  plan->total1 = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+
+/* remap from 1st to 2nd FFT, only nhalf complex values along fast axis
+   second indices = distribution after 2nd set of FFTs */
+
+  second_ilo = ip1*nhalf/np1;
+  second_ihi = (ip1+1)*nhalf/np1 - 1;
+  second_klo = ip2*nslow/np2;
+  second_khi = (ip2+1)*nslow/np2 - 1;
+  plan->mid1_plan =
+      remap_3d_create_plan(comm,
+			   0,nhalf-1,first_jlo,first_jhi,first_klo,first_khi,
+			   second_ilo,second_ihi,0,nmid-1,second_klo,second_khi,
+			   FFT_PRECISION,1,0,2);
+  if (plan->mid1_plan == NULL) return NULL;
+  plan->mid1_back =
+      remap_3d_create_plan(comm,
+			   0,nmid-1,second_klo,second_khi,second_ilo,second_ihi,
+			   first_jlo,first_jhi,first_klo,first_khi,0,nhalf-1,
+			   FFT_PRECISION,2,0,2);
+  if (plan->mid1_back == NULL) return NULL;
+
+/* 1d FFTs along mid axis */
+
+  plan->length2 = nmid;
+  plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+
+/* remap from 2nd to 3rd FFT
+   third indices = distribution after 3rd set of FFTs = output */
+
+  third_ilo = ip1*nhalf/np1;
+  third_ihi = (ip1+1)*nhalf/np1 - 1;
+  third_jlo = ip2*nmid/np2;
+  third_jhi = (ip2+1)*nmid/np2 - 1;
+
+  plan->mid2_plan =
+    remap_3d_create_plan(comm,
+			 0,nmid-1,second_klo,second_khi,second_ilo,second_ihi,
+			 third_jlo,third_jhi,0,nslow-1,third_ilo,third_ihi,
+			 FFT_PRECISION,1,0,2);
+  if (plan->mid2_plan == NULL) return NULL;
+  plan->mid2_back =
+    remap_3d_create_plan(comm,
+			 0,nslow-1,third_ilo,third_ihi,third_jlo,third_jhi,
+			 second_klo,second_khi,second_ilo,second_ihi,0,nmid-1,
+			 FFT_PRECISION,2,0,2);
+  if (plan->mid2_back == NULL) return NULL;
+
+  plan->out_ilo = third_ilo;
+  plan->out_ihi = third_ihi;
+  plan->out_jlo = third_jlo;
+  plan->out_jhi = third_jhi;
+  plan->out_klo = 0;
+  plan->out_khi = nslow - 1;
+
+/* 1d FFTs along slow axis */
+
+  plan->length3 = nslow;
+  plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+/* configure plan memory pointers and allocate work space
+   copy holds complex data after 1st FFTs, and after 2nd FFTs unless
+     it fits in the output given to FFT by user
+   rcopy holds real data along fast axis if a pre/post remap is needed
+   scratch_size = amount needed internally for remap scratch space,
+     in units of complex values */
+
+  in_size = (in_ihi-in_ilo+1) * (in_jhi-in_jlo+1) * (in_khi-in_klo+1);
+  rfirst_size = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  first_size = nhalf * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  second_size = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+  third_size = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+  copy_size = first_size;
+  if (second_size <= third_size)
+    plan->mid1_target = 0;
+  else
+    plan->mid1_target = 1;
+  copy_size = MAX(copy_size,second_size);
+
+  scratch_size = MAX(first_size,second_size);
+  scratch_size = MAX(scratch_size,third_size);
+  if (plan->pre_plan) {
+    scratch_size = MAX(scratch_size,(rfirst_size+1)/2);
+    scratch_size = MAX(scratch_size,(in_size+1)/2);
+  }
+
+  copy_size = MAX(copy_size,1);
+  scratch_size = MAX(scratch_size,1);
+  *nbuf = copy_size + scratch_size;
+
+  plan->copy = (FFT_DATA *) fftw_malloc(copy_size*sizeof(FFT_DATA));
+  plan->scratch = (FFT_DATA *) fftw_malloc(scratch_size*sizeof(FFT_DATA));
+  if (plan->copy == NULL || plan->scratch == NULL) return NULL;
+
+  if (plan->pre_plan) {
+    *nbuf += (rfirst_size+1)/2;
+    rfirst_size = MAX(rfirst_size,1);
+    plan->rcopy = (double *) fftw_malloc(rfirst_size*sizeof(double));
+    if (plan->rcopy == NULL) return NULL;
+  }
+  else plan->rcopy = NULL;
+
+/* system specific pre-computation of 1d FFT coeffs
+   procs which own no data along some axis do not need a plan for it */
+
+  plan->plan_fast_r2c = NULL;
+  plan->plan_fast_c2r = NULL;
+  if (plan->total1) {
+    plan->plan_fast_r2c =
+      fftw_plan_many_dft_r2c(1,&(plan->length1),plan->total1/plan->length1,
+			     (double *) plan->scratch,NULL,1,nfast,
+			     plan->copy,NULL,1,nhalf,FFTW_ESTIMATE);
+    plan->plan_fast_c2r =
+      fftw_plan_many_dft_c2r(1,&(plan->length1),plan->total1/plan->length1,
+			     plan->copy,NULL,1,nhalf,
+			     (double *) plan->scratch,NULL,1,nfast,
+			     FFTW_ESTIMATE);
+  }
+
+  plan->plan_mid_forward = NULL;
+  plan->plan_mid_backward = NULL;
+  if (plan->total2) {
+    plan->plan_mid_forward =
+      fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
+                         plan->scratch,NULL,1,plan->length2,plan->scratch,
+                         NULL,1,plan->length2,FFTW_FORWARD,FFTW_ESTIMATE);
+    plan->plan_mid_backward =
+      fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
+                         plan->scratch,NULL,1,plan->length2,plan->scratch,
+                         NULL,1,plan->length2,FFTW_BACKWARD,FFTW_ESTIMATE);
+  }
+
+  plan->plan_slow_forward = NULL;
+  plan->plan_slow_backward = NULL;
+  if (plan->total3) {
+    plan->plan_slow_forward =
+      fftw_plan_many_dft(1,&(plan->length3),plan->total3/plan->length3,
+                         plan->scratch,NULL,1,plan->length3,plan->scratch,
+                         NULL,1,plan->length3,FFTW_FORWARD,FFTW_ESTIMATE);
+    plan->plan_slow_backward =
+      fftw_plan_many_dft(1,&(plan->length3),plan->total3/plan->length3,
+                         plan->scratch,NULL,1,plan->length3,plan->scratch,
+                         NULL,1,plan->length3,FFTW_BACKWARD,FFTW_ESTIMATE);
+  }
+
+  return plan;
+}
+
+/* ------------------------------------------------------------------- */
+/* Destroy a 3d real-to-complex fft plan */
+
+void fft_3d_r2c_destroy_plan(struct fft_plan_3d_r2c *plan)
+
+{
+  if (plan->pre_plan) remap_3d_destroy_plan(plan->pre_plan);
+  if (plan->post_plan) remap_3d_destroy_plan(plan->post_plan);
+  remap_3d_destroy_plan(plan->mid1_plan);
+  remap_3d_destroy_plan(plan->mid1_back);
+  remap_3d_destroy_plan(plan->mid2_plan);
+  remap_3d_destroy_plan(plan->mid2_back);
+
+  if (plan->rcopy) fftw_free(plan->rcopy);
+  fftw_free(plan->copy);
+  fftw_free(plan->scratch);
+
+  if (plan->plan_fast_r2c) fftw_destroy_plan(plan->plan_fast_r2c);
+  if (plan->plan_fast_c2r) fftw_destroy_plan(plan->plan_fast_c2r);
+  if (plan->plan_mid_forward) fftw_destroy_plan(plan->plan_mid_forward);
+  if (plan->plan_mid_backward) fftw_destroy_plan(plan->plan_mid_backward);
+  if (plan->plan_slow_forward) fftw_destroy_plan(plan->plan_slow_forward);
+  if (plan->plan_slow_backward) fftw_destroy_plan(plan->plan_slow_backward);
+
+  free(plan);
+}
@@ -59,9 +59,44 @@ struct fft_plan_3d {
   fftw_plan plan_slow_backward;
 };
 
+/* details of how to do a 3d real-to-complex (and complex-to-real) FFT
+   the fast axis is transformed first (r2c), so only its nfast/2+1
+   non-negative frequencies are stored and communicated */
+
+struct fft_plan_3d_r2c {
+  struct remap_plan_3d *pre_plan;       /* remap real input -> 1st FFTs */
+  struct remap_plan_3d *mid1_plan;      /* remap from 1st -> 2nd FFTs */
+  struct remap_plan_3d *mid2_plan;      /* remap from 2nd -> 3rd FFTs */
+  struct remap_plan_3d *mid2_back;      /* remap from 3rd -> 2nd FFTs */
+  struct remap_plan_3d *mid1_back;      /* remap from 2nd -> 1st FFTs */
+  struct remap_plan_3d *post_plan;      /* remap real 1st FFTs -> output */
+  double *rcopy;                    /* memory for real data along fast axis */
+  FFT_DATA *copy;                   /* memory for remap results */
+  FFT_DATA *scratch;                /* scratch space for remaps */
+  int total1,total2,total3;         /* # of 1st,2nd,3rd FFTs (times length) */
+  int length1,length2,length3;      /* length of 1st,2nd,3rd FFTs */
+  int nhalf;                        /* # of complex values along fast axis */
+  int mid1_target;                  /* where to put 1st mid-remap results */
+  int out_ilo,out_ihi;              /* bounds of complex output I own */
+  int out_jlo,out_jhi;              /*   (stored slow,fast,mid from fastest */
+  int out_klo,out_khi;              /*    to slowest varying) */
+                                    /* system specific 1d FFT info */
+  fftw_plan plan_fast_r2c;
+  fftw_plan plan_fast_c2r;
+  fftw_plan plan_mid_forward;
+  fftw_plan plan_mid_backward;
+  fftw_plan plan_slow_forward;
+  fftw_plan plan_slow_backward;
+};
+
 /* function prototypes */
 
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
+void fft_3d_r2c(double *, FFT_DATA *, struct fft_plan_3d_r2c *);
+void fft_3d_c2r(FFT_DATA *, double *, struct fft_plan_3d_r2c *);
+struct fft_plan_3d_r2c *fft_3d_r2c_create_plan(MPI_Comm, int, int, int,
+  int, int, int, int, int, int, int *);
+void fft_3d_r2c_destroy_plan(struct fft_plan_3d_r2c *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int,
   int, int, int, int, int, int, int, int, int, int, int, int,
   int, int, int *);
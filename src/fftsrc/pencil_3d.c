@@ -0,0 +1,705 @@
+/* parallel real-to-complex 3d FFT using a pencil decomposition with
+   pipelined, non-blocking transposes
+
+   Uses the same data layouts, proc grid and remap library as the
+   real-to-complex FFTs in fft_3d.c, but replaces the blocking mid-remaps
+   by MPI_Ialltoallv() within a row or column of the proc grid.  Each
+   transpose is split into chunks of planes that are independent for the
+   1d FFTs on both sides of it, so that the transpose of chunk c is in
+   flight while the 1d FFTs of chunk c-1 (or c+1) are computed.
+
+   Requires an MPI-3 library.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mpi.h"
+#include "../defs.h"
+
+#ifdef FFT_PENCIL
+
+#include "remap_3d.h"
+#include "pencil_3d.h"
+
+/* ------------------------------------------------------------------- */
+/* Data layout for pencil FFTs (local indices, fastest varying last):
+
+   1st FFTs (x1 side a):  rcopy[slow][mid][fast]    nfast real
+                          c1[slow][mid][fast]       nhalf complex
+   2nd FFTs (x1 side b,   c2[slow][fast][mid]
+             x2 side a)
+   3rd FFTs (x2 side b):  out[mid][fast][slow]
+
+   The chunks of x1 are planes of constant slow index, those of x2 are
+   planes of constant fast index.
+*/
+
+static void pencil_xpose_setup(struct pencil_xpose_3d *, MPI_Comm,
+			       int, int, int *, int *);
+static void pencil_xpose_free(struct pencil_xpose_3d *);
+static void pencil_copy_c1(struct pencil_plan_3d *, int, double *, int);
+static void pencil_copy_c2_x1(struct pencil_plan_3d *, int, double *, int);
+static void pencil_copy_c2_x2(struct pencil_plan_3d *, int, double *, int);
+static void pencil_copy_out(struct pencil_plan_3d *, int, FFT_DATA *,
+			    double *, int);
+static void pencil_start(struct pencil_xpose_3d *, int, int,
+			 double *, double *);
+
+/* ------------------------------------------------------------------- */
+/* Perform 3d real-to-complex FFT (always forward, unscaled) */
+
+/* Arguments:
+
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this
+                  proc will be placed, same layout as fft_3d_r2c()
+   plan         plan returned by previous call to pencil_3d_create_plan
+*/
+
+void pencil_3d_r2c(double *in, FFT_DATA *out, struct pencil_plan_3d *plan)
+
+{
+  struct pencil_xpose_3d *x;
+  double *rdata;
+  int c,j,n;
+
+/* pre-remap of real data to prepare for 1st FFTs if needed */
+
+  if (plan->pre_plan) {
+    remap_3d(in, plan->rcopy, plan->scratch, plan->pre_plan);
+    rdata = plan->rcopy;
+  }
+  else
+    rdata = in;
+
+/* 1d r2c FFTs along fast axis of each chunk, then start its transpose
+   while finishing the transpose and 1d FFTs along mid axis of the
+   previous chunk */
+
+  x = &(plan->x1);
+  for (c = 0; c <= x->nchunk; c++) {
+    if (c < x->nchunk) {
+      n = x->cb[c]*plan->nm1;
+      if (plan->plan_fast_r2c[c])
+	fftw_execute_dft_r2c(plan->plan_fast_r2c[c], rdata + n*plan->nfast,
+			     plan->c1 + n*plan->nhalf);
+      pencil_copy_c1(plan,c,plan->sbuf,1);
+      pencil_start(x,c,1,plan->sbuf,plan->rbuf);
+    }
+    if (c > 0) {
+      MPI_Wait(&(x->req[c-1]),MPI_STATUS_IGNORE);
+      pencil_copy_c2_x1(plan,c-1,plan->rbuf,0);
+      if (plan->plan_mid_forward[c-1]) {
+	n = x->cb[c-1]*plan->nf2*plan->nmid;
+	fftw_execute_dft(plan->plan_mid_forward[c-1],
+			 plan->c2 + n, plan->c2 + n);
+      }
+    }
+  }
+
+/* transpose to distribution of 3rd FFTs, and 1d FFTs along slow axis */
+
+  x = &(plan->x2);
+  for (c = 0; c <= x->nchunk; c++) {
+    if (c < x->nchunk) {
+      pencil_copy_c2_x2(plan,c,plan->sbuf,1);
+      pencil_start(x,c,1,plan->sbuf,plan->rbuf);
+    }
+    if (c > 0) {
+      MPI_Wait(&(x->req[c-1]),MPI_STATUS_IGNORE);
+      pencil_copy_out(plan,c-1,out,plan->rbuf,0);
+      if (plan->plan_slow_forward[c-1]) {
+	for (j = 0; j < plan->nm3; j++) {
+	  n = (j*plan->nf2 + x->cb[c-1])*plan->nslow;
+	  fftw_execute_dft(plan->plan_slow_forward[c-1], out + n, out + n);
+	}
+      }
+    }
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Perform 3d complex-to-real FFT (always backward, unscaled) */
+
+/* Arguments:
+
+   in           starting address of complex input data on this proc,
+                  in the same distribution as output of pencil_3d_r2c()
+                  (contents are overwritten)
+   out          starting address of where real output data for this proc
+                  will be placed, in the distribution of input to
+                  pencil_3d_r2c()
+   plan         plan returned by previous call to pencil_3d_create_plan
+*/
+
+void pencil_3d_c2r(FFT_DATA *in, double *out, struct pencil_plan_3d *plan)
+
+{
+  struct pencil_xpose_3d *x;
+  double *rdata;
+  int c,j,n;
+
+/* 1d FFTs along slow axis of each chunk, then start its transpose */
+
+  x = &(plan->x2);
+  for (c = 0; c <= x->nchunk; c++) {
+    if (c < x->nchunk) {
+      if (plan->plan_slow_backward[c]) {
+	for (j = 0; j < plan->nm3; j++) {
+	  n = (j*plan->nf2 + x->cb[c])*plan->nslow;
+	  fftw_execute_dft(plan->plan_slow_backward[c], in + n, in + n);
+	}
+      }
+      pencil_copy_out(plan,c,in,plan->sbuf,1);
+      pencil_start(x,c,0,plan->sbuf,plan->rbuf);
+    }
+    if (c > 0) {
+      MPI_Wait(&(x->req[c-1]),MPI_STATUS_IGNORE);
+      pencil_copy_c2_x2(plan,c-1,plan->rbuf,0);
+    }
+  }
+
+/* 1d FFTs along mid axis of each chunk, then start its transpose while
+   finishing the c2r FFTs along fast axis of the previous chunk */
+
+  if (plan->post_plan)
+    rdata = plan->rcopy;
+  else
+    rdata = out;
+
+  x = &(plan->x1);
+  for (c = 0; c <= x->nchunk; c++) {
+    if (c < x->nchunk) {
+      if (plan->plan_mid_backward[c]) {
+	n = x->cb[c]*plan->nf2*plan->nmid;
+	fftw_execute_dft(plan->plan_mid_backward[c],
+			 plan->c2 + n, plan->c2 + n);
+      }
+      pencil_copy_c2_x1(plan,c,plan->sbuf,1);
+      pencil_start(x,c,0,plan->sbuf,plan->rbuf);
+    }
+    if (c > 0) {
+      MPI_Wait(&(x->req[c-1]),MPI_STATUS_IGNORE);
+      pencil_copy_c1(plan,c-1,plan->rbuf,0);
+      n = x->cb[c-1]*plan->nm1;
+      if (plan->plan_fast_c2r[c-1])
+	fftw_execute_dft_c2r(plan->plan_fast_c2r[c-1],
+			     plan->c1 + n*plan->nhalf, rdata + n*plan->nfast);
+    }
+  }
+
+/* post-remap to put real data in output distribution if needed */
+
+  if (plan->post_plan)
+    remap_3d(rdata, out, plan->scratch, plan->post_plan);
+}
+
+/* ------------------------------------------------------------------- */
+/* Create plan for performing a 3d real-to-complex pencil FFT */
+
+/* Arguments:
+
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d real matrix
+   in_ilo,in_ihi        input bounds of real data I own in fast index
+   in_jlo,in_jhi        input bounds of real data I own in mid index
+   in_klo,in_khi        input bounds of real data I own in slow index
+   nchunk               # of chunks to split each transpose into
+                          (1 = no overlap of communication and FFTs)
+   nbuf                 returns size of internal storage buffers used by FFT
+*/
+
+struct pencil_plan_3d *pencil_3d_create_plan(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi, int nchunk, int *nbuf)
+
+{
+  struct pencil_plan_3d *plan;
+  MPI_Comm row,col;
+  int me,nprocs,np1,np2,ip1,ip2;
+  int flag,remapflag;
+  int p,c,n,nhalf;
+  int *aper,*bper;
+  int in_size,rfirst_size,size1,size2,size3,buf_size,scratch_size;
+  unsigned flags = FFTW_ESTIMATE | FFTW_UNALIGNED;
+
+/* query MPI info */
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+/* compute division of procs in 2 dimensions not on-processor, and
+   split them into rows (same slow range) and columns (same fast range) */
+
+  bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+  MPI_Comm_split(comm,ip2,ip1,&row);
+  MPI_Comm_split(comm,ip1,ip2,&col);
+
+/* allocate memory for plan data struct */
+
+  plan = (struct pencil_plan_3d *) malloc(sizeof(struct pencil_plan_3d));
+  if (plan == NULL) return NULL;
+
+  nhalf = nfast/2 + 1;
+  plan->nfast = nfast;
+  plan->nmid = nmid;
+  plan->nslow = nslow;
+  plan->nhalf = nhalf;
+  plan->np1 = np1;
+  plan->np2 = np2;
+
+/* starting indices of every proc in my row and column */
+
+  plan->rmlo = (int *) malloc((np1+1)*sizeof(int));
+  plan->rflo = (int *) malloc((np1+1)*sizeof(int));
+  plan->cslo = (int *) malloc((np2+1)*sizeof(int));
+  plan->cmlo = (int *) malloc((np2+1)*sizeof(int));
+  if (plan->rmlo == NULL || plan->rflo == NULL ||
+      plan->cslo == NULL || plan->cmlo == NULL) return NULL;
+
+  for (p = 0; p <= np1; p++) {
+    plan->rmlo[p] = p*nmid/np1;
+    plan->rflo[p] = p*nhalf/np1;
+  }
+  for (p = 0; p <= np2; p++) {
+    plan->cslo[p] = p*nslow/np2;
+    plan->cmlo[p] = p*nmid/np2;
+  }
+
+  plan->mlo1 = plan->rmlo[ip1];
+  plan->nm1 = plan->rmlo[ip1+1] - plan->mlo1;
+  plan->slo1 = plan->cslo[ip2];
+  plan->ns1 = plan->cslo[ip2+1] - plan->slo1;
+  plan->flo2 = plan->rflo[ip1];
+  plan->nf2 = plan->rflo[ip1+1] - plan->flo2;
+  plan->mlo3 = plan->cmlo[ip2];
+  plan->nm3 = plan->cmlo[ip2+1] - plan->mlo3;
+
+  plan->out_ilo = plan->flo2;
+  plan->out_ihi = plan->flo2 + plan->nf2 - 1;
+  plan->out_jlo = plan->mlo3;
+  plan->out_jhi = plan->mlo3 + plan->nm3 - 1;
+  plan->out_klo = 0;
+  plan->out_khi = nslow - 1;
+
+/* remap real data from initial distribution to layout needed for 1st set
+   of 1d FFTs, not needed if all procs already own exactly that layout */
+
+  if (in_ilo == 0 && in_ihi == nfast-1 &&
+      in_jlo == plan->mlo1 && in_jhi == plan->mlo1+plan->nm1-1 &&
+      in_klo == plan->slo1 && in_khi == plan->slo1+plan->ns1-1)
+    flag = 0;
+  else
+    flag = 1;
+
+  MPI_Allreduce(&flag,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  if (remapflag == 0) {
+    plan->pre_plan = NULL;
+    plan->post_plan = NULL;
+  }
+  else {
+    plan->pre_plan =
+      remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+			   0,nfast-1,plan->mlo1,plan->mlo1+plan->nm1-1,
+			   plan->slo1,plan->slo1+plan->ns1-1,1,0,0,2);
+    if (plan->pre_plan == NULL) return NULL;
+    plan->post_plan =
+      remap_3d_create_plan(comm,0,nfast-1,plan->mlo1,plan->mlo1+plan->nm1-1,
+			   plan->slo1,plan->slo1+plan->ns1-1,
+			   in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,1,0,0,2);
+    if (plan->post_plan == NULL) return NULL;
+  }
+
+/* counts (in doubles) per plane of each transpose, for each proc in
+   the row or column */
+
+  aper = (int *) malloc(MAX(np1,np2)*sizeof(int));
+  bper = (int *) malloc(MAX(np1,np2)*sizeof(int));
+  if (aper == NULL || bper == NULL) return NULL;
+
+  for (p = 0; p < np1; p++) {
+    aper[p] = 2*plan->nm1*(plan->rflo[p+1] - plan->rflo[p]);
+    bper[p] = 2*plan->nf2*(plan->rmlo[p+1] - plan->rmlo[p]);
+  }
+  pencil_xpose_setup(&(plan->x1),row,plan->ns1,nchunk,aper,bper);
+
+  for (p = 0; p < np2; p++) {
+    aper[p] = 2*plan->ns1*(plan->cmlo[p+1] - plan->cmlo[p]);
+    bper[p] = 2*plan->nm3*(plan->cslo[p+1] - plan->cslo[p]);
+  }
+  pencil_xpose_setup(&(plan->x2),col,plan->nf2,nchunk,aper,bper);
+
+  free(aper);
+  free(bper);
+
+/* allocate work space
+   c1,c2 hold the complex data of the 1st and 2nd FFTs
+   sbuf,rbuf must hold a complete transpose, since all chunks may be in flight
+   rcopy holds real data along fast axis if a pre/post remap is needed */
+
+  in_size = (in_ihi-in_ilo+1) * (in_jhi-in_jlo+1) * (in_khi-in_klo+1);
+  rfirst_size = nfast * plan->nm1 * plan->ns1;
+  size1 = nhalf * plan->nm1 * plan->ns1;
+  size2 = plan->nf2 * nmid * plan->ns1;
+  size3 = plan->nf2 * plan->nm3 * nslow;
+
+  buf_size = MAX(size1,size2);
+  buf_size = MAX(buf_size,size3);
+  buf_size = MAX(buf_size,1);
+  size1 = MAX(size1,1);
+  size2 = MAX(size2,1);
+
+  plan->c1 = (FFT_DATA *) fftw_malloc(size1*sizeof(FFT_DATA));
+  plan->c2 = (FFT_DATA *) fftw_malloc(size2*sizeof(FFT_DATA));
+  plan->sbuf = (double *) fftw_malloc(2*buf_size*sizeof(double));
+  plan->rbuf = (double *) fftw_malloc(2*buf_size*sizeof(double));
+  if (plan->c1 == NULL || plan->c2 == NULL ||
+      plan->sbuf == NULL || plan->rbuf == NULL) return NULL;
+  *nbuf = size1 + size2 + 2*buf_size;
+
+  if (plan->pre_plan) {
+    rfirst_size = MAX(rfirst_size,1);
+    scratch_size = MAX(rfirst_size,in_size);
+    plan->rcopy = (double *) fftw_malloc(rfirst_size*sizeof(double));
+    plan->scratch = (double *) fftw_malloc(scratch_size*sizeof(double));
+    if (plan->rcopy == NULL || plan->scratch == NULL) return NULL;
+    *nbuf += (rfirst_size + scratch_size + 1)/2;
+  }
+  else {
+    plan->rcopy = NULL;
+    plan->scratch = NULL;
+  }
+
+/* system specific pre-computation of 1d FFT coeffs for each chunk
+   the buffers are only used for planning, and FFTW_UNALIGNED allows the
+   plans to be applied at the offset of every chunk */
+
+  n = plan->x1.nchunk;
+  plan->plan_fast_r2c = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+  plan->plan_fast_c2r = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+  plan->plan_mid_forward = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+  plan->plan_mid_backward = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+  n = plan->x2.nchunk;
+  plan->plan_slow_forward = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+  plan->plan_slow_backward = (fftw_plan *) malloc(n*sizeof(fftw_plan));
+
+  for (c = 0; c < plan->x1.nchunk; c++) {
+    plan->plan_fast_r2c[c] = NULL;
+    plan->plan_fast_c2r[c] = NULL;
+    plan->plan_mid_forward[c] = NULL;
+    plan->plan_mid_backward[c] = NULL;
+
+    n = (plan->x1.cb[c+1] - plan->x1.cb[c])*plan->nm1;
+    if (n > 0) {
+      plan->plan_fast_r2c[c] =
+	fftw_plan_many_dft_r2c(1,&(plan->nfast),n,
+			       plan->sbuf,NULL,1,nfast,
+			       (FFT_DATA *) plan->rbuf,NULL,1,nhalf,flags);
+      plan->plan_fast_c2r[c] =
+	fftw_plan_many_dft_c2r(1,&(plan->nfast),n,
+			       (FFT_DATA *) plan->rbuf,NULL,1,nhalf,
+			       plan->sbuf,NULL,1,nfast,flags);
+    }
+
+    n = (plan->x1.cb[c+1] - plan->x1.cb[c])*plan->nf2;
+    if (n > 0) {
+      plan->plan_mid_forward[c] =
+	fftw_plan_many_dft(1,&(plan->nmid),n,
+			   plan->c2,NULL,1,nmid,plan->c2,NULL,1,nmid,
+			   FFTW_FORWARD,flags);
+      plan->plan_mid_backward[c] =
+	fftw_plan_many_dft(1,&(plan->nmid),n,
+			   plan->c2,NULL,1,nmid,plan->c2,NULL,1,nmid,
+			   FFTW_BACKWARD,flags);
+    }
+  }
+
+  for (c = 0; c < plan->x2.nchunk; c++) {
+    plan->plan_slow_forward[c] = NULL;
+    plan->plan_slow_backward[c] = NULL;
+
+    n = plan->x2.cb[c+1] - plan->x2.cb[c];
+    if (n > 0 && plan->nm3 > 0) {
+      plan->plan_slow_forward[c] =
+	fftw_plan_many_dft(1,&(plan->nslow),n,
+			   (FFT_DATA *) plan->rbuf,NULL,1,nslow,
+			   (FFT_DATA *) plan->rbuf,NULL,1,nslow,
+			   FFTW_FORWARD,flags);
+      plan->plan_slow_backward[c] =
+	fftw_plan_many_dft(1,&(plan->nslow),n,
+			   (FFT_DATA *) plan->rbuf,NULL,1,nslow,
+			   (FFT_DATA *) plan->rbuf,NULL,1,nslow,
+			   FFTW_BACKWARD,flags);
+    }
+  }
+
+  return plan;
+}
+
+/* ------------------------------------------------------------------- */
+/* Destroy a 3d pencil fft plan */
+
+void pencil_3d_destroy_plan(struct pencil_plan_3d *plan)
+
+{
+  int c;
+
+  if (plan->pre_plan) remap_3d_destroy_plan(plan->pre_plan);
+  if (plan->post_plan) remap_3d_destroy_plan(plan->post_plan);
+
+  for (c = 0; c < plan->x1.nchunk; c++) {
+    if (plan->plan_fast_r2c[c]) fftw_destroy_plan(plan->plan_fast_r2c[c]);
+    if (plan->plan_fast_c2r[c]) fftw_destroy_plan(plan->plan_fast_c2r[c]);
+    if (plan->plan_mid_forward[c])
+      fftw_destroy_plan(plan->plan_mid_forward[c]);
+    if (plan->plan_mid_backward[c])
+      fftw_destroy_plan(plan->plan_mid_backward[c]);
+  }
+  for (c = 0; c < plan->x2.nchunk; c++) {
+    if (plan->plan_slow_forward[c])
+      fftw_destroy_plan(plan->plan_slow_forward[c]);
+    if (plan->plan_slow_backward[c])
+      fftw_destroy_plan(plan->plan_slow_backward[c]);
+  }
+  free(plan->plan_fast_r2c);
+  free(plan->plan_fast_c2r);
+  free(plan->plan_mid_forward);
+  free(plan->plan_mid_backward);
+  free(plan->plan_slow_forward);
+  free(plan->plan_slow_backward);
+
+  pencil_xpose_free(&(plan->x1));
+  pencil_xpose_free(&(plan->x2));
+
+  if (plan->rcopy) fftw_free(plan->rcopy);
+  if (plan->scratch) fftw_free(plan->scratch);
+  fftw_free(plan->c1);
+  fftw_free(plan->c2);
+  fftw_free(plan->sbuf);
+  fftw_free(plan->rbuf);
+
+  free(plan->rmlo);
+  free(plan->rflo);
+  free(plan->cslo);
+  free(plan->cmlo);
+  free(plan);
+}
+
+/* ------------------------------------------------------------------- */
+/* Set up the chunks, counts and displacements of one transpose
+
+   comm         row or column communicator of the transpose
+   nplane       # of planes (along the axis that is local on both sides)
+   nchunk       requested # of chunks
+   aper,bper    # of doubles per plane for each proc on side a and b
+*/
+
+static void pencil_xpose_setup(struct pencil_xpose_3d *x, MPI_Comm comm,
+			       int nplane, int nchunk, int *aper, int *bper)
+
+{
+  int c,p,n,np,atot,btot;
+
+  MPI_Comm_size(comm,&np);
+  x->comm = comm;
+  x->np = np;
+
+/* every proc in comm has the same # of planes, so agrees on the chunks */
+
+  nchunk = MIN(nchunk,nplane);
+  x->nchunk = MAX(nchunk,1);
+
+  x->cb = (int *) malloc((x->nchunk+1)*sizeof(int));
+  x->acnt = (int *) malloc(x->nchunk*np*sizeof(int));
+  x->adsp = (int *) malloc(x->nchunk*np*sizeof(int));
+  x->bcnt = (int *) malloc(x->nchunk*np*sizeof(int));
+  x->bdsp = (int *) malloc(x->nchunk*np*sizeof(int));
+  x->aoff = (int *) malloc(x->nchunk*sizeof(int));
+  x->boff = (int *) malloc(x->nchunk*sizeof(int));
+  x->req = (MPI_Request *) malloc(x->nchunk*sizeof(MPI_Request));
+
+  for (c = 0; c <= x->nchunk; c++) x->cb[c] = c*nplane/x->nchunk;
+
+  atot = btot = 0;
+  for (c = 0; c < x->nchunk; c++) {
+    n = x->cb[c+1] - x->cb[c];
+    x->aoff[c] = atot;
+    x->boff[c] = btot;
+    for (p = 0; p < np; p++) {
+      x->acnt[c*np+p] = n*aper[p];
+      x->adsp[c*np+p] = atot - x->aoff[c];
+      atot += n*aper[p];
+      x->bcnt[c*np+p] = n*bper[p];
+      x->bdsp[c*np+p] = btot - x->boff[c];
+      btot += n*bper[p];
+    }
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Free memory of one transpose */
+
+static void pencil_xpose_free(struct pencil_xpose_3d *x)
+
+{
+  free(x->cb);
+  free(x->acnt);
+  free(x->adsp);
+  free(x->bcnt);
+  free(x->bdsp);
+  free(x->aoff);
+  free(x->boff);
+  free(x->req);
+  MPI_Comm_free(&(x->comm));
+}
+
+/* ------------------------------------------------------------------- */
+/* Start the non-blocking transpose of chunk c
+   forward = 1 sends side a and receives side b, forward = 0 the reverse */
+
+static void pencil_start(struct pencil_xpose_3d *x, int c, int forward,
+			 double *sbuf, double *rbuf)
+
+{
+  int o = c*x->np;
+
+  if (forward)
+    MPI_Ialltoallv(sbuf + x->aoff[c],x->acnt+o,x->adsp+o,MPI_DOUBLE,
+		   rbuf + x->boff[c],x->bcnt+o,x->bdsp+o,MPI_DOUBLE,
+		   x->comm,&(x->req[c]));
+  else
+    MPI_Ialltoallv(sbuf + x->boff[c],x->bcnt+o,x->bdsp+o,MPI_DOUBLE,
+		   rbuf + x->aoff[c],x->acnt+o,x->adsp+o,MPI_DOUBLE,
+		   x->comm,&(x->req[c]));
+}
+
+/* ------------------------------------------------------------------- */
+/* Copy chunk c of c1 to (pack != 0) or from (pack = 0) the x1 buffer,
+   side a of x1: buf order is slow,mid,fast(of dest) */
+
+static void pencil_copy_c1(struct pencil_plan_3d *plan, int c, double *buf,
+			   int pack)
+
+{
+  struct pencil_xpose_3d *x = &(plan->x1);
+  FFT_DATA *a;
+  double *b;
+  int p,k,j,n;
+
+  for (p = 0; p < x->np; p++) {
+    b = buf + x->aoff[c] + x->adsp[c*x->np+p];
+    n = (plan->rflo[p+1] - plan->rflo[p])*sizeof(FFT_DATA);
+    for (k = x->cb[c]; k < x->cb[c+1]; k++) {
+      for (j = 0; j < plan->nm1; j++) {
+	a = plan->c1 + (k*plan->nm1 + j)*plan->nhalf + plan->rflo[p];
+	if (pack) memcpy(b,a,n);
+	else memcpy(a,b,n);
+	b += 2*(plan->rflo[p+1] - plan->rflo[p]);
+      }
+    }
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Copy chunk c of c2 to/from the x1 buffer
+   side b of x1: buf order is slow,mid(of source),fast */
+
+static void pencil_copy_c2_x1(struct pencil_plan_3d *plan, int c,
+			      double *buf, int pack)
+
+{
+  struct pencil_xpose_3d *x = &(plan->x1);
+  FFT_DATA *a;
+  double *b;
+  int p,k,j,i,nmid = plan->nmid;
+
+  for (p = 0; p < x->np; p++) {
+    b = buf + x->boff[c] + x->bdsp[c*x->np+p];
+    for (k = x->cb[c]; k < x->cb[c+1]; k++) {
+      for (j = plan->rmlo[p]; j < plan->rmlo[p+1]; j++) {
+	a = plan->c2 + k*plan->nf2*nmid + j;
+	if (pack) {
+	  for (i = 0; i < plan->nf2; i++) {
+	    *(b++) = a[i*nmid][0];
+	    *(b++) = a[i*nmid][1];
+	  }
+	} else {
+	  for (i = 0; i < plan->nf2; i++) {
+	    a[i*nmid][0] = *(b++);
+	    a[i*nmid][1] = *(b++);
+	  }
+	}
+      }
+    }
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Copy chunk c of c2 to/from the x2 buffer
+   side a of x2: buf order is slow,fast,mid(of dest) */
+
+static void pencil_copy_c2_x2(struct pencil_plan_3d *plan, int c,
+			      double *buf, int pack)
+
+{
+  struct pencil_xpose_3d *x = &(plan->x2);
+  FFT_DATA *a;
+  double *b;
+  int p,k,i,n;
+
+  for (p = 0; p < x->np; p++) {
+    b = buf + x->aoff[c] + x->adsp[c*x->np+p];
+    n = (plan->cmlo[p+1] - plan->cmlo[p])*sizeof(FFT_DATA);
+    for (k = 0; k < plan->ns1; k++) {
+      for (i = x->cb[c]; i < x->cb[c+1]; i++) {
+	a = plan->c2 + (k*plan->nf2 + i)*plan->nmid + plan->cmlo[p];
+	if (pack) memcpy(b,a,n);
+	else memcpy(a,b,n);
+	b += 2*(plan->cmlo[p+1] - plan->cmlo[p]);
+      }
+    }
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Copy chunk c of the output to/from the x2 buffer
+   side b of x2: buf order is slow(of source),fast,mid */
+
+static void pencil_copy_out(struct pencil_plan_3d *plan, int c,
+			    FFT_DATA *data, double *buf, int pack)
+
+{
+  struct pencil_xpose_3d *x = &(plan->x2);
+  FFT_DATA *a;
+  double *b;
+  int p,k,j,i,nslow = plan->nslow;
+  int jstride = plan->nf2*nslow;
+
+  for (p = 0; p < x->np; p++) {
+    b = buf + x->boff[c] + x->bdsp[c*x->np+p];
+    for (k = plan->cslo[p]; k < plan->cslo[p+1]; k++) {
+      for (i = x->cb[c]; i < x->cb[c+1]; i++) {
+	a = data + i*nslow + k;
+	if (pack) {
+	  for (j = 0; j < plan->nm3; j++) {
+	    *(b++) = a[j*jstride][0];
+	    *(b++) = a[j*jstride][1];
+	  }
+	} else {
+	  for (j = 0; j < plan->nm3; j++) {
+	    a[j*jstride][0] = *(b++);
+	    a[j*jstride][1] = *(b++);
+	  }
+	}
+      }
+    }
+  }
+}
+
+#endif /* FFT_PENCIL */
@@ -0,0 +1,74 @@
+#ifndef PENCIL_FFT_3D
+#define PENCIL_FFT_3D
+
+/* parallel real-to-complex 3d FFT using a pencil decomposition, with the
+   transposes between the 1d FFT stages split into chunks and done with
+   non-blocking all-to-all's (MPI-3), so that communication of one chunk
+   is overlapped with the 1d FFTs of its neighbours
+
+   The procs are arranged in a np1 x np2 grid (see bifactor() in
+   factor.c), and every transpose only involves a row (np1 procs) or a
+   column (np2 procs) of this grid, never all procs.  Data distributions
+   and storage order are identical to fft_3d_r2c(), so the two can be
+   exchanged freely.
+*/
+
+#include "fft_3d.h"
+
+/* default # of chunks each transpose is split into */
+
+#define PENCIL_NCHUNK 4
+
+/* details of one pipelined transpose between two stages of 1d FFTs
+   side "a" is the stage before the transpose in the forward direction,
+   side "b" is the stage after it, all counts/offsets are in doubles */
+
+struct pencil_xpose_3d {
+  MPI_Comm comm;                    /* row or column communicator */
+  int np;                           /* # of procs in comm */
+  int nchunk;                       /* # of chunks */
+  int *cb;                          /* chunk c covers planes cb[c]..cb[c+1]-1 */
+  int *acnt,*adsp;                  /* counts,displs of side a for each chunk */
+  int *bcnt,*bdsp;                  /* counts,displs of side b for each chunk */
+  int *aoff,*boff;                  /* offset of each chunk in buffers */
+  MPI_Request *req;                 /* one request per chunk */
+};
+
+struct pencil_plan_3d {
+  struct remap_plan_3d *pre_plan;       /* remap real input -> 1st FFTs */
+  struct remap_plan_3d *post_plan;      /* remap real 1st FFTs -> output */
+  struct pencil_xpose_3d x1;            /* transpose 1st <-> 2nd FFTs (rows) */
+  struct pencil_xpose_3d x2;            /* transpose 2nd <-> 3rd FFTs (cols) */
+  int nfast,nmid,nslow,nhalf;       /* global sizes */
+  int np1,np2;                      /* proc grid */
+  int mlo1,nm1,slo1,ns1;            /* mid,slow ranges of 1st FFTs */
+  int flo2,nf2;                     /* fast range of 2nd and 3rd FFTs */
+  int mlo3,nm3;                     /* mid range of 3rd FFTs */
+  int *rmlo,*rflo;                  /* mid,fast starts of each proc in row */
+  int *cslo,*cmlo;                  /* slow,mid starts of each proc in col */
+  double *rcopy;                    /* real data along fast axis */
+  FFT_DATA *c1;                     /* complex data after 1st FFTs */
+  FFT_DATA *c2;                     /* complex data during 2nd FFTs */
+  double *sbuf,*rbuf;               /* send/recv buffers for transposes */
+  double *scratch;                  /* scratch space for pre/post remaps */
+  int out_ilo,out_ihi;              /* bounds of complex output I own */
+  int out_jlo,out_jhi;              /*   (stored slow,fast,mid from fastest */
+  int out_klo,out_khi;              /*    to slowest varying) */
+                                    /* system specific 1d FFT info, per chunk */
+  fftw_plan *plan_fast_r2c;
+  fftw_plan *plan_fast_c2r;
+  fftw_plan *plan_mid_forward;
+  fftw_plan *plan_mid_backward;
+  fftw_plan *plan_slow_forward;
+  fftw_plan *plan_slow_backward;
+};
+
+/* function prototypes */
+
+void pencil_3d_r2c(double *, FFT_DATA *, struct pencil_plan_3d *);
+void pencil_3d_c2r(FFT_DATA *, double *, struct pencil_plan_3d *);
+struct pencil_plan_3d *pencil_3d_create_plan(MPI_Comm, int, int, int,
+  int, int, int, int, int, int, int, int *);
+void pencil_3d_destroy_plan(struct pencil_plan_3d *);
+
+#endif
@@ -36,12 +36,16 @@
 #ifdef FFT_BLOCK_DECOMP
 /* Include Steve Plimpton's FFTW interface code */
 #include "fft_3d.h"
+#ifdef FFT_PENCIL
+#include "pencil_3d.h"
+#endif /* FFT_PENCIL */
 #else /* FFT_BLOCK_DECOMP */
 /* For a single processor, use FFTW 3.1.2 directly */
 #include "fftw3.h"
 #endif /* FFT_BLOCK_DECOMP */
 
 #define ath_fft_data fftw_complex
+#define ath_fft_real double
 
 /* Indexing convention of FFT data
  * FFT Nfast=k, Nmid=j, Nslow=i (opposite to Athena) */
@@ -68,6 +72,34 @@ struct ath_3d_fft_plan {
   long int gcnt;
 };
 
+/* Plan for real-to-complex (forward) and complex-to-real (backward) 3D FFTs.
+ * Only the Nx3/2+1 non-negative wavenumbers are stored along x3, and the
+ * layout of the complex data differs between the serial and MPI versions,
+ * so it must be accessed through F3DK() using the index ranges kis..kke.
+ * These ranges are in GLOBAL coordinates (starting at 0), and i,j,k refer
+ * to the x1,x2,x3 directions respectively. */
+struct ath_3d_fft_r2c_plan {
+#ifdef FFT_BLOCK_DECOMP
+#ifdef FFT_PENCIL
+  struct pencil_plan_3d *plan;
+#else /* FFT_PENCIL */
+  struct fft_plan_3d_r2c *plan;
+#endif /* FFT_PENCIL */
+#else /* FFT_BLOCK_DECOMP */
+  fftw_plan fplan;
+  fftw_plan bplan;
+#endif /* FFT_BLOCK_DECOMP */
+  long int rcnt;          /* # of real values on this proc */
+  long int cnt;           /* # of complex values on this proc */
+  long int gcnt;          /* # of real values in global grid */
+  int kis, kie, kjs, kje, kks, kke;   /* extents of local complex data */
+  long int ksi, ksj, ksk;             /* strides of complex data in i,j,k */
+};
+
+/* Indexing convention of complex data from a real-to-complex 3D FFT */
+#define F3DK(i, j, k, p) (((i)-(p)->kis)*(p)->ksi + ((j)-(p)->kjs)*(p)->ksj \
+			+ ((k)-(p)->kks)*(p)->ksk)
+
 struct ath_2d_fft_plan {
 #ifdef FFT_BLOCK_DECOMP
   struct fft_plan_2d *plan;
@@ -96,6 +128,20 @@ void ath_3d_fft(struct ath_3d_fft_plan *ath_plan, ath_fft_data *data);
 void ath_3d_fft_free(ath_fft_data *data);
 void ath_3d_fft_destroy_plan(struct ath_3d_fft_plan *ath_plan);
 
+struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_quick_plan(DomainS *pD);
+struct ath_3d_fft_r2c_plan *ath_3d_fft_r2c_create_plan(DomainS *pD,
+				int gnx3, int gnx2, int gnx1,
+				int gks, int gke, int gjs, int gje,
+				int gis, int gie);
+ath_fft_data *ath_3d_fft_r2c_malloc(struct ath_3d_fft_r2c_plan *ath_plan);
+ath_fft_real *ath_3d_fft_real_malloc(struct ath_3d_fft_r2c_plan *ath_plan);
+void ath_3d_fft_r2c(struct ath_3d_fft_r2c_plan *ath_plan, ath_fft_real *in,
+				ath_fft_data *out);
+void ath_3d_fft_c2r(struct ath_3d_fft_r2c_plan *ath_plan, ath_fft_data *in,
+				ath_fft_real *out);
+void ath_3d_fft_real_free(ath_fft_real *data);
+void ath_3d_fft_r2c_destroy_plan(struct ath_3d_fft_r2c_plan *ath_plan);
+
 /**************************************************************************
  *
  *  Athena 2D FFT functions
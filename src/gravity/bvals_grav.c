@@ -6,14 +6,16 @@
  *
  * PURPOSE: Sets boundary conditions (quantities in ghost zones) for the
  *   gravitational potential on each edge of a Grid.  See comments at
- *   start of bvals_mhd.c for more details.
+ *   start of bvals_mhd.c for more details.  Messages are sent as floats
+ *   with halo_compress=1 or 2 in the <job> block, as for bvals_mhd().
  * The only BC functions implemented here are for:
  *- 1 = reflecting, 4 = periodic, and MPI boundaries
  *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - bvals_grav()      - calls appropriate functions to set ghost cells
  * - bvals_grav_init() - sets function pointers used by bvals_grav()
- * - bvals_grav_fun()  - enrolls a pointer to a user-defined BC function */
+ * - bvals_grav_fun()  - enrolls a pointer to a user-defined BC function
+ * - bvals_grav_destruct() - frees MPI buffers and requests */
 /*============================================================================*/
 
 #include <stdio.h>
@@ -29,8 +31,22 @@
 
 #ifdef MPI_PARALLEL
 /* MPI send and receive buffers */
-static double **send_buf = NULL, **recv_buf = NULL;
-static MPI_Request *recv_rq, *send_rq;
+static GReal **send_buf = NULL, **recv_buf = NULL;
+/* requests of the Domain and direction being updated, from persist_rq */
+static MPI_Request *recv_rq = NULL, *send_rq = NULL;
+
+/*! \struct PersistRqS
+ *  \brief Persistent requests for the exchange with the L and R Grids in
+ *   each direction, for the Grid in one Domain. */
+typedef struct PersistRq_s{
+  DomainS *pD;                /*!< Domain of Grid */
+  int cnt[3];                 /*!< words passed in x1,x2,x3 */
+  MPI_Request recv_rq[3][2];  /*!< receives from L,R Grids in x1,x2,x3 */
+  MPI_Request send_rq[3][2];  /*!< sends to L,R Grids in x1,x2,x3 */
+}PersistRqS;
+
+static PersistRqS *persist_rq = NULL;
+static int npersist_rq = 0;
 #endif /* MPI_PARALLEL */
 
 /*==============================================================================
@@ -39,6 +55,8 @@ static MPI_Request *recv_rq, *send_rq;
  *   periodic_Phi_???() - apply periodic BCs at boundary ???
  *   pack_Phi_???()   - pack data for MPI non-blocking send at ??? boundary
  *   unpack_Phi_???() - unpack data for MPI non-blocking receive at ??? boundary
+ *   persist_init()   - creates persistent requests for one Domain
+ *   persist_find()   - returns persistent requests of Domain
  *============================================================================*/
 
 static void reflect_Phi_ix1(GridS *pG);
@@ -78,6 +96,9 @@ static void unpack_Phi_ix2(GridS *pG);
 static void unpack_Phi_ox2(GridS *pG);
 static void unpack_Phi_ix3(GridS *pG);
 static void unpack_Phi_ox3(GridS *pG);
+
+static void persist_init(DomainS *pD);
+static PersistRqS *persist_find(const DomainS *pD);
 #endif /* MPI_PARALLEL */
 
 /*=========================== PUBLIC FUNCTIONS ===============================*/
@@ -102,7 +123,8 @@ void bvals_grav(DomainS *pD)
   int myL,myM,myN;
 #endif
 #ifdef MPI_PARALLEL
-  int cnt1, cnt2, cnt3, cnt, ierr, mIndex;
+  int ierr, mIndex;
+  PersistRqS *pR = persist_find(pD);
 #endif /* MPI_PARALLEL */
 
 /*--- Step 1. ------------------------------------------------------------------
@@ -112,34 +134,35 @@ void bvals_grav(DomainS *pD)
 
 #ifdef MPI_PARALLEL
 
-    cnt = nghost*(pGrid->Nx[1])*(pGrid->Nx[2]);
+    recv_rq = pR->recv_rq[0];
+    send_rq = pR->send_rq[0];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx1_Gid >= 0 && pGrid->lx1_Gid >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_Phi_ix1(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_Phi_ox1(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[0]);
       if (mIndex == 0) unpack_Phi_ix1(pGrid);
       if (mIndex == 1) unpack_Phi_ox1(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[0]);
       if (mIndex == 0) unpack_Phi_ix1(pGrid);
       if (mIndex == 1) unpack_Phi_ox1(pGrid);
 
@@ -148,14 +171,13 @@ void bvals_grav(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx1_Gid >= 0 && pGrid->lx1_Gid < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data R */
       pack_Phi_ox1(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx1_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* set physical boundary */
       (*(pD->ix1_GBCFun))(pGrid);
@@ -165,6 +187,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[0]);
       unpack_Phi_ox1(pGrid);
 
     }
@@ -172,14 +195,13 @@ void bvals_grav(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx1_Gid < 0 && pGrid->lx1_Gid >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
 
       /* pack and send data L */
       pack_Phi_ix1(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx1_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[0]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       /* set physical boundary */
       (*(pD->ox1_GBCFun))(pGrid);
@@ -189,6 +211,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[0]);
       unpack_Phi_ix1(pGrid);
 
     }
@@ -209,34 +232,35 @@ void bvals_grav(DomainS *pD)
 
 #ifdef MPI_PARALLEL
 
-    cnt = (pGrid->Nx[0] + 2*nghost)*nghost*(pGrid->Nx[2]);
+    recv_rq = pR->recv_rq[1];
+    send_rq = pR->send_rq[1];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx2_Gid >= 0 && pGrid->lx2_Gid >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_Phi_ix2(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_Phi_ox2(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[1]);
       if (mIndex == 0) unpack_Phi_ix2(pGrid);
       if (mIndex == 1) unpack_Phi_ox2(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[1]);
       if (mIndex == 0) unpack_Phi_ix2(pGrid);
       if (mIndex == 1) unpack_Phi_ox2(pGrid);
 
@@ -245,14 +269,13 @@ void bvals_grav(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx2_Gid >= 0 && pGrid->lx2_Gid < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data R */
       pack_Phi_ox2(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx2_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* set physical boundary */
       (*(pD->ix2_GBCFun))(pGrid);
@@ -262,6 +285,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[1]);
       unpack_Phi_ox2(pGrid);
 
     }
@@ -269,14 +293,13 @@ void bvals_grav(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx2_Gid < 0 && pGrid->lx2_Gid >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
 
       /* pack and send data L */
       pack_Phi_ix2(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx2_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[1]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       /* set physical boundary */
       (*(pD->ox2_GBCFun))(pGrid);
@@ -286,6 +309,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[1]);
       unpack_Phi_ix2(pGrid);
 
     }
@@ -317,34 +341,35 @@ void bvals_grav(DomainS *pD)
 
 #ifdef MPI_PARALLEL
 
-    cnt = (pGrid->Nx[0] + 2*nghost)*(pGrid->Nx[1] + 2*nghost)*nghost;
+    recv_rq = pR->recv_rq[2];
+    send_rq = pR->send_rq[2];
 
 /* MPI blocks to both left and right */
     if (pGrid->rx3_Gid >= 0 && pGrid->lx3_Gid >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_rq[0]));
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data L and R */
       pack_Phi_ix3(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       pack_Phi_ox3(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* check non-blocking sends have completed. */
       ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[2]);
       if (mIndex == 0) unpack_Phi_ix3(pGrid);
       if (mIndex == 1) unpack_Phi_ox3(pGrid);
       ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[mIndex], pR->cnt[2]);
       if (mIndex == 0) unpack_Phi_ix3(pGrid);
       if (mIndex == 1) unpack_Phi_ox3(pGrid);
 
@@ -353,14 +378,13 @@ void bvals_grav(DomainS *pD)
 /* Physical boundary on left, MPI block on right */
     if (pGrid->rx3_Gid >= 0 && pGrid->lx3_Gid < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_Gid,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_rq[1]));
 
       /* pack and send data R */
       pack_Phi_ox3(pGrid);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pGrid->rx3_Gid,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      halo_compress(send_buf[1], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[1]));
 
       /* set physical boundary */
       (*(pD->ix3_GBCFun))(pGrid);
@@ -370,6 +394,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from R and unpack data */
       ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[1], pR->cnt[2]);
       unpack_Phi_ox3(pGrid);
 
     }
@@ -377,14 +402,13 @@ void bvals_grav(DomainS *pD)
 /* MPI block on left, Physical boundary on right */
     if (pGrid->rx3_Gid < 0 && pGrid->lx3_Gid >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_Gid,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_rq[0]));
 
       /* pack and send data L */
       pack_Phi_ix3(pGrid);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pGrid->lx3_Gid,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      halo_compress(send_buf[0], pR->cnt[2]);
+      ierr = MPI_Start(&(send_rq[0]));
 
       /* set physical boundary */
       (*(pD->ox3_GBCFun))(pGrid);
@@ -394,6 +418,7 @@ void bvals_grav(DomainS *pD)
 
       /* wait on non-blocking receive from L and unpack data */
       ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      halo_expand(recv_buf[0], pR->cnt[2]);
       unpack_Phi_ix3(pGrid);
     }
 #endif /* MPI_PARALLEL */
@@ -765,7 +790,7 @@ void bvals_grav_init(MeshS *pM)
   }}}  /* End loop over all Domains with active Grids -----------------------*/
 
 #ifdef MPI_PARALLEL
-/* Allocate memory for send/receive buffers and MPI_Requests */
+/* Allocate memory for send/receive buffers */
 
   size = x1cnt > x2cnt ? x1cnt : x2cnt;
   size = x3cnt >  size ? x3cnt : size;
@@ -773,17 +798,21 @@ void bvals_grav_init(MeshS *pM)
   size *= nghost; /* Multiply by the third dimension */
 
   if (size > 0) {
-    if((send_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    if((send_buf = (GReal**)calloc_2d_array(2,size,sizeof(GReal))) == NULL)
       ath_error("[bvals_init]: Failed to allocate send buffer\n");
 
-    if((recv_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    if((recv_buf = (GReal**)calloc_2d_array(2,size,sizeof(GReal))) == NULL)
       ath_error("[bvals_init]: Failed to allocate recv buffer\n");
   }
 
-  if((recv_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
-    ath_error("[bvals_init]: Failed to allocate recv MPI_Request array\n");
-  if((send_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
-    ath_error("[bvals_init]: Failed to allocate send MPI_Request array\n");
+/* Create persistent requests for each Domain with a Grid on this proc */
+
+  for (nl=0; nl<(pM->NLevels); nl++){
+    for (nd=0; nd<(pM->DomainsPerLevel[nl]); nd++){
+      if (pM->Domain[nl][nd].Grid != NULL)
+        persist_init((DomainS*)&(pM->Domain[nl][nd]));
+    }
+  }
 
 #endif /* MPI_PARALLEL */
 
@@ -823,6 +852,37 @@ void bvals_grav_fun(DomainS *pD, enum BCDirection dir, VGFun_t prob_bc)
   return;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \fn void bvals_grav_destruct(void)
+ *  \brief Frees MPI send/receive buffers and persistent requests.
+ */
+
+void bvals_grav_destruct(void)
+{
+#ifdef MPI_PARALLEL
+  int n,m;
+
+  for (n=0; n<npersist_rq; n++) {
+    for (m=0; m<6; m++) {
+      if (persist_rq[n].recv_rq[m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(persist_rq[n].recv_rq[m/2][m%2]));
+      if (persist_rq[n].send_rq[m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(persist_rq[n].send_rq[m/2][m%2]));
+    }
+  }
+  if (persist_rq != NULL) free(persist_rq);
+  persist_rq = NULL;
+  npersist_rq = 0;
+
+  if (send_buf != NULL) free_2d_array(send_buf);
+  if (recv_buf != NULL) free_2d_array(recv_buf);
+  send_buf = recv_buf = NULL;
+  recv_rq = send_rq = NULL;
+#endif /* MPI_PARALLEL */
+
+  return;
+}
+
 /*=========================== PRIVATE FUNCTIONS ==============================*/
 /* Following are the functions:
  *   reflecting_???
@@ -1273,8 +1333,8 @@ static void pack_Phi_ix1(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
 
 /* Pack only Phi into send buffer */
   for (k=ks; k<=ke; k++){
@@ -1298,8 +1358,8 @@ static void pack_Phi_ox1(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
 
 /* Pack only Phi into send buffer */
   for (k=ks; k<=ke; k++){
@@ -1323,8 +1383,8 @@ static void pack_Phi_ix2(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
 
 /* Pack only Phi into send buffer */
   for (k=ks; k<=ke; k++){
@@ -1348,8 +1408,8 @@ static void pack_Phi_ox2(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
 
 /* Pack only Phi into send buffer */
 
@@ -1374,8 +1434,8 @@ static void pack_Phi_ix3(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[0][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[0][0]);
 
 /* Pack only Phi into send buffer */
 
@@ -1400,8 +1460,8 @@ static void pack_Phi_ox3(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pSnd;
-  pSnd = (double*)&(send_buf[1][0]);
+  GReal *pSnd;
+  pSnd = (GReal*)&(send_buf[1][0]);
 
 /* Pack only Phi into send buffer */
 
@@ -1426,8 +1486,8 @@ static void unpack_Phi_ix1(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1454,8 +1514,8 @@ static void unpack_Phi_ox1(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1480,8 +1540,8 @@ static void unpack_Phi_ix2(GridS *pG)
   int js = pG->js;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1506,8 +1566,8 @@ static void unpack_Phi_ox2(GridS *pG)
   int je = pG->je;
   int ks = pG->ks, ke = pG->ke;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1532,8 +1592,8 @@ static void unpack_Phi_ix3(GridS *pG)
   int js = pG->js, je = pG->je;
   int ks = pG->ks;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[0][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[0][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1558,8 +1618,8 @@ static void unpack_Phi_ox3(GridS *pG)
   int js = pG->js, je = pG->je;
   int ke = pG->ke;
   int i,j,k;
-  double *pRcv;
-  pRcv = (double*)&(recv_buf[1][0]);
+  GReal *pRcv;
+  pRcv = (GReal*)&(recv_buf[1][0]);
 
 /* Manually unpack the data from the receive buffer */
 
@@ -1574,6 +1634,74 @@ static void unpack_Phi_ox3(GridS *pG)
   return;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \fn static void persist_init(DomainS *pD)
+ *  \brief Creates persistent requests for the exchange of Phi in the Grid in
+ *   Domain pD with its L and R Grids in each direction, restarted with
+ *   MPI_Start() on every call to bvals_grav(). */
+
+static void persist_init(DomainS *pD)
+{
+  GridS *pG = pD->Grid;
+  PersistRqS *pR;
+  MPI_Datatype type;
+  int cnt[3],lid[3],rid[3],dir,n,ierr;
+
+  if ((persist_rq = (PersistRqS*)realloc(persist_rq,
+       (npersist_rq+1)*sizeof(PersistRqS))) == NULL)
+    ath_error("[bvals_grav_init]: Failed to allocate MPI_Request arrays\n");
+  pR = &(persist_rq[npersist_rq++]);
+  pR->pD = pD;
+
+  lid[0] = pG->lx1_Gid;  rid[0] = pG->rx1_Gid;
+  lid[1] = pG->lx2_Gid;  rid[1] = pG->rx2_Gid;
+  lid[2] = pG->lx3_Gid;  rid[2] = pG->rx3_Gid;
+
+/* Number of words passed in x1/x2/x3-direction by pack_Phi_???() */
+
+  cnt[0] = nghost*(pG->Nx[1])*(pG->Nx[2]);
+  cnt[1] = (pG->Nx[0] + 2*nghost)*nghost*(pG->Nx[2]);
+  cnt[2] = (pG->Nx[0] + 2*nghost)*(pG->Nx[1] + 2*nghost)*nghost;
+
+  for (dir=0; dir<3; dir++) {
+    pR->cnt[dir] = cnt[dir];
+    pR->recv_rq[dir][0] = pR->recv_rq[dir][1] = MPI_REQUEST_NULL;
+    pR->send_rq[dir][0] = pR->send_rq[dir][1] = MPI_REQUEST_NULL;
+    if (pG->Nx[dir] == 1) continue;
+
+    halo_msg_type(cnt[dir], &n, &type);
+    if (lid[dir] >= 0) {
+      ierr = MPI_Recv_init(&(recv_buf[0][0]),n,type,lid[dir],
+        LtoR_tag, pD->Comm_Domain, &(pR->recv_rq[dir][0]));
+      ierr = MPI_Send_init(&(send_buf[0][0]),n,type,lid[dir],
+        RtoL_tag, pD->Comm_Domain, &(pR->send_rq[dir][0]));
+    }
+    if (rid[dir] >= 0) {
+      ierr = MPI_Recv_init(&(recv_buf[1][0]),n,type,rid[dir],
+        RtoL_tag, pD->Comm_Domain, &(pR->recv_rq[dir][1]));
+      ierr = MPI_Send_init(&(send_buf[1][0]),n,type,rid[dir],
+        LtoR_tag, pD->Comm_Domain, &(pR->send_rq[dir][1]));
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static PersistRqS *persist_find(const DomainS *pD)
+ *  \brief Returns persistent requests created for Domain pD. */
+
+static PersistRqS *persist_find(const DomainS *pD)
+{
+  int n;
+
+  for (n=0; n<npersist_rq; n++)
+    if (persist_rq[n].pD == pD) return &(persist_rq[n]);
+  ath_error("[bvals_grav]: no MPI requests for level %d domain %d\n",
+    pD->Level,pD->DomNumber);
+  return NULL;
+}
+
 #endif /* MPI_PARALLEL */
 
 #endif /* SELF_GRAVITY */
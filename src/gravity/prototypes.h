@@ -17,6 +17,7 @@
 void bvals_grav_init(MeshS *pM);
 void bvals_grav_fun(DomainS *pD, enum BCDirection dir, VGFun_t prob_bc);
 void bvals_grav(DomainS *pDomain);
+void bvals_grav_destruct(void);
 #endif
 
 /* selfg.c  */
@@ -92,9 +92,9 @@ void selfg_fc(DomainS *pD)
       flx_m1r -= 0.5*(gxr*gxr)/four_pi_G + grav_mean_rho*phir_old;
 
 /* Update momenta and energy with d/dx1 terms  */
-      pG->U[ks][js][i].M1 -= 0.5*dtodx1*(flx_m1r-flx_m1l);
+      UVAR(pG->U,ks,js,i,M1) -= 0.5*dtodx1*(flx_m1r-flx_m1l);
 #ifndef ISOTHERMAL
-      pG->U[ks][js][i].E -=
+      UVAR(pG->U,ks,js,i,E) -=
          0.5*dtodx1*(pG->x1MassFlux[ks][js][i  ]*(dphic - dphil) +
                      pG->x1MassFlux[ks][js][i+1]*(dphir - dphic));
 #endif
@@ -155,10 +155,10 @@ void selfg_fc(DomainS *pD)
 	flx_m2r -= gxr*gyr/four_pi_G;
 
 /* Update momenta and energy with d/dx1 terms  */
-        pG->U[ks][j][i].M1 -= 0.5*dtodx1*(flx_m1r - flx_m1l);
-        pG->U[ks][j][i].M2 -= 0.5*dtodx1*(flx_m2r - flx_m2l);
+        UVAR(pG->U,ks,j,i,M1) -= 0.5*dtodx1*(flx_m1r - flx_m1l);
+        UVAR(pG->U,ks,j,i,M2) -= 0.5*dtodx1*(flx_m2r - flx_m2l);
 #ifndef ISOTHERMAL
-        pG->U[ks][j][i].E -=
+        UVAR(pG->U,ks,j,i,E) -=
            0.5*dtodx1*(pG->x1MassFlux[ks][j][i  ]*(dphic - dphil) +
                        pG->x1MassFlux[ks][j][i+1]*(dphir - dphic));
 #endif
@@ -216,10 +216,10 @@ void selfg_fc(DomainS *pD)
         flx_m2r -= 0.5*(gyr*gyr-gxr*gxr)/four_pi_G + grav_mean_rho*phir_old;
 
 /* Update momenta and energy with d/dx2 terms  */
-        pG->U[ks][j][i].M1 -= 0.5*dtodx2*(flx_m1r - flx_m1l);
-        pG->U[ks][j][i].M2 -= 0.5*dtodx2*(flx_m2r - flx_m2l);
+        UVAR(pG->U,ks,j,i,M1) -= 0.5*dtodx2*(flx_m1r - flx_m1l);
+        UVAR(pG->U,ks,j,i,M2) -= 0.5*dtodx2*(flx_m2r - flx_m2l);
 #ifndef ISOTHERMAL
-        pG->U[ks][j][i].E -=
+        UVAR(pG->U,ks,j,i,E) -=
            0.5*dtodx2*(pG->x2MassFlux[ks][j  ][i]*(dphic - dphil) +
                        pG->x2MassFlux[ks][j+1][i]*(dphir - dphic));
 #endif
@@ -247,7 +247,7 @@ void selfg_fc(DomainS *pD)
 
 #ifdef STAR_PARTICLE
        if (pG->Gstars != NULL){
-          pG->U[k][j][i].M1 -= 0.5*dtodx1*(dphir-dphil)*pG->U[k][j][i].d; 
+          UVAR(pG->U,k,j,i,M1) -= 0.5*dtodx1*(dphir-dphil)*UVAR(pG->U,k,j,i,d); 
        } else {
 #endif /* STAR_PARTICLE */
 /*  momentum fluxes in x1. gx, gy and gz centered at L and R x1-faces */
@@ -310,15 +310,15 @@ void selfg_fc(DomainS *pD)
         flx_m3l -= gxl*gzl/four_pi_G;
         flx_m3r -= gxr*gzr/four_pi_G;
 /* Update momenta and energy with d/dx1 terms  */
-        pG->U[k][j][i].M1 -= 0.5*dtodx1*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= 0.5*dtodx1*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= 0.5*dtodx1*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= 0.5*dtodx1*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= 0.5*dtodx1*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= 0.5*dtodx1*(flx_m3r - flx_m3l);
 #ifdef STAR_PARTICLE
         }
 #endif
 
 #ifdef ADIABATIC
-        pG->U[k][j][i].E -= 0.5*dtodx1*
+        UVAR(pG->U,k,j,i,E) -= 0.5*dtodx1*
           (pG->x1MassFlux[k][j][i  ]*(dphic - dphil) +
            pG->x1MassFlux[k][j][i+1]*(dphir - dphic));
 #endif /* ADIABATIC */
@@ -341,7 +341,7 @@ void selfg_fc(DomainS *pD)
         dphir = phir - phir_old;
 #ifdef STAR_PARTICLE
        if (pG->Gstars != NULL){
-          pG->U[k][j][i].M2 -= 0.5*dtodx1*(dphir-dphil)*pG->U[k][j][i].d; 
+          UVAR(pG->U,k,j,i,M2) -= 0.5*dtodx1*(dphir-dphil)*UVAR(pG->U,k,j,i,d); 
        } else {
 #endif /* STAR_PARTICLE */
 /* gx, gy and gz centered at L and R x2-faces */
@@ -405,14 +405,14 @@ void selfg_fc(DomainS *pD)
         flx_m3r -= gyr*gzr/four_pi_G;
 
 /* Update momenta and energy with d/dx2 terms  */
-        pG->U[k][j][i].M1 -= 0.5*dtodx2*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= 0.5*dtodx2*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= 0.5*dtodx2*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= 0.5*dtodx2*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= 0.5*dtodx2*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= 0.5*dtodx2*(flx_m3r - flx_m3l);
 #ifdef STAR_PARTICLE
        }
 #endif
 #ifdef ADIABATIC
-        pG->U[k][j][i].E -= 0.5*dtodx2*
+        UVAR(pG->U,k,j,i,E) -= 0.5*dtodx2*
           (pG->x2MassFlux[k][j  ][i]*(dphic - dphil) +
            pG->x2MassFlux[k][j+1][i]*(dphir - dphic));
 #endif /* ADIABATIC */
@@ -436,7 +436,7 @@ void selfg_fc(DomainS *pD)
 
 #ifdef STAR_PARTICLE
        if (pG->Gstars != NULL){
-          pG->U[k][j][i].M3 -= 0.5*dtodx1*(dphir-dphil)*pG->U[k][j][i].d; 
+          UVAR(pG->U,k,j,i,M3) -= 0.5*dtodx1*(dphir-dphil)*UVAR(pG->U,k,j,i,d); 
        } else {
 #endif
 /*  momentum fluxes in x3. gx, gy and gz centered at L and R x3-faces */
@@ -500,14 +500,14 @@ void selfg_fc(DomainS *pD)
                  + grav_mean_rho*phir_old;
 
 /* Update momenta and energy with d/dx3 terms  */
-        pG->U[k][j][i].M1 -= 0.5*dtodx3*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= 0.5*dtodx3*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= 0.5*dtodx3*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= 0.5*dtodx3*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= 0.5*dtodx3*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= 0.5*dtodx3*(flx_m3r - flx_m3l);
 #ifdef STAR_PARTICLE
         }
 #endif
 #ifdef ADIABATIC
-        pG->U[k][j][i].E -= 0.5*dtodx3*
+        UVAR(pG->U,k,j,i,E) -= 0.5*dtodx3*
           (pG->x3MassFlux[k  ][j][i]*(dphic - dphil) +
            pG->x3MassFlux[k+1][j][i]*(dphir - dphic));
 #endif /* ADIABATIC */
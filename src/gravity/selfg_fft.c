@@ -39,8 +39,9 @@
 
 /* plans for forward and backward FFTs; work space for FFTW */
 static struct ath_2d_fft_plan *fplan2d, *bplan2d;
-static struct ath_3d_fft_plan *fplan3d, *bplan3d;
+static struct ath_3d_fft_r2c_plan *rplan3d;
 static ath_fft_data *work=NULL;
+static ath_fft_real *rwork=NULL;
 
 #ifdef STATIC_MESH_REFINEMENT
 #error self gravity with FFT not yet implemented to work with SMR
@@ -72,15 +73,15 @@ void selfg_fft_1d(DomainS *pD)
 
   pG->Phi[ks][js][is] = 0.0;
   for (i=is; i<=ie; i++) {
-    drho = (pG->U[ks][js][i].d - grav_mean_rho);
+    drho = (UVAR(pG->U,ks,js,i,d) - grav_mean_rho);
     pG->Phi[ks][js][is] += ((float)(i-is+1))*four_pi_G*dx_sq*drho;
   }
   pG->Phi[ks][js][is] /= (float)(pG->Nx[0]);
 
-  drho = (pG->U[ks][js][is].d - grav_mean_rho);
+  drho = (UVAR(pG->U,ks,js,is,d) - grav_mean_rho);
   pG->Phi[ks][js][is+1] = 2.0*pG->Phi[ks][js][is] + four_pi_G*dx_sq*drho;
   for (i=is+2; i<=ie; i++) {
-    drho = (pG->U[ks][js][i-1].d - grav_mean_rho);
+    drho = (UVAR(pG->U,ks,js,i-1,d) - grav_mean_rho);
     pG->Phi[ks][js][i] = four_pi_G*dx_sq*drho 
       + 2.0*pG->Phi[ks][js][i-1] - pG->Phi[ks][js][i-2];
   }
@@ -145,7 +146,7 @@ void selfg_fft_2d_xy(DomainS *pD)
     for (i=is-nghost; i<=ie+nghost; i++){
       pG->Phi_old[ks][j][i] = pG->Phi[ks][j][i];
 #ifdef SHEARING_BOX
-      RollDen[ks][i][j] = pG->U[ks][j][i].d;
+      RollDen[ks][i][j] = UVAR(pG->U,ks,j,i,d);
 #endif
     }
   }
@@ -163,7 +164,7 @@ void selfg_fft_2d_xy(DomainS *pD)
 #ifdef SHEARING_BOX
         four_pi_G*(RollDen[ks][i][j] - grav_mean_rho);
 #else
-        four_pi_G*(pG->U[ks][j][i].d - grav_mean_rho);
+        four_pi_G*(UVAR(pG->U,ks,j,i,d) - grav_mean_rho);
 #endif
       work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][1] = 0.0;
     }
@@ -291,7 +292,7 @@ void selfg_fft_2d(DomainS *pD)
   for (j=js; j<=je; j++){
     for (i=is; i<=ie; i++){
       work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0] =
-        four_pi_G*(pG->U[ks][j][i].d - grav_mean_rho);
+        four_pi_G*(UVAR(pG->U,ks,j,i,d) - grav_mean_rho);
       work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][1] = 0.0;
     }
   }
@@ -362,7 +363,7 @@ void selfg_fft_3d(DomainS *pD)
   int j, js = pG->js, je = pG->je;
   int k, ks = pG->ks, ke = pG->ke;
   Real dx1sq=(pG->dx1*pG->dx1),dx2sq=(pG->dx2*pG->dx2),dx3sq=(pG->dx3*pG->dx3);
-  Real dkx,dky,dkz,pcoeff;
+  Real dkx,dky,dkz,kx2,ky2,pcoeff;
 
 #ifdef SHEARING_BOX
   Real qomt,Lx,Ly,dt;
@@ -398,7 +399,7 @@ void selfg_fft_3d(DomainS *pD)
     for (i=is-nghost; i<=ie+nghost; i++){
       pG->Phi_old[k][j][i] = pG->Phi[k][j][i];
 #ifdef SHEARING_BOX
-      RollDen[k][i][j] = pG->U[k][j][i].d;
+      RollDen[k][i][j] = UVAR(pG->U,k,j,i,d);
 #endif
     }
   }}
@@ -413,125 +414,75 @@ void selfg_fft_3d(DomainS *pD)
   for (k=ks; k<=ke; k++){
   for (j=js; j<=je; j++){
     for (i=is; i<=ie; i++){
-      work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = 
+      rwork[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])] = 
 #ifdef SHEARING_BOX
         RollDen[k][i][j] - grav_mean_rho;
 #else
-        pG->U[k][j][i].d - grav_mean_rho;
+        UVAR(pG->U,k,j,i,d) - grav_mean_rho;
 #endif
-      work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] = 0.0;
     }
   }}
 
 #ifndef SHEARING_BOX 
 #ifdef STAR_PARTICLE
-   assign_starparticles_3d(pD,work); 
+   assign_starparticles_3d(pD,rwork); 
 #endif /* STAR_PARTICLE */
 #endif /* SHEARING_BOX  */
 
-    
-   ath_3d_fft(fplan3d, work);
+/* The density is real, so use a real-to-complex FFT which only stores and
+ * transforms the non-negative wavenumbers in x3 */
+
+  ath_3d_fft_r2c(rplan3d, rwork, work);
      
-/* Compute potential in Fourier space.  Multiple loops are used to avoid divide
- * by zero at i=is,j=js,k=ks, and to avoid if statement in loop   */
-/* To compute kx,ky,kz, note that indices relative to whole Domain are needed */
+/* Compute potential in Fourier space.  The plan gives the range of global
+ * wavenumber indices held by this processor (see F3DK in fftsrc/prototypes.h),
+ * which in general differs from the range of cells in the Grid.  The kx=ky=kz=0
+ * mode (the mean density) is set to zero. */
 
   dkx = 2.0*PI/(double)(pD->Nx[0]);
   dky = 2.0*PI/(double)(pD->Nx[1]);
   dkz = 2.0*PI/(double)(pD->Nx[2]);
 
+  for (i=rplan3d->kis; i<=rplan3d->kie; i++){
 #ifdef SHEARING_BOX
-  ip=KCOMP(0,pG->Disp[0],pD->Nx[0]);
-  jp=KCOMP(0,pG->Disp[1],pD->Nx[1]);
-  kxtdx  = (ip+qomt*Lx/Ly*jp)*dkx;
-#endif
-
-  if ((pG->Disp[2])==0 && (pG->Disp[1])==0 && (pG->Disp[0])==0) {
-    work[F3DI(0,0,0,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = 0.0;
-    work[F3DI(0,0,0,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] = 0.0;
-  } else {
-#ifdef SHEARING_BOX
-    pcoeff = 1.0/(((2.0*cos( kxtdx           )-2.0)/dx1sq) +
-                  ((2.0*cos((pG->Disp[1])*dky)-2.0)/dx2sq) +
-                  ((2.0*cos((pG->Disp[2])*dkz)-2.0)/dx3sq));
-#else
-    pcoeff = 1.0/(((2.0*cos((pG->Disp[0])*dkx)-2.0)/dx1sq) +
-                  ((2.0*cos((pG->Disp[1])*dky)-2.0)/dx2sq) +
-                  ((2.0*cos((pG->Disp[2])*dkz)-2.0)/dx3sq));
-#endif
-    work[F3DI(0,0,0,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] *= pcoeff;
-    work[F3DI(0,0,0,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] *= pcoeff;
-  }
-
-
-  for (k=ks+1; k<=ke; k++){
-#ifdef SHEARING_BOX
-    pcoeff = 1.0/(((2.0*cos( kxtdx                    )-2.0)/dx1sq) +
-                  ((2.0*cos((        pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                  ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
-#else
-    pcoeff = 1.0/(((2.0*cos((        pG->Disp[0] )*dkx)-2.0)/dx1sq) +
-                  ((2.0*cos((        pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                  ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
-#endif
-    work[F3DI(0,0,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] *= pcoeff;
-    work[F3DI(0,0,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] *= pcoeff;
-  }
-
-  for (j=js+1; j<=je; j++){
-    for (k=ks; k<=ke; k++){
-#ifdef SHEARING_BOX
-      jp=KCOMP(j-js ,pG->Disp[1],pD->Nx[1]);
-      kxtdx  = (ip+qomt*Lx/Ly*jp)*dkx;
-      pcoeff = 1.0/(((2.0*cos( kxtdx                    )-2.0)/dx1sq) +
-                    ((2.0*cos(( (j-js)+pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                    ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
+    ip=KCOMP(i,0,pD->Nx[0]);
 #else
-      pcoeff = 1.0/(((2.0*cos((        pG->Disp[0] )*dkx)-2.0)/dx1sq) +
-                    ((2.0*cos(( (j-js)+pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                    ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
+    kx2 = (2.0*cos(i*dkx)-2.0)/dx1sq;
 #endif
-      work[F3DI(0,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] *= pcoeff;
-      work[F3DI(0,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] *= pcoeff;
-    }
-  }
-
-  for (i=is+1; i<=ie; i++){
-  for (j=js; j<=je; j++){
-    for (k=ks; k<=ke; k++){
+  for (j=rplan3d->kjs; j<=rplan3d->kje; j++){
 #ifdef SHEARING_BOX
-      ip=KCOMP(i-is ,pG->Disp[0],pD->Nx[0]);
-      jp=KCOMP(j-js ,pG->Disp[1],pD->Nx[1]);
-      kxtdx  = (ip+qomt*Lx/Ly*jp)*dkx;
-      pcoeff = 1.0/(((2.0*cos( kxtdx                    )-2.0)/dx1sq) +
-                    ((2.0*cos(( (j-js)+pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                    ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
-#else
-      pcoeff = 1.0/(((2.0*cos(( (i-is)+pG->Disp[0] )*dkx)-2.0)/dx1sq) +
-                    ((2.0*cos(( (j-js)+pG->Disp[1] )*dky)-2.0)/dx2sq) +
-                    ((2.0*cos(( (k-ks)+pG->Disp[2] )*dkz)-2.0)/dx3sq));
+    jp=KCOMP(j,0,pD->Nx[1]);
+    kxtdx = (ip+qomt*Lx/Ly*jp)*dkx;
+    kx2 = (2.0*cos(kxtdx)-2.0)/dx1sq;
 #endif
-      work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] *= pcoeff;
-      work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][1] *= pcoeff;
+    ky2 = (2.0*cos(j*dky)-2.0)/dx2sq;
+    for (k=rplan3d->kks; k<=rplan3d->kke; k++){
+      if (i==0 && j==0 && k==0) {
+        pcoeff = 0.0;
+      } else {
+        pcoeff = 1.0/(kx2 + ky2 + (2.0*cos(k*dkz)-2.0)/dx3sq);
+      }
+      work[F3DK(i,j,k,rplan3d)][0] *= pcoeff;
+      work[F3DK(i,j,k,rplan3d)][1] *= pcoeff;
     }
   }}
 
 /* Backward FFT and set potential in real space.  Normalization of Phi is over
  * total number of cells in Domain */
 
-  ath_3d_fft(bplan3d, work);
+  ath_3d_fft_c2r(rplan3d, work, rwork);
 
   for (k=ks; k<=ke; k++){
   for (j=js; j<=je; j++){
     for (i=is; i<=ie; i++){
 #ifdef SHEARING_BOX
       UnRollPhi[k][i][j] = 
-       four_pi_G*work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0]
-        / bplan3d->gcnt;
+       four_pi_G*rwork[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])]
+        / rplan3d->gcnt;
 #else
       pG->Phi[k][j][i] =
-       four_pi_G*work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0]
-        / bplan3d->gcnt;
+       four_pi_G*rwork[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])]
+        / rplan3d->gcnt;
 #endif
     }
   }}
@@ -590,9 +541,9 @@ void selfg_fft_3d_init(MeshS *pM)
     for (nd=0; nd<(pM->DomainsPerLevel[nl]); nd++){
       if (pM->Domain[nl][nd].Grid != NULL){
         pD = (DomainS*)&(pM->Domain[nl][nd]);
-        fplan3d = ath_3d_fft_quick_plan(pD, NULL, ATH_FFT_FORWARD);
-        bplan3d = ath_3d_fft_quick_plan(pD, NULL, ATH_FFT_BACKWARD);
-        work = ath_3d_fft_malloc(fplan3d);
+        rplan3d = ath_3d_fft_r2c_quick_plan(pD);
+        rwork = ath_3d_fft_real_malloc(rplan3d);
+        work = ath_3d_fft_r2c_malloc(rplan3d);
       }
     }
   }
@@ -79,22 +79,22 @@ void selfg_fft_disk_1d(DomainS *pD)
 
   pG->Phi[ks][js][is] = 0.0;
   for (i=is; i<=ie; i++) {
-    pG->Phi[ks][js][is] += pG->U[ks][js][i].d; 
+    pG->Phi[ks][js][is] += UVAR(pG->U,ks,js,i,d); 
   }
 
   pG->Phi[ks][js][is  ] *= 0.25*four_pi_G*dx1sq*(float)((pG->Nx[0])-1);
   pG->Phi[ks][js][is+1] = pG->Phi[ks][js][is] + 
-           four_pi_G*dx1sq*pG->U[ks][js][is].d - 
+           four_pi_G*dx1sq*UVAR(pG->U,ks,js,is,d) - 
            2.*pG->Phi[ks][js][is]/(float)((pG->Nx[0])-1);
   for (i=is+2; i<=ie; i++) {
-    pG->Phi[ks][js][i] = four_pi_G*dx1sq*pG->U[ks][js][i-1].d 
+    pG->Phi[ks][js][i] = four_pi_G*dx1sq*UVAR(pG->U,ks,js,i-1,d) 
       + 2.0*pG->Phi[ks][js][i-1] - pG->Phi[ks][js][i-2];
   }
 /* apply open BC in x1 direction to obtain values in ghost zones */
       pG->Phi[ks][js][ie+1] = 2.0*pG->Phi[ks][js][ie] - pG->Phi[ks][js][ie-1] +
-	dx1sq*four_pi_G*pG->U[ks][js][ie].d;
+	dx1sq*four_pi_G*UVAR(pG->U,ks,js,ie,d);
       pG->Phi[ks][js][is-1] = 2.0*pG->Phi[ks][js][is] - pG->Phi[ks][js][is+1] +
-	dx1sq*four_pi_G*pG->U[ks][js][is].d;
+	dx1sq*four_pi_G*UVAR(pG->U,ks,js,is,d);
 }
 
 
@@ -172,14 +172,14 @@ void selfg_fft_disk_2d(DomainS *pD)
   for (j=js; j<=je; j++){
     for (i=is; i<=ie; i++){
       /* real part */
-      work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0] = four_pi_G*pG->U[ks][j][i].d;
+      work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0] = four_pi_G*UVAR(pG->U,ks,j,i,d);
       /* imaginary part */
       work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][1] = 0.0;
       /* real part */
-      work2[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0]= four_pi_G*pG->U[ks][j][i].d*
+      work2[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0]= four_pi_G*UVAR(pG->U,ks,j,i,d)*
           cos(0.5*((j-js)+pG->Disp[1])*dky) ;
       /* imaginary part */
-      work2[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][1]= four_pi_G*pG->U[ks][j][i].d*
+      work2[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][1]= four_pi_G*UVAR(pG->U,ks,j,i,d)*
          -sin(0.5*((j-js)+pG->Disp[1])*dky);
     }
   }
@@ -320,7 +320,7 @@ void selfg_fft_disk_3d(DomainS *pD)
       for (i=is-nghost; i<=ie+nghost; i++){
         pG->Phi_old[k][j][i] = pG->Phi[k][j][i];
 #ifdef SHEARING_BOX
-        RollDen[k][i][j] = pG->U[k][j][i].d;
+        RollDen[k][i][j] = UVAR(pG->U,k,j,i,d);
 /* should add star particle density to RollDen using assign_starparticles_3d(pD,work), where work is the 1D
 version of grid.  Note that assign_starparticles_3d only fills active zones.  Does RemapVar really need
 the ghost zones? */
@@ -342,7 +342,7 @@ the ghost zones? */
 #ifdef SHEARING_BOX
         den=RollDen[k][i][j];
 #else
-        den=pG->U[k][j][i].d;
+        den=UVAR(pG->U,k,j,i,d);
 #endif
         work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = den;
       }
@@ -378,7 +378,7 @@ the ghost zones? */
 #ifdef SHEARING_BOX
         den=RollDen[k][i][j]-grav_mean_rho;
 #else
-        den=pG->U[k][j][i].d-grav_mean_rho;
+        den=UVAR(pG->U,k,j,i,d)-grav_mean_rho;
 #endif
         work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = 
           four_pi_G*den;
@@ -95,7 +95,7 @@ void selfg_fft_obc_2d(DomainS *pD)
       /* Add gas density into work array 0. */
       for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
-          work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0] = pG->U[ks][j][i].d;
+          work[F2DI(i-is,j-js,pG->Nx[0],pG->Nx[1])][0] = UVAR(pG->U,ks,j,i,d);
         }
       }
 
@@ -227,7 +227,7 @@ void selfg_fft_obc_3d(DomainS *pD)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = pG->U[k][j][i].d;
+            work[F3DI(i-is,j-js,k-ks,pG->Nx[0],pG->Nx[1],pG->Nx[2])][0] = UVAR(pG->U,k,j,i,d);
           }
         }
       }
@@ -7,6 +7,27 @@
  *   These functions work for non-periodic domains.  A low-order multipole
  *   expansion is used to compute the potential on the boundaries.
  *
+ *   The solver uses the correction scheme with red-black Gauss-Seidel
+ *   smoothing, cell-averaged restriction of the residual, and trilinear
+ *   prolongation of the correction.  A full multigrid (FMG) cycle is used on
+ *   a cold start; afterwards the potential from the previous step (Phi_old)
+ *   is used as the initial guess.  V- or W-cycles are then done until the
+ *   residual has been reduced by the requested factor.  Parameters are read
+ *   from the <multigrid> block of the input file:
+ *   - cycle      = V or W (default V)
+ *   - nu1, nu2   = number of pre- and post-smoothing sweeps (default 2, 2)
+ *   - ncoarse    = number of sweeps on the coarsest level (default 10)
+ *   - tol        = required reduction of L2 norm of residual (default 1e-6)
+ *   - max_cycles = maximum number of cycles per solve (default 10)
+ *   - warm_start = 0 to always do a cold start (default 1)
+ *
+ *   With MPI, each Grid is restricted/prolongated independently, and single
+ *   ghost zone of iterates are swapped with neighboring Grids after every
+ *   half-sweep of the smoother.  Once the Grids on any processor cannot be
+ *   coarsened any further, the level is gathered onto the root of
+ *   Comm_Domain, the rest of the V-cycle is done there in serial, and the
+ *   result is scattered back.
+ *
  * HISTORY:
  * - june-2007 - 2D and 3D solvers written by Irene Balmes
  * - july-2007 - routines incorporated into Athena by JMS and IB
@@ -19,6 +40,8 @@
 
 #include <math.h>
 #include <float.h>
+#include <stdlib.h>
+#include <string.h>
 #include "../defs.h"
 #include "../athena.h"
 #include "../globals.h"
@@ -31,14 +54,6 @@
 #error self gravity with multigrid not yet implemented to work with SMR
 #endif
 
-#ifdef MPI_PARALLEL
-#error self gravity with multigrid not yet implemented to work with MPI
-#endif
-
-#ifdef MPI_PARALLEL
-static double *send_buf=NULL, *recv_buf=NULL;
-#endif
-
 /*! \struct MGrid
  *  \brief Holds RHS, potential, and information about grid
  * size for a given level in the multi-grid hierarchy  */
@@ -52,29 +67,65 @@ typedef struct MGrid_s{
   int rx1_id, lx1_id;
   int rx2_id, lx2_id;
   int rx3_id, lx3_id;
+  int Disp1,Disp2,Disp3; /* offset of Grid in Domain, at this level */
+  int level;           /* level in hierarchy (0 = finest) */
+#ifdef MPI_PARALLEL
+  int dist;            /* 1 if this level is decomposed over Comm_Domain */
+#endif
 }MGrid;
 
 /* 3D temporary array needed for restriction of errors  */
 Real ***error;
 
+/* Parameters of the solver, set from <multigrid> block in input file */
+static int mg_gamma = 1;                 /* 1 for V-cycles, 2 for W-cycles */
+static int mg_nu1 = 2, mg_nu2 = 2;       /* pre- and post-smoothing sweeps */
+static int mg_ncoarse = 10;              /* sweeps on coarsest level */
+static int mg_max_cycles = 10;
+static int mg_warm_start = 1, mg_first_solve = 1;
+static Real mg_tol = 1.0e-6;
+
+#ifdef MPI_PARALLEL
+/* MPI send and receive buffers for swapping iterates */
+static double **send_buf = NULL, **recv_buf = NULL;
+static MPI_Request *recv_rq, *send_rq;
+static MPI_Comm Comm_MG;      /* Comm_Domain of Domain being solved */
+static int myID_MG, nproc_MG; /* rank in, and size of, Comm_MG */
+
+/* Data needed to agglomerate the coarse levels onto the root of Comm_MG.
+ * nlev_dist is the level at which the Grids are gathered, agg_Nx/agg_Disp
+ * are the size and offset of each Grid at that level (indexed by rank). */
+static int nlev_dist;
+static int (*agg_Nx)[3] = NULL, (*agg_Disp)[3] = NULL;
+static int *agg_gcnt = NULL, *agg_gdsp = NULL;   /* counts/displ for Gatherv */
+static int *agg_scnt = NULL, *agg_sdsp = NULL;   /* counts/displ for Scatterv*/
+static double *agg_sbuf = NULL, *agg_rbuf = NULL;
+#endif /* MPI_PARALLEL */
+
 /*==============================================================================
  * PRIVATE FUNCTION PROTOTYPES:
  *   multig_3d() -
  *============================================================================*/
 
 void multig_3d(MGrid *pMG);
-void Jacobi(MGrid *pMG);
+void fmg_3d(MGrid *pMG);
+int coarsen_ok(MGrid *pMG);
+void RBGS_3d(MGrid *pMG, int nsweep);
+void mg_norms(MGrid *pMG, Real *rnorm, Real *bnorm);
 void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse);
 void Prolongation_3d(MGrid *pMG_coarse, MGrid *pMG_fine);
 
-#ifdef MPI_PARALLEL
 void set_mg_bvals(MGrid *pMG);
-void swap_mg_ix1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
-void swap_mg_ox1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
-void swap_mg_ix2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
-void swap_mg_ox2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
-void swap_mg_ix3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
-void swap_mg_ox3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq);
+void set_mg_phys_bvals(MGrid *pMG, int dir);
+
+#ifdef MPI_PARALLEL
+void swap_mg_ix1(MGrid *pMG, int swap_flag);
+void swap_mg_ox1(MGrid *pMG, int swap_flag);
+void swap_mg_ix2(MGrid *pMG, int swap_flag);
+void swap_mg_ox2(MGrid *pMG, int swap_flag);
+void swap_mg_ix3(MGrid *pMG, int swap_flag);
+void swap_mg_ox3(MGrid *pMG, int swap_flag);
+static void agglomerate_mg(MGrid *pMG, void (*mg_solve)(MGrid *pMG));
 #endif
 
 
@@ -113,12 +164,12 @@ void selfg_multig_3d(DomainS *pD)
   int i, is = pG->is, ie = pG->ie;
   int j, js = pG->js, je = pG->je;
   int k, ks = pG->ks, ke = pG->ke;
-  int Nx1z, Nx2z, Nx3z;
+  int Nx1z, Nx2z, Nx3z, cold, ncycle;
   MGrid Root_grid;
-  Real mass = 0.0, tmass, dVol, rad, x1, x2, x3;
+  Real mass = 0.0, tmass, dVol, rad, x1, x2, x3, rnorm, bnorm;
   Real Grav_const = four_pi_G/(4.0*PI);
 #ifdef MPI_PARALLEL
-  Real mpi_err;
+  int mpi_err;
 #endif
 
 /* Copy current potential into old */
@@ -137,13 +188,13 @@ void selfg_multig_3d(DomainS *pD)
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=ie; i++){
-        mass += pG->U[k][j][i].d*dVol;
+        mass += UVAR(pG->U,k,j,i,d)*dVol;
       }
     }
   }
 
 #ifdef MPI_PARALLEL
-  mpi_err = MPI_Allreduce(&mass, &tmass,1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+  mpi_err = MPI_Allreduce(&mass, &tmass,1,MPI_DOUBLE,MPI_SUM,pD->Comm_Domain);
   if (mpi_err) ath_error("[selfg_multigrid]: MPI_Reduce returned err = %d\n",
     mpi_err);
 #else
@@ -242,6 +293,13 @@ void selfg_multig_3d(DomainS *pD)
   Root_grid.rx1_id = pG->rx1_id; Root_grid.lx1_id = pG->lx1_id;
   Root_grid.rx2_id = pG->rx2_id; Root_grid.lx2_id = pG->lx2_id;
   Root_grid.rx3_id = pG->rx3_id; Root_grid.lx3_id = pG->lx3_id;
+  Root_grid.Disp1 = pG->Disp[0] - pD->Disp[0];
+  Root_grid.Disp2 = pG->Disp[1] - pD->Disp[1];
+  Root_grid.Disp3 = pG->Disp[2] - pD->Disp[2];
+  Root_grid.level = 0;
+#ifdef MPI_PARALLEL
+  Root_grid.dist = 1;
+#endif
 
 /* There is only one ghost zone needed at each level, not nghost */
   Nx1z = pG->Nx[0] + 2;
@@ -256,22 +314,45 @@ void selfg_multig_3d(DomainS *pD)
     ath_error("[selfg_by_multig_3d]: Error allocating memory\n");
   }
 
-/* Initialize solution on root grid, including single ghost zone */
+/* Initialize solution on root grid, including single ghost zone.  Ghost zones
+ * hold the boundary values computed above (or the neighbors' values).  Unless
+ * this is a cold start, the interior is warm-started from Phi_old.  */
+  cold = (mg_first_solve || !mg_warm_start);
   for (k=ks-1; k<=ke+1; k++){
     for (j=js-1; j<=je+1; j++){
       for (i=is-1; i<=ie+1; i++){
-        Root_grid.rhs[k-ks+1][j-js+1][i-is+1] = four_pi_G*pG->U[k][j][i].d;
-        Root_grid.Phi[k-ks+1][j-js+1][i-is+1] = pG->Phi[k][j][i];
+        Root_grid.rhs[k-ks+1][j-js+1][i-is+1] = four_pi_G*UVAR(pG->U,k,j,i,d);
+        if (k<ks || k>ke || j<js || j>je || i<is || i>ie)
+          Root_grid.Phi[k-ks+1][j-js+1][i-is+1] = pG->Phi[k][j][i];
+        else if (cold)
+          Root_grid.Phi[k-ks+1][j-js+1][i-is+1] = 0.0;
+        else
+          Root_grid.Phi[k-ks+1][j-js+1][i-is+1] = pG->Phi_old[k][j][i];
       }
     }
   }
-#ifdef MPI_PARALLEL
   set_mg_bvals(&Root_grid);
-#endif
 
-/* Compute new potential.  Note multig_3d calls itself recursively. */
+/* Compute new potential.  From a cold start, begin with a full multigrid
+ * cycle.  Then do V- or W-cycles until the residual is reduced below mg_tol
+ * (relative to the RHS), or mg_max_cycles is reached.  Note fmg_3d and
+ * multig_3d call themselves recursively. */
 
-  multig_3d(&Root_grid);
+  ncycle = 0;
+  if (cold) {
+    fmg_3d(&Root_grid);
+    ncycle++;
+  }
+  mg_norms(&Root_grid, &rnorm, &bnorm);
+  while (rnorm > mg_tol*bnorm && ncycle < mg_max_cycles) {
+    multig_3d(&Root_grid);
+    ncycle++;
+    mg_norms(&Root_grid, &rnorm, &bnorm);
+  }
+  mg_first_solve = 0;
+
+  ath_pout(1,"[selfg_multig_3d]: %d cycles, |res|/|rhs| = %e\n",ncycle,
+    (bnorm > 0.0 ? rnorm/bnorm : 0.0));
 
 /* copy solution for potential from MGrid into Grid structure.  Boundary
  * conditions for nghost ghost cells are set by set_bvals() call in main() */
@@ -292,158 +373,204 @@ void selfg_multig_3d(DomainS *pD)
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void multig_3d(MGrid *pMG)
- *  \brief Functions needed for the multigrid solver in 3D
+ *  \brief One V-cycle (mg_gamma=1) or W-cycle (mg_gamma=2) in 3D.
+ *
+ *   Smooths the current iterate, solves for the correction on the next coarser
+ *   level (by calling itself recursively mg_gamma times), adds the
+ *   prolongated correction, and smooths again.
  */
 
 void multig_3d(MGrid *pMG)
 {
-  int i, is = pMG->is, ie = pMG->ie;
-  int j, js = pMG->js, je = pMG->je;
-  int k, ks = pMG->ks, ke = pMG->ke;
-  int Nx1z, Nx2z, Nx3z;
   MGrid Coarse_grid;
+  int n;
 
-/* If we are down to 4 cells in any dimension do 10 iterations and return */
-
-  if (pMG->Nx1==4 || pMG->Nx2==4 || pMG->Nx3==4)
-    Jacobi(pMG);
-
-/* Else, do 10 iterations at this level, restrict to a coarser grid, and call
- * multig_3d again with this coarse grid */
-
-  else { 
-    Jacobi(pMG);
-
-/* Allocate and initialize MGrid at next coarsest level */
-
-    Coarse_grid.Nx1 = pMG->Nx1/2;
-    Coarse_grid.Nx2 = pMG->Nx2/2;
-    Coarse_grid.Nx3 = pMG->Nx3/2;
-    Coarse_grid.is = 1;  Coarse_grid.ie = Coarse_grid.Nx1;
-    Coarse_grid.js = 1;  Coarse_grid.je = Coarse_grid.Nx2;
-    Coarse_grid.ks = 1;  Coarse_grid.ke = Coarse_grid.Nx3;
-    Coarse_grid.dx1 = 2.0*pMG->dx1;
-    Coarse_grid.dx2 = 2.0*pMG->dx2;
-    Coarse_grid.dx3 = 2.0*pMG->dx3;
-    Coarse_grid.rx1_id = pMG->rx1_id; Coarse_grid.lx1_id = pMG->lx1_id;
-    Coarse_grid.rx2_id = pMG->rx2_id; Coarse_grid.lx2_id = pMG->lx2_id;
-    Coarse_grid.rx3_id = pMG->rx3_id; Coarse_grid.lx3_id = pMG->lx3_id;
-
-/* Again, only one ghost zone on each level */
-    Nx1z = (pMG->Nx1)/2 + 2;
-    Nx2z = (pMG->Nx2)/2 + 2;
-    Nx3z = (pMG->Nx3)/2 + 2;
-    Coarse_grid.rhs = (Real ***) calloc_3d_array(Nx3z,Nx2z,Nx1z,sizeof(Real));
-    Coarse_grid.Phi = (Real ***) calloc_3d_array(Nx3z,Nx2z,Nx1z,sizeof(Real));
-    if (Coarse_grid.rhs == NULL) {
-      ath_error("[multig_3d]: Error allocating memory for some level\n");
-    }
-    if (Coarse_grid.Phi == NULL) {
-      ath_error("[multig_3d]: Error allocating memory for some level\n");
-    }
-
-    Restriction_3d(pMG, &Coarse_grid);
 #ifdef MPI_PARALLEL
-    set_mg_bvals(&Coarse_grid);
+/* If the Grids on some processor cannot be coarsened any further, gather this
+ * level onto the root processor and complete the cycle there */
+
+  if (pMG->dist == 1 && pMG->level == nlev_dist && nproc_MG > 1) {
+    agglomerate_mg(pMG, multig_3d);
+    return;
+  }
 #endif
 
-    multig_3d(&Coarse_grid);
+/* At the coarsest level, just do mg_ncoarse sweeps of the smoother */
+
+  if (coarsen_ok(pMG) == 0) {
+    RBGS_3d(pMG, mg_ncoarse);
+    return;
+  }
+
+  RBGS_3d(pMG, mg_nu1);
 
-/* The following code is first reached after 10 iterations at the coarsest
- * level.  We then prolongate, do 10 iterations, and return.  This will return
- * execution to this same spot for the next coarsest level, so we will
- * prolongate, do 10 iterations, return, and so on.
+  Restriction_3d(pMG, &Coarse_grid);
+  for (n=0; n<mg_gamma; n++) multig_3d(&Coarse_grid);
+  Prolongation_3d(&Coarse_grid, pMG);
+  free_3d_array(Coarse_grid.rhs);
+  free_3d_array(Coarse_grid.Phi);
+  set_mg_bvals(pMG);
+
+  RBGS_3d(pMG, mg_nu2);
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void fmg_3d(MGrid *pMG)
+ *  \brief Full multigrid cycle in 3D.
+ *
+ *   The correction is first found on the next coarser level by a full
+ *   multigrid cycle, prolongated as the initial guess at this level, and
+ *   then improved by a single V- or W-cycle.
  */
 
-    Prolongation_3d(&Coarse_grid, pMG);
-    free_3d_array(Coarse_grid.rhs);
-    free_3d_array(Coarse_grid.Phi);
+void fmg_3d(MGrid *pMG)
+{
+  MGrid Coarse_grid;
+
 #ifdef MPI_PARALLEL
-    set_mg_bvals(pMG);
+  if (pMG->dist == 1 && pMG->level == nlev_dist && nproc_MG > 1) {
+    agglomerate_mg(pMG, fmg_3d);
+    return;
+  }
 #endif
 
-/* End with 10 iterations at the finest level */
-
-    Jacobi(pMG);
+  if (coarsen_ok(pMG) == 0) {
+    RBGS_3d(pMG, mg_ncoarse);
+    return;
   }
 
+  Restriction_3d(pMG, &Coarse_grid);
+  fmg_3d(&Coarse_grid);
+  Prolongation_3d(&Coarse_grid, pMG);
+  free_3d_array(Coarse_grid.rhs);
+  free_3d_array(Coarse_grid.Phi);
+  set_mg_bvals(pMG);
+
+  multig_3d(pMG);
+
   return;
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void Jacobi(MGrid *pMG)
- *  \brief Jacobi iterations. 
+/*! \fn int coarsen_ok(MGrid *pMG)
+ *  \brief Returns 1 if the MGrid can be restricted to a coarser level.
  *
- *   Do not use with periodic BCs, uses multipole expansion
- *   to compute potential at boundary
+ *   We stop at 4 cells (or an odd number of cells) in any dimension.  Levels
+ *   above nlev_dist are decomposed over processors, and were already checked
+ *   to be coarsenable using the global sizes.
+ */
+
+int coarsen_ok(MGrid *pMG)
+{
+#ifdef MPI_PARALLEL
+  if (pMG->dist == 1 && pMG->level < nlev_dist) return 1;
+#endif
+  if (pMG->Nx1<=4 || pMG->Nx2<=4 || pMG->Nx3<=4 ||
+      (pMG->Nx1 % 2) != 0 || (pMG->Nx2 % 2) != 0 || (pMG->Nx3 % 2) != 0)
+    return 0;
+
+  return 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void RBGS_3d(MGrid *pMG, int nsweep)
+ *  \brief Red-black Gauss-Seidel iterations in 3D.
+ *
+ *   Colors are based on the global cell index, so that the iterates are
+ *   independent of the domain decomposition.  With MPI, ghost zones are
+ *   swapped after every half-sweep.
  */
-void Jacobi(MGrid *pMG)
+
+void RBGS_3d(MGrid *pMG, int nsweep)
 {
   int i, is = pMG->is, ie = pMG->ie;
   int j, js = pMG->js, je = pMG->je;
   int k, ks = pMG->ks, ke = pMG->ke;
-  int n;
+  int n, color, off = pMG->Disp1 + pMG->Disp2 + pMG->Disp3;
   Real dx1sq = (pMG->dx1*pMG->dx1);
   Real dx2sq = (pMG->dx2*pMG->dx2);
   Real dx3sq = (pMG->dx3*pMG->dx3);
+  Real idiag = 1.0/(2.0/dx1sq + 2.0/dx2sq + 2.0/dx3sq);
 
-/* Jacobi iterations in 3D */
-
-  if (pMG->Nx3 > 1) {
-    for (n=0; n<=10; n++){  /* hardwired to do 10 iterations */
+  for (n=0; n<nsweep; n++){
+    for (color=0; color<2; color++){
       for (k=ks; k<=ke; k++){
         for (j=js; j<=je; j++){
-          for (i=is; i<=ie; i++){
-            error[k][j][i] = -pMG->rhs[k][j][i];
-            error[k][j][i] += (pMG->Phi[k][j][i+1] + pMG->Phi[k][j][i-1])/dx1sq;
-            error[k][j][i] += (pMG->Phi[k][j+1][i] + pMG->Phi[k][j-1][i])/dx2sq;
-            error[k][j][i] += (pMG->Phi[k+1][j][i] + pMG->Phi[k-1][j][i])/dx3sq;
+          for (i=is+((color+is+j+k+off) & 1); i<=ie; i+=2){
+            pMG->Phi[k][j][i] = idiag*(
+                (pMG->Phi[k][j][i+1] + pMG->Phi[k][j][i-1])/dx1sq
+              + (pMG->Phi[k][j+1][i] + pMG->Phi[k][j-1][i])/dx2sq
+              + (pMG->Phi[k+1][j][i] + pMG->Phi[k-1][j][i])/dx3sq
+              - pMG->rhs[k][j][i]);
           }
         }
       }
-
-      for (k=ks; k<=ke; k++){
-        for (j=js; j<=je; j++){
-          for (i=is; i<=ie; i++){
-            pMG->Phi[k][j][i] = error[k][j][i]/(2.0/dx1sq + 2.0/dx2sq + 2.0/dx3sq);
-          }
-        }
-      }
-#ifdef MPI_PARALLEL
       set_mg_bvals(pMG);
-#endif
     }
   }
 
-/* Jacobi iterations in 2D (x-y plane) */
+  return;
+}
 
-  if (pMG->Nx3 == 1) {
-    for (n=0; n<=10; n++){  /* hardwired to do 10 iterations */
-      for (j=js; j<=je; j++){
-        for (i=is; i<=ie; i++){
-          error[ks][j][i] = -pMG->rhs[ks][j][i];
-          error[ks][j][i] += (pMG->Phi[ks][j][i+1] + pMG->Phi[ks][j][i-1])/dx1sq;
-          error[ks][j][i] += (pMG->Phi[ks][j+1][i] + pMG->Phi[ks][j-1][i])/dx2sq;
-        }
-      }
+/*----------------------------------------------------------------------------*/
+/*! \fn void mg_norms(MGrid *pMG, Real *rnorm, Real *bnorm)
+ *  \brief Computes the L2 norms of the residual and of the RHS over the Domain
+ */
 
-      for (j=js; j<=je; j++){
-        for (i=is; i<=ie; i++){
-          pMG->Phi[ks][j][i] = error[ks][j][i]/(2.0/dx1sq + 2.0/dx2sq);
-        }
-      }
+void mg_norms(MGrid *pMG, Real *rnorm, Real *bnorm)
+{
+  int i, is = pMG->is, ie = pMG->ie;
+  int j, js = pMG->js, je = pMG->je;
+  int k, ks = pMG->ks, ke = pMG->ke;
+  Real dx1sq = (pMG->dx1*pMG->dx1);
+  Real dx2sq = (pMG->dx2*pMG->dx2);
+  Real dx3sq = (pMG->dx3*pMG->dx3);
+  Real res;
+  double sum[2];
 #ifdef MPI_PARALLEL
-      set_mg_bvals(pMG);
+  double gsum[2];
+  int ierr;
 #endif
+
+  sum[0] = 0.0;
+  sum[1] = 0.0;
+  for (k=ks; k<=ke; k++){
+    for (j=js; j<=je; j++){
+      for (i=is; i<=ie; i++){
+        res = pMG->rhs[k][j][i];
+        res -= (pMG->Phi[k][j][i+1] + pMG->Phi[k][j][i-1]
+          - 2.0*pMG->Phi[k][j][i]) / dx1sq;
+        res -= (pMG->Phi[k][j+1][i] + pMG->Phi[k][j-1][i]
+          - 2.0*pMG->Phi[k][j][i]) / dx2sq;
+        res -= (pMG->Phi[k+1][j][i] + pMG->Phi[k-1][j][i]
+          - 2.0*pMG->Phi[k][j][i]) / dx3sq;
+        sum[0] += res*res;
+        sum[1] += pMG->rhs[k][j][i]*pMG->rhs[k][j][i];
+      }
     }
   }
 
+#ifdef MPI_PARALLEL
+  ierr = MPI_Allreduce(sum, gsum, 2, MPI_DOUBLE, MPI_SUM, Comm_MG);
+  sum[0] = gsum[0];
+  sum[1] = gsum[1];
+#endif
+
+  *rnorm = sqrt(sum[0]);
+  *bnorm = sqrt(sum[1]);
+
   return;
 }
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse) 
- *  \brief Averages fine grid solution onto coarse
+ *  \brief Allocates the next coarser level, and averages the residual of the
+ *   fine grid onto it.
+ *
+ *   The coarse level solves for the correction, so its initial iterate and
+ *   (homogeneous) boundary values are zero.
  */
 
 void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse)
@@ -451,10 +578,48 @@ void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse)
   int i, is = pMG_fine->is, ie = pMG_fine->ie;
   int j, js = pMG_fine->js, je = pMG_fine->je;
   int k, ks = pMG_fine->ks, ke = pMG_fine->ke;
+  int Nx1z, Nx2z, Nx3z;
   Real dx1sq = (pMG_fine->dx1*pMG_fine->dx1);
   Real dx2sq = (pMG_fine->dx2*pMG_fine->dx2);
   Real dx3sq = (pMG_fine->dx3*pMG_fine->dx3);
 
+/* Initialize MGrid at next coarsest level */
+
+  pMG_coarse->Nx1 = pMG_fine->Nx1/2;
+  pMG_coarse->Nx2 = pMG_fine->Nx2/2;
+  pMG_coarse->Nx3 = pMG_fine->Nx3/2;
+  pMG_coarse->is = 1;  pMG_coarse->ie = pMG_coarse->Nx1;
+  pMG_coarse->js = 1;  pMG_coarse->je = pMG_coarse->Nx2;
+  pMG_coarse->ks = 1;  pMG_coarse->ke = pMG_coarse->Nx3;
+  pMG_coarse->Disp1 = pMG_fine->Disp1/2;
+  pMG_coarse->Disp2 = pMG_fine->Disp2/2;
+  pMG_coarse->Disp3 = pMG_fine->Disp3/2;
+  pMG_coarse->dx1 = 2.0*pMG_fine->dx1;
+  pMG_coarse->dx2 = 2.0*pMG_fine->dx2;
+  pMG_coarse->dx3 = 2.0*pMG_fine->dx3;
+  pMG_coarse->rx1_id = pMG_fine->rx1_id; pMG_coarse->lx1_id = pMG_fine->lx1_id;
+  pMG_coarse->rx2_id = pMG_fine->rx2_id; pMG_coarse->lx2_id = pMG_fine->lx2_id;
+  pMG_coarse->rx3_id = pMG_fine->rx3_id; pMG_coarse->lx3_id = pMG_fine->lx3_id;
+  pMG_coarse->level = pMG_fine->level + 1;
+#ifdef MPI_PARALLEL
+  pMG_coarse->dist = pMG_fine->dist;
+#endif
+
+/* Again, only one ghost zone on each level.  calloc sets the iterate to zero */
+  Nx1z = pMG_coarse->Nx1 + 2;
+  Nx2z = pMG_coarse->Nx2 + 2;
+  Nx3z = pMG_coarse->Nx3 + 2;
+  pMG_coarse->rhs = (Real ***) calloc_3d_array(Nx3z,Nx2z,Nx1z,sizeof(Real));
+  pMG_coarse->Phi = (Real ***) calloc_3d_array(Nx3z,Nx2z,Nx1z,sizeof(Real));
+  if (pMG_coarse->rhs == NULL) {
+    ath_error("[Restriction_3d]: Error allocating memory for some level\n");
+  }
+  if (pMG_coarse->Phi == NULL) {
+    ath_error("[Restriction_3d]: Error allocating memory for some level\n");
+  }
+
+/* Compute residual on fine grid */
+
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=ie; i++){
@@ -469,14 +634,11 @@ void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse)
     }
   }
 
+/* Average residual onto coarse grid */
+
   for(k=ks; k<=pMG_coarse->ke; k++){
     for (j=js; j<=pMG_coarse->je; j++){
       for (i=is; i<=pMG_coarse->ie; i++){
-        pMG_coarse->Phi[k][j][i] =
-          (pMG_fine->Phi[2*k  ][2*j  ][2*i] + pMG_fine->Phi[2*k  ][2*j  ][2*i-1]
-         + pMG_fine->Phi[2*k  ][2*j-1][2*i] + pMG_fine->Phi[2*k  ][2*j-1][2*i-1]
-         + pMG_fine->Phi[2*k-1][2*j  ][2*i] + pMG_fine->Phi[2*k-1][2*j  ][2*i-1]
-         + pMG_fine->Phi[2*k-1][2*j-1][2*i] + pMG_fine->Phi[2*k-1][2*j-1][2*i-1])/8.0 ;
         pMG_coarse->rhs[k][j][i] =
            (error[2*k  ][2*j  ][2*i] + error[2*k  ][2*j  ][2*i-1]
           + error[2*k  ][2*j-1][2*i] + error[2*k  ][2*j-1][2*i-1]
@@ -491,228 +653,344 @@ void Restriction_3d(MGrid *pMG_fine, MGrid *pMG_coarse)
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void Prolongation_3d(MGrid *pMG_coarse, MGrid *pMG_fine)
- *  \brief Linear interpolation of coarse grid onto fine  
+ *  \brief Trilinear interpolation of coarse grid correction, which is added
+ *   to the fine grid iterate.
+ *
+ *   Uses the ghost zones of the coarse grid (including edges and corners),
+ *   which are zero at the boundaries of the Domain.
  */
 void Prolongation_3d(MGrid *pMG_coarse, MGrid *pMG_fine)
 {
   int i, is = pMG_coarse->is, ie = pMG_coarse->ie;
   int j, js = pMG_coarse->js, je = pMG_coarse->je;
   int k, ks = pMG_coarse->ks, ke = pMG_coarse->ke;
+  int fi, fj, fk, di, dj, dk;
+  Real ***c = pMG_coarse->Phi;
 
   for (k=ks; k<=ke; k++){
   for (j=js; j<=je; j++){
-    for (i=is; i<=ie; i++){
-      pMG_fine->Phi[2*k  ][2*j  ][2*i  ] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k  ][2*j  ][2*i  ] += 0.25*pMG_coarse->Phi[k+1][j+1][i+1];
-
-      pMG_fine->Phi[2*k  ][2*j  ][2*i-1] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k  ][2*j  ][2*i-1] += 0.25*pMG_coarse->Phi[k+1][j+1][i-1];
-
-      pMG_fine->Phi[2*k  ][2*j-1][2*i  ] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k  ][2*j-1][2*i  ] += 0.25*pMG_coarse->Phi[k+1][j-1][i+1];
-
-      pMG_fine->Phi[2*k-1][2*j  ][2*i  ] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k-1][2*j  ][2*i  ] += 0.25*pMG_coarse->Phi[k-1][j+1][i+1];
-
-      pMG_fine->Phi[2*k  ][2*j-1][2*i-1] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k  ][2*j-1][2*i-1] += 0.25*pMG_coarse->Phi[k+1][j-1][i-1];
-
-      pMG_fine->Phi[2*k-1][2*j-1][2*i  ] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k-1][2*j-1][2*i  ] += 0.25*pMG_coarse->Phi[k-1][j-1][i+1];
-
-      pMG_fine->Phi[2*k-1][2*j]  [2*i-1] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k-1][2*j]  [2*i-1] += 0.25*pMG_coarse->Phi[k-1][j+1][i-1];
-
-      pMG_fine->Phi[2*k-1][2*j-1][2*i-1] += 0.75*pMG_coarse->Phi[k  ][j  ][i  ];
-      pMG_fine->Phi[2*k-1][2*j-1][2*i-1] += 0.25*pMG_coarse->Phi[k-1][j-1][i-1];
+  for (i=is; i<=ie; i++){
+    for (fk=0; fk<2; fk++){
+      dk = 2*fk - 1;
+      for (fj=0; fj<2; fj++){
+        dj = 2*fj - 1;
+        for (fi=0; fi<2; fi++){
+          di = 2*fi - 1;
+          pMG_fine->Phi[2*k-1+fk][2*j-1+fj][2*i-1+fi] += (27.0*c[k][j][i]
+            + 9.0*(c[k][j][i+di] + c[k][j+dj][i] + c[k+dk][j][i])
+            + 3.0*(c[k][j+dj][i+di] + c[k+dk][j][i+di] + c[k+dk][j+dj][i])
+            + c[k+dk][j+dj][i+di])/64.0;
+        }
+      }
     }
-  }}
+  }}}
 
   return;
 }
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void set_mg_bvals(MGrid *pMG)
- *  \brief Sets BC for Jacobi iterates for MPI parallel jobs.
+ *  \brief Sets BC for iterates.
  *
- *   With self-gravity using multigrid, the boundary conditions at the edge of
- *   the Domain are held fixed.  So only ghostzones associated with internal
- *   boundaries between MPI grids need to be passed.
+ *   On the finest level, the boundary conditions at the edge of the Domain are
+ *   held fixed, while on coarser levels they are set by set_mg_phys_bvals().
+ *   With MPI, ghostzones associated with internal boundaries between MPI
+ *   grids are passed.
  *
- * This routine is largely a copy of set_bvals().
+ * This routine is largely a copy of bvals_grav().
  * Order for updating boundary conditions must always be x1-x2-x3 in order to
  * fill the corner cells properly
  */
 
-#ifdef MPI_PARALLEL
 void set_mg_bvals(MGrid *pMG)
 {
-  int cnt3, cnt, err;
-  MPI_Status stat;
-  MPI_Request rq;
+#ifdef MPI_PARALLEL
+  int cnt3, cnt, ierr, mIndex;
+#endif
 
 /*--- Step 1. ------------------------------------------------------------------
  * Boundary Conditions in x1-direction */
 
+  set_mg_phys_bvals(pMG,1);
+
+#ifdef MPI_PARALLEL
+
   cnt3 = 1;
   if (pMG->Nx3 > 1) cnt3 = pMG->Nx3;
   cnt = pMG->Nx2*cnt3;
 
 /* MPI blocks to both left and right */
   if (pMG->rx1_id >= 0 && pMG->lx1_id >= 0) {
-    /* Post a non-blocking receive for the input data from the left grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx1_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
-
-    swap_mg_ox1(pMG,cnt,0,&rq);  /* send R */
-    swap_mg_ix1(pMG,cnt,1,&rq);  /* listen L */
-
-    /* Post a non-blocking receive for the input data from the right grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx1_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ix1(pMG,cnt,0,&rq);  /* send L */
-    swap_mg_ox1(pMG,cnt,1,&rq);  /* listen R */
+    /* Post non-blocking receives for data from L and R Grids */
+    ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx1_id,LtoR_tag,
+      Comm_MG, &(recv_rq[0]));
+    ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx1_id,RtoL_tag,
+      Comm_MG, &(recv_rq[1]));
+
+    /* pack and send data L and R */
+    swap_mg_ix1(pMG,0);
+    ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx1_id,RtoL_tag,
+      Comm_MG, &(send_rq[0]));
+
+    swap_mg_ox1(pMG,0);
+    ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx1_id,LtoR_tag,
+      Comm_MG, &(send_rq[1]));
+
+    /* check non-blocking sends have completed. */
+    ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
+
+    /* check non-blocking receives and unpack data in any order. */
+    ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+    if (mIndex == 0) swap_mg_ix1(pMG,1);
+    if (mIndex == 1) swap_mg_ox1(pMG,1);
+    ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+    if (mIndex == 0) swap_mg_ix1(pMG,1);
+    if (mIndex == 1) swap_mg_ox1(pMG,1);
   }
 
 /* Physical boundary on left, MPI block on right */
   if (pMG->rx1_id >= 0 && pMG->lx1_id < 0) {
-    /* Post a non-blocking receive for the input data from the right grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx1_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ox1(pMG,cnt,0,&rq);  /* send R */
-    swap_mg_ox1(pMG,cnt,1,&rq);  /* listen R */
+    ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx1_id,RtoL_tag,
+      Comm_MG, &(recv_rq[1]));
+
+    swap_mg_ox1(pMG,0);
+    ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx1_id,LtoR_tag,
+      Comm_MG, &(send_rq[1]));
+
+    ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+    ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+    swap_mg_ox1(pMG,1);
   }
 
 /* MPI block on left, Physical boundary on right */
   if (pMG->rx1_id < 0 && pMG->lx1_id >= 0) {
-    /* Post a non-blocking receive for the input data from the left grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx1_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ix1(pMG,cnt,0,&rq);  /* send L */
-    swap_mg_ix1(pMG,cnt,1,&rq);  /* listen L */
+    ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx1_id,LtoR_tag,
+      Comm_MG, &(recv_rq[0]));
+
+    swap_mg_ix1(pMG,0);
+    ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx1_id,RtoL_tag,
+      Comm_MG, &(send_rq[0]));
+
+    ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+    ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+    swap_mg_ix1(pMG,1);
   }
 
+#endif /* MPI_PARALLEL */
+
 /*--- Step 2. ------------------------------------------------------------------
  * Boundary Conditions in x2-direction */
 
+  set_mg_phys_bvals(pMG,2);
+
+#ifdef MPI_PARALLEL
+
   cnt3 = 1;
   if (pMG->Nx3 > 1) cnt3 = pMG->Nx3;
   cnt = (pMG->Nx1 + 2)*cnt3;
 
 /* MPI blocks to both left and right */
   if (pMG->rx2_id >= 0 && pMG->lx2_id >= 0) {
-    /* Post a non-blocking receive for the input data from the left grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx2_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ox2(pMG,cnt,0,&rq);  /* send R */
-    swap_mg_ix2(pMG,cnt,1,&rq);  /* listen L */
+    ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx2_id,LtoR_tag,
+      Comm_MG, &(recv_rq[0]));
+    ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx2_id,RtoL_tag,
+      Comm_MG, &(recv_rq[1]));
 
-    /* Post a non-blocking receive for the input data from the right grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx2_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
+    swap_mg_ix2(pMG,0);
+    ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx2_id,RtoL_tag,
+      Comm_MG, &(send_rq[0]));
 
-    swap_mg_ix2(pMG,cnt,0,&rq);  /* send L */
-    swap_mg_ox2(pMG,cnt,1,&rq);  /* listen R */
+    swap_mg_ox2(pMG,0);
+    ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx2_id,LtoR_tag,
+      Comm_MG, &(send_rq[1]));
+
+    ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
+
+    ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+    if (mIndex == 0) swap_mg_ix2(pMG,1);
+    if (mIndex == 1) swap_mg_ox2(pMG,1);
+    ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+    if (mIndex == 0) swap_mg_ix2(pMG,1);
+    if (mIndex == 1) swap_mg_ox2(pMG,1);
   }
 
 /* Physical boundary on left, MPI block on right */
   if (pMG->rx2_id >= 0 && pMG->lx2_id < 0) {
-    /* Post a non-blocking receive for the input data from the right grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx2_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ox2(pMG,cnt,0,&rq);  /* send R */
-    swap_mg_ox2(pMG,cnt,1,&rq);  /* listen R */
+    ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx2_id,RtoL_tag,
+      Comm_MG, &(recv_rq[1]));
+
+    swap_mg_ox2(pMG,0);
+    ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx2_id,LtoR_tag,
+      Comm_MG, &(send_rq[1]));
+
+    ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+    ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+    swap_mg_ox2(pMG,1);
   }
 
 /* MPI block on left, Physical boundary on right */
   if (pMG->rx2_id < 0 && pMG->lx2_id >= 0) {
-    /* Post a non-blocking receive for the input data from the left grid */
-    err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx2_id,
-      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-    if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-    swap_mg_ix2(pMG,cnt,0,&rq);  /* send L */
-    swap_mg_ix2(pMG,cnt,1,&rq);  /* listen L */
+    ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx2_id,LtoR_tag,
+      Comm_MG, &(recv_rq[0]));
+
+    swap_mg_ix2(pMG,0);
+    ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx2_id,RtoL_tag,
+      Comm_MG, &(send_rq[0]));
+
+    ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+    ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+    swap_mg_ix2(pMG,1);
   }
 
+#endif /* MPI_PARALLEL */
+
 /*--- Step 3. ------------------------------------------------------------------
  * Boundary Conditions in x3-direction */
 
+  set_mg_phys_bvals(pMG,3);
+
+#ifdef MPI_PARALLEL
   if (pMG->Nx3 > 1){
 
     cnt = (pMG->Nx1 + 2)*(pMG->Nx2 + 2);
 
 /* MPI blocks to both left and right */
     if (pMG->rx3_id >= 0 && pMG->lx3_id >= 0) {
-      /* Post a non-blocking receive for the input data from the left grid */
-      err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx3_id,
-		      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-      if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-      swap_mg_ox3(pMG,cnt,0,&rq);  /* send R */
-      swap_mg_ix3(pMG,cnt,1,&rq);  /* listen L */
+      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx3_id,LtoR_tag,
+        Comm_MG, &(recv_rq[0]));
+      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx3_id,RtoL_tag,
+        Comm_MG, &(recv_rq[1]));
+
+      swap_mg_ix3(pMG,0);
+      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx3_id,RtoL_tag,
+        Comm_MG, &(send_rq[0]));
+
+      swap_mg_ox3(pMG,0);
+      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx3_id,LtoR_tag,
+        Comm_MG, &(send_rq[1]));
 
-      /* Post a non-blocking receive for the input data from the right grid */
-      err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx3_id,
-		      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-      if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
+      ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
 
-      swap_mg_ix3(pMG,cnt,0,&rq);  /* send L */
-      swap_mg_ox3(pMG,cnt,1,&rq);  /* listen R */
+      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      if (mIndex == 0) swap_mg_ix3(pMG,1);
+      if (mIndex == 1) swap_mg_ox3(pMG,1);
+      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      if (mIndex == 0) swap_mg_ix3(pMG,1);
+      if (mIndex == 1) swap_mg_ox3(pMG,1);
     }
 
 /* Physical boundary on left, MPI block on right */
     if (pMG->rx3_id >= 0 && pMG->lx3_id < 0) {
-      /* Post a non-blocking receive for the input data from the right grid */
-      err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->rx3_id,
-		      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-      if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-      swap_mg_ox3(pMG,cnt,0,&rq);  /* send R */
-      swap_mg_ox3(pMG,cnt,1,&rq);  /* listen R */
+      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx3_id,RtoL_tag,
+        Comm_MG, &(recv_rq[1]));
+
+      swap_mg_ox3(pMG,0);
+      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pMG->rx3_id,LtoR_tag,
+        Comm_MG, &(send_rq[1]));
+
+      ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      swap_mg_ox3(pMG,1);
     }
 
 /* MPI block on left, Physical boundary on right */
     if (pMG->rx3_id < 0 && pMG->lx3_id >= 0) {
-      /* Post a non-blocking receive for the input data from the left grid */
-      err = MPI_Irecv(recv_buf, cnt, MPI_DOUBLE, pMG->lx3_id,
-		      boundary_cells_tag, MPI_COMM_WORLD, &rq);
-      if(err) ath_error("[set_mg_bvals]: MPI_Irecv error = %d\n",err);
 
-      swap_mg_ix3(pMG,cnt,0,&rq);  /* send L */
-      swap_mg_ix3(pMG,cnt,1,&rq);  /* listen L */
+      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx3_id,LtoR_tag,
+        Comm_MG, &(recv_rq[0]));
+
+      swap_mg_ix3(pMG,0);
+      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pMG->lx3_id,RtoL_tag,
+        Comm_MG, &(send_rq[0]));
+
+      ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      swap_mg_ix3(pMG,1);
     }
   }
 
+#endif /* MPI_PARALLEL */
+
   return;
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ix1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void set_mg_phys_bvals(MGrid *pMG, int dir)
+ *  \brief Sets BC at edges of the Domain in direction dir for the coarse
+ *   levels, on which the correction is computed.
+ *
+ *   The correction is zero at the centers of the ghost zones of the finest
+ *   level, which lie 2^-(L+1) of a cell of level L outside the boundary.
+ *   Linear extrapolation through this point gives a ghost value of
+ *   (1-2^L)/(1+2^L) times the adjacent active zone: -1/3 at level 1,
+ *   tending to -1 (zero on the boundary face) on the coarsest levels.
+ */
+
+void set_mg_phys_bvals(MGrid *pMG, int dir)
+{
+  int i, is = pMG->is, ie = pMG->ie;
+  int j, js = pMG->js, je = pMG->je;
+  int k, ks = pMG->ks, ke = pMG->ke;
+  Real ***Phi = pMG->Phi;
+  Real fac;
+
+  if (pMG->level == 0) return;
+  fac = (1.0 - (Real)(1 << pMG->level))/(1.0 + (Real)(1 << pMG->level));
+
+  if (dir == 1) {
+    for (k=ks; k<=ke; k++){
+      for (j=js; j<=je; j++){
+        if (pMG->lx1_id < 0) Phi[k][j][is-1] = fac*Phi[k][j][is];
+        if (pMG->rx1_id < 0) Phi[k][j][ie+1] = fac*Phi[k][j][ie];
+      }
+    }
+  }
+
+  if (dir == 2) {
+    for (k=ks; k<=ke; k++){
+      for (i=is-1; i<=ie+1; i++){
+        if (pMG->lx2_id < 0) Phi[k][js-1][i] = fac*Phi[k][js][i];
+        if (pMG->rx2_id < 0) Phi[k][je+1][i] = fac*Phi[k][je][i];
+      }
+    }
+  }
+
+  if (dir == 3) {
+    for (j=js-1; j<=je+1; j++){
+      for (i=is-1; i<=ie+1; i++){
+        if (pMG->lx3_id < 0) Phi[ks-1][j][i] = fac*Phi[ks][j][i];
+        if (pMG->rx3_id < 0) Phi[ke+1][j][i] = fac*Phi[ke][j][i];
+      }
+    }
+  }
+
+  return;
+}
+
+#ifdef MPI_PARALLEL
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void swap_mg_ix1(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Inner x1 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ix1 and set_bvals/receive_ix1
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ix1 and bvals_grav/unpack_Phi_ix1
  */
 
-void swap_mg_ix1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ix1(MGrid *pMG, int swap_flag)
 {
-  int j,jl,ju,k,kl,ku,err;
-  MPI_Status stat;
-  double *psb = send_buf;
-  double *prb = recv_buf;
+  int j,jl,ju,k,kl,ku;
+  double *psb = send_buf[0];
+  double *prb = recv_buf[0];
 
   jl = pMG->js;
   ju = pMG->je;
@@ -732,21 +1010,11 @@ void swap_mg_ix1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
         *(psb++) = pMG->Phi[k][j][pMG->is];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on L-x1 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->lx1_id,
-                   boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ix1]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row i=is-1 of iteratas into ghost zonee */
+/* Unpack single row i=is-1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the left grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ix1]: MPI_Wait error = %d\n",err);
-
     for (k=kl; k<=ku; k++){
       for (j=jl; j<=ju; j++){
         pMG->Phi[k][j][pMG->is-1] = *(prb++);
@@ -758,19 +1026,19 @@ void swap_mg_ix1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ox1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void swap_mg_ox1(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Outer x1 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ox1 and set_bvals/receive_ox1
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ox1 and bvals_grav/unpack_Phi_ox1
  */
 
-void swap_mg_ox1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ox1(MGrid *pMG, int swap_flag)
 {
-  int j,jl,ju,k,kl,ku,err;
-  MPI_Status stat;
-  double *psb = send_buf;
-  double *prb = recv_buf;
+  int j,jl,ju,k,kl,ku;
+  double *psb = send_buf[1];
+  double *prb = recv_buf[1];
 
   jl = pMG->js;
   ju = pMG->je;
@@ -790,21 +1058,11 @@ void swap_mg_ox1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
         *(psb++) = pMG->Phi[k][j][pMG->ie];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on R-x1 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->rx1_id,
-      boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ox1]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row i=ie+1 of iterates into ghost zone */
+/* Unpack single row i=ie+1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the right grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ox1]: MPI_Wait error = %d\n",err);
-
     for (k=kl; k<=ku; k++){
       for (j=jl; j<=ju; j++){
         pMG->Phi[k][j][pMG->ie+1] = *(prb++);
@@ -816,18 +1074,19 @@ void swap_mg_ox1(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ix2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void swap_mg_ix2(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Inner x2 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ix2 and set_bvals/receive_ix2
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ix2 and bvals_grav/unpack_Phi_ix2
  */
 
-void swap_mg_ix2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ix2(MGrid *pMG, int swap_flag)
 {
-  int i,il,iu,k,kl,ku,err;
-  MPI_Status stat;
-  double *pd = send_buf;
+  int i,il,iu,k,kl,ku;
+  double *psb = send_buf[0];
+  double *prb = recv_buf[0];
 
   il = pMG->is - 1;
   iu = pMG->ie + 1;
@@ -844,27 +1103,17 @@ void swap_mg_ix2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
   if (swap_flag == 0) {
     for (k=kl; k<=ku; k++){
       for (i=il; i<=iu; i++){
-        *(pd++) = pMG->Phi[k][pMG->js][i];
+        *(psb++) = pMG->Phi[k][pMG->js][i];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on L-x2 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->lx2_id,
-       boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ix2]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row j=js-1 of iterates into ghost zone */
+/* Unpack single row j=js-1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the left grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ix2]: MPI_Wait error = %d\n",err);
-
     for (k=kl; k<=ku; k++){
       for (i=il; i<=iu; i++){
-        pMG->Phi[k][pMG->js-1][i] = *(pd++);
+        pMG->Phi[k][pMG->js-1][i] = *(prb++);
       }
     }
   }
@@ -873,18 +1122,19 @@ void swap_mg_ix2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ox2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void swap_mg_ox2(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Outer x2 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ix2 and set_bvals/receive_ix2
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ox2 and bvals_grav/unpack_Phi_ox2
  */
 
-void swap_mg_ox2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ox2(MGrid *pMG, int swap_flag)
 {
-  int i,il,iu,k,kl,ku,err;
-  MPI_Status stat;
-  double *pd = send_buf;
+  int i,il,iu,k,kl,ku;
+  double *psb = send_buf[1];
+  double *prb = recv_buf[1];
 
   il = pMG->is - 1;
   iu = pMG->ie + 1;
@@ -901,27 +1151,17 @@ void swap_mg_ox2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
   if (swap_flag == 0) {
     for (k=kl; k<=ku; k++){
       for (i=il; i<=iu; i++){
-        *(pd++) = pMG->Phi[k][pMG->je][i];
+        *(psb++) = pMG->Phi[k][pMG->je][i];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on R-x2 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->rx2_id,
-                   boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ox2]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row j=je+1 of iterates into ghost zone */
+/* Unpack single row j=je+1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the right grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ox2]: MPI_Wait error = %d\n",err);
-
     for (k=kl; k<=ku; k++){
       for (i=il; i<=iu; i++){
-        pMG->Phi[k][pMG->je+1][i] = *(pd++);
+        pMG->Phi[k][pMG->je+1][i] = *(prb++);
       }
     }
   }
@@ -930,18 +1170,19 @@ void swap_mg_ox2(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ix3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void swap_mg_ix3(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Inner x3 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ix3 and set_bvals/receive_ix3
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ix3 and bvals_grav/unpack_Phi_ix3
  */
 
-void swap_mg_ix3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ix3(MGrid *pMG, int swap_flag)
 {
-  int i,il,iu,j,jl,ju,err;
-  MPI_Status stat;
-  double *pd = send_buf;
+  int i,il,iu,j,jl,ju;
+  double *psb = send_buf[0];
+  double *prb = recv_buf[0];
 
   il = pMG->is - 1;
   iu = pMG->ie + 1;
@@ -953,27 +1194,17 @@ void swap_mg_ix3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
   if (swap_flag == 0) {
     for (j=jl; j<=ju; j++){
       for (i=il; i<=iu; i++){
-        *(pd++) = pMG->Phi[pMG->ks][j][i];
+        *(psb++) = pMG->Phi[pMG->ks][j][i];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on L-x3 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->lx3_id,
-                   boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ix3]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row k=ks-1 of iterates into ghost zone */
+/* Unpack single row k=ks-1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the left grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ix3]: MPI_Wait error = %d\n",err);
-
     for (j=jl; j<=ju; j++){
       for (i=il; i<=iu; i++){
-        pMG->Phi[pMG->ks-1][j][i] = *(pd++);
+        pMG->Phi[pMG->ks-1][j][i] = *(prb++);
       }
     }
   }
@@ -982,50 +1213,167 @@ void swap_mg_ix3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 }
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void swap_mg_ox3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+/*! \fn void swap_mg_ox3(MGrid *pMG, int swap_flag)
  *  \brief MPI_SWAP of boundary conditions, Outer x3 boundary
  *
- *   This function does either a send (swap_flag=0), or receive (swap_flag=1)
- *   Largely copied from set_bvals/send_ix1 and set_bvals/receive_ix1
+ *   This function either packs the send buffer (swap_flag=0), or unpacks the
+ *   receive buffer (swap_flag=1).
+ *   Largely copied from bvals_grav/pack_Phi_ox3 and bvals_grav/unpack_Phi_ox3
  */
 
-void swap_mg_ox3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
+void swap_mg_ox3(MGrid *pMG, int swap_flag)
 {
-  int i,il,iu,j,jl,ju,err;
-  MPI_Status stat;
-  double *pd = send_buf;
+  int i,il,iu,j,jl,ju;
+  double *psb = send_buf[1];
+  double *prb = recv_buf[1];
 
   il = pMG->is - 1;
   iu = pMG->ie + 1;
   jl = pMG->js - 1;
   ju = pMG->je + 1;
 
-/* Pack single row k=ke of interates into send buffer */
+/* Pack single row k=ke of iterates into send buffer */
 
   if (swap_flag == 0) {
     for (j=jl; j<=ju; j++){
       for (i=il; i<=iu; i++){
-        *(pd++) = pMG->Phi[pMG->ke][j][i];
+        *(psb++) = pMG->Phi[pMG->ke][j][i];
       }
     }
-
-    /* send contents of buffer to the neighboring grid on R-x3 */
-    err = MPI_Send(send_buf, cnt, MPI_DOUBLE, pMG->rx3_id,
-                   boundary_cells_tag, MPI_COMM_WORLD);
-    if(err) ath_error("[swap_mg_ox3]: MPI_Send error = %d\n",err);
   }
 
-/* Receive message and unpack single row k=ke+1 of iterates into ghost zone */
+/* Unpack single row k=ke+1 of iterates into ghost zone */
 
   if (swap_flag == 1) {
-
-    /* Wait to receive the input data from the right grid */
-    err = MPI_Wait(prq, &stat);
-    if(err) ath_error("[swap_mg_ox3]: MPI_Wait error = %d\n",err);
-
     for (j=jl; j<=ju; j++){
       for (i=il; i<=iu; i++){
-        pMG->Phi[pMG->ke+1][j][i] = *(pd++);
+        pMG->Phi[pMG->ke+1][j][i] = *(prb++);
+      }
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void agglomerate_mg(MGrid *pMG, void (*mg_solve)(MGrid *pMG))
+ *  \brief Gathers a distributed level onto the root of Comm_MG, continues the
+ *   cycle (mg_solve) on the single (serial) grid, and scatters the result back.
+ *
+ *   Each processor sends the RHS and iterates on its Grid including the single
+ *   ghost zone.  Ghost zones of the gathered grid are copied from the Grids at
+ *   the edge of the Domain, so the (fixed) physical BCs are preserved.  On
+ *   return, the ghost zones at internal boundaries hold the neighbors' values.
+ */
+
+static void agglomerate_mg(MGrid *pMG, void (*mg_solve)(MGrid *pMG))
+{
+  MGrid Glob_grid;
+  int i,j,k,n,ig,jg,kg,ierr;
+  int nx1z = pMG->Nx1 + 2, nx2z = pMG->Nx2 + 2, nx3z = pMG->Nx3 + 2;
+  double *pd;
+
+/* pack RHS and iterates (with ghost zones) into send buffer, and gather */
+
+  pd = agg_sbuf;
+  for (k=0; k<nx3z; k++){
+    for (j=0; j<nx2z; j++){
+      for (i=0; i<nx1z; i++){
+        *(pd++) = pMG->rhs[k][j][i];
+        *(pd++) = pMG->Phi[k][j][i];
+      }
+    }
+  }
+
+  ierr = MPI_Gatherv(agg_sbuf, 2*nx1z*nx2z*nx3z, MPI_DOUBLE, agg_rbuf,
+    agg_gcnt, agg_gdsp, MPI_DOUBLE, 0, Comm_MG);
+  if (ierr) ath_error("[agglomerate_mg]: MPI_Gatherv error = %d\n",ierr);
+
+/* Root processor unpacks data into a single grid covering the whole Domain at
+ * this level, and continues the V-cycle in serial */
+
+  if (myID_MG == 0) {
+    Glob_grid.Nx1 = 0;  Glob_grid.Nx2 = 0;  Glob_grid.Nx3 = 0;
+    for (n=0; n<nproc_MG; n++){
+      Glob_grid.Nx1 = MAX(Glob_grid.Nx1, agg_Disp[n][0] + agg_Nx[n][0]);
+      Glob_grid.Nx2 = MAX(Glob_grid.Nx2, agg_Disp[n][1] + agg_Nx[n][1]);
+      Glob_grid.Nx3 = MAX(Glob_grid.Nx3, agg_Disp[n][2] + agg_Nx[n][2]);
+    }
+    Glob_grid.is = 1;  Glob_grid.ie = Glob_grid.Nx1;
+    Glob_grid.js = 1;  Glob_grid.je = Glob_grid.Nx2;
+    Glob_grid.ks = 1;  Glob_grid.ke = Glob_grid.Nx3;
+    Glob_grid.dx1 = pMG->dx1;
+    Glob_grid.dx2 = pMG->dx2;
+    Glob_grid.dx3 = pMG->dx3;
+    Glob_grid.rx1_id = -1; Glob_grid.lx1_id = -1;
+    Glob_grid.rx2_id = -1; Glob_grid.lx2_id = -1;
+    Glob_grid.rx3_id = -1; Glob_grid.lx3_id = -1;
+    Glob_grid.Disp1 = 0;  Glob_grid.Disp2 = 0;  Glob_grid.Disp3 = 0;
+    Glob_grid.level = pMG->level;
+    Glob_grid.dist = 0;
+
+    Glob_grid.rhs = (Real ***) calloc_3d_array(Glob_grid.Nx3+2, Glob_grid.Nx2+2,
+      Glob_grid.Nx1+2, sizeof(Real));
+    Glob_grid.Phi = (Real ***) calloc_3d_array(Glob_grid.Nx3+2, Glob_grid.Nx2+2,
+      Glob_grid.Nx1+2, sizeof(Real));
+    if (Glob_grid.rhs == NULL || Glob_grid.Phi == NULL) {
+      ath_error("[agglomerate_mg]: Error allocating memory\n");
+    }
+
+/* Copy active zones of every Grid, plus ghost zones at edges of Domain */
+
+    for (n=0; n<nproc_MG; n++){
+      pd = agg_rbuf + agg_gdsp[n];
+      for (k=0; k<agg_Nx[n][2]+2; k++){
+        kg = k + agg_Disp[n][2];
+        for (j=0; j<agg_Nx[n][1]+2; j++){
+          jg = j + agg_Disp[n][1];
+          for (i=0; i<agg_Nx[n][0]+2; i++){
+            ig = i + agg_Disp[n][0];
+            if ((i>0 && i<=agg_Nx[n][0] && j>0 && j<=agg_Nx[n][1] &&
+                 k>0 && k<=agg_Nx[n][2]) ||
+                ig==0 || ig==Glob_grid.Nx1+1 || jg==0 || jg==Glob_grid.Nx2+1 ||
+                kg==0 || kg==Glob_grid.Nx3+1) {
+              Glob_grid.rhs[kg][jg][ig] = pd[0];
+              Glob_grid.Phi[kg][jg][ig] = pd[1];
+            }
+            pd += 2;
+          }
+        }
+      }
+    }
+
+    (*mg_solve)(&Glob_grid);
+
+/* pack the solution on each Grid (with ghost zones) for the scatter */
+
+    for (n=0; n<nproc_MG; n++){
+      pd = agg_rbuf + agg_sdsp[n];
+      for (k=0; k<agg_Nx[n][2]+2; k++){
+        kg = k + agg_Disp[n][2];
+        for (j=0; j<agg_Nx[n][1]+2; j++){
+          jg = j + agg_Disp[n][1];
+          for (i=0; i<agg_Nx[n][0]+2; i++){
+            ig = i + agg_Disp[n][0];
+            *(pd++) = Glob_grid.Phi[kg][jg][ig];
+          }
+        }
+      }
+    }
+
+    free_3d_array(Glob_grid.rhs);
+    free_3d_array(Glob_grid.Phi);
+  }
+
+  ierr = MPI_Scatterv(agg_rbuf, agg_scnt, agg_sdsp, MPI_DOUBLE, agg_sbuf,
+    nx1z*nx2z*nx3z, MPI_DOUBLE, 0, Comm_MG);
+  if (ierr) ath_error("[agglomerate_mg]: MPI_Scatterv error = %d\n",ierr);
+
+  pd = agg_sbuf;
+  for (k=0; k<nx3z; k++){
+    for (j=0; j<nx2z; j++){
+      for (i=0; i<nx1z; i++){
+        pMG->Phi[k][j][i] = *(pd++);
       }
     }
   }
@@ -1036,23 +1384,43 @@ void swap_mg_ox3(MGrid *pMG, int cnt, int swap_flag, MPI_Request *prq)
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void selfg_multig_3d_init(MeshS *pM)
- *  \brief Initialize send/receive buffers needed to swap
- *   iterates during Jacobi iterations.
+ *  \brief Reads parameters of the solver, and initializes send/receive
+ *   buffers needed to swap iterates during smoothing.
+ *
+ *   With MPI, also finds the level at which the Grids are agglomerated onto
+ *   the root processor, and allocates the buffers needed to do so.
  */
 
 void selfg_multig_3d_init(MeshS *pM)
 {
+  DomainS *pD=NULL;
+  int size1=0,size2=0,size3=0,nl,nd;
+  char *cycle;
 #ifdef MPI_PARALLEL
-  int i,j,k,x1cnt,x2cnt,x3cnt;
-  int nx1t,nx2t,nx3t, size;
-  int NGrid_x1, NGrid_x2, NGrid_x3;
+  GridS *pG;
+  int i,l,m,n,id,ierr,ok,gok,size;
+  int nx[3], Nx[3];
 #endif
-  int nmax,size1=0,size2=0,size3=0,nl,nd;
+
+/* Parameters of the solver */
+  cycle = par_gets_def("multigrid","cycle","V");
+  if (strcmp(cycle,"V") == 0) mg_gamma = 1;
+  else if (strcmp(cycle,"W") == 0) mg_gamma = 2;
+  else ath_error("[selfg_multig_3d_init]: cycle=%s must be V or W\n",cycle);
+  free(cycle);
+  mg_nu1 = par_geti_def("multigrid","nu1",2);
+  mg_nu2 = par_geti_def("multigrid","nu2",2);
+  mg_ncoarse = par_geti_def("multigrid","ncoarse",10);
+  mg_tol = par_getd_def("multigrid","tol",1.0e-6);
+  mg_max_cycles = par_geti_def("multigrid","max_cycles",10);
+  mg_warm_start = par_geti_def("multigrid","warm_start",1);
+  mg_first_solve = 1;
 
 /* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
   for (nl=0; nl<(pM->NLevels); nl++){
     for (nd=0; nd<(pM->DomainsPerLevel[nl]); nd++){
       if (pM->Domain[nl][nd].Grid != NULL) {
+        pD = &(pM->Domain[nl][nd]);
         if (pM->Domain[nl][nd].Grid->Nx[0] > size1){
           size1 = pM->Domain[nl][nd].Grid->Nx[0];
         }
@@ -1066,6 +1434,76 @@ void selfg_multig_3d_init(MeshS *pM)
     }
   }
 
+#ifdef MPI_PARALLEL
+  if (pD == NULL) return;
+  pG = pD->Grid;
+  Comm_MG = pD->Comm_Domain;
+  MPI_Comm_rank(Comm_MG, &myID_MG);
+  MPI_Comm_size(Comm_MG, &nproc_MG);
+
+/* Find the number of levels that can be coarsened on every Grid: each Grid
+ * must have an even number of cells, and the Domain must not yet have reached
+ * the coarsest level used in serial.  */
+
+  nlev_dist = 0;
+  do {
+    ok = 1;
+    for (i=0; i<3; i++){
+      nx[i] = (pG->Nx[i]) >> nlev_dist;
+      Nx[i] = (pD->Nx[i]) >> nlev_dist;
+      if ((nx[i] % 2) != 0 || (Nx[i] % 2) != 0 || Nx[i] <= 4) ok = 0;
+    }
+    ierr = MPI_Allreduce(&ok, &gok, 1, MPI_INT, MPI_MIN, Comm_MG);
+    if (gok) nlev_dist++;
+  } while (gok);
+
+/* Size and offset of every Grid at the agglomeration level */
+
+  if (nproc_MG > 1) {
+    agg_Nx   = (int (*)[3])calloc_1d_array(nproc_MG, 3*sizeof(int));
+    agg_Disp = (int (*)[3])calloc_1d_array(nproc_MG, 3*sizeof(int));
+    agg_gcnt = (int*)calloc_1d_array(nproc_MG, sizeof(int));
+    agg_gdsp = (int*)calloc_1d_array(nproc_MG, sizeof(int));
+    agg_scnt = (int*)calloc_1d_array(nproc_MG, sizeof(int));
+    agg_sdsp = (int*)calloc_1d_array(nproc_MG, sizeof(int));
+    if (agg_Nx == NULL || agg_Disp == NULL || agg_gcnt == NULL ||
+        agg_gdsp == NULL || agg_scnt == NULL || agg_sdsp == NULL)
+      ath_error("[selfg_multig_3d_init]: Failed to allocate agglomeration data\n");
+
+    for (n=0; n<(pD->NGrid[2]); n++){
+    for (m=0; m<(pD->NGrid[1]); m++){
+    for (l=0; l<(pD->NGrid[0]); l++){
+      id = pD->GData[n][m][l].ID_Comm_Domain;
+      for (i=0; i<3; i++){
+        agg_Nx[id][i] = (pD->GData[n][m][l].Nx[i]) >> nlev_dist;
+        agg_Disp[id][i] = (pD->GData[n][m][l].Disp[i] - pD->Disp[i]) >> nlev_dist;
+      }
+      agg_scnt[id] = (agg_Nx[id][0]+2)*(agg_Nx[id][1]+2)*(agg_Nx[id][2]+2);
+      agg_gcnt[id] = 2*agg_scnt[id];
+    }}}
+
+    for (id=1; id<nproc_MG; id++){
+      agg_gdsp[id] = agg_gdsp[id-1] + agg_gcnt[id-1];
+      agg_sdsp[id] = agg_sdsp[id-1] + agg_scnt[id-1];
+    }
+
+    size = agg_gcnt[myID_MG];
+    if((agg_sbuf = (double*)malloc(size*sizeof(double))) == NULL)
+      ath_error("[selfg_multig_3d_init]: Failed to allocate send buffer\n");
+
+    if (myID_MG == 0) {
+      size = agg_gdsp[nproc_MG-1] + agg_gcnt[nproc_MG-1];
+      if((agg_rbuf = (double*)malloc(size*sizeof(double))) == NULL)
+        ath_error("[selfg_multig_3d_init]: Failed to allocate recv buffer\n");
+
+/* error array on root must also hold the agglomerated grid */
+      size1 = MAX(size1, (pD->Nx[0]) >> nlev_dist);
+      size2 = MAX(size2, (pD->Nx[1]) >> nlev_dist);
+      size3 = MAX(size3, (pD->Nx[2]) >> nlev_dist);
+    }
+  }
+#endif /* MPI_PARALLEL */
+
   size1 += 2;
   size2 += 2;
   size3 += 2;
@@ -1075,56 +1513,24 @@ void selfg_multig_3d_init(MeshS *pM)
   }
 
 /* Allocate memory for send and receive buffers for Phi in MultiGrid
- * structure for MPI parallel.
+ * structure for MPI parallel.  The largest message is a single face of the
+ * finest level, including the ghost zones in the transverse directions.
  */
 #ifdef MPI_PARALLEL
-  NGrid_x1 = par_geti("parallel","NGrid_x1");
-  NGrid_x2 = par_geti("parallel","NGrid_x2");
-  NGrid_x3 = par_geti("parallel","NGrid_x3");
-
-  x1cnt = x2cnt = x3cnt = 0;
-        
-  for (k=0; k<NGrid_x3; k++){
-    for (j=0; j<NGrid_x2; j++){
-      for (i=0; i<NGrid_x1; i++){
-        if(NGrid_x1 > 1){
-          nx2t = pD->grid_block[k][j][i].jde - pD->grid_block[k][j][i].jds + 1;
-          nx3t = pD->grid_block[k][j][i].kde - pD->grid_block[k][j][i].kds + 1;
-        
-          x1cnt = nx2t*nx3t > x1cnt ? nx2t*nx3t : x1cnt;
-        }
-        
-        if(NGrid_x2 > 1){
-          nx1t = pD->grid_block[k][j][i].ide - pD->grid_block[k][j][i].ids + 1;
-          if(nx1t > 1) nx1t += 2;
-          nx3t = pD->grid_block[k][j][i].kde - pD->grid_block[k][j][i].kds + 1;
-
-          x2cnt = nx1t*nx3t > x2cnt ? nx1t*nx3t : x2cnt;
-        }
-
+  size = MAX(size2*size3, size1*size3);
+  size = MAX(size, size1*size2);
 
-        if(NGrid_x3 > 1){
-          nx1t = pD->grid_block[k][j][i].ide - pD->grid_block[k][j][i].ids + 1;
-          if(nx1t > 1) nx1t += 2;
-          nx2t = pD->grid_block[k][j][i].jde - pD->grid_block[k][j][i].jds + 1;
-          if(nx2t > 1) nx2t += 2;
-
-          x3cnt = nx1t*nx2t > x3cnt ? nx1t*nx2t : x3cnt;
-        }
-      }
-    }
-  }
+  if((send_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    ath_error("[selfg_multig_3d_init]: Failed to allocate send buffer\n");
 
-  size = x1cnt > x2cnt ? x1cnt : x2cnt;
-  size = x3cnt >  size ? x3cnt : size;
+  if((recv_buf = (double**)calloc_2d_array(2,size,sizeof(double))) == NULL)
+    ath_error("[selfg_multig_3d_init]: Failed to allocate recv buffer\n");
 
-  if (size > 0) {
-    if((send_buf = (double*)malloc(size*sizeof(double))) == NULL)
-      ath_error("[selfg_by_multig_3d_init]: Failed to allocate send buffer\n");
+  if((recv_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
+    ath_error("[selfg_multig_3d_init]: Failed to allocate recv MPI_Request\n");
 
-    if((recv_buf = (double*)malloc(size*sizeof(double))) == NULL)
-      ath_error("[selfg_by_multig_3d_init]: Failed to allocate recv buffer\n");
-  }
+  if((send_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
+    ath_error("[selfg_multig_3d_init]: Failed to allocate send MPI_Request\n");
 #endif /* MPI_PARALLEL */
   return;
 }
@@ -165,21 +165,33 @@ void init_grid(MeshS *pM)
       else
         n3z = 1;
 
-/* Build a 3D array of type ConsS */
-
+/* Build a 3D array of type ConsS, or with --enable-soa one 3D array per
+ * conserved variable.  The latter are stacked in a single allocation of
+ * NCONS*n3z planes, so pG->U.d owns the memory for all of them. */
+
+#ifdef CONS_SOA
+      {
+        GReal ***pblk, ****pvar = (GReal****)&(pG->U);
+        int n;
+        pblk = (GReal***)calloc_3d_array(NCONS*n3z, n2z, n1z, sizeof(GReal));
+        for (n=0; n<NCONS; n++) pvar[n] = (pblk == NULL) ? NULL : pblk + n*n3z;
+        if (pblk == NULL) goto on_error1;
+      }
+#else
       pG->U = (ConsS***)calloc_3d_array(n3z, n2z, n1z, sizeof(ConsS));
       if (pG->U == NULL) goto on_error1;
+#endif
     
 /* Build 3D arrays to hold interface field */
 
 #ifdef MHD
-      pG->B1i = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
+      pG->B1i = (GReal***)calloc_3d_array(n3z, n2z, n1z, sizeof(GReal));
       if (pG->B1i == NULL) goto on_error2;
 
-      pG->B2i = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
+      pG->B2i = (GReal***)calloc_3d_array(n3z, n2z, n1z, sizeof(GReal));
       if (pG->B2i == NULL) goto on_error3;
 
-      pG->B3i = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
+      pG->B3i = (GReal***)calloc_3d_array(n3z, n2z, n1z, sizeof(GReal));
       if (pG->B3i == NULL) goto on_error4;
 #endif /* MHD */
 
@@ -199,10 +211,10 @@ void init_grid(MeshS *pM)
 /* Build 3D arrays to gravitational potential and mass fluxes */
 
 #ifdef SELF_GRAVITY
-      pG->Phi = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
+      pG->Phi = (GReal***)calloc_3d_array(n3z, n2z, n1z, sizeof(GReal));
       if (pG->Phi == NULL) goto on_error9;
 
-      pG->Phi_old = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
+      pG->Phi_old = (GReal***)calloc_3d_array(n3z, n2z, n1z, sizeof(GReal));
       if (pG->Phi_old == NULL) goto on_error10;
 
       pG->x1MassFlux = (Real***)calloc_3d_array(n3z, n2z, n1z, sizeof(Real));
@@ -228,6 +240,13 @@ void init_grid(MeshS *pM)
       }
 #endif /* CYLINDRICAL */
 
+/* Build 3D array to cache primitive variables */
+#ifdef PRIM_CACHE
+      pG->W = (PrimS***)calloc_3d_array(n3z, n2z, n1z, sizeof(PrimS));
+      if (pG->W == NULL) goto on_error16;
+      pG->W_valid = 0;
+#endif /* PRIM_CACHE */
+
 
 /*-- Get IDs of neighboring Grids in Domain communicator ---------------------*/
 /* If Grid is at the edge of the Domain (so it is either a physical boundary,
@@ -1091,6 +1110,9 @@ G3.ijkl[2],G3.ijkr[2]);
 
 /*--- Error messages ---------------------------------------------------------*/
 
+#ifdef PRIM_CACHE
+  on_error16:
+#endif
 #ifdef CYLINDRICAL
   on_error15:
     free_1d_array(pG->ri);
@@ -1126,7 +1148,11 @@ G3.ijkl[2],G3.ijkr[2]);
     free_3d_array(pG->B1i);
 #endif
   on_error1:
+#ifdef CONS_SOA
+    if (pG->U.d != NULL) free_3d_array(pG->U.d);
+#else
     free_3d_array(pG->U);
+#endif
     ath_error("[init_grid]: Error allocating memory\n");
 }
 
@@ -61,16 +61,20 @@ VDFun_t integrate_init(MeshS *pM)
 #endif
 
   case 3:
+    integrate_init_3d_blocked(pM);
+    integrate_init_3d_overlap(pM);
     integrate_init_3d(pM);
 #if defined(CTU_INTEGRATOR)
     cfl = par_getd("time","cour_no");
     if (cfl > 0.5)
       ath_error("<time>cour_no=%e, must be <= 0.5 with 3D CTU integrator\n",cfl);
+    if (integrate_3d_kblock() > 0) return integrate_3d_blocked;
     return integrate_3d_ctu;
 #elif defined(VL_INTEGRATOR)
     cfl = par_getd("time","cour_no");
     if (cfl > 0.5)
       ath_error("<time>cour_no=%e, must be <= 0.5 with 3D VL integrator\n",cfl);
+    if (integrate_3d_kblock() > 0) return integrate_3d_blocked;
     return integrate_3d_vl;
 #else
     ath_err("[integrate_init]: Invalid integrator defined for 3D problem");
@@ -101,6 +105,8 @@ void integrate_destruct()
     return;
   case 3:
     integrate_destruct_3d();
+    integrate_destruct_3d_blocked();
+    integrate_destruct_3d_overlap();
     return;
   }
 
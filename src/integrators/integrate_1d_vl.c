@@ -76,7 +76,7 @@ void integrate_1d_vl(DomainS *pD)
   Real lsf=1.0, rsf=1.0;
 
   for (i=is-nghost; i<=ie+nghost; i++) {
-    Uhalf[i] = pG->U[ks][js][i];
+    Uhalf[i] = UCELL(pG->U,ks,js,i);
   }
 
 /*=== STEP 1: Compute first-order fluxes at t^{n} in x1-direction ============*/
@@ -88,21 +88,21 @@ void integrate_1d_vl(DomainS *pD)
  */
 
   for (i=is-nghost; i<=ie+nghost; i++) {
-    U1d[i].d  = pG->U[ks][js][i].d;
-    U1d[i].Mx = pG->U[ks][js][i].M1;
-    U1d[i].My = pG->U[ks][js][i].M2;
-    U1d[i].Mz = pG->U[ks][js][i].M3;
+    U1d[i].d  = UVAR(pG->U,ks,js,i,d);
+    U1d[i].Mx = UVAR(pG->U,ks,js,i,M1);
+    U1d[i].My = UVAR(pG->U,ks,js,i,M2);
+    U1d[i].Mz = UVAR(pG->U,ks,js,i,M3);
 #ifndef BAROTROPIC
-    U1d[i].E  = pG->U[ks][js][i].E;
+    U1d[i].E  = UVAR(pG->U,ks,js,i,E);
 #endif /* BAROTROPIC */
 #ifdef MHD
-    U1d[i].By = pG->U[ks][js][i].B2c;
-    U1d[i].Bz = pG->U[ks][js][i].B3c;
-    Bxc[i] = pG->U[ks][js][i].B1c;
+    U1d[i].By = UVAR(pG->U,ks,js,i,B2c);
+    U1d[i].Bz = UVAR(pG->U,ks,js,i,B3c);
+    Bxc[i] = UVAR(pG->U,ks,js,i,B1c);
     Bxi[i] = pG->B1i[ks][js][i];
 #endif /* MHD */
 #if (NSCALARS > 0)
-    for (n=0; n<NSCALARS; n++) U1d[i].s[n] = pG->U[ks][js][i].s[n];
+    for (n=0; n<NSCALARS; n++) U1d[i].s[n] = UVAR(pG->U,ks,js,i,s[n]);
 #endif
   }
 
@@ -127,9 +127,7 @@ void integrate_1d_vl(DomainS *pD)
 /*--- Step 1d ------------------------------------------------------------------
  * Compute flux in x1-direction */
 
-  for (i=il; i<=ie+nghost; i++) {
-    fluxes(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&x1Flux[i]);
-  }
+  fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,x1Flux,il,ie+nghost);
 
 /*=== STEPS 2-4: Not needed in 1D ===*/
 
@@ -179,7 +177,7 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
       rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-      Uhalf[i].M1 -= hdtodx1*pG->U[ks][js][i].d*(phir-phil);
+      Uhalf[i].M1 -= hdtodx1*UVAR(pG->U,ks,js,i,d)*(phir-phil);
 #ifndef BAROTROPIC
       Uhalf[i].E -= hdtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
                              rsf*x1Flux[i+1].d*(phir - phic));
@@ -201,7 +199,7 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
     rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-    Uhalf[i].M1 -= hdtodx1*pG->U[ks][js][i].d*(phir-phil);
+    Uhalf[i].M1 -= hdtodx1*UVAR(pG->U,ks,js,i,d)*(phir-phil);
 #ifndef BAROTROPIC
     Uhalf[i].E -= hdtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
                            rsf*x1Flux[i+1].d*(phir - phic));
@@ -219,24 +217,24 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
   for (i=il; i<=iu; i++) {
 
-    Ekin = 0.5*(SQR(pG->U[ks][js][i].M1)+SQR(pG->U[ks][js][i].M2)+SQR(pG->U[ks][js][i].M3))/pG->U[ks][js][i].d;
+    Ekin = 0.5*(SQR(UVAR(pG->U,ks,js,i,M1))+SQR(UVAR(pG->U,ks,js,i,M2))+SQR(UVAR(pG->U,ks,js,i,M3)))/UVAR(pG->U,ks,js,i,d);
 #ifdef MHD
-    B2sq = SQR(pG->U[ks][js][i].B2c);
-    Emag = 0.5*(SQR(pG->U[ks][js][i].B1c) + B2sq + SQR(pG->U[ks][js][i].B3c));
+    B2sq = SQR(UVAR(pG->U,ks,js,i,B2c));
+    Emag = 0.5*(SQR(UVAR(pG->U,ks,js,i,B1c)) + B2sq + SQR(UVAR(pG->U,ks,js,i,B3c)));
 #else
     B2sq = 0.0;
     Emag = 0.0;
 #endif
 
 #ifdef ISOTHERMAL
-    Ptot = Iso_csound2*pG->U[ks][js][i].d;
+    Ptot = Iso_csound2*UVAR(pG->U,ks,js,i,d);
 #else
-    Ptot = Gamma_1*(pG->U[ks][js][i].E - Ekin - Emag);
+    Ptot = Gamma_1*(UVAR(pG->U,ks,js,i,E) - Ekin - Emag);
 #endif
     Ptot = MAX(Ptot,TINY_NUMBER);
     Ptot += Emag;
 
-    Uhalf[i].M1 += hdt*(SQR(pG->U[ks][js][i].M2)/pG->U[ks][js][i].d - B2sq + Ptot)/r[i];
+    Uhalf[i].M1 += hdt*(SQR(UVAR(pG->U,ks,js,i,M2))/UVAR(pG->U,ks,js,i,d) - B2sq + Ptot)/r[i];
   }
 #endif /* CYLINDRICAL */
 
@@ -292,10 +290,10 @@ void integrate_1d_vl(DomainS *pD)
   for (i=is; i<=ie+1; i++) {
     Ul[i] = Prim1D_to_Cons1D(&Wl_x1Face[i],&Bxi[i]);
     Ur[i] = Prim1D_to_Cons1D(&Wr_x1Face[i],&Bxi[i]);
-
-    fluxes(Ul[i],Ur[i],Wl_x1Face[i],Wr_x1Face[i],Bxi[i],&x1Flux[i]);
   }
 
+  fluxes_pencil(Ul,Ur,Wl_x1Face,Wr_x1Face,Bxi,x1Flux,is,ie+1);
+
 /*=== STEP 11: Not needed in 1D ===*/
         
 /*=== STEP 12: Add source terms for a full timestep using n+1/2 states =======*/
@@ -317,9 +315,9 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
       rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-      pG->U[ks][js][i].M1 -= dtodx1*Uhalf[i].d*(phir-phil);
+      UVAR(pG->U,ks,js,i,M1) -= dtodx1*Uhalf[i].d*(phir-phil);
 #ifndef BAROTROPIC
-      pG->U[ks][js][i].E -= dtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
+      UVAR(pG->U,ks,js,i,E) -= dtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
                                     rsf*x1Flux[i+1].d*(phir - phic));
 #endif
     }
@@ -351,9 +349,9 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
     rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-    pG->U[ks][js][i].M1 -= dtodx1*(flx_m1r - flx_m1l);
+    UVAR(pG->U,ks,js,i,M1) -= dtodx1*(flx_m1r - flx_m1l);
 #ifndef BAROTROPIC
-    pG->U[ks][js][i].E -= dtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
+    UVAR(pG->U,ks,js,i,E) -= dtodx1*(lsf*x1Flux[i  ].d*(phic - phil) +
                                   rsf*x1Flux[i+1].d*(phir - phic));
 #endif /* BAROTROPIC */
   }
@@ -390,7 +388,7 @@ void integrate_1d_vl(DomainS *pD)
     Ptot = MAX(Ptot,TINY_NUMBER);
     Ptot += Emag;
 
-    pG->U[ks][js][i].M1 += pG->dt*(SQR(Uhalf[i].M2)/Uhalf[i].d - B2sq + Ptot)/r[i];
+    UVAR(pG->U,ks,js,i,M1) += pG->dt*(SQR(Uhalf[i].M2)/Uhalf[i].d - B2sq + Ptot)/r[i];
   }
 #endif /* CYLINDRICAL */
 
@@ -405,23 +403,23 @@ void integrate_1d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
     rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-    pG->U[ks][js][i].d  -= dtodx1*(rsf*x1Flux[i+1].d  - lsf*x1Flux[i].d );
-    pG->U[ks][js][i].M1 -= dtodx1*(rsf*x1Flux[i+1].Mx - lsf*x1Flux[i].Mx);
-    pG->U[ks][js][i].M2 -= dtodx1*(SQR(rsf)*x1Flux[i+1].My - SQR(lsf)*x1Flux[i].My);
-    pG->U[ks][js][i].M3 -= dtodx1*(rsf*x1Flux[i+1].Mz - lsf*x1Flux[i].Mz);
+    UVAR(pG->U,ks,js,i,d)  -= dtodx1*(rsf*x1Flux[i+1].d  - lsf*x1Flux[i].d );
+    UVAR(pG->U,ks,js,i,M1) -= dtodx1*(rsf*x1Flux[i+1].Mx - lsf*x1Flux[i].Mx);
+    UVAR(pG->U,ks,js,i,M2) -= dtodx1*(SQR(rsf)*x1Flux[i+1].My - SQR(lsf)*x1Flux[i].My);
+    UVAR(pG->U,ks,js,i,M3) -= dtodx1*(rsf*x1Flux[i+1].Mz - lsf*x1Flux[i].Mz);
 #ifndef BAROTROPIC
-    pG->U[ks][js][i].E  -= dtodx1*(rsf*x1Flux[i+1].E  - lsf*x1Flux[i].E );
+    UVAR(pG->U,ks,js,i,E)  -= dtodx1*(rsf*x1Flux[i+1].E  - lsf*x1Flux[i].E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][js][i].B2c -= dtodx1*(x1Flux[i+1].By - x1Flux[i].By);
-    pG->U[ks][js][i].B3c -= dtodx1*(rsf*x1Flux[i+1].Bz - lsf*x1Flux[i].Bz);
+    UVAR(pG->U,ks,js,i,B2c) -= dtodx1*(x1Flux[i+1].By - x1Flux[i].By);
+    UVAR(pG->U,ks,js,i,B3c) -= dtodx1*(rsf*x1Flux[i+1].Bz - lsf*x1Flux[i].Bz);
 /* For consistency, set B2i and B3i to cell-centered values.  */
-    pG->B2i[ks][js][i] = pG->U[ks][js][i].B2c;
-    pG->B3i[ks][js][i] = pG->U[ks][js][i].B3c;
+    pG->B2i[ks][js][i] = UVAR(pG->U,ks,js,i,B2c);
+    pG->B3i[ks][js][i] = UVAR(pG->U,ks,js,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
     for (n=0; n<NSCALARS; n++)
-      pG->U[ks][js][i].s[n] -= dtodx1*(rsf*x1Flux[i+1].s[n] - lsf*x1Flux[i].s[n]);
+      UVAR(pG->U,ks,js,i,s[n]) -= dtodx1*(rsf*x1Flux[i+1].s[n] - lsf*x1Flux[i].s[n]);
 #endif
   }
 
@@ -91,8 +91,9 @@ void integrate_1d_vl(DomainS *pD)
   int il=is-(nghost-1), iu=ie+(nghost-1);
 
   for (i=is-nghost; i<=ie+nghost; i++) {
-    Uhalf[i] = pG->U[ks][js][i];
-    W[i] = Cons_to_Prim(&(pG->U[ks][js][i]));
+    Uhalf[i] = UCELL(pG->U,ks,js,i);
+    U = UCELL(pG->U,ks,js,i);
+    W[i] = Cons_to_Prim(&U);
   }
 
 /*=== STEP 1: Compute first-order fluxes at t^{n} in x1-direction ============*/
@@ -142,9 +143,7 @@ void integrate_1d_vl(DomainS *pD)
 /*--- Step 1d ------------------------------------------------------------------
  * Compute flux in x1-direction */
 
-  for (i=il; i<=ie+nghost; i++) {
-    fluxes(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&x1Flux[i]);
-  }
+  fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,x1Flux,il,ie+nghost);
 
 /*=== STEPS 2-4: Not needed in 1D ===*/
 
@@ -189,7 +188,7 @@ void integrate_1d_vl(DomainS *pD)
       phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
       phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
 
-      Uhalf[i].M1 -= hdtodx1*pG->U[ks][js][i].d*(phir-phil);
+      Uhalf[i].M1 -= hdtodx1*UVAR(pG->U,ks,js,i,d)*(phir-phil);
       Uhalf[i].E -= hdtodx1*(x1Flux[i  ].d*(phic - phil) +
                              x1Flux[i+1].d*(phir - phic));
     }
@@ -303,10 +302,10 @@ void integrate_1d_vl(DomainS *pD)
   for (i=is; i<=ie+1; i++) {
     Ul[i] = Prim1D_to_Cons1D(&Wl_x1Face[i],&Bxi[i]);
     Ur[i] = Prim1D_to_Cons1D(&Wr_x1Face[i],&Bxi[i]);
-
-    fluxes(Ul[i],Ur[i],Wl_x1Face[i],Wr_x1Face[i],Bxi[i],&x1Flux[i]);
   }
 
+  fluxes_pencil(Ul,Ur,Wl_x1Face,Wr_x1Face,Bxi,x1Flux,is,ie+1);
+
 /*=== STEP 12: Not needed in 1D ===*/
         
 /*=== STEP 13: Add source terms for a full timestep using n+1/2 states =======*/
@@ -325,9 +324,9 @@ void integrate_1d_vl(DomainS *pD)
       phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
       phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
 
-      pG->U[ks][js][i].M1 -= dtodx1*Uhalf[i].d*(phir-phil);
+      UVAR(pG->U,ks,js,i,M1) -= dtodx1*Uhalf[i].d*(phir-phil);
 #ifndef BAROTROPIC
-      pG->U[ks][js][i].E -= dtodx1*(x1Flux[i  ].d*(phic - phil) +
+      UVAR(pG->U,ks,js,i,E) -= dtodx1*(x1Flux[i  ].d*(phic - phil) +
                                     x1Flux[i+1].d*(phir - phic));
 #endif
     }
@@ -340,23 +339,23 @@ void integrate_1d_vl(DomainS *pD)
  */
 
   for (i=is; i<=ie; i++) {
-    pG->U[ks][js][i].d  -= dtodx1*(x1Flux[i+1].d  - x1Flux[i].d );
-    pG->U[ks][js][i].M1 -= dtodx1*(x1Flux[i+1].Mx - x1Flux[i].Mx);
-    pG->U[ks][js][i].M2 -= dtodx1*(x1Flux[i+1].My - x1Flux[i].My);
-    pG->U[ks][js][i].M3 -= dtodx1*(x1Flux[i+1].Mz - x1Flux[i].Mz);
+    UVAR(pG->U,ks,js,i,d)  -= dtodx1*(x1Flux[i+1].d  - x1Flux[i].d );
+    UVAR(pG->U,ks,js,i,M1) -= dtodx1*(x1Flux[i+1].Mx - x1Flux[i].Mx);
+    UVAR(pG->U,ks,js,i,M2) -= dtodx1*(x1Flux[i+1].My - x1Flux[i].My);
+    UVAR(pG->U,ks,js,i,M3) -= dtodx1*(x1Flux[i+1].Mz - x1Flux[i].Mz);
 #ifndef BAROTROPIC
-    pG->U[ks][js][i].E  -= dtodx1*(x1Flux[i+1].E  - x1Flux[i].E );
+    UVAR(pG->U,ks,js,i,E)  -= dtodx1*(x1Flux[i+1].E  - x1Flux[i].E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][js][i].B2c -= dtodx1*(x1Flux[i+1].By - x1Flux[i].By);
-    pG->U[ks][js][i].B3c -= dtodx1*(x1Flux[i+1].Bz - x1Flux[i].Bz);
+    UVAR(pG->U,ks,js,i,B2c) -= dtodx1*(x1Flux[i+1].By - x1Flux[i].By);
+    UVAR(pG->U,ks,js,i,B3c) -= dtodx1*(x1Flux[i+1].Bz - x1Flux[i].Bz);
 /* For consistency, set B2i and B3i to cell-centered values.  */
-    pG->B2i[ks][js][i] = pG->U[ks][js][i].B2c;
-    pG->B3i[ks][js][i] = pG->U[ks][js][i].B3c;
+    pG->B2i[ks][js][i] = UVAR(pG->U,ks,js,i,B2c);
+    pG->B3i[ks][js][i] = UVAR(pG->U,ks,js,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
     for (n=0; n<NSCALARS; n++)
-      pG->U[ks][js][i].s[n] -= dtodx1*(x1Flux[i+1].s[n] - x1Flux[i].s[n]);
+      UVAR(pG->U,ks,js,i,s[n]) -= dtodx1*(x1Flux[i+1].s[n] - x1Flux[i].s[n]);
 #endif
   }
 
@@ -368,7 +367,8 @@ void integrate_1d_vl(DomainS *pD)
  * by using 1st order predictor fluxes */
         
   for (i=is; i<=ie; i++) {
-      Wcheck = check_Prim(&(pG->U[ks][js][i]));
+      U = UCELL(pG->U,ks,js,i);
+      Wcheck = check_Prim(&U);
       if (Wcheck.d < 0.0) {
         flag_cell = 1;
         BadCell.i = i;
@@ -422,7 +422,8 @@ void integrate_1d_vl(DomainS *pD)
   superl = 0;
   for (i=is; i<=ie; i++) {
     flag_cell=0;
-    Wcheck = check_Prim(&(pG->U[ks][js][i]));
+    U = UCELL(pG->U,ks,js,i);
+    Wcheck = check_Prim(&U);
     if (Wcheck.d < 0.0) {
       flag_cell = 1;
       negd++;
@@ -438,14 +439,16 @@ void integrate_1d_vl(DomainS *pD)
     }
     if (flag_cell != 0) {
       final++;
-      Wcheck = fix_vsq (&(pG->U[ks][js][i]));
+      U = UCELL(pG->U,ks,js,i);
+      Wcheck = fix_vsq (&U);
       U = Prim_to_Cons(&Wcheck);
-      pG->U[ks][js][i].d = U.d;
-      pG->U[ks][js][i].M1 = U.M1;
-      pG->U[ks][js][i].M2 = U.M2;
-      pG->U[ks][js][i].M3 = U.M3;
-      pG->U[ks][js][i].E = U.E;
-      Wcheck = check_Prim(&(pG->U[ks][js][i]));
+      UVAR(pG->U,ks,js,i,d) = U.d;
+      UVAR(pG->U,ks,js,i,M1) = U.M1;
+      UVAR(pG->U,ks,js,i,M2) = U.M2;
+      UVAR(pG->U,ks,js,i,M3) = U.M3;
+      UVAR(pG->U,ks,js,i,E) = U.E;
+      U = UCELL(pG->U,ks,js,i);
+      Wcheck = check_Prim(&U);
       Vsq = SQR(Wcheck.V1) + SQR(Wcheck.V2) + SQR(Wcheck.V3);
       if (Wcheck.d < 0.0 || Wcheck.P < 0.0 || Vsq > 1.0){
 	fail++;
@@ -647,54 +650,54 @@ static void FixCell(GridS *pG, Int3Vect indx)
 #endif /* BAROTROPIC */
         
   /* Use flux differences to correct bad cell */
-  pG->U[ks][js][indx.i].d  += dtodx1*(x1FD_ip1.d  - x1FD_i.d );
-  pG->U[ks][js][indx.i].M1 += dtodx1*(x1FD_ip1.Mx - x1FD_i.Mx);
-  pG->U[ks][js][indx.i].M2 += dtodx1*(x1FD_ip1.My - x1FD_i.My);
-  pG->U[ks][js][indx.i].M3 += dtodx1*(x1FD_ip1.Mz - x1FD_i.Mz);
+  UVAR(pG->U,ks,js,indx.i,d)  += dtodx1*(x1FD_ip1.d  - x1FD_i.d );
+  UVAR(pG->U,ks,js,indx.i,M1) += dtodx1*(x1FD_ip1.Mx - x1FD_i.Mx);
+  UVAR(pG->U,ks,js,indx.i,M2) += dtodx1*(x1FD_ip1.My - x1FD_i.My);
+  UVAR(pG->U,ks,js,indx.i,M3) += dtodx1*(x1FD_ip1.Mz - x1FD_i.Mz);
 #ifdef MHD
-  pG->U[ks][js][indx.i].B2c += dtodx1*(x1FD_ip1.By - x1FD_i.By);
-  pG->U[ks][js][indx.i].B3c += dtodx1*(x1FD_ip1.Bz - x1FD_i.Bz);
+  UVAR(pG->U,ks,js,indx.i,B2c) += dtodx1*(x1FD_ip1.By - x1FD_i.By);
+  UVAR(pG->U,ks,js,indx.i,B3c) += dtodx1*(x1FD_ip1.Bz - x1FD_i.Bz);
   /* For consistency, set B2i and B3i to cell-centered values.  */
-  pG->B2i[ks][js][indx.i] = pG->U[ks][js][indx.i].B2c;
-  pG->B3i[ks][js][indx.i] = pG->U[ks][js][indx.i].B3c;
+  pG->B2i[ks][js][indx.i] = UVAR(pG->U,ks,js,indx.i,B2c);
+  pG->B3i[ks][js][indx.i] = UVAR(pG->U,ks,js,indx.i,B3c);
 #endif
 #ifndef BAROTROPIC
-  pG->U[ks][js][indx.i].E  += dtodx1*(x1FD_ip1.E  - x1FD_i.E );
+  UVAR(pG->U,ks,js,indx.i,E)  += dtodx1*(x1FD_ip1.E  - x1FD_i.E );
 #endif /* BAROTROPIC */
         
         
   /* Use flux differences to correct bad cell neighbors at i-1 and i+1 */      
   if (indx.i > pG->is) {
-    pG->U[ks][js][indx.i-1].d  += dtodx1*(x1FD_i.d );
-    pG->U[ks][js][indx.i-1].M1 += dtodx1*(x1FD_i.Mx);
-    pG->U[ks][js][indx.i-1].M2 += dtodx1*(x1FD_i.My);
-    pG->U[ks][js][indx.i-1].M3 += dtodx1*(x1FD_i.Mz);
+    UVAR(pG->U,ks,js,indx.i-1,d)  += dtodx1*(x1FD_i.d );
+    UVAR(pG->U,ks,js,indx.i-1,M1) += dtodx1*(x1FD_i.Mx);
+    UVAR(pG->U,ks,js,indx.i-1,M2) += dtodx1*(x1FD_i.My);
+    UVAR(pG->U,ks,js,indx.i-1,M3) += dtodx1*(x1FD_i.Mz);
 #ifdef MHD
-    pG->U[ks][js][indx.i-1].B2c += dtodx1*(x1FD_i.By);
-    pG->U[ks][js][indx.i-1].B3c += dtodx1*(x1FD_i.Bz);
+    UVAR(pG->U,ks,js,indx.i-1,B2c) += dtodx1*(x1FD_i.By);
+    UVAR(pG->U,ks,js,indx.i-1,B3c) += dtodx1*(x1FD_i.Bz);
     /* For consistency, set B2i and B3i to cell-centered values.  */
-    pG->B2i[ks][js][indx.i-1] = pG->U[ks][js][indx.i-1].B2c;
-    pG->B3i[ks][js][indx.i-1] = pG->U[ks][js][indx.i-1].B3c;
+    pG->B2i[ks][js][indx.i-1] = UVAR(pG->U,ks,js,indx.i-1,B2c);
+    pG->B3i[ks][js][indx.i-1] = UVAR(pG->U,ks,js,indx.i-1,B3c);
 #endif
 #ifndef BAROTROPIC
-    pG->U[ks][js][indx.i-1].E  += dtodx1*(x1FD_i.E );
+    UVAR(pG->U,ks,js,indx.i-1,E)  += dtodx1*(x1FD_i.E );
 #endif /* BAROTROPIC */
   }
         
   if (indx.i < pG->ie) {
-    pG->U[ks][js][indx.i+1].d  -= dtodx1*(x1FD_ip1.d );
-    pG->U[ks][js][indx.i+1].M1 -= dtodx1*(x1FD_ip1.Mx);
-    pG->U[ks][js][indx.i+1].M2 -= dtodx1*(x1FD_ip1.My);
-    pG->U[ks][js][indx.i+1].M3 -= dtodx1*(x1FD_ip1.Mz);
+    UVAR(pG->U,ks,js,indx.i+1,d)  -= dtodx1*(x1FD_ip1.d );
+    UVAR(pG->U,ks,js,indx.i+1,M1) -= dtodx1*(x1FD_ip1.Mx);
+    UVAR(pG->U,ks,js,indx.i+1,M2) -= dtodx1*(x1FD_ip1.My);
+    UVAR(pG->U,ks,js,indx.i+1,M3) -= dtodx1*(x1FD_ip1.Mz);
 #ifdef MHD
-    pG->U[ks][js][indx.i+1].B2c -= dtodx1*(x1FD_ip1.By);
-    pG->U[ks][js][indx.i+1].B3c -= dtodx1*(x1FD_ip1.Bz);
+    UVAR(pG->U,ks,js,indx.i+1,B2c) -= dtodx1*(x1FD_ip1.By);
+    UVAR(pG->U,ks,js,indx.i+1,B3c) -= dtodx1*(x1FD_ip1.Bz);
     /* For consistency, set B2i and B3i to cell-centered values.  */
-    pG->B2i[ks][js][indx.i+1] = pG->U[ks][js][indx.i+1].B2c;
-    pG->B3i[ks][js][indx.i+1] = pG->U[ks][js][indx.i+1].B3c;
+    pG->B2i[ks][js][indx.i+1] = UVAR(pG->U,ks,js,indx.i+1,B2c);
+    pG->B3i[ks][js][indx.i+1] = UVAR(pG->U,ks,js,indx.i+1,B3c);
 #endif /* MHD */
 #ifndef BAROTROPIC
-    pG->U[ks][js][indx.i+1].E  -= dtodx1*(x1FD_ip1.E );
+    UVAR(pG->U,ks,js,indx.i+1,E)  -= dtodx1*(x1FD_ip1.E );
 #endif /* BAROTROPIC */
   }
         
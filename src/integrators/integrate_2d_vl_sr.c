@@ -68,7 +68,7 @@ static Real **emf3=NULL, **emf3_cc=NULL;
 /* 1D scratch vectors used by lr_states and flux functions */
 static Real *Bxc=NULL, *Bxi=NULL;
 static Prim1DS *W1d=NULL, *Wl=NULL, *Wr=NULL;
-static Cons1DS *U1d=NULL, *Ul=NULL, *Ur=NULL;
+static Cons1DS *U1d=NULL, *Ul=NULL, *Ur=NULL, *F1d=NULL;
 
 /* primitive variables at t^{n} */
 static PrimS **W=NULL;
@@ -106,6 +106,7 @@ static void FixCell(GridS *pG, Int3Vect);
 void integrate_2d_vl(DomainS *pD)
 {
   GridS *pG=(pD->Grid);
+  ConsS U;
   Real dtodx1=pG->dt/pG->dx1, dtodx2=pG->dt/pG->dx2;
   Real hdtodx1 = 0.5*dtodx1, hdtodx2 = 0.5*dtodx2;
   int i, is = pG->is, ie = pG->ie;
@@ -143,15 +144,16 @@ void integrate_2d_vl(DomainS *pD)
 
   for (j=js-nghost; j<=je+nghost; j++) {
     for (i=is-nghost; i<=ie+nghost; i++) {
-      Uhalf[j][i] = pG->U[ks][j][i];
-      W[j][i] = Cons_to_Prim(&(pG->U[ks][j][i]));
+      Uhalf[j][i] = UCELL(pG->U,ks,j,i);
+      U = UCELL(pG->U,ks,j,i);
+      W[j][i] = Cons_to_Prim(&U);
 #ifdef MHD
       B1_x1Face[j][i] = pG->B1i[ks][j][i]; 
       B2_x2Face[j][i] = pG->B2i[ks][j][i]; 
 #endif /* MHD */
 #ifdef USE_ENTROPY_FIX
       S[j][i] = W[j][i].P * pow(W[j][i].d,1.0-Gamma);
-      S[j][i]*= pG->U[ks][j][i].d / W[j][i].d;
+      S[j][i]*= UVAR(pG->U,ks,j,i,d) / W[j][i].d;
       Shalf[j][i] = S[j][i];
 #endif
     }
@@ -200,12 +202,12 @@ void integrate_2d_vl(DomainS *pD)
 /*--- Step 1d ------------------------------------------------------------------
  * Compute flux in x1-direction */
 
-    for (i=il; i<=ie+nghost; i++) {
-      fluxes(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&x1Flux[j][i]);
+    fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,x1Flux[j],il,ie+nghost);
 #ifdef USE_ENTROPY_FIX
+    for (i=il; i<=ie+nghost; i++) {
       entropy_flux(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&x1FluxS[j][i]);
-#endif
     }
+#endif
   }
 
 /*=== STEP 2: Compute first-order fluxes at t^{n} in x2-direction ============*/
@@ -252,12 +254,13 @@ void integrate_2d_vl(DomainS *pD)
 /*--- Step 2d ------------------------------------------------------------------
  * Compute flux in x2-direction */
 
-    for (j=jl; j<=je+nghost; j++) {
-      fluxes(Ul[j],Ur[j],Wl[j],Wr[j],Bxi[j],&x2Flux[j][i]);
+    fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,F1d,jl,je+nghost);
+    for (j=jl; j<=je+nghost; j++) x2Flux[j][i] = F1d[j];
 #ifdef USE_ENTROPY_FIX
+    for (j=jl; j<=je+nghost; j++) {
       entropy_flux(Ul[j],Ur[j],Wl[j],Wr[j],Bxi[j],&x2FluxS[j][i]);
-#endif
     }
+#endif
   }
 
 /*=== STEP 3: Not needed in 2D ===*/
@@ -427,7 +430,7 @@ void integrate_2d_vl(DomainS *pD)
         phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
         phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
 
-        Uhalf[j][i].M1 -= hdtodx1*(phir-phil)*pG->U[ks][j][i].d;
+        Uhalf[j][i].M1 -= hdtodx1*(phir-phil)*UVAR(pG->U,ks,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[j][i].E -= hdtodx1*(x1Flux[j][i  ].d*(phic - phil)
                            + x1Flux[j][i+1].d*(phir - phic));
@@ -435,7 +438,7 @@ void integrate_2d_vl(DomainS *pD)
         phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
 
-        Uhalf[j][i].M2 -= hdtodx2*(phir-phil)*pG->U[ks][j][i].d;
+        Uhalf[j][i].M2 -= hdtodx2*(phir-phil)*UVAR(pG->U,ks,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[j][i].E -= hdtodx2*(x2Flux[j  ][i].d*(phic - phil)
                                 + x2Flux[j+1][i].d*(phir - phic));
@@ -674,19 +677,24 @@ void integrate_2d_vl(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
       Bx = B1_x1Face[j][i];
+      Bxi[i] = Bx;
 #endif
       Ul[i] = Prim1D_to_Cons1D(&Wl_x1Face[j][i],&Bx);
       Ur[i] = Prim1D_to_Cons1D(&Wr_x1Face[j][i],&Bx);
-
-      fluxes(Ul[i],Ur[i],Wl_x1Face[j][i],Wr_x1Face[j][i],Bx,&x1Flux[j][i]);
-
 #ifdef USE_ENTROPY_FIX
       entropy_flux(Ul[i],          Ur[i],
 		   Wl_x1Face[j][i],Wr_x1Face[j][i],
 		   Bx,             &x1FluxS[j][i]);
 #endif
-
+#ifdef H_CORRECTION
+      fluxes(Ul[i],Ur[i],Wl_x1Face[j][i],Wr_x1Face[j][i],Bx,&x1Flux[j][i]);
+#endif
+    }
+#ifndef H_CORRECTION
+    fluxes_pencil(Ul,Ur,Wl_x1Face[j],Wr_x1Face[j],Bxi,x1Flux[j],is,ie+1);
+#endif
 #ifdef FIRST_ORDER_FLUX_CORRECTION
+    for (i=is; i<=ie+1; i++) {
 /* revert to predictor flux if this flux Nan'ed */
       if ((x1Flux[j][i].d  != x1Flux[j][i].d)  ||
 #ifndef BAROTROPIC
@@ -702,9 +710,8 @@ void integrate_2d_vl(DomainS *pD)
         x1Flux[j][i] = x1FluxP[j][i];
         NaNFlux++;
       }
-#endif
-
     }
+#endif
   }
 
 /*--- Step 11c -----------------------------------------------------------------
@@ -721,19 +728,24 @@ void integrate_2d_vl(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
       Bx = B2_x2Face[j][i];
+      Bxi[i] = Bx;
 #endif
       Ul[i] = Prim1D_to_Cons1D(&Wl_x2Face[j][i],&Bx);
       Ur[i] = Prim1D_to_Cons1D(&Wr_x2Face[j][i],&Bx);
-
-      fluxes(Ul[i],Ur[i],Wl_x2Face[j][i],Wr_x2Face[j][i],Bx,&x2Flux[j][i]);
-
 #ifdef USE_ENTROPY_FIX
       entropy_flux(Ul[i],          Ur[i],
 		   Wl_x2Face[j][i],Wr_x2Face[j][i],
 		   Bx,             &x2FluxS[j][i]);
 #endif
-
+#ifdef H_CORRECTION
+      fluxes(Ul[i],Ur[i],Wl_x2Face[j][i],Wr_x2Face[j][i],Bx,&x2Flux[j][i]);
+#endif
+    }
+#ifndef H_CORRECTION
+    fluxes_pencil(Ul,Ur,Wl_x2Face[j],Wr_x2Face[j],Bxi,x2Flux[j],is-1,ie+1);
+#endif
 #ifdef FIRST_ORDER_FLUX_CORRECTION
+    for (i=is-1; i<=ie+1; i++) {
 /* revert to predictor flux if this flux NaN'ed */
       if ((x2Flux[j][i].d  != x2Flux[j][i].d)  ||
 #ifndef BAROTROPIC
@@ -749,9 +761,8 @@ void integrate_2d_vl(DomainS *pD)
         x2Flux[j][i] = x2FluxP[j][i];
         NaNFlux++;
       }
-#endif
-
     }
+#endif
   }
 
 #ifdef FIRST_ORDER_FLUX_CORRECTION
@@ -803,8 +814,8 @@ void integrate_2d_vl(DomainS *pD)
 
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pG->U[ks][j][i].B1c = 0.5*(pG->B1i[ks][j][i]+pG->B1i[ks][j][i+1]);
-      pG->U[ks][j][i].B2c = 0.5*(pG->B2i[ks][j][i]+pG->B2i[ks][j+1][i]);
+      UVAR(pG->U,ks,j,i,B1c) = 0.5*(pG->B1i[ks][j][i]+pG->B1i[ks][j][i+1]);
+      UVAR(pG->U,ks,j,i,B2c) = 0.5*(pG->B2i[ks][j][i]+pG->B2i[ks][j+1][i]);
     }
   }
 #endif /* MHD */
@@ -826,17 +837,17 @@ void integrate_2d_vl(DomainS *pD)
         phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
         phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
 
-        pG->U[ks][j][i].M1 -= dtodx1*(phir-phil)*Uhalf[j][i].d;
+        UVAR(pG->U,ks,j,i,M1) -= dtodx1*(phir-phil)*Uhalf[j][i].d;
 #ifndef BAROTROPIC
-        pG->U[ks][j][i].E -= dtodx1*(x1Flux[j][i  ].d*(phic - phil)
+        UVAR(pG->U,ks,j,i,E) -= dtodx1*(x1Flux[j][i  ].d*(phic - phil)
                                    + x1Flux[j][i+1].d*(phir - phic));
 #endif
         phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
 
-        pG->U[ks][j][i].M2 -= dtodx2*(phir-phil)*Uhalf[j][i].d;
+        UVAR(pG->U,ks,j,i,M2) -= dtodx2*(phir-phil)*Uhalf[j][i].d;
 #ifndef BAROTROPIC
-        pG->U[ks][j][i].E -= dtodx2*(x2Flux[j  ][i].d*(phic - phil)
+        UVAR(pG->U,ks,j,i,E) -= dtodx2*(x2Flux[j  ][i].d*(phic - phil)
                                    + x2Flux[j+1][i].d*(phir - phic));
 #endif
       }
@@ -851,19 +862,19 @@ void integrate_2d_vl(DomainS *pD)
 
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pG->U[ks][j][i].d   -= dtodx1*(x1Flux[j][i+1].d  - x1Flux[j][i].d );
-      pG->U[ks][j][i].M1  -= dtodx1*(x1Flux[j][i+1].Mx - x1Flux[j][i].Mx);
-      pG->U[ks][j][i].M2  -= dtodx1*(x1Flux[j][i+1].My - x1Flux[j][i].My);
-      pG->U[ks][j][i].M3  -= dtodx1*(x1Flux[j][i+1].Mz - x1Flux[j][i].Mz);
+      UVAR(pG->U,ks,j,i,d)   -= dtodx1*(x1Flux[j][i+1].d  - x1Flux[j][i].d );
+      UVAR(pG->U,ks,j,i,M1)  -= dtodx1*(x1Flux[j][i+1].Mx - x1Flux[j][i].Mx);
+      UVAR(pG->U,ks,j,i,M2)  -= dtodx1*(x1Flux[j][i+1].My - x1Flux[j][i].My);
+      UVAR(pG->U,ks,j,i,M3)  -= dtodx1*(x1Flux[j][i+1].Mz - x1Flux[j][i].Mz);
 #ifndef BAROTROPIC
-      pG->U[ks][j][i].E   -= dtodx1*(x1Flux[j][i+1].E  - x1Flux[j][i].E );
+      UVAR(pG->U,ks,j,i,E)   -= dtodx1*(x1Flux[j][i+1].E  - x1Flux[j][i].E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-      pG->U[ks][j][i].B3c -= dtodx1*(x1Flux[j][i+1].Bz - x1Flux[j][i].Bz);
+      UVAR(pG->U,ks,j,i,B3c) -= dtodx1*(x1Flux[j][i+1].Bz - x1Flux[j][i].Bz);
 #endif /* MHD */
 #if (NSCALARS > 0)
       for (n=0; n<NSCALARS; n++)
-        pG->U[ks][j][i].s[n] -= dtodx1*(x1Flux[j][i+1].s[n]
+        UVAR(pG->U,ks,j,i,s[n]) -= dtodx1*(x1Flux[j][i+1].s[n]
                                       - x1Flux[j][i  ].s[n]);
 #endif
 #ifdef USE_ENTROPY_FIX
@@ -878,19 +889,19 @@ void integrate_2d_vl(DomainS *pD)
 
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pG->U[ks][j][i].d   -= dtodx2*(x2Flux[j+1][i].d  - x2Flux[j][i].d );
-      pG->U[ks][j][i].M1  -= dtodx2*(x2Flux[j+1][i].Mz - x2Flux[j][i].Mz);
-      pG->U[ks][j][i].M2  -= dtodx2*(x2Flux[j+1][i].Mx - x2Flux[j][i].Mx);
-      pG->U[ks][j][i].M3  -= dtodx2*(x2Flux[j+1][i].My - x2Flux[j][i].My);
+      UVAR(pG->U,ks,j,i,d)   -= dtodx2*(x2Flux[j+1][i].d  - x2Flux[j][i].d );
+      UVAR(pG->U,ks,j,i,M1)  -= dtodx2*(x2Flux[j+1][i].Mz - x2Flux[j][i].Mz);
+      UVAR(pG->U,ks,j,i,M2)  -= dtodx2*(x2Flux[j+1][i].Mx - x2Flux[j][i].Mx);
+      UVAR(pG->U,ks,j,i,M3)  -= dtodx2*(x2Flux[j+1][i].My - x2Flux[j][i].My);
 #ifndef BAROTROPIC
-      pG->U[ks][j][i].E   -= dtodx2*(x2Flux[j+1][i].E  - x2Flux[j][i].E );
+      UVAR(pG->U,ks,j,i,E)   -= dtodx2*(x2Flux[j+1][i].E  - x2Flux[j][i].E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-      pG->U[ks][j][i].B3c -= dtodx2*(x2Flux[j+1][i].By - x2Flux[j][i].By);
+      UVAR(pG->U,ks,j,i,B3c) -= dtodx2*(x2Flux[j+1][i].By - x2Flux[j][i].By);
 #endif /* MHD */
 #if (NSCALARS > 0)
       for (n=0; n<NSCALARS; n++)
-        pG->U[ks][j][i].s[n] -= dtodx2*(x2Flux[j+1][i].s[n]
+        UVAR(pG->U,ks,j,i,s[n]) -= dtodx2*(x2Flux[j+1][i].s[n]
                                       - x2Flux[j  ][i].s[n]);
 #endif
 #ifdef USE_ENTROPY_FIX
@@ -909,7 +920,8 @@ void integrate_2d_vl(DomainS *pD)
 
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      Wcheck = check_Prim(&(pG->U[ks][j][i]));
+      Ucheck = UCELL(pG->U,ks,j,i);
+      Wcheck = check_Prim(&Ucheck);
       if (Wcheck.d < 0.0) {
         flag_cell = 1;
         BadCell.i = i;
@@ -965,7 +977,8 @@ void integrate_2d_vl(DomainS *pD)
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
       flag_cell=0;
-      Wcheck = check_Prim(&(pG->U[ks][j][i]));
+      Ucheck = UCELL(pG->U,ks,j,i);
+      Wcheck = check_Prim(&Ucheck);
       if (Wcheck.d < 0.0) {
         flag_cell = 1;
         negd++;
@@ -982,30 +995,33 @@ void integrate_2d_vl(DomainS *pD)
 #ifdef USE_ENTROPY_FIX
       if (flag_cell != 0) {
 	entropy++;
-	Wcheck = entropy_fix (&(pG->U[ks][j][i]),&(S[j][i]));
+	Ucheck = UCELL(pG->U,ks,j,i);
+	Wcheck = entropy_fix (&Ucheck,&(S[j][i]));
 	Ucheck = Prim_to_Cons(&Wcheck);
 	Wcheck = check_Prim(&Ucheck);
 	Vsq = SQR(Wcheck.V1) + SQR(Wcheck.V2) + SQR(Wcheck.V3);
 	if (Wcheck.d > 0.0 && Wcheck.P > 0.0 && Vsq < 1.0){
-          pG->U[ks][j][i].d = Ucheck.d;
-          pG->U[ks][j][i].M1 = Ucheck.M1;
-          pG->U[ks][j][i].M2 = Ucheck.M2;
-          pG->U[ks][j][i].M3 = Ucheck.M3;
-          pG->U[ks][j][i].E = Ucheck.E;
+          UVAR(pG->U,ks,j,i,d) = Ucheck.d;
+          UVAR(pG->U,ks,j,i,M1) = Ucheck.M1;
+          UVAR(pG->U,ks,j,i,M2) = Ucheck.M2;
+          UVAR(pG->U,ks,j,i,M3) = Ucheck.M3;
+          UVAR(pG->U,ks,j,i,E) = Ucheck.E;
 	  flag_cell = 0;
 	}
       }
 #endif
       if (flag_cell != 0) {
 	final++;
-	Wcheck = fix_vsq (&(pG->U[ks][j][i]));
+	Ucheck = UCELL(pG->U,ks,j,i);
+	Wcheck = fix_vsq (&Ucheck);
 	Ucheck = Prim_to_Cons(&Wcheck);
-	pG->U[ks][j][i].d = Ucheck.d;
-	pG->U[ks][j][i].M1 = Ucheck.M1;
-	pG->U[ks][j][i].M2 = Ucheck.M2;
-	pG->U[ks][j][i].M3 = Ucheck.M3;
-	pG->U[ks][j][i].E = Ucheck.E;
-	Wcheck = check_Prim(&(pG->U[ks][j][i]));
+	UVAR(pG->U,ks,j,i,d) = Ucheck.d;
+	UVAR(pG->U,ks,j,i,M1) = Ucheck.M1;
+	UVAR(pG->U,ks,j,i,M2) = Ucheck.M2;
+	UVAR(pG->U,ks,j,i,M3) = Ucheck.M3;
+	UVAR(pG->U,ks,j,i,E) = Ucheck.E;
+	Ucheck = UCELL(pG->U,ks,j,i);
+	Wcheck = check_Prim(&Ucheck);
 	Vsq = SQR(Wcheck.V1) + SQR(Wcheck.V2) + SQR(Wcheck.V3);
 	if (Wcheck.d < 0.0 || Wcheck.P < 0.0 || Vsq > 1.0){
 	  fail++;
@@ -1239,6 +1255,7 @@ void integrate_init_2d(MeshS *pM)
   if ((U1d= (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((Ul = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((Ur = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
+  if ((F1d= (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((W1d= (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
   if ((Wl = (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
   if ((Wr = (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
@@ -1319,6 +1336,7 @@ void integrate_destruct_2d(void)
   if (U1d != NULL) free(U1d);
   if (Ul  != NULL) free(Ul);
   if (Ur  != NULL) free(Ur);
+  if (F1d != NULL) free(F1d);
   if (W1d != NULL) free(W1d);
   if (Wl  != NULL) free(Wl);
   if (Wr  != NULL) free(Wr);
@@ -1517,29 +1535,29 @@ static void FixCell(GridS *pG, Int3Vect ix)
 
 /* Use flux differences to correct bad cell-centered quantities */
 
-  pG->U[ks][ix.j][ix.i].d  += dtodx1*(x1FD_ip1.d  - x1FD_i.d );
-  pG->U[ks][ix.j][ix.i].M1 += dtodx1*(x1FD_ip1.Mx - x1FD_i.Mx);
-  pG->U[ks][ix.j][ix.i].M2 += dtodx1*(x1FD_ip1.My - x1FD_i.My);
-  pG->U[ks][ix.j][ix.i].M3 += dtodx1*(x1FD_ip1.Mz - x1FD_i.Mz);
+  UVAR(pG->U,ks,ix.j,ix.i,d)  += dtodx1*(x1FD_ip1.d  - x1FD_i.d );
+  UVAR(pG->U,ks,ix.j,ix.i,M1) += dtodx1*(x1FD_ip1.Mx - x1FD_i.Mx);
+  UVAR(pG->U,ks,ix.j,ix.i,M2) += dtodx1*(x1FD_ip1.My - x1FD_i.My);
+  UVAR(pG->U,ks,ix.j,ix.i,M3) += dtodx1*(x1FD_ip1.Mz - x1FD_i.Mz);
 #ifndef BAROTROPIC
-  pG->U[ks][ix.j][ix.i].E  += dtodx1*(x1FD_ip1.E  - x1FD_i.E );
+  UVAR(pG->U,ks,ix.j,ix.i,E)  += dtodx1*(x1FD_ip1.E  - x1FD_i.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-  pG->U[ks][ix.j][ix.i].B3c += dtodx1*(x1FD_ip1.Bz - x1FD_i.Bz);
+  UVAR(pG->U,ks,ix.j,ix.i,B3c) += dtodx1*(x1FD_ip1.Bz - x1FD_i.Bz);
 #endif /* MHD */
   /*#ifdef USE_ENTROPY_FIX
   S[ix.j][ix.i]  += dtodx1*(x1SFD_ip1  - x1SFD_i );
   #endif*/
 
-  pG->U[ks][ix.j][ix.i].d  += dtodx2*(x2FD_jp1.d  - x2FD_j.d );
-  pG->U[ks][ix.j][ix.i].M1 += dtodx2*(x2FD_jp1.Mz - x2FD_j.Mz);
-  pG->U[ks][ix.j][ix.i].M2 += dtodx2*(x2FD_jp1.Mx - x2FD_j.Mx);
-  pG->U[ks][ix.j][ix.i].M3 += dtodx2*(x2FD_jp1.My - x2FD_j.My);
+  UVAR(pG->U,ks,ix.j,ix.i,d)  += dtodx2*(x2FD_jp1.d  - x2FD_j.d );
+  UVAR(pG->U,ks,ix.j,ix.i,M1) += dtodx2*(x2FD_jp1.Mz - x2FD_j.Mz);
+  UVAR(pG->U,ks,ix.j,ix.i,M2) += dtodx2*(x2FD_jp1.Mx - x2FD_j.Mx);
+  UVAR(pG->U,ks,ix.j,ix.i,M3) += dtodx2*(x2FD_jp1.My - x2FD_j.My);
 #ifndef BAROTROPIC
-  pG->U[ks][ix.j][ix.i].E  += dtodx2*(x2FD_jp1.E  - x2FD_j.E );
+  UVAR(pG->U,ks,ix.j,ix.i,E)  += dtodx2*(x2FD_jp1.E  - x2FD_j.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-  pG->U[ks][ix.j][ix.i].B3c += dtodx2*(x2FD_jp1.By - x2FD_j.By);
+  UVAR(pG->U,ks,ix.j,ix.i,B3c) += dtodx2*(x2FD_jp1.By - x2FD_j.By);
 #endif /* MHD */
   /*#ifdef USE_ENTROPY_FIX
   S[ix.j][ix.i]  += dtodx2*(x2SFD_jp1  - x2SFD_j );
@@ -1548,15 +1566,15 @@ static void FixCell(GridS *pG, Int3Vect ix)
 /* Use flux differences to correct cell-centered values at i-1 and i+1 */
 
   if (ix.i > pG->is) {
-    pG->U[ks][ix.j][ix.i-1].d  += dtodx1*(x1FD_i.d );
-    pG->U[ks][ix.j][ix.i-1].M1 += dtodx1*(x1FD_i.Mx);
-    pG->U[ks][ix.j][ix.i-1].M2 += dtodx1*(x1FD_i.My);
-    pG->U[ks][ix.j][ix.i-1].M3 += dtodx1*(x1FD_i.Mz);
+    UVAR(pG->U,ks,ix.j,ix.i-1,d)  += dtodx1*(x1FD_i.d );
+    UVAR(pG->U,ks,ix.j,ix.i-1,M1) += dtodx1*(x1FD_i.Mx);
+    UVAR(pG->U,ks,ix.j,ix.i-1,M2) += dtodx1*(x1FD_i.My);
+    UVAR(pG->U,ks,ix.j,ix.i-1,M3) += dtodx1*(x1FD_i.Mz);
 #ifndef BAROTROPIC
-    pG->U[ks][ix.j][ix.i-1].E  += dtodx1*(x1FD_i.E );
+    UVAR(pG->U,ks,ix.j,ix.i-1,E)  += dtodx1*(x1FD_i.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][ix.j][ix.i-1].B3c += dtodx1*(x1FD_i.Bz);
+    UVAR(pG->U,ks,ix.j,ix.i-1,B3c) += dtodx1*(x1FD_i.Bz);
 #endif /* MHD */
     /*#ifdef USE_ENTROPY_FIX
     S[ix.j][ix.i-1]  += dtodx1*(x1SFD_i );
@@ -1564,15 +1582,15 @@ static void FixCell(GridS *pG, Int3Vect ix)
   }
 
   if (ix.i < pG->ie) {
-    pG->U[ks][ix.j][ix.i+1].d  -= dtodx1*(x1FD_ip1.d );
-    pG->U[ks][ix.j][ix.i+1].M1 -= dtodx1*(x1FD_ip1.Mx);
-    pG->U[ks][ix.j][ix.i+1].M2 -= dtodx1*(x1FD_ip1.My);
-    pG->U[ks][ix.j][ix.i+1].M3 -= dtodx1*(x1FD_ip1.Mz);
+    UVAR(pG->U,ks,ix.j,ix.i+1,d)  -= dtodx1*(x1FD_ip1.d );
+    UVAR(pG->U,ks,ix.j,ix.i+1,M1) -= dtodx1*(x1FD_ip1.Mx);
+    UVAR(pG->U,ks,ix.j,ix.i+1,M2) -= dtodx1*(x1FD_ip1.My);
+    UVAR(pG->U,ks,ix.j,ix.i+1,M3) -= dtodx1*(x1FD_ip1.Mz);
 #ifndef BAROTROPIC
-    pG->U[ks][ix.j][ix.i+1].E  -= dtodx1*(x1FD_ip1.E );
+    UVAR(pG->U,ks,ix.j,ix.i+1,E)  -= dtodx1*(x1FD_ip1.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][ix.j][ix.i+1].B3c -= dtodx1*(x1FD_ip1.Bz);
+    UVAR(pG->U,ks,ix.j,ix.i+1,B3c) -= dtodx1*(x1FD_ip1.Bz);
 #endif /* MHD */
     /*#ifdef USE_ENTROPY_FIX
     S[ix.j][ix.i+1]  -= dtodx1*(x1SFD_ip1 );
@@ -1582,15 +1600,15 @@ static void FixCell(GridS *pG, Int3Vect ix)
 /* Use flux differences to correct cell-centered values at j-1 and j+1 */
 
   if (ix.j > pG->js) {
-    pG->U[ks][ix.j-1][ix.i].d  += dtodx2*(x2FD_j.d );
-    pG->U[ks][ix.j-1][ix.i].M1 += dtodx2*(x2FD_j.Mz);
-    pG->U[ks][ix.j-1][ix.i].M2 += dtodx2*(x2FD_j.Mx);
-    pG->U[ks][ix.j-1][ix.i].M3 += dtodx2*(x2FD_j.My);
+    UVAR(pG->U,ks,ix.j-1,ix.i,d)  += dtodx2*(x2FD_j.d );
+    UVAR(pG->U,ks,ix.j-1,ix.i,M1) += dtodx2*(x2FD_j.Mz);
+    UVAR(pG->U,ks,ix.j-1,ix.i,M2) += dtodx2*(x2FD_j.Mx);
+    UVAR(pG->U,ks,ix.j-1,ix.i,M3) += dtodx2*(x2FD_j.My);
 #ifndef BAROTROPIC
-    pG->U[ks][ix.j-1][ix.i].E  += dtodx2*(x2FD_j.E );
+    UVAR(pG->U,ks,ix.j-1,ix.i,E)  += dtodx2*(x2FD_j.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][ix.j-1][ix.i].B3c += dtodx2*(x2FD_j.By);
+    UVAR(pG->U,ks,ix.j-1,ix.i,B3c) += dtodx2*(x2FD_j.By);
 #endif /* MHD */
     /*#ifdef USE_ENTROPY_FIX
    S[ix.j-1][ix.i]  += dtodx2*(x2SFD_j );
@@ -1598,15 +1616,15 @@ static void FixCell(GridS *pG, Int3Vect ix)
   }
 
   if (ix.j < pG->je) {
-    pG->U[ks][ix.j+1][ix.i].d  -= dtodx2*(x2FD_jp1.d );
-    pG->U[ks][ix.j+1][ix.i].M1 -= dtodx2*(x2FD_jp1.Mz);
-    pG->U[ks][ix.j+1][ix.i].M2 -= dtodx2*(x2FD_jp1.Mx);
-    pG->U[ks][ix.j+1][ix.i].M3 -= dtodx2*(x2FD_jp1.My);
+    UVAR(pG->U,ks,ix.j+1,ix.i,d)  -= dtodx2*(x2FD_jp1.d );
+    UVAR(pG->U,ks,ix.j+1,ix.i,M1) -= dtodx2*(x2FD_jp1.Mz);
+    UVAR(pG->U,ks,ix.j+1,ix.i,M2) -= dtodx2*(x2FD_jp1.Mx);
+    UVAR(pG->U,ks,ix.j+1,ix.i,M3) -= dtodx2*(x2FD_jp1.My);
 #ifndef BAROTROPIC
-    pG->U[ks][ix.j+1][ix.i].E  -= dtodx2*(x2FD_jp1.E );
+    UVAR(pG->U,ks,ix.j+1,ix.i,E)  -= dtodx2*(x2FD_jp1.E );
 #endif /* BAROTROPIC */
 #ifdef MHD
-    pG->U[ks][ix.j+1][ix.i].B3c -= dtodx2*(x2FD_jp1.By);
+    UVAR(pG->U,ks,ix.j+1,ix.i,B3c) -= dtodx2*(x2FD_jp1.By);
 #endif /* MHD */
     /*#ifdef USE_ENTROPY_FIX
     S[ix.j+1][ix.i]  -= dtodx2*(x2SFD_jp1 );
@@ -1642,8 +1660,8 @@ static void FixCell(GridS *pG, Int3Vect ix)
 /* compute new cell-centered fields */
   for (j=(ix.j-1); j<=(ix.j+1); j++) {
   for (i=(ix.i-1); i<=(ix.i+1); i++) {
-    pG->U[ks][j][i].B1c = 0.5*(pG->B1i[ks][j][i] + pG->B1i[ks][j][i+1]);
-    pG->U[ks][j][i].B2c = 0.5*(pG->B2i[ks][j][i] + pG->B2i[ks][j+1][i]);
+    UVAR(pG->U,ks,j,i,B1c) = 0.5*(pG->B1i[ks][j][i] + pG->B1i[ks][j][i+1]);
+    UVAR(pG->U,ks,j,i,B2c) = 0.5*(pG->B2i[ks][j][i] + pG->B2i[ks][j+1][i]);
   }}
 #endif /* MHD */
 
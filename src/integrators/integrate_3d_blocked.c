@@ -0,0 +1,856 @@
+#include "../copyright.h"
+/*============================================================================*/
+/*! \file integrate_3d_blocked.c
+ *  \brief Drives the 3D CTU or VL integrator over blocks of k-planes, so
+ *   that its scratch arrays only have to span one block rather than the
+ *   whole Grid, or over the interior and shell of the Grid, so that the
+ *   interior can be updated while boundary values are exchanged.
+ *
+ * PURPOSE: Drives the 3D CTU or VL integrator over blocks of k-planes.  The
+ *   3D integrators need 50-100 scratch arrays of the size of the Grid (see
+ *   the header of integrate_3d_ctu.c), which limits the number of cells that
+ *   fit on a node and streams the whole Grid through memory in every sweep.
+ *   With <integrator>kblock=nk > 0 the Grid is instead updated nk k-planes
+ *   at a time: the integrator is called on a "view" of the Grid consisting
+ *   of the nk planes plus nghost ghost planes on either side, so its scratch
+ *   arrays are allocated for nk+2*nghost planes only, and each block stays
+ *   in cache between the sweeps of the integrator.
+ *
+ *   Since the blocks are updated in place one after the other, the ghost
+ *   planes below block k0..k1 have already been advanced by the previous
+ *   block.  Their old values are kept in ring buffers of k-planes: before a
+ *   block is integrated, its planes (and the x3-face above it) are copied
+ *   into the rings, and the view points to these copies for all planes
+ *   below k0.  The x3-face at k1+1, which is updated again by the next
+ *   block, is also taken from the ring so its first update is discarded.
+ *   Results are bitwise identical to the unblocked integrator.
+ *
+ *   The cost is that the predictor steps are recomputed on the 2*nghost
+ *   ghost planes of every block, so nk should not be much smaller than
+ *   about 4*nghost.
+ *
+ *   Not compatible with shearing boxes, SMR, particles, special relativity,
+ *   or first-order flux correction with the VL integrator, all of which
+ *   touch cells outside the block being integrated.
+ *
+ *   The same views are used to overlap the update with the exchange of
+ *   boundary values.  With <job>overlap_bvals=1 the Grid is split into an
+ *   interior box, at least nghost cells from every edge, and a shell of six
+ *   boxes of thickness nghost.  The interior needs no ghost zones, so main()
+ *   calls integrate_3d_interior() between bvals_mhd_start() and
+ *   bvals_mhd_finish(), and integrate_3d_shell() after the exchange.  The
+ *   shell boxes are integrated on copies of U and B (taken before the
+ *   interior is updated in place, with the ghost zones added after the
+ *   exchange), and their active cells copied back.  Faces shared between
+ *   boxes are written by both, with identical values.  Results are again
+ *   bitwise identical to the integrator on the whole Grid.  The cost is that
+ *   the predictor steps are recomputed on the ghost zones of all seven boxes,
+ *   which adds 15-30% to the integration time of 128^3-64^3 Grids, so the
+ *   split only pays when waiting for the exchange takes longer than that.
+ *   Needs a single Domain, Grids with more than 2*nghost cells in each
+ *   direction, and cannot be combined with kblock.
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - integrate_3d_blocked()
+ * - integrate_3d_kblock()
+ * - integrate_init_3d_blocked()
+ * - integrate_destruct_3d_blocked()
+ * - integrate_3d_interior()
+ * - integrate_3d_shell()
+ * - integrate_3d_overlap()
+ * - integrate_init_3d_overlap()
+ * - integrate_destruct_3d_overlap() */
+/*============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../defs.h"
+#include "../athena.h"
+#include "../globals.h"
+#include "prototypes.h"
+#include "../prototypes.h"
+
+/* number of k-planes per block (0 if blocking is off), size of rings */
+static int kblock=0, nring=0;
+
+/* ring buffers holding the old values of already updated planes */
+#ifdef CONS_SOA
+static ConsArrS Uring;
+#else
+static ConsS ***Uring=NULL;
+#endif
+#ifdef MHD
+static GReal ***B1ring=NULL, ***B2ring=NULL, ***B3ring=NULL;
+#endif
+
+/* arrays of k-plane pointers making up the view of one block */
+#ifdef CONS_SOA
+static ConsArrS Uview;
+#else
+static ConsS ***Uview=NULL;
+#endif
+#ifdef MHD
+static GReal ***B1view=NULL, ***B2view=NULL, ***B3view=NULL;
+#endif
+
+/* Boxes of the interior/shell split: box 0 is the interior, boxes 1-6 the
+ * shell (x3-faces, then x2-faces, then x1-faces).  NOVVIEW is the largest
+ * number of Grid arrays a box can view: U (NCONS with CONS_SOA), B1i, B2i,
+ * B3i, W, Phi, Phi_old and three mass fluxes. */
+#define NOVBOX 7
+#define NOVVIEW (NCONS+9)
+
+typedef struct OvBox_s{
+  int lo[3],hi[3];        /* active cells of the Grid in this box */
+  int o[3];               /* Grid index minus view index */
+  int nv[3];              /* size of view, including ghost zones */
+  GridS view;             /* the box as a Grid, passed to the integrator */
+#ifdef CONS_SOA
+  ConsArrS U;             /* copy of U (shell boxes only) */
+#else
+  ConsS ***U;             /* copy of U (shell boxes only) */
+#endif
+#ifdef MHD
+  GReal ***B1i,***B2i,***B3i;   /* copy of B (shell boxes only) */
+#endif
+  int nrows;              /* number of views into Grid arrays */
+  char ***vk[NOVVIEW];    /* j-row pointers of each plane of these views */
+}OvBoxS;
+
+static int overlap=0;     /* 1 if interior/shell split is used */
+static OvBoxS ovbox[NOVBOX];
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ *   save_plane() - copies k-plane of U and B into the ring buffers
+ *   ov_box()     - sets up one box and its view of the Grid
+ *   ov_rows()    - array of row pointers viewing part of a Grid array
+ *   ov_arrays()  - lists arrays copied between Grid and shell box
+ *   ov_gather()  - copies U and B of Grid into shell box
+ *   ov_scatter() - copies updated active cells of shell box into Grid
+ *   ov_integrate() - calls the integrator on the view of one box
+ *============================================================================*/
+
+static void save_plane(const GridS *pG, const int k);
+static int ov_box(const GridS *pG, OvBoxS *pB, const int shell);
+static char ***ov_rows(OvBoxS *pB, char ***a, const size_t size);
+static int ov_arrays(const GridS *pG, OvBoxS *pB, char ****ga, char ****ba,
+                     size_t *size, int *face);
+static void ov_gather(const GridS *pG, OvBoxS *pB, const int ghost);
+static void ov_scatter(GridS *pG, OvBoxS *pB);
+static void ov_integrate(DomainS *pD, OvBoxS *pB);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_3d_blocked(DomainS *pD)
+ *  \brief Updates the Grid for one timestep in blocks of kblock k-planes */
+
+void integrate_3d_blocked(DomainS *pD)
+{
+  GridS *pG=(pD->Grid), view;
+  DomainS dom;
+  int k,kv,k0,k1,nk,off,slot;
+#ifdef CONS_SOA
+  GReal ****pUview = (GReal****)&Uview, ****pUring = (GReal****)&Uring;
+  GReal ****pU = (GReal****)&(pG->U);
+  int n;
+#endif
+  int ks = pG->ks, ke = pG->ke;
+
+  for (k0=ks; k0<=ke; k0+=kblock) {
+    k1 = MIN(k0+kblock-1, ke);
+    nk = k1 - k0 + 1;
+    off = k0 - ks;
+
+/* Save the planes updated by this block, and the x3-face above it, while
+ * they still hold values at t^n */
+
+    for (k=k0; k<=MIN(k1+1,ke); k++) save_plane(pG,k);
+
+/* Build view of planes k0-nghost..k1+nghost, with index ks at plane k0 */
+
+    view = *pG;
+    view.ke = ks + nk - 1;
+    view.Nx[2] = nk;
+    view.Disp[2] = pG->Disp[2] + off;
+    view.MinX[2] = pG->MinX[2] + (Real)(off)*pG->dx3;
+    view.MaxX[2] = view.MinX[2] + (Real)(nk)*pG->dx3;
+
+    for (kv=0; kv<=view.ke+nghost; kv++) {
+      k = kv + off;
+      slot = k % nring;
+      if (k >= ks && k < k0) {
+#ifdef CONS_SOA
+        for (n=0; n<NCONS; n++) pUview[n][kv] = pUring[n][slot];
+#else
+        Uview[kv] = Uring[slot];
+#endif
+#ifdef MHD
+        B1view[kv] = B1ring[slot];
+        B2view[kv] = B2ring[slot];
+        B3view[kv] = B3ring[slot];
+#endif
+      } else {
+#ifdef CONS_SOA
+        for (n=0; n<NCONS; n++) pUview[n][kv] = pU[n][k];
+#else
+        Uview[kv] = pG->U[k];
+#endif
+#ifdef MHD
+        B1view[kv] = pG->B1i[k];
+        B2view[kv] = pG->B2i[k];
+        B3view[kv] = (k == k1+1 && k1 < ke) ? B3ring[slot] : pG->B3i[k];
+#endif
+      }
+    }
+
+    view.U = Uview;
+#ifdef PRIM_CACHE
+/* Cache filled by new_dt() is only valid for the first block, since the VL
+ * corrector of each block overwrites it in the planes of the next */
+    view.W = pG->W + off;
+    if (k0 != ks) view.W_valid = 0;
+#endif
+#ifdef MHD
+    view.B1i = B1view;
+    view.B2i = B2view;
+    view.B3i = B3view;
+#ifdef RESISTIVITY
+    view.eta_Ohm  = pG->eta_Ohm  + off;
+    view.eta_Hall = pG->eta_Hall + off;
+    view.eta_AD   = pG->eta_AD   + off;
+#endif
+#endif /* MHD */
+#ifdef SELF_GRAVITY
+    view.Phi        = pG->Phi        + off;
+    view.Phi_old    = pG->Phi_old    + off;
+    view.x1MassFlux = pG->x1MassFlux + off;
+    view.x2MassFlux = pG->x2MassFlux + off;
+    view.x3MassFlux = pG->x3MassFlux + off;
+#endif /* SELF_GRAVITY */
+
+    dom = *pD;
+    dom.Grid = &view;
+#if defined(CTU_INTEGRATOR)
+    integrate_3d_ctu(&dom);
+#elif defined(VL_INTEGRATOR)
+    integrate_3d_vl(&dom);
+#endif
+  }
+#ifdef PRIM_CACHE
+  pG->W_valid = 0;
+#endif
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn int integrate_3d_kblock(void)
+ *  \brief Returns number of k-planes per block, or 0 if blocking is off */
+
+int integrate_3d_kblock(void)
+{
+  return kblock;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_init_3d_blocked(MeshS *pM)
+ *  \brief Reads <integrator>kblock, allocates ring buffers and views.  Must
+ *   be called before integrate_init_3d(), which sizes its arrays by kblock */
+
+void integrate_init_3d_blocked(MeshS *pM)
+{
+  int size1=0,size2=0,size3=0,nl,nd;
+#ifdef CONS_SOA
+  GReal ***pblk, ***pvblk;
+  GReal ****pUring = (GReal****)&Uring, ****pUview = (GReal****)&Uview;
+  int n;
+#endif
+
+  kblock = par_geti_def("integrator","kblock",0);
+  if (kblock <= 0) {
+    kblock = 0;
+    return;
+  }
+
+#if defined(SHEARING_BOX) || defined(STATIC_MESH_REFINEMENT) || defined(PARTICLES) || defined(SPECIAL_RELATIVITY)
+  ath_error("[integrate_init_3d_blocked]: <integrator>kblock cannot be used with shearing box, SMR, particles or special relativity\n");
+#endif
+#if defined(VL_INTEGRATOR) && defined(FIRST_ORDER_FLUX_CORRECTION)
+  ath_error("[integrate_init_3d_blocked]: <integrator>kblock cannot be used with first-order flux correction\n");
+#endif
+
+/* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
+  for (nl=0; nl<(pM->NLevels); nl++){
+    for (nd=0; nd<(pM->DomainsPerLevel[nl]); nd++){
+      if (pM->Domain[nl][nd].Grid != NULL) {
+        if (pM->Domain[nl][nd].Grid->Nx[0] > size1){
+          size1 = pM->Domain[nl][nd].Grid->Nx[0];
+        }
+        if (pM->Domain[nl][nd].Grid->Nx[1] > size2){
+          size2 = pM->Domain[nl][nd].Grid->Nx[1];
+        }
+        if (pM->Domain[nl][nd].Grid->Nx[2] > size3){
+          size3 = pM->Domain[nl][nd].Grid->Nx[2];
+        }
+      }
+    }
+  }
+
+/* A single block covering the Grid is the same as no blocking */
+  if (kblock >= size3) {
+    kblock = 0;
+    return;
+  }
+
+  size1 = size1 + 2*nghost;
+  size2 = size2 + 2*nghost;
+
+/* The rings must hold planes k0-nghost..k1+1 of the current block */
+  nring = kblock + nghost + 1;
+
+#ifdef CONS_SOA
+/* One ring and one view per conserved variable, each stored in one block */
+  if ((pblk = (GReal***)calloc_3d_array(NCONS*nring,size2,size1,sizeof(GReal)))
+    == NULL) goto on_error;
+  for (n=0; n<NCONS; n++) pUring[n] = pblk + n*nring;
+  if ((pvblk = (GReal***)calloc(NCONS*(kblock+2*nghost),sizeof(GReal**)))
+    == NULL) goto on_error;
+  for (n=0; n<NCONS; n++) pUview[n] = pvblk + n*(kblock+2*nghost);
+#else
+  if ((Uring = (ConsS***)calloc_3d_array(nring,size2,size1,sizeof(ConsS)))
+    == NULL) goto on_error;
+  if ((Uview = (ConsS***)calloc(kblock+2*nghost,sizeof(ConsS**))) == NULL)
+    goto on_error;
+#endif
+#ifdef MHD
+  if ((B1ring = (GReal***)calloc_3d_array(nring,size2,size1,sizeof(GReal)))
+    == NULL) goto on_error;
+  if ((B2ring = (GReal***)calloc_3d_array(nring,size2,size1,sizeof(GReal)))
+    == NULL) goto on_error;
+  if ((B3ring = (GReal***)calloc_3d_array(nring,size2,size1,sizeof(GReal)))
+    == NULL) goto on_error;
+  if ((B1view = (GReal***)calloc(kblock+2*nghost,sizeof(GReal**))) == NULL)
+    goto on_error;
+  if ((B2view = (GReal***)calloc(kblock+2*nghost,sizeof(GReal**))) == NULL)
+    goto on_error;
+  if ((B3view = (GReal***)calloc(kblock+2*nghost,sizeof(GReal**))) == NULL)
+    goto on_error;
+#endif /* MHD */
+
+  ath_pout(0,"[integrate_init_3d_blocked]: updating Grid in blocks of %d k-planes\n",
+    kblock);
+  return;
+
+  on_error:
+    integrate_destruct_3d_blocked();
+    ath_error("[integrate_init_3d_blocked]: malloc returned a NULL pointer\n");
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_destruct_3d_blocked(void)
+ *  \brief Free ring buffers and views */
+
+void integrate_destruct_3d_blocked(void)
+{
+#ifdef CONS_SOA
+  if (Uring.d != NULL) free_3d_array(Uring.d);
+  if (Uview.d != NULL) free(Uview.d);
+  memset(&Uring,0,sizeof(ConsArrS));
+  memset(&Uview,0,sizeof(ConsArrS));
+#else
+  if (Uring != NULL) free_3d_array(Uring);
+  if (Uview != NULL) free(Uview);
+  Uring = NULL;  Uview = NULL;
+#endif
+#ifdef MHD
+  if (B1ring != NULL) free_3d_array(B1ring);
+  if (B2ring != NULL) free_3d_array(B2ring);
+  if (B3ring != NULL) free_3d_array(B3ring);
+  if (B1view != NULL) free(B1view);
+  if (B2view != NULL) free(B2view);
+  if (B3view != NULL) free(B3view);
+#endif /* MHD */
+#ifdef MHD
+  B1ring = NULL;  B2ring = NULL;  B3ring = NULL;
+  B1view = NULL;  B2view = NULL;  B3view = NULL;
+#endif /* MHD */
+  kblock = 0;
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_3d_interior(DomainS *pD)
+ *  \brief Updates the interior box of the Grid, which needs no ghost zones.
+ *   Called while boundary values are exchanged; first copies the active
+ *   cells seen by the shell boxes, since the interior is updated in place */
+
+void integrate_3d_interior(DomainS *pD)
+{
+  GridS *pG=(pD->Grid);
+  int b;
+
+  for (b=1; b<NOVBOX; b++) ov_gather(pG,&ovbox[b],0);
+  ov_integrate(pD,&ovbox[0]);
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_3d_shell(DomainS *pD)
+ *  \brief Updates the shell boxes of the Grid, once the exchange of
+ *   boundary values begun before integrate_3d_interior() is complete */
+
+void integrate_3d_shell(DomainS *pD)
+{
+  GridS *pG=(pD->Grid);
+  int b;
+
+  for (b=1; b<NOVBOX; b++) ov_gather(pG,&ovbox[b],1);
+  for (b=1; b<NOVBOX; b++) {
+    ov_integrate(pD,&ovbox[b]);
+    ov_scatter(pG,&ovbox[b]);
+  }
+#ifdef PRIM_CACHE
+  pG->W_valid = 0;
+#endif
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn int integrate_3d_overlap(void)
+ *  \brief Returns 1 if the Grid is updated as interior and shell, else 0 */
+
+int integrate_3d_overlap(void)
+{
+  return overlap;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_init_3d_overlap(MeshS *pM)
+ *  \brief Reads <job>overlap_bvals, sets up the interior and shell boxes and
+ *   allocates the copies of U and B for the shell */
+
+void integrate_init_3d_overlap(MeshS *pM)
+{
+  GridS *pG;
+  int m=nghost,d,dd,b,ok=1,gs[3],ge[3];
+#ifdef MPI_PARALLEL
+  int all_ok,ierr;
+#endif
+
+  overlap = 0;
+  if (par_geti_def("job","overlap_bvals",0) == 0) return;
+
+#if defined(SHEARING_BOX) || defined(STATIC_MESH_REFINEMENT) || defined(PARTICLES) || defined(SPECIAL_RELATIVITY) || defined(CYLINDRICAL)
+  ath_error("[integrate_init_3d_overlap]: <job>overlap_bvals cannot be used with shearing box, SMR, particles, special relativity or cylindrical coordinates\n");
+#endif
+#if defined(OPERATOR_SPLIT_COOLING) || defined(THERMAL_CONDUCTION) || defined(RESISTIVITY) || defined(VISCOSITY)
+  ath_error("[integrate_init_3d_overlap]: <job>overlap_bvals cannot be used with operator-split cooling or explicit diffusion\n");
+#endif
+#if defined(VL_INTEGRATOR) && defined(FIRST_ORDER_FLUX_CORRECTION)
+  ath_error("[integrate_init_3d_overlap]: <job>overlap_bvals cannot be used with first-order flux correction\n");
+#endif
+  if (kblock > 0)
+    ath_error("[integrate_init_3d_overlap]: <job>overlap_bvals cannot be used with <integrator>kblock\n");
+
+/* Interior box must contain at least one cell */
+
+  if (pM->NLevels != 1 || pM->DomainsPerLevel[0] != 1) {
+    ath_perr(-1,"[integrate_init_3d_overlap]: overlap_bvals ignored, needs a single Domain\n");
+    return;
+  }
+  pG = pM->Domain[0][0].Grid;
+  if (pG != NULL) {
+    for (d=0; d<3; d++) if (pG->Nx[d] <= 2*m) ok = 0;
+  }
+#ifdef MPI_PARALLEL
+  ierr = MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  ok = all_ok;
+#endif
+  if (ok == 0) {
+    if (myID_Comm_world == 0)
+      ath_perr(-1,"[integrate_init_3d_overlap]: overlap_bvals ignored, Grids must have more than %d cells in each direction\n",
+        2*m);
+    return;
+  }
+  if (pG == NULL) return;
+
+/* Interior, then shell boxes on the x3-faces (full x1-x2 extent), on the
+ * x2-faces (full x1 extent), and on the x1-faces */
+
+  gs[0] = pG->is;  gs[1] = pG->js;  gs[2] = pG->ks;
+  ge[0] = pG->ie;  ge[1] = pG->je;  ge[2] = pG->ke;
+  for (d=0; d<3; d++) {
+    ovbox[0].lo[d] = gs[d] + m;
+    ovbox[0].hi[d] = ge[d] - m;
+  }
+  for (b=1; b<NOVBOX; b++) {
+    d = 2 - (b-1)/2;
+    for (dd=0; dd<3; dd++) {
+      ovbox[b].lo[dd] = (dd < d) ? gs[dd] : ovbox[0].lo[dd];
+      ovbox[b].hi[dd] = (dd < d) ? ge[dd] : ovbox[0].hi[dd];
+    }
+    if (b%2 == 1) {
+      ovbox[b].lo[d] = gs[d];
+      ovbox[b].hi[d] = gs[d] + m - 1;
+    } else {
+      ovbox[b].lo[d] = ge[d] - m + 1;
+      ovbox[b].hi[d] = ge[d];
+    }
+  }
+
+  for (b=0; b<NOVBOX; b++) {
+    if (ov_box(pG,&ovbox[b],(b > 0)) == 0) {
+      integrate_destruct_3d_overlap();
+      ath_error("[integrate_init_3d_overlap]: malloc returned a NULL pointer\n");
+    }
+  }
+
+  overlap = 1;
+  ath_pout(0,"[integrate_init_3d_overlap]: updating interior of Grid while boundary values are exchanged\n");
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void integrate_destruct_3d_overlap(void)
+ *  \brief Free copies of U and B for the shell, and views of all boxes */
+
+void integrate_destruct_3d_overlap(void)
+{
+  OvBoxS *pB;
+  int b,n;
+
+  for (b=0; b<NOVBOX; b++) {
+    pB = &ovbox[b];
+#ifdef CONS_SOA
+    if (pB->U.d != NULL) free_3d_array(pB->U.d);
+#else
+    if (pB->U != NULL) free_3d_array(pB->U);
+#endif
+#ifdef MHD
+    if (pB->B1i != NULL) free_3d_array(pB->B1i);
+    if (pB->B2i != NULL) free_3d_array(pB->B2i);
+    if (pB->B3i != NULL) free_3d_array(pB->B3i);
+#endif
+    for (n=0; n<pB->nrows; n++) {
+      if (pB->vk[n] != NULL) {
+        free(pB->vk[n][0]);
+        free(pB->vk[n]);
+      }
+    }
+    memset(pB,0,sizeof(OvBoxS));
+  }
+  overlap = 0;
+
+  return;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void save_plane(const GridS *pG, const int k)
+ *  \brief Copies k-plane of U and interface B (ghost zones included) into
+ *   the ring buffers */
+
+static void save_plane(const GridS *pG, const int k)
+{
+  int j, slot = k % nring;
+  int n1z = pG->Nx[0] + 2*nghost, n2z = pG->Nx[1] + 2*nghost;
+#ifdef CONS_SOA
+  GReal ****pUring = (GReal****)&Uring, ****pU = (GReal****)&(pG->U);
+  int n;
+#endif
+
+  for (j=0; j<n2z; j++) {
+#ifdef CONS_SOA
+    for (n=0; n<NCONS; n++)
+      memcpy(pUring[n][slot][j], pU[n][k][j], n1z*sizeof(GReal));
+#else
+    memcpy(Uring[slot][j], pG->U[k][j], n1z*sizeof(ConsS));
+#endif
+#ifdef MHD
+    memcpy(B1ring[slot][j], pG->B1i[k][j], n1z*sizeof(GReal));
+    memcpy(B2ring[slot][j], pG->B2i[k][j], n1z*sizeof(GReal));
+    memcpy(B3ring[slot][j], pG->B3i[k][j], n1z*sizeof(GReal));
+#endif
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int ov_box(const GridS *pG, OvBoxS *pB, const int shell)
+ *  \brief Sets up the view of the Grid for box pB, allocating copies of U
+ *   and B if it is part of the shell.  The views are built once, since the
+ *   Grid arrays do not move.  Returns 0 if malloc fails, else 1 */
+
+static int ov_box(const GridS *pG, OvBoxS *pB, const int shell)
+{
+  GridS *pV = &(pB->view);
+  Real dx[3];
+  int d;
+#ifdef CONS_SOA
+  GReal ***pblk;
+  GReal ****pU = (GReal****)&(pG->U), ****pVU = (GReal****)&(pV->U);
+  GReal ****pBU = (GReal****)&(pB->U);
+  int n;
+#endif
+
+  dx[0] = pG->dx1;  dx[1] = pG->dx2;  dx[2] = pG->dx3;
+  pB->o[0] = pB->lo[0] - pG->is;
+  pB->o[1] = pB->lo[1] - pG->js;
+  pB->o[2] = pB->lo[2] - pG->ks;
+
+  *pV = *pG;
+  for (d=0; d<3; d++) {
+    pV->Nx[d] = pB->hi[d] - pB->lo[d] + 1;
+    pV->Disp[d] = pG->Disp[d] + pB->o[d];
+    pV->MinX[d] = pG->MinX[d] + (Real)(pB->o[d])*dx[d];
+    pV->MaxX[d] = pV->MinX[d] + (Real)(pV->Nx[d])*dx[d];
+    pB->nv[d] = pV->Nx[d] + 2*nghost;
+  }
+  pV->ie = pV->is + pV->Nx[0] - 1;
+  pV->je = pV->js + pV->Nx[1] - 1;
+  pV->ke = pV->ks + pV->Nx[2] - 1;
+
+/* Shell boxes are integrated on copies of U and B, the interior in place */
+
+  if (shell) {
+#ifdef CONS_SOA
+    if ((pblk = (GReal***)calloc_3d_array(NCONS*pB->nv[2],pB->nv[1],pB->nv[0],
+      sizeof(GReal))) == NULL) return 0;
+    for (n=0; n<NCONS; n++) pBU[n] = pblk + n*pB->nv[2];
+#else
+    if ((pB->U = (ConsS***)calloc_3d_array(pB->nv[2],pB->nv[1],pB->nv[0],
+      sizeof(ConsS))) == NULL) return 0;
+#endif
+#ifdef MHD
+    if ((pB->B1i = (GReal***)calloc_3d_array(pB->nv[2],pB->nv[1],pB->nv[0],
+      sizeof(GReal))) == NULL) return 0;
+    if ((pB->B2i = (GReal***)calloc_3d_array(pB->nv[2],pB->nv[1],pB->nv[0],
+      sizeof(GReal))) == NULL) return 0;
+    if ((pB->B3i = (GReal***)calloc_3d_array(pB->nv[2],pB->nv[1],pB->nv[0],
+      sizeof(GReal))) == NULL) return 0;
+#endif
+    pV->U = pB->U;
+#ifdef MHD
+    pV->B1i = pB->B1i;
+    pV->B2i = pB->B2i;
+    pV->B3i = pB->B3i;
+#endif
+  } else {
+#ifdef CONS_SOA
+    for (n=0; n<NCONS; n++)
+      if ((pVU[n] = (GReal***)ov_rows(pB,(char***)pU[n],sizeof(GReal)))
+        == NULL) return 0;
+#else
+    if ((pV->U = (ConsS***)ov_rows(pB,(char***)pG->U,sizeof(ConsS))) == NULL)
+      return 0;
+#endif
+#ifdef MHD
+    if ((pV->B1i = (GReal***)ov_rows(pB,(char***)pG->B1i,sizeof(GReal)))
+      == NULL) return 0;
+    if ((pV->B2i = (GReal***)ov_rows(pB,(char***)pG->B2i,sizeof(GReal)))
+      == NULL) return 0;
+    if ((pV->B3i = (GReal***)ov_rows(pB,(char***)pG->B3i,sizeof(GReal)))
+      == NULL) return 0;
+#endif
+  }
+
+/* All boxes work in place on the remaining arrays */
+
+#ifdef PRIM_CACHE
+  if ((pV->W = (PrimS***)ov_rows(pB,(char***)pG->W,sizeof(PrimS))) == NULL)
+    return 0;
+#endif
+#ifdef SELF_GRAVITY
+  if ((pV->Phi = (GReal***)ov_rows(pB,(char***)pG->Phi,sizeof(GReal)))
+    == NULL) return 0;
+  if ((pV->Phi_old = (GReal***)ov_rows(pB,(char***)pG->Phi_old,sizeof(GReal)))
+    == NULL) return 0;
+  if ((pV->x1MassFlux = (Real***)ov_rows(pB,(char***)pG->x1MassFlux,
+    sizeof(Real))) == NULL) return 0;
+  if ((pV->x2MassFlux = (Real***)ov_rows(pB,(char***)pG->x2MassFlux,
+    sizeof(Real))) == NULL) return 0;
+  if ((pV->x3MassFlux = (Real***)ov_rows(pB,(char***)pG->x3MassFlux,
+    sizeof(Real))) == NULL) return 0;
+#endif /* SELF_GRAVITY */
+
+  return 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static char ***ov_rows(OvBoxS *pB, char ***a, const size_t size)
+ *  \brief Returns array of row pointers through which the Grid array a, with
+ *   elements of the given size, is seen as an array over the view of pB */
+
+static char ***ov_rows(OvBoxS *pB, char ***a, const size_t size)
+{
+  char ***vk, **vj;
+  int kv,jv;
+
+  if (pB->nrows >= NOVVIEW) return NULL;
+  if ((vk = (char***)calloc(pB->nv[2],sizeof(char**))) == NULL) return NULL;
+  if ((vj = (char**)calloc(pB->nv[2]*pB->nv[1],sizeof(char*))) == NULL) {
+    free(vk);
+    return NULL;
+  }
+  pB->vk[pB->nrows++] = vk;
+
+  for (kv=0; kv<pB->nv[2]; kv++) {
+    vk[kv] = vj + kv*pB->nv[1];
+    for (jv=0; jv<pB->nv[1]; jv++) {
+      vk[kv][jv] = a[kv+pB->o[2]][jv+pB->o[1]] + pB->o[0]*size;
+    }
+  }
+
+  return vk;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int ov_arrays(const GridS *pG, OvBoxS *pB, char ****ga,
+ *                           char ****ba, size_t *size, int *face)
+ *  \brief Lists the arrays of the Grid (ga) and their copies in shell box pB
+ *   (ba), with the size of their elements and the direction normal to their
+ *   faces (-1 for cell-centred).  Returns the number of arrays */
+
+static int ov_arrays(const GridS *pG, OvBoxS *pB, char ****ga, char ****ba,
+                     size_t *size, int *face)
+{
+  int na=0;
+#ifdef CONS_SOA
+  GReal ****pU = (GReal****)&(pG->U), ****pBU = (GReal****)&(pB->U);
+  int n;
+
+  for (n=0; n<NCONS; n++) {
+    ga[na] = (char***)pU[n];  ba[na] = (char***)pBU[n];
+    size[na] = sizeof(GReal);  face[na++] = -1;
+  }
+#else
+  ga[na] = (char***)pG->U;  ba[na] = (char***)pB->U;
+  size[na] = sizeof(ConsS);  face[na++] = -1;
+#endif
+#ifdef MHD
+  ga[na] = (char***)pG->B1i;  ba[na] = (char***)pB->B1i;
+  size[na] = sizeof(GReal);  face[na++] = 0;
+  ga[na] = (char***)pG->B2i;  ba[na] = (char***)pB->B2i;
+  size[na] = sizeof(GReal);  face[na++] = 1;
+  ga[na] = (char***)pG->B3i;  ba[na] = (char***)pB->B3i;
+  size[na] = sizeof(GReal);  face[na++] = 2;
+#endif
+
+  return na;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void ov_gather(const GridS *pG, OvBoxS *pB, const int ghost)
+ *  \brief Copies U and B of the Grid over the view of shell box pB: cells in
+ *   the active range of the Grid if ghost=0 (before the interior is updated),
+ *   cells in its ghost zones if ghost=1 (after the exchange) */
+
+static void ov_gather(const GridS *pG, OvBoxS *pB, const int ghost)
+{
+  char ***ga[NCONS+3], ***ba[NCONS+3];
+  size_t size[NCONS+3];
+  int face[NCONS+3],il[2],iu[2];
+  int na,n,ns,s,kv,jv,k,j,i0,i1,act;
+  int is = pG->is, ie = pG->ie;
+
+  na = ov_arrays(pG,pB,ga,ba,size,face);
+  i0 = pB->lo[0] - nghost;
+  i1 = pB->hi[0] + nghost;
+
+  for (kv=0; kv<pB->nv[2]; kv++) {
+    k = kv + pB->o[2];
+    for (jv=0; jv<pB->nv[1]; jv++) {
+      j = jv + pB->o[1];
+      act = (k >= pG->ks && k <= pG->ke && j >= pG->js && j <= pG->je);
+
+/* Segments of row j,k to be copied in this phase */
+      ns = 0;
+      if (ghost == 0) {
+        if (act) {
+          il[0] = MAX(i0,is);  iu[0] = MIN(i1,ie);  ns = 1;
+        }
+      } else if (!act) {
+        il[0] = i0;  iu[0] = i1;  ns = 1;
+      } else {
+        il[0] = i0;  iu[0] = is-1;
+        il[1] = ie+1;  iu[1] = i1;  ns = 2;
+      }
+
+      for (s=0; s<ns; s++) {
+        if (il[s] > iu[s]) continue;
+        for (n=0; n<na; n++) {
+          memcpy(ba[n][kv][jv] + (il[s] - pB->o[0])*size[n],
+                 ga[n][k][j] + il[s]*size[n], (iu[s] - il[s] + 1)*size[n]);
+        }
+      }
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void ov_scatter(GridS *pG, OvBoxS *pB)
+ *  \brief Copies the updated active cells of shell box pB, and the faces of
+ *   B it owns (its upper faces only at the edge of the Grid), into the Grid */
+
+static void ov_scatter(GridS *pG, OvBoxS *pB)
+{
+  char ***ga[NCONS+3], ***ba[NCONS+3];
+  size_t size[NCONS+3];
+  int face[NCONS+3],ge[3],hi[3];
+  int na,n,d,k,j;
+
+  na = ov_arrays(pG,pB,ga,ba,size,face);
+  ge[0] = pG->ie;  ge[1] = pG->je;  ge[2] = pG->ke;
+
+  for (n=0; n<na; n++) {
+    for (d=0; d<3; d++) {
+      hi[d] = pB->hi[d];
+      if (face[n] == d && hi[d] == ge[d]) hi[d]++;
+    }
+    for (k=pB->lo[2]; k<=hi[2]; k++) {
+      for (j=pB->lo[1]; j<=hi[1]; j++) {
+        memcpy(ga[n][k][j] + pB->lo[0]*size[n],
+               ba[n][k-pB->o[2]][j-pB->o[1]] + (pB->lo[0] - pB->o[0])*size[n],
+               (hi[0] - pB->lo[0] + 1)*size[n]);
+      }
+    }
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void ov_integrate(DomainS *pD, OvBoxS *pB)
+ *  \brief Calls the integrator on the view of box pB */
+
+static void ov_integrate(DomainS *pD, OvBoxS *pB)
+{
+  DomainS dom;
+
+  pB->view.time = pD->Grid->time;
+  pB->view.dt = pD->Grid->dt;
+#ifdef PRIM_CACHE
+/* Cache filled by new_dt() is valid in the interior, which is integrated
+ * first; the shell boxes are integrated on copies of U */
+  pB->view.W_valid = (pB == &ovbox[0]) ? pD->Grid->W_valid : 0;
+#endif
+
+  dom = *pD;
+  dom.Grid = &(pB->view);
+#if defined(CTU_INTEGRATOR)
+  integrate_3d_ctu(&dom);
+#elif defined(VL_INTEGRATOR)
+  integrate_3d_vl(&dom);
+#endif
+
+  return;
+}
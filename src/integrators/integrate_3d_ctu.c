@@ -13,6 +13,8 @@
  *   - For adb hydro, requires (9*Cons1DS +  3*Real) = 48 3D arrays
  *   - For adb mhd, requires   (9*Cons1DS + 10*Real) = 73 3D arrays
  *   The H-correction of Sanders et al. adds another 3 arrays.  
+ *   With <integrator>kblock > 0 the arrays only span a block of kblock
+ *   k-planes plus ghost zones (see integrate_3d_blocked.c).
  *
  * REFERENCES:
  * - P. Colella, "Multidimensional upwind methods for hyperbolic conservation
@@ -68,7 +70,10 @@ static Real ***emf1_cc=NULL, ***emf2_cc=NULL, ***emf3_cc=NULL;
 /* 1D scratch vectors used by lr_states and flux functions */
 static Real *Bxc=NULL, *Bxi=NULL;
 static Prim1DS *W=NULL, *Wl=NULL, *Wr=NULL;
-static Cons1DS *U1d=NULL;
+static Cons1DS *U1d=NULL, *Ul=NULL, *Ur=NULL, *F1d=NULL;
+#ifdef OPENMP
+#pragma omp threadprivate(Bxc,Bxi,W,Wl,Wr,U1d,Ul,Ur,F1d)
+#endif
 
 /* density and Pressure at t^{n+1/2} needed by MHD, cooling, and gravity */
 static Real ***dhalf = NULL, ***phalf=NULL;
@@ -89,6 +94,77 @@ static ConsS **rFlxiib=NULL, **rFlxoib=NULL;
 static Real ***geom_src=NULL;
 #endif
 
+/* With OpenMP the loops over the Grid are shared among threads in slabs of
+ * constant k (constant j in step 3), each thread sweeping its own 1D pencils
+ * through its private copy of the 1D scratch vectors above.  The scalars
+ * written inside these loops must be private; those given a value before
+ * the loops (or changed in them only in cylindrical coordinates) are
+ * firstprivate. */
+#ifdef OPENMP
+#ifndef BAROTROPIC
+#define CTU_OMP_P_ADB ,coolfl,coolfr,coolf
+#define CTU_OMP_FP_ADB ,Eh
+#else
+#define CTU_OMP_P_ADB
+#define CTU_OMP_FP_ADB
+#endif
+#ifdef MHD
+#define CTU_OMP_P_MHD ,MHD_src_By,MHD_src_Bz,mdb1,mdb2,mdb3,db1,db2,db3, \
+  l1,l2,l3,B1,B2,B3,V1,V2,V3,B1ch,B2ch,B3ch
+#else
+#define CTU_OMP_P_MHD
+#endif
+#ifdef H_CORRECTION
+#define CTU_OMP_P_HCORR ,cfr,cfl,lambdar,lambdal
+#else
+#define CTU_OMP_P_HCORR
+#endif
+#if (NSCALARS > 0)
+#define CTU_OMP_P_SCAL ,n
+#else
+#define CTU_OMP_P_SCAL
+#endif
+#ifdef SELF_GRAVITY
+#define CTU_OMP_P_SELFG ,gxl,gxr,gyl,gyr,gzl,gzr, \
+  flx_m1l,flx_m1r,flx_m2l,flx_m2r,flx_m3l,flx_m3r
+#else
+#define CTU_OMP_P_SELFG
+#endif
+#ifdef SHEARING_BOX
+#define CTU_OMP_P_SHBOX ,M1n,dM2n,M1e,dM2e, \
+  flx1_dM2,frx1_dM2,flx2_dM2,frx2_dM2,flx3_dM2,frx3_dM2
+#else
+#define CTU_OMP_P_SHBOX
+#endif
+#ifdef CYLINDRICAL
+#ifndef ISOTHERMAL
+#define CTU_OMP_P_CYL ,rinv,geom_src_d,geom_src_Vx,geom_src_Vy,geom_src_P, \
+  geom_src_By,geom_src_Bz,Pavgh
+#else
+#define CTU_OMP_P_CYL ,rinv,geom_src_d,geom_src_Vx,geom_src_Vy,geom_src_P, \
+  geom_src_By,geom_src_Bz
+#endif
+#else
+#define CTU_OMP_P_CYL
+#endif
+#if defined(CYLINDRICAL) && defined(FARGO)
+#define CTU_OMP_P_FARGO ,Om,qshear,Mrn,Mpn,Mre,Mpe,Mrav,Mpav
+#else
+#define CTU_OMP_P_FARGO
+#endif
+#ifdef PARTICLES
+#define CTU_OMP_P_PART ,d1
+#else
+#define CTU_OMP_P_PART
+#endif
+
+#define CTU_OMP_PRIVATE i,j,k,x1,x2,x3,phicl,phicr,phifc,phil,phir,phic, \
+  M1h,M2h,M3h,g,gl,gr CTU_OMP_P_ADB CTU_OMP_P_MHD CTU_OMP_P_HCORR \
+  CTU_OMP_P_SCAL CTU_OMP_P_SELFG CTU_OMP_P_SHBOX CTU_OMP_P_CYL \
+  CTU_OMP_P_FARGO CTU_OMP_P_PART
+#define CTU_OMP_FIRSTPRIVATE Bx,q2,dtodx2,dx2,dx2i,lsf,rsf CTU_OMP_FP_ADB
+#endif /* OPENMP */
+
 /*==============================================================================
  * PRIVATE FUNCTION PROTOTYPES: 
  *   integrate_emf1_corner() - the upwind CT method in GS05, for emf1
@@ -173,6 +249,8 @@ void integrate_3d_ctu(DomainS *pD)
   Real g,gl,gr;
   Real lsf=1.0, rsf=1.0;
 
+  PERF_START(integrate_3d_perf);
+
 #if defined(CYLINDRICAL) && defined(FARGO)
   if (OrbitalProfile==NULL || ShearProfile==NULL)
     ath_error("[integrate_3d_ctu]:  OrbitalProfile() and ShearProfile() *must* be defined.\n");
@@ -205,6 +283,12 @@ void integrate_3d_ctu(DomainS *pD)
   exchange_gpcouple(pD,1);
 #endif
 
+/* Convert to primitive variables once for all three sweeps (only in the
+ * ghost zones if new_dt() has filled the cache) */
+#ifdef PRIM_CACHE
+  Cons_to_Prim_Stage(pG);
+#endif
+
 /*=== STEP 1: Compute L/R x1-interface states and 1D x1-Fluxes ===============*/
 
 /*--- Step 1a ------------------------------------------------------------------
@@ -212,26 +296,48 @@ void integrate_3d_ctu(DomainS *pD)
  * U1d = (d, M1, M2, M3, E, B2c, B3c, s[n])
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl; k<=ku; k++) {
     for (j=jl; j<=ju; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        U1d[i].d  = pG->U[k][j][i].d;
-        U1d[i].Mx = pG->U[k][j][i].M1;
-        U1d[i].My = pG->U[k][j][i].M2;
-        U1d[i].Mz = pG->U[k][j][i].M3;
+#ifdef PRIM_CACHE
+        W[i].d  = pG->W[k][j][i].d;
+        W[i].Vx = pG->W[k][j][i].V1;
+        W[i].Vy = pG->W[k][j][i].V2;
+        W[i].Vz = pG->W[k][j][i].V3;
 #ifndef BAROTROPIC
-        U1d[i].E  = pG->U[k][j][i].E;
+        W[i].P  = pG->W[k][j][i].P;
 #endif /* BAROTROPIC */
 #ifdef MHD
-        U1d[i].By = pG->U[k][j][i].B2c;
-        U1d[i].Bz = pG->U[k][j][i].B3c;
-        Bxc[i] = pG->U[k][j][i].B1c;
-        Bxi[i] = pG->B1i[k][j][i];
-        B1_x1Face[k][j][i] = pG->B1i[k][j][i];
+        W[i].By = pG->W[k][j][i].B2c;
+        W[i].Bz = pG->W[k][j][i].B3c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W[i].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
+        U1d[i].d  = UVAR(pG->U,k,j,i,d);
+        U1d[i].Mx = UVAR(pG->U,k,j,i,M1);
+        U1d[i].My = UVAR(pG->U,k,j,i,M2);
+        U1d[i].Mz = UVAR(pG->U,k,j,i,M3);
+#ifndef BAROTROPIC
+        U1d[i].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[i].By = UVAR(pG->U,k,j,i,B2c);
+        U1d[i].Bz = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[i].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[i].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[i] = UVAR(pG->U,k,j,i,B1c);
+        Bxi[i] = pG->B1i[k][j][i];
+        B1_x1Face[k][j][i] = pG->B1i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 1b ------------------------------------------------------------------
@@ -239,7 +345,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
      for (i=is-nghost; i<=ie+nghost; i++) {
+#ifndef PRIM_CACHE
        W[i] = Cons1D_to_Prim1D(&U1d[i],&Bxc[i]);
+#endif
 
         /* Calculate the cell-centered geometric source vector now using U^{n}
          * This will be used at the end of the integration step as a source term
@@ -258,7 +366,9 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* CYLINDRICAL */
      }
 
+     PERF_START(lr_states_perf);
      lr_states(pG,W,Bxc,pG->dt,pG->dx1,il+1,iu-1,Wl,Wr,1);
+     PERF_STOP(lr_states_perf);
 
 /* Apply density floor */
      for (i=il+1; i<=iu; i++){
@@ -296,8 +406,8 @@ void integrate_3d_ctu(DomainS *pD)
 	  l2 = l2 < 0.0 ? l2 : 0.0;
 	}
 
-        MHD_src_By = (pG->U[k][j][i-1].M2/pG->U[k][j][i-1].d)*l2;
-        MHD_src_Bz = (pG->U[k][j][i-1].M3/pG->U[k][j][i-1].d)*l3;
+        MHD_src_By = (UVAR(pG->U,k,j,i-1,M2)/UVAR(pG->U,k,j,i-1,d))*l2;
+        MHD_src_Bz = (UVAR(pG->U,k,j,i-1,M3)/UVAR(pG->U,k,j,i-1,d))*l3;
 
         Wl[i].By += hdt*MHD_src_By;
         Wl[i].Bz += hdt*MHD_src_Bz;
@@ -326,8 +436,8 @@ void integrate_3d_ctu(DomainS *pD)
           l2 = l2 < 0.0 ? l2 : 0.0;
         }
 
-        MHD_src_By = (pG->U[k][j][i].M2/pG->U[k][j][i].d)*l2;
-        MHD_src_Bz = (pG->U[k][j][i].M3/pG->U[k][j][i].d)*l3;
+        MHD_src_By = (UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d))*l2;
+        MHD_src_Bz = (UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d))*l3;
 
         Wr[i].By += hdt*MHD_src_By;
         Wr[i].Bz += hdt*MHD_src_Bz;
@@ -548,13 +658,13 @@ void integrate_3d_ctu(DomainS *pD)
       for (i=il+1; i<=iu; i++) {
         Ul_x1Face[k][j][i] = Prim1D_to_Cons1D(&Wl[i],&Bxi[i]);
         Ur_x1Face[k][j][i] = Prim1D_to_Cons1D(&Wr[i],&Bxi[i]);
-
-#ifdef MHD
-        Bx = B1_x1Face[k][j][i];
-#endif
-        fluxes(Ul_x1Face[k][j][i],Ur_x1Face[k][j][i],Wl[i],Wr[i],Bx,
-          &x1Flux[k][j][i]);
       }
+
+/* Bxi[i] is the same as B1_x1Face[k][j][i] at this stage */
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul_x1Face[k][j],Ur_x1Face[k][j],Wl,Wr,Bxi,x1Flux[k][j],
+        il+1,iu);
+      PERF_STOP(fluxes_perf);
     }
   }
 
@@ -565,6 +675,9 @@ void integrate_3d_ctu(DomainS *pD)
  * U1d = (d, M2, M3, M1, E, B3c, B1c, s[n])
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl; k<=ku; k++) {
     for (i=il; i<=iu; i++) {
 #ifdef CYLINDRICAL
@@ -573,34 +686,57 @@ void integrate_3d_ctu(DomainS *pD)
       dtodx2 = pG->dt/dx2;
 #endif
       for (j=js-nghost; j<=je+nghost; j++) {
-        U1d[j].d  = pG->U[k][j][i].d;
-        U1d[j].Mx = pG->U[k][j][i].M2;
-        U1d[j].My = pG->U[k][j][i].M3;
-        U1d[j].Mz = pG->U[k][j][i].M1;
+#ifdef PRIM_CACHE
+        W[j].d  = pG->W[k][j][i].d;
+        W[j].Vx = pG->W[k][j][i].V2;
+        W[j].Vy = pG->W[k][j][i].V3;
+        W[j].Vz = pG->W[k][j][i].V1;
 #ifndef BAROTROPIC
-        U1d[j].E  = pG->U[k][j][i].E;
-#endif
+        W[j].P  = pG->W[k][j][i].P;
+#endif /* BAROTROPIC */
 #ifdef MHD
-        U1d[j].By = pG->U[k][j][i].B3c;
-        U1d[j].Bz = pG->U[k][j][i].B1c;
-        Bxc[j] = pG->U[k][j][i].B2c;
-        Bxi[j] = pG->B2i[k][j][i];
-        B2_x2Face[k][j][i] = pG->B2i[k][j][i];
+        W[j].By = pG->W[k][j][i].B3c;
+        W[j].Bz = pG->W[k][j][i].B1c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W[j].r[n] = pG->W[k][j][i].r[n];
 #endif
+#else
+        U1d[j].d  = UVAR(pG->U,k,j,i,d);
+        U1d[j].Mx = UVAR(pG->U,k,j,i,M2);
+        U1d[j].My = UVAR(pG->U,k,j,i,M3);
+        U1d[j].Mz = UVAR(pG->U,k,j,i,M1);
+#ifndef BAROTROPIC
+        U1d[j].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[j].By = UVAR(pG->U,k,j,i,B3c);
+        U1d[j].Bz = UVAR(pG->U,k,j,i,B1c);
+#endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[j].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[j].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[j] = UVAR(pG->U,k,j,i,B2c);
+        Bxi[j] = pG->B2i[k][j][i];
+        B2_x2Face[k][j][i] = pG->B2i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 2b ------------------------------------------------------------------
  * Compute L and R states at X2-interfaces, add "MHD source terms" for 0.5*dt
  */
 
+#ifndef PRIM_CACHE
       for (j=js-nghost; j<=je+nghost; j++) {
         W[j] = Cons1D_to_Prim1D(&U1d[j],&Bxc[j]);
       }
+#endif
 
+      PERF_START(lr_states_perf);
       lr_states(pG,W,Bxc,pG->dt,dx2,jl+1,ju-1,Wl,Wr,2);
+      PERF_STOP(lr_states_perf);
 
 /* Apply density floor */
      for (j=jl+1; j<=ju; j++){
@@ -637,8 +773,8 @@ void integrate_3d_ctu(DomainS *pD)
           l3 = l3 < 0.0 ? l3 : 0.0;
         }
 
-        MHD_src_By = (pG->U[k][j-1][i].M3/pG->U[k][j-1][i].d)*l3;
-        MHD_src_Bz = (pG->U[k][j-1][i].M1/pG->U[k][j-1][i].d)*l1;
+        MHD_src_By = (UVAR(pG->U,k,j-1,i,M3)/UVAR(pG->U,k,j-1,i,d))*l3;
+        MHD_src_Bz = (UVAR(pG->U,k,j-1,i,M1)/UVAR(pG->U,k,j-1,i,d))*l1;
 
         Wl[j].By += hdt*MHD_src_By;
         Wl[j].Bz += hdt*MHD_src_Bz;
@@ -663,8 +799,8 @@ void integrate_3d_ctu(DomainS *pD)
           l3 = l3 < 0.0 ? l3 : 0.0;
         }
 
-        MHD_src_By = (pG->U[k][j][i].M3/pG->U[k][j][i].d)*l3;
-        MHD_src_Bz = (pG->U[k][j][i].M1/pG->U[k][j][i].d)*l1;
+        MHD_src_By = (UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d))*l3;
+        MHD_src_Bz = (UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d))*l1;
 
         Wr[j].By += hdt*MHD_src_By;
         Wr[j].Bz += hdt*MHD_src_Bz;
@@ -749,15 +885,17 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
       for (j=jl+1; j<=ju; j++) {
-        Ul_x2Face[k][j][i] = Prim1D_to_Cons1D(&Wl[j],&Bxi[j]);
-        Ur_x2Face[k][j][i] = Prim1D_to_Cons1D(&Wr[j],&Bxi[j]);
-
-#ifdef MHD
-        Bx = B2_x2Face[k][j][i];
-#endif
-        fluxes(Ul_x2Face[k][j][i],Ur_x2Face[k][j][i],Wl[j],Wr[j],Bx,
-          &x2Flux[k][j][i]);
+        Ul[j] = Prim1D_to_Cons1D(&Wl[j],&Bxi[j]);
+        Ur[j] = Prim1D_to_Cons1D(&Wr[j],&Bxi[j]);
+        Ul_x2Face[k][j][i] = Ul[j];
+        Ur_x2Face[k][j][i] = Ur[j];
       }
+
+/* Fluxes are computed along the contiguous 1D pencil, then stored */
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,F1d,jl+1,ju);
+      PERF_STOP(fluxes_perf);
+      for (j=jl+1; j<=ju; j++) x2Flux[k][j][i] = F1d[j];
     }
   }
 
@@ -768,37 +906,63 @@ void integrate_3d_ctu(DomainS *pD)
  * U1d = (d, M3, M1, M2, E, B1c, B2c, s[n])
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (j=jl; j<=ju; j++) {
     for (i=il; i<=iu; i++) {
       for (k=ks-nghost; k<=ke+nghost; k++) {
-        U1d[k].d  = pG->U[k][j][i].d;
-        U1d[k].Mx = pG->U[k][j][i].M3;
-        U1d[k].My = pG->U[k][j][i].M1;
-        U1d[k].Mz = pG->U[k][j][i].M2;
+#ifdef PRIM_CACHE
+        W[k].d  = pG->W[k][j][i].d;
+        W[k].Vx = pG->W[k][j][i].V3;
+        W[k].Vy = pG->W[k][j][i].V1;
+        W[k].Vz = pG->W[k][j][i].V2;
 #ifndef BAROTROPIC
-        U1d[k].E  = pG->U[k][j][i].E;
+        W[k].P  = pG->W[k][j][i].P;
 #endif /* BAROTROPIC */
 #ifdef MHD
-        U1d[k].By = pG->U[k][j][i].B1c;
-        U1d[k].Bz = pG->U[k][j][i].B2c;
-        Bxc[k] = pG->U[k][j][i].B3c;
-        Bxi[k] = pG->B3i[k][j][i];
-        B3_x3Face[k][j][i] = pG->B3i[k][j][i];
+        W[k].By = pG->W[k][j][i].B1c;
+        W[k].Bz = pG->W[k][j][i].B2c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W[k].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
+        U1d[k].d  = UVAR(pG->U,k,j,i,d);
+        U1d[k].Mx = UVAR(pG->U,k,j,i,M3);
+        U1d[k].My = UVAR(pG->U,k,j,i,M1);
+        U1d[k].Mz = UVAR(pG->U,k,j,i,M2);
+#ifndef BAROTROPIC
+        U1d[k].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[k].By = UVAR(pG->U,k,j,i,B1c);
+        U1d[k].Bz = UVAR(pG->U,k,j,i,B2c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[k].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[k].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[k] = UVAR(pG->U,k,j,i,B3c);
+        Bxi[k] = pG->B3i[k][j][i];
+        B3_x3Face[k][j][i] = pG->B3i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 3b ------------------------------------------------------------------
  * Compute L and R states at X3-interfaces, add "MHD source terms" for 0.5*dt
  */
 
+#ifndef PRIM_CACHE
       for (k=ks-nghost; k<=ke+nghost; k++) {
         W[k] = Cons1D_to_Prim1D(&U1d[k],&Bxc[k]);
       }
+#endif
 
+      PERF_START(lr_states_perf);
       lr_states(pG,W,Bxc,pG->dt,pG->dx3,kl+1,ku-1,Wl,Wr,3);
+      PERF_STOP(lr_states_perf);
 
 /* Apply density floor */
      for (k=kl+1; k<=ku; k++){
@@ -836,8 +1000,8 @@ void integrate_3d_ctu(DomainS *pD)
           l2 = l2 < 0.0 ? l2 : 0.0;
         }
 
-        MHD_src_By = (pG->U[k-1][j][i].M1/pG->U[k-1][j][i].d)*l1;
-        MHD_src_Bz = (pG->U[k-1][j][i].M2/pG->U[k-1][j][i].d)*l2;
+        MHD_src_By = (UVAR(pG->U,k-1,j,i,M1)/UVAR(pG->U,k-1,j,i,d))*l1;
+        MHD_src_Bz = (UVAR(pG->U,k-1,j,i,M2)/UVAR(pG->U,k-1,j,i,d))*l2;
 
         Wl[k].By += hdt*MHD_src_By;
         Wl[k].Bz += hdt*MHD_src_Bz;
@@ -862,8 +1026,8 @@ void integrate_3d_ctu(DomainS *pD)
           l2 = l2 < 0.0 ? l2 : 0.0;
         }
 
-        MHD_src_By = (pG->U[k][j][i].M1/pG->U[k][j][i].d)*l1;
-        MHD_src_Bz = (pG->U[k][j][i].M2/pG->U[k][j][i].d)*l2;
+        MHD_src_By = (UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d))*l1;
+        MHD_src_Bz = (UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d))*l2;
 
         Wr[k].By += hdt*MHD_src_By;
         Wr[k].Bz += hdt*MHD_src_Bz;
@@ -942,15 +1106,17 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
       for (k=kl+1; k<=ku; k++) {
-        Ul_x3Face[k][j][i] = Prim1D_to_Cons1D(&Wl[k],&Bxi[k]);
-        Ur_x3Face[k][j][i] = Prim1D_to_Cons1D(&Wr[k],&Bxi[k]);
-
-#ifdef MHD
-        Bx = B3_x3Face[k][j][i];
-#endif
-        fluxes(Ul_x3Face[k][j][i],Ur_x3Face[k][j][i],Wl[k],Wr[k],Bx,
-          &x3Flux[k][j][i]);
+        Ul[k] = Prim1D_to_Cons1D(&Wl[k],&Bxi[k]);
+        Ur[k] = Prim1D_to_Cons1D(&Wr[k],&Bxi[k]);
+        Ul_x3Face[k][j][i] = Ul[k];
+        Ur_x3Face[k][j][i] = Ur[k];
       }
+
+/* Fluxes are computed along the contiguous 1D pencil, then stored */
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,F1d,kl+1,ku);
+      PERF_STOP(fluxes_perf);
+      for (k=kl+1; k<=ku; k++) x3Flux[k][j][i] = F1d[k];
     }
   }
 
@@ -963,18 +1129,21 @@ void integrate_3d_ctu(DomainS *pD)
 
 #ifdef MHD
 /* emf1 */
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl; k<=ku; k++) {
     for (j=jl; j<=ju; j++) {
       for (i=il; i<=iu; i++) {
-        emf1_cc[k][j][i] = (pG->U[k][j][i].B2c*pG->U[k][j][i].M3 -
-                            pG->U[k][j][i].B3c*pG->U[k][j][i].M2)
-                              /pG->U[k][j][i].d;
-        emf2_cc[k][j][i] = (pG->U[k][j][i].B3c*pG->U[k][j][i].M1 -
-                            pG->U[k][j][i].B1c*pG->U[k][j][i].M3)
-                              /pG->U[k][j][i].d;
-        emf3_cc[k][j][i] = (pG->U[k][j][i].B1c*pG->U[k][j][i].M2 -
-                            pG->U[k][j][i].B2c*pG->U[k][j][i].M1)
-                              /pG->U[k][j][i].d;
+        emf1_cc[k][j][i] = (UVAR(pG->U,k,j,i,B2c)*UVAR(pG->U,k,j,i,M3) -
+                            UVAR(pG->U,k,j,i,B3c)*UVAR(pG->U,k,j,i,M2))
+                              /UVAR(pG->U,k,j,i,d);
+        emf2_cc[k][j][i] = (UVAR(pG->U,k,j,i,B3c)*UVAR(pG->U,k,j,i,M1) -
+                            UVAR(pG->U,k,j,i,B1c)*UVAR(pG->U,k,j,i,M3))
+                              /UVAR(pG->U,k,j,i,d);
+        emf3_cc[k][j][i] = (UVAR(pG->U,k,j,i,B1c)*UVAR(pG->U,k,j,i,M2) -
+                            UVAR(pG->U,k,j,i,B2c)*UVAR(pG->U,k,j,i,M1))
+                              /UVAR(pG->U,k,j,i,d);
       }
     }
   }
@@ -986,6 +1155,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Update the interface magnetic fields using CT for a half time step.
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1014,6 +1186,9 @@ void integrate_3d_ctu(DomainS *pD)
                              q3*(emf1[k+1][ju][i  ]-emf1[k][ju][i]);
     }
   }
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (j=jl+1; j<=ju-1; j++) {
     for (i=il+1; i<=iu-1; i++) {
 #ifdef CYLINDRICAL
@@ -1033,6 +1208,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Since the fluxes come from an x2-sweep, (x,y,z) on RHS -> (z,x,y) on LHS 
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu; i++) {
@@ -1132,6 +1310,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef MHD
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu; i++) {
@@ -1142,11 +1323,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k  ][j  ][i  ] - lsf*pG->B1i[k][j][i-1])*dx1i;
         db2 = (    pG->B2i[k  ][j+1][i-1] -     pG->B2i[k][j][i-1])*dx2i;
         db3 = (    pG->B3i[k+1][j  ][i-1] -     pG->B3i[k][j][i-1])*dx3i;
-        B1 = pG->U[k][j][i-1].B1c;
-        B2 = pG->U[k][j][i-1].B2c;
-        B3 = pG->U[k][j][i-1].B3c;
-        V2 = pG->U[k][j][i-1].M2/pG->U[k][j][i-1].d;
-        V3 = pG->U[k][j][i-1].M3/pG->U[k][j][i-1].d;
+        B1 = UVAR(pG->U,k,j,i-1,B1c);
+        B2 = UVAR(pG->U,k,j,i-1,B2c);
+        B3 = UVAR(pG->U,k,j,i-1,B3c);
+        V2 = UVAR(pG->U,k,j,i-1,M2)/UVAR(pG->U,k,j,i-1,d);
+        V3 = UVAR(pG->U,k,j,i-1,M3)/UVAR(pG->U,k,j,i-1,d);
 
         /* Calculate mdb2 = min_mod(-db1,db2) */
         if(db1 > 0.0 && db2 < 0.0){
@@ -1182,11 +1363,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k  ][j  ][i+1] - lsf*pG->B1i[k][j][i])*dx1i;
         db2 = (    pG->B2i[k  ][j+1][i  ] -     pG->B2i[k][j][i])*dx2i;
         db3 = (    pG->B3i[k+1][j  ][i  ] -     pG->B3i[k][j][i])*dx3i;
-        B1 = pG->U[k][j][i].B1c;
-        B2 = pG->U[k][j][i].B2c;
-        B3 = pG->U[k][j][i].B3c;
-        V2 = pG->U[k][j][i].M2/pG->U[k][j][i].d;
-        V3 = pG->U[k][j][i].M3/pG->U[k][j][i].d;
+        B1 = UVAR(pG->U,k,j,i,B1c);
+        B2 = UVAR(pG->U,k,j,i,B2c);
+        B3 = UVAR(pG->U,k,j,i,B3c);
+        V2 = UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d);
+        V3 = UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d);
 
         /* Calculate mdb2 = min_mod(-db1,db2) */
         if(db1 > 0.0 && db2 < 0.0){
@@ -1227,6 +1408,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
   if (StaticGravPot != NULL){
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu; i++) {
@@ -1239,9 +1423,9 @@ void integrate_3d_ctu(DomainS *pD)
 #ifdef CYLINDRICAL
         q2 = hdt/(r[i]*pG->dx2);
 #endif
-        Ur_x1Face[k][j][i].My -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x1Face[k][j][i].My -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifdef ROTATING_FRAME
-        Ur_x1Face[k][j][i].My -= (pG->dt)*Omega_0*pG->U[k][j][i].M1;
+        Ur_x1Face[k][j][i].My -= (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
         Ur_x1Face[k][j][i].E -= q2*(x2Flux[k][j  ][i  ].d*(phic - phil)
@@ -1251,7 +1435,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
         phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
 
-        Ur_x1Face[k][j][i].Mz -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x1Face[k][j][i].Mz -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x1Face[k][j][i].E -= q3*(x3Flux[k  ][j][i  ].d*(phic - phil)
                                   + x3Flux[k+1][j][i  ].d*(phir - phic));
@@ -1265,9 +1449,9 @@ void integrate_3d_ctu(DomainS *pD)
 #ifdef CYLINDRICAL
         q2 = hdt/(r[i-1]*pG->dx2);
 #endif
-        Ul_x1Face[k][j][i].My -= q2*(phir-phil)*pG->U[k][j][i-1].d;
+        Ul_x1Face[k][j][i].My -= q2*(phir-phil)*UVAR(pG->U,k,j,i-1,d);
 #ifdef ROTATING_FRAME
-        Ul_x1Face[k][j][i].My -= (pG->dt)*Omega_0*pG->U[k][j][i-1].M1;
+        Ul_x1Face[k][j][i].My -= (pG->dt)*Omega_0*UVAR(pG->U,k,j,i-1,M1);
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
         Ul_x1Face[k][j][i].E -= q2*(x2Flux[k][j  ][i-1].d*(phic - phil)
@@ -1277,7 +1461,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)((x1-pG->dx1),x2,(x3+0.5*pG->dx3));
         phil = (*StaticGravPot)((x1-pG->dx1),x2,(x3-0.5*pG->dx3));
 
-        Ul_x1Face[k][j][i].Mz -= q3*(phir-phil)*pG->U[k][j][i-1].d;
+        Ul_x1Face[k][j][i].Mz -= q3*(phir-phil)*UVAR(pG->U,k,j,i-1,d);
 #ifndef BAROTROPIC
         Ul_x1Face[k][j][i].E -= q3*(x3Flux[k  ][j][i-1].d*(phic - phil)
                                   + x3Flux[k+1][j][i-1].d*(phir - phic));
@@ -1292,6 +1476,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef SELF_GRAVITY
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu; i++) {
@@ -1300,7 +1487,7 @@ void integrate_3d_ctu(DomainS *pD)
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j-1][i]);
 
         /* correct right states; x2 and x3 gradients */
-        Ur_x1Face[k][j][i].My -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x1Face[k][j][i].My -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x1Face[k][j][i].E -= q2*(x2Flux[k][j  ][i  ].d*(phic - phil)
                                   + x2Flux[k][j+1][i  ].d*(phir - phic));
@@ -1309,7 +1496,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k+1][j][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k-1][j][i]);
 
-        Ur_x1Face[k][j][i].Mz -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x1Face[k][j][i].Mz -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x1Face[k][j][i].E -= q3*(x3Flux[k  ][j][i  ].d*(phic - phil)
                                   + x3Flux[k+1][j][i  ].d*(phir - phic));
@@ -1320,7 +1507,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i-1] + pG->Phi[k][j+1][i-1]);
         phil = 0.5*(pG->Phi[k][j][i-1] + pG->Phi[k][j-1][i-1]);
 
-        Ul_x1Face[k][j][i].My -= q2*(phir-phil)*pG->U[k][j][i-1].d;
+        Ul_x1Face[k][j][i].My -= q2*(phir-phil)*UVAR(pG->U,k,j,i-1,d);
 #ifndef BAROTROPIC
         Ul_x1Face[k][j][i].E -= q2*(x2Flux[k][j  ][i-1].d*(phic - phil)
                                   + x2Flux[k][j+1][i-1].d*(phir - phic));
@@ -1329,7 +1516,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i-1] + pG->Phi[k+1][j][i-1]);
         phil = 0.5*(pG->Phi[k][j][i-1] + pG->Phi[k-1][j][i-1]);
 
-        Ul_x1Face[k][j][i].Mz -= q3*(phir-phil)*pG->U[k][j][i-1].d;
+        Ul_x1Face[k][j][i].Mz -= q3*(phir-phil)*UVAR(pG->U,k,j,i-1,d);
 #ifndef BAROTROPIC
         Ul_x1Face[k][j][i].E -= q3*(x3Flux[k  ][j][i-1].d*(phic - phil)
                                   + x3Flux[k+1][j][i-1].d*(phir - phic));
@@ -1347,6 +1534,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Since the fluxes come from an x1-sweep, (x,y,z) on RHS -> (y,z,x) on LHS
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1439,6 +1629,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef MHD
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1449,11 +1642,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k  ][j-1][i+1] - lsf*pG->B1i[k][j-1][i])*dx1i;
         db2 = (    pG->B2i[k  ][j  ][i  ] -     pG->B2i[k][j-1][i])*dx2i;
         db3 = (    pG->B3i[k+1][j-1][i  ] -     pG->B3i[k][j-1][i])*dx3i;
-        B1 = pG->U[k][j-1][i].B1c;
-        B2 = pG->U[k][j-1][i].B2c;
-        B3 = pG->U[k][j-1][i].B3c;
-        V1 = pG->U[k][j-1][i].M1/pG->U[k][j-1][i].d;
-        V3 = pG->U[k][j-1][i].M3/pG->U[k][j-1][i].d;
+        B1 = UVAR(pG->U,k,j-1,i,B1c);
+        B2 = UVAR(pG->U,k,j-1,i,B2c);
+        B3 = UVAR(pG->U,k,j-1,i,B3c);
+        V1 = UVAR(pG->U,k,j-1,i,M1)/UVAR(pG->U,k,j-1,i,d);
+        V3 = UVAR(pG->U,k,j-1,i,M3)/UVAR(pG->U,k,j-1,i,d);
 
         /* Calculate mdb1 = min_mod(-db2,db1) */
         if(db2 > 0.0 && db1 < 0.0){
@@ -1485,11 +1678,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k  ][j  ][i+1] - lsf*pG->B1i[k][j][i])*dx1i;
         db2 = (    pG->B2i[k  ][j+1][i  ] -     pG->B2i[k][j][i])*dx2i;
         db3 = (    pG->B3i[k+1][j  ][i  ] -     pG->B3i[k][j][i])*dx3i;
-        B1 = pG->U[k][j][i].B1c;
-        B2 = pG->U[k][j][i].B2c;
-        B3 = pG->U[k][j][i].B3c;
-        V1 = pG->U[k][j][i].M1/pG->U[k][j][i].d;
-        V3 = pG->U[k][j][i].M3/pG->U[k][j][i].d;
+        B1 = UVAR(pG->U,k,j,i,B1c);
+        B2 = UVAR(pG->U,k,j,i,B2c);
+        B3 = UVAR(pG->U,k,j,i,B3c);
+        V1 = UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d);
+        V3 = UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d);
 
         /* Calculate mdb1 = min_mod(-db2,db1) */
         if(db2 > 0.0 && db1 < 0.0){
@@ -1530,6 +1723,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
   if (StaticGravPot != NULL){
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1547,12 +1743,12 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
         g -= r[i]*SQR((*OrbitalProfile)(r[i])); 
 #endif
-        Ur_x2Face[k][j][i].Mz -= hdt*pG->U[k][j][i].d*g;
+        Ur_x2Face[k][j][i].Mz -= hdt*UVAR(pG->U,k,j,i,d)*g;
 #ifdef ROTATING_FRAME
-        Ur_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*pG->U[k][j][i].M2;
+        Ur_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M2);
         #ifdef FARGO
         Om = (*OrbitalProfile)(x1vc(pG,i));
-        Ur_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*pG->U[k][j][i].d*Om*x1vc(pG,i);
+        Ur_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,d)*Om*x1vc(pG,i);
         #endif
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
@@ -1567,7 +1763,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
         phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
 
-        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j  ][i].d*(phic - phil)
                                   + x3Flux[k+1][j  ][i].d*(phir - phic));
@@ -1582,12 +1778,12 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
         g -= r[i]*SQR((*OrbitalProfile)(r[i])); 
 #endif
-        Ul_x2Face[k][j][i].Mz -= hdt*pG->U[k][j-1][i].d*g;
+        Ul_x2Face[k][j][i].Mz -= hdt*UVAR(pG->U,k,j-1,i,d)*g;
 #ifdef ROTATING_FRAME
-        Ul_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*pG->U[k][j-1][i].M2;
+        Ul_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*UVAR(pG->U,k,j-1,i,M2);
         #ifdef FARGO
         Om = (*OrbitalProfile)(x1vc(pG,i));
-        Ul_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*pG->U[k][j-1][i].d*Om*x1vc(pG,i);
+        Ul_x2Face[k][j][i].Mz += (pG->dt)*Omega_0*UVAR(pG->U,k,j-1,i,d)*Om*x1vc(pG,i);
         #endif
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
@@ -1602,7 +1798,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)(x1,(x2-pG->dx2),(x3+0.5*pG->dx3));
         phil = (*StaticGravPot)(x1,(x2-pG->dx2),(x3-0.5*pG->dx3));
 
-        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j-1][i].d;
+        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j-1,i,d);
 #ifndef BAROTROPIC
         Ul_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j-1][i].d*(phic - phil)
                                   + x3Flux[k+1][j-1][i].d*(phir - phic));
@@ -1617,6 +1813,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef SELF_GRAVITY
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1625,7 +1824,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i+1]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i-1]);
 
-        Ur_x2Face[k][j][i].Mz -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x2Face[k][j][i].Mz -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x2Face[k][j][i].E -= q1*(x1Flux[k][j][i  ].d*(phic - phil)
                                   + x1Flux[k][j][i+1].d*(phir - phic));
@@ -1634,7 +1833,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k+1][j][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k-1][j][i]);
 
-        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j][i].d*(phic - phil)
                                   + x3Flux[k+1][j][i].d*(phir - phic));
@@ -1645,7 +1844,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j-1][i] + pG->Phi[k][j-1][i+1]);
         phil = 0.5*(pG->Phi[k][j-1][i] + pG->Phi[k][j-1][i-1]);
 
-        Ul_x2Face[k][j][i].Mz -= q1*(phir-phil)*pG->U[k][j-1][i].d;
+        Ul_x2Face[k][j][i].Mz -= q1*(phir-phil)*UVAR(pG->U,k,j-1,i,d);
 #ifndef BAROTROPIC
         Ul_x2Face[k][j][i].E -= q1*(x1Flux[k][j-1][i  ].d*(phic - phil)
                                   + x1Flux[k][j-1][i+1].d*(phir - phic));
@@ -1653,7 +1852,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j-1][i] + pG->Phi[k+1][j-1][i]);
         phil = 0.5*(pG->Phi[k][j-1][i] + pG->Phi[k-1][j-1][i]);
 
-        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j-1][i].d;
+        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j-1,i,d);
 #ifndef BAROTROPIC
         Ul_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j-1][i].d*(phic - phil)
                                   + x3Flux[k+1][j-1][i].d*(phir - phic));
@@ -1683,7 +1882,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,x3);
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
 
-        Ur_x2Face[k][j][i].Mz -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x2Face[k][j][i].Mz -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x2Face[k][j][i].E -= q1*(x1Flux[k][j  ][i  ].d*(phic - phil)
                                   + x1Flux[k][j  ][i+1].d*(phir - phic));
@@ -1692,7 +1891,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,x2,(x3+0.5*pG->dx3));
         phil = (*ShearingBoxPot)(x1,x2,(x3-0.5*pG->dx3));
 
-        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j  ][i].d*(phic - phil)
                                   + x3Flux[k+1][j  ][i].d*(phir - phic));
@@ -1703,7 +1902,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),(x2-pG->dx2),x3);
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),(x2-pG->dx2),x3);
 
-        Ul_x2Face[k][j][i].Mz -= q1*(phir-phil)*pG->U[k][j-1][i].d;
+        Ul_x2Face[k][j][i].Mz -= q1*(phir-phil)*UVAR(pG->U,k,j-1,i,d);
 #ifndef BAROTROPIC
         Ul_x2Face[k][j][i].E -= q1*(x1Flux[k][j-1][i  ].d*(phic - phil)
                                   + x1Flux[k][j-1][i+1].d*(phir - phic));
@@ -1711,7 +1910,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,(x2-pG->dx2),(x3+0.5*pG->dx3));
         phil = (*ShearingBoxPot)(x1,(x2-pG->dx2),(x3-0.5*pG->dx3));
 
-        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*pG->U[k][j-1][i].d;
+        Ul_x2Face[k][j][i].My -= q3*(phir-phil)*UVAR(pG->U,k,j-1,i,d);
 #ifndef BAROTROPIC
         Ul_x2Face[k][j][i].E -= q3*(x3Flux[k  ][j-1][i].d*(phic - phil)
                                   + x3Flux[k+1][j-1][i].d*(phir - phic));
@@ -1723,14 +1922,14 @@ void integrate_3d_ctu(DomainS *pD)
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
-        Ur_x2Face[k][j][i].Mz += pG->dt*Omega_0*pG->U[k][j][i].M2;
-        Ul_x2Face[k][j][i].Mz += pG->dt*Omega_0*pG->U[k][j-1][i].M2;
+        Ur_x2Face[k][j][i].Mz += pG->dt*Omega_0*UVAR(pG->U,k,j,i,M2);
+        Ul_x2Face[k][j][i].Mz += pG->dt*Omega_0*UVAR(pG->U,k,j-1,i,M2);
 #ifdef FARGO
-        Ur_x2Face[k][j][i].Mx += hdt*(qshear-2.)*Omega_0*pG->U[k][j][i].M1;
-        Ul_x2Face[k][j][i].Mx += hdt*(qshear-2.)*Omega_0*pG->U[k][j-1][i].M1;
+        Ur_x2Face[k][j][i].Mx += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k,j,i,M1);
+        Ul_x2Face[k][j][i].Mx += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k,j-1,i,M1);
 #else
-        Ur_x2Face[k][j][i].Mx -= pG->dt*Omega_0*pG->U[k][j][i].M1;
-        Ul_x2Face[k][j][i].Mx -= pG->dt*Omega_0*pG->U[k][j-1][i].M1;
+        Ur_x2Face[k][j][i].Mx -= pG->dt*Omega_0*UVAR(pG->U,k,j,i,M1);
+        Ul_x2Face[k][j][i].Mx -= pG->dt*Omega_0*UVAR(pG->U,k,j-1,i,M1);
 #endif
       }
     }
@@ -1744,11 +1943,11 @@ void integrate_3d_ctu(DomainS *pD)
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
 
-        Ur_x2Face[k][j][i].Mz += pG->dt*Om*pG->U[k][j][i].M2;
-        Ur_x2Face[k][j][i].Mx += hdt*(qshear-2.0)*Om*pG->U[k][j][i].M1;
+        Ur_x2Face[k][j][i].Mz += pG->dt*Om*UVAR(pG->U,k,j,i,M2);
+        Ur_x2Face[k][j][i].Mx += hdt*(qshear-2.0)*Om*UVAR(pG->U,k,j,i,M1);
 
-        Ul_x2Face[k][j][i].Mz += pG->dt*Om*pG->U[k][j-1][i].M2;
-        Ul_x2Face[k][j][i].Mx += hdt*(qshear-2.0)*Om*pG->U[k][j-1][i].M1;
+        Ul_x2Face[k][j][i].Mz += pG->dt*Om*UVAR(pG->U,k,j-1,i,M2);
+        Ul_x2Face[k][j][i].Mx += hdt*(qshear-2.0)*Om*UVAR(pG->U,k,j-1,i,M1);
       }
     }
   }
@@ -1759,6 +1958,9 @@ void integrate_3d_ctu(DomainS *pD)
  * states on x2-faces.  S_{M_R} = -(\rho v_\phi^2 - B_\phi^2)/R
  */
 #ifdef CYLINDRICAL
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1776,6 +1978,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Since the fluxes come from an x1-sweep, (x,y,z) on RHS -> (z,x,y) on LHS 
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1869,6 +2074,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef MHD
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1879,11 +2087,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k-1][j  ][i+1] - lsf*pG->B1i[k-1][j][i])*dx1i;
         db2 = (    pG->B2i[k-1][j+1][i  ] -     pG->B2i[k-1][j][i])*dx2i;
         db3 = (    pG->B3i[k  ][j  ][i  ] -     pG->B3i[k-1][j][i])*dx3i;
-        B1 = pG->U[k-1][j][i].B1c;
-        B2 = pG->U[k-1][j][i].B2c;
-        B3 = pG->U[k-1][j][i].B3c;
-        V1 = pG->U[k-1][j][i].M1/pG->U[k-1][j][i].d;
-        V2 = pG->U[k-1][j][i].M2/pG->U[k-1][j][i].d;
+        B1 = UVAR(pG->U,k-1,j,i,B1c);
+        B2 = UVAR(pG->U,k-1,j,i,B2c);
+        B3 = UVAR(pG->U,k-1,j,i,B3c);
+        V1 = UVAR(pG->U,k-1,j,i,M1)/UVAR(pG->U,k-1,j,i,d);
+        V2 = UVAR(pG->U,k-1,j,i,M2)/UVAR(pG->U,k-1,j,i,d);
 
         /* Calculate mdb1 = min_mod(-db3,db1) */
         if(db3 > 0.0 && db1 < 0.0){
@@ -1915,11 +2123,11 @@ void integrate_3d_ctu(DomainS *pD)
         db1 = (rsf*pG->B1i[k  ][j  ][i+1] - lsf*pG->B1i[k][j][i])*dx1i;
         db2 = (    pG->B2i[k  ][j+1][i  ] -     pG->B2i[k][j][i])*dx2i;
         db3 = (    pG->B3i[k+1][j  ][i  ] -     pG->B3i[k][j][i])*dx3i;
-        B1 = pG->U[k][j][i].B1c;
-        B2 = pG->U[k][j][i].B2c;
-        B3 = pG->U[k][j][i].B3c;
-        V1 = pG->U[k][j][i].M1/pG->U[k][j][i].d;
-        V2 = pG->U[k][j][i].M2/pG->U[k][j][i].d;
+        B1 = UVAR(pG->U,k,j,i,B1c);
+        B2 = UVAR(pG->U,k,j,i,B2c);
+        B3 = UVAR(pG->U,k,j,i,B3c);
+        V1 = UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d);
+        V2 = UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d);
 
         /* Calculate mdb1 = min_mod(-db3,db1) */
         if(db3 > 0.0 && db1 < 0.0){
@@ -1960,6 +2168,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
   if (StaticGravPot != NULL){
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -1977,12 +2188,12 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
         g -= r[i]*SQR((*OrbitalProfile)(r[i])); 
 #endif
-        Ur_x3Face[k][j][i].My -= hdt*pG->U[k][j][i].d*g;
+        Ur_x3Face[k][j][i].My -= hdt*UVAR(pG->U,k,j,i,d)*g;
 #ifdef ROTATING_FRAME
-        Ur_x3Face[k][j][i].My += (pG->dt)*Omega_0*pG->U[k][j][i].M2;
+        Ur_x3Face[k][j][i].My += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M2);
         #ifdef FARGO
         Om = (*OrbitalProfile)(x1vc(pG,i));
-        Ur_x3Face[k][j][i].My += (pG->dt)*Omega_0*pG->U[k][j][i].d*Om*x1vc(pG,i);
+        Ur_x3Face[k][j][i].My += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,d)*Om*x1vc(pG,i);
         #endif
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
@@ -1997,9 +2208,9 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
 
-        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifdef ROTATING_FRAME
-        Ur_x3Face[k][j][i].Mz -= (pG->dt)*Omega_0*pG->U[k][j][i].M1;
+        Ur_x3Face[k][j][i].Mz -= (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
         Ur_x3Face[k][j][i].E -= q2*(x2Flux[k  ][j  ][i].d*(phic - phil)
@@ -2014,12 +2225,12 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
         g -= r[i]*SQR((*OrbitalProfile)(r[i])); 
 #endif
-        Ul_x3Face[k][j][i].My -= hdt*pG->U[k-1][j][i].d*g;
+        Ul_x3Face[k][j][i].My -= hdt*UVAR(pG->U,k-1,j,i,d)*g;
 #ifdef ROTATING_FRAME
-        Ul_x3Face[k][j][i].My += (pG->dt)*Omega_0*pG->U[k-1][j][i].M2;
+        Ul_x3Face[k][j][i].My += (pG->dt)*Omega_0*UVAR(pG->U,k-1,j,i,M2);
         #ifdef FARGO
         Om = (*OrbitalProfile)(x1vc(pG,i));
-        Ul_x3Face[k][j][i].My += (pG->dt)*Omega_0*pG->U[k-1][j][i].d*Om*x1vc(pG,i);
+        Ul_x3Face[k][j][i].My += (pG->dt)*Omega_0*UVAR(pG->U,k-1,j,i,d)*Om*x1vc(pG,i);
         #endif
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
@@ -2034,9 +2245,9 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),(x3-pG->dx3));
         phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),(x3-pG->dx3));
 
-        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k-1][j][i].d;
+        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k-1,j,i,d);
 #ifdef ROTATING_FRAME
-        Ul_x3Face[k][j][i].Mz -= (pG->dt)*Omega_0*pG->U[k-1][j][i].M1;
+        Ul_x3Face[k][j][i].Mz -= (pG->dt)*Omega_0*UVAR(pG->U,k-1,j,i,M1);
 #endif /*ROTATING_FRAME*/
 #ifndef BAROTROPIC
         Ul_x3Face[k][j][i].E -= q2*(x2Flux[k-1][j  ][i].d*(phic - phil)
@@ -2052,6 +2263,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef SELF_GRAVITY
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -2060,7 +2274,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i+1]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i-1]);
 
-        Ur_x3Face[k][j][i].My -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x3Face[k][j][i].My -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x3Face[k][j][i].E -= q1*(x1Flux[k][j][i  ].d*(phic - phil)
                                   + x1Flux[k][j][i+1].d*(phir - phic));
@@ -2069,7 +2283,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j+1][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j-1][i]);
 
-        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x3Face[k][j][i].E -= q2*(x2Flux[k][j  ][i].d*(phic - phil)
                                   + x2Flux[k][j+1][i].d*(phir - phic));
@@ -2080,7 +2294,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k-1][j][i] + pG->Phi[k-1][j][i+1]);
         phil = 0.5*(pG->Phi[k-1][j][i] + pG->Phi[k-1][j][i-1]);
 
-        Ul_x3Face[k][j][i].My -= q1*(phir-phil)*pG->U[k-1][j][i].d;
+        Ul_x3Face[k][j][i].My -= q1*(phir-phil)*UVAR(pG->U,k-1,j,i,d);
 #ifndef BAROTROPIC
         Ul_x3Face[k][j][i].E -= q1*(x1Flux[k-1][j][i  ].d*(phic - phil)
                                   + x1Flux[k-1][j][i+1].d*(phir - phic));
@@ -2089,7 +2303,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = 0.5*(pG->Phi[k-1][j][i] + pG->Phi[k-1][j+1][i]);
         phil = 0.5*(pG->Phi[k-1][j][i] + pG->Phi[k-1][j-1][i]);
 
-        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k-1][j][i].d;
+        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k-1,j,i,d);
 #ifndef BAROTROPIC
         Ul_x3Face[k][j][i].E -= q2*(x2Flux[k-1][j  ][i].d*(phic - phil)
                                   + x2Flux[k-1][j+1][i].d*(phir - phic));
@@ -2118,7 +2332,7 @@ void integrate_3d_ctu(DomainS *pD)
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
 
         /* correct right states; x1 and x2 gradients */
-        Ur_x3Face[k][j][i].My -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x3Face[k][j][i].My -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x3Face[k][j][i].E -= q1*(x1Flux[k  ][j][i  ].d*(phic - phil)
                                   + x1Flux[k  ][j][i+1].d*(phir - phic));
@@ -2127,7 +2341,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),x3);
 
-        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Ur_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Ur_x3Face[k][j][i].E -= q2*(x2Flux[k  ][j  ][i].d*(phic - phil)
                                   + x2Flux[k  ][j+1][i].d*(phir - phic));
@@ -2138,7 +2352,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,(x3-pG->dx3));
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,(x3-pG->dx3));
 
-        Ul_x3Face[k][j][i].My -= q1*(phir-phil)*pG->U[k-1][j][i].d;
+        Ul_x3Face[k][j][i].My -= q1*(phir-phil)*UVAR(pG->U,k-1,j,i,d);
 #ifndef BAROTROPIC
         Ul_x3Face[k][j][i].E -= q1*(x1Flux[k-1][j][i  ].d*(phic - phil)
                                   + x1Flux[k-1][j][i+1].d*(phir - phic));
@@ -2147,7 +2361,7 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),(x3-pG->dx3));
         phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),(x3-pG->dx3));
 
-        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*pG->U[k-1][j][i].d;
+        Ul_x3Face[k][j][i].Mz -= q2*(phir-phil)*UVAR(pG->U,k-1,j,i,d);
 #ifndef BAROTROPIC
         Ul_x3Face[k][j][i].E -= q2*(x2Flux[k-1][j  ][i].d*(phic - phil)
                                   + x2Flux[k-1][j+1][i].d*(phir - phic));
@@ -2159,14 +2373,14 @@ void integrate_3d_ctu(DomainS *pD)
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
-        Ur_x3Face[k][j][i].My += pG->dt*Omega_0*pG->U[k][j][i].M2;
-        Ul_x3Face[k][j][i].My += pG->dt*Omega_0*pG->U[k-1][j][i].M2;
+        Ur_x3Face[k][j][i].My += pG->dt*Omega_0*UVAR(pG->U,k,j,i,M2);
+        Ul_x3Face[k][j][i].My += pG->dt*Omega_0*UVAR(pG->U,k-1,j,i,M2);
 #ifdef FARGO
-        Ur_x3Face[k][j][i].Mz += hdt*(qshear-2.)*Omega_0*pG->U[k][j][i].M1;
-        Ul_x3Face[k][j][i].Mz += hdt*(qshear-2.)*Omega_0*pG->U[k-1][j][i].M1;
+        Ur_x3Face[k][j][i].Mz += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k,j,i,M1);
+        Ul_x3Face[k][j][i].Mz += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k-1,j,i,M1);
 #else
-        Ur_x3Face[k][j][i].Mz -= pG->dt*Omega_0*pG->U[k][j][i].M1;
-        Ul_x3Face[k][j][i].Mz -= pG->dt*Omega_0*pG->U[k-1][j][i].M1;
+        Ur_x3Face[k][j][i].Mz -= pG->dt*Omega_0*UVAR(pG->U,k,j,i,M1);
+        Ul_x3Face[k][j][i].Mz -= pG->dt*Omega_0*UVAR(pG->U,k-1,j,i,M1);
 #endif
       }
     }
@@ -2180,11 +2394,11 @@ void integrate_3d_ctu(DomainS *pD)
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
 
-        Ur_x3Face[k][j][i].My += pG->dt*Om*pG->U[k][j][i].M2;
-        Ur_x3Face[k][j][i].Mz += hdt*(qshear-2.0)*Om*pG->U[k][j][i].M1;
+        Ur_x3Face[k][j][i].My += pG->dt*Om*UVAR(pG->U,k,j,i,M2);
+        Ur_x3Face[k][j][i].Mz += hdt*(qshear-2.0)*Om*UVAR(pG->U,k,j,i,M1);
 
-        Ul_x3Face[k][j][i].My += pG->dt*Om*pG->U[k-1][j][i].M2;
-        Ul_x3Face[k][j][i].Mz += hdt*(qshear-2.0)*Om*pG->U[k-1][j][i].M1;
+        Ul_x3Face[k][j][i].My += pG->dt*Om*UVAR(pG->U,k-1,j,i,M2);
+        Ul_x3Face[k][j][i].Mz += hdt*(qshear-2.0)*Om*UVAR(pG->U,k-1,j,i,M1);
       }
     }
   }
@@ -2195,6 +2409,9 @@ void integrate_3d_ctu(DomainS *pD)
  * states on x3-faces.  S_{M_R} = -(\rho v_\phi^2 - B_\phi^2)/R
  */
 #ifdef CYLINDRICAL
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -2208,6 +2425,9 @@ void integrate_3d_ctu(DomainS *pD)
 /*--- Step 7e ------------------------------------------------------------------
  * Apply density floor
  */
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
   for (j=jl+1; j<=ju-1; j++) {
   for (i=il+1; i<=iu-1; i++) {
@@ -2248,6 +2468,9 @@ void integrate_3d_ctu(DomainS *pD)
 #endif
 #endif
   {
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
     for (k=kl+1; k<=ku-1; k++) {
       for (j=jl+1; j<=ju-1; j++) {
 	for (i=il+1; i<=iu-1; i++) {
@@ -2255,7 +2478,7 @@ void integrate_3d_ctu(DomainS *pD)
           rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
           q2 = hdt/(r[i]*pG->dx2);
 #endif
-          dhalf[k][j][i] = pG->U[k][j][i].d 
+          dhalf[k][j][i] = UVAR(pG->U,k,j,i,d) 
             - q1*(rsf*x1Flux[k  ][j  ][i+1].d - lsf*x1Flux[k][j][i].d)
             - q2*(    x2Flux[k  ][j+1][i  ].d -     x2Flux[k][j][i].d)
             - q3*(    x3Flux[k+1][j  ][i  ].d -     x3Flux[k][j][i].d);
@@ -2281,6 +2504,9 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* PARTICLES */
 #endif /* MHD */
   {
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=kl+1; k<=ku-1; k++) {
     for (j=jl+1; j<=ju-1; j++) {
       for (i=il+1; i<=iu-1; i++) {
@@ -2288,23 +2514,23 @@ void integrate_3d_ctu(DomainS *pD)
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
         q2 = hdt/(r[i]/pG->dx2);
 #endif
-        M1h = pG->U[k][j][i].M1
+        M1h = UVAR(pG->U,k,j,i,M1)
            - q1*(rsf*x1Flux[k  ][j  ][i+1].Mx - lsf*x1Flux[k][j][i].Mx)
            - q2*(    x2Flux[k  ][j+1][i  ].Mz -     x2Flux[k][j][i].Mz)
            - q3*(    x3Flux[k+1][j  ][i  ].My -     x3Flux[k][j][i].My);
 
-        M2h = pG->U[k][j][i].M2
+        M2h = UVAR(pG->U,k,j,i,M2)
            - q1*(SQR(rsf)*x1Flux[k  ][j  ][i+1].My - SQR(lsf)*x1Flux[k][j][i].My)
            - q2*(         x2Flux[k  ][j+1][i  ].Mx -          x2Flux[k][j][i].Mx)
            - q3*(         x3Flux[k+1][j  ][i  ].Mz -          x3Flux[k][j][i].Mz);
 
-        M3h = pG->U[k][j][i].M3
+        M3h = UVAR(pG->U,k,j,i,M3)
            - q1*(rsf*x1Flux[k  ][j  ][i+1].Mz - lsf*x1Flux[k][j][i].Mz)
            - q2*(    x2Flux[k  ][j+1][i  ].My -     x2Flux[k][j][i].My)
            - q3*(    x3Flux[k+1][j  ][i  ].Mx -     x3Flux[k][j][i].Mx);
 
 #ifndef BAROTROPIC
-        Eh = pG->U[k][j][i].E
+        Eh = UVAR(pG->U,k,j,i,E)
            - q1*(rsf*x1Flux[k  ][j  ][i+1].E - lsf*x1Flux[k][j][i].E)
            - q2*(    x2Flux[k  ][j+1][i  ].E -     x2Flux[k][j][i].E)
            - q3*(    x3Flux[k+1][j  ][i  ].E -     x3Flux[k][j][i].E);
@@ -2320,40 +2546,40 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
           g -= r[i]*SQR((*OrbitalProfile)(r[i]));
 #endif
-          M1h -= hdt*pG->U[k][j][i].d*g;
+          M1h -= hdt*UVAR(pG->U,k,j,i,d)*g;
 #ifdef ROTATING_FRAME
-          M1h += (pG->dt)*Omega_0*pG->U[k][j][i].M2;
+          M1h += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M2);
         #ifdef FARGO
           Om = (*OrbitalProfile)(x1vc(pG,i));
-          M1h += (pG->dt)*Omega_0*pG->U[k][j][i].d*Om*x1vc(pG,i);
+          M1h += (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,d)*Om*x1vc(pG,i);
         #endif
 #endif
 
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
-          M2h -= q2*(phir-phil)*pG->U[k][j][i].d;
+          M2h -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifdef ROTATING_FRAME
-          M2h -= (pG->dt)*Omega_0*pG->U[k][j][i].M1;
+          M2h -= (pG->dt)*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif
 
           phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
           phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
-          M3h -= q3*(phir-phil)*pG->U[k][j][i].d;
+          M3h -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
         }
 
         /* Add source terms due to self-gravity  */
 #ifdef SELF_GRAVITY
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i+1]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i-1]);
-        M1h -= q1*(phir-phil)*pG->U[k][j][i].d;
+        M1h -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j+1][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j-1][i]);
-        M2h -= q2*(phir-phil)*pG->U[k][j][i].d;
+        M2h -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k+1][j][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k-1][j][i]);
-        M3h -= q3*(phir-phil)*pG->U[k][j][i].d;
+        M3h -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #endif /* SELF_GRAVITY */
 
         /* Add the tidal gravity and Coriolis terms for shearing box. */
@@ -2362,29 +2588,29 @@ void integrate_3d_ctu(DomainS *pD)
           cc_pos(pG,i,j,k,&x1,&x2,&x3);
           phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,x3);
           phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
-          M1h -= q1*(phir-phil)*pG->U[k][j][i].d;
+          M1h -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 
           phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),x3);
-          M2h -= q2*(phir-phil)*pG->U[k][j][i].d;
+          M2h -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 
           phir = (*ShearingBoxPot)(x1,x2,(x3+0.5*pG->dx3));
           phil = (*ShearingBoxPot)(x1,x2,(x3-0.5*pG->dx3));
-          M3h -= q3*(phir-phil)*pG->U[k][j][i].d;
+          M3h -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
         }
 
-        M1h += pG->dt*Omega_0*pG->U[k][j][i].M2;
+        M1h += pG->dt*Omega_0*UVAR(pG->U,k,j,i,M2);
 #ifdef FARGO
-        M2h += hdt*(qshear-2.)*Omega_0*pG->U[k][j][i].M1;
+        M2h += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k,j,i,M1);
 #else
-        M2h -= pG->dt*Omega_0*pG->U[k][j][i].M1;
+        M2h -= pG->dt*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif
 #endif /* SHEARING_BOX */
 #if defined(CYLINDRICAL) && defined(FARGO)
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
-        M1h += hdt*2.0*Om*pG->U[k][j][i].M2;
-        M2h += hdt*Om*(qshear-2.0)*pG->U[k][j][i].M1;
+        M1h += hdt*2.0*Om*UVAR(pG->U,k,j,i,M2);
+        M2h += hdt*Om*(qshear-2.0)*UVAR(pG->U,k,j,i,M1);
 #endif
 
         /* Add the particle feedback terms */
@@ -2451,6 +2677,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef H_CORRECTION
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks-1; k<=ke+1; k++) {
     for (j=js-1; j<=je+1; j++) {
       for (i=is-1; i<=ie+2; i++) {
@@ -2466,6 +2695,9 @@ void integrate_3d_ctu(DomainS *pD)
     }
   }
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks-1; k<=ke+1; k++) {
     for (j=js-1; j<=je+2; j++) {
       for (i=is-1; i<=ie+1; i++) {
@@ -2481,6 +2713,9 @@ void integrate_3d_ctu(DomainS *pD)
     }
   }
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks-1; k<=ke+2; k++) {
     for (j=js-1; j<=je+1; j++) {
       for (i=is-1; i<=ie+1; i++) {
@@ -2501,6 +2736,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Compute 3D x1-fluxes from corrected L/R states.
  */
 
+#if defined(OPENMP) && !defined(H_CORRECTION)
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks-1; k<=ke+1; k++) {
     for (j=js-1; j<=je+1; j++) {
       for (i=is; i<=ie+1; i++) {
@@ -2518,13 +2756,21 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B1_x1Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Wl[i] = Cons1D_to_Prim1D(&Ul_x1Face[k][j][i],&Bx);
         Wr[i] = Cons1D_to_Prim1D(&Ur_x1Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul_x1Face[k][j][i],Ur_x1Face[k][j][i],Wl[i],Wr[i],Bx,
                &x1Flux[k][j][i]);
+#endif
       }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul_x1Face[k][j],Ur_x1Face[k][j],Wl,Wr,
+        Bxi,x1Flux[k][j],is,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
     }
   }
 
@@ -2532,6 +2778,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Compute 3D x2-fluxes from corrected L/R states.
  */
 
+#if defined(OPENMP) && !defined(H_CORRECTION)
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks-1; k<=ke+1; k++) {
     for (j=js; j<=je+1; j++) {
       for (i=is-1; i<=ie+1; i++) {
@@ -2549,13 +2798,21 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B2_x2Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Wl[i] = Cons1D_to_Prim1D(&Ul_x2Face[k][j][i],&Bx);
         Wr[i] = Cons1D_to_Prim1D(&Ur_x2Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul_x2Face[k][j][i],Ur_x2Face[k][j][i],Wl[i],Wr[i],Bx,
                &x2Flux[k][j][i]);
+#endif
       }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul_x2Face[k][j],Ur_x2Face[k][j],Wl,Wr,
+        Bxi,x2Flux[k][j],is-1,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
     }
   }
 
@@ -2563,6 +2820,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Compute 3D x3-fluxes from corrected L/R states.
  */
 
+#if defined(OPENMP) && !defined(H_CORRECTION)
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke+1; k++) {
     for (j=js-1; j<=je+1; j++) {
       for (i=is-1; i<=ie+1; i++) {
@@ -2580,13 +2840,21 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B3_x3Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Wl[i] = Cons1D_to_Prim1D(&Ul_x3Face[k][j][i],&Bx);
         Wr[i] = Cons1D_to_Prim1D(&Ur_x3Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul_x3Face[k][j][i],Ur_x3Face[k][j][i],Wl[i],Wr[i],Bx,
                &x3Flux[k][j][i]);
+#endif
       }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul_x3Face[k][j],Ur_x3Face[k][j],Wl,Wr,
+        Bxi,x3Flux[k][j],is-1,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
     }
   }
 
@@ -2688,6 +2956,9 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef MHD
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
@@ -2718,6 +2989,9 @@ void integrate_3d_ctu(DomainS *pD)
         dtodx3*(emf1[k+1][je+1][i  ] - emf1[k][je+1][i]);
     }
   }
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
 #ifdef CYLINDRICAL
@@ -2736,6 +3010,9 @@ void integrate_3d_ctu(DomainS *pD)
  * Add geometric source terms
  */
 #ifdef CYLINDRICAL
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
@@ -2743,7 +3020,7 @@ void integrate_3d_ctu(DomainS *pD)
         q2 = hdt/(r[i]*pG->dx2);
 
         /* calculate d at time n+1/2 */
-        dhalf[k][j][i] = pG->U[k][j][i].d 
+        dhalf[k][j][i] = UVAR(pG->U,k,j,i,d) 
           - q1*(rsf*x1Flux[k  ][j  ][i+1].d - lsf*x1Flux[k][j][i].d)
           - q2*(    x2Flux[k  ][j+1][i  ].d -     x2Flux[k][j][i].d)
           - q3*(    x3Flux[k+1][j  ][i  ].d -     x3Flux[k][j][i].d);
@@ -2751,8 +3028,8 @@ void integrate_3d_ctu(DomainS *pD)
 #ifdef FARGO
         dtodx2 = pG->dt/(r[i]*pG->dx2);
         /* Save current R/phi momenta */
-        Mrn = pG->U[k][j][i].M1;
-        Mpn = pG->U[k][j][i].M2;
+        Mrn = UVAR(pG->U,k,j,i,M1);
+        Mpn = UVAR(pG->U,k,j,i,M2);
 
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
@@ -2774,17 +3051,17 @@ void integrate_3d_ctu(DomainS *pD)
           phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
           phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
           g = (phir-phil)/pG->dx1;
-	  Mre -= pG->dt*pG->U[k][j][i].d*g;
+	  Mre -= pG->dt*UVAR(pG->U,k,j,i,d)*g;
 
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
-          Mpe -= dtodx2*(phir-phil)*pG->U[k][j][i].d;
+          Mpe -= dtodx2*(phir-phil)*UVAR(pG->U,k,j,i,d);
         }
 
-          Mre += pG->dt*pG->U[k][j][i].d*r[i]*SQR((*OrbitalProfile)(r[i]));
+          Mre += pG->dt*UVAR(pG->U,k,j,i,d)*r[i]*SQR((*OrbitalProfile)(r[i]));
 #ifdef ROTATING_FRAME
-          Mre += (pG->dt)*2.0*Omega_0*(pG->U[k][j][i].M2+pG->U[k][j][i].d*Om*x1vc(pG,i));
-          Mpe -= (pG->dt)*2.0*Omega_0*pG->U[k][j][i].M1;
+          Mre += (pG->dt)*2.0*Omega_0*(UVAR(pG->U,k,j,i,M2)+UVAR(pG->U,k,j,i,d)*Om*x1vc(pG,i));
+          Mpe -= (pG->dt)*2.0*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif
 
         /* Average forward euler and current values to approximate at t^{n+1/2} */
@@ -2796,12 +3073,12 @@ void integrate_3d_ctu(DomainS *pD)
 #else /* FARGO */
 
         /* calculate M1 and M2 at time n+1/2 */
-        M1h = pG->U[k][j][i].M1
+        M1h = UVAR(pG->U,k,j,i,M1)
            - q1*(rsf*x1Flux[k  ][j  ][i+1].Mx - lsf*x1Flux[k][j][i].Mx)
            - q2*(    x2Flux[k  ][j+1][i  ].Mz -     x2Flux[k][j][i].Mz)
            - q3*(    x3Flux[k+1][j  ][i  ].My -     x3Flux[k][j][i].My);
         M1h += hdt*geom_src[k][j][i];
-        M2h = pG->U[k][j][i].M2
+        M2h = UVAR(pG->U,k,j,i,M2)
            - q1*(SQR(rsf)*x1Flux[k  ][j  ][i+1].My - SQR(lsf)*x1Flux[k][j][i].My)
            - q2*(         x2Flux[k  ][j+1][i  ].Mx -          x2Flux[k][j][i].Mx)
            - q3*(         x3Flux[k+1][j  ][i  ].Mz -          x3Flux[k][j][i].Mz);
@@ -2811,15 +3088,15 @@ void integrate_3d_ctu(DomainS *pD)
           phir = (*StaticGravPot)((x1+0.5*pG->dx1),x2,x3);
           phil = (*StaticGravPot)((x1-0.5*pG->dx1),x2,x3);
           g = (phir-phil)/pG->dx1;
-          M1h -= hdt*pG->U[ks][j][i].d*g;
+          M1h -= hdt*UVAR(pG->U,ks,j,i,d)*g;
 
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
-          M2h -= q2*(phir-phil)*pG->U[k][j][i].d;
+          M2h -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
         }
 #ifdef ROTATING_FRAME
-          M1h += (pG->dt)*Omega_0*pG->U[ks][j][i].M2;
-          M2h -= (pG->dt)*Omega_0*pG->U[ks][j][i].M1;
+          M1h += (pG->dt)*Omega_0*UVAR(pG->U,ks,j,i,M2);
+          M2h -= (pG->dt)*Omega_0*UVAR(pG->U,ks,j,i,M1);
 #endif /*ROTATING_FRAME*/
 
         /* Compute geometric source term at time n+1/2 */
@@ -2845,18 +3122,18 @@ void integrate_3d_ctu(DomainS *pD)
 
 #ifdef FARGO
         /* Use average values to apply source terms for full time-step */
-        pG->U[k][j][i].M1 += pG->dt*( 2.0*Om*Mpav + geom_src[k][j][i]);
-        pG->U[k][j][i].M2 += pG->dt*( Om*(qshear-2.0)*Mrav);
+        UVAR(pG->U,k,j,i,M1) += pG->dt*( 2.0*Om*Mpav + geom_src[k][j][i]);
+        UVAR(pG->U,k,j,i,M2) += pG->dt*( Om*(qshear-2.0)*Mrav);
 #ifdef ROTATING_FRAME
-        pG->U[ks][j][i].M1 += (pG->dt)*2.0*Omega_0*(Mpav+dhalf[j][i]*Om*x1vc(pG,i));
-        pG->U[ks][j][i].M2 -= (pG->dt)*2.0*Omega_0*Mrav;
+        UVAR(pG->U,ks,j,i,M1) += (pG->dt)*2.0*Omega_0*(Mpav+dhalf[j][i]*Om*x1vc(pG,i));
+        UVAR(pG->U,ks,j,i,M2) -= (pG->dt)*2.0*Omega_0*Mrav;
 #endif
 #else /* FARGO */
         /* Add time-centered geometric source term for full dt */
-        pG->U[k][j][i].M1 += pG->dt*geom_src[k][j][i];
+        UVAR(pG->U,k,j,i,M1) += pG->dt*geom_src[k][j][i];
 #ifdef ROTATING_FRAME
-        pG->U[ks][j][i].M1 += (pG->dt)*2.0*Omega_0*M2h;
-        pG->U[ks][j][i].M2 -= (pG->dt)*2.0*Omega_0*M1h;
+        UVAR(pG->U,ks,j,i,M1) += (pG->dt)*2.0*Omega_0*M2h;
+        UVAR(pG->U,ks,j,i,M2) -= (pG->dt)*2.0*Omega_0*M1h;
 #endif /* ROTATING_FRAME */
 #endif /* FARGO */
       }
@@ -2882,11 +3159,11 @@ void integrate_3d_ctu(DomainS *pD)
         cc_pos(pG,i,j,k,&x1,&x2,&x3);
 
         /* Store the current state */
-        M1n  = pG->U[k][j][i].M1;
+        M1n  = UVAR(pG->U,k,j,i,M1);
 #ifdef FARGO
-        dM2n = pG->U[k][j][i].M2;
+        dM2n = UVAR(pG->U,k,j,i,M2);
 #else
-        dM2n = pG->U[k][j][i].M2 + qom*x1*pG->U[k][j][i].d;
+        dM2n = UVAR(pG->U,k,j,i,M2) + qom*x1*UVAR(pG->U,k,j,i,d);
 #endif
 
         /* Calculate the flux for the y-momentum fluctuation */
@@ -2923,11 +3200,11 @@ void integrate_3d_ctu(DomainS *pD)
  * potential momentum source terms using a Crank-Nicholson
  * discretization for the momentum fluctuation equation. */
 
-        pG->U[k][j][i].M1 += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
-        pG->U[k][j][i].M2 += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
+        UVAR(pG->U,k,j,i,M1) += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
+        UVAR(pG->U,k,j,i,M2) += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
 
 #ifndef FARGO
-        pG->U[k][j][i].M2 -= 0.5*qshear*om_dt*
+        UVAR(pG->U,k,j,i,M2) -= 0.5*qshear*om_dt*
             (x1Flux[k][j][i].d + x1Flux[k][j][i+1].d);
 #endif
 
@@ -2938,21 +3215,21 @@ void integrate_3d_ctu(DomainS *pD)
         phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,x3);
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
                                     x1Flux[k][j][i+1].d*(phir - phic));
 #endif
 
         phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),x3);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
                                     x2Flux[k][j+1][i].d*(phir - phic));
 #endif
 
         phir = (*ShearingBoxPot)(x1,x2,(x3+0.5*pG->dx3));
         phil = (*ShearingBoxPot)(x1,x2,(x3-0.5*pG->dx3));
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
                                     x3Flux[k+1][j][i].d*(phir - phic));
 #endif
       }
@@ -2961,6 +3238,9 @@ void integrate_3d_ctu(DomainS *pD)
 #endif /* SHEARING_BOX */
 
   if (StaticGravPot != NULL){
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
     for (k=ks; k<=ke; k++) {
       for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
@@ -2977,28 +3257,28 @@ void integrate_3d_ctu(DomainS *pD)
 #if defined(CYLINDRICAL) && defined(FARGO)
           g -= r[i]*SQR((*OrbitalProfile)(r[i]));
 #endif
-          pG->U[k][j][i].M1 -= pG->dt*dhalf[k][j][i]*g;
+          UVAR(pG->U,k,j,i,M1) -= pG->dt*dhalf[k][j][i]*g;
 #ifndef BAROTROPIC
 #ifdef CYLINDRICAL
-          pG->U[k][j][i].E -= hdt*g*(lsf*x1Flux[k][j][i  ].d +
+          UVAR(pG->U,k,j,i,E) -= hdt*g*(lsf*x1Flux[k][j][i  ].d +
                                      rsf*x1Flux[k][j][i+1].d);
 #else
-          pG->U[k][j][i].E -= dtodx1*(lsf*x1Flux[k][j][i  ].d*(phic - phil) +
+          UVAR(pG->U,k,j,i,E) -= dtodx1*(lsf*x1Flux[k][j][i  ].d*(phic - phil) +
                                       rsf*x1Flux[k][j][i+1].d*(phir - phic));
 #endif
 #endif
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
-          pG->U[k][j][i].M2 -= dtodx2*(phir-phil)*dhalf[k][j][i];
+          UVAR(pG->U,k,j,i,M2) -= dtodx2*(phir-phil)*dhalf[k][j][i];
 #ifndef BAROTROPIC
-          pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
+          UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
                                       x2Flux[k][j+1][i].d*(phir - phic));
 #endif
           phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
           phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
-          pG->U[k][j][i].M3 -= dtodx3*(phir-phil)*dhalf[k][j][i];
+          UVAR(pG->U,k,j,i,M3) -= dtodx3*(phir-phil)*dhalf[k][j][i];
 #ifndef BAROTROPIC
-          pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
+          UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
                                       x3Flux[k+1][j][i].d*(phir - phic));
 #endif
         }
@@ -3015,6 +3295,9 @@ void integrate_3d_ctu(DomainS *pD)
 #ifdef SELF_GRAVITY
 /* Add fluxes and source terms due to (d/dx1) terms  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=ie; i++){
@@ -3047,11 +3330,11 @@ void integrate_3d_ctu(DomainS *pD)
         flx_m3r = gxr*gzr/four_pi_G;
 
         /* Update momenta and energy with d/dx1 terms  */
-        pG->U[k][j][i].M1 -= dtodx1*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx1*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx1*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx1*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx1*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx1*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
                                     x1Flux[k][j][i+1].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -3060,6 +3343,9 @@ void integrate_3d_ctu(DomainS *pD)
 
 /* Add fluxes and source terms due to (d/dx2) terms  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=ie; i++){
@@ -3092,11 +3378,11 @@ void integrate_3d_ctu(DomainS *pD)
         flx_m3r = gyr*gzr/four_pi_G;
 
         /* Update momenta and energy with d/dx2 terms  */
-        pG->U[k][j][i].M1 -= dtodx2*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx2*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx2*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx2*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx2*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx2*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
                                     x2Flux[k][j+1][i].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -3105,6 +3391,9 @@ void integrate_3d_ctu(DomainS *pD)
 
 /* Add fluxes and source terms due to (d/dx3) terms  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++){
     for (j=js; j<=je; j++){
       for (i=is; i<=ie; i++){
@@ -3137,11 +3426,11 @@ void integrate_3d_ctu(DomainS *pD)
         flx_m3r = 0.5*(gzr*gzr-gxr*gxr-gyr*gyr)/four_pi_G + grav_mean_rho*phir;
 
 /* Update momenta and energy with d/dx3 terms  */
-        pG->U[k][j][i].M1 -= dtodx3*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx3*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx3*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx3*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx3*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx3*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
                                     x3Flux[k+1][j][i].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -3150,6 +3439,9 @@ void integrate_3d_ctu(DomainS *pD)
 
 /* Save mass fluxes in Grid structure for source term correction in main loop */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke+1; k++) {
     for (j=js; j<=je+1; j++) {
       for (i=is; i<=ie+1; i++) {
@@ -3167,11 +3459,14 @@ void integrate_3d_ctu(DomainS *pD)
 
 #ifndef BAROTROPIC
   if (CoolingFunc != NULL){
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
     for (k=ks; k<=ke; k++){
       for (j=js; j<=je; j++){
         for (i=is; i<=ie; i++){
           coolf = (*CoolingFunc)(dhalf[k][j][i],phalf[k][j][i],pG->dt);
-          pG->U[k][j][i].E -= pG->dt*coolf;
+          UVAR(pG->U,k,j,i,E) -= pG->dt*coolf;
         }
       }
     }
@@ -3186,11 +3481,11 @@ void integrate_3d_ctu(DomainS *pD)
   for (k=ks; k<=ke; k++)
     for (j=js; j<=je; j++)
       for (i=is; i<=ie; i++) {
-      pG->U[k][j][i].M1 -= pG->Coup[k][j][i].fb1;
-      pG->U[k][j][i].M2 -= pG->Coup[k][j][i].fb2;
-      pG->U[k][j][i].M3 -= pG->Coup[k][j][i].fb3;
+      UVAR(pG->U,k,j,i,M1) -= pG->Coup[k][j][i].fb1;
+      UVAR(pG->U,k,j,i,M2) -= pG->Coup[k][j][i].fb2;
+      UVAR(pG->U,k,j,i,M3) -= pG->Coup[k][j][i].fb3;
 #ifndef BAROTROPIC
-      pG->U[k][j][i].E += pG->Coup[k][j][i].Eloss;
+      UVAR(pG->U,k,j,i,E) += pG->Coup[k][j][i].Eloss;
       pG->Coup[k][j][i].Eloss *= dt1; /* for history output purpose */
       pG->Eloss[k][j][i] *= dt1; /* for history output purpose */
 #endif
@@ -3203,22 +3498,25 @@ void integrate_3d_ctu(DomainS *pD)
  * Update cell-centered variables in pG using 3D x1-Fluxes
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
 #ifdef CYLINDRICAL
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-        pG->U[k][j][i].d  -= dtodx1*(rsf*x1Flux[k][j][i+1].d -lsf*x1Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx1*(rsf*x1Flux[k][j][i+1].Mx-lsf*x1Flux[k][j][i].Mx);
-        pG->U[k][j][i].M2 -= dtodx1*(SQR(rsf)*x1Flux[k][j][i+1].My-SQR(lsf)*x1Flux[k][j][i].My);
-        pG->U[k][j][i].M3 -= dtodx1*(rsf*x1Flux[k][j][i+1].Mz-lsf*x1Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,d)  -= dtodx1*(rsf*x1Flux[k][j][i+1].d -lsf*x1Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx1*(rsf*x1Flux[k][j][i+1].Mx-lsf*x1Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M2) -= dtodx1*(SQR(rsf)*x1Flux[k][j][i+1].My-SQR(lsf)*x1Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M3) -= dtodx1*(rsf*x1Flux[k][j][i+1].Mz-lsf*x1Flux[k][j][i].Mz);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  -= dtodx1*(rsf*x1Flux[k][j][i+1].E -lsf*x1Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  -= dtodx1*(rsf*x1Flux[k][j][i+1].E -lsf*x1Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx1*(rsf*x1Flux[k][j][i+1].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx1*(rsf*x1Flux[k][j][i+1].s[n]
                                        - lsf*x1Flux[k][j][i  ].s[n]);
 #endif
       }
@@ -3229,22 +3527,25 @@ void integrate_3d_ctu(DomainS *pD)
  * Update cell-centered variables in pG using 3D x2-Fluxes
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
 #ifdef CYLINDRICAL
         dtodx2 = pG->dt/(r[i]*pG->dx2);
 #endif
-        pG->U[k][j][i].d  -= dtodx2*(x2Flux[k][j+1][i].d -x2Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx2*(x2Flux[k][j+1][i].Mz-x2Flux[k][j][i].Mz);
-        pG->U[k][j][i].M2 -= dtodx2*(x2Flux[k][j+1][i].Mx-x2Flux[k][j][i].Mx);
-        pG->U[k][j][i].M3 -= dtodx2*(x2Flux[k][j+1][i].My-x2Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,d)  -= dtodx2*(x2Flux[k][j+1][i].d -x2Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx2*(x2Flux[k][j+1][i].Mz-x2Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M2) -= dtodx2*(x2Flux[k][j+1][i].Mx-x2Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M3) -= dtodx2*(x2Flux[k][j+1][i].My-x2Flux[k][j][i].My);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -=dtodx2*(x2Flux[k][j+1][i].E -x2Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E) -=dtodx2*(x2Flux[k][j+1][i].E -x2Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx2*(x2Flux[k][j+1][i].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx2*(x2Flux[k][j+1][i].s[n]
                                        - x2Flux[k][j  ][i].s[n]);
 #endif
       }
@@ -3255,19 +3556,22 @@ void integrate_3d_ctu(DomainS *pD)
  * Update cell-centered variables in pG using 3D x3-Fluxes
  */
 
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        pG->U[k][j][i].d  -= dtodx3*(x3Flux[k+1][j][i].d -x3Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx3*(x3Flux[k+1][j][i].My-x3Flux[k][j][i].My);
-        pG->U[k][j][i].M2 -= dtodx3*(x3Flux[k+1][j][i].Mz-x3Flux[k][j][i].Mz);
-        pG->U[k][j][i].M3 -= dtodx3*(x3Flux[k+1][j][i].Mx-x3Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,d)  -= dtodx3*(x3Flux[k+1][j][i].d -x3Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx3*(x3Flux[k+1][j][i].My-x3Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M2) -= dtodx3*(x3Flux[k+1][j][i].Mz-x3Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M3) -= dtodx3*(x3Flux[k+1][j][i].Mx-x3Flux[k][j][i].Mx);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  -= dtodx3*(x3Flux[k+1][j][i].E -x3Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  -= dtodx3*(x3Flux[k+1][j][i].E -x3Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx3*(x3Flux[k+1][j][i].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx3*(x3Flux[k+1][j][i].s[n]
                                        - x3Flux[k  ][j][i].s[n]);
 #endif
       }
@@ -3279,15 +3583,18 @@ void integrate_3d_ctu(DomainS *pD)
  */
 
 #ifdef MHD
+#ifdef OPENMP
+#pragma omp parallel for private(CTU_OMP_PRIVATE) firstprivate(CTU_OMP_FIRSTPRIVATE)
+#endif
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
 #ifdef CYLINDRICAL
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-        pG->U[k][j][i].B1c = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
-        pG->U[k][j][i].B2c = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
-        pG->U[k][j][i].B3c = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
+        UVAR(pG->U,k,j,i,B1c) = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
+        UVAR(pG->U,k,j,i,B2c) = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
+        UVAR(pG->U,k,j,i,B3c) = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
       }
     }
   }
@@ -3589,6 +3896,7 @@ void integrate_3d_ctu(DomainS *pD)
   }
 
 #endif /* STATIC_MESH_REFINEMENT */
+  PERF_STOP(integrate_3d_perf);
   return;
 }
 
@@ -3598,7 +3906,7 @@ void integrate_3d_ctu(DomainS *pD)
 */
 void integrate_init_3d(MeshS *pM)
 {
-  int nmax,size1=0,size2=0,size3=0,nl,nd;
+  int nmax,size1=0,size2=0,size3=0,nl,nd,ierr=0;
 
 /* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
   for (nl=0; nl<(pM->NLevels); nl++){
@@ -3620,6 +3928,9 @@ void integrate_init_3d(MeshS *pM)
   size1 = size1 + 2*nghost;
   size2 = size2 + 2*nghost;
   size3 = size3 + 2*nghost;
+/* With blocking the arrays only have to span one block of k-planes */
+  if (integrate_3d_kblock() > 0)
+    size3 = MIN(size3, integrate_3d_kblock() + 2*nghost);
   nmax = MAX((MAX(size1,size2)),size3);
 
 #ifdef MHD
@@ -3646,9 +3957,6 @@ void integrate_init_3d(MeshS *pM)
     goto on_error;
 #endif /* H_CORRECTION */
 
-  if ((Bxc = (Real*)malloc(nmax*sizeof(Real))) == NULL) goto on_error;
-  if ((Bxi = (Real*)malloc(nmax*sizeof(Real))) == NULL) goto on_error;
-
 #ifdef MHD
   if ((B1_x1Face = (Real***)calloc_3d_array(size3,size2,size1, sizeof(Real)))
     == NULL) goto on_error;
@@ -3658,10 +3966,22 @@ void integrate_init_3d(MeshS *pM)
     == NULL) goto on_error;
 #endif /* MHD */
 
-  if ((U1d=(Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
-  if ((W  =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
-  if ((Wl =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
-  if ((Wr =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
+/* 1D scratch vectors, one set per OpenMP thread */
+#ifdef OPENMP
+#pragma omp parallel reduction(+:ierr)
+#endif
+  {
+    if ((Bxc = (Real*)malloc(nmax*sizeof(Real))) == NULL) ierr++;
+    if ((Bxi = (Real*)malloc(nmax*sizeof(Real))) == NULL) ierr++;
+    if ((U1d=(Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) ierr++;
+    if ((Ul =(Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) ierr++;
+    if ((Ur =(Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) ierr++;
+    if ((F1d=(Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) ierr++;
+    if ((W  =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) ierr++;
+    if ((Wl =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) ierr++;
+    if ((Wr =(Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) ierr++;
+  }
+  if (ierr > 0) goto on_error;
 
   if ((Ul_x1Face=(Cons1DS***)calloc_3d_array(size3,size2,size1,sizeof(Cons1DS)))
     == NULL) goto on_error;
@@ -3741,18 +4061,26 @@ void integrate_destruct_3d(void)
   if (eta3 != NULL) free_3d_array(eta3);
 #endif /* H_CORRECTION */
 
-  if (Bxc != NULL) free(Bxc);
-  if (Bxi != NULL) free(Bxi);
 #ifdef MHD
   if (B1_x1Face != NULL) free_3d_array(B1_x1Face);
   if (B2_x2Face != NULL) free_3d_array(B2_x2Face);
   if (B3_x3Face != NULL) free_3d_array(B3_x3Face);
 #endif /* MHD */
 
-  if (U1d      != NULL) free(U1d);
-  if (W        != NULL) free(W);
-  if (Wl       != NULL) free(Wl);
-  if (Wr       != NULL) free(Wr);
+#ifdef OPENMP
+#pragma omp parallel
+#endif
+  {
+    if (Bxc      != NULL) free(Bxc);
+    if (Bxi      != NULL) free(Bxi);
+    if (U1d      != NULL) free(U1d);
+    if (Ul       != NULL) free(Ul);
+    if (Ur       != NULL) free(Ur);
+    if (F1d      != NULL) free(F1d);
+    if (W        != NULL) free(W);
+    if (Wl       != NULL) free(Wl);
+    if (Wr       != NULL) free(Wr);
+  }
 
   if (Ul_x1Face != NULL) free_3d_array(Ul_x1Face);
   if (Ur_x1Face != NULL) free_3d_array(Ur_x1Face);
@@ -3802,6 +4130,9 @@ static void integrate_emf1_corner(const GridS *pG)
   int k, ks = pG->ks, ke = pG->ke;
   Real de1_l2, de1_r2, de1_l3, de1_r3;
 
+#ifdef OPENMP
+#pragma omp parallel for private(i,j,de1_l2,de1_r2,de1_l3,de1_r3)
+#endif
   for (k=ks-1; k<=ke+2; k++) {
     for (j=js-1; j<=je+2; j++) {
       for (i=is-2; i<=ie+2; i++) {
@@ -3871,6 +4202,9 @@ static void integrate_emf2_corner(const GridS *pG)
   int k, ks = pG->ks, ke = pG->ke;
   Real de2_l1, de2_r1, de2_l3, de2_r3;
 
+#ifdef OPENMP
+#pragma omp parallel for private(i,j,de2_l1,de2_r1,de2_l3,de2_r3)
+#endif
   for (k=ks-1; k<=ke+2; k++) {
     for (j=js-2; j<=je+2; j++) {
       for (i=is-1; i<=ie+2; i++) {
@@ -3941,6 +4275,9 @@ static void integrate_emf3_corner(const GridS *pG)
   Real de3_l1, de3_r1, de3_l2, de3_r2;
   Real rsf=1.0,lsf=1.0;
 
+#ifdef OPENMP
+#pragma omp parallel for private(i,j,de3_l1,de3_r1,de3_l2,de3_r2) firstprivate(rsf,lsf)
+#endif
   for (k=ks-2; k<=ke+2; k++) {
     for (j=js-1; j<=je+2; j++) {
       for (i=is-1; i<=ie+2; i++) {
@@ -67,7 +67,7 @@ static Real ***emf1_cc=NULL, ***emf2_cc=NULL, ***emf3_cc=NULL;
 /* 1D scratch vectors used by lr_states and flux functions */
 static Real *Bxc=NULL, *Bxi=NULL;
 static Prim1DS *W1d=NULL, *Wl=NULL, *Wr=NULL;
-static Cons1DS *U1d=NULL, *Ul=NULL, *Ur=NULL;
+static Cons1DS *U1d=NULL, *Ul=NULL, *Ur=NULL, *F1d=NULL;
 
 /* conserved variables at t^{n+1/2} computed in predict step */
 static ConsS ***Uhalf=NULL;
@@ -108,6 +108,9 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
 void integrate_3d_vl(DomainS *pD)
 {
   GridS *pG=(pD->Grid);
+#if defined(MHD) || defined(FIRST_ORDER_FLUX_CORRECTION)
+  ConsS U;
+#endif
   PrimS W,Whalf;
   Real dtodx1=pG->dt/pG->dx1, dtodx2=pG->dt/pG->dx2, dtodx3=pG->dt/pG->dx3;
   Real q1 = 0.5*dtodx1, q2 = 0.5*dtodx2, q3 = 0.5*dtodx3;
@@ -155,6 +158,8 @@ void integrate_3d_vl(DomainS *pD)
   Real lsf=1.0,rsf=1.0,g;
   Real dx1i=1.0/pG->dx1, dx2i=1.0/pG->dx2, dx3i=1.0/pG->dx3;
 
+  PERF_START(integrate_3d_perf);
+
 #if defined(CYLINDRICAL) && defined(FARGO)
   if (OrbitalProfile==NULL || ShearProfile==NULL)
     ath_error("[integrate_3d_vl]:  OrbitalProfile() and ShearProfile() *must* be defined.\n");
@@ -166,7 +171,7 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-nghost; k<=ke+nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        Uhalf[k][j][i] = pG->U[k][j][i];
+        Uhalf[k][j][i] = UCELL(pG->U,k,j,i);
 #ifdef MHD
         B1_x1Face[k][j][i] = pG->B1i[k][j][i];
         B2_x2Face[k][j][i] = pG->B2i[k][j][i];
@@ -176,6 +181,12 @@ void integrate_3d_vl(DomainS *pD)
     }
   }
 
+/* Convert to primitive variables once for all three sweeps (only in the
+ * ghost zones if new_dt() has filled the cache) */
+#ifdef PRIM_CACHE
+  Cons_to_Prim_Stage(pG);
+#endif
+
 /*=== STEP 1: Compute first-order fluxes at t^{n} in x1-direction ============*/
 /* No source terms are needed since there is no temporal evolution */
 
@@ -187,30 +198,51 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-nghost; k<=ke+nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-	U1d[i].d  = pG->U[k][j][i].d;
-	U1d[i].Mx = pG->U[k][j][i].M1;
-	U1d[i].My = pG->U[k][j][i].M2;
-	U1d[i].Mz = pG->U[k][j][i].M3;
+#ifdef PRIM_CACHE
+        W1d[i].d  = pG->W[k][j][i].d;
+        W1d[i].Vx = pG->W[k][j][i].V1;
+        W1d[i].Vy = pG->W[k][j][i].V2;
+        W1d[i].Vz = pG->W[k][j][i].V3;
 #ifndef BAROTROPIC
-	U1d[i].E  = pG->U[k][j][i].E;
+        W1d[i].P  = pG->W[k][j][i].P;
 #endif /* BAROTROPIC */
 #ifdef MHD
-	U1d[i].By = pG->U[k][j][i].B2c;
-	U1d[i].Bz = pG->U[k][j][i].B3c;
-        Bxc[i] = pG->U[k][j][i].B1c;
-        Bxi[i] = pG->B1i[k][j][i];
+        W1d[i].By = pG->W[k][j][i].B2c;
+        W1d[i].Bz = pG->W[k][j][i].B3c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[i].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
+        U1d[i].d  = UVAR(pG->U,k,j,i,d);
+        U1d[i].Mx = UVAR(pG->U,k,j,i,M1);
+        U1d[i].My = UVAR(pG->U,k,j,i,M2);
+        U1d[i].Mz = UVAR(pG->U,k,j,i,M3);
+#ifndef BAROTROPIC
+        U1d[i].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[i].By = UVAR(pG->U,k,j,i,B2c);
+        U1d[i].Bz = UVAR(pG->U,k,j,i,B3c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[i].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[i].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[i] = UVAR(pG->U,k,j,i,B1c);
+        Bxi[i] = pG->B1i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 1b ------------------------------------------------------------------
  * Compute first-order L/R states */
 
+#ifndef PRIM_CACHE
     for (i=is-nghost; i<=ie+nghost; i++) {
       W1d[i] = Cons1D_to_Prim1D(&U1d[i],&Bxc[i]);
     }
+#endif
 
     for (i=il; i<=ie+nghost; i++) {
       Wl[i] = W1d[i-1];
@@ -228,9 +260,9 @@ void integrate_3d_vl(DomainS *pD)
 /*--- Step 1d ------------------------------------------------------------------
  * Compute flux in x1-direction */
 
-      for (i=il; i<=ie+nghost; i++) {
-        fluxes(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&x1Flux[k][j][i]);
-      }
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,x1Flux[k][j],il,ie+nghost);
+      PERF_STOP(fluxes_perf);
     }
   }
 
@@ -245,30 +277,51 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-nghost; k<=ke+nghost; k++) {
     for (i=is-nghost; i<=ie+nghost; i++) {
       for (j=js-nghost; j<=je+nghost; j++) {
-	U1d[j].d  = pG->U[k][j][i].d;
-	U1d[j].Mx = pG->U[k][j][i].M2;
-	U1d[j].My = pG->U[k][j][i].M3;
-	U1d[j].Mz = pG->U[k][j][i].M1;
+#ifdef PRIM_CACHE
+        W1d[j].d  = pG->W[k][j][i].d;
+        W1d[j].Vx = pG->W[k][j][i].V2;
+        W1d[j].Vy = pG->W[k][j][i].V3;
+        W1d[j].Vz = pG->W[k][j][i].V1;
 #ifndef BAROTROPIC
-	U1d[j].E  = pG->U[k][j][i].E;
+        W1d[j].P  = pG->W[k][j][i].P;
 #endif /* BAROTROPIC */
 #ifdef MHD
-	U1d[j].By = pG->U[k][j][i].B3c;
-	U1d[j].Bz = pG->U[k][j][i].B1c;
-        Bxc[j] = pG->U[k][j][i].B2c;
-        Bxi[j] = pG->B2i[k][j][i];
+        W1d[j].By = pG->W[k][j][i].B3c;
+        W1d[j].Bz = pG->W[k][j][i].B1c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[j].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
+        U1d[j].d  = UVAR(pG->U,k,j,i,d);
+        U1d[j].Mx = UVAR(pG->U,k,j,i,M2);
+        U1d[j].My = UVAR(pG->U,k,j,i,M3);
+        U1d[j].Mz = UVAR(pG->U,k,j,i,M1);
+#ifndef BAROTROPIC
+        U1d[j].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[j].By = UVAR(pG->U,k,j,i,B3c);
+        U1d[j].Bz = UVAR(pG->U,k,j,i,B1c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[j].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[j].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[j] = UVAR(pG->U,k,j,i,B2c);
+        Bxi[j] = pG->B2i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 2b ------------------------------------------------------------------
  * Compute first-order L/R states */
 
+#ifndef PRIM_CACHE
       for (j=js-nghost; j<=je+nghost; j++) {
         W1d[j] = Cons1D_to_Prim1D(&U1d[j],&Bxc[j]);
       }
+#endif
 
       for (j=jl; j<=je+nghost; j++) {
         Wl[j] = W1d[j-1];
@@ -286,9 +339,10 @@ void integrate_3d_vl(DomainS *pD)
 /*--- Step 2d ------------------------------------------------------------------
  * Compute flux in x2-direction */
 
-      for (j=jl; j<=je+nghost; j++) {
-        fluxes(Ul[j],Ur[j],Wl[j],Wr[j],Bxi[j],&x2Flux[k][j][i]);
-      }
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,F1d,jl,je+nghost);
+      PERF_STOP(fluxes_perf);
+      for (j=jl; j<=je+nghost; j++) x2Flux[k][j][i] = F1d[j];
     }
   }
 
@@ -303,30 +357,51 @@ void integrate_3d_vl(DomainS *pD)
   for (j=js-nghost; j<=je+nghost; j++) {
     for (i=is-nghost; i<=ie+nghost; i++) {
       for (k=ks-nghost; k<=ke+nghost; k++) {
-	U1d[k].d  = pG->U[k][j][i].d;
-	U1d[k].Mx = pG->U[k][j][i].M3;
-	U1d[k].My = pG->U[k][j][i].M1;
-	U1d[k].Mz = pG->U[k][j][i].M2;
+#ifdef PRIM_CACHE
+        W1d[k].d  = pG->W[k][j][i].d;
+        W1d[k].Vx = pG->W[k][j][i].V3;
+        W1d[k].Vy = pG->W[k][j][i].V1;
+        W1d[k].Vz = pG->W[k][j][i].V2;
 #ifndef BAROTROPIC
-	U1d[k].E  = pG->U[k][j][i].E;
+        W1d[k].P  = pG->W[k][j][i].P;
 #endif /* BAROTROPIC */
 #ifdef MHD
-	U1d[k].By = pG->U[k][j][i].B1c;
-	U1d[k].Bz = pG->U[k][j][i].B2c;
-        Bxc[k] = pG->U[k][j][i].B3c;
-        Bxi[k] = pG->B3i[k][j][i];
+        W1d[k].By = pG->W[k][j][i].B1c;
+        W1d[k].Bz = pG->W[k][j][i].B2c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[k].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
+        U1d[k].d  = UVAR(pG->U,k,j,i,d);
+        U1d[k].Mx = UVAR(pG->U,k,j,i,M3);
+        U1d[k].My = UVAR(pG->U,k,j,i,M1);
+        U1d[k].Mz = UVAR(pG->U,k,j,i,M2);
+#ifndef BAROTROPIC
+        U1d[k].E  = UVAR(pG->U,k,j,i,E);
+#endif /* BAROTROPIC */
+#ifdef MHD
+        U1d[k].By = UVAR(pG->U,k,j,i,B1c);
+        U1d[k].Bz = UVAR(pG->U,k,j,i,B2c);
 #endif /* MHD */
 #if (NSCALARS > 0)
-        for (n=0; n<NSCALARS; n++) U1d[k].s[n] = pG->U[k][j][i].s[n];
+        for (n=0; n<NSCALARS; n++) U1d[k].s[n] = UVAR(pG->U,k,j,i,s[n]);
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[k] = UVAR(pG->U,k,j,i,B3c);
+        Bxi[k] = pG->B3i[k][j][i];
+#endif /* MHD */
       }
 
 /*--- Step 3b ------------------------------------------------------------------
  * Compute first-order L/R states */      
         
+#ifndef PRIM_CACHE
       for (k=ks-nghost; k<=ke+nghost; k++) {
         W1d[k] = Cons1D_to_Prim1D(&U1d[k],&Bxc[k]);
       }
+#endif
 
       for (k=kl; k<=ke+nghost; k++) { 
         Wl[k] = W1d[k-1];
@@ -344,9 +419,10 @@ void integrate_3d_vl(DomainS *pD)
 /*--- Step 3d ------------------------------------------------------------------
  * Compute flux in x1-direction */
 
-      for (k=kl; k<=ke+nghost; k++) {
-        fluxes(Ul[k],Ur[k],Wl[k],Wr[k],Bxi[k],&x3Flux[k][j][i]);
-      }
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl,Wr,Bxi,F1d,kl,ke+nghost);
+      PERF_STOP(fluxes_perf);
+      for (k=kl; k<=ke+nghost; k++) x3Flux[k][j][i] = F1d[k];
     }
   }
 
@@ -361,7 +437,8 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-nghost; k<=ke+nghost; k++) {
     for (j=js-nghost; j<=je+nghost; j++) {
       for (i=is-nghost; i<=ie+nghost; i++) {
-        Whalf = Cons_to_Prim(&pG->U[k][j][i]);
+        U = UCELL(pG->U,k,j,i);
+        Whalf = Cons_to_Prim(&U);
         emf1_cc[k][j][i] = (Whalf.B2c*Whalf.V3 - Whalf.B3c*Whalf.V2);
         emf2_cc[k][j][i] = (Whalf.B3c*Whalf.V1 - Whalf.B1c*Whalf.V3);
         emf3_cc[k][j][i] = (Whalf.B1c*Whalf.V2 - Whalf.B2c*Whalf.V1);
@@ -635,7 +712,7 @@ void integrate_3d_vl(DomainS *pD)
           g -= r[i]*SQR((*OrbitalProfile)(r[i]));
 #endif
 #endif /* CYLINDRICAL */
-          Uhalf[k][j][i].M1 -= hdt*pG->U[k][j][i].d*g;
+          Uhalf[k][j][i].M1 -= hdt*UVAR(pG->U,k,j,i,d)*g;
 #ifndef BAROTROPIC
           Uhalf[k][j][i].E -= q1*(lsf*x1Flux[k][j][i  ].d*(phic - phil)
                                 + rsf*x1Flux[k][j][i+1].d*(phir - phic));
@@ -643,7 +720,7 @@ void integrate_3d_vl(DomainS *pD)
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
 
-          Uhalf[k][j][i].M2 -= q2*(phir-phil)*pG->U[k][j][i].d;
+          Uhalf[k][j][i].M2 -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
           Uhalf[k][j][i].E -= q2*(x2Flux[k][j  ][i].d*(phic - phil)
                                 + x2Flux[k][j+1][i].d*(phir - phic));
@@ -651,7 +728,7 @@ void integrate_3d_vl(DomainS *pD)
           phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
           phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
 
-          Uhalf[k][j][i].M3 -= q3*(phir-phil)*pG->U[k][j][i].d;
+          Uhalf[k][j][i].M3 -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
           Uhalf[k][j][i].E -= q3*(x3Flux[k  ][j][i].d*(phic - phil)
                                 + x3Flux[k+1][j][i].d*(phir - phic));
@@ -674,7 +751,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i+1]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j][i-1]);
 
-        Uhalf[k][j][i].M1 -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Uhalf[k][j][i].M1 -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q1*(x1Flux[k][j][i  ].d*(phic - phil)
                               + x1Flux[k][j][i+1].d*(phir - phic));
@@ -682,7 +759,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j+1][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k][j-1][i]);
 
-        Uhalf[k][j][i].M2 -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Uhalf[k][j][i].M2 -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q2*(x2Flux[k][j  ][i].d*(phic - phil)
                               + x2Flux[k][j+1][i].d*(phir - phic));
@@ -690,7 +767,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = 0.5*(pG->Phi[k][j][i] + pG->Phi[k+1][j][i]);
         phil = 0.5*(pG->Phi[k][j][i] + pG->Phi[k-1][j][i]);
 
-        Uhalf[k][j][i].M3 -= q3*(phir-phil)*pG->U[k][j][i].d; 
+        Uhalf[k][j][i].M3 -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d); 
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q3*(x3Flux[k  ][j][i].d*(phic - phil)
                               + x3Flux[k+1][j][i].d*(phir - phic));
@@ -718,7 +795,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,x3);
         phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
 
-        Uhalf[k][j][i].M1 -= q1*(phir-phil)*pG->U[k][j][i].d;
+        Uhalf[k][j][i].M1 -= q1*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q1*(x1Flux[k][j][i  ].d*(phic - phil)
                               + x1Flux[k][j][i+1].d*(phir - phic));
@@ -726,7 +803,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),x3);
         phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),x3);
 
-        Uhalf[k][j][i].M2 -= q2*(phir-phil)*pG->U[k][j][i].d;
+        Uhalf[k][j][i].M2 -= q2*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q2*(x2Flux[k][j  ][i].d*(phic - phil)
                               + x2Flux[k][j+1][i].d*(phir - phic));
@@ -734,7 +811,7 @@ void integrate_3d_vl(DomainS *pD)
         phir = (*ShearingBoxPot)(x1,x2,(x3+0.5*pG->dx3));
         phil = (*ShearingBoxPot)(x1,x2,(x3-0.5*pG->dx3));
 
-        Uhalf[k][j][i].M3 -= q3*(phir-phil)*pG->U[k][j][i].d;
+        Uhalf[k][j][i].M3 -= q3*(phir-phil)*UVAR(pG->U,k,j,i,d);
 #ifndef BAROTROPIC
         Uhalf[k][j][i].E -= q3*(x3Flux[k  ][j][i].d*(phic - phil)
                               + x3Flux[k+1][j][i].d*(phir - phic));
@@ -746,11 +823,11 @@ void integrate_3d_vl(DomainS *pD)
   for (k=kl; k<=ku; k++) {
     for (j=jl; j<=ju; j++) {
       for (i=il; i<=iu; i++) {
-        Uhalf[k][j][i].M1 += pG->dt*Omega_0*pG->U[k][j][i].M2;
+        Uhalf[k][j][i].M1 += pG->dt*Omega_0*UVAR(pG->U,k,j,i,M2);
 #ifdef FARGO
-        Uhalf[k][j][i].M2 += hdt*(qshear-2.)*Omega_0*pG->U[k][j][i].M1;
+        Uhalf[k][j][i].M2 += hdt*(qshear-2.)*Omega_0*UVAR(pG->U,k,j,i,M1);
 #else
-        Uhalf[k][j][i].M2 -= pG->dt*Omega_0*pG->U[k][j][i].M1;
+        Uhalf[k][j][i].M2 -= pG->dt*Omega_0*UVAR(pG->U,k,j,i,M1);
 #endif
       }
     }
@@ -764,8 +841,8 @@ void integrate_3d_vl(DomainS *pD)
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
         /* This *is* a half-timestep update below (see note above) */
-        Uhalf[k][j][i].M1 += pG->dt*Om*pG->U[k][j][i].M2;
-        Uhalf[k][j][i].M2 += hdt*(qshear - 2.0)*Om*pG->U[k][j][i].M1;
+        Uhalf[k][j][i].M1 += pG->dt*Om*UVAR(pG->U,k,j,i,M2);
+        Uhalf[k][j][i].M2 += hdt*(qshear - 2.0)*Om*UVAR(pG->U,k,j,i,M1);
       }
     }
   }
@@ -781,29 +858,35 @@ void integrate_3d_vl(DomainS *pD)
     for (j=jl; j<=ju; j++) {
       for (i=il; i<=iu; i++) {
 
-        Ekin = 0.5*(SQR(pG->U[k][j][i].M1)+SQR(pG->U[k][j][i].M2)+SQR(pG->U[k][j][i].M3))/pG->U[k][j][i].d;
+        Ekin = 0.5*(SQR(UVAR(pG->U,k,j,i,M1))+SQR(UVAR(pG->U,k,j,i,M2))+SQR(UVAR(pG->U,k,j,i,M3)))/UVAR(pG->U,k,j,i,d);
 #ifdef MHD
-        B2sq = SQR(pG->U[k][j][i].B2c);
-        Emag = 0.5*(SQR(pG->U[k][j][i].B1c) + B2sq + SQR(pG->U[k][j][i].B3c));
+        B2sq = SQR(UVAR(pG->U,k,j,i,B2c));
+        Emag = 0.5*(SQR(UVAR(pG->U,k,j,i,B1c)) + B2sq + SQR(UVAR(pG->U,k,j,i,B3c)));
 #else
         B2sq = 0.0;
         Emag = 0.0;
 #endif
 
 #ifdef ISOTHERMAL
-        Ptot = Iso_csound2*pG->U[k][j][i].d;
+        Ptot = Iso_csound2*UVAR(pG->U,k,j,i,d);
 #else
-        Ptot = Gamma_1*(pG->U[k][j][i].E - Ekin - Emag);
+        Ptot = Gamma_1*(UVAR(pG->U,k,j,i,E) - Ekin - Emag);
 #endif
         Ptot = MAX(Ptot,TINY_NUMBER);
         Ptot += Emag;
 
-        Uhalf[k][j][i].M1 += hdt*(SQR(pG->U[k][j][i].M2)/pG->U[k][j][i].d - B2sq + Ptot)/r[i];
+        Uhalf[k][j][i].M1 += hdt*(SQR(UVAR(pG->U,k,j,i,M2))/UVAR(pG->U,k,j,i,d) - B2sq + Ptot)/r[i];
       }
     }
   }
 #endif /* CYLINDRICAL */
 
+/* Convert half-step variables to primitives once for steps 7-9 */
+#ifdef PRIM_CACHE
+  Cons_to_Prim_Array(Uhalf,pG->W,is-nghost,ie+nghost,js-nghost,je+nghost,
+                     ks-nghost,ke+nghost);
+#endif
+
 /*=== STEP 7: Compute second-order L/R x1-interface states ===================*/
 
 /*--- Step 7a ------------------------------------------------------------------
@@ -814,6 +897,22 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-1; k<=ke+1; k++) {
     for (j=js-1; j<=je+1; j++) {
       for (i=il; i<=iu; i++) {
+#ifdef PRIM_CACHE
+        W1d[i].d  = pG->W[k][j][i].d;
+        W1d[i].Vx = pG->W[k][j][i].V1;
+        W1d[i].Vy = pG->W[k][j][i].V2;
+        W1d[i].Vz = pG->W[k][j][i].V3;
+#ifndef BAROTROPIC
+        W1d[i].P  = pG->W[k][j][i].P;
+#endif /* BAROTROPIC */
+#ifdef MHD
+        W1d[i].By = pG->W[k][j][i].B2c;
+        W1d[i].Bz = pG->W[k][j][i].B3c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[i].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
         U1d[i].d  = Uhalf[k][j][i].d;
         U1d[i].Mx = Uhalf[k][j][i].M1;
         U1d[i].My = Uhalf[k][j][i].M2;
@@ -824,22 +923,29 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef MHD
         U1d[i].By = Uhalf[k][j][i].B2c;
         U1d[i].Bz = Uhalf[k][j][i].B3c;
-        Bxc[i] = Uhalf[k][j][i].B1c;
 #endif /* MHD */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) U1d[i].s[n] = Uhalf[k][j][i].s[n];
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[i] = Uhalf[k][j][i].B1c;
+#endif /* MHD */
       }
 
 /*--- Step 7b ------------------------------------------------------------------
  * Compute L and R states at x1-interfaces, store in 3D array
  */
 
+#ifndef PRIM_CACHE
       for (i=il; i<=iu; i++) {
         W1d[i] = Cons1D_to_Prim1D(&U1d[i],&Bxc[i]);
       }
+#endif
 
+      PERF_START(lr_states_perf);
       lr_states(pG,W1d,Bxc,pG->dt,pG->dx1,is,ie,Wl,Wr,1);
+      PERF_STOP(lr_states_perf);
 
       for (i=is; i<=ie+1; i++) {
         Wl_x1Face[k][j][i] = Wl[i];
@@ -858,6 +964,22 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks-1; k<=ke+1; k++) {
     for (i=is-1; i<=ie+1; i++) {
       for (j=jl; j<=ju; j++) {
+#ifdef PRIM_CACHE
+        W1d[j].d  = pG->W[k][j][i].d;
+        W1d[j].Vx = pG->W[k][j][i].V2;
+        W1d[j].Vy = pG->W[k][j][i].V3;
+        W1d[j].Vz = pG->W[k][j][i].V1;
+#ifndef BAROTROPIC
+        W1d[j].P  = pG->W[k][j][i].P;
+#endif /* BAROTROPIC */
+#ifdef MHD
+        W1d[j].By = pG->W[k][j][i].B3c;
+        W1d[j].Bz = pG->W[k][j][i].B1c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[j].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
         U1d[j].d  = Uhalf[k][j][i].d;
         U1d[j].Mx = Uhalf[k][j][i].M2;
         U1d[j].My = Uhalf[k][j][i].M3;
@@ -868,25 +990,32 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef MHD
         U1d[j].By = Uhalf[k][j][i].B3c;
         U1d[j].Bz = Uhalf[k][j][i].B1c;
-        Bxc[j] = Uhalf[k][j][i].B2c;
 #endif /* MHD */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) U1d[j].s[n] = Uhalf[k][j][i].s[n];
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[j] = Uhalf[k][j][i].B2c;
+#endif /* MHD */
       }
 
 /*--- Step 8b ------------------------------------------------------------------
  * Compute L and R states at x2-interfaces, store in 3D array
  */
 
+#ifndef PRIM_CACHE
       for (j=jl; j<=ju; j++) {
         W1d[j] = Cons1D_to_Prim1D(&U1d[j],&Bxc[j]);
       }
+#endif
 
 #ifdef CYLINDRICAL
       dx2 = r[i]*pG->dx2;
 #endif
+      PERF_START(lr_states_perf);
       lr_states(pG,W1d,Bxc,pG->dt,dx2,js,je,Wl,Wr,2);
+      PERF_STOP(lr_states_perf);
 
       for (j=js; j<=je+1; j++) {
         Wl_x2Face[k][j][i] = Wl[j];
@@ -905,6 +1034,22 @@ void integrate_3d_vl(DomainS *pD)
   for (j=js-1; j<=je+1; j++) {
     for (i=is-1; i<=ie+1; i++) {
       for (k=kl; k<=ku; k++) {
+#ifdef PRIM_CACHE
+        W1d[k].d  = pG->W[k][j][i].d;
+        W1d[k].Vx = pG->W[k][j][i].V3;
+        W1d[k].Vy = pG->W[k][j][i].V1;
+        W1d[k].Vz = pG->W[k][j][i].V2;
+#ifndef BAROTROPIC
+        W1d[k].P  = pG->W[k][j][i].P;
+#endif /* BAROTROPIC */
+#ifdef MHD
+        W1d[k].By = pG->W[k][j][i].B1c;
+        W1d[k].Bz = pG->W[k][j][i].B2c;
+#endif /* MHD */
+#if (NSCALARS > 0)
+        for (n=0; n<NSCALARS; n++) W1d[k].r[n] = pG->W[k][j][i].r[n];
+#endif
+#else
         U1d[k].d  = Uhalf[k][j][i].d;
         U1d[k].Mx = Uhalf[k][j][i].M3;
         U1d[k].My = Uhalf[k][j][i].M1;
@@ -915,22 +1060,29 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef MHD
         U1d[k].By = Uhalf[k][j][i].B1c;
         U1d[k].Bz = Uhalf[k][j][i].B2c;
-        Bxc[k] = Uhalf[k][j][i].B3c;
 #endif /* MHD */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) U1d[k].s[n] = Uhalf[k][j][i].s[n];
 #endif
+#endif /* PRIM_CACHE */
+#ifdef MHD
+        Bxc[k] = Uhalf[k][j][i].B3c;
+#endif /* MHD */
       }
 
 /*--- Step 9b ------------------------------------------------------------------
  * Compute L and R states at x3-interfaces, store in 3D array
  */
 
+#ifndef PRIM_CACHE
       for (k=kl; k<=ku; k++) {
         W1d[k] = Cons1D_to_Prim1D(&U1d[k],&Bxc[k]);
       }
+#endif
 
+      PERF_START(lr_states_perf);
       lr_states(pG,W1d,Bxc,pG->dt,pG->dx3,ks,ke,Wl,Wr,3);
+      PERF_STOP(lr_states_perf);
 
       for (k=ks; k<=ke+1; k++) {
         Wl_x3Face[k][j][i] = Wl[k];
@@ -1014,14 +1166,23 @@ void integrate_3d_vl(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B1_x1Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Ul[i] = Prim1D_to_Cons1D(&Wl_x1Face[k][j][i],&Bx);
         Ur[i] = Prim1D_to_Cons1D(&Wr_x1Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul[i],Ur[i],Wl_x1Face[k][j][i],Wr_x1Face[k][j][i],Bx,
                &x1Flux[k][j][i]);
-
+#endif
+      }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl_x1Face[k][j],Wr_x1Face[k][j],
+        Bxi,x1Flux[k][j],is,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
 #ifdef FIRST_ORDER_FLUX_CORRECTION
+      for (i=is; i<=ie+1; i++) {
 /* revert to predictor flux if this flux Nan'ed */
         if ((x1Flux[k][j][i].d  != x1Flux[k][j][i].d)  ||
 #ifndef BAROTROPIC
@@ -1037,9 +1198,8 @@ void integrate_3d_vl(DomainS *pD)
           x1Flux[k][j][i] = x1FluxP[k][j][i];
           NaNFlux++;
         }
-#endif
-
       }
+#endif
     }
   }
 
@@ -1064,14 +1224,23 @@ void integrate_3d_vl(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B2_x2Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Ul[i] = Prim1D_to_Cons1D(&Wl_x2Face[k][j][i],&Bx);
         Ur[i] = Prim1D_to_Cons1D(&Wr_x2Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul[i],Ur[i],Wl_x2Face[k][j][i],Wr_x2Face[k][j][i],Bx,
                &x2Flux[k][j][i]);
-
+#endif
+      }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl_x2Face[k][j],Wr_x2Face[k][j],
+        Bxi,x2Flux[k][j],is-1,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
 #ifdef FIRST_ORDER_FLUX_CORRECTION
+      for (i=is-1; i<=ie+1; i++) {
 /* revert to predictor flux if this flux NaN'ed */
         if ((x2Flux[k][j][i].d  != x2Flux[k][j][i].d)  ||
 #ifndef BAROTROPIC
@@ -1087,9 +1256,8 @@ void integrate_3d_vl(DomainS *pD)
           x2Flux[k][j][i] = x2FluxP[k][j][i];
           NaNFlux++;
         }
-#endif
-
       }
+#endif
     }
   }
 
@@ -1114,14 +1282,23 @@ void integrate_3d_vl(DomainS *pD)
 #endif /* H_CORRECTION */
 #ifdef MHD
         Bx = B3_x3Face[k][j][i];
+        Bxi[i] = Bx;
 #endif
         Ul[i] = Prim1D_to_Cons1D(&Wl_x3Face[k][j][i],&Bx);
         Ur[i] = Prim1D_to_Cons1D(&Wr_x3Face[k][j][i],&Bx);
-
+#ifdef H_CORRECTION
         fluxes(Ul[i],Ur[i],Wl_x3Face[k][j][i],Wr_x3Face[k][j][i],Bx,
                &x3Flux[k][j][i]);
-
+#endif
+      }
+#ifndef H_CORRECTION
+      PERF_START(fluxes_perf);
+      fluxes_pencil(Ul,Ur,Wl_x3Face[k][j],Wr_x3Face[k][j],
+        Bxi,x3Flux[k][j],is-1,ie+1);
+      PERF_STOP(fluxes_perf);
+#endif
 #ifdef FIRST_ORDER_FLUX_CORRECTION
+      for (i=is-1; i<=ie+1; i++) {
 /* revert to predictor flux if this flux NaN'ed */
         if ((x3Flux[k][j][i].d  != x3Flux[k][j][i].d)  ||
 #ifndef BAROTROPIC
@@ -1137,9 +1314,8 @@ void integrate_3d_vl(DomainS *pD)
           x3Flux[k][j][i] = x3FluxP[k][j][i];
           NaNFlux++;
         }
-#endif
-
       }
+#endif
     }
   }
 
@@ -1318,9 +1494,9 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-        pG->U[k][j][i].B1c = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
-        pG->U[k][j][i].B2c = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
-        pG->U[k][j][i].B3c = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
+        UVAR(pG->U,k,j,i,B1c) = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
+        UVAR(pG->U,k,j,i,B2c) = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
+        UVAR(pG->U,k,j,i,B3c) = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
       }
     }
   }
@@ -1345,11 +1521,11 @@ void integrate_3d_vl(DomainS *pD)
 	cc_pos(pG,i,j,k,&x1,&x2,&x3);
 
 /* Store the current state */
-	M1n  = pG->U[k][j][i].M1;
+	M1n  = UVAR(pG->U,k,j,i,M1);
 #ifdef FARGO
-	dM2n = pG->U[k][j][i].M2;
+	dM2n = UVAR(pG->U,k,j,i,M2);
 #else
-	dM2n = pG->U[k][j][i].M2 + qom*x1*pG->U[k][j][i].d;
+	dM2n = UVAR(pG->U,k,j,i,M2) + qom*x1*UVAR(pG->U,k,j,i,d);
 #endif
 
 /* Calculate the flux for the y-momentum fluctuation */
@@ -1381,11 +1557,11 @@ void integrate_3d_vl(DomainS *pD)
  * potential momentum source terms using a Crank-Nicholson
  * discretization for the momentum fluctuation equation. */
 
-	pG->U[k][j][i].M1 += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
-	pG->U[k][j][i].M2 += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
+	UVAR(pG->U,k,j,i,M1) += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
+	UVAR(pG->U,k,j,i,M2) += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
 
 #ifndef FARGO
-	pG->U[k][j][i].M2 -= 0.5*qshear*om_dt*
+	UVAR(pG->U,k,j,i,M2) -= 0.5*qshear*om_dt*
            (x1Flux[k][j][i].d + x1Flux[k][j][i+1].d);
 #endif
 
@@ -1396,21 +1572,21 @@ void integrate_3d_vl(DomainS *pD)
 	phir = (*ShearingBoxPot)((x1+0.5*pG->dx1),x2,x3);
 	phil = (*ShearingBoxPot)((x1-0.5*pG->dx1),x2,x3);
 #ifndef BAROTROPIC
-	pG->U[k][j][i].E -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
+	UVAR(pG->U,k,j,i,E) -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
                                     x1Flux[k][j][i+1].d*(phir - phic));
 #endif
 
 	phir = (*ShearingBoxPot)(x1,(x2+0.5*pG->dx2),x3);
 	phil = (*ShearingBoxPot)(x1,(x2-0.5*pG->dx2),x3);
 #ifndef BAROTROPIC
-	pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
+	UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
                                     x2Flux[k][j+1][i].d*(phir - phic));
 #endif
 
 	phir = (*ShearingBoxPot)(x1,x2,(x3+0.5*pG->dx3));
 	phil = (*ShearingBoxPot)(x1,x2,(x3-0.5*pG->dx3));
 #ifndef BAROTROPIC
-	pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
+	UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
                                     x3Flux[k+1][j][i].d*(phir - phic));
 #endif
       }
@@ -1436,25 +1612,25 @@ void integrate_3d_vl(DomainS *pD)
           g -= r[i]*SQR((*OrbitalProfile)(r[i]));
 #endif
 #endif
-          pG->U[k][j][i].M1 -= pG->dt*Uhalf[k][j][i].d*g;
+          UVAR(pG->U,k,j,i,M1) -= pG->dt*Uhalf[k][j][i].d*g;
 #ifndef BAROTROPIC
-          pG->U[k][j][i].E -= dtodx1*(lsf*x1Flux[k][j][i  ].d*(phic - phil)
+          UVAR(pG->U,k,j,i,E) -= dtodx1*(lsf*x1Flux[k][j][i  ].d*(phic - phil)
                                     + rsf*x1Flux[k][j][i+1].d*(phir - phic));
 #endif
           phir = (*StaticGravPot)(x1,(x2+0.5*pG->dx2),x3);
           phil = (*StaticGravPot)(x1,(x2-0.5*pG->dx2),x3);
 
-          pG->U[k][j][i].M2 -= dtodx2*(phir-phil)*Uhalf[k][j][i].d;
+          UVAR(pG->U,k,j,i,M2) -= dtodx2*(phir-phil)*Uhalf[k][j][i].d;
 #ifndef BAROTROPIC
-          pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil)
+          UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil)
                                     + x2Flux[k][j+1][i].d*(phir - phic));
 #endif
           phir = (*StaticGravPot)(x1,x2,(x3+0.5*pG->dx3));
           phil = (*StaticGravPot)(x1,x2,(x3-0.5*pG->dx3));
 
-          pG->U[k][j][i].M3 -= dtodx3*(phir-phil)*Uhalf[k][j][i].d;
+          UVAR(pG->U,k,j,i,M3) -= dtodx3*(phir-phil)*Uhalf[k][j][i].d;
 #ifndef BAROTROPIC
-          pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil)
+          UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil)
                                     + x3Flux[k+1][j][i].d*(phir - phic));
 #endif
         }
@@ -1503,11 +1679,11 @@ void integrate_3d_vl(DomainS *pD)
         flx_m3r = gxr*gzr/four_pi_G;
 
 /* Update momenta and energy with d/dx1 terms  */
-        pG->U[k][j][i].M1 -= dtodx1*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx1*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx1*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx1*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx1*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx1*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx1*(x1Flux[k][j][i  ].d*(phic - phil) +
                                     x1Flux[k][j][i+1].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -1548,11 +1724,11 @@ void integrate_3d_vl(DomainS *pD)
         flx_m3r = gyr*gzr/four_pi_G;
 
 /* Update momenta and energy with d/dx2 terms  */
-        pG->U[k][j][i].M1 -= dtodx2*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx2*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx2*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx2*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx2*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx2*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx2*(x2Flux[k][j  ][i].d*(phic - phil) +
                                     x2Flux[k][j+1][i].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -1593,11 +1769,11 @@ void integrate_3d_vl(DomainS *pD)
         flx_m3r = 0.5*(gzr*gzr-gxr*gxr-gyr*gyr)/four_pi_G + grav_mean_rho*phir;
 
 /* Update momenta and energy with d/dx3 terms  */
-        pG->U[k][j][i].M1 -= dtodx3*(flx_m1r - flx_m1l);
-        pG->U[k][j][i].M2 -= dtodx3*(flx_m2r - flx_m2l);
-        pG->U[k][j][i].M3 -= dtodx3*(flx_m3r - flx_m3l);
+        UVAR(pG->U,k,j,i,M1) -= dtodx3*(flx_m1r - flx_m1l);
+        UVAR(pG->U,k,j,i,M2) -= dtodx3*(flx_m2r - flx_m2l);
+        UVAR(pG->U,k,j,i,M3) -= dtodx3*(flx_m3r - flx_m3l);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
+        UVAR(pG->U,k,j,i,E) -= dtodx3*(x3Flux[k  ][j][i].d*(phic - phil) +
                                     x3Flux[k+1][j][i].d*(phir - phic));
 #endif /* BAROTROPIC */
       }
@@ -1644,14 +1820,14 @@ void integrate_3d_vl(DomainS *pD)
         Ptot = MAX(Ptot,TINY_NUMBER);
         Ptot += Emag;
 
-        pG->U[k][j][i].M1 += pG->dt*(SQR(Uhalf[k][j][i].M2)/Uhalf[k][j][i].d - B2sq + Ptot)/r[i];
+        UVAR(pG->U,k,j,i,M1) += pG->dt*(SQR(Uhalf[k][j][i].M2)/Uhalf[k][j][i].d - B2sq + Ptot)/r[i];
 
 #ifdef FARGO
         /* Use average values to apply source terms for full time-step */
         Om = (*OrbitalProfile)(r[i]);
         qshear = (*ShearProfile)(r[i]);
-        pG->U[k][j][i].M1 += pG->dt*(2.0*Om*Uhalf[k][j][i].M2);
-        pG->U[k][j][i].M2 += pG->dt*(Om*(qshear-2.0)*Uhalf[k][j][i].M1);
+        UVAR(pG->U,k,j,i,M1) += pG->dt*(2.0*Om*Uhalf[k][j][i].M2);
+        UVAR(pG->U,k,j,i,M2) += pG->dt*(Om*(qshear-2.0)*Uhalf[k][j][i].M1);
 #endif /* FARGO */
       }
     }
@@ -1670,16 +1846,16 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
         rsf = ri[i+1]/r[i];  lsf = ri[i]/r[i];
 #endif
-        pG->U[k][j][i].d  -= dtodx1*(rsf*x1Flux[k][j][i+1].d  - lsf*x1Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx1*(rsf*x1Flux[k][j][i+1].Mx - lsf*x1Flux[k][j][i].Mx);
-        pG->U[k][j][i].M2 -= dtodx1*(SQR(rsf)*x1Flux[k][j][i+1].My - SQR(lsf)*x1Flux[k][j][i].My);
-        pG->U[k][j][i].M3 -= dtodx1*(rsf*x1Flux[k][j][i+1].Mz - lsf*x1Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,d)  -= dtodx1*(rsf*x1Flux[k][j][i+1].d  - lsf*x1Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx1*(rsf*x1Flux[k][j][i+1].Mx - lsf*x1Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M2) -= dtodx1*(SQR(rsf)*x1Flux[k][j][i+1].My - SQR(lsf)*x1Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M3) -= dtodx1*(rsf*x1Flux[k][j][i+1].Mz - lsf*x1Flux[k][j][i].Mz);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  -= dtodx1*(rsf*x1Flux[k][j][i+1].E  - lsf*x1Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  -= dtodx1*(rsf*x1Flux[k][j][i+1].E  - lsf*x1Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx1*(rsf*x1Flux[k][j][i+1].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx1*(rsf*x1Flux[k][j][i+1].s[n]
                                        - lsf*x1Flux[k][j][i  ].s[n]);
 #endif
       }
@@ -1696,16 +1872,16 @@ void integrate_3d_vl(DomainS *pD)
 #ifdef CYLINDRICAL
         dtodx2 = pG->dt/(r[i]*pG->dx2);
 #endif
-        pG->U[k][j][i].d  -= dtodx2*(x2Flux[k][j+1][i].d  - x2Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx2*(x2Flux[k][j+1][i].Mz - x2Flux[k][j][i].Mz);
-        pG->U[k][j][i].M2 -= dtodx2*(x2Flux[k][j+1][i].Mx - x2Flux[k][j][i].Mx);
-        pG->U[k][j][i].M3 -= dtodx2*(x2Flux[k][j+1][i].My - x2Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,d)  -= dtodx2*(x2Flux[k][j+1][i].d  - x2Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx2*(x2Flux[k][j+1][i].Mz - x2Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M2) -= dtodx2*(x2Flux[k][j+1][i].Mx - x2Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M3) -= dtodx2*(x2Flux[k][j+1][i].My - x2Flux[k][j][i].My);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  -= dtodx2*(x2Flux[k][j+1][i].E  - x2Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  -= dtodx2*(x2Flux[k][j+1][i].E  - x2Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx2*(x2Flux[k][j+1][i].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx2*(x2Flux[k][j+1][i].s[n]
                                        - x2Flux[k][j  ][i].s[n]);
 #endif
       }
@@ -1719,16 +1895,16 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        pG->U[k][j][i].d  -= dtodx3*(x3Flux[k+1][j][i].d  - x3Flux[k][j][i].d );
-        pG->U[k][j][i].M1 -= dtodx3*(x3Flux[k+1][j][i].My - x3Flux[k][j][i].My);
-        pG->U[k][j][i].M2 -= dtodx3*(x3Flux[k+1][j][i].Mz - x3Flux[k][j][i].Mz);
-        pG->U[k][j][i].M3 -= dtodx3*(x3Flux[k+1][j][i].Mx - x3Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,d)  -= dtodx3*(x3Flux[k+1][j][i].d  - x3Flux[k][j][i].d );
+        UVAR(pG->U,k,j,i,M1) -= dtodx3*(x3Flux[k+1][j][i].My - x3Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M2) -= dtodx3*(x3Flux[k+1][j][i].Mz - x3Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M3) -= dtodx3*(x3Flux[k+1][j][i].Mx - x3Flux[k][j][i].Mx);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  -= dtodx3*(x3Flux[k+1][j][i].E  - x3Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  -= dtodx3*(x3Flux[k+1][j][i].E  - x3Flux[k][j][i].E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          pG->U[k][j][i].s[n] -= dtodx3*(x3Flux[k+1][j][i].s[n]
+          UVAR(pG->U,k,j,i,s[n]) -= dtodx3*(x3Flux[k+1][j][i].s[n]
                                        - x3Flux[k  ][j][i].s[n]);
 #endif
       }
@@ -1744,7 +1920,8 @@ void integrate_3d_vl(DomainS *pD)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        W = Cons_to_Prim(&(pG->U[k][j][i]));
+        U = UCELL(pG->U,k,j,i);
+        W = Cons_to_Prim(&U);
         if (W.d < 0.0) {
           flag_cell = 1;
           BadCell.i = i;
@@ -2074,6 +2251,7 @@ void integrate_3d_vl(DomainS *pD)
 
 #endif /* STATIC_MESH_REFINEMENT */
 
+  PERF_STOP(integrate_3d_perf);
   return;
 }
 
@@ -2105,6 +2283,9 @@ void integrate_init_3d(MeshS *pM)
   size1 = size1 + 2*nghost;
   size2 = size2 + 2*nghost;
   size3 = size3 + 2*nghost;
+/* With blocking the arrays only have to span one block of k-planes */
+  if (integrate_3d_kblock() > 0)
+    size3 = MIN(size3, integrate_3d_kblock() + 2*nghost);
   nmax = MAX((MAX(size1,size2)),size3);
 
 #ifdef MHD
@@ -2158,6 +2339,7 @@ void integrate_init_3d(MeshS *pM)
   if ((U1d = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((Ul  = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((Ur  = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
+  if ((F1d = (Cons1DS*)malloc(nmax*sizeof(Cons1DS))) == NULL) goto on_error;
   if ((W1d = (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
   if ((Wl  = (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
   if ((Wr  = (Prim1DS*)malloc(nmax*sizeof(Prim1DS))) == NULL) goto on_error;
@@ -2243,6 +2425,7 @@ void integrate_destruct_3d(void)
   if (U1d != NULL) free(U1d);
   if (Ul  != NULL) free(Ul);
   if (Ur  != NULL) free(Ur);
+  if (F1d != NULL) free(F1d);
   if (W1d != NULL) free(W1d);
   if (Wl  != NULL) free(Wl);
   if (Wr  != NULL) free(Wr);
@@ -2689,9 +2872,9 @@ static void FixCell(GridS *pG, Int3Vect ix)
 #ifdef CYLINDRICAL
     rsf = pG->ri[i+1]/pG->r[i];  lsf = pG->ri[i]/pG->r[i];
 #endif
-    pG->U[k][j][i].B1c = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
-    pG->U[k][j][i].B2c = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
-    pG->U[k][j][i].B3c = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
+    UVAR(pG->U,k,j,i,B1c) = 0.5*(lsf*pG->B1i[k][j][i] + rsf*pG->B1i[k][j][i+1]);
+    UVAR(pG->U,k,j,i,B2c) = 0.5*(    pG->B2i[k][j][i] +     pG->B2i[k][j+1][i]);
+    UVAR(pG->U,k,j,i,B3c) = 0.5*(    pG->B3i[k][j][i] +     pG->B3i[k+1][j][i]);
   }}}
 #endif /* MHD */
 
@@ -2749,40 +2932,40 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
   lsf = (lx1>0) ? pG->ri[i  ]/pG->r[i] : pG->ri[i+1]/pG->r[i];
   dtodx2 = pG->dt/(pG->r[i]*pG->dx2);
 #endif
-  pG->U[k][j][i].d  += dtodx1*(rsf*rx1*x1FD_ip1.d  - lsf*lx1*x1FD_i.d );
-  pG->U[k][j][i].M1 += dtodx1*(rsf*rx1*x1FD_ip1.Mx - lsf*lx1*x1FD_i.Mx);
-  pG->U[k][j][i].M2 += dtodx1*(SQR(rsf)*rx1*x1FD_ip1.My - SQR(lsf)*lx1*x1FD_i.My);
-  pG->U[k][j][i].M3 += dtodx1*(rsf*rx1*x1FD_ip1.Mz - lsf*lx1*x1FD_i.Mz);
+  UVAR(pG->U,k,j,i,d)  += dtodx1*(rsf*rx1*x1FD_ip1.d  - lsf*lx1*x1FD_i.d );
+  UVAR(pG->U,k,j,i,M1) += dtodx1*(rsf*rx1*x1FD_ip1.Mx - lsf*lx1*x1FD_i.Mx);
+  UVAR(pG->U,k,j,i,M2) += dtodx1*(SQR(rsf)*rx1*x1FD_ip1.My - SQR(lsf)*lx1*x1FD_i.My);
+  UVAR(pG->U,k,j,i,M3) += dtodx1*(rsf*rx1*x1FD_ip1.Mz - lsf*lx1*x1FD_i.Mz);
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E  += dtodx1*(rsf*rx1*x1FD_ip1.E  - lsf*lx1*x1FD_i.E );
+  UVAR(pG->U,k,j,i,E)  += dtodx1*(rsf*rx1*x1FD_ip1.E  - lsf*lx1*x1FD_i.E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
   for (n=0; n<NSCALARS; n++)
-    pG->U[k][j][i].s[n] += dtodx1*(rsf*rx1*x1FD_ip1.s[n] - lsf*lx1*x1FD_i.s[n]);
+    UVAR(pG->U,k,j,i,s[n]) += dtodx1*(rsf*rx1*x1FD_ip1.s[n] - lsf*lx1*x1FD_i.s[n]);
 #endif
 
-  pG->U[k][j][i].d  += dtodx2*(rx2*x2FD_jp1.d  - lx2*x2FD_j.d );
-  pG->U[k][j][i].M1 += dtodx2*(rx2*x2FD_jp1.Mz - lx2*x2FD_j.Mz);
-  pG->U[k][j][i].M2 += dtodx2*(rx2*x2FD_jp1.Mx - lx2*x2FD_j.Mx);
-  pG->U[k][j][i].M3 += dtodx2*(rx2*x2FD_jp1.My - lx2*x2FD_j.My);
+  UVAR(pG->U,k,j,i,d)  += dtodx2*(rx2*x2FD_jp1.d  - lx2*x2FD_j.d );
+  UVAR(pG->U,k,j,i,M1) += dtodx2*(rx2*x2FD_jp1.Mz - lx2*x2FD_j.Mz);
+  UVAR(pG->U,k,j,i,M2) += dtodx2*(rx2*x2FD_jp1.Mx - lx2*x2FD_j.Mx);
+  UVAR(pG->U,k,j,i,M3) += dtodx2*(rx2*x2FD_jp1.My - lx2*x2FD_j.My);
 #ifndef BAROTROPIC                                   
-  pG->U[k][j][i].E  += dtodx2*(rx2*x2FD_jp1.E  - lx2*x2FD_j.E );
+  UVAR(pG->U,k,j,i,E)  += dtodx2*(rx2*x2FD_jp1.E  - lx2*x2FD_j.E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
   for (n=0; n<NSCALARS; n++)
-    pG->U[k][j][i].s[n] += dtodx2*(rx2*x2FD_jp1.s[n] - lx2*x2FD_j.s[n]);
+    UVAR(pG->U,k,j,i,s[n]) += dtodx2*(rx2*x2FD_jp1.s[n] - lx2*x2FD_j.s[n]);
 #endif
 
-  pG->U[k][j][i].d  += dtodx3*(rx3*x3FD_kp1.d  - lx3*x3FD_k.d );
-  pG->U[k][j][i].M1 += dtodx3*(rx3*x3FD_kp1.My - lx3*x3FD_k.My);
-  pG->U[k][j][i].M2 += dtodx3*(rx3*x3FD_kp1.Mz - lx3*x3FD_k.Mz);
-  pG->U[k][j][i].M3 += dtodx3*(rx3*x3FD_kp1.Mx - lx3*x3FD_k.Mx);
+  UVAR(pG->U,k,j,i,d)  += dtodx3*(rx3*x3FD_kp1.d  - lx3*x3FD_k.d );
+  UVAR(pG->U,k,j,i,M1) += dtodx3*(rx3*x3FD_kp1.My - lx3*x3FD_k.My);
+  UVAR(pG->U,k,j,i,M2) += dtodx3*(rx3*x3FD_kp1.Mz - lx3*x3FD_k.Mz);
+  UVAR(pG->U,k,j,i,M3) += dtodx3*(rx3*x3FD_kp1.Mx - lx3*x3FD_k.Mx);
 #ifndef BAROTROPIC                                   
-  pG->U[k][j][i].E  += dtodx3*(rx3*x3FD_kp1.E  - lx3*x3FD_k.E );
+  UVAR(pG->U,k,j,i,E)  += dtodx3*(rx3*x3FD_kp1.E  - lx3*x3FD_k.E );
 #endif /* BAROTROPIC */
 #if (NSCALARS > 0)
   for (n=0; n<NSCALARS; n++)
-    pG->U[k][j][i].s[n] += dtodx3*(rx3*x3FD_kp1.s[n] - lx3*x3FD_k.s[n]);
+    UVAR(pG->U,k,j,i,s[n]) += dtodx3*(rx3*x3FD_kp1.s[n] - lx3*x3FD_k.s[n]);
 #endif
 
 #ifdef SHEARING_BOX
@@ -2820,11 +3003,11 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
  * potential momentum source terms using a Crank-Nicholson
  * discretization for the momentum fluctuation equation. */
 
-  pG->U[k][j][i].M1 += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
-  pG->U[k][j][i].M2 += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
+  UVAR(pG->U,k,j,i,M1) += (4.0*dM2e + 2.0*(qshear-2.)*om_dt*M1e)*fact;
+  UVAR(pG->U,k,j,i,M2) += 2.0*(qshear-2.)*(M1e + om_dt*dM2e)*fact;
 
 #ifndef FARGO
-  pG->U[k][j][i].M2 += 0.5*qshear*om_dt*(ABS(lx1)*x1FD_i.d + ABS(rx1)*x1FD_ip1.d);
+  UVAR(pG->U,k,j,i,M2) += 0.5*qshear*om_dt*(ABS(lx1)*x1FD_i.d + ABS(rx1)*x1FD_ip1.d);
 #endif
 
 /* Update the energy for a fixed potential.
@@ -2834,21 +3017,21 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
   phir = (*ShearingBoxPot)((x1+rx1*0.5*pG->dx1),x2,x3);
   phil = (*ShearingBoxPot)((x1-lx1*0.5*pG->dx1),x2,x3);
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx1*(lx1*x1FD_i.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx1*(lx1*x1FD_i.d*(phic - phil) +
                               rx1*x1FD_ip1.d*(phir - phic));
 #endif
 
   phir = (*ShearingBoxPot)(x1,(x2+rx2*0.5*pG->dx2),x3);
   phil = (*ShearingBoxPot)(x1,(x2-lx2*0.5*pG->dx2),x3);
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
                               rx2*x2FD_jp1.d*(phir - phic));
 #endif
 
   phir = (*ShearingBoxPot)(x1,x2,(x3+rx3*0.5*pG->dx3));
   phil = (*ShearingBoxPot)(x1,x2,(x3-lx3*0.5*pG->dx3));
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
                               rx3*x3FD_kp1.d*(phir - phic));
 #endif
 #endif /* SHEARING_BOX */
@@ -2860,7 +3043,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
     phil = (*StaticGravPot)((x1-lx1*0.5*pG->dx1),x2,x3);
 
 #ifndef BAROTROPIC
-    pG->U[k][j][i].E += dtodx1*(lsf*lx1*x1FD_i.d*(phic - phil) +
+    UVAR(pG->U,k,j,i,E) += dtodx1*(lsf*lx1*x1FD_i.d*(phic - phil) +
                                 rsf*rx1*x1FD_ip1.d*(phir - phic));
 #endif
 
@@ -2868,7 +3051,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
     phil = (*StaticGravPot)(x1,(x2-lx2*0.5*pG->dx2),x3);
 
 #ifndef BAROTROPIC
-    pG->U[k][j][i].E += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
+    UVAR(pG->U,k,j,i,E) += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
                                 rx2*x2FD_jp1.d*(phir - phic));
 #endif
 
@@ -2876,7 +3059,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
     phil = (*StaticGravPot)(x1,x2,(x3-lx3*0.5*pG->dx3));
 
 #ifndef BAROTROPIC
-    pG->U[k][j][i].E += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
+    UVAR(pG->U,k,j,i,E) += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
                                 rx3*x3FD_kp1.d*(phir - phic));
 #endif
   }
@@ -2887,7 +3070,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
   phir = 0.5*(pG->Phi[k][j][i  ] + pG->Phi[k][j][i+rx1]);
 
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx1*(lx1*x1FD_i.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx1*(lx1*x1FD_i.d*(phic - phil) +
                               rx1*x1FD_ip1.d*(phir - phic));
 #endif
 
@@ -2895,7 +3078,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
   phir = 0.5*(pG->Phi[k][j  ][i] + pG->Phi[k][j+rx2][i]);
 
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx2*(lx2*x2FD_j.d*(phic - phil) +
                               rx2*x2FD_jp1.d*(phir - phic));
 #endif
 
@@ -2903,7 +3086,7 @@ static void ApplyCorr(GridS *pG, int i, int j, int k,
   phir = 0.5*(pG->Phi[k  ][j][i] + pG->Phi[k+rx3][j][i]);
 
 #ifndef BAROTROPIC
-  pG->U[k][j][i].E += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
+  UVAR(pG->U,k,j,i,E) += dtodx3*(lx3*x3FD_k.d*(phic - phil) +
                               rx3*x3FD_kp1.d*(phir - phic));
 #endif
 
@@ -34,4 +34,15 @@ void integrate_init_3d(MeshS *pM);
 void integrate_3d_ctu(DomainS *pD);
 void integrate_3d_vl(DomainS *pD);
 
+/* integrate_3d_blocked.c */
+void integrate_3d_blocked(DomainS *pD);
+int integrate_3d_kblock(void);
+void integrate_init_3d_blocked(MeshS *pM);
+void integrate_destruct_3d_blocked(void);
+void integrate_3d_interior(DomainS *pD);
+void integrate_3d_shell(DomainS *pD);
+int integrate_3d_overlap(void);
+void integrate_init_3d_overlap(MeshS *pM);
+void integrate_destruct_3d_overlap(void);
+
 #endif /* INTEGRATORS_PROTOTYPES_H */
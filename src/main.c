@@ -45,6 +45,9 @@ static char *athena_version = "version 4.0 - 01-Jul-2010";
 #include "globals.h"
 #include "prototypes.h"
 #include "particles/prototypes.h"
+#ifdef OPENMP
+#include <omp.h>
+#endif
 
 /*==============================================================================
  * PRIVATE FUNCTION PROTOTYPES:
@@ -114,6 +117,9 @@ int main(int argc, char *argv[])
   clock_t time0,time1, have_times;
   struct timeval tvs, tve;
   Real dt_done;
+  int overlap_dt=0;       /* set to 1 if new_dt() overlaps bvals_mhd() */
+  int overlap_int=0;      /* set to 1 if integrator overlaps bvals_mhd() */
+  int bvals_pending=0;    /* set to 1 while bvals_mhd_finish() is deferred */
 
 #ifdef MPI_PARALLEL
   char *pc, *suffix, new_name[MAXLEN];
@@ -329,9 +335,21 @@ int main(int argc, char *argv[])
 #endif /* MPI_PARALLEL */
   ath_log_set_level(out_level, err_level);
 
+/* Record begin/end events of main loop phases if trace=1 in <log> block */
+  name = par_gets("job","problem_id");
+  ath_trace_init(par_geti_def("log","trace",0), name);
+  free(name);  name = NULL;
+
   if(have_time > 0) /* current calendar time (UTC) is available */
     ath_pout(0,"Simulation started on %s\n",ctime(&start));
 
+/* The integrators keep per-thread scratch arrays in threadprivate storage,
+ * which only persists between parallel regions with a fixed thread count */
+#ifdef OPENMP
+  omp_set_dynamic(0);
+  ath_pout(0,"Using %d OpenMP threads per process\n",omp_get_max_threads());
+#endif
+
 /*--- Step 4. ----------------------------------------------------------------*/
 /* Initialize nested mesh hierarchy. */
 
@@ -435,6 +453,7 @@ int main(int argc, char *argv[])
  * Initialize gravitational potential for new runs
  * Allocate temporary arrays */
 
+  change_rundir(rundir); /* Change to run directory (FFT plans may use it) */
   init_output(&Mesh); 
   lr_states_init(&Mesh);
   Integrate = integrate_init(&Mesh);
@@ -457,7 +476,6 @@ int main(int argc, char *argv[])
     fp = athout_fp();
     par_dump(0,fp);      /* Dump a copy of the parsed information to athout */
   }
-  change_rundir(rundir); /* Change to run directory */
   ath_sig_init();        /* Install a signal handler */
   for (nl=1; nl<(Mesh.NLevels); nl++){
     sprintf(level_dir,"lev%d",nl);
@@ -477,6 +495,30 @@ int main(int argc, char *argv[])
   ath_pout(0,"\nSetup complete, entering main loop...\n\n");
   ath_pout(0,"cycle=%i time=%e next dt=%e\n",Mesh.nstep, Mesh.time, Mesh.dt);
 
+/* Reset phase timers.  Breakdown is reported every timer_ncycle cycles (0 =
+ * only at end of run, <0 = never) */
+
+  ath_timer_init(par_geti_def("log","timer_ncycle",0), Mesh.nstep);
+#ifdef PERF_COUNTERS
+  ath_perf_init();
+#endif
+
+/* The new timestep can be computed while ghost zones are exchanged only if it
+ * does not depend on them (no explicit diffusion), there is a single Domain
+ * (the MPI buffers in bvals_mhd are shared by all Domains), and there are no
+ * particles (which must be exchanged first).  */
+
+#if !defined(THERMAL_CONDUCTION) && !defined(RESISTIVITY) && \
+    !defined(VISCOSITY) && !defined(PARTICLES)
+  overlap_dt = (Mesh.NLevels == 1 && Mesh.DomainsPerLevel[0] == 1) ? 1 : 0;
+#endif
+
+/* With <job>overlap_bvals=1 the exchange is completed only in the next
+ * Step 9c, after the interior of the Grid (which needs no ghost zones) has
+ * been updated.  It is completed earlier if any output is due.  */
+
+  overlap_int = overlap_dt && integrate_3d_overlap();
+
 /*--- Step 9. ----------------------------------------------------------------*/
 /* START OF MAIN INTEGRATION LOOP ==============================================
  * Steps are: (a) Check for data ouput
@@ -495,14 +537,26 @@ int main(int argc, char *argv[])
 /*--- Step 9a. ---------------------------------------------------------------*/
 /* Only write output's with t_out>t (last argument of data_output = 0) */
 
+    if (bvals_pending && data_output_due(&Mesh)) {
+      ath_timer_start(bvals_timer);
+      bvals_mhd_finish(&(Mesh.Domain[0][0]));
+      ath_timer_stop(bvals_timer);
+      bvals_pending = 0;
+    }
+
+    ath_timer_start(output_timer);
     data_output(&Mesh, 0);
+    ath_timer_stop(output_timer);
 
 /*--- Step 9b. ---------------------------------------------------------------*/
 /* operator-split explicit diffusion: thermal conduction, viscosity, resistivity
  * Done first since CFL constraint is applied which may change dt  */
 
 #ifdef OPERATOR_SPLIT_COOLING
+    ath_timer_start(cooling_timer);
     integrate_cooling(&Mesh);
+    ath_timer_stop(cooling_timer);
+    ath_timer_start(bvals_timer);
     for (nl=0; nl<(Mesh.NLevels); nl++){ 
       for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
         if (Mesh.Domain[nl][nd].Grid != NULL){
@@ -510,6 +564,7 @@ int main(int argc, char *argv[])
         }
       }
     }
+    ath_timer_stop(bvals_timer);
 #endif
 
 
@@ -520,19 +575,27 @@ int main(int argc, char *argv[])
       STS_dt = Mesh.diff_dt/(1.0+nu_STS-(1.0-nu_STS)
                *cos(0.5*PI*(2.0*i+1.0)/(Real)(N_STS)));
 #endif
+      ath_timer_start(diff_timer);
       integrate_diff(&Mesh);
+      ath_timer_stop(diff_timer);
 
 #ifdef STATIC_MESH_REFINEMENT
+      ath_timer_start(smr_timer);
       RestrictCorrect(&Mesh);
+      ath_timer_stop(smr_timer);
 #endif
+      ath_timer_start(bvals_timer);
       for (nl=0; nl<(Mesh.NLevels); nl++){ 
         for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
           if (Mesh.Domain[nl][nd].Grid != NULL){
             bvals_mhd(&(Mesh.Domain[nl][nd]));
           }
       }}
+      ath_timer_stop(bvals_timer);
 #ifdef STATIC_MESH_REFINEMENT
+      ath_timer_start(smr_timer);
       Prolongate(&Mesh);
+      ath_timer_stop(smr_timer);
 #endif
 #ifdef STS
     }
@@ -540,18 +603,36 @@ int main(int argc, char *argv[])
 #endif /* Explicit diffusion */
 
 /*--- Step 9c. ---------------------------------------------------------------*/
-/* Loop over all Domains and call Integrator */
-
-    for (nl=0; nl<(Mesh.NLevels); nl++){ 
-      for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
-        if (Mesh.Domain[nl][nd].Grid != NULL){
-          (*Integrate)(&(Mesh.Domain[nl][nd]));
+/* Loop over all Domains and call Integrator.  If the exchange of boundary
+ * values is still in progress, update the interior of the Grid first.  */
+
+    if (bvals_pending) {
+      ath_timer_start(integrate_timer);
+      integrate_3d_interior(&(Mesh.Domain[0][0]));
+      ath_timer_stop(integrate_timer);
+      ath_timer_start(bvals_timer);
+      bvals_mhd_finish(&(Mesh.Domain[0][0]));
+      ath_timer_stop(bvals_timer);
+      ath_timer_start(integrate_timer);
+      integrate_3d_shell(&(Mesh.Domain[0][0]));
+      ath_timer_stop(integrate_timer);
+      bvals_pending = 0;
+    } else {
+      for (nl=0; nl<(Mesh.NLevels); nl++){ 
+        for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
+          if (Mesh.Domain[nl][nd].Grid != NULL){
+            ath_timer_start(integrate_timer);
+            (*Integrate)(&(Mesh.Domain[nl][nd]));
 #ifdef FARGO
-          Fargo(&(Mesh.Domain[nl][nd]));
-#ifdef PARTICLES
-          advect_particles(&(Mesh.Domain[nl][nd]));
+            Fargo(&(Mesh.Domain[nl][nd]));
+#endif
+            ath_timer_stop(integrate_timer);
+#if defined(FARGO) && defined(PARTICLES)
+            ath_timer_start(particle_timer);
+            advect_particles(&(Mesh.Domain[nl][nd]));
+            ath_timer_stop(particle_timer);
 #endif
-#endif /* FARGO */
+          }
         }
       }
     }
@@ -560,7 +641,9 @@ int main(int argc, char *argv[])
 /* With SMR, restrict solution from Child --> Parent grids  */
 
 #ifdef STATIC_MESH_REFINEMENT
+    ath_timer_start(smr_timer);
     RestrictCorrect(&Mesh);
+    ath_timer_stop(smr_timer);
 #endif
 
 /*--- Step 9e. ---------------------------------------------------------------*/
@@ -573,6 +656,7 @@ int main(int argc, char *argv[])
  * correction to fluxes for accelerations due to self-gravity. */
 
 #ifdef SELF_GRAVITY
+    ath_timer_start(selfg_timer);
     for (nl=0; nl<(Mesh.NLevels); nl++){ 
       for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
         if (Mesh.Domain[nl][nd].Grid != NULL){
@@ -582,6 +666,7 @@ int main(int argc, char *argv[])
         }
       }
     }
+    ath_timer_stop(selfg_timer);
 #endif
 
 /*--- Step 9g. ---------------------------------------------------------------*/
@@ -601,28 +686,62 @@ int main(int argc, char *argv[])
 
 /*--- Step 9h. ---------------------------------------------------------------*/
 /* Boundary values must be set after time is updated for t-dependent BCs.
- * With SMR, ghost zones at internal fine/coarse boundaries set by Prolongate */
-
-    for (nl=0; nl<(Mesh.NLevels); nl++){ 
-      for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
-        if (Mesh.Domain[nl][nd].Grid != NULL){
-          bvals_mhd(&(Mesh.Domain[nl][nd]));
+ * With SMR, ghost zones at internal fine/coarse boundaries set by Prolongate.
+ * If overlap_dt is set, the new dt (which needs only active zones) is
+ * computed while the x1-boundary data is in flight.  If overlap_int is set,
+ * the exchange is completed in Step 9c.  */
+
+    if (overlap_dt) {
+      if (Mesh.Domain[0][0].Grid != NULL){
+        ath_timer_start(bvals_timer);
+        bvals_mhd_start(&(Mesh.Domain[0][0]));
+        ath_timer_stop(bvals_timer);
+      }
+      ath_timer_start(newdt_timer);
+      new_dt(&Mesh);
+      ath_timer_stop(newdt_timer);
+      if (Mesh.Domain[0][0].Grid != NULL){
+        if (overlap_int) {
+          bvals_pending = 1;
+        } else {
+          ath_timer_start(bvals_timer);
+          bvals_mhd_finish(&(Mesh.Domain[0][0]));
+          ath_timer_stop(bvals_timer);
+        }
+      }
+    } else {
+      for (nl=0; nl<(Mesh.NLevels); nl++){ 
+        for (nd=0; nd<(Mesh.DomainsPerLevel[nl]); nd++){  
+          if (Mesh.Domain[nl][nd].Grid != NULL){
+            ath_timer_start(bvals_timer);
+            bvals_mhd(&(Mesh.Domain[nl][nd]));
+            ath_timer_stop(bvals_timer);
 #ifdef PARTICLES
-          bvals_particle(&(Mesh.Domain[nl][nd]));
+            ath_timer_start(particle_timer);
+            bvals_particle(&(Mesh.Domain[nl][nd]));
+            ath_timer_stop(particle_timer);
 #endif
+          }
         }
       }
     }
 
 #ifdef STATIC_MESH_REFINEMENT
+    ath_timer_start(smr_timer);
     Prolongate(&Mesh);
+    ath_timer_stop(smr_timer);
 #endif
 
 /*--- Step 9i. ---------------------------------------------------------------*/
-/* Compute new dt. With resistivity, the diffusion coeffieicnts are evaluated
- * within new_dt(), which requires that boundary values are already updated.  */
-
-    new_dt(&Mesh);
+/* Compute new dt, unless already done in Step 9h. With resistivity, the
+ * diffusion coeffieicnts are evaluated within new_dt(), which requires that
+ * boundary values are already updated.  */
+
+    if (!overlap_dt) {
+      ath_timer_start(newdt_timer);
+      new_dt(&Mesh);
+      ath_timer_stop(newdt_timer);
+    }
 
 /*--- Step 9j. ---------------------------------------------------------------*/
 /* Force quit if wall time limit reached.  Check signals from system */
@@ -638,6 +757,8 @@ int main(int argc, char *argv[])
     ath_pout(0,"cycle=%i time=%e next dt=%e last dt=%e\n",
 	     Mesh.nstep,Mesh.time,Mesh.dt,dt_done);
 
+    ath_timer_report(Mesh.nstep, 0);
+
     if(nflush == Mesh.nstep){
       ath_flush_out();
       ath_flush_err();
@@ -645,6 +766,13 @@ int main(int argc, char *argv[])
     }
   } /* END OF MAIN INTEGRATION LOOP ==========================================*/
 
+  if (bvals_pending) {
+    ath_timer_start(bvals_timer);
+    bvals_mhd_finish(&(Mesh.Domain[0][0]));
+    ath_timer_stop(bvals_timer);
+    bvals_pending = 0;
+  }
+
 /*--- Step 10. ---------------------------------------------------------------*/
 /* Finish up by computing zc/sec, dumping data, and deallocate memory */
 
@@ -717,12 +845,25 @@ int main(int argc, char *argv[])
 
 /* Final output everything (last argument of data_output = 1) */
 
+  ath_timer_start(output_timer);
   data_output(&Mesh, 1);
+  ath_timer_stop(output_timer);
+
+/* Print breakdown of wall time over phases of the main loop */
+
+  ath_timer_report(Mesh.nstep, 1);
+#ifdef PERF_COUNTERS
+  ath_perf_report();
+#endif
 
 /* Free all memory */
 
   lr_states_destruct();
   integrate_destruct();
+  bvals_mhd_destruct();
+#ifdef SELF_GRAVITY
+  bvals_grav_destruct();
+#endif
   data_output_destruct();
 #ifdef PARTICLES
   particle_destruct(&Mesh);
@@ -738,6 +879,7 @@ int main(int argc, char *argv[])
   integrate_diff_destruct();
 #endif
   par_close();
+  ath_trace_close();
 
 #ifdef MPI_PARALLEL
   MPI_Finalize();
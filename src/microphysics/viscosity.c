@@ -121,13 +121,13 @@ void viscosity(DomainS *pD)
       x3Flux[k][j][i].E = 0.0;
 #endif
 
-      Vel[k][j][i].x1 = pG->U[k][j][i].M1/pG->U[k][j][i].d;
-      Vel[k][j][i].x2 = pG->U[k][j][i].M2/pG->U[k][j][i].d;
+      Vel[k][j][i].x1 = UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d);
+      Vel[k][j][i].x2 = UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d);
 #ifdef FARGO
       cc_pos(pG,i,j,k,&x1,&x2,&x3);
       Vel[k][j][i].x2 -= qshear*Omega_0*x1;
 #endif
-      Vel[k][j][i].x3 = pG->U[k][j][i].M3/pG->U[k][j][i].d;
+      Vel[k][j][i].x3 = UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d);
     }
   }}
   
@@ -167,11 +167,11 @@ void viscosity(DomainS *pD)
   for (k=ks; k<=ke; k++) {
   for (j=js; j<=je; j++) { 
     for (i=is; i<=ie; i++) { 
-      pG->U[k][j][i].M1 += dtodx1*(x1Flux[k][j][i+1].Mx - x1Flux[k][j][i].Mx);
-      pG->U[k][j][i].M2 += dtodx1*(x1Flux[k][j][i+1].My - x1Flux[k][j][i].My);
-      pG->U[k][j][i].M3 += dtodx1*(x1Flux[k][j][i+1].Mz - x1Flux[k][j][i].Mz);
+      UVAR(pG->U,k,j,i,M1) += dtodx1*(x1Flux[k][j][i+1].Mx - x1Flux[k][j][i].Mx);
+      UVAR(pG->U,k,j,i,M2) += dtodx1*(x1Flux[k][j][i+1].My - x1Flux[k][j][i].My);
+      UVAR(pG->U,k,j,i,M3) += dtodx1*(x1Flux[k][j][i+1].Mz - x1Flux[k][j][i].Mz);
 #ifndef BAROTROPIC
-      pG->U[k][j][i].E  += dtodx1*(x1Flux[k][j][i+1].E  - x1Flux[k][j][i].E );
+      UVAR(pG->U,k,j,i,E)  += dtodx1*(x1Flux[k][j][i+1].E  - x1Flux[k][j][i].E );
 #endif /* BAROTROPIC */
     }
   }}
@@ -182,11 +182,11 @@ void viscosity(DomainS *pD)
     for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        pG->U[k][j][i].M1 += dtodx2*(x2Flux[k][j+1][i].Mx - x2Flux[k][j][i].Mx);
-        pG->U[k][j][i].M2 += dtodx2*(x2Flux[k][j+1][i].My - x2Flux[k][j][i].My);
-        pG->U[k][j][i].M3 += dtodx2*(x2Flux[k][j+1][i].Mz - x2Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M1) += dtodx2*(x2Flux[k][j+1][i].Mx - x2Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M2) += dtodx2*(x2Flux[k][j+1][i].My - x2Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M3) += dtodx2*(x2Flux[k][j+1][i].Mz - x2Flux[k][j][i].Mz);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  += dtodx2*(x2Flux[k][j+1][i].E  - x2Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  += dtodx2*(x2Flux[k][j+1][i].E  - x2Flux[k][j][i].E );
 #endif /* BAROTROPIC */
       }
     }}
@@ -198,11 +198,11 @@ void viscosity(DomainS *pD)
     for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        pG->U[k][j][i].M1 += dtodx3*(x3Flux[k+1][j][i].Mx - x3Flux[k][j][i].Mx);
-        pG->U[k][j][i].M2 += dtodx3*(x3Flux[k+1][j][i].My - x3Flux[k][j][i].My);
-        pG->U[k][j][i].M3 += dtodx3*(x3Flux[k+1][j][i].Mz - x3Flux[k][j][i].Mz);
+        UVAR(pG->U,k,j,i,M1) += dtodx3*(x3Flux[k+1][j][i].Mx - x3Flux[k][j][i].Mx);
+        UVAR(pG->U,k,j,i,M2) += dtodx3*(x3Flux[k+1][j][i].My - x3Flux[k][j][i].My);
+        UVAR(pG->U,k,j,i,M3) += dtodx3*(x3Flux[k+1][j][i].Mz - x3Flux[k][j][i].Mz);
 #ifndef BAROTROPIC
-        pG->U[k][j][i].E  += dtodx3*(x3Flux[k+1][j][i].E  - x3Flux[k][j][i].E );
+        UVAR(pG->U,k,j,i,E)  += dtodx3*(x3Flux[k+1][j][i].E  - x3Flux[k][j][i].E );
 #endif /* BAROTROPIC */
       }
     }}
@@ -245,7 +245,7 @@ void ViscStress_iso(DomainS *pD)
                                    - (Vel[k-1][j][i].x1 + Vel[k-1][j][i-1].x1));
       }
 
-      nud = nu_iso*0.5*(pG->U[k][j][i].d + pG->U[k][j][i-1].d);
+      nud = nu_iso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k,j,i-1,d));
       x1Flux[k][j][i].Mx += nud*VStress.Mx;
       x1Flux[k][j][i].My += nud*VStress.My;
       x1Flux[k][j][i].Mz += nud*VStress.Mz;
@@ -279,7 +279,7 @@ void ViscStress_iso(DomainS *pD)
              (Vel[k-1][j][i].x2 + Vel[k-1][j-1][i].x2))/(4.0*pG->dx3);
         }
 
-        nud = nu_iso*0.5*(pG->U[k][j][i].d + pG->U[k][j-1][i].d);
+        nud = nu_iso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k,j-1,i,d));
         x2Flux[k][j][i].Mx += nud*VStress.Mx;
         x2Flux[k][j][i].My += nud*VStress.My;
         x2Flux[k][j][i].Mz += nud*VStress.Mz;
@@ -311,7 +311,7 @@ void ViscStress_iso(DomainS *pD)
         VStress.Mz = 2.0*(Vel[k][j][i].x3 - Vel[k-1][j][i].x3)/pG->dx3
            - ONE_3RD*(divv[k][j][i] + divv[k-1][j][i]);
 
-        nud = nu_iso*0.5*(pG->U[k][j][i].d + pG->U[k-1][j][i].d);
+        nud = nu_iso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k-1,j,i,d));
         x3Flux[k][j][i].Mx += nud*VStress.Mx;
         x3Flux[k][j][i].My += nud*VStress.My;
         x3Flux[k][j][i].Mz += nud*VStress.Mz;
@@ -404,8 +404,8 @@ void ViscStress_aniso(DomainS *pD)
 /* Compute field components at x1-interface */
 
       Bx = pG->B1i[k][j][i];
-      By = 0.5*(pG->U[k][j][i].B2c + pG->U[k][j][i-1].B2c);
-      Bz = 0.5*(pG->U[k][j][i].B3c + pG->U[k][j][i-1].B3c);
+      By = 0.5*(UVAR(pG->U,k,j,i,B2c) + UVAR(pG->U,k,j,i-1,B2c));
+      Bz = 0.5*(UVAR(pG->U,k,j,i,B3c) + UVAR(pG->U,k,j,i-1,B3c));
       B02 = Bx*Bx + By*By + Bz*Bz;
       B02 = MAX(B02,TINY_NUMBER);  /* limit in case B=0 */
 
@@ -432,7 +432,7 @@ void ViscStress_aniso(DomainS *pD)
 
 /* Add fluxes */
 
-      nud = nu_aniso*0.5*(pG->U[k][j][i].d + pG->U[k][j][i-1].d);
+      nud = nu_aniso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k,j,i-1,d));
       qa = nud*(BBdV - ONE_3RD*divV);
 
       VStress.Mx = qa*(3.0*Bx*Bx/B02 - 1.0);
@@ -508,9 +508,9 @@ void ViscStress_aniso(DomainS *pD)
       
 /* Compute field components at x2-interface */
 
-      Bx = 0.5*(pG->U[k][j][i].B1c + pG->U[k][j-1][i].B1c);
+      Bx = 0.5*(UVAR(pG->U,k,j,i,B1c) + UVAR(pG->U,k,j-1,i,B1c));
       By = pG->B2i[k][j][i];
-      Bz = 0.5*(pG->U[k][j][i].B3c + pG->U[k][j-1][i].B3c);
+      Bz = 0.5*(UVAR(pG->U,k,j,i,B3c) + UVAR(pG->U,k,j-1,i,B3c));
       B02 = Bx*Bx + By*By + Bz*Bz;
       B02 = MAX(B02,TINY_NUMBER); /* limit in case B=0 */
 
@@ -537,7 +537,7 @@ void ViscStress_aniso(DomainS *pD)
 
 /* Add fluxes */
 
-      nud = nu_aniso*0.5*(pG->U[k][j][i].d + pG->U[k][j-1][i].d);
+      nud = nu_aniso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k,j-1,i,d));
       qa = nud*(BBdV - ONE_3RD*divV);
 
       VStress.Mx = qa*(3.0*Bx*By/B02);
@@ -608,8 +608,8 @@ void ViscStress_aniso(DomainS *pD)
         
 /* Compute field components at x3-interface */
 
-        Bx = 0.5*(pG->U[k][j][i].B1c + pG->U[k-1][j][i].B1c);
-        By = 0.5*(pG->U[k][j][i].B2c + pG->U[k-1][j][i].B2c);
+        Bx = 0.5*(UVAR(pG->U,k,j,i,B1c) + UVAR(pG->U,k-1,j,i,B1c));
+        By = 0.5*(UVAR(pG->U,k,j,i,B2c) + UVAR(pG->U,k-1,j,i,B2c));
         Bz = pG->B3i[k][j][i];
         B02 = Bx*Bx + By*By + Bz*Bz;
         B02 = MAX(B02,TINY_NUMBER); /* limit in case B=0 */
@@ -626,7 +626,7 @@ void ViscStress_aniso(DomainS *pD)
 
 /* Add fluxes */
 
-        nud = nu_aniso*0.5*(pG->U[k][j][i].d + pG->U[k-1][j][i].d);
+        nud = nu_aniso*0.5*(UVAR(pG->U,k,j,i,d) + UVAR(pG->U,k-1,j,i,d));
         qa = nud*(BBdV - ONE_3RD*divV);
 
         VStress.Mx = qa*(3.0*Bx*Bz/B02);
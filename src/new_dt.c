@@ -14,6 +14,13 @@
  * A CFL condition is also applied using particle velocities if PARTICLES is
  * defined.
  *
+ * With PRIM_CACHE, the primitive variables are computed into the cache of
+ * the Grid and read from there; the gas pressure then uses the cell-centered
+ * rather than the face-centered magnetic field.  The cache is marked valid,
+ * so the first stage of the next 3D integrator call only converts the ghost
+ * zones.  Operator-split cooling and explicit diffusion change U between
+ * new_dt() and the integrator, so the cache is not reused with them.
+ *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - new_dt() - computes dt						      */
 /*============================================================================*/
@@ -83,29 +90,49 @@ void new_dt(MeshS *pM)
     max_v1 = max_v2 = max_v3 = 1.0;
 #else
 
+#ifdef PRIM_CACHE
+    Cons_to_Prim_Grid(pGrid,pGrid->is,pGrid->ie,pGrid->js,pGrid->je,
+                      pGrid->ks,pGrid->ke);
+#if !defined(OPERATOR_SPLIT_COOLING) && !defined(THERMAL_CONDUCTION) && \
+    !defined(RESISTIVITY) && !defined(VISCOSITY)
+    pGrid->W_valid = 1;
+#endif
+#endif
+
     for (k=pGrid->ks; k<=pGrid->ke; k++) {
     for (j=pGrid->js; j<=pGrid->je; j++) {
       for (i=pGrid->is; i<=pGrid->ie; i++) {
-        di = 1.0/(pGrid->U[k][j][i].d);
-        v1 = pGrid->U[k][j][i].M1*di;
-        v2 = pGrid->U[k][j][i].M2*di;
-        v3 = pGrid->U[k][j][i].M3*di;
+#ifdef PRIM_CACHE
+        di = 1.0/(pGrid->W[k][j][i].d);
+        v1 = pGrid->W[k][j][i].V1;
+        v2 = pGrid->W[k][j][i].V2;
+        v3 = pGrid->W[k][j][i].V3;
+#else
+        di = 1.0/(UVAR(pGrid->U,k,j,i,d));
+        v1 = UVAR(pGrid->U,k,j,i,M1)*di;
+        v2 = UVAR(pGrid->U,k,j,i,M2)*di;
+        v3 = UVAR(pGrid->U,k,j,i,M3)*di;
+#endif
         qsq = v1*v1 + v2*v2 + v3*v3;
 
 #ifdef MHD
 
 /* Use maximum of face-centered fields (always larger than cell-centered B) */
-        b1 = pGrid->U[k][j][i].B1c 
-          + fabs((double)(pGrid->B1i[k][j][i] - pGrid->U[k][j][i].B1c));
-        b2 = pGrid->U[k][j][i].B2c 
-          + fabs((double)(pGrid->B2i[k][j][i] - pGrid->U[k][j][i].B2c));
-        b3 = pGrid->U[k][j][i].B3c 
-          + fabs((double)(pGrid->B3i[k][j][i] - pGrid->U[k][j][i].B3c));
+        b1 = UVAR(pGrid->U,k,j,i,B1c) 
+          + fabs((double)(pGrid->B1i[k][j][i] - UVAR(pGrid->U,k,j,i,B1c)));
+        b2 = UVAR(pGrid->U,k,j,i,B2c) 
+          + fabs((double)(pGrid->B2i[k][j][i] - UVAR(pGrid->U,k,j,i,B2c)));
+        b3 = UVAR(pGrid->U,k,j,i,B3c) 
+          + fabs((double)(pGrid->B3i[k][j][i] - UVAR(pGrid->U,k,j,i,B3c)));
         bsq = b1*b1 + b2*b2 + b3*b3;
 /* compute sound speed squared */
 #ifdef ADIABATIC
-        p = MAX(Gamma_1*(pGrid->U[k][j][i].E - 0.5*pGrid->U[k][j][i].d*qsq
+#ifdef PRIM_CACHE
+        p = pGrid->W[k][j][i].P;
+#else
+        p = MAX(Gamma_1*(UVAR(pGrid->U,k,j,i,E) - 0.5*UVAR(pGrid->U,k,j,i,d)*qsq
                 - 0.5*bsq), TINY_NUMBER);
+#endif
         asq = Gamma*p*di;
 #elif defined ISOTHERMAL
         asq = Iso_csound2;
@@ -122,8 +149,12 @@ void new_dt(MeshS *pM)
 
 /* compute sound speed squared */
 #ifdef ADIABATIC
-        p = MAX(Gamma_1*(pGrid->U[k][j][i].E - 0.5*pGrid->U[k][j][i].d*qsq),
+#ifdef PRIM_CACHE
+        p = pGrid->W[k][j][i].P;
+#else
+        p = MAX(Gamma_1*(UVAR(pGrid->U,k,j,i,E) - 0.5*UVAR(pGrid->U,k,j,i,d)*qsq),
                 TINY_NUMBER);
+#endif
         asq = Gamma*p*di;
 #elif defined ISOTHERMAL
         asq = Iso_csound2;
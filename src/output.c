@@ -67,6 +67,7 @@
  * CONTAINS PUBLIC FUNCTIONS: 
  * - init_output() -
  * - data_output() -
+ * - data_output_due() - tests whether data_output() would write anything
  * - data_output_destruct()
  * - OutData1,2,3()   -
  *
@@ -558,6 +559,24 @@ void data_output(MeshS *pM, const int flag)
   return;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \fn int data_output_due(const MeshS *pM)
+ *  \brief Returns 1 if data_output(pM,0) would write any output or restart
+ *   file at the current time, else 0.  Used by main() to complete boundary
+ *   values that are still being exchanged before any output is made. */
+
+int data_output_due(const MeshS *pM)
+{
+  int n;
+
+  for (n=0; n<out_count; n++) {
+    if (pM->time >= OutArray[n].t) return 1;
+  }
+  if (rst_flag && pM->time >= rst_out.t) return 1;
+
+  return 0;
+}
+
 /*----------------------------------------------------------------------------*/
 /*! \fn void data_output_destruct(void) 
  *  \brief Free all memory associated with Output, called by
@@ -1102,28 +1121,28 @@ Real *OutData1(GridS *pgrid, OutputS *pout, int *Nx1)
 /*! \fn Real expr_d(const GridS *pG, const int i, const int j, const int k) 
  *  \brief Density */
 Real expr_d(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,d);
 }
 /*! \fn Real expr_M1(const GridS *pG, const int i, const int j, const int k) 
  *  \brief 1-component of momentum */ 
 Real expr_M1(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M1;
+  return UVAR(pG->U,k,j,i,M1);
 }
 /*! \fn Real expr_M2(const GridS *pG, const int i, const int j, const int k) 
  *  \brief 2-component of momentum */
 Real expr_M2(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M2;
+  return UVAR(pG->U,k,j,i,M2);
 }
 /*! \fn Real expr_M3(const GridS *pG, const int i, const int j, const int k) 
  *  \brief 3-component of momentum */
 Real expr_M3(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M3;
+  return UVAR(pG->U,k,j,i,M3);
 }
 #ifndef BAROTROPIC
 /*! \fn Real expr_E(const GridS *pG, const int i, const int j, const int k) 
  *  \brief Total energy */
 Real expr_E(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].E;
+  return UVAR(pG->U,k,j,i,E);
 }
 #endif
 
@@ -1134,24 +1153,24 @@ Real expr_E(const GridS *pG, const int i, const int j, const int k) {
 /*! \fn Real expr_B1c(const GridS *pG, const int i, const int j, const int k) 
  *  \brief 1-component of cell-centered B-field */
 Real expr_B1c(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].B1c;
+  return UVAR(pG->U,k,j,i,B1c);
 }
 /*! \fn Real expr_B2c(const GridS *pG, const int i, const int j, const int k) 
  *  \brief 2-component of cell-centered B-field */
 Real expr_B2c(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].B2c;
+  return UVAR(pG->U,k,j,i,B2c);
 }
 /*! \fn Real expr_B3c(const GridS *pG, const int i, const int j, const int k)  
  *  \brief 3-component of cell-centered B-field */
 Real expr_B3c(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].B3c;
+  return UVAR(pG->U,k,j,i,B3c);
 }
 /*! \fn Real expr_ME(const GridS *pG, const int i, const int j, const int k) 
  *  \brief Magnetic field energy */
 Real expr_ME(const GridS *pG, const int i, const int j, const int k) {
-  return 0.5*(pG->U[k][j][i].B1c*pG->U[k][j][i].B1c + 
-	      pG->U[k][j][i].B2c*pG->U[k][j][i].B2c + 
-	      pG->U[k][j][i].B3c*pG->U[k][j][i].B3c);
+  return 0.5*(UVAR(pG->U,k,j,i,B1c)*UVAR(pG->U,k,j,i,B1c) + 
+	      UVAR(pG->U,k,j,i,B2c)*UVAR(pG->U,k,j,i,B2c) + 
+	      UVAR(pG->U,k,j,i,B3c)*UVAR(pG->U,k,j,i,B3c));
 }
 #endif
 
@@ -1161,26 +1180,27 @@ Real expr_ME(const GridS *pG, const int i, const int j, const int k) {
 /*! \fn Real expr_V1(const GridS *pG, const int i, const int j, const int k)  
  *  \brief 1-velocity */
 Real expr_V1(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M1/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,M1)/UVAR(pG->U,k,j,i,d);
 }
 /*! \fn Real expr_V2(const GridS *pG, const int i, const int j, const int k)  
  *  \brief 2-velocity */
 Real expr_V2(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M2/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,M2)/UVAR(pG->U,k,j,i,d);
 }
 /*! \fn Real expr_V3(const GridS *pG, const int i, const int j, const int k)  
  *  \brief 3-velocity */
 Real expr_V3(const GridS *pG, const int i, const int j, const int k) {
-  return pG->U[k][j][i].M3/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d);
 }
 
 /*! \fn Real expr_P(const GridS *pG, const int i, const int j, const int k) 
  *  \brief Pressure */
 Real expr_P(const GridS *pG, const int i, const int j, const int k) {
 #ifdef ISOTHERMAL
-  return  pG->U[k][j][i].d*Iso_csound2;
+  return  UVAR(pG->U,k,j,i,d)*Iso_csound2;
 #else
-  ConsS *gp = &(pG->U[k][j][i]);
+  ConsS U = UCELL(pG->U,k,j,i);
+  ConsS *gp = &U;
   return Gamma_1*(gp->E 
 #ifdef MHD
 		  - 0.5*(gp->B1c*gp->B1c + gp->B2c*gp->B2c + gp->B3c*gp->B3c)
@@ -1196,7 +1216,8 @@ Real expr_P(const GridS *pG, const int i, const int j, const int k) {
 #ifdef ADIABATIC
 Real expr_cs2(const GridS *pG, const int i, const int j, const int k)
 {
-  ConsS *gp = &(pG->U[k][j][i]);
+  ConsS U = UCELL(pG->U,k,j,i);
+  ConsS *gp = &U;
   return (Gamma*Gamma_1*(gp->E 
 #ifdef MHD
 	  - 0.5*(gp->B1c*gp->B1c + gp->B2c*gp->B2c + gp->B3c*gp->B3c)
@@ -1212,7 +1233,8 @@ Real expr_cs2(const GridS *pG, const int i, const int j, const int k)
 #ifdef ADIABATIC
 Real expr_S(const GridS *pG, const int i, const int j, const int k)
 {
-  ConsS *gp = &(pG->U[k][j][i]);
+  ConsS U = UCELL(pG->U,k,j,i);
+  ConsS *gp = &U;
   Real P = Gamma_1*(gp->E 
 #ifdef MHD
 		   - 0.5*(gp->B1c*gp->B1c + gp->B2c*gp->B2c + gp->B3c*gp->B3c)
@@ -1229,8 +1251,9 @@ Real expr_S(const GridS *pG, const int i, const int j, const int k)
 #ifdef SPECIAL_RELATIVITY
 Real expr_G(const GridS *pG, const int i, const int j, const int k)
 {
+  ConsS U = UCELL(pG->U,k,j,i);
   PrimS W;
-  W = Cons_to_Prim(&(pG->U[k][j][i]));
+  W = Cons_to_Prim(&U);
   return 1.0/sqrt(1.0 - (SQR(W.V1)+SQR(W.V2)+SQR(W.V3)));
 }
 #endif /* SPECIAL_RELATIVITY */
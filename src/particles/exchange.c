@@ -67,7 +67,10 @@ static GPExc ***myCoup=NULL;
 #ifdef MPI_PARALLEL
 /* MPI send and receive buffers */
 static double **send_buf = NULL, **recv_buf = NULL;
+/* requests for the shearing-box remap */
 static MPI_Request *recv_rq, *send_rq;
+/* persistent requests for exchange with L,R Grids in x1,x2,x3, for each lab */
+static MPI_Request recv_prq_lab[3][3][2], send_prq_lab[3][3][2];
 #endif /* MPI_PARALLEL */
 
 #ifdef SHEARING_BOX
@@ -95,8 +98,12 @@ static VGFun_t apply_ix3 = NULL, apply_ox3 = NULL;
  *   periodic_???() - apply periodic BCs at boundary ???
  *   pack_???()     - pack data at ??? boundary
  *   unpack_???()   - unpack data at ??? boundary
+ *   set_layers()   - sets NVar, NExc and NOfst for exchange step lab
+ *   persist_init() - creates persistent requests for each exchange step
  *============================================================================*/
 
+static void set_layers(const short lab);
+
 static void reflect_ix1_exchange(GridS *pG);
 static void reflect_ox1_exchange(GridS *pG);
 static void reflect_ix2_exchange(GridS *pG);
@@ -133,6 +140,8 @@ static void unpack_ox2_exchange(GridS *pG);
 static void unpack_ix3_exchange(GridS *pG);
 static void unpack_ox3_exchange(GridS *pG);
 
+static void persist_init(DomainS *pD);
+
 #ifdef SHEARING_BOX
 static void pack_ix2_remap(GridS *pG, GPExc ***myZns);
 static void pack_ox2_remap(GridS *pG, GPExc ***myZns);
@@ -169,7 +178,8 @@ void exchange_gpcouple(DomainS *pD, short lab)
 #endif
 #endif
 #ifdef MPI_PARALLEL
-  int cnt1, cnt2, cnt3, cnt, ierr, mIndex;
+  int ierr, mIndex;
+  MPI_Request *recv_prq, *send_prq;
 #endif /* MPI_PARALLEL */
 	
 /*--- Step 1. ------------------------------------------------------------------	
@@ -186,11 +196,10 @@ void exchange_gpcouple(DomainS *pD, short lab)
   Delta = 0.0; 
 #endif
 
+  set_layers(lab);
   switch (lab) {
     case 0: /* particle binning for output purpose */
 		  
-      NVar = 4; NExc = 1; NOfst = 0;
-
       for (k=klp; k<=kup; k++) {
        for (j=jlp; j<=jup; j++) {
         for (i=ilp; i<=iup; i++) {
@@ -204,8 +213,6 @@ void exchange_gpcouple(DomainS *pD, short lab)
 #ifdef FEEDBACK		  
     case 1: /* predictor step of feedback exchange */
 		  
-      NVar = 5; NExc = 1; NOfst = nghost;
-
       for (k=klp; k<=kup; k++) {
        for (j=jlp; j<=jup; j++) {
         for (i=ilp; i<=iup; i++) {
@@ -219,7 +226,6 @@ void exchange_gpcouple(DomainS *pD, short lab)
 		  
     case 2: /* corrector step of feedback exchange */
 		  
-      NVar = 4; NExc = 2; NOfst = 0;
 #ifdef SHEARING_BOX
 #ifndef FARGO
       Delta = 0.5; /* at the middle of a time step */
@@ -271,36 +277,31 @@ void exchange_gpcouple(DomainS *pD, short lab)
   if (pG->Nx[2] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt1 = pG->Nx[0] > 1 ? pG->Nx[0] + 2*NExc : 1;
-    cnt2 = pG->Nx[1] > 1 ? pG->Nx[1] + 2*NExc : 1;
-    cnt = (NExc+NOfst)*cnt1*cnt2*NVar;
+    recv_prq = recv_prq_lab[lab][2];
+    send_prq = send_prq_lab[lab][2];
 
 /* MPI blocks to both left and right */
     if (pG->rx3_id >= 0 && pG->lx3_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx3_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx3_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_prq[0]));
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data L and R */
       pack_ix3_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx3_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       pack_ox3_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx3_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* check non-blocking sends have completed. */
-      ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
+      ierr = MPI_Waitall(2, send_prq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix3_exchange(pG);
       if (mIndex == 1) unpack_ox3_exchange(pG);
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix3_exchange(pG);
       if (mIndex == 1) unpack_ox3_exchange(pG);
 
@@ -309,23 +310,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
     /* Physical boundary on left, MPI block on right */
     if (pG->rx3_id >= 0 && pG->lx3_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx3_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data R */
       pack_ox3_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx3_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* set physical boundary */
       (*apply_ix3)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[1]), MPI_STATUS_IGNORE);
       
       /* wait on non-blocking receive from R and unpack data */
-      ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[1]), MPI_STATUS_IGNORE);
       unpack_ox3_exchange(pG);
       
     }
@@ -333,23 +332,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
     /* MPI block on left, Physical boundary on right */
     if (pG->rx3_id < 0 && pG->lx3_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx3_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_prq[0]));
 
       /* pack and send data L */
       pack_ix3_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx3_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       /* set physical boundary */
       (*apply_ox3)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[0]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from L and unpack data */
-      ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[0]), MPI_STATUS_IGNORE);
       unpack_ix3_exchange(pG);
 
     }
@@ -369,36 +366,31 @@ void exchange_gpcouple(DomainS *pD, short lab)
   if (pG->Nx[1] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt1 = pG->Nx[0] > 1 ? pG->Nx[0] + 2*NExc : 1;
-    cnt3 = pG->Nx[2] > 1 ? pG->Nx[2] + 2*NOfst: 1;
-    cnt = (NExc+NOfst)*cnt1*cnt3*NVar;
+    recv_prq = recv_prq_lab[lab][1];
+    send_prq = send_prq_lab[lab][1];
 
 /* MPI blocks to both left and right */
     if (pG->rx2_id >= 0 && pG->lx2_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx2_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx2_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_prq[0]));
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data L and R */
       pack_ix2_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx2_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       pack_ox2_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx2_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* check non-blocking sends have completed. */
-      ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
+      ierr = MPI_Waitall(2, send_prq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix2_exchange(pG);
       if (mIndex == 1) unpack_ox2_exchange(pG);
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix2_exchange(pG);
       if (mIndex == 1) unpack_ox2_exchange(pG);
 
@@ -407,23 +399,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
 /* Physical boundary on left, MPI block on right */
     if (pG->rx2_id >= 0 && pG->lx2_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx2_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data R */
       pack_ox2_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx2_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* set physical boundary */
       (*apply_ix2)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[1]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from R and unpack data */
-      ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[1]), MPI_STATUS_IGNORE);
       unpack_ox2_exchange(pG);
 
     }
@@ -431,23 +421,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
 /* MPI block on left, Physical boundary on right */
     if (pG->rx2_id < 0 && pG->lx2_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx2_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_prq[0]));
 
       /* pack and send data L */
       pack_ix2_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx2_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       /* set physical boundary */
       (*apply_ox2)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[0]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from L and unpack data */
-      ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[0]), MPI_STATUS_IGNORE);
       unpack_ix2_exchange(pG);
 
     }
@@ -539,36 +527,31 @@ void exchange_gpcouple(DomainS *pD, short lab)
   if (pG->Nx[0] > 1){
 
 #ifdef MPI_PARALLEL
-    cnt2 = pG->Nx[1] > 1 ? pG->Nx[1] + 2*NOfst : 1;
-    cnt3 = pG->Nx[2] > 1 ? pG->Nx[2] + 2*NOfst : 1;
-    cnt = (NExc+NOfst)*cnt2*cnt3*NVar;
+    recv_prq = recv_prq_lab[lab][0];
+    send_prq = send_prq_lab[lab][0];
 
 /* MPI blocks to both left and right */
     if (pG->rx1_id >= 0 && pG->lx1_id >= 0) {
 
-      /* Post non-blocking receives for data from L and R Grids */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx1_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx1_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receives for data from L and R Grids */
+      ierr = MPI_Start(&(recv_prq[0]));
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data L and R */
       pack_ix1_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx1_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       pack_ox1_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx1_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* check non-blocking sends have completed. */
-      ierr = MPI_Waitall(2, send_rq, MPI_STATUS_IGNORE);
+      ierr = MPI_Waitall(2, send_prq, MPI_STATUS_IGNORE);
 
       /* check non-blocking receives and unpack data in any order. */
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix1_exchange(pG);
       if (mIndex == 1) unpack_ox1_exchange(pG);
-      ierr = MPI_Waitany(2,recv_rq,&mIndex,MPI_STATUS_IGNORE);
+      ierr = MPI_Waitany(2,recv_prq,&mIndex,MPI_STATUS_IGNORE);
       if (mIndex == 0) unpack_ix1_exchange(pG);
       if (mIndex == 1) unpack_ox1_exchange(pG);
     }
@@ -576,23 +559,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
 /* Physical boundary on left, MPI block on right */
     if (pG->rx1_id >= 0 && pG->lx1_id < 0) {
 
-      /* Post non-blocking receive for data from R Grid */
-      ierr = MPI_Irecv(&(recv_buf[1][0]),cnt,MPI_DOUBLE,pG->rx1_id,RtoL_tag,
-        pD->Comm_Domain, &(recv_rq[1]));
+      /* Start persistent receive for data from R Grid */
+      ierr = MPI_Start(&(recv_prq[1]));
 
       /* pack and send data R */
       pack_ox1_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[1][0]),cnt,MPI_DOUBLE,pG->rx1_id,LtoR_tag,
-        pD->Comm_Domain, &(send_rq[1]));
+      ierr = MPI_Start(&(send_prq[1]));
 
       /* set physical boundary */
       (*apply_ix1)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[1]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from R and unpack data */
-      ierr = MPI_Wait(&(recv_rq[1]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[1]), MPI_STATUS_IGNORE);
       unpack_ox1_exchange(pG);
 
     }
@@ -600,23 +581,21 @@ void exchange_gpcouple(DomainS *pD, short lab)
 /* MPI block on left, Physical boundary on right */
     if (pG->rx1_id < 0 && pG->lx1_id >= 0) {
 
-      /* Post non-blocking receive for data from L grid */
-      ierr = MPI_Irecv(&(recv_buf[0][0]),cnt,MPI_DOUBLE,pG->lx1_id,LtoR_tag,
-        pD->Comm_Domain, &(recv_rq[0]));
+      /* Start persistent receive for data from L grid */
+      ierr = MPI_Start(&(recv_prq[0]));
 
       /* pack and send data L */
       pack_ix1_exchange(pG);
-      ierr = MPI_Isend(&(send_buf[0][0]),cnt,MPI_DOUBLE,pG->lx1_id,RtoL_tag,
-        pD->Comm_Domain, &(send_rq[0]));
+      ierr = MPI_Start(&(send_prq[0]));
 
       /* set physical boundary */
       (*apply_ox1)(pG);
 
       /* check non-blocking send has completed. */
-      ierr = MPI_Wait(&(send_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(send_prq[0]), MPI_STATUS_IGNORE);
 
       /* wait on non-blocking receive from L and unpack data */
-      ierr = MPI_Wait(&(recv_rq[0]), MPI_STATUS_IGNORE);
+      ierr = MPI_Wait(&(recv_prq[0]), MPI_STATUS_IGNORE);
       unpack_ix1_exchange(pG);
 
     }
@@ -1628,6 +1607,8 @@ void exchange_gpcouple_init(MeshS *pM)
   if((send_rq = (MPI_Request*) calloc_1d_array(2,sizeof(MPI_Request))) == NULL)
     ath_error("[exchange_init]: Failed to allocate send MPI_Request array\n");
 
+  persist_init(pD);
+
 #endif /* MPI_PARALLEL */
 
   return;
@@ -1671,6 +1652,10 @@ void exchange_gpcouple_fun(enum BCDirection dir, VGFun_t prob_bc)
  *  \brief Finalize the exchange of gas-particle coupling */
 void exchange_gpcouple_destruct(MeshS *pM)
 {
+#ifdef MPI_PARALLEL
+  int lab,m;
+#endif
+
   apply_ix1 = NULL;
   apply_ox1 = NULL;
   apply_ix2 = NULL;
@@ -1686,8 +1671,18 @@ void exchange_gpcouple_destruct(MeshS *pM)
   free_3d_array(TempZns);
 #endif
 #ifdef MPI_PARALLEL
+  for (lab=0; lab<3; lab++) {
+    for (m=0; m<6; m++) {
+      if (recv_prq_lab[lab][m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(recv_prq_lab[lab][m/2][m%2]));
+      if (send_prq_lab[lab][m/2][m%2] != MPI_REQUEST_NULL)
+        MPI_Request_free(&(send_prq_lab[lab][m/2][m%2]));
+    }
+  }
   free_2d_array(send_buf);
   free_2d_array(recv_buf);
+  free_1d_array(recv_rq);
+  free_1d_array(send_rq);
 #endif
   return;
 }
@@ -1702,6 +1697,31 @@ void exchange_gpcouple_destruct(MeshS *pM)
  * where ???=[ix1,ox1,ix2,ox2,ix3,ox3]
  */
 
+/*----------------------------------------------------------------------------*/
+/*! \fn static void set_layers(const short lab)
+ *  \brief Sets the number of variables NVar, ghost layers NExc and grid
+ *   layers NOfst exchanged in step lab (see exchange_gpcouple()).
+ */
+
+static void set_layers(const short lab)
+{
+  switch (lab) {
+    case 0: /* particle binning for output purpose */
+      NVar = 4; NExc = 1; NOfst = 0;
+      break;
+#ifdef FEEDBACK
+    case 1: /* predictor step of feedback exchange */
+      NVar = 5; NExc = 1; NOfst = nghost;
+      break;
+    case 2: /* corrector step of feedback exchange */
+      NVar = 4; NExc = 2; NOfst = 0;
+      break;
+#endif /* FEEDBACK */
+  }
+
+  return;
+}
+
 /*----------------------------------------------------------------------------*/
 /*! \fn static void reflect_ix3_exchange(GridS *pG)
  *  \brief REFLECTING boundary conditions, Inner x3 boundary (ibc_x3=1,5)
@@ -2408,6 +2428,64 @@ static void unpack_ox1_exchange(GridS *pG)
   return;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \fn static void persist_init(DomainS *pD)
+ *  \brief Creates persistent requests for the exchange with the L and R Grids
+ *   in each direction, for each step lab, restarted with MPI_Start() on every
+ *   call to exchange_gpcouple().  Counts are those of pack_???_exchange().
+ */
+
+static void persist_init(DomainS *pD)
+{
+  GridS *pG = pD->Grid;
+  int cnt[3],lid[3],rid[3],nx[3],dir,lab,nlab,ierr;
+
+  lid[0] = pG->lx1_id;  rid[0] = pG->rx1_id;
+  lid[1] = pG->lx2_id;  rid[1] = pG->rx2_id;
+  lid[2] = pG->lx3_id;  rid[2] = pG->rx3_id;
+
+#ifdef FEEDBACK
+  nlab = 3;
+#else
+  nlab = 1;
+#endif
+
+  for (lab=0; lab<3; lab++) {
+    for (dir=0; dir<3; dir++) {
+      recv_prq_lab[lab][dir][0] = recv_prq_lab[lab][dir][1] = MPI_REQUEST_NULL;
+      send_prq_lab[lab][dir][0] = send_prq_lab[lab][dir][1] = MPI_REQUEST_NULL;
+    }
+    if (lab >= nlab) continue;
+
+    set_layers(lab);
+    for (dir=0; dir<3; dir++) nx[dir] = pG->Nx[dir];
+    cnt[2] = (NExc+NOfst)*NVar*(nx[0] > 1 ? nx[0] + 2*NExc : 1)
+                              *(nx[1] > 1 ? nx[1] + 2*NExc : 1);
+    cnt[1] = (NExc+NOfst)*NVar*(nx[0] > 1 ? nx[0] + 2*NExc : 1)
+                              *(nx[2] > 1 ? nx[2] + 2*NOfst : 1);
+    cnt[0] = (NExc+NOfst)*NVar*(nx[1] > 1 ? nx[1] + 2*NOfst : 1)
+                              *(nx[2] > 1 ? nx[2] + 2*NOfst : 1);
+
+    for (dir=0; dir<3; dir++) {
+      if (nx[dir] == 1) continue;
+      if (lid[dir] >= 0) {
+        ierr = MPI_Recv_init(&(recv_buf[0][0]),cnt[dir],MPI_DOUBLE,lid[dir],
+          LtoR_tag, pD->Comm_Domain, &(recv_prq_lab[lab][dir][0]));
+        ierr = MPI_Send_init(&(send_buf[0][0]),cnt[dir],MPI_DOUBLE,lid[dir],
+          RtoL_tag, pD->Comm_Domain, &(send_prq_lab[lab][dir][0]));
+      }
+      if (rid[dir] >= 0) {
+        ierr = MPI_Recv_init(&(recv_buf[1][0]),cnt[dir],MPI_DOUBLE,rid[dir],
+          RtoL_tag, pD->Comm_Domain, &(recv_prq_lab[lab][dir][1]));
+        ierr = MPI_Send_init(&(send_buf[1][0]),cnt[dir],MPI_DOUBLE,rid[dir],
+          LtoR_tag, pD->Comm_Domain, &(send_prq_lab[lab][dir][1]));
+      }
+    }
+  }
+
+  return;
+}
+
 #ifdef SHEARING_BOX
 /*----------------------------------------------------------------------------*/
 /*! \fn static void unpack_ix2_remap(GridS *pG)
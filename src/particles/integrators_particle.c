@@ -557,7 +557,7 @@ void feedback_predictor(DomainS *pD)
     for (j=jlp; j<=jup; j++)
       for (i=ilp; i<=iup; i++)
       {
-        pG->Coup[k][j][i].FBstiff /= pG->U[k][j][i].d;
+        pG->Coup[k][j][i].FBstiff /= UVAR(pG->U,k,j,i,d);
 
         stiffness = 1.0/MAX(1.0, pG->Coup[k][j][i].FBstiff);
 
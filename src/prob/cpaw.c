@@ -275,18 +275,18 @@ void problem(DomainS *pDomain)
   for (k=ks; k<=ke; k++) {
   for (j=js; j<=je; j++) {
   for (i=is; i<=ie; i++) {
-    pGrid->U[k][j][i].B1c = 0.5*(pGrid->B1i[k][j][i]+pGrid->B1i[k][j][i+1]);
+    UVAR(pGrid->U,k,j,i,B1c) = 0.5*(pGrid->B1i[k][j][i]+pGrid->B1i[k][j][i+1]);
   }}}
 
   if (pGrid->Nx[1] > 1) {
     for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pGrid->U[k][j][i].B2c = 0.5*(pGrid->B2i[k][j][i]+pGrid->B2i[k][j+1][i]);
+      UVAR(pGrid->U,k,j,i,B2c) = 0.5*(pGrid->B2i[k][j][i]+pGrid->B2i[k][j+1][i]);
     }}}
   } else {
     for (i=is; i<=ie; i++) {
-      pGrid->U[ks][js][i].B2c = pGrid->B2i[ks][js][i];
+      UVAR(pGrid->U,ks,js,i,B2c) = pGrid->B2i[ks][js][i];
     }
   }
 
@@ -294,12 +294,12 @@ void problem(DomainS *pDomain)
     for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pGrid->U[k][j][i].B3c = 0.5*(pGrid->B3i[k][j][i]+pGrid->B3i[k+1][j][i]);
+      UVAR(pGrid->U,k,j,i,B3c) = 0.5*(pGrid->B3i[k][j][i]+pGrid->B3i[k+1][j][i]);
     }}}
   } else {
     for (j=js; j<=je; j++) {
     for (i=is; i<=ie; i++) {
-      pGrid->U[ks][j][i].B3c = pGrid->B3i[ks][j][i];
+      UVAR(pGrid->U,ks,j,i,B3c) = pGrid->B3i[ks][j][i];
     }}
   }
 
@@ -313,38 +313,38 @@ void problem(DomainS *pDomain)
 	sn = sin(k_par*x);
 	cs = fac*cos(k_par*x);
 
-	pGrid->U[k][j][i].d  = den;
+	UVAR(pGrid->U,k,j,i,d)  = den;
 
         Mx = den*v_par;
         My = -fac*den*v_perp*sn;
         Mz = -den*v_perp*cs;
 
-        pGrid->U[k][j][i].M1 = Mx*cos_a2*cos_a3 - My*sin_a3 - Mz*sin_a2*cos_a3;
-        pGrid->U[k][j][i].M2 = Mx*cos_a2*sin_a3 + My*cos_a3 - Mz*sin_a2*sin_a3;
-        pGrid->U[k][j][i].M3 = Mx*sin_a2                    + Mz*cos_a2;
+        UVAR(pGrid->U,k,j,i,M1) = Mx*cos_a2*cos_a3 - My*sin_a3 - Mz*sin_a2*cos_a3;
+        UVAR(pGrid->U,k,j,i,M2) = Mx*cos_a2*sin_a3 + My*cos_a3 - Mz*sin_a2*sin_a3;
+        UVAR(pGrid->U,k,j,i,M3) = Mx*sin_a2                    + Mz*cos_a2;
 
 
 /*
-	pGrid->U[k][j][i].M1 = den*(v_par*cos_a2*cos_a3 +
+	UVAR(pGrid->U,k,j,i,M1) = den*(v_par*cos_a2*cos_a3 +
 				    v_perp*sn*sin_a3 +
 				    v_perp*cs*sin_a2*cos_a3);
 
-	pGrid->U[k][j][i].M2 = den*(v_par*cos_a2*sin_a3 -
+	UVAR(pGrid->U,k,j,i,M2) = den*(v_par*cos_a2*sin_a3 -
 				    v_perp*sn*cos_a3 +
 				    v_perp*cs*sin_a2*sin_a3);
 
-	pGrid->U[k][j][i].M3 = den*(v_par*sin_a2 -
+	UVAR(pGrid->U,k,j,i,M3) = den*(v_par*sin_a2 -
 				    v_perp*cs*cos_a2);
 */
 
 #ifndef ISOTHERMAL
-	pGrid->U[k][j][i].E = pres/Gamma_1 
-	  + 0.5*(SQR(pGrid->U[k][j][i].B1c) +
-		 SQR(pGrid->U[k][j][i].B2c) +
-		 SQR(pGrid->U[k][j][i].B3c) )
-	  + 0.5*(SQR(pGrid->U[k][j][i].M1) +
-		 SQR(pGrid->U[k][j][i].M2) +
-		 SQR(pGrid->U[k][j][i].M3) )/den;
+	UVAR(pGrid->U,k,j,i,E) = pres/Gamma_1 
+	  + 0.5*(SQR(UVAR(pGrid->U,k,j,i,B1c)) +
+		 SQR(UVAR(pGrid->U,k,j,i,B2c)) +
+		 SQR(UVAR(pGrid->U,k,j,i,B3c)) )
+	  + 0.5*(SQR(UVAR(pGrid->U,k,j,i,M1)) +
+		 SQR(UVAR(pGrid->U,k,j,i,M2)) +
+		 SQR(UVAR(pGrid->U,k,j,i,M3)) )/den;
 #endif
 
       }
@@ -538,15 +538,15 @@ void Userwork_after_loop(MeshS *pM)
 #endif /* ISOTHERMAL */
 
     for (i=is; i<=ie; i++) {
-      error.d   += fabs(pGrid->U[k][j][i].d   - RootSoln[k][j][i].d);
-      error.M1  += fabs(pGrid->U[k][j][i].M1  - RootSoln[k][j][i].M1);
-      error.M2  += fabs(pGrid->U[k][j][i].M2  - RootSoln[k][j][i].M2);
-      error.M3  += fabs(pGrid->U[k][j][i].M3  - RootSoln[k][j][i].M3); 
-      error.B1c += fabs(pGrid->U[k][j][i].B1c - RootSoln[k][j][i].B1c);
-      error.B2c += fabs(pGrid->U[k][j][i].B2c - RootSoln[k][j][i].B2c);
-      error.B3c += fabs(pGrid->U[k][j][i].B3c - RootSoln[k][j][i].B3c);
+      error.d   += fabs(UVAR(pGrid->U,k,j,i,d)   - RootSoln[k][j][i].d);
+      error.M1  += fabs(UVAR(pGrid->U,k,j,i,M1)  - RootSoln[k][j][i].M1);
+      error.M2  += fabs(UVAR(pGrid->U,k,j,i,M2)  - RootSoln[k][j][i].M2);
+      error.M3  += fabs(UVAR(pGrid->U,k,j,i,M3)  - RootSoln[k][j][i].M3); 
+      error.B1c += fabs(UVAR(pGrid->U,k,j,i,B1c) - RootSoln[k][j][i].B1c);
+      error.B2c += fabs(UVAR(pGrid->U,k,j,i,B2c) - RootSoln[k][j][i].B2c);
+      error.B3c += fabs(UVAR(pGrid->U,k,j,i,B3c) - RootSoln[k][j][i].B3c);
 #ifndef ISOTHERMAL
-      error.E   += fabs(pGrid->U[k][j][i].E   -  RootSoln[k][j][i].E);
+      error.E   += fabs(UVAR(pGrid->U,k,j,i,E)   -  RootSoln[k][j][i].E);
 #endif /* ISOTHERMAL */
     }
 
@@ -106,16 +106,16 @@ void problem(DomainS *pDomain)
       for (i=il; i<=iu; i++) {
         cc_pos(pG,i,j,k,&x1c,&x2c,&x3c);
         fc_pos(pG,i,j,k,&x1f,&x2f,&x3f);
-        memset(&(pG->U[k][j][i]),0.0,sizeof(ConsS));
+        UZERO(pG->U,k,j,i);
 
-        pG->U[k][j][i].d  = 1.0;
+        UVAR(pG->U,k,j,i,d)  = 1.0;
         switch (iprob) {
           case 1:
 #ifndef CYLINDRICAL
   ath_error("[cyldiff]: iprob=1 only works in cylindrical!\n");
 #endif
 #ifdef MHD
-                  pG->U[k][j][i].B3c = jn(mm,lambdamn*x1c)*cos(mm*x2c);
+                  UVAR(pG->U,k,j,i,B3c) = jn(mm,lambdamn*x1c)*cos(mm*x2c);
                   pG->B3i[k][j][i]   = jn(mm,lambdamn*x1f)*cos(mm*x2f);
 #endif
 
@@ -126,7 +126,7 @@ void problem(DomainS *pDomain)
 #endif
 
 #ifdef MHD
-                  pG->U[k][j][i].B3c = 1.0-SQR(x1c);
+                  UVAR(pG->U,k,j,i,B3c) = 1.0-SQR(x1c);
                   pG->B3i[k][j][i]   = 1.0-SQR(x1f);
 #endif
                   break;
@@ -134,7 +134,7 @@ void problem(DomainS *pDomain)
                   ath_error("[cyldiff]:  Not an accepted problem number\n");
         }
 
-        RootSoln[k][j][i] = pG->U[k][j][i].B3c;
+        RootSoln[k][j][i] = UVAR(pG->U,k,j,i,B3c);
       }
     }
   }
@@ -243,7 +243,7 @@ void Userwork_after_loop(MeshS *pM)
   for (k=ks; k<=ke; k++) {
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
-        error += fabs(pG->U[k][j][i].B3c - RootSoln[k][j][i]*tfact);
+        error += fabs(UVAR(pG->U,k,j,i,B3c) - RootSoln[k][j][i]*tfact);
       }
     }
   }
@@ -307,13 +307,13 @@ void cyldiff_ix1(GridS *pG)
           case 1:        
 #ifdef MHD
 
-            pG->U[k][j][is-i].B3c = jn(mm,lambdamn*x1c)*cos(mm*x2c)*exp(-om_diff*pG->time);
+            UVAR(pG->U,k,j,is-i,B3c) = jn(mm,lambdamn*x1c)*cos(mm*x2c)*exp(-om_diff*pG->time);
             pG->B3i[k][j][is-i]   = jn(mm,lambdamn*x1f)*cos(mm*x2f)*exp(-om_diff*pG->time);
 #endif
             break;
           default:
 #ifdef MHD
-            pG->U[k][j][is-i].B3c = pG->U[k][j][is].B3c;
+            UVAR(pG->U,k,j,is-i,B3c) = UVAR(pG->U,k,j,is,B3c);
             pG->B3i[k][j][is-i]   = pG->B3i[k][j][is];
 #endif
         }
@@ -348,13 +348,13 @@ void cyldiff_ox1(GridS *pG)
         switch(iprob){
           case 1:        
 #ifdef MHD
-            pG->U[k][j][ie+i].B3c = 0.;
+            UVAR(pG->U,k,j,ie+i,B3c) = 0.;
             pG->B3i[k][j][ie+i]   = 0.;
 #endif
             break;
           default:
 #ifdef MHD
-            pG->U[k][j][ie+i].B3c = pG->U[k][j][ie].B3c;
+            UVAR(pG->U,k,j,ie+i,B3c) = UVAR(pG->U,k,j,ie,B3c);
             pG->B3i[k][j][ie+i]   = pG->B3i[k][j][ie];
 #endif
         }
@@ -385,13 +385,13 @@ void cyldiff_ix2(GridS *pG)
         switch(iprob){
           case 1:        
 #ifdef MHD
-            pG->U[k][js-j][i].B3c = 0.;
+            UVAR(pG->U,k,js-j,i,B3c) = 0.;
             pG->B3i[k][js-j][i]   = 0.;
 #endif
             break;
           default:
 #ifdef MHD
-            pG->U[k][js-j][i].B3c = pG->U[k][js][i].B3c;
+            UVAR(pG->U,k,js-j,i,B3c) = UVAR(pG->U,k,js,i,B3c);
             pG->B3i[k][js-j][i]   = pG->B3i[k][js][i];
 #endif
         }
@@ -423,13 +423,13 @@ void cyldiff_ox2(GridS *pG)
         switch(iprob){
           case 1:        
 #ifdef MHD
-            pG->U[k][je+j][i].B3c = 0.;
+            UVAR(pG->U,k,je+j,i,B3c) = 0.;
             pG->B3i[k][je+j][i]   = 0.;
 #endif
             break;
           default:
 #ifdef MHD
-            pG->U[k][je+j][i].B3c = pG->U[k][je][i].B3c;
+            UVAR(pG->U,k,je+j,i,B3c) = UVAR(pG->U,k,je,i,B3c);
             pG->B3i[k][je+j][i]   = pG->B3i[k][je][i];
 #endif
         }
@@ -94,17 +94,17 @@ void problem(DomainS *pDomain)
 //        vt = vcir*(1.-1./(1+x1*x1));
         vt = x1*Omega(x1);
 
-        pG->U[k][j][i].d  = rho0;
-        pG->U[k][j][i].M1 = 0.0;
+        UVAR(pG->U,k,j,i,d)  = rho0;
+        UVAR(pG->U,k,j,i,M1) = 0.0;
 
 #ifndef FARGO
-        pG->U[k][j][i].M2 = rho0*vt;
+        UVAR(pG->U,k,j,i,M2) = rho0*vt;
 #else
-        pG->U[k][j][i].M2 = 0.0;
+        UVAR(pG->U,k,j,i,M2) = 0.0;
 #endif
 
 #ifdef MHD
-        pG->U[k][j][i].B2c = bphi0/x1;
+        UVAR(pG->U,k,j,i,B2c) = bphi0/x1;
         pG->B2i[k][j][i]   = bphi0/x1;
 #endif
 
@@ -112,10 +112,10 @@ void problem(DomainS *pDomain)
         Eint = pgas0/Gamma_1;
         Emag = 0.0;
 #ifdef MHD
-        Emag = 0.5*(SQR(pG->U[k][j][i].B1c) + SQR(pG->U[k][j][i].B2c) + SQR(pG->U[k][j][i].B3c));
+        Emag = 0.5*(SQR(UVAR(pG->U,k,j,i,B1c)) + SQR(UVAR(pG->U,k,j,i,B2c)) + SQR(UVAR(pG->U,k,j,i,B3c)));
 #endif
-        Ekin = 0.5*(SQR(pG->U[k][j][i].M1 ) + SQR(pG->U[k][j][i].M2 ) + SQR(pG->U[k][j][i].M3 ))/pG->U[k][j][i].d;
-        pG->U[k][j][i].E = Eint + Emag + Ekin;
+        Ekin = 0.5*(SQR(UVAR(pG->U,k,j,i,M1) ) + SQR(UVAR(pG->U,k,j,i,M2) ) + SQR(UVAR(pG->U,k,j,i,M3) ))/UVAR(pG->U,k,j,i,d);
+        UVAR(pG->U,k,j,i,E) = Eint + Emag + Ekin;
 #endif
       }
     }
@@ -82,7 +82,7 @@ void problem(DomainS *pDomain)
   // Compute 1D wind/accretion solution
   for (i=il; i<=iu; i++) {
     cc_pos(pG,i,j,k,&x1,&x2,&x3);
-    memset(&(pG->U[ks][js][i]),0.0,sizeof(ConsS));
+    UZERO(pG->U,ks,js,i);
     vs = pow(lambda_s/x1,0.5*beta);
 
     switch(iprob) {
@@ -108,19 +108,19 @@ void problem(DomainS *pDomain)
     converged = bisection(myfunc,a,b,x1,&v);
     if (!converged) ath_error("[cylwindrot]:  Bisection did not converge!\n");
 
-    pG->U[ks][js][i].d   = lambda_s/(x1*v);
-    pG->U[ks][js][i].M1  = lambda_s/x1;
+    UVAR(pG->U,ks,js,i,d)   = lambda_s/(x1*v);
+    UVAR(pG->U,ks,js,i,M1)  = lambda_s/x1;
     if (iprob==2)
-      pG->U[ks][js][i].M1  *= -1.0;
-    pG->U[ks][js][i].M2  = pG->U[ks][js][i].d*ang_mom/x1;
-    pG->U[ks][js][i].M3  = pG->U[ks][js][i].d*vz0;
+      UVAR(pG->U,ks,js,i,M1)  *= -1.0;
+    UVAR(pG->U,ks,js,i,M2)  = UVAR(pG->U,ks,js,i,d)*ang_mom/x1;
+    UVAR(pG->U,ks,js,i,M3)  = UVAR(pG->U,ks,js,i,d)*vz0;
 
         /* Initialize total energy */
 #ifndef ISOTHERMAL
         pgas0 = 1.0/Gamma;
-        pgas = pgas0*pow(pG->U[ks][js][i].d,Gamma);
-        pG->U[ks][js][i].E = pgas/Gamma_1
-          + 0.5*(SQR(pG->U[ks][js][i].M1) + SQR(pG->U[ks][js][i].M2) + SQR(pG->U[ks][js][i].M3))/pG->U[ks][js][i].d;
+        pgas = pgas0*pow(UVAR(pG->U,ks,js,i,d),Gamma);
+        UVAR(pG->U,ks,js,i,E) = pgas/Gamma_1
+          + 0.5*(SQR(UVAR(pG->U,ks,js,i,M1)) + SQR(UVAR(pG->U,ks,js,i,M2)) + SQR(UVAR(pG->U,ks,js,i,M3)))/UVAR(pG->U,ks,js,i,d);
 #endif /* ISOTHERMAL */
   }
 
@@ -128,8 +128,8 @@ void problem(DomainS *pDomain)
   for (k=kl; k<=ku; k++) {
     for (j=jl; j<=ju; j++) {
       for (i=il; i<=iu; i++) {
-        pG->U[k][j][i] = pG->U[ks][js][i];
-        RootSoln[k][j][i] = pG->U[ks][js][i];
+        UCOPY(pG->U,k,j,i,ks,js,i);
+        RootSoln[k][j][i] = UCELL(pG->U,ks,js,i);
       }
     }
   }
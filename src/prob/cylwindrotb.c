@@ -43,7 +43,7 @@ void problem(DomainS *pDomain)
   Real x,y,xslow,yslow,xfast,yfast;
   Real R0,R1,R2,rho,Mdot,K,Omega,Pgas,beta,vR,BR,vphi,Bphi;
   ConsS *Wind=NULL;
-  Real *pU=NULL,*pUl=NULL,*pUr=NULL;
+  Real *pUl=NULL,*pUr=NULL;
   Real lsf,rsf;
 
   is = pG->is;  ie = pG->ie;  nx1 = ie-is+1;
@@ -156,16 +156,15 @@ void problem(DomainS *pDomain)
 
   /* Average the wind solution across the zone for cc variables */
   for (i=il; i<=iu; i++) {
-    memset(&(pG->U[ks][js][i]),0.0,sizeof(ConsS));
+    UZERO(pG->U,ks,js,i);
     cc_pos(pG,i,js,ks,&x1,&x2,&x3);
     lsf = (x1 - 0.5*pG->dx1)/x1;
     rsf = (x1 + 0.5*pG->dx1)/x1;
 
-    pU  = (Real*)&(pG->U[ks][js][i]);
     pUl = (Real*)&(Wind[i]);
     pUr = (Real*)&(Wind[i+1]);
     for (n=0; n<NWAVE; n++) {
-      pU[n] = 0.5*(lsf*pUl[n] + rsf*pUr[n]);
+      UVARN(pG->U,ks,js,i,n) = 0.5*(lsf*pUl[n] + rsf*pUr[n]);
     }
 
     pG->B1i[ks][js][i]   = Wind[i].B1c;
@@ -177,11 +176,11 @@ void problem(DomainS *pDomain)
   for (k=kl; k<=ku; k++) {
     for (j=jl; j<=ju; j++) {
       for (i=il; i<=iu; i++) {
-        pG->U[k][j][i] = pG->U[ks][js][i];
+        UCOPY(pG->U,k,j,i,ks,js,i);
         pG->B1i[k][j][i] = pG->B1i[ks][js][i];
         pG->B2i[k][j][i] = pG->B2i[ks][js][i];
         pG->B3i[k][j][i] = pG->B3i[ks][js][i];
-        RootSoln[k][j][i]  = pG->U[ks][js][i];
+        RootSoln[k][j][i]  = UCELL(pG->U,ks,js,i);
       }
     }
   }
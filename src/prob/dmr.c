@@ -68,16 +68,16 @@ void problem(DomainS *pDomain)
       cc_pos(pGrid,i,j,ks,&x1,&x2,&x3);
       x1_shock = 0.1666666666 + x2/sqrt((double)3.0);
 /* upstream conditions */
-      pGrid->U[ks][j][i].d = 1.4;
-      pGrid->U[ks][j][i].E = 2.5;
-      pGrid->U[ks][j][i].M1 = 0.0;
-      pGrid->U[ks][j][i].M2 = 0.0;
+      UVAR(pGrid->U,ks,j,i,d) = 1.4;
+      UVAR(pGrid->U,ks,j,i,E) = 2.5;
+      UVAR(pGrid->U,ks,j,i,M1) = 0.0;
+      UVAR(pGrid->U,ks,j,i,M2) = 0.0;
 /* downstream conditions */
       if (x1 < x1_shock) {
-        pGrid->U[ks][j][i].d = d0;
-        pGrid->U[ks][j][i].E = e0 + 0.5*d0*(u0*u0+v0*v0);
-        pGrid->U[ks][j][i].M1 = d0*u0;
-        pGrid->U[ks][j][i].M2 = d0*v0;
+        UVAR(pGrid->U,ks,j,i,d) = d0;
+        UVAR(pGrid->U,ks,j,i,E) = e0 + 0.5*d0*(u0*u0+v0*v0);
+        UVAR(pGrid->U,ks,j,i,M1) = d0*u0;
+        UVAR(pGrid->U,ks,j,i,M2) = d0*v0;
       }
     }
   }
@@ -156,10 +156,10 @@ Real d0,e0,u0,v0;
 
   for (j=jl; j<=ju;  j++) {
     for (i=1;  i<=nghost;  i++) {
-      pGrid->U[ks][j][is-i].d  = d0;
-      pGrid->U[ks][j][is-i].M1 = d0*u0;
-      pGrid->U[ks][j][is-i].M2 = d0*v0;
-      pGrid->U[ks][j][is-i].E  = e0 + 0.5*d0*(u0*u0+v0*v0);
+      UVAR(pGrid->U,ks,j,is-i,d)  = d0;
+      UVAR(pGrid->U,ks,j,is-i,M1) = d0*u0;
+      UVAR(pGrid->U,ks,j,is-i,M2) = d0*v0;
+      UVAR(pGrid->U,ks,j,is-i,E)  = e0 + 0.5*d0*(u0*u0+v0*v0);
     }
   }
 }
@@ -194,16 +194,16 @@ Real d0,e0,u0,v0,x1,x2,x3;
       cc_pos(pGrid,i,j,ks,&x1,&x2,&x3);
       if (x1 < 0.1666666666) {
 /* fixed at downstream state */
-        pGrid->U[ks][js-j][i].d  = d0;
-        pGrid->U[ks][js-j][i].M1 = d0*u0;
-        pGrid->U[ks][js-j][i].M2 = d0*v0;
-        pGrid->U[ks][js-j][i].E  = e0 + 0.5*d0*(u0*u0+v0*v0);
+        UVAR(pGrid->U,ks,js-j,i,d)  = d0;
+        UVAR(pGrid->U,ks,js-j,i,M1) = d0*u0;
+        UVAR(pGrid->U,ks,js-j,i,M2) = d0*v0;
+        UVAR(pGrid->U,ks,js-j,i,E)  = e0 + 0.5*d0*(u0*u0+v0*v0);
       } else {
 /* reflected */
-        pGrid->U[ks][js-j][i].d  = pGrid->U[ks][js+(j-1)][i].d;
-        pGrid->U[ks][js-j][i].M1 = pGrid->U[ks][js+(j-1)][i].M1;
-        pGrid->U[ks][js-j][i].M2 = -pGrid->U[ks][js+(j-1)][i].M2;
-        pGrid->U[ks][js-j][i].E  = pGrid->U[ks][js+(j-1)][i].E;
+        UVAR(pGrid->U,ks,js-j,i,d)  = UVAR(pGrid->U,ks,js+(j-1),i,d);
+        UVAR(pGrid->U,ks,js-j,i,M1) = UVAR(pGrid->U,ks,js+(j-1),i,M1);
+        UVAR(pGrid->U,ks,js-j,i,M2) = -UVAR(pGrid->U,ks,js+(j-1),i,M2);
+        UVAR(pGrid->U,ks,js-j,i,E)  = UVAR(pGrid->U,ks,js+(j-1),i,E);
       }
     }
   }
@@ -242,16 +242,16 @@ Real d0,e0,u0,v0,x1_shock,x1,x2,x3;
       cc_pos(pGrid,i,j,ks,&x1,&x2,&x3);
       if (x1 < x1_shock) {
 /* fixed at downstream state */
-        pGrid->U[ks][je+j][i].d  = d0;
-        pGrid->U[ks][je+j][i].M1 = d0*u0;
-        pGrid->U[ks][je+j][i].M2 = d0*v0;
-        pGrid->U[ks][je+j][i].E  = e0 + 0.5*d0*(u0*u0+v0*v0);
+        UVAR(pGrid->U,ks,je+j,i,d)  = d0;
+        UVAR(pGrid->U,ks,je+j,i,M1) = d0*u0;
+        UVAR(pGrid->U,ks,je+j,i,M2) = d0*v0;
+        UVAR(pGrid->U,ks,je+j,i,E)  = e0 + 0.5*d0*(u0*u0+v0*v0);
       } else {
 /* fixed at upstream state */
-        pGrid->U[ks][je+j][i].d  = 1.4;
-        pGrid->U[ks][je+j][i].M1 = 0.0;
-        pGrid->U[ks][je+j][i].M2 = 0.0;
-        pGrid->U[ks][je+j][i].E  = 2.5;
+        UVAR(pGrid->U,ks,je+j,i,d)  = 1.4;
+        UVAR(pGrid->U,ks,je+j,i,M1) = 0.0;
+        UVAR(pGrid->U,ks,je+j,i,M2) = 0.0;
+        UVAR(pGrid->U,ks,je+j,i,E)  = 2.5;
       }
     }
   }
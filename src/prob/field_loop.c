@@ -235,22 +235,22 @@ void problem(DomainS *pDomain)
   for (k=ks; k<=ke; k++) {
   for (j=js; j<=je; j++) {
   for (i=is; i<=ie; i++) {
-     pGrid->U[k][j][i].d = 1.0;
-     pGrid->U[k][j][i].M1 = pGrid->U[k][j][i].d*vflow*x1size/diag;
-     pGrid->U[k][j][i].M2 = pGrid->U[k][j][i].d*vflow*x2size/diag;
-     pGrid->U[k][j][i].M3 = pGrid->U[k][j][i].d*vflow*x3size/diag;
+     UVAR(pGrid->U,k,j,i,d) = 1.0;
+     UVAR(pGrid->U,k,j,i,M1) = UVAR(pGrid->U,k,j,i,d)*vflow*x1size/diag;
+     UVAR(pGrid->U,k,j,i,M2) = UVAR(pGrid->U,k,j,i,d)*vflow*x2size/diag;
+     UVAR(pGrid->U,k,j,i,M3) = UVAR(pGrid->U,k,j,i,d)*vflow*x3size/diag;
 
      cc_pos(pGrid,i,j,k,&x1c,&x2c,&x3c);
      if ((x1c*x1c + x2c*x2c + x3c*x3c) < rad*rad) {
-       pGrid->U[k][j][i].d = drat;
-       pGrid->U[k][j][i].M1 = pGrid->U[k][j][i].d*vflow*x1size/diag;
-       pGrid->U[k][j][i].M2 = pGrid->U[k][j][i].d*vflow*x2size/diag;
-       pGrid->U[k][j][i].M3 = pGrid->U[k][j][i].d*vflow*x3size/diag;
+       UVAR(pGrid->U,k,j,i,d) = drat;
+       UVAR(pGrid->U,k,j,i,M1) = UVAR(pGrid->U,k,j,i,d)*vflow*x1size/diag;
+       UVAR(pGrid->U,k,j,i,M2) = UVAR(pGrid->U,k,j,i,d)*vflow*x2size/diag;
+       UVAR(pGrid->U,k,j,i,M3) = UVAR(pGrid->U,k,j,i,d)*vflow*x3size/diag;
      }
 #if (NSCALARS > 0)
-     for (n=0; n<NSCALARS; n++) pGrid->U[k][j][i].s[n] = 0.0;
+     for (n=0; n<NSCALARS; n++) UVAR(pGrid->U,k,j,i,s[n]) = 0.0;
      if ((x1c*x1c + x2c*x2c + x3c*x3c) < rad*rad) {
-       for (n=0; n<NSCALARS; n++)  pGrid->U[k][j][i].s[n] = 1.0;
+       for (n=0; n<NSCALARS; n++)  UVAR(pGrid->U,k,j,i,s[n]) = 1.0;
      }
 #endif
   }}}
@@ -290,25 +290,25 @@ void problem(DomainS *pDomain)
     for (j=js; j<=je; j++) {
       for (i=is; i<=ie; i++) {
 #ifdef MHD
-        pGrid->U[k][j][i].B1c = 0.5*(pGrid->B1i[k][j][i  ] + 
+        UVAR(pGrid->U,k,j,i,B1c) = 0.5*(pGrid->B1i[k][j][i  ] + 
                                      pGrid->B1i[k][j][i+1]);
-        pGrid->U[k][j][i].B2c = 0.5*(pGrid->B2i[k][j  ][i] +
+        UVAR(pGrid->U,k,j,i,B2c) = 0.5*(pGrid->B2i[k][j  ][i] +
                                      pGrid->B2i[k][j+1][i]);
 	if (ke > ks)
-	  pGrid->U[k][j][i].B3c = 0.5*(pGrid->B3i[k  ][j][i] + 
+	  UVAR(pGrid->U,k,j,i,B3c) = 0.5*(pGrid->B3i[k  ][j][i] + 
                                        pGrid->B3i[k+1][j][i]);
 	else
-	  pGrid->U[k][j][i].B3c = pGrid->B3i[k][j][i];
+	  UVAR(pGrid->U,k,j,i,B3c) = pGrid->B3i[k][j][i];
 #endif
 
 #ifndef ISOTHERMAL
-	pGrid->U[k][j][i].E = 1.0/Gamma_1
+	UVAR(pGrid->U,k,j,i,E) = 1.0/Gamma_1
 #ifdef MHD
-	  + 0.5*(SQR(pGrid->U[k][j][i].B1c) + SQR(pGrid->U[k][j][i].B2c)
-               + SQR(pGrid->U[k][j][i].B3c))
+	  + 0.5*(SQR(UVAR(pGrid->U,k,j,i,B1c)) + SQR(UVAR(pGrid->U,k,j,i,B2c))
+               + SQR(UVAR(pGrid->U,k,j,i,B3c)))
 #endif
-	  + 0.5*(SQR(pGrid->U[k][j][i].M1) + SQR(pGrid->U[k][j][i].M2)
-               + SQR(pGrid->U[k][j][i].M3))/pGrid->U[k][j][i].d;
+	  + 0.5*(SQR(UVAR(pGrid->U,k,j,i,M1)) + SQR(UVAR(pGrid->U,k,j,i,M2))
+               + SQR(UVAR(pGrid->U,k,j,i,M3)))/UVAR(pGrid->U,k,j,i,d);
 #endif /* ISOTHERMAL */
       }
     }
@@ -360,8 +360,8 @@ static Real current(const GridS *pG, const int i, const int j, const int k)
  *  \brief computes magnetic pressure (Bx2 + By2) */
 static Real Bp2(const GridS *pG, const int i, const int j, const int k)
 {
-  return (pG->U[k][j][i].B1c*pG->U[k][j][i].B1c + 
-	  pG->U[k][j][i].B2c*pG->U[k][j][i].B2c);
+  return (UVAR(pG->U,k,j,i,B1c)*UVAR(pG->U,k,j,i,B1c) + 
+	  UVAR(pG->U,k,j,i,B2c)*UVAR(pG->U,k,j,i,B2c));
 }
 
 /*! \fn static Real divB(const GridS *pG, const int i, const int j, const int k)
@@ -386,7 +386,7 @@ static Real divB(const GridS *pG, const int i, const int j, const int k)
  *  \brief returns first passively advected scalar s[0] */
 static Real color(const GridS *pG, const int i, const int j, const int k)
 {
-  return pG->U[k][j][i].s[0]/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,s[0])/UVAR(pG->U,k,j,i,d);
 }
 #endif
 
@@ -397,13 +397,13 @@ static Real color(const GridS *pG, const int i, const int j, const int k)
 static Real Temperature(const GridS *pG, const int i, const int j, const int k)
 {
   Real Temp;
-  Temp = pG->U[k][j][i].E - (0.5/pG->U[k][j][i].d)*(
-    SQR(pG->U[k][j][i].M1) + SQR(pG->U[k][j][i].M2) + SQR(pG->U[k][j][i].M3));
+  Temp = UVAR(pG->U,k,j,i,E) - (0.5/UVAR(pG->U,k,j,i,d))*(
+    SQR(UVAR(pG->U,k,j,i,M1)) + SQR(UVAR(pG->U,k,j,i,M2)) + SQR(UVAR(pG->U,k,j,i,M3)));
 #ifdef MHD
-  Temp -= 0.5*(SQR(pG->U[k][j][i].B1c) + SQR(pG->U[k][j][i].B2c) 
-            + SQR(pG->U[k][j][i].B3c));
+  Temp -= 0.5*(SQR(UVAR(pG->U,k,j,i,B1c)) + SQR(UVAR(pG->U,k,j,i,B2c)) 
+            + SQR(UVAR(pG->U,k,j,i,B3c)));
 #endif
-  Temp *= Gamma_1/pG->U[k][j][i].d;
+  Temp *= Gamma_1/UVAR(pG->U,k,j,i,d);
   return Temp;
 }
 #endif
@@ -455,9 +455,9 @@ void Userwork_after_loop(MeshS *pM)
           divB += (pG->B3i[k+1][j][i] - pG->B3i[k][j][i])/pG->dx3;
 
         maxdivB = MAX(maxdivB,fabs(divB));
-        maxB1 = MAX(maxB1,fabs(pG->U[k][j][i].B1c));
-        maxB2 = MAX(maxB2,fabs(pG->U[k][j][i].B2c));
-        maxB3 = MAX(maxB3,fabs(pG->U[k][j][i].B3c));
+        maxB1 = MAX(maxB1,fabs(UVAR(pG->U,k,j,i,B1c)));
+        maxB2 = MAX(maxB2,fabs(UVAR(pG->U,k,j,i,B2c)));
+        maxB3 = MAX(maxB3,fabs(UVAR(pG->U,k,j,i,B3c)));
       }
     }
   }
@@ -63,26 +63,26 @@ void problem(DomainS *pDomain)
       for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
           cc_pos(pGrid,i,j,k,&x1,&x2,&x3);
-          pGrid->U[k][j][i].d = 1.0;
-          pGrid->U[k][j][i].M1 = vflow + amp*(ran2(&iseed) - 0.5);
-          pGrid->U[k][j][i].M2 = amp*(ran2(&iseed) - 0.5);
-          pGrid->U[k][j][i].M3 = 0.0;
+          UVAR(pGrid->U,k,j,i,d) = 1.0;
+          UVAR(pGrid->U,k,j,i,M1) = vflow + amp*(ran2(&iseed) - 0.5);
+          UVAR(pGrid->U,k,j,i,M2) = amp*(ran2(&iseed) - 0.5);
+          UVAR(pGrid->U,k,j,i,M3) = 0.0;
           if (fabs(x2) < 0.25) {
-  	    pGrid->U[k][j][i].d = drat;
-            pGrid->U[k][j][i].M1 = -drat*(vflow + amp*(ran2(&iseed) - 0.5));
-            pGrid->U[k][j][i].M2 = drat*amp*(ran2(&iseed) - 0.5);
+  	    UVAR(pGrid->U,k,j,i,d) = drat;
+            UVAR(pGrid->U,k,j,i,M1) = -drat*(vflow + amp*(ran2(&iseed) - 0.5));
+            UVAR(pGrid->U,k,j,i,M2) = drat*amp*(ran2(&iseed) - 0.5);
           }
 /* Pressure scaled to give a sound speed of 1 with gamma=1.4 */
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E = 2.5/Gamma_1
-             + 0.5*(SQR(pGrid->U[k][j][i].M1) + SQR(pGrid->U[k][j][i].M2)
-             + SQR(pGrid->U[k][j][i].M3))/pGrid->U[k][j][i].d;
+          UVAR(pGrid->U,k,j,i,E) = 2.5/Gamma_1
+             + 0.5*(SQR(UVAR(pGrid->U,k,j,i,M1)) + SQR(UVAR(pGrid->U,k,j,i,M2))
+             + SQR(UVAR(pGrid->U,k,j,i,M3)))/UVAR(pGrid->U,k,j,i,d);
 #endif /* BAROTROPIC */
 #ifdef MHD
           pGrid->B1i[k][j][i] = b0;
-          pGrid->U[k][j][i].B1c = b0;
+          UVAR(pGrid->U,k,j,i,B1c) = b0;
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E += 0.5*b0*b0;
+          UVAR(pGrid->U,k,j,i,E) += 0.5*b0*b0;
 #endif /* BAROTROPIC */
 #endif /* MHD */
         }
@@ -104,26 +104,26 @@ void problem(DomainS *pDomain)
       for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
           cc_pos(pGrid,i,j,k,&x1,&x2,&x3);
-          pGrid->U[k][j][i].d = 1.0;
-          pGrid->U[k][j][i].M1 = vflow*tanh(x2/a);
-          pGrid->U[k][j][i].M2 = amp*sin(2.0*PI*x1)*exp(-(x2*x2)/(sigma*sigma));
-          pGrid->U[k][j][i].M3 = 0.0;
+          UVAR(pGrid->U,k,j,i,d) = 1.0;
+          UVAR(pGrid->U,k,j,i,M1) = vflow*tanh(x2/a);
+          UVAR(pGrid->U,k,j,i,M2) = amp*sin(2.0*PI*x1)*exp(-(x2*x2)/(sigma*sigma));
+          UVAR(pGrid->U,k,j,i,M3) = 0.0;
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E = 1.0/Gamma_1
-             + 0.5*(SQR(pGrid->U[k][j][i].M1) + SQR(pGrid->U[k][j][i].M2)
-             + SQR(pGrid->U[k][j][i].M3))/pGrid->U[k][j][i].d;
+          UVAR(pGrid->U,k,j,i,E) = 1.0/Gamma_1
+             + 0.5*(SQR(UVAR(pGrid->U,k,j,i,M1)) + SQR(UVAR(pGrid->U,k,j,i,M2))
+             + SQR(UVAR(pGrid->U,k,j,i,M3)))/UVAR(pGrid->U,k,j,i,d);
 #endif /* BAROTROPIC */
 #ifdef MHD
           pGrid->B1i[k][j][i] = b0;
-          pGrid->U[k][j][i].B1c = b0;
+          UVAR(pGrid->U,k,j,i,B1c) = b0;
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E += 0.5*b0*b0;
+          UVAR(pGrid->U,k,j,i,E) += 0.5*b0*b0;
 #endif /* BAROTROPIC */
 #endif /* MHD */
 /* Use passive scalar to keep track of the fluids, since densities are same */
 #if (NSCALARS > 0)
-          pGrid->U[k][j][i].s[0] = 0.0;
-          if (x2 > 0) pGrid->U[k][j][i].s[0] = 1.0;
+          UVAR(pGrid->U,k,j,i,s[0]) = 0.0;
+          if (x2 > 0) UVAR(pGrid->U,k,j,i,s[0]) = 1.0;
 #endif
         }
 #ifdef MHD
@@ -143,24 +143,24 @@ void problem(DomainS *pDomain)
       for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
           cc_pos(pGrid,i,j,k,&x1,&x2,&x3);
-          pGrid->U[k][j][i].d = 0.505 + 0.495*tanh((fabs(x2)-0.5)/a);
-          pGrid->U[k][j][i].M1 = vflow*tanh((fabs(x2)-0.5)/a);
-          pGrid->U[k][j][i].M2 = amp*vflow*sin(2.0*PI*x1)
+          UVAR(pGrid->U,k,j,i,d) = 0.505 + 0.495*tanh((fabs(x2)-0.5)/a);
+          UVAR(pGrid->U,k,j,i,M1) = vflow*tanh((fabs(x2)-0.5)/a);
+          UVAR(pGrid->U,k,j,i,M2) = amp*vflow*sin(2.0*PI*x1)
                *exp(-((fabs(x2)-0.5)*(fabs(x2)-0.5))/(sigma*sigma));
-          if (x2 < 0.0) pGrid->U[k][j][i].M2 *= -1.0;
-          pGrid->U[k][j][i].M1 *= pGrid->U[k][j][i].d;
-          pGrid->U[k][j][i].M2 *= pGrid->U[k][j][i].d;
-          pGrid->U[k][j][i].M3 = 0.0;
+          if (x2 < 0.0) UVAR(pGrid->U,k,j,i,M2) *= -1.0;
+          UVAR(pGrid->U,k,j,i,M1) *= UVAR(pGrid->U,k,j,i,d);
+          UVAR(pGrid->U,k,j,i,M2) *= UVAR(pGrid->U,k,j,i,d);
+          UVAR(pGrid->U,k,j,i,M3) = 0.0;
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E = 1.0/Gamma_1
-             + 0.5*(SQR(pGrid->U[k][j][i].M1) + SQR(pGrid->U[k][j][i].M2)
-             + SQR(pGrid->U[k][j][i].M3))/pGrid->U[k][j][i].d;
+          UVAR(pGrid->U,k,j,i,E) = 1.0/Gamma_1
+             + 0.5*(SQR(UVAR(pGrid->U,k,j,i,M1)) + SQR(UVAR(pGrid->U,k,j,i,M2))
+             + SQR(UVAR(pGrid->U,k,j,i,M3)))/UVAR(pGrid->U,k,j,i,d);
 #endif /* BAROTROPIC */
 #ifdef MHD
           pGrid->B1i[k][j][i] = b0;
-          pGrid->U[k][j][i].B1c = b0;
+          UVAR(pGrid->U,k,j,i,B1c) = b0;
 #ifndef BAROTROPIC
-          pGrid->U[k][j][i].E += 0.5*b0*b0;
+          UVAR(pGrid->U,k,j,i,E) += 0.5*b0*b0;
 #endif /* BAROTROPIC */
 #endif /* MHD */
         }
@@ -231,7 +231,7 @@ void problem_read_restart(MeshS *pM, FILE *fp)
  *  \brief Returns first passively advected scalar s[0] */
 static Real color(const GridS *pG, const int i, const int j, const int k)
 {
-  return pG->U[k][j][i].s[0]/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,s[0])/UVAR(pG->U,k,j,i,d);
 }
 #endif
 
@@ -346,20 +346,20 @@ double ran2(long int *idum){
  *  \brief x-component of B-field */
 static Real hst_Bx(const GridS *pG, const int i, const int j, const int k)
 {
-  return pG->U[k][j][i].B1c;
+  return UVAR(pG->U,k,j,i,B1c);
 }
 
 /*! \fn static Real hst_By(const GridS *pG, const int i,const int j,const int k)
  *  \brief y-component of B-field */
 static Real hst_By(const GridS *pG, const int i, const int j, const int k)
 {
-  return pG->U[k][j][i].B2c;
+  return UVAR(pG->U,k,j,i,B2c);
 }
 
 /*! \fn static Real hst_Bz(const GridS *pG, const int i,const int j,const int k)
  *  \brief z-component of B-field */
 static Real hst_Bz(const GridS *pG, const int i, const int j, const int k)
 {
-  return pG->U[k][j][i].B3c;
+  return UVAR(pG->U,k,j,i,B3c);
 }
 #endif
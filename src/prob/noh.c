@@ -62,15 +62,15 @@ void problem(DomainS *pD)
         } else {
           r = sqrt(x1*x1 + x2*x2);
         }
-	pGrid->U[k][j][i].d = 1.0;
-	pGrid->U[k][j][i].M1 = -x1/r;
-	pGrid->U[k][j][i].M2 = -x2/r;
+	UVAR(pGrid->U,k,j,i,d) = 1.0;
+	UVAR(pGrid->U,k,j,i,M1) = -x1/r;
+	UVAR(pGrid->U,k,j,i,M2) = -x2/r;
 	if (pGrid->Nx[2] > 1) {
-	  pGrid->U[k][j][i].M3 = -x3/r;
+	  UVAR(pGrid->U,k,j,i,M3) = -x3/r;
         } else {
-	  pGrid->U[k][j][i].M3 = 0.0;
+	  UVAR(pGrid->U,k,j,i,M3) = 0.0;
         }
-	pGrid->U[k][j][i].E = 1.0e-6/Gamma_1 + 0.5;
+	UVAR(pGrid->U,k,j,i,E) = 1.0e-6/Gamma_1 + 0.5;
       }
     }
   }
@@ -158,15 +158,15 @@ void noh3d_oib(GridS *pGrid)
         }
 	d0 = 1.0*f_t;
    
-	pGrid->U[k][j][i].d  = d0;
-	pGrid->U[k][j][i].M1 = -x1*d0/r;
-	pGrid->U[k][j][i].M2 = -x2*d0/r;
+	UVAR(pGrid->U,k,j,i,d)  = d0;
+	UVAR(pGrid->U,k,j,i,M1) = -x1*d0/r;
+	UVAR(pGrid->U,k,j,i,M2) = -x2*d0/r;
         if (pGrid->Nx[2] > 1) {
-	  pGrid->U[k][j][i].M3 = -x3*d0/r;
-          pGrid->U[k][j][i].E = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
+	  UVAR(pGrid->U,k,j,i,M3) = -x3*d0/r;
+          UVAR(pGrid->U,k,j,i,E) = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
         } else {
-	  pGrid->U[k][j][i].M3 = 0.0;
-          pGrid->U[k][j][i].E = 1.0e-6/Gamma_1 + 0.5*d0;
+	  UVAR(pGrid->U,k,j,i,M3) = 0.0;
+          UVAR(pGrid->U,k,j,i,E) = 1.0e-6/Gamma_1 + 0.5*d0;
         }
       }
     }
@@ -209,15 +209,15 @@ void noh3d_ojb(GridS *pGrid)
         }
 	d0 = 1.0*f_t;
 
-	pGrid->U[k][j][i].d  = d0;
-	pGrid->U[k][j][i].M1 = -x1*d0/r;
-	pGrid->U[k][j][i].M2 = -x2*d0/r;
+	UVAR(pGrid->U,k,j,i,d)  = d0;
+	UVAR(pGrid->U,k,j,i,M1) = -x1*d0/r;
+	UVAR(pGrid->U,k,j,i,M2) = -x2*d0/r;
         if (pGrid->Nx[2] > 1) {
-	  pGrid->U[k][j][i].M3 = -x3*d0/r;
-          pGrid->U[k][j][i].E = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
+	  UVAR(pGrid->U,k,j,i,M3) = -x3*d0/r;
+          UVAR(pGrid->U,k,j,i,E) = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
         } else {
-	  pGrid->U[k][j][i].M3 = 0.0;
-          pGrid->U[k][j][i].E = 1.0e-6/Gamma_1 + 0.5*d0;
+	  UVAR(pGrid->U,k,j,i,M3) = 0.0;
+          UVAR(pGrid->U,k,j,i,E) = 1.0e-6/Gamma_1 + 0.5*d0;
         }
       }
     }
@@ -247,11 +247,11 @@ void noh3d_okb(GridS *pGrid)
 	f_t = (1.0 + pGrid->time/r)*(1.0 + pGrid->time/r);
 	d0 = 1.0*f_t;
 
-	pGrid->U[k][j][i].d  = d0;
-	pGrid->U[k][j][i].M1 = -x1*d0/r;
-	pGrid->U[k][j][i].M2 = -x2*d0/r;
-	pGrid->U[k][j][i].M3 = -x3*d0/r;
-	pGrid->U[k][j][i].E = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
+	UVAR(pGrid->U,k,j,i,d)  = d0;
+	UVAR(pGrid->U,k,j,i,M1) = -x1*d0/r;
+	UVAR(pGrid->U,k,j,i,M2) = -x2*d0/r;
+	UVAR(pGrid->U,k,j,i,M3) = -x3*d0/r;
+	UVAR(pGrid->U,k,j,i,E) = 1.0e-6*pow(f_t,1.0+Gamma)/Gamma_1 + 0.5*d0;
       }
     }
   }
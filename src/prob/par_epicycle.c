@@ -113,12 +113,12 @@ void problem(DomainS *pDomain)
   for (j=pGrid->js; j<=pGrid->je; j++) {
   for (i=pGrid->is; i<=pGrid->ie; i++) {
     cc_pos(pGrid,i,j,k,&x1,&x2,&x3);
-    pGrid->U[k][j][i].d = 1.0;
-    pGrid->U[k][j][i].M1 = 0.0;
-    pGrid->U[k][j][i].M2 = 0.0;
-    pGrid->U[k][j][i].M3 = 0.0;
+    UVAR(pGrid->U,k,j,i,d) = 1.0;
+    UVAR(pGrid->U,k,j,i,M1) = 0.0;
+    UVAR(pGrid->U,k,j,i,M2) = 0.0;
+    UVAR(pGrid->U,k,j,i,M3) = 0.0;
 #ifndef FARGO
-      pGrid->U[k][j][i].M2 -= qshear*Omega_0*x1;
+      UVAR(pGrid->U,k,j,i,M2) -= qshear*Omega_0*x1;
 #endif
   }}}
 
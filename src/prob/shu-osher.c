@@ -57,18 +57,18 @@ void problem(DomainS *pDomain)
     cc_pos(pGrid,i,js,ks,&x1,&x2,&x3);
 
     if (x1 < -0.8) {
-      pGrid->U[ks][js][i].d = dl;
-      pGrid->U[ks][js][i].M1 = ul*dl;
-      pGrid->U[ks][js][i].M2 = vl*dl;
-      pGrid->U[ks][js][i].M3 = wl*dl;
-      pGrid->U[ks][js][i].E = pl/Gamma_1 + 0.5*dl*(ul*ul + vl*vl + wl*wl);
+      UVAR(pGrid->U,ks,js,i,d) = dl;
+      UVAR(pGrid->U,ks,js,i,M1) = ul*dl;
+      UVAR(pGrid->U,ks,js,i,M2) = vl*dl;
+      UVAR(pGrid->U,ks,js,i,M3) = wl*dl;
+      UVAR(pGrid->U,ks,js,i,E) = pl/Gamma_1 + 0.5*dl*(ul*ul + vl*vl + wl*wl);
     }
     else {
-      pGrid->U[ks][js][i].d = 1.0 + 0.2*sin(5.0*PI*x1);
-      pGrid->U[ks][js][i].M1 = 0.0;
-      pGrid->U[ks][js][i].M2 = 0.0;
-      pGrid->U[ks][js][i].M3 = 0.0;
-      pGrid->U[ks][js][i].E = 1.0/Gamma_1;
+      UVAR(pGrid->U,ks,js,i,d) = 1.0 + 0.2*sin(5.0*PI*x1);
+      UVAR(pGrid->U,ks,js,i,M1) = 0.0;
+      UVAR(pGrid->U,ks,js,i,M2) = 0.0;
+      UVAR(pGrid->U,ks,js,i,M3) = 0.0;
+      UVAR(pGrid->U,ks,js,i,E) = 1.0/Gamma_1;
     }
   }
 
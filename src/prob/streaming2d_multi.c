@@ -188,19 +188,19 @@ void problem(DomainS *pDomain)
   for (i=pGrid->is; i<=pGrid->ie; i++) {
     cc_pos(pGrid,i,j,pGrid->ks,&x1,&x2,&x3);
 
-    pGrid->U[pGrid->ks][j][i].d = rho0;
+    UVAR(pGrid->U,pGrid->ks,j,i,d) = rho0;
 
     if (ipert != 3) {
-      pGrid->U[pGrid->ks][j][i].M1 = rho0 * uxNSH;
-      pGrid->U[pGrid->ks][j][i].M3 = rho0 * uyNSH;
+      UVAR(pGrid->U,pGrid->ks,j,i,M1) = rho0 * uxNSH;
+      UVAR(pGrid->U,pGrid->ks,j,i,M3) = rho0 * uyNSH;
     } else {
-      pGrid->U[pGrid->ks][j][i].M1 = 0.0;
-      pGrid->U[pGrid->ks][j][i].M3 = 0.0;
+      UVAR(pGrid->U,pGrid->ks,j,i,M1) = 0.0;
+      UVAR(pGrid->U,pGrid->ks,j,i,M3) = 0.0;
     }
 
-    pGrid->U[pGrid->ks][j][i].M2 = 0.0;
+    UVAR(pGrid->U,pGrid->ks,j,i,M2) = 0.0;
 #ifndef FARGO
-    pGrid->U[pGrid->ks][j][i].M3 -= qshear*rho0*Omega_0*x1;
+    UVAR(pGrid->U,pGrid->ks,j,i,M3) -= qshear*rho0*Omega_0*x1;
 #endif
 
   }}
@@ -372,9 +372,9 @@ static Real hst_rho_Vx_dVy(const GridS *pG,
   Real x1,x2,x3;
   cc_pos(pG,i,j,k,&x1,&x2,&x3);
 #ifdef FARGO
-  return pG->U[k][j][i].M1*pG->U[k][j][i].M3/pG->U[k][j][i].d;
+  return UVAR(pG->U,k,j,i,M1)*UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d);
 #else
-  return pG->U[k][j][i].M1*(pG->U[k][j][i].M3/pG->U[k][j][i].d
+  return UVAR(pG->U,k,j,i,M1)*(UVAR(pG->U,k,j,i,M3)/UVAR(pG->U,k,j,i,d)
                             + qshear*Omega_0*x1);
 #endif
 }
@@ -60,6 +60,34 @@ char *ath_fname(const char *path, const char *basename,
 void ath_sig_init(void);
 int  ath_sig_act(int *piquit);
 
+/*----------------------------------------------------------------------------*/
+/* ath_perf.c */
+#ifdef PERF_COUNTERS
+void ath_perf_init(void);
+void ath_perf_start(const enum PerfKernel k);
+void ath_perf_stop(const enum PerfKernel k);
+void ath_perf_report(void);
+#define PERF_START(k) ath_perf_start(k)
+#define PERF_STOP(k) ath_perf_stop(k)
+#else
+#define PERF_START(k)
+#define PERF_STOP(k)
+#endif /* PERF_COUNTERS */
+
+/*----------------------------------------------------------------------------*/
+/* ath_timer.c */
+void ath_timer_init(const int nrep, const int nstep);
+void ath_timer_start(const enum TimerPhase n);
+void ath_timer_stop(const enum TimerPhase n);
+void ath_timer_report(const int nstep, const int final);
+
+/*----------------------------------------------------------------------------*/
+/* ath_trace.c */
+void ath_trace_init(const int on, const char *basename);
+void ath_trace_begin(const char *name);
+void ath_trace_end(const char *name);
+void ath_trace_close(void);
+
 /*----------------------------------------------------------------------------*/
 /* baton.c */
 void baton_start(const int Nb, const int tag);
@@ -70,6 +98,14 @@ void baton_stop(const int Nb, const int tag);
 void bvals_mhd_init(MeshS *pM);
 void bvals_mhd_fun(DomainS *pD, enum BCDirection dir, VGFun_t prob_bc);
 void bvals_mhd(DomainS *pDomain);
+void bvals_mhd_start(DomainS *pDomain);
+void bvals_mhd_finish(DomainS *pDomain);
+void bvals_mhd_destruct(void);
+#ifdef MPI_PARALLEL
+void halo_msg_type(const int cnt, int *count, MPI_Datatype *type);
+void halo_compress(GReal *buf, const int cnt);
+void halo_expand(GReal *buf, const int cnt);
+#endif
 
 /*----------------------------------------------------------------------------*/
 /* bvals_shear.c  */
@@ -129,6 +165,13 @@ Real x3cc(const GridS *pG, const int k);
 /* convert_var.c */
 PrimS Cons_to_Prim(const ConsS *pU);
 ConsS Prim_to_Cons(const PrimS *pW);
+#ifdef PRIM_CACHE
+void Cons_to_Prim_Grid(GridS *pG, int il, int iu, int jl, int ju,
+                       int kl, int ku);
+void Cons_to_Prim_Stage(GridS *pG);
+void Cons_to_Prim_Array(ConsS ***U, PrimS ***W, int il, int iu,
+                        int jl, int ju, int kl, int ku);
+#endif
 Prim1DS Cons1D_to_Prim1D(const Cons1DS *pU, const Real *pBx);
 Cons1DS Prim1D_to_Cons1D(const Prim1DS *pW, const Real *pBx);
 #ifndef SPECIAL_RELATIVITY
@@ -162,6 +205,7 @@ void new_dt(MeshS *pM);
 /* output.c - and related files */
 void init_output(MeshS *pM);
 void data_output(MeshS *pM, const int flag);
+int data_output_due(const MeshS *pM);
 void add_rst_out(OutputS *new_out);
 void data_output_destruct(void);
 void dump_history_enroll(const ConsFun_t pfun, const char *label);
@@ -274,6 +318,11 @@ void ath_error(char *fmt, ...);
 void minmax1(Real   *data, int nx1,                   Real *dmin, Real *dmax);
 void minmax2(Real  **data, int nx2, int nx1,          Real *dmin, Real *dmax);
 void minmax3(Real ***data, int nx3, int nx2, int nx1, Real *dmin, Real *dmax);
+#ifdef CONS_SOA
+ConsS cons_gather(const ConsArrS *pU, const int k, const int j, const int i);
+void cons_scatter(ConsArrS *pU, const int k, const int j, const int i,
+                  const ConsS U);
+#endif
 void do_nothing_bc(GridS *pG);
 Real compute_div_b(GridS *pG);
 int sign_change(Real (*func)(const Real,const Real), const Real a0, const Real b0, const Real x, Real *a, Real *b);
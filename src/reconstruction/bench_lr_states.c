@@ -0,0 +1,513 @@
+#include "../copyright.h"
+#define MAIN_C
+/*============================================================================*/
+/*! \file bench_lr_states.c
+ *  \brief Stand-alone benchmark and validation of the reconstruction kernels.
+ *
+ * PURPOSE: Stand-alone benchmark and validation of the reconstruction
+ *   kernels.  Built and run by "make bench-lr-states", which compiles every
+ *   lr_states_*.c file in this directory that supports the configured
+ *   physics and integrator, once for each order of reconstruction, with
+ *   lr_states(), lr_states_init() and lr_states_destruct() renamed to
+ *   lr_states_<name>() etc., and defines BENCH_<NAME> for each one built.
+ *
+ *   For each kernel the time per cell of lr_states() is printed for pencil
+ *   lengths from 8 (typical of small SMR grids) to 4096, with the pencil kept
+ *   in cache as in the integrators.  The kernels are then checked with:
+ *   - uniform:  a uniform state must be reconstructed exactly
+ *   - locality: L/R states computed on short pencils at several offsets
+ *               must equal those computed on the full pencil, which catches
+ *               errors in the remainder loops of vectorized kernels
+ *   - finite:   all L/R states on a pencil with smooth regions, noise and
+ *               strong jumps must be finite
+ *   and a checksum of the L/R states is printed.  With -w <file> the L/R
+ *   states of every kernel are written to a file, and with -c <file> they
+ *   are compared with those in the file, so that a modified (e.g.
+ *   vectorized) kernel can be validated against the scalar reference built
+ *   from the same configuration.
+ *
+ *   The run fails (exit status 1) if any check fails.
+ *
+ *   Usage: bench_lr_states [-n ncell] [-w file | -c file]
+ *   where ncell is the number of cells reconstructed per timing (default
+ *   2^20).
+ *
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - ran()          - uniform random number in [0,1)
+ * - make_pencil()  - fills pencil with test data
+ * - max_diff()     - max relative difference between L/R states
+ * - wtime()        - wall time in seconds
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - ath_perr()  - discards warnings, since ath_log.c is not linked
+ * - ath_error() - prints error and exits, since utils.c is not linked
+ * - main()                                                                   */
+/*============================================================================*/
+
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "../defs.h"
+#include "../athena.h"
+#include "../globals.h"
+#include "prototypes.h"
+#include "../prototypes.h"
+
+/*! \fn void (*LRStatesFun_t)(const GridS *pG, const Prim1DS W[],
+ *                            const Real Bxc[], const Real dt, const Real dx,
+ *                            const int il, const int iu, Prim1DS Wl[],
+ *                            Prim1DS Wr[], const int dir)
+ *  \brief Reconstruction kernel */
+typedef void (*LRStatesFun_t)(const GridS *pG, const Prim1DS W[],
+                              const Real Bxc[], const Real dt, const Real dx,
+                              const int il, const int iu, Prim1DS Wl[],
+                              Prim1DS Wr[], const int dir);
+
+#define BENCH_DECLARE(name) \
+void lr_states_##name(const GridS *pG, const Prim1DS W[], const Real Bxc[], \
+                      const Real dt, const Real dx, const int il, \
+                      const int iu, Prim1DS Wl[], Prim1DS Wr[], \
+                      const int dir); \
+void lr_states_init_##name(MeshS *pM); \
+void lr_states_destruct_##name(void);
+
+#define BENCH_ENTRY(name) \
+  {#name, lr_states_##name, lr_states_init_##name, lr_states_destruct_##name},
+
+#ifdef BENCH_DC
+BENCH_DECLARE(dc)
+#endif
+#ifdef BENCH_PLM
+BENCH_DECLARE(plm)
+#endif
+#ifdef BENCH_PRIM2
+BENCH_DECLARE(prim2)
+#endif
+#ifdef BENCH_PPM
+BENCH_DECLARE(ppm)
+#endif
+#ifdef BENCH_PRIM3
+BENCH_DECLARE(prim3)
+#endif
+#ifdef BENCH_P3C_KOREN
+BENCH_DECLARE(p3c_koren)
+#endif
+#ifdef BENCH_P3C_LIMO3
+BENCH_DECLARE(p3c_limo3)
+#endif
+
+/*! \struct BenchKernelS
+ *  \brief Name and entry points of one kernel */
+typedef struct BenchKernel_s{
+  const char *name;
+  LRStatesFun_t lr_states;
+  void (*init)(MeshS *pM);
+  void (*destruct)(void);
+}BenchKernelS;
+
+static BenchKernelS kernel[] = {
+#ifdef BENCH_DC
+  BENCH_ENTRY(dc)
+#endif
+#ifdef BENCH_PLM
+  BENCH_ENTRY(plm)
+#endif
+#ifdef BENCH_PRIM2
+  BENCH_ENTRY(prim2)
+#endif
+#ifdef BENCH_PPM
+  BENCH_ENTRY(ppm)
+#endif
+#ifdef BENCH_PRIM3
+  BENCH_ENTRY(prim3)
+#endif
+#ifdef BENCH_P3C_KOREN
+  BENCH_ENTRY(p3c_koren)
+#endif
+#ifdef BENCH_P3C_LIMO3
+  BENCH_ENTRY(p3c_limo3)
+#endif
+  {NULL, NULL, NULL, NULL}
+};
+
+/* pencil lengths that are timed; the last is the full pencil */
+#define NLEN 10
+static const int pencil_len[NLEN] = {8,16,32,64,128,256,512,1024,2048,4096};
+#define NMAX 4096
+
+/* number of Reals in Prim1DS */
+#define NPRIM ((int)(sizeof(Prim1DS)/sizeof(Real)))
+
+/* tolerances on relative differences */
+#ifdef SINGLE_PREC
+#define TOL_EXACT 1.0e-5
+#else
+#define TOL_EXACT 1.0e-12
+#endif
+
+/* maximum velocity, which must be < 1 with special relativity */
+#ifdef SPECIAL_RELATIVITY
+#define VMAX 0.5
+#else
+#define VMAX 1.0
+#endif
+
+static unsigned long ran_state = 1;
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ *============================================================================*/
+
+static double ran(void);
+static void make_pencil(const int uniform, Prim1DS *W, Real *Bxc);
+static double max_diff(const Prim1DS *Wa, const Prim1DS *Wb, const int il,
+                       const int iu);
+static double wtime(void);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn int ath_perr(const int level, const char *fmt, ...)
+ *  \brief Discards warnings from the kernels, which would otherwise dominate
+ *   the output and timings. */
+int ath_perr(const int level, const char *fmt, ...)
+{
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_error(char *fmt, ...)
+ *  \brief Prints error message and exits. */
+void ath_error(char *fmt, ...)
+{
+  va_list ap;
+
+  fprintf(stderr,"### Fatal error: ");
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+
+  exit(EXIT_FAILURE);
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn int main(int argc, char *argv[])
+ *  \brief Times and checks all kernels, and returns 1 if any check fails. */
+int main(int argc, char *argv[])
+{
+  int ncell=1<<20, nkernel, k, l, n, r, nrep, il, iu, i0, nfail=0, nbad, i;
+  int dpl=1, ok;
+  char *wfile=NULL, *cfile=NULL, name[32];
+  FILE *fp=NULL;
+  MeshS Mesh;
+  DomainS Dom, *pDom;
+  GridS Grid;
+  Prim1DS *W=NULL, *Wl=NULL, *Wr=NULL, *Wl0=NULL, *Wr0=NULL;
+  Real *Bxc=NULL, *pw, dt, dx=1.0;
+  double t, tcell[NLEN], dunif, dloc, dref, sum;
+
+  for (i=1; i<argc; i++) {
+    if (argv[i][0] == '-' && i+1 < argc) {
+      switch (argv[i][1]) {
+      case 'n': ncell = atoi(argv[++i]); break;
+      case 'w': wfile = argv[++i]; break;
+      case 'c': cfile = argv[++i]; break;
+      default:  ncell = 0; break;
+      }
+    } else {
+      ncell = 0;
+    }
+  }
+  if (ncell < 1 || (wfile != NULL && cfile != NULL))
+    ath_error("usage: %s [-n ncell] [-w file | -c file]\n",argv[0]);
+
+#ifdef ISOTHERMAL
+  Iso_csound = 1.0;
+  Iso_csound2 = 1.0;
+#else
+  Gamma = 5.0/3.0;
+  Gamma_1 = Gamma - 1.0;
+  Gamma_2 = Gamma - 2.0;
+#endif
+
+/* time step at a Courant number of 0.4, used in characteristic tracing */
+  dt = 0.4*dx/(VMAX + 3.0);
+
+  for (nkernel=0; kernel[nkernel].name != NULL; nkernel++);
+  if (nkernel == 0) ath_error("[bench_lr_states]: no kernels were built\n");
+
+/* One Grid with NMAX cells in each direction, which sets the size of the
+ * arrays allocated in lr_states_init() */
+
+  memset(&Grid, 0, sizeof(GridS));
+  memset(&Dom, 0, sizeof(DomainS));
+  memset(&Mesh, 0, sizeof(MeshS));
+  Grid.Nx[0] = Grid.Nx[1] = Grid.Nx[2] = NMAX;
+  Grid.dx1 = Grid.dx2 = Grid.dx3 = dx;
+  Dom.Grid = &Grid;
+  pDom = &Dom;
+  Mesh.NLevels = 1;
+  Mesh.DomainsPerLevel = &dpl;
+  Mesh.Domain = &pDom;
+
+  n = NMAX + 2*nghost;
+  if ((W = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Wl = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Wr = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Wl0 = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Wr0 = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Bxc = (Real*)calloc(n,sizeof(Real))) == NULL) goto on_error;
+#ifdef CYLINDRICAL
+  if ((Grid.r = (Real*)calloc(n,sizeof(Real))) == NULL) goto on_error;
+  if ((Grid.ri = (Real*)calloc(n,sizeof(Real))) == NULL) goto on_error;
+  for (i=0; i<n; i++) {
+    Grid.ri[i] = 10.0 + ((Real)(i - nghost))*dx;
+    Grid.r[i] = Grid.ri[i] + 0.5*dx;
+  }
+#endif
+
+  if (wfile != NULL && (fp = fopen(wfile,"wb")) == NULL)
+    ath_error("[bench_lr_states]: cannot open %s\n",wfile);
+  if (cfile != NULL && (fp = fopen(cfile,"rb")) == NULL)
+    ath_error("[bench_lr_states]: cannot open %s\n",cfile);
+
+  printf("Reconstruction benchmark: ns per cell for pencil lengths %d-%d\n\n",
+         pencil_len[0],pencil_len[NLEN-1]);
+  printf("%-10s","kernel");
+  for (l=0; l<NLEN; l++) printf(" %6d",pencil_len[l]);
+  printf("  %9s %9s %5s %22s\n","uniform","locality","bad","checksum");
+
+  for (k=0; k<nkernel; k++) {
+    (*kernel[k].init)(&Mesh);
+
+/* time on each pencil length, with pencil in cache */
+
+    ran_state = 1;
+    make_pencil(0, W, Bxc);
+    for (l=0; l<NLEN; l++) {
+      il = nghost;
+      iu = il + pencil_len[l] - 1;
+      nrep = MAX(ncell/pencil_len[l], 1);
+      (*kernel[k].lr_states)(&Grid,W,Bxc,dt,dx,il,iu,Wl,Wr,0);
+      t = wtime();
+      for (r=0; r<nrep; r++)
+        (*kernel[k].lr_states)(&Grid,W,Bxc,dt,dx,il,iu,Wl,Wr,0);
+      tcell[l] = 1.0e9*(wtime() - t)/((double)nrep*(double)pencil_len[l]);
+    }
+
+/* reference on full pencil; count non-finite states, and form checksum */
+
+    il = nghost;
+    iu = il + NMAX - 1;
+    (*kernel[k].lr_states)(&Grid,W,Bxc,dt,dx,il,iu,Wl0,Wr0,0);
+    nbad = 0;
+    sum = 0.0;
+    for (i=il; i<=iu+1; i++) {
+      for (n=0; n<NPRIM; n++) {
+        pw = (Real*)&(Wl0[i]);
+        if (!(fabs(pw[n]) <= DBL_MAX)) nbad++;
+        else sum += (double)(1 + (i+n)%7)*pw[n];
+        pw = (Real*)&(Wr0[i]);
+        if (!(fabs(pw[n]) <= DBL_MAX)) nbad++;
+        else sum += (double)(1 + (i+n)%5)*pw[n];
+      }
+    }
+
+/* locality: short pencils at several offsets must match full pencil */
+
+    dloc = 0.0;
+    for (l=0; l<NLEN-1; l++) {
+      for (i0=nghost; i0+pencil_len[l]<=nghost+NMAX; i0+=3*pencil_len[l]+1) {
+        (*kernel[k].lr_states)(&Grid,W,Bxc,dt,dx,i0,i0+pencil_len[l]-1,
+                               Wl,Wr,0);
+        dloc = MAX(dloc, max_diff(Wl,Wl0,i0,i0+pencil_len[l]));
+        dloc = MAX(dloc, max_diff(Wr,Wr0,i0,i0+pencil_len[l]));
+      }
+    }
+
+/* uniform state must be reconstructed exactly */
+
+    make_pencil(1, W, Bxc);
+    (*kernel[k].lr_states)(&Grid,W,Bxc,dt,dx,il,iu,Wl,Wr,0);
+    dunif = MAX(max_diff(Wl,W,il,iu+1), max_diff(Wr,W,il,iu+1));
+
+    printf("%-10s",kernel[k].name);
+    for (l=0; l<NLEN; l++) printf(" %6.1f",tcell[l]);
+    printf("  %9.2e %9.2e %5d %22.15e\n",dunif,dloc,nbad,sum);
+
+    if (dunif > TOL_EXACT) {
+      printf("  FAIL: %s does not preserve uniform state (%e)\n",
+             kernel[k].name,dunif);
+      nfail++;
+    }
+    if (dloc > TOL_EXACT) {
+      printf("  FAIL: %s depends on pencil length/offset (%e)\n",
+             kernel[k].name,dloc);
+      nfail++;
+    }
+    if (nbad > 0) {
+      printf("  FAIL: %s gives %d non-finite states\n",kernel[k].name,nbad);
+      nfail++;
+    }
+
+/* write L/R states on full pencil, or compare with those in file */
+
+    n = NMAX + 1;
+    if (wfile != NULL) {
+      memset(name, 0, sizeof(name));
+      strncpy(name, kernel[k].name, sizeof(name)-1);
+      ok = (fwrite(name,sizeof(char),sizeof(name),fp) == sizeof(name));
+      ok = ok && (fwrite(&Wl0[il],sizeof(Prim1DS),n,fp) == (size_t)n);
+      ok = ok && (fwrite(&Wr0[il],sizeof(Prim1DS),n,fp) == (size_t)n);
+      if (!ok) ath_error("[bench_lr_states]: error writing %s\n",wfile);
+    }
+    if (cfile != NULL) {
+      rewind(fp);
+      ok = 0;
+      while (fread(name,sizeof(char),sizeof(name),fp) == sizeof(name)) {
+        if (strcmp(name, kernel[k].name) == 0) {
+          ok = (fread(&Wl[il],sizeof(Prim1DS),n,fp) == (size_t)n);
+          ok = ok && (fread(&Wr[il],sizeof(Prim1DS),n,fp) == (size_t)n);
+          break;
+        }
+        fseek(fp, 2*n*sizeof(Prim1DS), SEEK_CUR);
+      }
+      if (!ok) {
+        printf("  FAIL: %s not found in %s\n",kernel[k].name,cfile);
+        nfail++;
+      } else {
+        dref = MAX(max_diff(Wl,Wl0,il,iu+1), max_diff(Wr,Wr0,il,iu+1));
+        printf("  %s differs from %s by %e\n",kernel[k].name,cfile,dref);
+        if (dref > TOL_EXACT) {
+          printf("  FAIL: %s does not match reference\n",kernel[k].name);
+          nfail++;
+        }
+      }
+    }
+
+    (*kernel[k].destruct)();
+  }
+
+  if (fp != NULL) fclose(fp);
+  printf("\n%s\n",nfail ? "bench-lr-states: FAILED" : "bench-lr-states: OK");
+
+  free(W);  free(Wl);  free(Wr);  free(Wl0);  free(Wr0);  free(Bxc);
+#ifdef CYLINDRICAL
+  free(Grid.r);  free(Grid.ri);
+#endif
+  return (nfail ? 1 : 0);
+
+  on_error:
+  ath_error("[bench_lr_states]: malloc returned a NULL pointer\n");
+  return 1;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double ran(void)
+ *  \brief Uniform random number in [0,1) from a 32-bit LCG, so that the
+ *   test data are the same on every machine. */
+static double ran(void)
+{
+  ran_state = (1664525UL*ran_state + 1013904223UL) & 0xffffffffUL;
+  return (double)ran_state/4294967296.0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void make_pencil(const int uniform, Prim1DS *W, Real *Bxc)
+ *  \brief Fills W[] and Bxc[] over the full pencil plus ghost cells.  If
+ *   uniform=0 the pencil has smooth waves in its first quarter, small-scale
+ *   noise in the second, and jumps of up to a factor 100 in density and
+ *   pressure in the rest; otherwise it is a uniform state. */
+static void make_pencil(const int uniform, Prim1DS *W, Real *Bxc)
+{
+  int i, ntot = NMAX + 2*nghost;
+#if (NSCALARS > 0)
+  int n;
+#endif
+  double x, a, d=1.0, p=1.0, vx=0.3*VMAX, vy=-0.2*VMAX, vz=0.1*VMAX;
+  double by=0.5, bz=-0.4;
+
+  for (i=0; i<ntot; i++) {
+    x = (double)i/(double)ntot;
+    if (!uniform) {
+      if (i < ntot/4) {
+        a = sin(16.0*PI*x);
+        d = 1.0 + 0.5*a;           p = 1.0 + 0.3*a;
+        vx = 0.5*VMAX*a;           vy = 0.3*VMAX*cos(16.0*PI*x);
+        vz = 0.2*VMAX*a;
+        by = 0.5 + 0.3*a;          bz = 0.4*cos(16.0*PI*x);
+      } else if (i < ntot/2) {
+        d = 1.0 + 0.1*ran();       p = 1.0 + 0.1*ran();
+        vx = 0.1*VMAX*(2.0*ran() - 1.0);
+        vy = 0.1*VMAX*(2.0*ran() - 1.0);
+        vz = 0.1*VMAX*(2.0*ran() - 1.0);
+        by = 0.5 + 0.1*ran();      bz = 0.1*ran();
+      } else if (i % 16 == 0) {
+        d = exp(log(100.0)*(ran() - 0.5));
+        p = exp(log(100.0)*(ran() - 0.5));
+        vx = 0.5*VMAX*(2.0*ran() - 1.0);
+        vy = 0.3*VMAX*(2.0*ran() - 1.0);
+        vz = 0.3*VMAX*(2.0*ran() - 1.0);
+        by = 2.0*ran() - 1.0;      bz = 2.0*ran() - 1.0;
+      }
+    }
+    W[i].d  = d;
+    W[i].Vx = vx;
+    W[i].Vy = vy;
+    W[i].Vz = vz;
+#ifndef BAROTROPIC
+    W[i].P  = p;
+#endif
+#ifdef MHD
+    W[i].By = by;
+    W[i].Bz = bz;
+#endif
+#if (NSCALARS > 0)
+    for (n=0; n<NSCALARS; n++) W[i].r[n] = uniform ? 0.5 : x;
+#endif
+    Bxc[i] = uniform ? 0.7 : 0.7 + 0.2*sin(4.0*PI*x);
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double max_diff(const Prim1DS *Wa, const Prim1DS *Wb,
+ *                             const int il, const int iu)
+ *  \brief Returns max over [il:iu] of |Wa - Wb|/(|Wb| + 1e-10) over all
+ *   components, or 1 if any component of Wa is not finite. */
+static double max_diff(const Prim1DS *Wa, const Prim1DS *Wb, const int il,
+                       const int iu)
+{
+  int i, n;
+  const Real *pa, *pb;
+  double d, dmax=0.0;
+
+  for (i=il; i<=iu; i++) {
+    pa = (const Real*)&(Wa[i]);
+    pb = (const Real*)&(Wb[i]);
+    for (n=0; n<NPRIM; n++) {
+      if (!(fabs(pa[n]) <= DBL_MAX)) return 1.0;
+      d = fabs(pa[n] - pb[n])/(fabs(pb[n]) + 1.0e-10);
+      if (d > dmax) dmax = d;
+    }
+  }
+
+  return dmax;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double wtime(void)
+ *  \brief Returns wall time in seconds. */
+static double wtime(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv,NULL);
+  return (double)tv.tv_sec + 1.0e-6*(double)tv.tv_usec;
+}
@@ -28,6 +28,7 @@
  * - esys_prim_adb_hyd() - adiabatic hydrodynamics
  * - esys_prim_iso_mhd() - isothermal MHD
  * - esys_prim_adb_mhd() - adiabatic MHD
+ * - esys_prim_*_pencil() - the same for every cell of a 1D pencil
  *============================================================================*/
 
 #include <math.h>
@@ -585,3 +586,452 @@ void esys_prim_adb_mhd(const Real d, const Real v1, const Real rho_a2,
   left_eigenmatrix[6][6] = left_eigenmatrix[0][6];
 }
 #endif
+
+/*============================================================================*/
+/* Pencil versions of the functions above.  They compute the same quantities
+ * with the same operations for every cell il..iu of a 1D pencil, storing
+ * eigenvalues[n][i] and the eigenmatrix elements [n][m] of cell i as
+ * right_eigenmatrix[n*NWAVE+m][i] and left_eigenmatrix[n*NWAVE+m][i], so
+ * that the loops over i vectorize.  Zero elements are again not set.  The
+ * tests for degenerate states are written as selects between values that are
+ * always computed, so values in the unselected branch may be NaN.  The row
+ * pointers are copied into local arrays before the loop, so the compiler can
+ * see that they do not change inside it.
+ */
+
+#define REM(n,m) rem[(n)*NWAVE+(m)][i]
+#define LEM(n,m) lem[(n)*NWAVE+(m)][i]
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void esys_prim_iso_hyd_pencil(const int il, const int iu,
+ *  const Real d[], const Real v1[], Real **eigenvalues,
+ *  Real **right_eigenmatrix, Real **left_eigenmatrix)
+ *  \brief ISOTHERMAL HYDRO, cells il..iu of a pencil
+ */
+
+#if defined(BAROTROPIC) && defined(HYDRO)
+void SIMD_CLONES esys_prim_iso_hyd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix)
+{
+  int i,k;
+  Real *ev[NWAVE], *rem[NWAVE*NWAVE], *lem[NWAVE*NWAVE];
+
+  for (k=0; k<NWAVE; k++) ev[k] = eigenvalues[k];
+  for (k=0; k<NWAVE*NWAVE; k++) {
+    rem[k] = right_eigenmatrix[k];
+    lem[k] = left_eigenmatrix[k];
+  }
+
+SIMD_IVDEP
+  for (i=il; i<=iu; i++) {
+    ev[0][i] = v1[i] - Iso_csound;
+    ev[1][i] = v1[i];
+    ev[2][i] = v1[i];
+    ev[3][i] = v1[i] + Iso_csound;
+
+    REM(0,0) = 1.0;
+    REM(1,0) = -Iso_csound/d[i];
+    REM(2,1) = 1.0;
+    REM(3,2) = 1.0;
+    REM(0,3) = 1.0;
+    REM(1,3) = Iso_csound/d[i];
+
+    LEM(0,0) = 0.5;
+    LEM(0,1) = -0.5*d[i]/Iso_csound;
+    LEM(1,2) = 1.0;
+    LEM(2,3) = 1.0;
+    LEM(3,0) = 0.5;
+    LEM(3,1) = 0.5*d[i]/Iso_csound;
+  }
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void esys_prim_adb_hyd_pencil(const int il, const int iu,
+ *  const Real d[], const Real v1[], const Real p[], Real **eigenvalues,
+ *  Real **right_eigenmatrix, Real **left_eigenmatrix)
+ *  \brief ADIABATIC HYDRO, cells il..iu of a pencil.  Takes the pressure p
+ *   rather than rho_a2=Gamma*p.
+ */
+
+#if !defined(BAROTROPIC) && defined(HYDRO)
+void SIMD_CLONES esys_prim_adb_hyd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real p[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix)
+{
+  int i,k;
+  Real *ev[NWAVE], *rem[NWAVE*NWAVE], *lem[NWAVE*NWAVE];
+  Real asq,a;
+
+  for (k=0; k<NWAVE; k++) ev[k] = eigenvalues[k];
+  for (k=0; k<NWAVE*NWAVE; k++) {
+    rem[k] = right_eigenmatrix[k];
+    lem[k] = left_eigenmatrix[k];
+  }
+
+SIMD_IVDEP
+  for (i=il; i<=iu; i++) {
+    asq = Gamma*p[i]/d[i];
+    a = sqrt(asq);
+
+    ev[0][i] = v1[i] - a;
+    ev[1][i] = v1[i];
+    ev[2][i] = v1[i];
+    ev[3][i] = v1[i];
+    ev[4][i] = v1[i] + a;
+
+    REM(0,0) = 1.0;
+    REM(1,0) = -a/d[i];
+    REM(4,0) = asq;
+    REM(0,1) = 1.0;
+    REM(2,2) = 1.0;
+    REM(3,3) = 1.0;
+    REM(0,4) = 1.0;
+    REM(1,4) = -REM(1,0);
+    REM(4,4) = asq;
+
+    LEM(0,1) = -0.5*d[i]/a;
+    LEM(0,4) = 0.5/asq;
+    LEM(1,0) = 1.0;
+    LEM(1,4) = -1.0/asq;
+    LEM(2,2) = 1.0;
+    LEM(3,3) = 1.0;
+    LEM(4,1) = -LEM(0,1);
+    LEM(4,4) = LEM(0,4);
+  }
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void esys_prim_iso_mhd_pencil(const int il, const int iu,
+ *  const Real d[], const Real v1[], const Real b1[], const Real b2[],
+ *  const Real b3[], Real **eigenvalues,
+ *  Real **right_eigenmatrix, Real **left_eigenmatrix)
+ *  \brief ISOTHERMAL MHD, cells il..iu of a pencil
+ */
+
+#if defined(BAROTROPIC) && defined(MHD)
+void SIMD_CLONES esys_prim_iso_mhd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real b1[], const Real b2[],
+  const Real b3[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix)
+{
+  int i,k;
+  Real *ev[NWAVE], *rem[NWAVE*NWAVE], *lem[NWAVE*NWAVE];
+  Real btsq,vaxsq,cfsq,cf,cssq,cs,bt,bet2,bet3,alpha_f,alpha_s;
+  Real sqrtd,s,qf,qs,af,as,vax,norm,af_prime,as_prime;
+  Real ct2,tsum,tdif,cf2_cs2,di,tf,ts;
+
+  for (k=0; k<NWAVE; k++) ev[k] = eigenvalues[k];
+  for (k=0; k<NWAVE*NWAVE; k++) {
+    rem[k] = right_eigenmatrix[k];
+    lem[k] = left_eigenmatrix[k];
+  }
+
+SIMD_IVDEP
+  for (i=il; i<=iu; i++) {
+    di = 1.0/d[i];
+    btsq  = b2[i]*b2[i] + b3[i]*b3[i];
+    vaxsq = b1[i]*b1[i]*di;
+
+    ct2 = btsq*di;
+    tsum = vaxsq + ct2 + (Iso_csound2);
+    tdif = vaxsq + ct2 - (Iso_csound2);
+    cf2_cs2 = sqrt((double)(tdif*tdif + 4.0*(Iso_csound2)*ct2));
+
+    cfsq = 0.5*(tsum + cf2_cs2);
+    cf = sqrt((double)cfsq);
+
+    cssq = (Iso_csound2)*vaxsq/cfsq;
+    cs = sqrt((double)cssq);
+
+    bt = sqrt(btsq);
+    bet2 = b2[i]/bt;
+    bet3 = b3[i]/bt;
+    bet2 = (bt == 0.0) ? 1.0 : bet2;
+    bet3 = (bt == 0.0) ? 0.0 : bet3;
+
+    tf = sqrt((Iso_csound2 - cssq)/(cfsq - cssq));
+    ts = sqrt((cfsq - Iso_csound2)/(cfsq - cssq));
+    alpha_f = ((cfsq - Iso_csound2) <= 0.0) ? 1.0 : tf;
+    alpha_s = ((cfsq - Iso_csound2) <= 0.0) ? 0.0 : ts;
+    alpha_f = ((Iso_csound2 - cssq) <= 0.0) ? 0.0 : alpha_f;
+    alpha_s = ((Iso_csound2 - cssq) <= 0.0) ? 1.0 : alpha_s;
+    alpha_f = ((cfsq-cssq) == 0.0) ? 1.0 : alpha_f;
+    alpha_s = ((cfsq-cssq) == 0.0) ? 0.0 : alpha_s;
+
+    sqrtd = sqrt(d[i]);
+    s = SIGN(b1[i]);
+    qf = cf*alpha_f*s;
+    qs = cs*alpha_s*s;
+    af = Iso_csound*alpha_f*sqrtd;
+    as = Iso_csound*alpha_s*sqrtd;
+
+    vax = sqrt(vaxsq);
+    ev[0][i] = v1[i] - cf;
+    ev[1][i] = v1[i] - vax;
+    ev[2][i] = v1[i] - cs;
+    ev[3][i] = v1[i] + cs;
+    ev[4][i] = v1[i] + vax;
+    ev[5][i] = v1[i] + cf;
+
+    REM(0,0) = d[i]*alpha_f;
+    REM(1,0) = -cf*alpha_f;
+    REM(2,0) = qs*bet2;
+    REM(3,0) = qs*bet3;
+    REM(4,0) = as*bet2;
+    REM(5,0) = as*bet3;
+
+    REM(2,1) = -bet3;
+    REM(3,1) = bet2;
+    REM(4,1) = -bet3*s*sqrtd;
+    REM(5,1) = bet2*s*sqrtd;
+
+    REM(0,2) = d[i]*alpha_s;
+    REM(1,2) = -cs*alpha_s;
+    REM(2,2) = -qf*bet2;
+    REM(3,2) = -qf*bet3;
+    REM(4,2) = -af*bet2;
+    REM(5,2) = -af*bet3;
+
+    REM(0,3) = REM(0,2);
+    REM(1,3) = -REM(1,2);
+    REM(2,3) = -REM(2,2);
+    REM(3,3) = -REM(3,2);
+    REM(4,3) = REM(4,2);
+    REM(5,3) = REM(5,2);
+
+    REM(2,4) = bet3;
+    REM(3,4) = -bet2;
+    REM(4,4) = REM(4,1);
+    REM(5,4) = REM(5,1);
+
+    REM(0,5) = REM(0,0);
+    REM(1,5) = -REM(1,0);
+    REM(2,5) = -REM(2,0);
+    REM(3,5) = -REM(3,0);
+    REM(4,5) = REM(4,0);
+    REM(5,5) = REM(5,0);
+
+    norm = 0.5/Iso_csound2;
+    qf = norm*qf;
+    qs = norm*qs;
+    af_prime = norm*af*di;
+    as_prime = norm*as*di;
+
+    LEM(0,0) = norm*alpha_f*Iso_csound2*di;
+    LEM(0,1) = -norm*cf*alpha_f;
+    LEM(0,2) = qs*bet2;
+    LEM(0,3) = qs*bet3;
+    LEM(0,4) = as_prime*bet2;
+    LEM(0,5) = as_prime*bet3;
+
+    LEM(1,2) = -0.5*bet3;
+    LEM(1,3) = 0.5*bet2;
+    LEM(1,4) = -0.5*bet3*s/sqrtd;
+    LEM(1,5) = 0.5*bet2*s/sqrtd;
+
+    LEM(2,0) = norm*alpha_s*Iso_csound2*di;
+    LEM(2,1) = -norm*cs*alpha_s;
+    LEM(2,2) = -qf*bet2;
+    LEM(2,3) = -qf*bet3;
+    LEM(2,4) = -af_prime*bet2;
+    LEM(2,5) = -af_prime*bet3;
+
+    LEM(3,0) = LEM(2,0);
+    LEM(3,1) = -LEM(2,1);
+    LEM(3,2) = -LEM(2,2);
+    LEM(3,3) = -LEM(2,3);
+    LEM(3,4) = LEM(2,4);
+    LEM(3,5) = LEM(2,5);
+
+    LEM(4,2) = -LEM(1,2);
+    LEM(4,3) = -LEM(1,3);
+    LEM(4,4) = LEM(1,4);
+    LEM(4,5) = LEM(1,5);
+
+    LEM(5,0) = LEM(0,0);
+    LEM(5,1) = -LEM(0,1);
+    LEM(5,2) = -LEM(0,2);
+    LEM(5,3) = -LEM(0,3);
+    LEM(5,4) = LEM(0,4);
+    LEM(5,5) = LEM(0,5);
+  }
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void esys_prim_adb_mhd_pencil(const int il, const int iu,
+ *  const Real d[], const Real v1[], const Real p[], const Real b1[],
+ *  const Real b2[], const Real b3[], Real **eigenvalues,
+ *  Real **right_eigenmatrix, Real **left_eigenmatrix)
+ *  \brief ADIABATIC MHD, cells il..iu of a pencil.  Takes the pressure p
+ *   rather than rho_a2=Gamma*p.
+ */
+
+#if !defined(BAROTROPIC) && defined(MHD)
+void SIMD_CLONES esys_prim_adb_mhd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real p[], const Real b1[],
+  const Real b2[], const Real b3[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix)
+{
+  int i,k;
+  Real *ev[NWAVE], *rem[NWAVE*NWAVE], *lem[NWAVE*NWAVE];
+  Real di,cfsq,cf,cssq,cs,bt,bet2,bet3,alpha_f,alpha_s;
+  Real sqrtd,s,a,qf,qs,af,as,vax,na,af_prime,as_prime;
+  Real tsum,tdif,cf2_cs2,ct2;
+  Real btsq,vaxsq,asq,tf,ts;
+
+  for (k=0; k<NWAVE; k++) ev[k] = eigenvalues[k];
+  for (k=0; k<NWAVE*NWAVE; k++) {
+    rem[k] = right_eigenmatrix[k];
+    lem[k] = left_eigenmatrix[k];
+  }
+
+SIMD_IVDEP
+  for (i=il; i<=iu; i++) {
+    di = 1.0/d[i];
+    btsq  = b2[i]*b2[i] + b3[i]*b3[i];
+    vaxsq = b1[i]*b1[i]*di;
+    asq   = Gamma*p[i]*di;
+
+    ct2 = btsq*di;
+    tsum = vaxsq + ct2 + asq;
+    tdif = vaxsq + ct2 - asq;
+    cf2_cs2 = sqrt((double)(tdif*tdif + 4.0*asq*ct2));
+
+    cfsq = 0.5*(tsum + cf2_cs2);
+    cf = sqrt((double)cfsq);
+
+    cssq = asq*vaxsq/cfsq;
+    cs = sqrt((double)cssq);
+
+    bt  = sqrt(btsq);
+    bet2 = b2[i]/bt;
+    bet3 = b3[i]/bt;
+    bet2 = (bt == 0.0) ? 1.0 : bet2;
+    bet3 = (bt == 0.0) ? 0.0 : bet3;
+
+    tf = sqrt((asq - cssq)/cf2_cs2);
+    ts = sqrt((cfsq - asq)/cf2_cs2);
+    alpha_f = ((cfsq - asq) <= 0.0) ? 1.0 : tf;
+    alpha_s = ((cfsq - asq) <= 0.0) ? 0.0 : ts;
+    alpha_f = ((asq - cssq) <= 0.0) ? 0.0 : alpha_f;
+    alpha_s = ((asq - cssq) <= 0.0) ? 1.0 : alpha_s;
+    alpha_f = (cf2_cs2 == 0.0) ? 1.0 : alpha_f;
+    alpha_s = (cf2_cs2 == 0.0) ? 0.0 : alpha_s;
+
+    sqrtd = sqrt(d[i]);
+    s = SIGN(b1[i]);
+    a = sqrt(asq);
+    qf = cf*alpha_f*s;
+    qs = cs*alpha_s*s;
+    af = a*alpha_f*sqrtd;
+    as = a*alpha_s*sqrtd;
+
+    vax = sqrt(vaxsq);
+    ev[0][i] = v1[i] - cf;
+    ev[1][i] = v1[i] - vax;
+    ev[2][i] = v1[i] - cs;
+    ev[3][i] = v1[i];
+    ev[4][i] = v1[i] + cs;
+    ev[5][i] = v1[i] + vax;
+    ev[6][i] = v1[i] + cf;
+
+    REM(0,0) = d[i]*alpha_f;
+    REM(0,2) = d[i]*alpha_s;
+    REM(0,3) = 1.0;
+    REM(0,4) = REM(0,2);
+    REM(0,6) = REM(0,0);
+
+    REM(1,0) = -cf*alpha_f;
+    REM(1,2) = -cs*alpha_s;
+    REM(1,4) = -REM(1,2);
+    REM(1,6) = -REM(1,0);
+
+    REM(2,0) = qs*bet2;
+    REM(2,1) = -bet3;
+    REM(2,2) = -qf*bet2;
+    REM(2,4) = -REM(2,2);
+    REM(2,5) = bet3;
+    REM(2,6) = -REM(2,0);
+
+    REM(3,0) = qs*bet3;
+    REM(3,1) = bet2;
+    REM(3,2) = -qf*bet3;
+    REM(3,4) = -REM(3,2);
+    REM(3,5) = -bet2;
+    REM(3,6) = -REM(3,0);
+
+    REM(4,0) = d[i]*asq*alpha_f;
+    REM(4,2) = d[i]*asq*alpha_s;
+    REM(4,4) = REM(4,2);
+    REM(4,6) = REM(4,0);
+
+    REM(5,0) = as*bet2;
+    REM(5,1) = -bet3*s*sqrtd;
+    REM(5,2) = -af*bet2;
+    REM(5,4) = REM(5,2);
+    REM(5,5) = REM(5,1);
+    REM(5,6) = REM(5,0);
+
+    REM(6,0) = as*bet3;
+    REM(6,1) = bet2*s*sqrtd;
+    REM(6,2) = -af*bet3;
+    REM(6,4) = REM(6,2);
+    REM(6,5) = REM(6,1);
+    REM(6,6) = REM(6,0);
+
+    na = 0.5/asq;
+    qf = na*qf;
+    qs = na*qs;
+    af_prime = na*af*di;
+    as_prime = na*as*di;
+
+    LEM(0,1) = -na*cf*alpha_f;
+    LEM(0,2) = qs*bet2;
+    LEM(0,3) = qs*bet3;
+    LEM(0,4) = na*alpha_f*di;
+    LEM(0,5) = as_prime*bet2;
+    LEM(0,6) = as_prime*bet3;
+
+    LEM(1,2) = -0.5*bet3;
+    LEM(1,3) = 0.5*bet2;
+    LEM(1,5) = -0.5*bet3*s/sqrtd;
+    LEM(1,6) = 0.5*bet2*s/sqrtd;
+
+    LEM(2,1) = -na*cs*alpha_s;
+    LEM(2,2) = -qf*bet2;
+    LEM(2,3) = -qf*bet3;
+    LEM(2,4) = na*alpha_s*di;
+    LEM(2,5) = -af_prime*bet2;
+    LEM(2,6) = -af_prime*bet3;
+
+    LEM(3,0) = 1.0;
+    LEM(3,4) = -1.0/asq;
+
+    LEM(4,1) = -LEM(2,1);
+    LEM(4,2) = -LEM(2,2);
+    LEM(4,3) = -LEM(2,3);
+    LEM(4,4) = LEM(2,4);
+    LEM(4,5) = LEM(2,5);
+    LEM(4,6) = LEM(2,6);
+
+    LEM(5,2) = -LEM(1,2);
+    LEM(5,3) = -LEM(1,3);
+    LEM(5,5) = LEM(1,5);
+    LEM(5,6) = LEM(1,6);
+
+    LEM(6,1) = -LEM(0,1);
+    LEM(6,2) = -LEM(0,2);
+    LEM(6,3) = -LEM(0,3);
+    LEM(6,4) = LEM(0,4);
+    LEM(6,5) = LEM(0,5);
+    LEM(6,6) = LEM(0,6);
+  }
+}
+#endif
+
+#undef REM
+#undef LEM
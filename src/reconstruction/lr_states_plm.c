@@ -46,6 +46,9 @@
 
 
 static Real **pW=NULL;
+#ifdef OPENMP
+#pragma omp threadprivate(pW)
+#endif
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void lr_states(const GridS *pG, const Prim1DS W[], const Real Bxc[], 
@@ -408,7 +411,7 @@ void lr_states(const GridS *pG __attribute__((unused)),
 
 void lr_states_init(MeshS *pM)
 {
-  int nmax,size1=0,size2=0,size3=0,nl,nd;
+  int nmax,size1=0,size2=0,size3=0,nl,nd,ierr=0;
 
 /* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
   for (nl=0; nl<(pM->NLevels); nl++){
@@ -432,7 +435,14 @@ void lr_states_init(MeshS *pM)
   size3 = size3 + 2*nghost;
   nmax = MAX((MAX(size1,size2)),size3);
 
-  if ((pW = (Real**)malloc(nmax*sizeof(Real*))) == NULL) goto on_error;
+/* Every OpenMP thread allocates its own private copy of the work arrays */
+#ifdef OPENMP
+#pragma omp parallel reduction(+:ierr)
+#endif
+  {
+    if ((pW = (Real**)malloc(nmax*sizeof(Real*))) == NULL) ierr++;
+  }
+  if (ierr > 0) goto on_error;
 
   return;
   on_error:
@@ -446,7 +456,12 @@ void lr_states_init(MeshS *pM)
 
 void lr_states_destruct(void)
 {
-  if (pW != NULL) free(pW);
+#ifdef OPENMP
+#pragma omp parallel
+#endif
+  {
+    if (pW != NULL) free(pW);
+  }
   return;
 }
 
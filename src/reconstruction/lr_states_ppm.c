@@ -18,7 +18,7 @@
  * - W_{L,i+1/2} is denoted by Wl[i+1];   W_{R,i+1/2} is denoted by Wr[i+1]
  *
  *   Internally, in this routine, Wlv and Wrv are the reconstructed values on
- *   the left-and right-side of cell center.  Thus (see Step 18),
+ *   the left-and right-side of cell center.  Thus (see Step 8),
  * -   W_{L,i-1/2} = Wrv(i-1);  W_{R,i-1/2} = Wlv(i)
  *
  * REFERENCE:
@@ -48,7 +48,18 @@
 #error : PPM reconstruction (order=3) cannot be used with VL integrator.
 #endif /* VL_INTEGRATOR */
 
-static Real **pW=NULL, **dWm=NULL, **Wim1h=NULL;
+/* Work arrays, all indexed [variable][i] so that each step below is a loop
+ * over the whole pencil.  Element [n][m] of the eigenmatrices of cell i is
+ * stored in rem[n*NWAVE+m][i] and lem[n*NWAVE+m][i]. */
+static Real **W1d=NULL, **ev=NULL, **rem=NULL, **lem=NULL;
+static Real **dWc=NULL, **dWl=NULL, **dWr=NULL, **dWg=NULL;
+static Real **dac=NULL, **dal=NULL, **dar=NULL, **dag=NULL;
+static Real **dWm=NULL, **Wim1h=NULL, **Wlv=NULL, **Wrv=NULL;
+static Real **dW=NULL, **W6=NULL;
+#ifdef OPENMP
+#pragma omp threadprivate(W1d,ev,rem,lem,dWc,dWl,dWr,dWg,dac,dal,dar,dag)
+#pragma omp threadprivate(dWm,Wim1h,Wlv,Wrv,dW,W6)
+#endif
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void lr_states(const GridS* pG, const Prim1DS W[], const Real Bxc[],
@@ -65,615 +76,451 @@ static Real **pW=NULL, **dWm=NULL, **Wim1h=NULL;
  *
  * Output Arguments:
  * - Wl,Wr = L/R-states of PRIMITIVE variables at interfaces over [il:iu+1]
+ *
+ * Each step is applied to every cell of the pencil before the next one, and
+ * the branches of the limiters are written as selects, so the loops over i
+ * vectorize.  The arithmetic for each cell is the same as in the original
+ * cell-by-cell version of this function.
  */
 
-void lr_states(const GridS* pG __attribute__((unused)),
+void SIMD_CLONES lr_states(const GridS* pG __attribute__((unused)),
                const Prim1DS W[], const Real Bxc[],
                const Real dt, const Real dx, const int il, const int iu,
-               Prim1DS Wl[], Prim1DS Wr[], 
+               Prim1DS Wl[], Prim1DS Wr[],
                const int dir __attribute__((unused)))
 {
   int i,n,m;
-  Real lim_slope1,lim_slope2,qa,qb,qc,qx;
-  Real ev    [NWAVE],rem    [NWAVE][NWAVE],lem    [NWAVE][NWAVE];
-  Real ev_ip1[NWAVE],rem_ip1[NWAVE][NWAVE],lem_ip1[NWAVE][NWAVE];
-  Real dWc[NWAVE+NSCALARS],dWl[NWAVE+NSCALARS];
-  Real dWr[NWAVE+NSCALARS],dWg[NWAVE+NSCALARS];
-  Real dac[NWAVE+NSCALARS],dal[NWAVE+NSCALARS];
-  Real dar[NWAVE+NSCALARS],dag[NWAVE+NSCALARS],da[NWAVE+NSCALARS];
-  Real Wlv[NWAVE+NSCALARS],Wrv[NWAVE+NSCALARS];
-  Real dW[NWAVE+NSCALARS],W6[NWAVE+NSCALARS];
+  Real lim_slope1,lim_slope2,qa,qb,qc,qx,tl,tr;
+  Real wc,wl,wr,wlv,wrv;
+  const Real *pW;
   Real *pWl, *pWr;
+  Real *pw, *pc, *pl, *pr, *pg, *pe;
+  Real *lm[NWAVE], *rm[NWAVE];
   Real qx1,qx2;
 
   /* ADDITIONAL VARIABLES REQUIRED FOR CYLINDRICAL COORDINATES */
-  Real ql,qr,qxx1,qxx2,zc,zr,zl,q1,q2,gamma_curv;
+  Real qxx1,qxx2,gamma_curv;
   const Real dtodx = dt/dx;
 #ifdef CYLINDRICAL
   const Real *r=pG->r, *ri=pG->ri;
 #endif
 
-/* Zero eigenmatrices, set pointer to primitive variables */
-  for (n=0; n<NWAVE; n++) {
-    for (m=0; m<NWAVE; m++) {
-      rem[n][m] = 0.0;
-      lem[n][m] = 0.0;
-      rem_ip1[n][m] = 0.0;
-      lem_ip1[n][m] = 0.0;
-    }
-  }
-  for (i=il-3; i<=iu+3; i++) pW[i] = (Real*)&(W[i]);
-
-/*====================== START LOOP OVER il-2:il-1 ==========================*/
-
 /*--- Step 1. ------------------------------------------------------------------
- * Compute eigensystem in primitive variables.  */
+ * Copy primitive variables into pencil arrays, and compute eigensystem in
+ * primitive variables over il-2:iu+2 */
 
-  for (i=il-2; i<=il-1; i++) {
+  for (i=il-3; i<=iu+3; i++) {
+    pW = (const Real*)&(W[i]);
+    for (n=0; n<(NWAVE+NSCALARS); n++) W1d[n][i] = pW[n];
+  }
 
 #ifdef HYDRO
 #ifdef ISOTHERMAL
-    esys_prim_iso_hyd(W[i].d,W[i].Vx,             ev,rem,lem);
+  esys_prim_iso_hyd_pencil(il-2,iu+2,W1d[0],W1d[1],ev,rem,lem);
 #else
-    esys_prim_adb_hyd(W[i].d,W[i].Vx,Gamma*W[i].P,ev,rem,lem);
+  esys_prim_adb_hyd_pencil(il-2,iu+2,W1d[0],W1d[1],W1d[4],ev,rem,lem);
 #endif /* ISOTHERMAL */
 #endif /* HYDRO */
 
 #ifdef MHD
 #ifdef ISOTHERMAL
-    esys_prim_iso_mhd(
-      W[i].d,W[i].Vx,             Bxc[i],W[i].By,W[i].Bz,ev,rem,lem);
+  esys_prim_iso_mhd_pencil(il-2,iu+2,W1d[0],W1d[1],
+    Bxc,W1d[4],W1d[5],ev,rem,lem);
 #else
-    esys_prim_adb_mhd(
-      W[i].d,W[i].Vx,Gamma*W[i].P,Bxc[i],W[i].By,W[i].Bz,ev,rem,lem);
+  esys_prim_adb_mhd_pencil(il-2,iu+2,W1d[0],W1d[1],W1d[4],
+    Bxc,W1d[5],W1d[6],ev,rem,lem);
 #endif /* ISOTHERMAL */
 #endif /* MHD */
 
 /*--- Step 2. ------------------------------------------------------------------
- * Compute centered, L/R, and van Leer differences of primitive variables
- * Note we access contiguous array elements by indexing pointers for speed */
+ * Compute centered, L/R, and van Leer differences of primitive variables.
+ * Row pointers are loaded once per variable so that the loops over i see
+ * loop-invariant bases. */
 
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
+  for (n=0; n<(NWAVE+NSCALARS); n++) {
+    pw = W1d[n];
+    pc = dWc[n];
+    pl = dWl[n];
+    pr = dWr[n];
+    pg = dWg[n];
 #ifdef CYLINDRICAL
-      if (dir==1) {
-        dWc[n] = (pW[i+1][n]*r[i+1] - pW[i-1][n]*r[i-1])/r[i];
-        dWl[n] = (pW[i  ][n]*r[i  ] - pW[i-1][n]*r[i-1])/ri[i];
-        dWr[n] = (pW[i+1][n]*r[i+1] - pW[i  ][n]*r[i  ])/ri[i+1];
-      }
-      else
+    if (dir==1) {
+      for (i=il-2; i<=iu+2; i++) pc[i] = (pw[i+1]*r[i+1] - pw[i-1]*r[i-1])/r[i];
+      for (i=il-2; i<=iu+2; i++) pl[i] = (pw[i  ]*r[i  ] - pw[i-1]*r[i-1])/ri[i];
+      for (i=il-2; i<=iu+2; i++) pr[i] = (pw[i+1]*r[i+1] - pw[i  ]*r[i  ])/ri[i+1];
+    }
+    else
 #endif
-      {
-        dWc[n] = pW[i+1][n] - pW[i-1][n];
-        dWl[n] = pW[i  ][n] - pW[i-1][n];
-        dWr[n] = pW[i+1][n] - pW[i  ][n];
-      }
-      if (dWl[n]*dWr[n] > 0.0) {
-        dWg[n] = 2.0*dWl[n]*dWr[n]/(dWl[n]+dWr[n]);
-      } else {
-        dWg[n] = 0.0;
-      }
+    {
+      for (i=il-2; i<=iu+2; i++) pc[i] = pw[i+1] - pw[i-1];
+      for (i=il-2; i<=iu+2; i++) pl[i] = pw[i  ] - pw[i-1];
+      for (i=il-2; i<=iu+2; i++) pr[i] = pw[i+1] - pw[i  ];
+    }
+    for (i=il-2; i<=iu+2; i++) {
+      qa = 2.0*pl[i]*pr[i]/(pl[i]+pr[i]);
+      pg[i] = (pl[i]*pr[i] > 0.0) ? qa : 0.0;
     }
+  }
 
 /*--- Step 3. ------------------------------------------------------------------
  * Project differences in primitive variables along characteristics */
 
-    for (n=0; n<NWAVE; n++) {
-      dac[n] = lem[n][0]*dWc[0];
-      dal[n] = lem[n][0]*dWl[0];
-      dar[n] = lem[n][0]*dWr[0];
-      dag[n] = lem[n][0]*dWg[0];
+  for (n=0; n<NWAVE; n++) {
+    for (m=0; m<NWAVE; m++) lm[m] = lem[n*NWAVE+m];
+    pc = dac[n];
+    pl = dal[n];
+    pr = dar[n];
+    pg = dag[n];
+SIMD_IVDEP
+    for (i=il-2; i<=iu+2; i++) {
+      qa = lm[0][i]*dWc[0][i];
+      qb = lm[0][i]*dWl[0][i];
+      qc = lm[0][i]*dWr[0][i];
+      qx = lm[0][i]*dWg[0][i];
       for (m=1; m<NWAVE; m++) {
-	dac[n] += lem[n][m]*dWc[m];
-	dal[n] += lem[n][m]*dWl[m];
-	dar[n] += lem[n][m]*dWr[m];
-	dag[n] += lem[n][m]*dWg[m];
+        qa += lm[m][i]*dWc[m][i];
+        qb += lm[m][i]*dWl[m][i];
+        qc += lm[m][i]*dWr[m][i];
+        qx += lm[m][i]*dWg[m][i];
       }
+      pc[i] = qa;
+      pl[i] = qb;
+      pr[i] = qc;
+      pg[i] = qx;
     }
+  }
 
 /* Advected variables are treated differently; for them the right and left
  * eigenmatrices are simply the identitiy matrix.
  */
 #if (NSCALARS > 0)
-    for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
-      dac[n] = dWc[n];
-      dal[n] = dWl[n];
-      dar[n] = dWr[n];
-      dag[n] = dWg[n];
+  for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
+    for (i=il-2; i<=iu+2; i++) {
+      dac[n][i] = dWc[n][i];
+      dal[n][i] = dWl[n][i];
+      dar[n][i] = dWr[n][i];
+      dag[n][i] = dWg[n][i];
     }
+  }
 #endif
 
 /*--- Step 4. ------------------------------------------------------------------
- * Apply monotonicity constraints to characteristic projections */
+ * Apply monotonicity constraints to characteristic projections.  The limited
+ * slopes overwrite dac. */
 
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      da[n] = 0.0;
-      if (dal[n]*dar[n] > 0.0) {
-        lim_slope1 = MIN(    fabs(dal[n]),fabs(dar[n]));
-        lim_slope2 = MIN(0.5*fabs(dac[n]),fabs(dag[n]));
-        da[n] = SIGN(dac[n])*MIN(2.0*lim_slope1,lim_slope2);
-      }
+  for (n=0; n<(NWAVE+NSCALARS); n++) {
+    pc = dac[n];
+    pl = dal[n];
+    pr = dar[n];
+    pg = dag[n];
+    for (i=il-2; i<=iu+2; i++) {
+      lim_slope1 = MIN(    fabs(pl[i]),fabs(pr[i]));
+      lim_slope2 = MIN(0.5*fabs(pc[i]),fabs(pg[i]));
+      qa = SIGN(pc[i])*MIN(2.0*lim_slope1,lim_slope2);
+      pc[i] = (pl[i]*pr[i] > 0.0) ? qa : 0.0;
     }
+  }
 
 /*--- Step 5. ------------------------------------------------------------------
  * Project monotonic slopes in characteristic back to primitive variables  */
 
-    for (n=0; n<NWAVE; n++) {
-      dWm[i][n] = da[0]*rem[n][0];
+  for (n=0; n<NWAVE; n++) {
+    for (m=0; m<NWAVE; m++) rm[m] = rem[n*NWAVE+m];
+    pl = dWm[n];
+SIMD_IVDEP
+    for (i=il-2; i<=iu+2; i++) {
+      qa = dac[0][i]*rm[0][i];
       for (m=1; m<NWAVE; m++) {
-        dWm[i][n] += da[m]*rem[n][m];
+        qa += dac[m][i]*rm[m][i];
       }
+      pl[i] = qa;
     }
+  }
 
 #if (NSCALARS > 0)
-    for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
-      dWm[i][n] = da[n];
+  for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
+    for (i=il-2; i<=iu+2; i++) {
+      dWm[n][i] = dac[n][i];
     }
+  }
 #endif
 
 /*--- Step 6. ------------------------------------------------------------------
- * Limit velocity difference to sound speed
- * Limit velocity so momentum is always TVD (using only minmod limiter)
- * CURRENTLY NOT USED.  Was added to make code more robust for turbulence
- * simulations, but found it added noise to Noh shocktube.
- */ 
-
-#ifdef H_CORRECTION
-/* 
-#ifdef ISOTHERMAL
-    qa = Iso_csound;
-#else
-    qa = sqrt(Gamma*W[i].P/W[i].d);
-#endif
-    dWm[i][1] = SIGN(dWm[i][1])*MIN(fabs(dWm[i][1]),qa);
-*/
-#endif /* H_CORRECTION */
-/* 
-    qa = W[i  ].Vx*W[i  ].d - W[i-1].Vx*W[i-1].d;
-    qb = W[i+1].Vx*W[i+1].d - W[i  ].Vx*W[i  ].d;
-    qc = W[i+1].Vx*W[i+1].d - W[i-1].Vx*W[i-1].d;
-    qx = SIGN(qc)*MIN(2.0*MIN(fabs(qa),fabs(qb)), 0.5*fabs(qc));
-
-    if ((-W[i].Vx*dWm[i][0]) > 0.0) {
-      qa = 0.0;
-      qb = -W[i].Vx*dWm[i][0];
-    } else {
-      qa = -W[i].Vx*dWm[i][0];
-      qb = 0.0;
-    }
-    if (qx > 0.0) {
-      qb += qx;
-    } else {
-      qa += qx;
-    }
-    qa = qa/W[i].d;
-    qb = qb/W[i].d;
-
-    dWm[i][1] = MIN(dWm[i][1],qb);
-    dWm[i][1] = MAX(dWm[i][1],qa);
-*/
-  }
-/*====================== END LOOP OVER il-2:il-1 =========================*/
-
-
-/*--- Step 7. ------------------------------------------------------------------
  * Construct parabolic interpolant in primitive variables at left-interface
- * of cell il-1 ("W[il-3/2]", CW eqn 1.6) using linear TVD slopes at il-2 and
- * il-1 computed in Steps 2-7.
+ * of cells il-1:iu+2 ("W[i-1/2]", CW eqn 1.6) using linear TVD slopes at i-1
+ * and i computed in Steps 2-5.
  */
 
   for (n=0; n<(NWAVE+NSCALARS); n++) {
+    pw = W1d[n];
+    pc = dWm[n];
+    pl = Wim1h[n];
 #ifdef CYLINDRICAL
     if (dir==1) {
-      Wim1h[il-1][n] = (0.5*(pW[il-1][n]*r[il-1] + pW[il-2][n]*r[il-2])
-                     - (dWm[il-1][n]*r[il-1] - dWm[il-2][n]*r[il-2])/6.0)/ri[il-1];
+      for (i=il-1; i<=iu+2; i++) {
+        pl[i] = (0.5*(pw[i]*r[i] + pw[i-1]*r[i-1])
+              - (pc[i]*r[i] - pc[i-1]*r[i-1])/6.0)/ri[i];
+      }
     }
     else
 #endif
     {
-      Wim1h[il-1][n] =.5*(pW[il-1][n]+pW[il-2][n])-(dWm[il-1][n]-dWm[il-2][n])/6.;
-    }
-  }
-
-/* Loop over il-2:il-1 in Steps 2-7 was necessary to bootstrap method by
- * computing Wim1h[il-1].  Now repeat these steps for rest of grid.  Splitting
- * into two loops avoids calculating eigensystems twice per cell.
- *
- * At the start of the loop, rem and lem still store values at i=il-1 computed
- * at the end of Step 2.  For each i, the eigensystem at i+1 is stored in
- * rem_ip1 and lem_ip1.  At the end of the loop rem[lem] is then set to
- * rem_ip1[lem_ip1] in preparation for the next iteration.
- */
-
-/*========================= START BIG LOOP OVER i =========================*/
-/* Steps 8-14 below are identical to steps 1-7 above */
-  for (i=il-1; i<=iu+1; i++) {
-
-/*--- Step 8. ------------------------------------------------------------------
- * Compute eigensystem in primitive variables.  */
-
-#ifdef HYDRO
-#ifdef ISOTHERMAL
-    esys_prim_iso_hyd(W[i+1].d,W[i+1].Vx,               ev_ip1,rem_ip1,lem_ip1);
-#else
-    esys_prim_adb_hyd(W[i+1].d,W[i+1].Vx,Gamma*W[i+1].P,ev_ip1,rem_ip1,lem_ip1);
-#endif /* ISOTHERMAL */
-#endif /* HYDRO */
-
-#ifdef MHD
-#ifdef ISOTHERMAL
-    esys_prim_iso_mhd(W[i+1].d,W[i+1].Vx,
-      Bxc[i+1],W[i+1].By,W[i+1].Bz,ev_ip1,rem_ip1,lem_ip1);
-#else
-    esys_prim_adb_mhd(W[i+1].d,W[i+1].Vx,Gamma*W[i+1].P,
-      Bxc[i+1],W[i+1].By,W[i+1].Bz,ev_ip1,rem_ip1,lem_ip1);
-#endif /* ISOTHERMAL */
-#endif /* MHD */
-
-/*--- Step 9. ------------------------------------------------------------------
- * Compute centered, L/R, and van Leer differences of primitive variables */
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-#ifdef CYLINDRICAL
-      if (dir==1) {
-        dWc[n] = (pW[i+2][n]*r[i+2] - pW[i  ][n]*r[i  ])/r[i+1];
-        dWl[n] = (pW[i+1][n]*r[i+1] - pW[i  ][n]*r[i  ])/ri[i+1];
-        dWr[n] = (pW[i+2][n]*r[i+2] - pW[i+1][n]*r[i+1])/ri[i+2];
-      }
-      else
-#endif
-      {
-        dWc[n] = pW[i+2][n] - pW[i  ][n];
-        dWl[n] = pW[i+1][n] - pW[i  ][n];
-        dWr[n] = pW[i+2][n] - pW[i+1][n];
-      }
-      if (dWl[n]*dWr[n] > 0.0) {
-        dWg[n] = 2.0*dWl[n]*dWr[n]/(dWl[n]+dWr[n]);
-      } else {
-        dWg[n] = 0.0;
+      for (i=il-1; i<=iu+2; i++) {
+        pl[i] = 0.5*(pw[i]+pw[i-1]) - (pc[i]-pc[i-1])/6.0;
       }
     }
+  }
 
-/*--- Step 10. -----------------------------------------------------------------
- * Project differences in primitive variables along characteristics */
-
-    for (n=0; n<NWAVE; n++) {
-      dac[n] = lem_ip1[n][0]*dWc[0];
-      dal[n] = lem_ip1[n][0]*dWl[0];
-      dar[n] = lem_ip1[n][0]*dWr[0];
-      dag[n] = lem_ip1[n][0]*dWg[0];
-      for (m=1; m<NWAVE; m++) {
-        dac[n] += lem_ip1[n][m]*dWc[m];
-        dal[n] += lem_ip1[n][m]*dWl[m];
-        dar[n] += lem_ip1[n][m]*dWr[m];
-        dag[n] += lem_ip1[n][m]*dWg[m];
-      }
-    }
-
-/* Advected variables are treated differently; for them the right and left
- * eigenmatrices are simply the identitiy matrix.
- */
-#if (NSCALARS > 0)
-    for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
-      dac[n] = dWc[n];
-      dal[n] = dWl[n];
-      dar[n] = dWr[n];
-      dag[n] = dWg[n];
-    }
-#endif
-
-/*--- Step 11. -----------------------------------------------------------------
- * Apply monotonicity constraints to characteristic projections */
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      da[n] = 0.0;
-      if (dal[n]*dar[n] > 0.0) {
-        lim_slope1 = MIN(    fabs(dal[n]),fabs(dar[n]));
-        lim_slope2 = MIN(0.5*fabs(dac[n]),fabs(dag[n]));
-        da[n] = SIGN(dac[n])*MIN(2.0*lim_slope1,lim_slope2);
-      }
-    }
-
-/*--- Step 12. -----------------------------------------------------------------
- * Project monotonic slopes in characteristic back to primitive variables  */
-
-    for (n=0; n<NWAVE; n++) {
-      dWm[i+1][n] = da[0]*rem_ip1[n][0];
-      for (m=1; m<NWAVE; m++) {
-        dWm[i+1][n] += da[m]*rem_ip1[n][m];
-      }
-    }
-
-#if (NSCALARS > 0)
-    for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
-      dWm[i+1][n] = da[n];
-    }
-#endif
-
-/*--- Step 13. -----------------------------------------------------------------
- * When H-correction defined, limit velocity difference to sound speed
- * Limit velocity so momentum is always TVD (using only minmod limiter)
- * CURRENTLY NOT USED.  Was added to make code more robust for turbulence
- * simulations, but found it added noise to Noh shocktube.
- */
-
-#ifdef H_CORRECTION
-/* 
-#ifdef ISOTHERMAL
-    qa = Iso_csound;
-#else
-    qa = sqrt(Gamma*W[i+1].P/W[i+1].d);
-#endif
-    dWm[i+1][1] = SIGN(dWm[i+1][1])*MIN(fabs(dWm[i+1][1]),qa);
-*/
-#endif /* H_CORRECTION */
-/* 
-    qa = W[i+1].Vx*W[i+1].d - W[i  ].Vx*W[i  ].d;
-    qb = W[i+2].Vx*W[i+2].d - W[i+1].Vx*W[i+1].d;
-    qc = W[i+2].Vx*W[i+2].d - W[i  ].Vx*W[i  ].d;
-    qx = SIGN(qc)*MIN(2.0*MIN(fabs(qa),fabs(qb)), 0.5*fabs(qc));
-
-    if ((-W[i+1].Vx*dWm[i+1][0]) > 0.0) {
-      qa = 0.0;
-      qb = -W[i+1].Vx*dWm[i+1][0];
-    } else {
-      qa = -W[i+1].Vx*dWm[i+1][0];
-      qb = 0.0;
-    }
-    if (qx > 0.0) {
-      qb += qx;
-    } else {
-      qa += qx;
-    }
-    qa = qa/W[i+1].d;
-    qb = qb/W[i+1].d;
-
-    dWm[i+1][1] = MIN(dWm[i+1][1],qb);
-    dWm[i+1][1] = MAX(dWm[i+1][1],qa);
-*/
-/*--- Step 14. -----------------------------------------------------------------
- * Construct parabolic interpolant in primitive variables at left-interface
- * of cell i+1 ("W[i+1/2]", CW eqn 1.6) using linear TVD slopes at i and
- * i+1 computed in Steps 2-7.
- */
+/*--- Step 7. ------------------------------------------------------------------
+ * Compute L/R values in cells il-1:iu+1, then monotonize again (CW eqn 1.10),
+ * ensure they lie between neighboring cell-centered vals, and compute
+ * coefficients of interpolation parabolae (CW eqn 1.5) */
 
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
+  for (n=0; n<(NWAVE+NSCALARS); n++) {
+    pw = W1d[n];
+    pc = Wim1h[n];
+    pl = Wlv[n];
+    pr = Wrv[n];
+    for (i=il-1; i<=iu+1; i++) {
+      gamma_curv = 0.0;
 #ifdef CYLINDRICAL
-      if (dir==1) {
-        Wim1h[i+1][n] = (0.5*(pW[i+1][n]*r[i+1] + pW[i][n]*r[i]) 
-                      - (dWm[i+1][n]*r[i+1] - dWm[i][n]*r[i])/6.0)/ri[i+1];
-      }
-      else
+      if (dir==1) gamma_curv = dx/(6.0*r[i]);
 #endif
-      {
-        Wim1h[i+1][n] = 0.5*(pW[i+1][n]+pW[i][n]) - (dWm[i+1][n]-dWm[i][n])/6.0;
-      }
-    }
-
-/*--- Step 15. -----------------------------------------------------------------
- * Compute L/R values */
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      Wlv[n] = Wim1h[i  ][n];
-      Wrv[n] = Wim1h[i+1][n];
-    }
-
-/*--- Step 16. -----------------------------------------------------------------
- * Monotonize again (CW eqn 1.10), ensure they lie between neighboring
- * cell-centered vals */
-
-    gamma_curv = 0.0;
+      wc  = pw[i];
+      wlv = pc[i  ];
+      wrv = pc[i+1];
+
+      qa = (wrv-wc)*(wc-wlv);
+      qb = wrv-wlv;
+      qc = 6.0*(wc - 0.5*(wlv*(1.0-gamma_curv) + wrv*(1.0+gamma_curv)));
+      tl = (6.0*wc - wrv*(4.0+3.0*gamma_curv))/(2.0-3.0*gamma_curv);
+      tr = (6.0*wc - wlv*(4.0-3.0*gamma_curv))/(2.0+3.0*gamma_curv);
+      wl = ((qb*qc) > (qb*qb)) ? tl : wlv;
+      wr = ((qb*qc) > (qb*qb)) ? wrv : (((qb*qc) < -(qb*qb)) ? tr : wrv);
+      wl = (qa <= 0.0) ? wc : wl;
+      wr = (qa <= 0.0) ? wc : wr;
+
+      wl = MAX(MIN(wc,pw[i-1]),wl);
+      pl[i] = MIN(MAX(wc,pw[i-1]),wl);
+      wr = MAX(MIN(wc,pw[i+1]),wr);
+      pr[i] = MIN(MAX(wc,pw[i+1]),wr);
+    }
+
+    pc = dW[n];
+    pg = W6[n];
+    for (i=il-1; i<=iu+1; i++) {
+      gamma_curv = 0.0;
 #ifdef CYLINDRICAL
-    if (dir==1) gamma_curv = dx/(6.0*r[i]);
+      if (dir==1) gamma_curv = dx/(6.0*r[i]);
 #endif
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      qa = (Wrv[n]-pW[i][n])*(pW[i][n]-Wlv[n]);
-      qb = Wrv[n]-Wlv[n];
-      qc = 6.0*(pW[i][n] - 0.5*(Wlv[n]*(1.0-gamma_curv) + Wrv[n]*(1.0+gamma_curv)));
-      if (qa <= 0.0) {
-        Wlv[n] = pW[i][n];
-        Wrv[n] = pW[i][n];
-      } else if ((qb*qc) > (qb*qb)) {
-        Wlv[n] = (6.0*pW[i][n] - Wrv[n]*(4.0+3.0*gamma_curv))/(2.0-3.0*gamma_curv);
-      } else if ((qb*qc) < -(qb*qb)) {
-        Wrv[n] = (6.0*pW[i][n] - Wlv[n]*(4.0-3.0*gamma_curv))/(2.0+3.0*gamma_curv);
-      }
-    }
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      Wlv[n] = MAX(MIN(pW[i][n],pW[i-1][n]),Wlv[n]);
-      Wlv[n] = MIN(MAX(pW[i][n],pW[i-1][n]),Wlv[n]);
-      Wrv[n] = MAX(MIN(pW[i][n],pW[i+1][n]),Wrv[n]);
-      Wrv[n] = MIN(MAX(pW[i][n],pW[i+1][n]),Wrv[n]);
-    }
-
-/*--- Step 17. -----------------------------------------------------------------
- * Compute coefficients of interpolation parabolae (CW eqn 1.5) */
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      dW[n] = Wrv[n] - Wlv[n];
-      W6[n] = 6.0*(pW[i][n] - 0.5*(Wlv[n]*(1.0-gamma_curv) + Wrv[n]*(1.0+gamma_curv)));
+      pc[i] = pr[i] - pl[i];
+      pg[i] = 6.0*(pw[i] - 0.5*(pl[i]*(1.0-gamma_curv) + pr[i]*(1.0+gamma_curv)));
     }
+  }
 
-/*--- Step 18. -----------------------------------------------------------------
+/*--- Step 8. ------------------------------------------------------------------
  * Integrate linear interpolation function over domain of dependence defined by
- * max(min) eigenvalue (CW eqn 1.12)
+ * max(min) eigenvalue (CW eqn 1.12).  From here on Wrv holds W_{L,i+1/2} and
+ * Wlv holds W_{R,i-1/2}.
  */
 
-    pWl = (Real *) &(Wl[i+1]);
-    pWr = (Real *) &(Wr[i]);
-
-#ifndef CTU_INTEGRATOR 
-
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      pWl[n] = Wrv[n];
-      pWr[n] = Wlv[n];
-    }
+#ifdef CTU_INTEGRATOR /* include steps 8-9 only if using CTU integrator */
 
-#else /* include steps 18-19 only if using CTU integrator */
-
-    qx1  = 0.5*MAX(ev[NWAVE-1],0.0)*dtodx;
-    qxx1 = 0.0;
+  for (n=0; n<(NWAVE+NSCALARS); n++) {
+    pl = Wlv[n];
+    pr = Wrv[n];
+    pc = dW[n];
+    pg = W6[n];
+    pe = ev[0];
+    pw = ev[NWAVE-1];
+    for (i=il-1; i<=iu+1; i++) {
+      qx1  = 0.5*MAX(pw[i],0.0)*dtodx;
+      qxx1 = 0.0;
 #ifdef CYLINDRICAL
-    if (dir==1) 
-      qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
+      if (dir==1)
+        qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
 #endif
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      pWl[n] = Wrv[n] - qx1 *(dW[n] - (1.0-FOUR_3RDS*qx1)*W6[n])
-                      + qxx1*(dW[n] - (1.0-      2.0*qx1)*W6[n]);
-    }
+      pr[i] = pr[i] - qx1 *(pc[i] - (1.0-FOUR_3RDS*qx1)*pg[i])
+                    + qxx1*(pc[i] - (1.0-      2.0*qx1)*pg[i]);
 
-    qx2  = -0.5*MIN(ev[0],0.0)*dtodx;
-    qxx2 = 0.0;
+      qx2  = -0.5*MIN(pe[i],0.0)*dtodx;
+      qxx2 = 0.0;
 #ifdef CYLINDRICAL
-    if (dir==1) 
-      qxx2 = SQR(qx2)*dx/(3.0*(ri[i]+dx*qx2));
+      if (dir==1)
+        qxx2 = SQR(qx2)*dx/(3.0*(ri[i]+dx*qx2));
 #endif
-    for (n=0; n<(NWAVE+NSCALARS); n++) {
-      pWr[n] = Wlv[n] + qx2 *(dW[n] + (1.0-FOUR_3RDS*qx2)*W6[n])
-                      + qxx2*(dW[n] + (1.0-      2.0*qx2)*W6[n]);
+      pl[i] = pl[i] + qx2 *(pc[i] + (1.0-FOUR_3RDS*qx2)*pg[i])
+                    + qxx2*(pc[i] + (1.0-      2.0*qx2)*pg[i]);
     }
+  }
 
-
-/*--- Step 19. -----------------------------------------------------------------
- * Then subtract amount of each wave m that does not reach the interface
+/*--- Step 9. ------------------------------------------------------------------
+ * Then subtract amount of each wave n that does not reach the interface
  * during timestep (CW eqn 3.5ff).  For HLL fluxes, must subtract waves that
- * move in both directions, but only to 2nd order.
+ * move in both directions, but only to 2nd order.  Waves are subtracted only
+ * in cells where they move towards the interface, using a select so that the
+ * loop over i has no branches.
  */
 
-    for (n=0; n<NWAVE; n++) {
-      if (ev[n] >= 0.0) {
-        qa  = 0.0;
-        qx1 = 0.5*dtodx*ev[NWAVE-1];
-        qx2 = 0.5*dtodx*ev[n];
-        qb  = qx1 - qx2;
-        qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
+  for (n=0; n<NWAVE; n++) {
+    for (m=0; m<NWAVE; m++) {
+      lm[m] = lem[n*NWAVE+m];
+      rm[m] = rem[m*NWAVE+n];
+    }
+    pe = ev[n];
+SIMD_IVDEP
+    for (i=il-1; i<=iu+1; i++) {
+      qa  = 0.0;
+      qx1 = 0.5*dtodx*ev[NWAVE-1][i];
+      qx2 = 0.5*dtodx*pe[i];
+      qb  = qx1 - qx2;
+      qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
 #ifdef CYLINDRICAL
-        if (dir==1) {
-          qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
-          qxx2 = SQR(qx2)*dx/(3.0*(ri[i+1]-dx*qx2));
-          qb -= qxx1 - qxx2;
-          qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
-        }
+      if (dir==1) {
+        qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
+        qxx2 = SQR(qx2)*dx/(3.0*(ri[i+1]-dx*qx2));
+        qb -= qxx1 - qxx2;
+        qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
+      }
 #endif
-        for (m=0; m<NWAVE; m++) {
-          qa += lem[n][m]*(qb*(dW[m]-W6[m]) + qc*W6[m]);
-        }
-        for (m=0; m<NWAVE; m++) pWl[m] += qa*rem[m][n];
+      for (m=0; m<NWAVE; m++) {
+        qa += lm[m][i]*(qb*(dW[m][i]-W6[m][i]) + qc*W6[m][i]);
+      }
+      for (m=0; m<NWAVE; m++) {
+        wr = Wrv[m][i] + qa*rm[m][i];
+        Wrv[m][i] = (pe[i] >= 0.0) ? wr : Wrv[m][i];
+      }
 
 /* For HLL fluxes, subtract wave moving away from interface to 2nd order */
 #if defined(HLLE_FLUX) || defined(HLLC_FLUX) || defined(HLLD_FLUX) || defined(FORCE_FLUX)
-        qa  = 0.0;
-        qx1 = 0.5*dtodx*ev[0];
-        qx2 = 0.5*dtodx*ev[n];
+      qa  = 0.0;
+      qx1 = 0.5*dtodx*ev[0][i];
+      qx2 = 0.5*dtodx*pe[i];
 #ifdef CYLINDRICAL
-        if (dir==1) {
-          qx1 *= 1.0 - dx*qx1/(3.0*(ri[i+1]-dx*qx1));
-          qx2 *= 1.0 - dx*qx2/(3.0*(ri[i+1]-dx*qx2));
-        }
+      if (dir==1) {
+        qx1 *= 1.0 - dx*qx1/(3.0*(ri[i+1]-dx*qx1));
+        qx2 *= 1.0 - dx*qx2/(3.0*(ri[i+1]-dx*qx2));
+      }
 #endif
-        qx = qx1 - qx2;
-        for (m=0; m<NWAVE; m++) {
-          qa += lem[n][m]*qx*dW[m];
-        }
-        for (m=0; m<NWAVE; m++) pWr[m] += qa*rem[m][n];
-#endif /* HLL_FLUX */
-
+      qx = qx1 - qx2;
+      for (m=0; m<NWAVE; m++) {
+        qa += lm[m][i]*qx*dW[m][i];
       }
+      for (m=0; m<NWAVE; m++) {
+        wl = Wlv[m][i] + qa*rm[m][i];
+        Wlv[m][i] = (pe[i] >= 0.0) ? wl : Wlv[m][i];
+      }
+#endif /* HLL_FLUX */
     }
+  }
 
-    for (n=0; n<NWAVE; n++) {
-      if (ev[n] <= 0.0) {
-        qa = 0.0;
-        qx1 = 0.5*dtodx*ev[0];
-        qx2 = 0.5*dtodx*ev[n];
-        qb  = qx1 - qx2;
-        qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
+  for (n=0; n<NWAVE; n++) {
+    for (m=0; m<NWAVE; m++) {
+      lm[m] = lem[n*NWAVE+m];
+      rm[m] = rem[m*NWAVE+n];
+    }
+    pe = ev[n];
+SIMD_IVDEP
+    for (i=il-1; i<=iu+1; i++) {
+      qa  = 0.0;
+      qx1 = 0.5*dtodx*ev[0][i];
+      qx2 = 0.5*dtodx*pe[i];
+      qb  = qx1 - qx2;
+      qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
 #ifdef CYLINDRICAL
-        if (dir==1) {
-          qxx1 = SQR(qx1)*dx/(3.0*(r[i]-dx*qx1));
-          qxx2 = SQR(qx2)*dx/(3.0*(r[i]-dx*qx2));
-          qb -= qxx1 - qxx2;
-          qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
-        }
+      if (dir==1) {
+        qxx1 = SQR(qx1)*dx/(3.0*(r[i]-dx*qx1));
+        qxx2 = SQR(qx2)*dx/(3.0*(r[i]-dx*qx2));
+        qb -= qxx1 - qxx2;
+        qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
+      }
 #endif
-        for (m=0; m<NWAVE; m++) {
-          qa += lem[n][m]*(qb*(dW[m]+W6[m]) + qc*W6[m]);
-        }
-        for (m=0; m<NWAVE; m++) pWr[m] += qa*rem[m][n];
+      for (m=0; m<NWAVE; m++) {
+        qa += lm[m][i]*(qb*(dW[m][i]+W6[m][i]) + qc*W6[m][i]);
+      }
+      for (m=0; m<NWAVE; m++) {
+        wl = Wlv[m][i] + qa*rm[m][i];
+        Wlv[m][i] = (pe[i] <= 0.0) ? wl : Wlv[m][i];
+      }
 
 /* For HLL fluxes, subtract wave moving away from interface to 2nd order */
 #if defined(HLLE_FLUX) || defined(HLLC_FLUX) || defined(HLLD_FLUX) || defined(FORCE_FLUX)
-        qa = 0.0;
-        qx1 = 0.5*dtodx*ev[NWAVE-1];
-        qx2 = 0.5*dtodx*ev[n];
-#ifdef CYLINDRICAL 
-        if (dir==1) {
-          qx1 *= 1.0 - dx*qx1/(3.0*(ri[i]-dx*qx1));
-          qx2 *= 1.0 - dx*qx2/(3.0*(ri[i]-dx*qx2));
-        }
+      qa  = 0.0;
+      qx1 = 0.5*dtodx*ev[NWAVE-1][i];
+      qx2 = 0.5*dtodx*pe[i];
+#ifdef CYLINDRICAL
+      if (dir==1) {
+        qx1 *= 1.0 - dx*qx1/(3.0*(ri[i]-dx*qx1));
+        qx2 *= 1.0 - dx*qx2/(3.0*(ri[i]-dx*qx2));
+      }
 #endif
-        qx = qx1 - qx2;
-        for (m=0; m<NWAVE; m++) {
-          qa += lem[n][m]*qx*dW[m];
-        }
-        for (m=0; m<NWAVE; m++) pWl[m] += qa*rem[m][n];
-#endif /* HLL_FLUX */
-
+      qx = qx1 - qx2;
+      for (m=0; m<NWAVE; m++) {
+        qa += lm[m][i]*qx*dW[m][i];
+      }
+      for (m=0; m<NWAVE; m++) {
+        wr = Wrv[m][i] + qa*rm[m][i];
+        Wrv[m][i] = (pe[i] <= 0.0) ? wr : Wrv[m][i];
       }
+#endif /* HLL_FLUX */
     }
+  }
 
 /* Wave subtraction for passive scalars */
-    for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
-      if (W[i].Vx > 0.) {
-
-        qx1 = 0.5*dtodx*ev[NWAVE-1];
-        qx2 = 0.5*dtodx*W[i].Vx;
-        qb  = qx1 - qx2;
-        qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
+#if (NSCALARS > 0)
+  for (n=NWAVE; n<(NWAVE+NSCALARS); n++) {
+    pl = Wlv[n];
+    pr = Wrv[n];
+    pc = dW[n];
+    pg = W6[n];
+    for (i=il-1; i<=iu+1; i++) {
+      qx1 = 0.5*dtodx*ev[NWAVE-1][i];
+      qx2 = 0.5*dtodx*W1d[1][i];
+      qb  = qx1 - qx2;
+      qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
 #ifdef CYLINDRICAL
-        if (dir==1) {
-          qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
-          qxx2 = SQR(qx2)*dx/(3.0*(ri[i+1]-dx*qx2));
-          qb -= qxx1 - qxx2;
-          qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
-        }
+      if (dir==1) {
+        qxx1 = SQR(qx1)*dx/(3.0*(ri[i+1]-dx*qx1));
+        qxx2 = SQR(qx2)*dx/(3.0*(ri[i+1]-dx*qx2));
+        qb -= qxx1 - qxx2;
+        qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
+      }
 #endif
-        pWl[n] += qb*(dW[n]-W6[n]) + qc*W6[n];
-
-      } else if (W[i].Vx < 0.) {
+      wr = pr[i] + (qb*(pc[i]-pg[i]) + qc*pg[i]);
+      pr[i] = (W1d[1][i] > 0.) ? wr : pr[i];
 
-        qx1 = 0.5*dtodx*ev[0];
-        qx2 = 0.5*dtodx*W[i].Vx;
-        qb  = qx1 - qx2;
-        qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
+      qx1 = 0.5*dtodx*ev[0][i];
+      qx2 = 0.5*dtodx*W1d[1][i];
+      qb  = qx1 - qx2;
+      qc  = FOUR_3RDS*(SQR(qx1) - SQR(qx2));
 #ifdef CYLINDRICAL
-        if (dir==1) {
-          qxx1 = SQR(qx1)*dx/(3.0*(r[i]-dx*qx1));
-          qxx2 = SQR(qx2)*dx/(3.0*(r[i]-dx*qx2));
-          qb -= qxx1 - qxx2;
-          qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
-        }
-#endif
-        pWr[n] += qb*(dW[n]+W6[n]) + qc*W6[n];
-
+      if (dir==1) {
+        qxx1 = SQR(qx1)*dx/(3.0*(r[i]-dx*qx1));
+        qxx2 = SQR(qx2)*dx/(3.0*(r[i]-dx*qx2));
+        qb -= qxx1 - qxx2;
+        qc -= 2.0*(qx1*qxx1 - qx2*qxx2);
       }
+#endif
+      wl = pl[i] + (qb*(pc[i]+pg[i]) + qc*pg[i]);
+      pl[i] = (W1d[1][i] < 0.) ? wl : pl[i];
     }
+  }
+#endif /* NSCALARS */
 
 #endif /* CTU_INTEGRATOR */
 
-/*--- Step 20. -----------------------------------------------------------------
- * Save eigenvalues and eigenmatrices at i+1 for use in next iteration */
+/*--- Step 10. -----------------------------------------------------------------
+ * Store L/R states at interfaces:  W_{L,i+1/2} = Wrv(i), W_{R,i-1/2} = Wlv(i)
+ */
 
-    for (m=0; m<NWAVE; m++) {
-      ev[m] = ev_ip1[m];
-      for (n=0; n<NWAVE; n++) {
-        rem[m][n] = rem_ip1[m][n];
-        lem[m][n] = lem_ip1[m][n];
-      }
+  for (i=il-1; i<=iu+1; i++) {
+    pWl = (Real *) &(Wl[i+1]);
+    pWr = (Real *) &(Wr[i]);
+    for (n=0; n<(NWAVE+NSCALARS); n++) {
+      pWl[n] = Wrv[n][i];
+      pWr[n] = Wlv[n][i];
     }
-
-  } /*====================== END BIG LOOP OVER i =========================*/
+  }
 
   return;
 }
@@ -685,7 +532,8 @@ void lr_states(const GridS* pG __attribute__((unused)),
 
 void lr_states_init(MeshS *pM)
 {
-  int nmax,size1=0,size2=0,size3=0,nl,nd;
+  int nmax,size1=0,size2=0,size3=0,nl,nd,ierr=0;
+  const int nvar = NWAVE + NSCALARS;
 
 /* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
   for (nl=0; nl<(pM->NLevels); nl++){
@@ -709,13 +557,50 @@ void lr_states_init(MeshS *pM)
   size3 = size3 + 2*nghost;
   nmax = MAX((MAX(size1,size2)),size3);
 
-  if ((pW = (Real**)malloc(nmax*sizeof(Real*))) == NULL) goto on_error;
-
-  if ((dWm = (Real**)calloc_2d_array(nmax, (NWAVE + NSCALARS), sizeof(Real))) == NULL)
-    goto on_error;
-
-  if ((Wim1h = (Real**)calloc_2d_array(nmax, (NWAVE + NSCALARS), sizeof(Real))) == NULL)
-    goto on_error;
+/* Every OpenMP thread allocates its own private copy of the work arrays.  The
+ * eigenmatrices must be zeroed, since their zero elements are never set. */
+#ifdef OPENMP
+#pragma omp parallel reduction(+:ierr)
+#endif
+  {
+    if ((W1d = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((ev = (Real**)calloc_2d_array(NWAVE, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((rem = (Real**)calloc_2d_array(NWAVE*NWAVE, nmax, sizeof(Real)))
+        == NULL) ierr++;
+    if ((lem = (Real**)calloc_2d_array(NWAVE*NWAVE, nmax, sizeof(Real)))
+        == NULL) ierr++;
+    if ((dWc = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dWl = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dWr = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dWg = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dac = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dal = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dar = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dag = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dWm = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((Wim1h = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((Wlv = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((Wrv = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((dW = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+    if ((W6 = (Real**)calloc_2d_array(nvar, nmax, sizeof(Real))) == NULL)
+      ierr++;
+  }
+  if (ierr > 0) goto on_error;
 
   return;
   on_error:
@@ -729,9 +614,29 @@ void lr_states_init(MeshS *pM)
 
 void lr_states_destruct(void)
 {
-  if (pW != NULL) free(pW);
-  if (dWm != NULL) free_2d_array(dWm);
-  if (Wim1h != NULL) free_2d_array(Wim1h);
+#ifdef OPENMP
+#pragma omp parallel
+#endif
+  {
+    if (W1d != NULL) free_2d_array(W1d);
+    if (ev != NULL) free_2d_array(ev);
+    if (rem != NULL) free_2d_array(rem);
+    if (lem != NULL) free_2d_array(lem);
+    if (dWc != NULL) free_2d_array(dWc);
+    if (dWl != NULL) free_2d_array(dWl);
+    if (dWr != NULL) free_2d_array(dWr);
+    if (dWg != NULL) free_2d_array(dWg);
+    if (dac != NULL) free_2d_array(dac);
+    if (dal != NULL) free_2d_array(dal);
+    if (dar != NULL) free_2d_array(dar);
+    if (dag != NULL) free_2d_array(dag);
+    if (dWm != NULL) free_2d_array(dWm);
+    if (Wim1h != NULL) free_2d_array(Wim1h);
+    if (Wlv != NULL) free_2d_array(Wlv);
+    if (Wrv != NULL) free_2d_array(Wrv);
+    if (dW != NULL) free_2d_array(dW);
+    if (W6 != NULL) free_2d_array(W6);
+  }
   return;
 }
 
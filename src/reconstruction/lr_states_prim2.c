@@ -46,6 +46,12 @@ static Real **pW=NULL;
 #ifdef SPECIAL_RELATIVITY
 static Real **vel=NULL;
 #endif
+#ifdef OPENMP
+#pragma omp threadprivate(pW)
+#ifdef SPECIAL_RELATIVITY
+#pragma omp threadprivate(vel)
+#endif
+#endif
 
 /*----------------------------------------------------------------------------*/
 /*! \fn void lr_states(const GridS *pG, const Prim1DS W[], const Real Bxc[],
@@ -316,7 +322,7 @@ void lr_states(const GridS *pG __attribute((unused)),
 
 void lr_states_init(MeshS *pM)
 {
-  int nmax,size1=0,size2=0,size3=0,nl,nd,n4v=4;
+  int nmax,size1=0,size2=0,size3=0,nl,nd,ierr=0,n4v=4;
 
 /* Cycle over all Grids on this processor to find maximum Nx1, Nx2, Nx3 */
   for (nl=0; nl<(pM->NLevels); nl++){
@@ -340,11 +346,18 @@ void lr_states_init(MeshS *pM)
   size3 = size3 + 2*nghost;
   nmax = MAX((MAX(size1,size2)),size3);
 
-  if ((pW = (Real**)malloc(nmax*sizeof(Real*))) == NULL) goto on_error;
+/* Every OpenMP thread allocates its own private copy of the work arrays */
+#ifdef OPENMP
+#pragma omp parallel reduction(+:ierr)
+#endif
+  {
+    if ((pW = (Real**)malloc(nmax*sizeof(Real*))) == NULL) ierr++;
 #ifdef SPECIAL_RELATIVITY
-  if ((vel = (Real**)calloc_2d_array(nmax, n4v, sizeof(Real))) == NULL)
-    goto on_error;
+    if ((vel = (Real**)calloc_2d_array(nmax, n4v, sizeof(Real))) == NULL)
+      ierr++;
 #endif
+  }
+  if (ierr > 0) goto on_error;
 
   return;
   on_error:
@@ -358,10 +371,15 @@ void lr_states_init(MeshS *pM)
 
 void lr_states_destruct(void)
 {
-  if (pW != NULL) free(pW);
+#ifdef OPENMP
+#pragma omp parallel
+#endif
+  {
+    if (pW != NULL) free(pW);
 #ifdef SPECIAL_RELATIVITY
-  if (vel != NULL) free_2d_array(vel);
+    if (vel != NULL) free_2d_array(vel);
 #endif
+  }
   return;
 }
 
@@ -37,6 +37,33 @@ void esys_prim_adb_mhd(const Real d, const Real v1, const Real rho_a2,
   Real right_eigenmatrix[][7], Real left_eigenmatrix[][7]);
 #endif
 
+/* esystem_prim.c, pencil versions indexed [n][i] and [n*NWAVE+m][i] */
+#if defined(BAROTROPIC) && defined(HYDRO)
+void esys_prim_iso_hyd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix);
+#endif
+
+#if !defined(BAROTROPIC) && defined(HYDRO)
+void esys_prim_adb_hyd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real p[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix);
+#endif
+
+#if defined(BAROTROPIC) && defined(MHD)
+void esys_prim_iso_mhd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real b1[], const Real b2[],
+  const Real b3[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix);
+#endif
+
+#if !defined(BAROTROPIC) && defined(MHD)
+void esys_prim_adb_mhd_pencil(const int il, const int iu,
+  const Real d[], const Real v1[], const Real p[], const Real b1[],
+  const Real b2[], const Real b3[], Real **eigenvalues,
+  Real **right_eigenmatrix, Real **left_eigenmatrix);
+#endif
+
 /*  All of the lr_states_*.c files in this directory contain the same function
  *  names below */
 void lr_states_destruct(void);
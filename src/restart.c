@@ -59,6 +59,7 @@ void restart_grids(char *res_file, MeshS *pM)
   FILE *fp;
   char line[MAXLEN];
   int i,j,k,is,ie,js,je,ks,ke,nl,nd;
+  Real rval;  /* restart files hold Reals, also with --enable-mixed */
 #ifdef MHD
   int ib=0,jb=0,kb=0;
 #endif
@@ -136,7 +137,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->U[k][j][i].d),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            UVAR(pG->U,k,j,i,d) = rval;
           }
         }
       }
@@ -150,7 +152,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->U[k][j][i].M1),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            UVAR(pG->U,k,j,i,M1) = rval;
           }
         }
       }
@@ -164,7 +167,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->U[k][j][i].M2),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            UVAR(pG->U,k,j,i,M2) = rval;
           }
         }
       }
@@ -178,7 +182,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->U[k][j][i].M3),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            UVAR(pG->U,k,j,i,M3) = rval;
           }
         }
       }
@@ -193,7 +198,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->U[k][j][i].E),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            UVAR(pG->U,k,j,i,E) = rval;
           }
         }
       }
@@ -217,7 +223,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie+ib; i++) {
-            fread(&(pG->B1i[k][j][i]),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            pG->B1i[k][j][i] = rval;
           }
         }
       }
@@ -231,7 +238,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je+jb; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->B2i[k][j][i]),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            pG->B2i[k][j][i] = rval;
           }
         }
       }
@@ -245,7 +253,8 @@ void restart_grids(char *res_file, MeshS *pM)
       for (k=ks; k<=ke+kb; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            fread(&(pG->B3i[k][j][i]),sizeof(Real),1,fp);
+            fread(&rval,sizeof(Real),1,fp);
+            pG->B3i[k][j][i] = rval;
           }
         }
       }
@@ -259,11 +268,11 @@ void restart_grids(char *res_file, MeshS *pM)
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
 #if defined(CARTESIAN)
-          pG->U[k][j][i].B1c = 0.5*(pG->B1i[k][j][i] +pG->B1i[k][j][i+1]);
+          UVAR(pG->U,k,j,i,B1c) = 0.5*(pG->B1i[k][j][i] +pG->B1i[k][j][i+1]);
 #elif defined(CYLINDRICAL)
-          pG->U[k][j][i].B1c = 0.5*(pG->ri[i]*pG->B1i[k][j][i] + pG->ri[i+1]*pG->B1i[k][j][i+1])/pG->r[i];
+          UVAR(pG->U,k,j,i,B1c) = 0.5*(pG->ri[i]*pG->B1i[k][j][i] + pG->ri[i+1]*pG->B1i[k][j][i+1])/pG->r[i];
 #elif defined(SPHERICAL)
-          pG->U[k][j][i].B1c = ((pG->px1i[i+1]-pG->px1v[i])*pG->B1i[k][j][i] + (pG->px1v[i]-pG->px1i[i])*pG->B1i[k][j][i+1])/pG->dx1;
+          UVAR(pG->U,k,j,i,B1c) = ((pG->px1i[i+1]-pG->px1v[i])*pG->B1i[k][j][i] + (pG->px1v[i]-pG->px1i[i])*pG->B1i[k][j][i+1])/pG->dx1;
 #endif
         }}}
       }
@@ -271,7 +280,7 @@ void restart_grids(char *res_file, MeshS *pM)
         for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
-        pG->U[k][j][i].B1c = pG->B1i[k][j][i];
+        UVAR(pG->U,k,j,i,B1c) = pG->B1i[k][j][i];
         }}}
       }
       if(jb==1) {
@@ -279,9 +288,9 @@ void restart_grids(char *res_file, MeshS *pM)
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
 #ifdef SPHERICAL
-          pG->U[k][j][i].B2c = ((pG->px2i[j+1]-pG->px2v[j])*pG->B2i[k][j][i] + (pG->px2v[j]-pG->px2i[j])*pG->B2i[k][j+1][i])/pG->dx2;
+          UVAR(pG->U,k,j,i,B2c) = ((pG->px2i[j+1]-pG->px2v[j])*pG->B2i[k][j][i] + (pG->px2v[j]-pG->px2i[j])*pG->B2i[k][j+1][i])/pG->dx2;
 #else
-          pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i] +pG->B2i[k][j+1][i]);
+          UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i] +pG->B2i[k][j+1][i]);
 #endif
         }}}
       }
@@ -289,21 +298,21 @@ void restart_grids(char *res_file, MeshS *pM)
         for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
-          pG->U[k][j][i].B2c = pG->B2i[k][j][i];
+          UVAR(pG->U,k,j,i,B2c) = pG->B2i[k][j][i];
         }}}
       }
       if(kb==1) {
         for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
-          pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i] +pG->B3i[k+1][j][i]);
+          UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i] +pG->B3i[k+1][j][i]);
         }}}
       }
       else {
         for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
         for (i=is; i<=ie; i++) {
-          pG->U[k][j][i].B3c = pG->B3i[k][j][i];
+          UVAR(pG->U,k,j,i,B3c) = pG->B3i[k][j][i];
         }}}
       }
 #endif
@@ -321,7 +330,8 @@ void restart_grids(char *res_file, MeshS *pM)
         for (k=ks; k<=ke; k++) {
           for (j=js; j<=je; j++) {
             for (i=is; i<=ie; i++) {
-              fread(&(pG->U[k][j][i].s[n]),sizeof(Real),1,fp);
+              fread(&rval,sizeof(Real),1,fp);
+              UVAR(pG->U,k,j,i,s[n]) = rval;
             }
           }
         }
@@ -590,7 +600,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            buf[nbuf++] = pG->U[k][j][i].d;
+            buf[nbuf++] = UVAR(pG->U,k,j,i,d);
             if ((nbuf+1) > bufsize) {
               fwrite(buf,sizeof(Real),nbuf,fp);
               nbuf = 0;
@@ -609,7 +619,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            buf[nbuf++] = pG->U[k][j][i].M1;
+            buf[nbuf++] = UVAR(pG->U,k,j,i,M1);
             if ((nbuf+1) > bufsize) {
               fwrite(buf,sizeof(Real),nbuf,fp);
               nbuf = 0;
@@ -628,7 +638,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            buf[nbuf++] = pG->U[k][j][i].M2;
+            buf[nbuf++] = UVAR(pG->U,k,j,i,M2);
             if ((nbuf+1) > bufsize) {
               fwrite(buf,sizeof(Real),nbuf,fp);
               nbuf = 0;
@@ -647,7 +657,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            buf[nbuf++] = pG->U[k][j][i].M3;
+            buf[nbuf++] = UVAR(pG->U,k,j,i,M3);
             if ((nbuf+1) > bufsize) {
               fwrite(buf,sizeof(Real),nbuf,fp);
               nbuf = 0;
@@ -667,7 +677,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
       for (k=ks; k<=ke; k++) {
         for (j=js; j<=je; j++) {
           for (i=is; i<=ie; i++) {
-            buf[nbuf++] = pG->U[k][j][i].E;
+            buf[nbuf++] = UVAR(pG->U,k,j,i,E);
             if ((nbuf+1) > bufsize) {
               fwrite(buf,sizeof(Real),nbuf,fp);
               nbuf = 0;
@@ -754,7 +764,7 @@ void dump_restart(MeshS *pM, OutputS *pout)
         for (k=ks; k<=ke; k++) {
           for (j=js; j<=je; j++) {
             for (i=is; i<=ie; i++) {
-              buf[nbuf++] = pG->U[k][j][i].s[n];
+              buf[nbuf++] = UVAR(pG->U,k,j,i,s[n]);
               if ((nbuf+1) > bufsize) {
                 fwrite(buf,sizeof(Real),nbuf,fp);
                 nbuf = 0;
@@ -0,0 +1,604 @@
+#include "../copyright.h"
+#define MAIN_C
+/*============================================================================*/
+/*! \file bench_rsolvers.c
+ *  \brief Stand-alone benchmark and consistency check of the Riemann solvers.
+ *
+ * PURPOSE: Stand-alone benchmark and consistency check of the Riemann
+ *   solvers.  Built and run by "make bench-rsolvers", which compiles every
+ *   solver in this directory that supports the configured physics (gas, EOS,
+ *   special relativity, scalars, precision) with fluxes() and fluxes_pencil()
+ *   renamed to fluxes_<name>() and fluxes_pencil_<name>(), and defines
+ *   BENCH_<NAME> for each one that compiled.
+ *
+ *   Randomized but physically valid L/R states are generated from primitive
+ *   variables in five classes:
+ *   - uniform: identical L/R states, every solver must return the physical
+ *              flux, so all must agree to round-off
+ *   - smooth:  relative jumps of 1e-4, all solvers must agree to O(1e-4)
+ *   - random:  O(1) jumps in all variables
+ *   - shock:   pressure ratios up to 1e4 and colliding flows
+ *   - vacuum:  densities down to 1e-8 and diverging flows
+ *   For each solver the time per interface of fluxes() and fluxes_pencil() on
+ *   the random states is printed, with the largest difference from the HLLE
+ *   fluxes (or the first solver built) for each class, normalized by
+ *   |F| + (|Vx| + c)|U| on the side where this is larger, and the number
+ *   of non-finite fluxes.  Interfaces at which a solver calls ath_error()
+ *   (e.g. the exact solver with vacuum states) are counted as non-finite.
+ *
+ *   The run fails (exit status 1) if any solver gives a non-finite flux for
+ *   the uniform, smooth or random states, or differs from the reference by
+ *   more than the tolerance on the uniform or smooth states.
+ *
+ *   Usage: bench_rsolvers [n_interfaces [n_repeat [seed]]]
+ *
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - ran()          - uniform random number in [0,1)
+ * - ran_log()      - log-uniform random number in [lo,hi]
+ * - make_prim()    - random primitive state
+ * - make_states()  - random L/R states of one class
+ * - safe_flux()    - calls a solver, returning 1 if it calls ath_error()
+ * - cons_array()   - copies fluxes of conserved variables into an array
+ * - flux_scale()   - normalization of flux differences
+ * - wtime()        - wall time in seconds
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - ath_perr()  - discards warnings, since ath_log.c is not linked
+ * - ath_error() - returns to the harness if a solver fails, else prints error
+ *                 and exits, since utils.c is not linked
+ * - main()                                                                   */
+/*============================================================================*/
+
+#include <float.h>
+#include <math.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "../defs.h"
+#include "../athena.h"
+#include "../globals.h"
+#include "prototypes.h"
+#include "../prototypes.h"
+
+/* Only HLLE, HLLC, HLLD and the exact solver have relativistic versions (the
+ * *_sr.c files); the others compile with SPECIAL_RELATIVITY but are
+ * Newtonian, so they are left out.  Solver names get the suffix "_sr". */
+#ifdef SPECIAL_RELATIVITY
+#undef BENCH_ROE
+#undef BENCH_FORCE
+#undef BENCH_TWO_SHOCK
+#define SR_SUFFIX "_sr"
+#else
+#define SR_SUFFIX ""
+#endif
+
+/*! \fn void (*FluxFun_t)(const Cons1DS Ul, const Cons1DS Ur,
+ *                        const Prim1DS Wl, const Prim1DS Wr,
+ *                        const Real Bxi, Cons1DS *pF)
+ *  \brief Riemann solver at one interface */
+typedef void (*FluxFun_t)(const Cons1DS Ul, const Cons1DS Ur,
+                          const Prim1DS Wl, const Prim1DS Wr,
+                          const Real Bxi, Cons1DS *pF);
+/*! \fn void (*PencilFun_t)(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                          const Prim1DS *Wl, const Prim1DS *Wr,
+ *                          const Real *Bxi, Cons1DS *pF,
+ *                          const int il, const int iu)
+ *  \brief Riemann solver along a pencil */
+typedef void (*PencilFun_t)(const Cons1DS *Ul, const Cons1DS *Ur,
+                            const Prim1DS *Wl, const Prim1DS *Wr,
+                            const Real *Bxi, Cons1DS *pF,
+                            const int il, const int iu);
+
+#define BENCH_DECLARE(name) \
+void fluxes_##name(const Cons1DS Ul, const Cons1DS Ur, \
+                   const Prim1DS Wl, const Prim1DS Wr, \
+                   const Real Bxi, Cons1DS *pF); \
+void fluxes_pencil_##name(const Cons1DS *Ul, const Cons1DS *Ur, \
+                          const Prim1DS *Wl, const Prim1DS *Wr, \
+                          const Real *Bxi, Cons1DS *pF, \
+                          const int il, const int iu);
+
+#ifdef BENCH_HLLE
+BENCH_DECLARE(hlle)
+#endif
+#ifdef BENCH_HLLC
+BENCH_DECLARE(hllc)
+#endif
+#ifdef BENCH_HLLD
+BENCH_DECLARE(hlld)
+#endif
+#ifdef BENCH_ROE
+BENCH_DECLARE(roe)
+#endif
+#ifdef BENCH_FORCE
+BENCH_DECLARE(force)
+#endif
+#ifdef BENCH_EXACT
+BENCH_DECLARE(exact)
+#endif
+#ifdef BENCH_TWO_SHOCK
+BENCH_DECLARE(two_shock)
+#endif
+
+/*! \struct BenchSolverS
+ *  \brief Name and entry points of one solver */
+typedef struct BenchSolver_s{
+  const char *name;
+  FluxFun_t flux;
+  PencilFun_t pencil;
+}BenchSolverS;
+
+/* HLLE first, since it is the reference for the differences */
+static BenchSolverS solver[] = {
+#ifdef BENCH_HLLE
+  {"hlle" SR_SUFFIX, fluxes_hlle, fluxes_pencil_hlle},
+#endif
+#ifdef BENCH_HLLC
+  {"hllc" SR_SUFFIX, fluxes_hllc, fluxes_pencil_hllc},
+#endif
+#ifdef BENCH_HLLD
+  {"hlld" SR_SUFFIX, fluxes_hlld, fluxes_pencil_hlld},
+#endif
+#ifdef BENCH_ROE
+  {"roe" SR_SUFFIX, fluxes_roe, fluxes_pencil_roe},
+#endif
+#ifdef BENCH_FORCE
+  {"force" SR_SUFFIX, fluxes_force, fluxes_pencil_force},
+#endif
+#ifdef BENCH_EXACT
+  {"exact" SR_SUFFIX, fluxes_exact, fluxes_pencil_exact},
+#endif
+#ifdef BENCH_TWO_SHOCK
+  {"two_shock" SR_SUFFIX, fluxes_two_shock, fluxes_pencil_two_shock},
+#endif
+  {NULL, NULL, NULL}
+};
+
+/* classes of L/R states */
+enum {UNIFORM, SMOOTH, RANDOM, SHOCK, VACUUM, NCLASS};
+static const char *class_name[NCLASS] = {"uniform","smooth","random","shock",
+  "vacuum"};
+
+/* tolerances on normalized differences for the uniform and smooth classes */
+#ifdef SINGLE_PREC
+#define TOL_UNIFORM 1.0e-4
+#elif defined(SPECIAL_RELATIVITY)
+#define TOL_UNIFORM 1.0e-5   /* HLLD_SR finds the total pressure iteratively */
+#else
+#define TOL_UNIFORM 1.0e-10
+#endif
+#define SMOOTH_JUMP 1.0e-4
+#define TOL_SMOOTH  (20.0*SMOOTH_JUMP)
+
+/* maximum velocity, which must be < 1 with special relativity */
+#ifdef SPECIAL_RELATIVITY
+#define VMAX 0.9
+#else
+#define VMAX 2.0
+#endif
+
+/* number of conserved variables returned by cons_array() */
+#define NFLUX (NWAVE + NSCALARS)
+
+static unsigned long ran_state = 1;
+
+/* ath_error() jumps back to safe_flux() or the timing loop if catch_error=1 */
+static jmp_buf error_env;
+static int catch_error = 0;
+
+/*==============================================================================
+ * PRIVATE FUNCTION PROTOTYPES:
+ *============================================================================*/
+
+static double ran(void);
+static double ran_log(const double lo, const double hi);
+static void make_prim(Prim1DS *pW, const double d, const double P,
+                      const double vx, const double bscale);
+static void make_states(const int cls, const int n, Cons1DS *Ul, Cons1DS *Ur,
+                        Prim1DS *Wl, Prim1DS *Wr, Real *Bxi);
+static int safe_flux(const FluxFun_t flux, const Cons1DS *pUl,
+                     const Cons1DS *pUr, const Prim1DS *pWl,
+                     const Prim1DS *pWr, const Real Bxi, Cons1DS *pF);
+static int cons_array(const Cons1DS *pU, double *a);
+static double flux_scale(const Cons1DS *pF, const Cons1DS *pU,
+                         const Prim1DS *pW, const Real Bx);
+static double wtime(void);
+
+/*=========================== PUBLIC FUNCTIONS ===============================*/
+/*----------------------------------------------------------------------------*/
+/*! \fn int ath_perr(const int level, const char *fmt, ...)
+ *  \brief Discards warnings from the solvers (e.g. negative pressures in the
+ *   vacuum states), which would otherwise dominate the output and timings. */
+int ath_perr(const int level, const char *fmt, ...)
+{
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void ath_error(char *fmt, ...)
+ *  \brief Returns to the harness if called from a solver, otherwise prints
+ *   error message and exits. */
+void ath_error(char *fmt, ...)
+{
+  va_list ap;
+
+  if (catch_error) longjmp(error_env, 1);
+
+  fprintf(stderr,"### Fatal error: ");
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+
+  exit(EXIT_FAILURE);
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn int main(int argc, char *argv[])
+ *  \brief Runs all solvers on all classes of states, prints timings and
+ *   differences, and returns 1 if any check fails. */
+int main(int argc, char *argv[])
+{
+  int n=4096, nrep=50, nsolver, s, c, i, r, m, nfail=0;
+  Cons1DS *Ul=NULL, *Ur=NULL, *F0=NULL, *F=NULL;
+  Prim1DS *Wl=NULL, *Wr=NULL;
+  Real *Bxi=NULL;
+  volatile double tpoint, tpencil;
+  double t, diff, dmax[NCLASS], fa[NFLUX], fb[NFLUX];
+  int nbad[NCLASS];
+
+  if (argc > 1) n = atoi(argv[1]);
+  if (argc > 2) nrep = atoi(argv[2]);
+  if (argc > 3) ran_state = (unsigned long)atol(argv[3]);
+  if (n < 1 || nrep < 1) ath_error("usage: %s [n [nrep [seed]]]\n",argv[0]);
+
+#ifdef ISOTHERMAL
+  Iso_csound = 1.0;
+  Iso_csound2 = 1.0;
+#else
+  Gamma = 5.0/3.0;
+  Gamma_1 = Gamma - 1.0;
+  Gamma_2 = Gamma - 2.0;
+#endif
+
+  for (nsolver=0; solver[nsolver].name != NULL; nsolver++);
+  if (nsolver == 0) ath_error("[bench_rsolvers]: no solvers were built\n");
+
+  if ((Ul = (Cons1DS*)calloc(n,sizeof(Cons1DS))) == NULL) goto on_error;
+  if ((Ur = (Cons1DS*)calloc(n,sizeof(Cons1DS))) == NULL) goto on_error;
+  if ((Wl = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Wr = (Prim1DS*)calloc(n,sizeof(Prim1DS))) == NULL) goto on_error;
+  if ((Bxi = (Real*)calloc(n,sizeof(Real))) == NULL) goto on_error;
+  if ((F0 = (Cons1DS*)calloc(n,sizeof(Cons1DS))) == NULL) goto on_error;
+  if ((F = (Cons1DS*)calloc(n,sizeof(Cons1DS))) == NULL) goto on_error;
+
+  printf("Riemann solver benchmark: %d interfaces x %d repeats\n",n,nrep);
+  printf("Differences are max |F - F_%s|/(|F| + (|Vx| + c)|U|); "
+         "non-finite fluxes in ()\n\n",solver[0].name);
+  printf("%-10s %9s %9s","solver","ns/point","ns/pencil");
+  for (c=0; c<NCLASS; c++) printf(" %15s",class_name[c]);
+  printf("\n");
+
+  for (s=0; s<nsolver; s++) {
+    for (c=0; c<NCLASS; c++) {
+      dmax[c] = 0.0;
+      nbad[c] = 0;
+    }
+
+/* time fluxes() and fluxes_pencil() on the random states */
+
+    ran_state = ran_state*(unsigned long)(s+1) + 12345UL;
+    make_states(RANDOM, n, Ul, Ur, Wl, Wr, Bxi);
+    tpoint = tpencil = -1.0;
+    catch_error = 1;
+    if (setjmp(error_env) == 0) {
+      t = wtime();
+      for (r=0; r<nrep; r++) {
+        for (i=0; i<n; i++)
+          (*solver[s].flux)(Ul[i],Ur[i],Wl[i],Wr[i],Bxi[i],&F[i]);
+      }
+      tpoint = 1.0e9*(wtime() - t)/((double)n*(double)nrep);
+      t = wtime();
+      for (r=0; r<nrep; r++)
+        (*solver[s].pencil)(Ul,Ur,Wl,Wr,Bxi,F,0,n-1);
+      tpencil = 1.0e9*(wtime() - t)/((double)n*(double)nrep);
+    }
+    catch_error = 0;
+
+/* Compare with reference solver on the same states in every class.  The
+ * seed is reset so all solvers see identical states.  Interfaces where the
+ * reference fails are skipped. */
+
+    for (c=0; c<NCLASS; c++) {
+      ran_state = 1000UL + (unsigned long)c;
+      make_states(c, n, Ul, Ur, Wl, Wr, Bxi);
+      for (i=0; i<n; i++) {
+        if (safe_flux(solver[0].flux,&Ul[i],&Ur[i],&Wl[i],&Wr[i],Bxi[i],
+                      &F0[i]) != 0) continue;
+        if (safe_flux(solver[s].flux,&Ul[i],&Ur[i],&Wl[i],&Wr[i],Bxi[i],
+                      &F[i]) != 0) {
+          nbad[c]++;
+          continue;
+        }
+        cons_array(&F0[i], fb);
+        cons_array(&F[i], fa);
+        diff = 0.0;
+        for (m=0; m<NFLUX; m++) diff += fabs(fa[m] - fb[m]);
+        diff /= MAX(flux_scale(&F0[i], &Ul[i], &Wl[i], Bxi[i]),
+                    flux_scale(&F0[i], &Ur[i], &Wr[i], Bxi[i]));
+        if (diff > dmax[c]) dmax[c] = diff;
+      }
+    }
+
+    if (tpoint < 0.0)
+      printf("%-10s %9s %9s",solver[s].name,"failed","failed");
+    else
+      printf("%-10s %9.1f %9.1f",solver[s].name,tpoint,tpencil);
+    for (c=0; c<NCLASS; c++) printf(" %9.2e (%3d)",dmax[c],nbad[c]);
+    printf("\n");
+
+    for (c=0; c<=RANDOM; c++) {
+      if (nbad[c] > 0) {
+        printf("  FAIL: %s gives non-finite fluxes for %s states\n",
+               solver[s].name,class_name[c]);
+        nfail++;
+      }
+    }
+    if (dmax[UNIFORM] > TOL_UNIFORM) {
+      printf("  FAIL: %s differs from %s by %e > %e for uniform states\n",
+             solver[s].name,solver[0].name,dmax[UNIFORM],TOL_UNIFORM);
+      nfail++;
+    }
+    if (dmax[SMOOTH] > TOL_SMOOTH) {
+      printf("  FAIL: %s differs from %s by %e > %e for smooth states\n",
+             solver[s].name,solver[0].name,dmax[SMOOTH],TOL_SMOOTH);
+      nfail++;
+    }
+  }
+
+  printf("\n%s\n", nfail ? "bench-rsolvers: FAILED" : "bench-rsolvers: OK");
+
+  free(Ul);  free(Ur);  free(Wl);  free(Wr);  free(Bxi);
+  free(F0);  free(F);
+  return (nfail ? 1 : 0);
+
+  on_error:
+  ath_error("[bench_rsolvers]: malloc returned a NULL pointer\n");
+  return 1;
+}
+
+/*=========================== PRIVATE FUNCTIONS ==============================*/
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double ran(void)
+ *  \brief Uniform random number in [0,1) from a 32-bit LCG, so that the
+ *   states are the same on every machine. */
+static double ran(void)
+{
+  ran_state = (1664525UL*ran_state + 1013904223UL) & 0xffffffffUL;
+  return (double)ran_state/4294967296.0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double ran_log(const double lo, const double hi)
+ *  \brief Log-uniform random number in [lo,hi]. */
+static double ran_log(const double lo, const double hi)
+{
+  return lo*exp(log(hi/lo)*ran());
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void make_prim(Prim1DS *pW, const double d, const double P,
+ *                            const double vx, const double bscale)
+ *  \brief Sets primitive state with density d, pressure P (ignored if
+ *   isothermal), normal velocity vx, random transverse velocities, and
+ *   random transverse fields of magnitude bscale*sqrt(P). */
+static void make_prim(Prim1DS *pW, const double d, const double P,
+                      const double vx, const double bscale)
+{
+  double vt = VMAX - fabs(vx);
+#if (NSCALARS > 0)
+  int n;
+#endif
+
+  pW->d  = d;
+  pW->Vx = vx;
+  pW->Vy = 0.7*vt*(2.0*ran() - 1.0);
+  pW->Vz = 0.7*vt*(2.0*ran() - 1.0);
+#ifndef ISOTHERMAL
+  pW->P  = P;
+#endif
+#ifdef MHD
+  pW->By = bscale*sqrt(P)*(2.0*ran() - 1.0);
+  pW->Bz = bscale*sqrt(P)*(2.0*ran() - 1.0);
+#endif
+#if (NSCALARS > 0)
+  for (n=0; n<NSCALARS; n++) pW->r[n] = ran();
+#endif
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void make_states(const int cls, const int n, Cons1DS *Ul,
+ *                              Cons1DS *Ur, Prim1DS *Wl, Prim1DS *Wr,
+ *                              Real *Bxi)
+ *  \brief Fills n L/R states of class cls; conserved variables are computed
+ *   from the primitives with Prim1D_to_Cons1D(). */
+static void make_states(const int cls, const int n, Cons1DS *Ul, Cons1DS *Ur,
+                        Prim1DS *Wl, Prim1DS *Wr, Real *Bxi)
+{
+  int i;
+  double dl, dr, pl, pr, vl, vr, b = 1.0, eps;
+  Real Bx;
+  Prim1DS W;
+
+  for (i=0; i<n; i++) {
+    switch (cls) {
+    case SHOCK:
+      dl = ran_log(1.0,10.0);       pl = ran_log(1.0e2,1.0e4);
+      dr = ran_log(0.01,1.0);       pr = ran_log(1.0e-2,1.0);
+      vl = 0.5*VMAX*ran();          vr = -0.5*VMAX*ran();
+      break;
+    case VACUUM:
+      dl = ran_log(1.0e-8,1.0e-4);  pl = dl*ran_log(1.0e-2,1.0);
+      dr = (ran() < 0.5) ? ran_log(1.0e-8,1.0e-4) : ran_log(0.1,1.0);
+      pr = dr*ran_log(1.0e-2,1.0);
+      vl = -0.5*VMAX*ran();         vr = 0.5*VMAX*ran();
+      b = 0.1;
+      break;
+    default:
+      dl = ran_log(0.1,10.0);       pl = ran_log(0.1,10.0);
+      dr = ran_log(0.1,10.0);       pr = ran_log(0.1,10.0);
+      vl = 0.5*VMAX*(2.0*ran() - 1.0);
+      vr = 0.5*VMAX*(2.0*ran() - 1.0);
+      break;
+    }
+#ifdef ISOTHERMAL
+    pl = dl*Iso_csound2;
+    pr = dr*Iso_csound2;
+#endif
+
+/* swap sides at random so both orientations are tested */
+    if (cls != RANDOM && ran() < 0.5) {
+      eps = dl; dl = dr; dr = eps;
+      eps = pl; pl = pr; pr = eps;
+      eps = vl; vl = -vr; vr = -eps;
+    }
+
+    Bx = 0.0;
+#ifdef MHD
+    Bx = b*sqrt(0.5*(pl + pr))*(2.0*ran() - 1.0);
+#endif
+    make_prim(&Wl[i], dl, pl, vl, b);
+
+    if (cls == UNIFORM || cls == SMOOTH) {
+      W = Wl[i];
+      if (cls == SMOOTH) {
+        eps = SMOOTH_JUMP;
+        W.d  *= 1.0 + eps*(2.0*ran() - 1.0);
+        W.Vx += eps*VMAX*(2.0*ran() - 1.0);
+        W.Vy += eps*VMAX*(2.0*ran() - 1.0);
+        W.Vz += eps*VMAX*(2.0*ran() - 1.0);
+#ifndef ISOTHERMAL
+        W.P  *= 1.0 + eps*(2.0*ran() - 1.0);
+#endif
+#ifdef MHD
+        W.By += eps*sqrt(pl)*(2.0*ran() - 1.0);
+        W.Bz += eps*sqrt(pl)*(2.0*ran() - 1.0);
+#endif
+      }
+      Wr[i] = W;
+    } else {
+      make_prim(&Wr[i], dr, pr, vr, b);
+    }
+
+    Bxi[i] = Bx;
+    Ul[i] = Prim1D_to_Cons1D(&Wl[i], &Bx);
+    Ur[i] = Prim1D_to_Cons1D(&Wr[i], &Bx);
+  }
+
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int safe_flux(const FluxFun_t flux, const Cons1DS *pUl,
+ *                           const Cons1DS *pUr, const Prim1DS *pWl,
+ *                           const Prim1DS *pWr, const Real Bxi, Cons1DS *pF)
+ *  \brief Calls flux() at one interface.  Returns 1 if the solver called
+ *   ath_error() or any component of the flux is not finite, else 0. */
+static int safe_flux(const FluxFun_t flux, const Cons1DS *pUl,
+                     const Cons1DS *pUr, const Prim1DS *pWl,
+                     const Prim1DS *pWr, const Real Bxi, Cons1DS *pF)
+{
+  double a[NFLUX];
+  int m;
+
+  catch_error = 1;
+  if (setjmp(error_env) != 0) {
+    catch_error = 0;
+    return 1;
+  }
+  (*flux)(*pUl,*pUr,*pWl,*pWr,Bxi,pF);
+  catch_error = 0;
+
+  cons_array(pF, a);
+  for (m=0; m<NFLUX; m++) {
+    if (!(fabs(a[m]) <= DBL_MAX)) return 1;
+  }
+
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static int cons_array(const Cons1DS *pU, double *a)
+ *  \brief Copies the NFLUX evolved components of pU into a[]. */
+static int cons_array(const Cons1DS *pU, double *a)
+{
+  int m=0;
+#if (NSCALARS > 0)
+  int n;
+#endif
+
+  a[m++] = pU->d;
+  a[m++] = pU->Mx;
+  a[m++] = pU->My;
+  a[m++] = pU->Mz;
+#ifndef BAROTROPIC
+  a[m++] = pU->E;
+#endif
+#ifdef MHD
+  a[m++] = pU->By;
+  a[m++] = pU->Bz;
+#endif
+#if (NSCALARS > 0)
+  for (n=0; n<NSCALARS; n++) a[m++] = pU->s[n];
+#endif
+
+  return m;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double flux_scale(const Cons1DS *pF, const Cons1DS *pU,
+ *                               const Prim1DS *pW, const Real Bx)
+ *  \brief Returns |F| + (|Vx| + c)|U|, with c an upper bound on the fast
+ *   speed, used to normalize differences between fluxes. */
+static double flux_scale(const Cons1DS *pF, const Cons1DS *pU,
+                         const Prim1DS *pW, const Real Bx)
+{
+  double f[NFLUX], u[NFLUX], sf=0.0, su=0.0, c2;
+  int m;
+
+#ifdef ISOTHERMAL
+  c2 = Iso_csound2;
+#else
+  c2 = Gamma*pW->P/pW->d;
+#endif
+#ifdef MHD
+  c2 += (Bx*Bx + pW->By*pW->By + pW->Bz*pW->Bz)/pW->d;
+#endif
+#ifdef SPECIAL_RELATIVITY
+  c2 = 1.0;
+#endif
+
+  cons_array(pF, f);
+  cons_array(pU, u);
+  for (m=0; m<NFLUX; m++) {
+    sf += fabs(f[m]);
+    su += fabs(u[m]);
+  }
+
+  return sf + (fabs(pW->Vx) + sqrt(c2))*su + TINY_NUMBER;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static double wtime(void)
+ *  \brief Returns wall time in seconds. */
+static double wtime(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv,NULL);
+  return (double)tv.tv_sec + 1.0e-6*(double)tv.tv_usec;
+}
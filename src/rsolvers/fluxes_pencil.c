@@ -0,0 +1,57 @@
+#include "../copyright.h"
+/*============================================================================*/
+/*! \file fluxes_pencil.c
+ *  \brief Generic pencil interface to the Riemann solvers.
+ *
+ * PURPOSE: Computes the fluxes at every interface of a 1D pencil by calling
+ *   fluxes() once per interface.  Used for the Riemann solvers that do not
+ *   provide their own fluxes_pencil(), which currently are all solvers except
+ *   the non-relativistic HLLE, HLLC and HLLD fluxes.
+ *
+ * CONTAINS PUBLIC FUNCTIONS:
+ * - fluxes_pencil() - fluxes at every interface of a 1D pencil */
+/*============================================================================*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../defs.h"
+#include "../athena.h"
+#include "../globals.h"
+#include "prototypes.h"
+#include "../prototypes.h"
+
+#if defined(SPECIAL_RELATIVITY) || \
+   !(defined(HLLE_FLUX) || defined(HLLC_FLUX) || defined(HLLD_FLUX))
+/*----------------------------------------------------------------------------*/
+/*! \fn void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                   const Prim1DS *Wl, const Prim1DS *Wr,
+ *                   const Real *Bxi, Cons1DS *pFlux,
+ *                   const int il, const int iu)
+ *  \brief Computes 1D fluxes at interfaces il..iu of a pencil.
+ *   Input Arguments:
+ *   - Bxi = B in direction of 1D slice at cell interfaces (MHD only)
+ *   - Ul,Ur = L/R-states of CONSERVED variables at cell interfaces
+ *   - Wl,Wr = L/R-states of PRIMITIVE variables at cell interfaces
+ *   Output Arguments:
+ *   - pFlux = fluxes of CONSERVED variables at cell interfaces
+ */
+
+void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                   const Prim1DS *Wl, const Prim1DS *Wr,
+                   const Real *Bxi, Cons1DS *pFlux,
+                   const int il, const int iu)
+{
+  int i;
+  Real Bx = 0.0;
+
+  for (i=il; i<=iu; i++) {
+#ifdef MHD
+    Bx = Bxi[i];
+#endif
+    fluxes(Ul[i],Ur[i],Wl[i],Wr[i],Bx,&pFlux[i]);
+  }
+
+  return;
+}
+#endif
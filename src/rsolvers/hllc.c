@@ -17,7 +17,8 @@
  *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - fluxes() - all Riemann solvers in Athena must have this function name and
- *              use the same argument list as defined in rsolvers/prototypes.h*/
+ *              use the same argument list as defined in rsolvers/prototypes.h
+ * - fluxes_pencil() - fluxes at every interface of a 1D pencil */
 /*============================================================================*/
 
 #include <math.h>
@@ -51,39 +52,57 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
             const Prim1DS Wl, const Prim1DS Wr,
             const Real Bxi, Cons1DS *pFlux)
 {
-  Real sqrtdl,sqrtdr,isdlpdr,droe,v1roe,v2roe,v3roe;
-#ifndef BAROTROPIC
-  Real hroe;
+  fluxes_pencil(&Ul,&Ur,&Wl,&Wr,&Bxi,pFlux,0,0);
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                   const Prim1DS *Wl, const Prim1DS *Wr,
+ *                   const Real *Bxi, Cons1DS *pFlux,
+ *                   const int il, const int iu)
+ *  \brief Computes 1D fluxes at interfaces il..iu of a pencil.
+ *
+ * The Roe eigenvalues are evaluated inline and the flux weights of step 6 are
+ * selects rather than branches, so the loop body is straight-line code
+ * except in cylindrical coordinates.  A negative contact pressure is
+ * reported once per pencil.
+ *   Input Arguments:
+ *   - Ul,Ur = L/R-states of CONSERVED variables at cell interfaces
+ *   - Wl,Wr = L/R-states of PRIMITIVE variables at cell interfaces
+ *   Output Arguments:
+ *   - pFlux = fluxes of CONSERVED variables at cell interfaces
+ */
+
+void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                   const Prim1DS *Wl, const Prim1DS *Wr,
+                   const Real *Bxi, Cons1DS *pFlux,
+                   const int il, const int iu)
+{
+  Real sqrtdl,sqrtdr,isdlpdr,v1roe,cfroe;
+#ifndef ISOTHERMAL
+  Real v2roe,v3roe,hroe,vsq;
 #endif
-  Real ev[NWAVE];
   Real *pFl, *pFr, *pF;
   Cons1DS Fl,Fr;
-  int n;
+  int i,n;
   Real cfl,cfr,bp,bm,tmp;
   Real al,ar; /* Min and Max wave speeds */
   Real am,cp; /* Contact wave speed and pressure */
   Real tl,tr,dl,dr,sl,sm,sr;
+  Real cpmin=0.0;
 
-/*--- Step 1. ------------------------------------------------------------------
- * Convert left- and right- states in conserved to primitive variables.
- */
-/*
-  pbl = Cons1D_to_Prim1D(&Ul,&Wl,&Bxi);
-  pbr = Cons1D_to_Prim1D(&Ur,&Wr,&Bxi);
-*/
+  for (i=il; i<=iu; i++) {
 
-/*--- Step 2. ------------------------------------------------------------------
+/*--- Step 1. ------------------------------------------------------------------
  * Compute Roe-averaged data from left- and right-states
  */
 
-  sqrtdl = sqrt((double)Wl.d);
-  sqrtdr = sqrt((double)Wr.d);
-  isdlpdr = 1.0/(sqrtdl + sqrtdr);
+    sqrtdl = sqrt((double)Wl[i].d);
+    sqrtdr = sqrt((double)Wr[i].d);
+    isdlpdr = 1.0/(sqrtdl + sqrtdr);
 
-  droe  = sqrtdl*sqrtdr;
-  v1roe = (sqrtdl*Wl.Vx + sqrtdr*Wr.Vx)*isdlpdr;
-  v2roe = (sqrtdl*Wl.Vy + sqrtdr*Wr.Vy)*isdlpdr;
-  v3roe = (sqrtdl*Wl.Vz + sqrtdr*Wr.Vz)*isdlpdr;
+    v1roe = (sqrtdl*Wl[i].Vx + sqrtdr*Wr[i].Vx)*isdlpdr;
 
 /*
  * Following Roe(1981), the enthalpy H=(E+P)/d is averaged for adiabatic flows,
@@ -91,159 +110,150 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  */
 
 #ifndef ISOTHERMAL
-  hroe = ((Ul.E + Wl.P)/sqrtdl + (Ur.E + Wr.P)/sqrtdr)*isdlpdr;
+    v2roe = (sqrtdl*Wl[i].Vy + sqrtdr*Wr[i].Vy)*isdlpdr;
+    v3roe = (sqrtdl*Wl[i].Vz + sqrtdr*Wr[i].Vz)*isdlpdr;
+    hroe = ((Ul[i].E + Wl[i].P)/sqrtdl + (Ur[i].E + Wr[i].P)/sqrtdr)*isdlpdr;
 #endif
 
-/*--- Step 3. ------------------------------------------------------------------
- * Compute eigenvalues using Roe-averaged values
+/*--- Step 2. ------------------------------------------------------------------
+ * Compute the fastest Roe eigenvalues, using the same expressions as
+ * esys_roe_*_hyd() in esystem_roe.c
  */
 
 #ifdef ISOTHERMAL
-  esys_roe_iso_hyd(v1roe, v2roe, v3roe, ev, NULL, NULL);
+    cfroe = Iso_csound;
 #else
-  esys_roe_adb_hyd(v1roe, v2roe, v3roe, hroe, ev, NULL, NULL);
+    vsq = v1roe*v1roe + v2roe*v2roe + v3roe*v3roe;
+    cfroe = sqrt(Gamma_1*MAX((hroe-0.5*vsq), TINY_NUMBER));
 #endif /* ISOTHERMAL */
 
-/*--- Step 4. ------------------------------------------------------------------
+/*--- Step 3. ------------------------------------------------------------------
  * Compute the max and min wave speeds
  */
 
 #ifdef ISOTHERMAL
-  cfl = cfr = Iso_csound;
+    cfl = cfr = Iso_csound;
 #else
-  cfl = sqrt((double)(Gamma*Wl.P/Wl.d));
-  cfr = sqrt((double)(Gamma*Wr.P/Wr.d));
+    cfl = sqrt((double)(Gamma*Wl[i].P/Wl[i].d));
+    cfr = sqrt((double)(Gamma*Wr[i].P/Wr[i].d));
 #endif
 
-  ar = MAX(ev[NWAVE-1],(Wr.Vx + cfr));
-  al = MIN(ev[0]      ,(Wl.Vx - cfl));
+    ar = MAX((v1roe + cfroe),(Wr[i].Vx + cfr));
+    al = MIN((v1roe - cfroe),(Wl[i].Vx - cfl));
 
-  bp = ar > 0.0 ? ar : 0.0;
-  bm = al < 0.0 ? al : 0.0;
+    bp = ar > 0.0 ? ar : 0.0;
+    bm = al < 0.0 ? al : 0.0;
 
-/*--- Step 5. ------------------------------------------------------------------
+/*--- Step 4. ------------------------------------------------------------------
  * Compute the contact wave speed and Pressure
  */
 
 #ifdef ISOTHERMAL
-  tl = Wl.d*Iso_csound2 + (Wl.Vx - al)*Ul.Mx;
-  tr = Wr.d*Iso_csound2 + (Wr.Vx - ar)*Ur.Mx;
+    tl = Wl[i].d*Iso_csound2 + (Wl[i].Vx - al)*Ul[i].Mx;
+    tr = Wr[i].d*Iso_csound2 + (Wr[i].Vx - ar)*Ur[i].Mx;
 #else
-  tl = Wl.P + (Wl.Vx - al)*Ul.Mx;
-  tr = Wr.P + (Wr.Vx - ar)*Ur.Mx;
+    tl = Wl[i].P + (Wl[i].Vx - al)*Ul[i].Mx;
+    tr = Wr[i].P + (Wr[i].Vx - ar)*Ur[i].Mx;
 #endif
 
-  dl =   Ul.Mx - Ul.d*al;
-  dr = -(Ur.Mx - Ur.d*ar);
+    dl =   Ul[i].Mx - Ul[i].d*al;
+    dr = -(Ur[i].Mx - Ur[i].d*ar);
 
-  tmp = 1.0/(dl + dr);
+    tmp = 1.0/(dl + dr);
 /* Determine the contact wave speed... */
-  am = (tl - tr)*tmp;
+    am = (tl - tr)*tmp;
 /* ...and the pressure at the contact surface */
-  cp = (dl*tr + dr*tl)*tmp;
-  if(cp < 0.0) ath_perr(1,"[hllc flux]: Contact Pressure = %g\n",cp);
-  cp = cp > 0.0 ? cp : 0.0;
+    cp = (dl*tr + dr*tl)*tmp;
+    cpmin = MIN(cpmin,cp);
+    cp = cp > 0.0 ? cp : 0.0;
 
-/*--- Step 6. ------------------------------------------------------------------
+/*--- Step 5. ------------------------------------------------------------------
  * Compute L/R fluxes along the line bm, bp
  */
 
-  Fl.d  = Ul.Mx - bm*Ul.d;
-  Fr.d  = Ur.Mx - bp*Ur.d;
+    Fl.d  = Ul[i].Mx - bm*Ul[i].d;
+    Fr.d  = Ur[i].Mx - bp*Ur[i].d;
 
-  Fl.Mx = Ul.Mx*(Wl.Vx - bm);
-  Fr.Mx = Ur.Mx*(Wr.Vx - bp);
+    Fl.Mx = Ul[i].Mx*(Wl[i].Vx - bm);
+    Fr.Mx = Ur[i].Mx*(Wr[i].Vx - bp);
 
-  Fl.My = Ul.My*(Wl.Vx - bm);
-  Fr.My = Ur.My*(Wr.Vx - bp);
+    Fl.My = Ul[i].My*(Wl[i].Vx - bm);
+    Fr.My = Ur[i].My*(Wr[i].Vx - bp);
 
-  Fl.Mz = Ul.Mz*(Wl.Vx - bm);
-  Fr.Mz = Ur.Mz*(Wr.Vx - bp);
+    Fl.Mz = Ul[i].Mz*(Wl[i].Vx - bm);
+    Fr.Mz = Ur[i].Mz*(Wr[i].Vx - bp);
 
 #ifdef ISOTHERMAL
-  Fl.Mx += Wl.d*Iso_csound2;
-  Fr.Mx += Wr.d*Iso_csound2;
+    Fl.Mx += Wl[i].d*Iso_csound2;
+    Fr.Mx += Wr[i].d*Iso_csound2;
 #else
-  Fl.Mx += Wl.P;
-  Fr.Mx += Wr.P;
+    Fl.Mx += Wl[i].P;
+    Fr.Mx += Wr[i].P;
 
-  Fl.E  = Ul.E*(Wl.Vx - bm) + Wl.P*Wl.Vx;
-  Fr.E  = Ur.E*(Wr.Vx - bp) + Wr.P*Wr.Vx;
+    Fl.E  = Ul[i].E*(Wl[i].Vx - bm) + Wl[i].P*Wl[i].Vx;
+    Fr.E  = Ur[i].E*(Wr[i].Vx - bp) + Wr[i].P*Wr[i].Vx;
 #endif /* ISOTHERMAL */
 
-#if (NSCALARS > 0)
-  for (n=0; n<NSCALARS; n++) {
-    Fl.s[n] = Fl.d*Wl.r[n];
-    Fr.s[n] = Fr.d*Wr.r[n];
-  }
-#endif
-
-/*--- Step 7. ------------------------------------------------------------------
+/*--- Step 6. ------------------------------------------------------------------
  * Compute flux weights or scales
  */
 
-  if (am >= 0.0) {
-    sl =  am/(am - bm);
-    sr = 0.0;
-    sm = -bm/(am - bm);
-  }
-  else {
-    sl =  0.0;
-    sr = -am/(bp - am);
-    sm =  bp/(bp - am);
-  }
+    sl = am >= 0.0 ?  am/(am - bm) : 0.0;
+    sr = am >= 0.0 ?  0.0          : -am/(bp - am);
+    sm = am >= 0.0 ? -bm/(am - bm) : bp/(bp - am);
 
-/*--- Step 8. ------------------------------------------------------------------
+/*--- Step 7. ------------------------------------------------------------------
  * Compute the HLLC flux at interface
  */
-  pFl = (Real *)&(Fl);
-  pFr = (Real *)&(Fr);
-  pF  = (Real *)pFlux;
-  for (n=0; n<NWAVE; n++) pF[n] = sl*pFl[n] + sr*pFr[n];
+    pFl = (Real *)&(Fl);
+    pFr = (Real *)&(Fr);
+    pF  = (Real *)&(pFlux[i]);
+    for (n=0; n<NWAVE; n++) pF[n] = sl*pFl[n] + sr*pFr[n];
 
 /* Add the weighted contribution of the flux along the contact */
-  pFlux->Mx += sm*cp;
+    pFlux[i].Mx += sm*cp;
 #ifndef ISOTHERMAL
-  pFlux->E  += sm*cp*am;
+    pFlux[i].E  += sm*cp*am;
 #endif /* ISOTHERMAL */
 
 /* Fluxes of passively advected scalars, computed from density flux */
 #if (NSCALARS > 0)
-  if (pFlux->d >= 0.0) {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl.r[n];
-  } else {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr.r[n];
-  }
+    for (n=0; n<NSCALARS; n++) {
+      pFlux[i].s[n] = pFlux[i].d*(pFlux[i].d >= 0.0 ? Wl[i].r[n] : Wr[i].r[n]);
+    }
 #endif
 
 #ifdef CYLINDRICAL
-  if (al > 0.0) {
+    if (al > 0.0) {
 #ifndef ISOTHERMAL
-    pFlux->Pflux = Wl.P;
+      pFlux[i].Pflux = Wl[i].P;
 #else /* ISOTHERMAL */
-    pFlux->Pflux = Wl.d*Iso_csound2;
+      pFlux[i].Pflux = Wl[i].d*Iso_csound2;
 #endif /* ISOTHERMAL */
-  }
-  else if (ar < 0.0) {
+    }
+    else if (ar < 0.0) {
 #ifndef ISOTHERMAL
-    pFlux->Pflux = Wr.P;
+      pFlux[i].Pflux = Wr[i].P;
 #else /* ISOTHERMAL */
-    pFlux->Pflux = Wr.d*Iso_csound2;
+      pFlux[i].Pflux = Wr[i].d*Iso_csound2;
 #endif /* ISOTHERMAL */
-  }
-  else {
-#ifndef ISOTHERMAL
-    pFlux->Pflux = cp;
-#else /* ISOTHERMAL */
-    if (am >= 0.0) {
-      pFlux->Pflux = Wl.d*(al-Wl.Vx)/(al-am);
     }
     else {
-      pFlux->Pflux = Wr.d*(ar-Wr.Vx)/(ar-am);
-    }
+#ifndef ISOTHERMAL
+      pFlux[i].Pflux = cp;
+#else /* ISOTHERMAL */
+      if (am >= 0.0) {
+        pFlux[i].Pflux = Wl[i].d*(al-Wl[i].Vx)/(al-am);
+      }
+      else {
+        pFlux[i].Pflux = Wr[i].d*(ar-Wr[i].Vx)/(ar-am);
+      }
 #endif /* ISOTHERMAL */
-  }
+    }
 #endif /* CYLINDRICAL */
+  }
+
+  if (cpmin < 0.0) ath_perr(1,"[hllc flux]: Contact Pressure = %g\n",cpmin);
 
   return;
 }
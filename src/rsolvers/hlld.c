@@ -19,7 +19,14 @@
  *
  * CONTAINS PUBLIC FUNCTIONS: 
  * - fluxes() - all Riemann solvers in Athena must have this function name and
- *              use the same argument list as defined in rsolvers/prototypes.h*/
+ *              use the same argument list as defined in rsolvers/prototypes.h
+ * - fluxes_pencil() - fluxes at every interface of a 1D pencil
+ *
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - hlld_flux() - HLLD flux at one interface, separate adiabatic and
+ *                 isothermal versions
+ * - hlld_flux_simd() - adiabatic HLLD flux at four interfaces using AVX2,
+ *                 only compiled with SIMD */
 /*============================================================================*/
 
 #include <math.h>
@@ -36,6 +43,15 @@
 
 #define SMALL_NUMBER 1e-8
 
+/* The vectorized kernel is written with GCC vector extensions plus the AVX
+ * sqrt intrinsic, so it is only compiled for x86-64 with gcc-compatible
+ * compilers, and only for the adiabatic solver in double precision. */
+#if defined(SIMD) && !defined(ISOTHERMAL) && !defined(SINGLE_PREC) && \
+    defined(__GNUC__) && defined(__x86_64__)
+#define HLLD_SIMD
+#include <immintrin.h>
+#endif
+
 #ifndef MHD
 #error : The HLLD flux only works for mhd.
 #endif /* MHD */
@@ -43,9 +59,9 @@
 #ifndef ISOTHERMAL
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void fluxes(const Cons1DS Ul, const Cons1DS Ur,
- *           const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
- *  \brief Compute 1D fluxes
+/*! \fn static void hlld_flux(const Cons1DS *Ul, const Cons1DS *Ur,
+ *           const Prim1DS *Wl, const Prim1DS *Wr, const Real Bxi, Cons1DS *pFlux)
+ *  \brief Compute 1D fluxes (adiabatic)
  * Input Arguments:
  * - Bxi = B in direction of slice at cell interface
  * - Ul,Ur = L/R-states of CONSERVED variables at cell interface
@@ -54,8 +70,9 @@
  * - Flux = fluxes of CONSERVED variables at cell interface
  */
 
-void fluxes(const Cons1DS Ul, const Cons1DS Ur,
-            const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
+static void hlld_flux(const Cons1DS *Ul, const Cons1DS *Ur,
+                      const Prim1DS *Wl, const Prim1DS *Wr,
+                      const Real Bxi, Cons1DS *pFlux)
 {
   Cons1DS Ulst,Uldst,Urdst,Urst;       /* Conserved variable for all states */
   Prim1DS Wlst,Wrst;                   /* Primitive variables for all states */
@@ -73,6 +90,7 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
   Real Bxsig;                         /* sign(Bx) = 1 for Bx>0, -1 for Bx<0 */
   Real Bxsq;                          /* Bx^2 */
   Real tmp;                      /* Temp variable for repeated calculations */
+  Real di;                            /* 1/d in the L* & R* states */
 #if (NSCALARS > 0)
   int n;
 #endif
@@ -93,24 +111,24 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  */
 
   Bxsq = Bxi*Bxi;
-  pbl = 0.5*(Bxsq + SQR(Wl.By) + SQR(Wl.Bz));
-  pbr = 0.5*(Bxsq + SQR(Wr.By) + SQR(Wr.Bz));
-  gpl  = Gamma * Wl.P;
-  gpr  = Gamma * Wr.P;
+  pbl = 0.5*(Bxsq + SQR(Wl->By) + SQR(Wl->Bz));
+  pbr = 0.5*(Bxsq + SQR(Wr->By) + SQR(Wr->Bz));
+  gpl  = Gamma * Wl->P;
+  gpr  = Gamma * Wr->P;
   gpbl = gpl + 2.0*pbl;
   gpbr = gpr + 2.0*pbr;
 
-  cfl = sqrt((gpbl + sqrt(SQR(gpbl)-4.0*gpl*Bxsq))/(2.0*Wl.d));
-  cfr = sqrt((gpbr + sqrt(SQR(gpbr)-4.0*gpr*Bxsq))/(2.0*Wr.d));
+  cfl = sqrt((gpbl + sqrt(SQR(gpbl)-4.0*gpl*Bxsq))/(2.0*Wl->d));
+  cfr = sqrt((gpbr + sqrt(SQR(gpbr)-4.0*gpr*Bxsq))/(2.0*Wr->d));
   cfmax = MAX(cfl,cfr);
 
-  if(Wl.Vx <= Wr.Vx) {
-    spd[0] = Wl.Vx - cfmax;
-    spd[4] = Wr.Vx + cfmax;
+  if(Wl->Vx <= Wr->Vx) {
+    spd[0] = Wl->Vx - cfmax;
+    spd[4] = Wr->Vx + cfmax;
   }
   else {
-    spd[0] = Wr.Vx - cfmax;
-    spd[4] = Wl.Vx + cfmax;
+    spd[0] = Wr->Vx - cfmax;
+    spd[4] = Wl->Vx + cfmax;
   }
 
 /*  maxspd = MAX(fabs(spd[0]),fabs(spd[4])); */
@@ -120,29 +138,29 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  */
 
   /* total pressure */
-  ptl = Wl.P + pbl;
-  ptr = Wr.P + pbr;
-
-  Fl.d  = Ul.Mx;
-  Fl.Mx = Ul.Mx*Wl.Vx + ptl - Bxsq;
-  Fl.My = Ul.d*Wl.Vx*Wl.Vy - Bxi*Ul.By;
-  Fl.Mz = Ul.d*Wl.Vx*Wl.Vz - Bxi*Ul.Bz;
-  Fl.E  = Wl.Vx*(Ul.E + ptl - Bxsq) - Bxi*(Wl.Vy*Ul.By + Wl.Vz*Ul.Bz);
-  Fl.By = Ul.By*Wl.Vx - Bxi*Wl.Vy;
-  Fl.Bz = Ul.Bz*Wl.Vx - Bxi*Wl.Vz;
-
-  Fr.d  = Ur.Mx;
-  Fr.Mx = Ur.Mx*Wr.Vx + ptr - Bxsq;
-  Fr.My = Ur.d*Wr.Vx*Wr.Vy - Bxi*Ur.By;
-  Fr.Mz = Ur.d*Wr.Vx*Wr.Vz - Bxi*Ur.Bz;
-  Fr.E  = Wr.Vx*(Ur.E + ptr - Bxsq) - Bxi*(Wr.Vy*Ur.By + Wr.Vz*Ur.Bz);
-  Fr.By = Ur.By*Wr.Vx - Bxi*Wr.Vy;
-  Fr.Bz = Ur.Bz*Wr.Vx - Bxi*Wr.Vz;
+  ptl = Wl->P + pbl;
+  ptr = Wr->P + pbr;
+
+  Fl.d  = Ul->Mx;
+  Fl.Mx = Ul->Mx*Wl->Vx + ptl - Bxsq;
+  Fl.My = Ul->d*Wl->Vx*Wl->Vy - Bxi*Ul->By;
+  Fl.Mz = Ul->d*Wl->Vx*Wl->Vz - Bxi*Ul->Bz;
+  Fl.E  = Wl->Vx*(Ul->E + ptl - Bxsq) - Bxi*(Wl->Vy*Ul->By + Wl->Vz*Ul->Bz);
+  Fl.By = Ul->By*Wl->Vx - Bxi*Wl->Vy;
+  Fl.Bz = Ul->Bz*Wl->Vx - Bxi*Wl->Vz;
+
+  Fr.d  = Ur->Mx;
+  Fr.Mx = Ur->Mx*Wr->Vx + ptr - Bxsq;
+  Fr.My = Ur->d*Wr->Vx*Wr->Vy - Bxi*Ur->By;
+  Fr.Mz = Ur->d*Wr->Vx*Wr->Vz - Bxi*Ur->Bz;
+  Fr.E  = Wr->Vx*(Ur->E + ptr - Bxsq) - Bxi*(Wr->Vy*Ur->By + Wr->Vz*Ur->Bz);
+  Fr.By = Ur->By*Wr->Vx - Bxi*Wr->Vy;
+  Fr.Bz = Ur->Bz*Wr->Vx - Bxi*Wr->Vz;
 
 #if (NSCALARS > 0)
   for (n=0; n<NSCALARS; n++) {
-    Fl.s[n] = Fl.d*Wl.r[n];
-    Fr.s[n] = Fr.d*Wr.r[n];
+    Fl.s[n] = Fl.d*Wl->r[n];
+    Fr.s[n] = Fr.d*Wr->r[n];
   }
 #endif
 
@@ -170,18 +188,18 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  * Compute middle and Alfven wave speeds
  */
 
-  sdl = spd[0] - Wl.Vx;
-  sdr = spd[4] - Wr.Vx;
+  sdl = spd[0] - Wl->Vx;
+  sdr = spd[4] - Wr->Vx;
 
   /* S_M: eqn (38) of Miyoshi & Kusano */
-  spd[2] = (sdr*Wr.d*Wr.Vx - sdl*Wl.d*Wl.Vx - ptr + ptl) /
-           (sdr*Wr.d-sdl*Wl.d);
+  spd[2] = (sdr*Wr->d*Wr->Vx - sdl*Wl->d*Wl->Vx - ptr + ptl) /
+           (sdr*Wr->d-sdl*Wl->d);
 
   sdml   = spd[0] - spd[2];
   sdmr   = spd[4] - spd[2];
   /* eqn (43) of Miyoshi & Kusano */
-  Ulst.d = Ul.d * sdl/sdml;
-  Urst.d = Ur.d * sdr/sdmr;
+  Ulst.d = Ul->d * sdl/sdml;
+  Urst.d = Ur->d * sdr/sdmr;
   sqrtdl = sqrt(Ulst.d);
   sqrtdr = sqrt(Urst.d);
 
@@ -193,103 +211,108 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  * Compute intermediate states
  */
 
-  ptst = ptl + Ul.d*sdl*(sdl-sdml);
+  ptst = ptl + Ul->d*sdl*(sdl-sdml);
  
 /* Ul* */
   /* eqn (39) of M&K */
   Ulst.Mx = Ulst.d * spd[2];
-//   if((fabs(spd[2]/Wl.Vx-1.0)<SMALL_NUMBER) ||
+//   if((fabs(spd[2]/Wl->Vx-1.0)<SMALL_NUMBER) ||
 //      (fabs(spd[2])/fabs(spd[0]) <= SMALL_NUMBER &&
-//       fabs(Wl.Vx)/fabs(spd[0]) <= SMALL_NUMBER)) {
-//     Ulst.My = Ulst.d * Wl.Vy;
-//     Ulst.Mz = Ulst.d * Wl.Vz;
+//       fabs(Wl->Vx)/fabs(spd[0]) <= SMALL_NUMBER)) {
+//     Ulst.My = Ulst.d * Wl->Vy;
+//     Ulst.Mz = Ulst.d * Wl->Vz;
 // 
-//     Ulst.By = Ul.By;
-//     Ulst.Bz = Ul.Bz;
+//     Ulst.By = Ul->By;
+//     Ulst.Bz = Ul->Bz;
 //   }
-  if (fabs(Ul.d*sdl*sdml-Bxsq) < SMALL_NUMBER*ptst) {
+  if (fabs(Ul->d*sdl*sdml-Bxsq) < SMALL_NUMBER*ptst) {
     /* Degenerate case */
-    Ulst.My = Ulst.d * Wl.Vy;
-    Ulst.Mz = Ulst.d * Wl.Vz;
+    Ulst.My = Ulst.d * Wl->Vy;
+    Ulst.Mz = Ulst.d * Wl->Vz;
 
-    Ulst.By = Ul.By;
-    Ulst.Bz = Ul.Bz;
+    Ulst.By = Ul->By;
+    Ulst.Bz = Ul->Bz;
   }
   else {
     /* eqns (44) and (46) of M&K */
-    tmp = Bxi*(sdl-sdml)/(Ul.d*sdl*sdml-Bxsq);
-    Ulst.My = Ulst.d * (Wl.Vy - Ul.By*tmp);
-    Ulst.Mz = Ulst.d * (Wl.Vz - Ul.Bz*tmp);
-//     if(Ul.By == 0.0 && Ul.Bz == 0.0) {
+    tmp = Bxi*(sdl-sdml)/(Ul->d*sdl*sdml-Bxsq);
+    Ulst.My = Ulst.d * (Wl->Vy - Ul->By*tmp);
+    Ulst.Mz = Ulst.d * (Wl->Vz - Ul->Bz*tmp);
+//     if(Ul->By == 0.0 && Ul->Bz == 0.0) {
 //       Ulst.By = 0.0;
 //       Ulst.Bz = 0.0;
 //     }
 //     else {
 //       /* eqns (45) and (47) of M&K */
-//       tmp = (Ul.d*SQR(sdl)-Bxsq)/(Ul.d*sdl*sdml - Bxsq);
-//       Ulst.By = Ul.By * tmp;
-//       Ulst.Bz = Ul.Bz * tmp;
+//       tmp = (Ul->d*SQR(sdl)-Bxsq)/(Ul->d*sdl*sdml - Bxsq);
+//       Ulst.By = Ul->By * tmp;
+//       Ulst.Bz = Ul->Bz * tmp;
 //     }
 
     /* eqns (45) and (47) of M&K */
-    tmp = (Ul.d*SQR(sdl)-Bxsq)/(Ul.d*sdl*sdml - Bxsq);
-    Ulst.By = Ul.By * tmp;
-    Ulst.Bz = Ul.Bz * tmp;
+    tmp = (Ul->d*SQR(sdl)-Bxsq)/(Ul->d*sdl*sdml - Bxsq);
+    Ulst.By = Ul->By * tmp;
+    Ulst.Bz = Ul->Bz * tmp;
   }
   vbstl = (Ulst.Mx*Bxi+Ulst.My*Ulst.By+Ulst.Mz*Ulst.Bz)/Ulst.d;
   /* eqn (48) of M&K */
-  Ulst.E = (sdl*Ul.E - ptl*Wl.Vx + ptst*spd[2] +
-            Bxi*(Wl.Vx*Bxi+Wl.Vy*Ul.By+Wl.Vz*Ul.Bz - vbstl))/sdml;
-  Wlst = Cons1D_to_Prim1D(&Ulst,&Bxi);
+  Ulst.E = (sdl*Ul->E - ptl*Wl->Vx + ptst*spd[2] +
+            Bxi*(Wl->Vx*Bxi+Wl->Vy*Ul->By+Wl->Vz*Ul->Bz - vbstl))/sdml;
+  /* only the transverse velocities of W* are needed */
+  di = 1.0/Ulst.d;
+  Wlst.Vy = Ulst.My*di;
+  Wlst.Vz = Ulst.Mz*di;
 
 
 /* Ur* */
   /* eqn (39) of M&K */
   Urst.Mx = Urst.d * spd[2];
-//   if((fabs(spd[2]/Wr.Vx-1.0)<SMALL_NUMBER) ||
+//   if((fabs(spd[2]/Wr->Vx-1.0)<SMALL_NUMBER) ||
 //      (fabs(spd[2])/fabs(spd[4]) <= SMALL_NUMBER &&
-//       fabs(Wr.Vx)/fabs(spd[4]) <= SMALL_NUMBER)) {
-//     Urst.My = Urst.d * Wr.Vy;
-//     Urst.Mz = Urst.d * Wr.Vz;
+//       fabs(Wr->Vx)/fabs(spd[4]) <= SMALL_NUMBER)) {
+//     Urst.My = Urst.d * Wr->Vy;
+//     Urst.Mz = Urst.d * Wr->Vz;
 // 
-//     Urst.By = Ur.By;
-//     Urst.Bz = Ur.Bz;
+//     Urst.By = Ur->By;
+//     Urst.Bz = Ur->Bz;
 //   }
-  if (fabs(Ur.d*sdr*sdmr-Bxsq) < SMALL_NUMBER*ptst) {
+  if (fabs(Ur->d*sdr*sdmr-Bxsq) < SMALL_NUMBER*ptst) {
     /* Degenerate case */
-    Urst.My = Urst.d * Wr.Vy;
-    Urst.Mz = Urst.d * Wr.Vz;
+    Urst.My = Urst.d * Wr->Vy;
+    Urst.Mz = Urst.d * Wr->Vz;
 
-    Urst.By = Ur.By;
-    Urst.Bz = Ur.Bz;
+    Urst.By = Ur->By;
+    Urst.Bz = Ur->Bz;
   }
   else {
     /* eqns (44) and (46) of M&K */
-    tmp = Bxi*(sdr-sdmr)/(Ur.d*sdr*sdmr-Bxsq);
-    Urst.My = Urst.d * (Wr.Vy - Ur.By*tmp);
-    Urst.Mz = Urst.d * (Wr.Vz - Ur.Bz*tmp);
+    tmp = Bxi*(sdr-sdmr)/(Ur->d*sdr*sdmr-Bxsq);
+    Urst.My = Urst.d * (Wr->Vy - Ur->By*tmp);
+    Urst.Mz = Urst.d * (Wr->Vz - Ur->Bz*tmp);
 
-//     if(Ur.By == 0.0 && Ur.Bz == 0.0) {
+//     if(Ur->By == 0.0 && Ur->Bz == 0.0) {
 //       Urst.By = 0.0;
 //       Urst.Bz = 0.0;
 //     }
 //     else {
 //       /* eqns (45) and (47) of M&K */
-//       tmp = (Ur.d*SQR(sdr)-Bxsq)/(Ur.d*sdr*sdmr - Bxsq);
-//       Urst.By = Ur.By * tmp;
-//       Urst.Bz = Ur.Bz * tmp;
+//       tmp = (Ur->d*SQR(sdr)-Bxsq)/(Ur->d*sdr*sdmr - Bxsq);
+//       Urst.By = Ur->By * tmp;
+//       Urst.Bz = Ur->Bz * tmp;
 //     }
 
     /* eqns (45) and (47) of M&K */
-    tmp = (Ur.d*SQR(sdr)-Bxsq)/(Ur.d*sdr*sdmr - Bxsq);
-    Urst.By = Ur.By * tmp;
-    Urst.Bz = Ur.Bz * tmp;
+    tmp = (Ur->d*SQR(sdr)-Bxsq)/(Ur->d*sdr*sdmr - Bxsq);
+    Urst.By = Ur->By * tmp;
+    Urst.Bz = Ur->Bz * tmp;
   }
   vbstr = (Urst.Mx*Bxi+Urst.My*Urst.By+Urst.Mz*Urst.Bz)/Urst.d;
   /* eqn (48) of M&K */
-  Urst.E = (sdr*Ur.E - ptr*Wr.Vx + ptst*spd[2] +
-            Bxi*(Wr.Vx*Bxi+Wr.Vy*Ur.By+Wr.Vz*Ur.Bz - vbstr))/sdmr;
-  Wrst = Cons1D_to_Prim1D(&Urst,&Bxi);
+  Urst.E = (sdr*Ur->E - ptr*Wr->Vx + ptst*spd[2] +
+            Bxi*(Wr->Vx*Bxi+Wr->Vy*Ur->By+Wr->Vz*Ur->Bz - vbstr))/sdmr;
+  di = 1.0/Urst.d;
+  Wrst.Vy = Urst.My*di;
+  Wrst.Vz = Urst.Mz*di;
 
 
 /* Ul** and Ur** - if Bx is zero, same as *-states */
@@ -341,53 +364,53 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 
   if(spd[1] >= 0.0) {
 /* return Fl* */
-    pFlux->d  = Fl.d  + spd[0]*(Ulst.d  - Ul.d);
-    pFlux->Mx = Fl.Mx + spd[0]*(Ulst.Mx - Ul.Mx);
-    pFlux->My = Fl.My + spd[0]*(Ulst.My - Ul.My);
-    pFlux->Mz = Fl.Mz + spd[0]*(Ulst.Mz - Ul.Mz);
-    pFlux->E  = Fl.E  + spd[0]*(Ulst.E  - Ul.E);
-    pFlux->By = Fl.By + spd[0]*(Ulst.By - Ul.By);
-    pFlux->Bz = Fl.Bz + spd[0]*(Ulst.Bz - Ul.Bz);
+    pFlux->d  = Fl.d  + spd[0]*(Ulst.d  - Ul->d);
+    pFlux->Mx = Fl.Mx + spd[0]*(Ulst.Mx - Ul->Mx);
+    pFlux->My = Fl.My + spd[0]*(Ulst.My - Ul->My);
+    pFlux->Mz = Fl.Mz + spd[0]*(Ulst.Mz - Ul->Mz);
+    pFlux->E  = Fl.E  + spd[0]*(Ulst.E  - Ul->E);
+    pFlux->By = Fl.By + spd[0]*(Ulst.By - Ul->By);
+    pFlux->Bz = Fl.Bz + spd[0]*(Ulst.Bz - Ul->Bz);
   }
   else if(spd[2] >= 0.0) {
 /* return Fl** */
     tmp = spd[1] - spd[0];
-    pFlux->d  = Fl.d  - spd[0]*Ul.d  - tmp*Ulst.d  + spd[1]*Uldst.d;
-    pFlux->Mx = Fl.Mx - spd[0]*Ul.Mx - tmp*Ulst.Mx + spd[1]*Uldst.Mx;
-    pFlux->My = Fl.My - spd[0]*Ul.My - tmp*Ulst.My + spd[1]*Uldst.My;
-    pFlux->Mz = Fl.Mz - spd[0]*Ul.Mz - tmp*Ulst.Mz + spd[1]*Uldst.Mz;
-    pFlux->E  = Fl.E  - spd[0]*Ul.E  - tmp*Ulst.E  + spd[1]*Uldst.E;
-    pFlux->By = Fl.By - spd[0]*Ul.By - tmp*Ulst.By + spd[1]*Uldst.By;
-    pFlux->Bz = Fl.Bz - spd[0]*Ul.Bz - tmp*Ulst.Bz + spd[1]*Uldst.Bz;
+    pFlux->d  = Fl.d  - spd[0]*Ul->d  - tmp*Ulst.d  + spd[1]*Uldst.d;
+    pFlux->Mx = Fl.Mx - spd[0]*Ul->Mx - tmp*Ulst.Mx + spd[1]*Uldst.Mx;
+    pFlux->My = Fl.My - spd[0]*Ul->My - tmp*Ulst.My + spd[1]*Uldst.My;
+    pFlux->Mz = Fl.Mz - spd[0]*Ul->Mz - tmp*Ulst.Mz + spd[1]*Uldst.Mz;
+    pFlux->E  = Fl.E  - spd[0]*Ul->E  - tmp*Ulst.E  + spd[1]*Uldst.E;
+    pFlux->By = Fl.By - spd[0]*Ul->By - tmp*Ulst.By + spd[1]*Uldst.By;
+    pFlux->Bz = Fl.Bz - spd[0]*Ul->Bz - tmp*Ulst.Bz + spd[1]*Uldst.Bz;
   }
   else if(spd[3] > 0.0) {
 /* return Fr** */
     tmp = spd[3] - spd[4];
-    pFlux->d  = Fr.d  - spd[4]*Ur.d  - tmp*Urst.d  + spd[3]*Urdst.d;
-    pFlux->Mx = Fr.Mx - spd[4]*Ur.Mx - tmp*Urst.Mx + spd[3]*Urdst.Mx;
-    pFlux->My = Fr.My - spd[4]*Ur.My - tmp*Urst.My + spd[3]*Urdst.My;
-    pFlux->Mz = Fr.Mz - spd[4]*Ur.Mz - tmp*Urst.Mz + spd[3]*Urdst.Mz;
-    pFlux->E  = Fr.E  - spd[4]*Ur.E  - tmp*Urst.E  + spd[3]*Urdst.E;
-    pFlux->By = Fr.By - spd[4]*Ur.By - tmp*Urst.By + spd[3]*Urdst.By;
-    pFlux->Bz = Fr.Bz - spd[4]*Ur.Bz - tmp*Urst.Bz + spd[3]*Urdst.Bz;
+    pFlux->d  = Fr.d  - spd[4]*Ur->d  - tmp*Urst.d  + spd[3]*Urdst.d;
+    pFlux->Mx = Fr.Mx - spd[4]*Ur->Mx - tmp*Urst.Mx + spd[3]*Urdst.Mx;
+    pFlux->My = Fr.My - spd[4]*Ur->My - tmp*Urst.My + spd[3]*Urdst.My;
+    pFlux->Mz = Fr.Mz - spd[4]*Ur->Mz - tmp*Urst.Mz + spd[3]*Urdst.Mz;
+    pFlux->E  = Fr.E  - spd[4]*Ur->E  - tmp*Urst.E  + spd[3]*Urdst.E;
+    pFlux->By = Fr.By - spd[4]*Ur->By - tmp*Urst.By + spd[3]*Urdst.By;
+    pFlux->Bz = Fr.Bz - spd[4]*Ur->Bz - tmp*Urst.Bz + spd[3]*Urdst.Bz;
   }
   else {
 /* return Fr* */
-    pFlux->d  = Fr.d  + spd[4]*(Urst.d  - Ur.d);
-    pFlux->Mx = Fr.Mx + spd[4]*(Urst.Mx - Ur.Mx);
-    pFlux->My = Fr.My + spd[4]*(Urst.My - Ur.My);
-    pFlux->Mz = Fr.Mz + spd[4]*(Urst.Mz - Ur.Mz);
-    pFlux->E  = Fr.E  + spd[4]*(Urst.E  - Ur.E);
-    pFlux->By = Fr.By + spd[4]*(Urst.By - Ur.By);
-    pFlux->Bz = Fr.Bz + spd[4]*(Urst.Bz - Ur.Bz);
+    pFlux->d  = Fr.d  + spd[4]*(Urst.d  - Ur->d);
+    pFlux->Mx = Fr.Mx + spd[4]*(Urst.Mx - Ur->Mx);
+    pFlux->My = Fr.My + spd[4]*(Urst.My - Ur->My);
+    pFlux->Mz = Fr.Mz + spd[4]*(Urst.Mz - Ur->Mz);
+    pFlux->E  = Fr.E  + spd[4]*(Urst.E  - Ur->E);
+    pFlux->By = Fr.By + spd[4]*(Urst.By - Ur->By);
+    pFlux->Bz = Fr.Bz + spd[4]*(Urst.Bz - Ur->Bz);
   }
 
 /* Fluxes of passively advected scalars, computed from density flux */
 #if (NSCALARS > 0)
   if (pFlux->d >= 0.0) {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl.r[n];
+    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl->r[n];
   } else {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr.r[n];
+    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr->r[n];
   }
 #endif
 
@@ -397,12 +420,263 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
   return;
 }
 
+#ifdef HLLD_SIMD
+/*----------------------------------------------------------------------------*/
+/* Vector types and helpers for hlld_flux_simd().  Comparisons of v4d return
+ * v4di masks (all bits set where true), which VSEL() uses to merge two
+ * vectors bit by bit, so that all branches of the scalar solver become
+ * selects. */
+
+typedef double v4d __attribute__ ((vector_size (32)));
+typedef long long v4di __attribute__ ((vector_size (32)));
+
+#define VLOAD(p,i,f) {(p)[i].f, (p)[(i)+1].f, (p)[(i)+2].f, (p)[(i)+3].f}
+#define VSEL(m,a,b) ((v4d)(((v4di)(a) & (m)) | ((v4di)(b) & ~(m))))
+#define VABS(a) ((v4d)((v4di)(a) & 0x7fffffffffffffffLL))
+#define VSQRT(a) ((v4d)_mm256_sqrt_pd((__m256d)(a)))
+
+/* Select the flux in one variable from the six possible states, in the same
+ * order of precedence as the if/else chains in hlld_flux() */
+#define VFLUX(F,fl,fr,ul,ur,ulst,urst,uldst,urdst) \
+  F = VSEL(m3, fr - sp4*ur - tr*urst + sp3*urdst, fr + sp4*(urst - ur)); \
+  F = VSEL(m2, fl - sp0*ul - tl*ulst + sp1*uldst, F); \
+  F = VSEL(m1, fl + sp0*(ulst - ul), F); \
+  F = VSEL(m4, fr, F); \
+  F = VSEL(m0, fl, F)
+
+/*----------------------------------------------------------------------------*/
+/*! \fn static void hlld_flux_simd(const Cons1DS *Ul, const Cons1DS *Ur,
+ *           const Prim1DS *Wl, const Prim1DS *Wr, const Real *Bxi,
+ *           Cons1DS *pFlux, const int i)
+ *  \brief Compute 1D fluxes (adiabatic) at interfaces i..i+3 using AVX2
+ *
+ * Same algorithm and order of operations as hlld_flux(), but every branch
+ * (supersonic states, degenerate L*,R* states, Bx=0, choice of the
+ * intermediate state) is evaluated for all four interfaces and the result
+ * selected with a mask, so the fluxes agree with the scalar solver to
+ * round-off.  Values computed in lanes that are not selected may be
+ * infinite or NaN; they never reach the output.
+ */
+
+static void __attribute__ ((target ("avx2")))
+hlld_flux_simd(const Cons1DS *Ul, const Cons1DS *Ur,
+               const Prim1DS *Wl, const Prim1DS *Wr, const Real *Bxi,
+               Cons1DS *pFlux, const int i)
+{
+  const v4d one = {1.0, 1.0, 1.0, 1.0};
+  v4d bxi = {Bxi[i], Bxi[i+1], Bxi[i+2], Bxi[i+3]};
+  v4d uld = VLOAD(Ul,i,d),  ulmx = VLOAD(Ul,i,Mx), ulmy = VLOAD(Ul,i,My);
+  v4d ulmz = VLOAD(Ul,i,Mz), ule = VLOAD(Ul,i,E);
+  v4d ulby = VLOAD(Ul,i,By), ulbz = VLOAD(Ul,i,Bz);
+  v4d urd = VLOAD(Ur,i,d),  urmx = VLOAD(Ur,i,Mx), urmy = VLOAD(Ur,i,My);
+  v4d urmz = VLOAD(Ur,i,Mz), ure = VLOAD(Ur,i,E);
+  v4d urby = VLOAD(Ur,i,By), urbz = VLOAD(Ur,i,Bz);
+  v4d wld = VLOAD(Wl,i,d),  wlvx = VLOAD(Wl,i,Vx), wlvy = VLOAD(Wl,i,Vy);
+  v4d wlvz = VLOAD(Wl,i,Vz), wlp = VLOAD(Wl,i,P);
+  v4d wlby = VLOAD(Wl,i,By), wlbz = VLOAD(Wl,i,Bz);
+  v4d wrd = VLOAD(Wr,i,d),  wrvx = VLOAD(Wr,i,Vx), wrvy = VLOAD(Wr,i,Vy);
+  v4d wrvz = VLOAD(Wr,i,Vz), wrp = VLOAD(Wr,i,P);
+  v4d wrby = VLOAD(Wr,i,By), wrbz = VLOAD(Wr,i,Bz);
+  v4d bxsq,pbl,pbr,gpl,gpr,gpbl,gpbr,cfl,cfr,cfmax,ptl,ptr,ptst;
+  v4d sp0,sp1,sp2,sp3,sp4,sdl,sdr,sdml,sdmr,sqrtdl,sqrtdr,den,tmp,di;
+  v4d fld,flmx,flmy,flmz,fle,flby,flbz,frd,frmx,frmy,frmz,fre,frby,frbz;
+  v4d ulstd,ulstmx,ulstmy,ulstmz,ulste,ulstby,ulstbz,wlstvy,wlstvz,vbstl;
+  v4d urstd,urstmx,urstmy,urstmz,urste,urstby,urstbz,wrstvy,wrstvz,vbstr;
+  v4d uldstmy,uldstmz,uldste,uldstby,uldstbz;
+  v4d urdstmy,urdstmz,urdste,urdstby,urdstbz;
+  v4d invsumd,bxsig,tl,tr,F;
+  v4di m,m0,m1,m2,m3,m4;
+  int k;
+#if (NSCALARS > 0)
+  int n;
+#endif
+
+/* Left & right wave speeds, eqn. (67) of Miyoshi & Kusano */
+
+  bxsq = bxi*bxi;
+  pbl = 0.5*(bxsq + wlby*wlby + wlbz*wlbz);
+  pbr = 0.5*(bxsq + wrby*wrby + wrbz*wrbz);
+  gpl  = Gamma*wlp;
+  gpr  = Gamma*wrp;
+  gpbl = gpl + 2.0*pbl;
+  gpbr = gpr + 2.0*pbr;
+
+  cfl = VSQRT((gpbl + VSQRT(gpbl*gpbl - 4.0*gpl*bxsq))/(2.0*wld));
+  cfr = VSQRT((gpbr + VSQRT(gpbr*gpbr - 4.0*gpr*bxsq))/(2.0*wrd));
+  cfmax = VSEL((v4di)(cfl > cfr), cfl, cfr);
+
+  m = (v4di)(wlvx <= wrvx);
+  sp0 = VSEL(m, wlvx - cfmax, wrvx - cfmax);
+  sp4 = VSEL(m, wrvx + cfmax, wlvx + cfmax);
+
+/* L/R fluxes */
+
+  ptl = wlp + pbl;
+  ptr = wrp + pbr;
+
+  fld  = ulmx;
+  flmx = ulmx*wlvx + ptl - bxsq;
+  flmy = uld*wlvx*wlvy - bxi*ulby;
+  flmz = uld*wlvx*wlvz - bxi*ulbz;
+  fle  = wlvx*(ule + ptl - bxsq) - bxi*(wlvy*ulby + wlvz*ulbz);
+  flby = ulby*wlvx - bxi*wlvy;
+  flbz = ulbz*wlvx - bxi*wlvz;
+
+  frd  = urmx;
+  frmx = urmx*wrvx + ptr - bxsq;
+  frmy = urd*wrvx*wrvy - bxi*urby;
+  frmz = urd*wrvx*wrvz - bxi*urbz;
+  fre  = wrvx*(ure + ptr - bxsq) - bxi*(wrvy*urby + wrvz*urbz);
+  frby = urby*wrvx - bxi*wrvy;
+  frbz = urbz*wrvx - bxi*wrvz;
+
+/* Middle and Alfven wave speeds, eqns. (38), (43) and (51) of M&K */
+
+  sdl = sp0 - wlvx;
+  sdr = sp4 - wrvx;
+  sp2 = (sdr*wrd*wrvx - sdl*wld*wlvx - ptr + ptl)/(sdr*wrd - sdl*wld);
+
+  sdml = sp0 - sp2;
+  sdmr = sp4 - sp2;
+  ulstd = uld*sdl/sdml;
+  urstd = urd*sdr/sdmr;
+  sqrtdl = VSQRT(ulstd);
+  sqrtdr = VSQRT(urstd);
+
+  sp1 = sp2 - VABS(bxi)/sqrtdl;
+  sp3 = sp2 + VABS(bxi)/sqrtdr;
+
+/* Ul*, eqns. (39) and (44)-(48) of M&K */
+
+  ptst = ptl + uld*sdl*(sdl-sdml);
+
+  ulstmx = ulstd*sp2;
+  den = uld*sdl*sdml - bxsq;
+  m = (v4di)(VABS(den) < SMALL_NUMBER*ptst);
+  tmp = bxi*(sdl-sdml)/den;
+  ulstmy = VSEL(m, ulstd*wlvy, ulstd*(wlvy - ulby*tmp));
+  ulstmz = VSEL(m, ulstd*wlvz, ulstd*(wlvz - ulbz*tmp));
+  tmp = (uld*(sdl*sdl) - bxsq)/den;
+  ulstby = VSEL(m, ulby, ulby*tmp);
+  ulstbz = VSEL(m, ulbz, ulbz*tmp);
+  vbstl = (ulstmx*bxi + ulstmy*ulstby + ulstmz*ulstbz)/ulstd;
+  ulste = (sdl*ule - ptl*wlvx + ptst*sp2 +
+           bxi*(wlvx*bxi + wlvy*ulby + wlvz*ulbz - vbstl))/sdml;
+  di = 1.0/ulstd;
+  wlstvy = ulstmy*di;
+  wlstvz = ulstmz*di;
+
+/* Ur* */
+
+  urstmx = urstd*sp2;
+  den = urd*sdr*sdmr - bxsq;
+  m = (v4di)(VABS(den) < SMALL_NUMBER*ptst);
+  tmp = bxi*(sdr-sdmr)/den;
+  urstmy = VSEL(m, urstd*wrvy, urstd*(wrvy - urby*tmp));
+  urstmz = VSEL(m, urstd*wrvz, urstd*(wrvz - urbz*tmp));
+  tmp = (urd*(sdr*sdr) - bxsq)/den;
+  urstby = VSEL(m, urby, urby*tmp);
+  urstbz = VSEL(m, urbz, urbz*tmp);
+  vbstr = (urstmx*bxi + urstmy*urstby + urstmz*urstbz)/urstd;
+  urste = (sdr*ure - ptr*wrvx + ptst*sp2 +
+           bxi*(wrvx*bxi + wrvy*urby + wrvz*urbz - vbstr))/sdmr;
+  di = 1.0/urstd;
+  wrstvy = urstmy*di;
+  wrstvz = urstmz*di;
+
+/* Ul** and Ur**, eqns. (59)-(63) of M&K; same as *-states if Bx is zero */
+
+  invsumd = 1.0/(sqrtdl + sqrtdr);
+  bxsig = VSEL((v4di)(bxi > 0.0), one, -one);
+
+  tmp = invsumd*(sqrtdl*wlstvy + sqrtdr*wrstvy + bxsig*(urstby-ulstby));
+  uldstmy = ulstd*tmp;
+  urdstmy = urstd*tmp;
+
+  tmp = invsumd*(sqrtdl*wlstvz + sqrtdr*wrstvz + bxsig*(urstbz-ulstbz));
+  uldstmz = ulstd*tmp;
+  urdstmz = urstd*tmp;
+
+  uldstby = invsumd*(sqrtdl*urstby + sqrtdr*ulstby +
+                     bxsig*sqrtdl*sqrtdr*(wrstvy-wlstvy));
+  uldstbz = invsumd*(sqrtdl*urstbz + sqrtdr*ulstbz +
+                     bxsig*sqrtdl*sqrtdr*(wrstvz-wlstvz));
+  urdstby = uldstby;
+  urdstbz = uldstbz;
+
+  tmp = sp2*bxi + (uldstmy*uldstby + uldstmz*uldstbz)/ulstd;
+  uldste = ulste - sqrtdl*bxsig*(vbstl - tmp);
+  urdste = urste + sqrtdr*bxsig*(vbstr - tmp);
+
+  m = (v4di)(0.5*bxsq < SMALL_NUMBER*ptst);
+  uldstmy = VSEL(m, ulstmy, uldstmy);
+  uldstmz = VSEL(m, ulstmz, uldstmz);
+  uldste  = VSEL(m, ulste,  uldste);
+  uldstby = VSEL(m, ulstby, uldstby);
+  uldstbz = VSEL(m, ulstbz, uldstbz);
+  urdstmy = VSEL(m, urstmy, urdstmy);
+  urdstmz = VSEL(m, urstmz, urdstmz);
+  urdste  = VSEL(m, urste,  urdste);
+  urdstby = VSEL(m, urstby, urdstby);
+  urdstbz = VSEL(m, urstbz, urdstbz);
+
+/* Flux.  Lanes are stored as soon as each variable is selected. */
+
+  m0 = (v4di)(sp0 >= 0.0);
+  m4 = (v4di)(sp4 <= 0.0);
+  m1 = (v4di)(sp1 >= 0.0);
+  m2 = (v4di)(sp2 >= 0.0);
+  m3 = (v4di)(sp3 >  0.0);
+  tl = sp1 - sp0;
+  tr = sp3 - sp4;
+
+  VFLUX(F,fld,frd,uld,urd,ulstd,urstd,ulstd,urstd);
+  for (k=0; k<4; k++) pFlux[i+k].d = F[k];
+  VFLUX(F,flmx,frmx,ulmx,urmx,ulstmx,urstmx,ulstmx,urstmx);
+  for (k=0; k<4; k++) pFlux[i+k].Mx = F[k];
+  VFLUX(F,flmy,frmy,ulmy,urmy,ulstmy,urstmy,uldstmy,urdstmy);
+  for (k=0; k<4; k++) pFlux[i+k].My = F[k];
+  VFLUX(F,flmz,frmz,ulmz,urmz,ulstmz,urstmz,uldstmz,urdstmz);
+  for (k=0; k<4; k++) pFlux[i+k].Mz = F[k];
+  VFLUX(F,fle,fre,ule,ure,ulste,urste,uldste,urdste);
+  for (k=0; k<4; k++) pFlux[i+k].E = F[k];
+  VFLUX(F,flby,frby,ulby,urby,ulstby,urstby,uldstby,urdstby);
+  for (k=0; k<4; k++) pFlux[i+k].By = F[k];
+  VFLUX(F,flbz,frbz,ulbz,urbz,ulstbz,urstbz,uldstbz,urdstbz);
+  for (k=0; k<4; k++) pFlux[i+k].Bz = F[k];
+
+#if defined(CYLINDRICAL) && !defined(BAROTROPIC)
+  F = VSEL(m0, ptl, VSEL(m4, ptr, ptst));
+  for (k=0; k<4; k++) pFlux[i+k].Pflux = F[k];
+#endif
+
+/* Fluxes of passively advected scalars, computed from density flux */
+#if (NSCALARS > 0)
+  for (k=i; k<i+4; k++) {
+    if (pFlux[k].d >= 0.0) {
+      for (n=0; n<NSCALARS; n++) pFlux[k].s[n] = pFlux[k].d*Wl[k].r[n];
+    } else {
+      for (n=0; n<NSCALARS; n++) pFlux[k].s[n] = pFlux[k].d*Wr[k].r[n];
+    }
+  }
+#endif
+
+  return;
+}
+
+#undef VLOAD
+#undef VSEL
+#undef VABS
+#undef VSQRT
+#undef VFLUX
+#endif /* HLLD_SIMD */
+
 #else /* ISOTHERMAL */
 
 /*----------------------------------------------------------------------------*/
-/*! \fn void fluxes(const Cons1DS Ul, const Cons1DS Ur,
- *          const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
- *  \brief Compute 1D fluxes
+/*! \fn static void hlld_flux(const Cons1DS *Ul, const Cons1DS *Ur,
+ *          const Prim1DS *Wl, const Prim1DS *Wr, const Real Bxi, Cons1DS *pFlux)
+ *  \brief Compute 1D fluxes (isothermal)
  * Input Arguments:
  * - Bxi = B in direction of slice at cell interface
  * - Ul,Ur = L/R-states of CONSERVED variables at cell interface
@@ -411,8 +685,9 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  * - Flux = fluxes of CONSERVED variables at cell interface
  */
 
-void fluxes(const Cons1DS Ul, const Cons1DS Ur,
-            const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
+static void hlld_flux(const Cons1DS *Ul, const Cons1DS *Ur,
+                      const Prim1DS *Wl, const Prim1DS *Wr,
+                      const Real Bxi, Cons1DS *pFlux)
 {
   Cons1DS Ulst,Ucst,Urst;              /* Conserved variable for all states */
   Cons1DS Fl,Fr;                       /* Fluxes for left & right states */
@@ -446,29 +721,29 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
  */
 
   Bxsq = Bxi*Bxi;
-  pbl = 0.5*(Bxsq + SQR(Wl.By) + SQR(Wl.Bz));
-  pbr = 0.5*(Bxsq + SQR(Wr.By) + SQR(Wr.Bz));
-  gpl  = Wl.d*Iso_csound2;
-  gpr  = Wr.d*Iso_csound2;
+  pbl = 0.5*(Bxsq + SQR(Wl->By) + SQR(Wl->Bz));
+  pbr = 0.5*(Bxsq + SQR(Wr->By) + SQR(Wr->Bz));
+  gpl  = Wl->d*Iso_csound2;
+  gpr  = Wr->d*Iso_csound2;
   gpbl = gpl + 2.0*pbl;
   gpbr = gpr + 2.0*pbr;
 
-  cfl = sqrt((gpbl + sqrt(SQR(gpbl)-4.0*gpl*Bxsq))/(2.0*Wl.d));
-  cfr = sqrt((gpbr + sqrt(SQR(gpbr)-4.0*gpr*Bxsq))/(2.0*Wr.d));
+  cfl = sqrt((gpbl + sqrt(SQR(gpbl)-4.0*gpl*Bxsq))/(2.0*Wl->d));
+  cfr = sqrt((gpbr + sqrt(SQR(gpbr)-4.0*gpr*Bxsq))/(2.0*Wr->d));
 
-  spd[0] = MIN(Wl.Vx-cfl,Wr.Vx-cfr);
-  spd[4] = MAX(Wl.Vx+cfl,Wr.Vx+cfr);
+  spd[0] = MIN(Wl->Vx-cfl,Wr->Vx-cfr);
+  spd[4] = MAX(Wl->Vx+cfl,Wr->Vx+cfr);
 
 //   /* COMPUTE ROE AVERAGES */
-//   sqrtdl = sqrt((double)Wl.d);
-//   sqrtdr = sqrt((double)Wr.d);
+//   sqrtdl = sqrt((double)Wl->d);
+//   sqrtdr = sqrt((double)Wr->d);
 //   isdlpdr = 1.0/(sqrtdl + sqrtdr);
 //   idroe  = 1.0/(sqrtdl*sqrtdr);
-//   v1roe = (sqrtdl*Wl.Vx + sqrtdr*Wr.Vx)*isdlpdr;
-//   b2roe = (sqrtdr*Wl.By + sqrtdl*Wr.By)*isdlpdr;
-//   b3roe = (sqrtdr*Wl.Bz + sqrtdl*Wr.Bz)*isdlpdr;
-//   x = 0.5*(SQR(Wl.By - Wr.By) + SQR(Wl.Bz - Wr.Bz))*SQR(isdlpdr);
-//   y = 0.5*(Wl.d + Wr.d)*idroe;
+//   v1roe = (sqrtdl*Wl->Vx + sqrtdr*Wr->Vx)*isdlpdr;
+//   b2roe = (sqrtdr*Wl->By + sqrtdl*Wr->By)*isdlpdr;
+//   b3roe = (sqrtdr*Wl->Bz + sqrtdl*Wr->Bz)*isdlpdr;
+//   x = 0.5*(SQR(Wl->By - Wr->By) + SQR(Wl->Bz - Wr->Bz))*SQR(isdlpdr);
+//   y = 0.5*(Wl->d + Wr->d)*idroe;
 // 
 //   /* COMPUTE FAST MAGNETOSONIC SPEED */
 //   bt_starsq = (SQR(b2roe) + SQR(b3roe))*y;
@@ -479,8 +754,8 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 //   cfsq = 0.5*(tsum + sqrt((double)(SQR(tsum) - 4.0*twid_csq*vaxsq)));
 //   cf = sqrt((double)cfsq);
 // 
-//   spd[0] = MIN(Wl.Vx-cfl,v1roe-cf);
-//   spd[4] = MAX(v1roe+cf,Wr.Vx+cfr);
+//   spd[0] = MIN(Wl->Vx-cfl,v1roe-cf);
+//   spd[4] = MAX(v1roe+cf,Wr->Vx+cfr);
 
 /*--- Step 3. ------------------------------------------------------------------
  * Compute L/R fluxes
@@ -490,24 +765,24 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
   ptl = gpl + pbl;
   ptr = gpr + pbr;
 
-  Fl.d  = Ul.Mx;
-  Fl.Mx = Ul.Mx*Wl.Vx + ptl - Bxsq;
-  Fl.My = Ul.d*Wl.Vx*Wl.Vy - Bxi*Ul.By;
-  Fl.Mz = Ul.d*Wl.Vx*Wl.Vz - Bxi*Ul.Bz;
-  Fl.By = Ul.By*Wl.Vx - Bxi*Wl.Vy;
-  Fl.Bz = Ul.Bz*Wl.Vx - Bxi*Wl.Vz;
+  Fl.d  = Ul->Mx;
+  Fl.Mx = Ul->Mx*Wl->Vx + ptl - Bxsq;
+  Fl.My = Ul->d*Wl->Vx*Wl->Vy - Bxi*Ul->By;
+  Fl.Mz = Ul->d*Wl->Vx*Wl->Vz - Bxi*Ul->Bz;
+  Fl.By = Ul->By*Wl->Vx - Bxi*Wl->Vy;
+  Fl.Bz = Ul->Bz*Wl->Vx - Bxi*Wl->Vz;
 
-  Fr.d  = Ur.Mx;
-  Fr.Mx = Ur.Mx*Wr.Vx + ptr - Bxsq;
-  Fr.My = Ur.d*Wr.Vx*Wr.Vy - Bxi*Ur.By;
-  Fr.Mz = Ur.d*Wr.Vx*Wr.Vz - Bxi*Ur.Bz;
-  Fr.By = Ur.By*Wr.Vx - Bxi*Wr.Vy;
-  Fr.Bz = Ur.Bz*Wr.Vx - Bxi*Wr.Vz;
+  Fr.d  = Ur->Mx;
+  Fr.Mx = Ur->Mx*Wr->Vx + ptr - Bxsq;
+  Fr.My = Ur->d*Wr->Vx*Wr->Vy - Bxi*Ur->By;
+  Fr.Mz = Ur->d*Wr->Vx*Wr->Vz - Bxi*Ur->Bz;
+  Fr.By = Ur->By*Wr->Vx - Bxi*Wr->Vy;
+  Fr.Bz = Ur->Bz*Wr->Vx - Bxi*Wr->Vz;
 
 #if (NSCALARS > 0)
   for (n=0; n<NSCALARS; n++) {
-    Fl.s[n] = Fl.d*Wl.r[n];
-    Fr.s[n] = Fr.d*Wr.r[n];
+    Fl.s[n] = Fl.d*Wl->r[n];
+    Fr.s[n] = Fr.d*Wr->r[n];
   }
 #endif
 
@@ -536,22 +811,22 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 
   /* rho component of U^{hll} from Mignone eqn. (15);
    * uses F_L and F_R from eqn. (6) */
-  dhll = (spd[4]*Ur.d-spd[0]*Ul.d-Fr.d+Fl.d)*idspd;
+  dhll = (spd[4]*Ur->d-spd[0]*Ul->d-Fr.d+Fl.d)*idspd;
   if (dhll < d_MIN){
     dhll = d_MIN;
   }
   sqrtdhll = sqrt(dhll);
 
   /* rho and mx components of F^{hll} from Mignone eqn. (17) */
-  fdhll = (spd[4]*Fl.d-spd[0]*Fr.d+spd[4]*spd[0]*(Ur.d-Ul.d))*idspd;
-  fmxhll = (spd[4]*Fl.Mx-spd[0]*Fr.Mx+spd[4]*spd[0]*(Ur.Mx-Ul.Mx))*idspd;
+  fdhll = (spd[4]*Fl.d-spd[0]*Fr.d+spd[4]*spd[0]*(Ur->d-Ul->d))*idspd;
+  fmxhll = (spd[4]*Fl.Mx-spd[0]*Fr.Mx+spd[4]*spd[0]*(Ur->Mx-Ul->Mx))*idspd;
 
   /* ustar from paragraph between eqns. (23) and (24) */
   ustar = fdhll/dhll;
 
   /* mx component of U^{hll} from Mignone eqn. (15); paragraph referenced
    * above states that mxhll should NOT be used to compute ustar */
-  mxhll = (spd[4]*Ur.Mx-spd[0]*Ul.Mx-Fr.Mx+Fl.Mx)*idspd;
+  mxhll = (spd[4]*Ur->Mx-spd[0]*Ul->Mx-Fr.Mx+Fl.Mx)*idspd;
 
   /* S*_L and S*_R from Mignone eqn. (29) */
   spd[1] = ustar - fabs(Bxi)/sqrtdhll;
@@ -572,22 +847,22 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
   if ((fabs(spd[0]/spd[1]-1.0) < SMALL_NUMBER) 
         || (fabs(spd[0]/spd[3]-1.0) < SMALL_NUMBER)) {
     /* degenerate case described below eqn. (39) */
-    Ulst.My = Ul.My;
-    Ulst.Mz = Ul.Mz;
-    Ulst.By = Ul.By;
-    Ulst.Bz = Ul.Bz;
+    Ulst.My = Ul->My;
+    Ulst.Mz = Ul->Mz;
+    Ulst.By = Ul->By;
+    Ulst.Bz = Ul->Bz;
   } else {
-    mfact = Bxi*(ustar-Wl.Vx)/tmp;
-    bfact = (Ul.d*SQR(spd[0]-Wl.Vx)-Bxsq)/(dhll*tmp);
+    mfact = Bxi*(ustar-Wl->Vx)/tmp;
+    bfact = (Ul->d*SQR(spd[0]-Wl->Vx)-Bxsq)/(dhll*tmp);
 
     /* eqn. (30) of Mignone */
-    Ulst.My = dhll*Wl.Vy-Ul.By*mfact;
+    Ulst.My = dhll*Wl->Vy-Ul->By*mfact;
     /* eqn. (31) of Mignone */
-    Ulst.Mz = dhll*Wl.Vz-Ul.Bz*mfact;
+    Ulst.Mz = dhll*Wl->Vz-Ul->Bz*mfact;
     /* eqn. (32) of Mignone */
-    Ulst.By = Ul.By*bfact;
+    Ulst.By = Ul->By*bfact;
     /* eqn. (33) of Mignone */
-    Ulst.Bz = Ul.Bz*bfact;
+    Ulst.Bz = Ul->Bz*bfact;
   }
 
 /* Ur* */
@@ -601,22 +876,22 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
   if ((fabs(spd[4]/spd[1]-1.0) < SMALL_NUMBER) 
         || (fabs(spd[4]/spd[3]-1.0) < SMALL_NUMBER)) {
     /* degenerate case described below eqn. (39) */
-    Urst.My = Ur.My;
-    Urst.Mz = Ur.Mz;
-    Urst.By = Ur.By;
-    Urst.Bz = Ur.Bz;
+    Urst.My = Ur->My;
+    Urst.Mz = Ur->Mz;
+    Urst.By = Ur->By;
+    Urst.Bz = Ur->Bz;
   } else {
-    mfact = Bxi*(ustar-Wr.Vx)/tmp;
-    bfact = (Ur.d*SQR(spd[4]-Wr.Vx)-Bxsq)/(dhll*tmp);
+    mfact = Bxi*(ustar-Wr->Vx)/tmp;
+    bfact = (Ur->d*SQR(spd[4]-Wr->Vx)-Bxsq)/(dhll*tmp);
 
     /* eqn. (30) of Mignone */
-    Urst.My = dhll*Wr.Vy-Ur.By*mfact;
+    Urst.My = dhll*Wr->Vy-Ur->By*mfact;
     /* eqn. (31) of Mignone */
-    Urst.Mz = dhll*Wr.Vz-Ur.Bz*mfact;
+    Urst.Mz = dhll*Wr->Vz-Ur->Bz*mfact;
     /* eqn. (32) of Mignone */
-    Urst.By = Ur.By*bfact;
+    Urst.By = Ur->By*bfact;
     /* eqn. (33) of Mignone */
-    Urst.Bz = Ur.Bz*bfact;
+    Urst.Bz = Ur->Bz*bfact;
   }
 
 /* Uc* */
@@ -641,21 +916,21 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 
   if(spd[1] >= 0.0) {
 /* return (Fl+Sl*(Ulst-Ul)), eqn. (38b) of Mignone */
-    pFlux->d  = Fl.d  + spd[0]*(Ulst.d  - Ul.d);
-    pFlux->Mx = Fl.Mx + spd[0]*(Ulst.Mx - Ul.Mx);
-    pFlux->My = Fl.My + spd[0]*(Ulst.My - Ul.My);
-    pFlux->Mz = Fl.Mz + spd[0]*(Ulst.Mz - Ul.Mz);
-    pFlux->By = Fl.By + spd[0]*(Ulst.By - Ul.By);
-    pFlux->Bz = Fl.Bz + spd[0]*(Ulst.Bz - Ul.Bz);
+    pFlux->d  = Fl.d  + spd[0]*(Ulst.d  - Ul->d);
+    pFlux->Mx = Fl.Mx + spd[0]*(Ulst.Mx - Ul->Mx);
+    pFlux->My = Fl.My + spd[0]*(Ulst.My - Ul->My);
+    pFlux->Mz = Fl.Mz + spd[0]*(Ulst.Mz - Ul->Mz);
+    pFlux->By = Fl.By + spd[0]*(Ulst.By - Ul->By);
+    pFlux->Bz = Fl.Bz + spd[0]*(Ulst.Bz - Ul->Bz);
   }
   else if (spd[3] <= 0.0) {
 /* return (Fr+Sr*(Urst-Ur)), eqn. (38d) of Mignone */
-    pFlux->d  = Fr.d  + spd[4]*(Urst.d  - Ur.d);
-    pFlux->Mx = Fr.Mx + spd[4]*(Urst.Mx - Ur.Mx);
-    pFlux->My = Fr.My + spd[4]*(Urst.My - Ur.My);
-    pFlux->Mz = Fr.Mz + spd[4]*(Urst.Mz - Ur.Mz);
-    pFlux->By = Fr.By + spd[4]*(Urst.By - Ur.By);
-    pFlux->Bz = Fr.Bz + spd[4]*(Urst.Bz - Ur.Bz);
+    pFlux->d  = Fr.d  + spd[4]*(Urst.d  - Ur->d);
+    pFlux->Mx = Fr.Mx + spd[4]*(Urst.Mx - Ur->Mx);
+    pFlux->My = Fr.My + spd[4]*(Urst.My - Ur->My);
+    pFlux->Mz = Fr.Mz + spd[4]*(Urst.Mz - Ur->Mz);
+    pFlux->By = Fr.By + spd[4]*(Urst.By - Ur->By);
+    pFlux->Bz = Fr.Bz + spd[4]*(Urst.Bz - Ur->Bz);
   }
   else {
 /* return Fcst, eqn. (38c) of Mignone, using eqn. (24) */
@@ -670,9 +945,9 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 /* Fluxes of passively advected scalars, computed from density flux */
 #if (NSCALARS > 0)
   if (pFlux->d >= 0.0) {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl.r[n];
+    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl->r[n];
   } else {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr.r[n];
+    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr->r[n];
   }
 #endif
 
@@ -680,5 +955,53 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
 }
 
 #endif /* ISOTHERMAL */
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void fluxes(const Cons1DS Ul, const Cons1DS Ur,
+ *           const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
+ *  \brief Compute 1D fluxes at a single interface
+ */
+
+void fluxes(const Cons1DS Ul, const Cons1DS Ur,
+            const Prim1DS Wl, const Prim1DS Wr, const Real Bxi, Cons1DS *pFlux)
+{
+  hlld_flux(&Ul,&Ur,&Wl,&Wr,Bxi,pFlux);
+  return;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                   const Prim1DS *Wl, const Prim1DS *Wr,
+ *                   const Real *Bxi, Cons1DS *pFlux,
+ *                   const int il, const int iu)
+ *  \brief Compute 1D fluxes at interfaces il..iu of a pencil.
+ *
+ * hlld_flux() reads the states through pointers and computes only the
+ * transverse velocities of the L*,R* states, so it is inlined here without
+ * any per-interface copies of the input states.  With SIMD, interfaces are
+ * processed four at a time by hlld_flux_simd() if the CPU supports AVX2; the
+ * remainder of the pencil, and every interface on other CPUs, is done by the
+ * scalar hlld_flux().
+ */
+
+void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                   const Prim1DS *Wl, const Prim1DS *Wr,
+                   const Real *Bxi, Cons1DS *pFlux,
+                   const int il, const int iu)
+{
+  int i=il;
+
+#ifdef HLLD_SIMD
+  if (__builtin_cpu_supports("avx2")) {
+    for (; i+3<=iu; i+=4) hlld_flux_simd(Ul,Ur,Wl,Wr,Bxi,pFlux,i);
+  }
+#endif
+  for (; i<=iu; i++) {
+    hlld_flux(&Ul[i],&Ur[i],&Wl[i],&Wr[i],Bxi[i],&pFlux[i]);
+  }
+
+  return;
+}
+
 #endif /* SPECIAL_RELATIVITY */
 #endif /* HLLD_FLUX */
@@ -26,7 +26,11 @@
  *
  * CONTAINS PUBLIC FUNCTIONS:
  * - fluxes() - all Riemann solvers in Athena must have this function name and
- *              use the same argument list as defined in rsolvers/prototypes.h*/
+ *              use the same argument list as defined in rsolvers/prototypes.h
+ * - fluxes_pencil() - fluxes at every interface of a 1D pencil
+ *
+ * PRIVATE FUNCTION PROTOTYPES:
+ * - hlle_pencil() - HLLE fluxes along a pencil, shared with roe.c */
 /*============================================================================*/
 
 #include <math.h>
@@ -45,69 +49,71 @@
 
 #if defined(HLLE_FLUX) || defined (ROE_FLUX)
 /*----------------------------------------------------------------------------*/
-/*! \fn void HLLE_FUNCTION(const Cons1DS Ul, const Cons1DS Ur,
- *                     const Prim1DS Wl, const Prim1DS Wr,
- *                   const Real Bxi, Cons1DS *pFlux)
- *  \brief HLLE flux function wrapper.
+/*! \fn static void hlle_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                   const Prim1DS *Wl, const Prim1DS *Wr,
+ *                   const Real *Bxi, Cons1DS *pFlux,
+ *                   const int il, const int iu)
+ *  \brief Computes HLLE fluxes at interfaces il..iu of a 1D pencil.
  *
- * - HLLE_FUNCTION=fluxes if HLLE_FLUX defined
- * - HLLE_FUNCTION=hlle_flux if ROE_FLUX defined
+ * The loop body is straight-line code: the two Roe eigenvalues needed for
+ * the wave speed estimates are evaluated inline rather than through the
+ * esys_roe_*() functions, and the upwinding of passive scalars is a select,
+ * so that the compiler can keep the whole pencil in registers.  Results are
+ * identical to evaluating each interface separately.
  *   Input Arguments:
- *  -  Bxi = B in direction of 1D slice at cell interface
- *  -  Ul,Ur = L/R-states of CONSERVED variables at cell interface
+ *  -  Bxi = B in direction of 1D slice at cell interfaces (MHD only)
+ *  -  Ul,Ur = L/R-states of CONSERVED variables at cell interfaces
+ *  -  Wl,Wr = L/R-states of PRIMITIVE variables at cell interfaces
  *   Output Arguments:
- *  -  pFlux = pointer to fluxes of CONSERVED variables at cell interface
+ *  -  pFlux = fluxes of CONSERVED variables at cell interfaces
  */
 
-void HLLE_FUNCTION(const Cons1DS Ul, const Cons1DS Ur,
-                   const Prim1DS Wl, const Prim1DS Wr,
-                   const Real Bxi, Cons1DS *pFlux)
+static void hlle_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                        const Prim1DS *Wl, const Prim1DS *Wr,
+                        const Real *Bxi, Cons1DS *pFlux,
+                        const int il, const int iu)
 {
   Real sqrtdl,sqrtdr,isdlpdr,droe,v1roe,v2roe,v3roe,pbl=0.0,pbr=0.0;
   Real asq,vaxsq=0.0,qsq,cfsq,cfl,cfr,bp,bm,ct2=0.0,tmp;
 #ifndef ISOTHERMAL
-  Real hroe;
+  Real hroe,vsq;
 #endif
 #ifdef MHD
-  Real b2roe,b3roe,x,y;
+  Real Bx,b2roe,b3roe,x,y,di,btsq,bt_starsq,twid_asq,tsum,tdif;
 #endif
-  Real ev[NWAVE],al,ar;
+  Real cfroe,evl,evr,al,ar;
   Real *pFl, *pFr, *pF;
   Cons1DS Fl,Fr;
-  int n;
+  int i,n;
 
+  for (i=il; i<=iu; i++) {
+#ifdef MHD
+    Bx = Bxi[i];
+#endif
 
 /*--- Step 1. ------------------------------------------------------------------
- * Convert left- and right- states in conserved to primitive variables.
- */
-
-/*
-  pbl = Cons1D_to_Prim1D(&Ul,&Wl,&Bxi);
-  pbr = Cons1D_to_Prim1D(&Ur,&Wr,&Bxi);
-*/
-
-/*--- Step 2. ------------------------------------------------------------------
  * Compute Roe-averaged data from left- and right-states
  */
 
-  sqrtdl = sqrt((double)Wl.d);
-  sqrtdr = sqrt((double)Wr.d);
-  isdlpdr = 1.0/(sqrtdl + sqrtdr);
+    sqrtdl = sqrt((double)Wl[i].d);
+    sqrtdr = sqrt((double)Wr[i].d);
+    isdlpdr = 1.0/(sqrtdl + sqrtdr);
 
-  droe  = sqrtdl*sqrtdr;
-  v1roe = (sqrtdl*Wl.Vx + sqrtdr*Wr.Vx)*isdlpdr;
-  v2roe = (sqrtdl*Wl.Vy + sqrtdr*Wr.Vy)*isdlpdr;
-  v3roe = (sqrtdl*Wl.Vz + sqrtdr*Wr.Vz)*isdlpdr;
+    droe  = sqrtdl*sqrtdr;
+    v1roe = (sqrtdl*Wl[i].Vx + sqrtdr*Wr[i].Vx)*isdlpdr;
+    v2roe = (sqrtdl*Wl[i].Vy + sqrtdr*Wr[i].Vy)*isdlpdr;
+    v3roe = (sqrtdl*Wl[i].Vz + sqrtdr*Wr[i].Vz)*isdlpdr;
 
 /* The Roe average of the magnetic field is defined differently.  */
 
 #ifdef MHD
-  b2roe = (sqrtdr*Wl.By + sqrtdl*Wr.By)*isdlpdr;
-  b3roe = (sqrtdr*Wl.Bz + sqrtdl*Wr.Bz)*isdlpdr;
-  x = 0.5*(SQR(Wl.By - Wr.By) + SQR(Wl.Bz - Wr.Bz))/(SQR(sqrtdl + sqrtdr));
-  y = 0.5*(Wl.d + Wr.d)/droe;
-  pbl = 0.5*(SQR(Bxi) + SQR(Wl.By) + SQR(Wl.Bz));
-  pbr = 0.5*(SQR(Bxi) + SQR(Wr.By) + SQR(Wr.Bz));
+    b2roe = (sqrtdr*Wl[i].By + sqrtdl*Wr[i].By)*isdlpdr;
+    b3roe = (sqrtdr*Wl[i].Bz + sqrtdl*Wr[i].Bz)*isdlpdr;
+    x = 0.5*(SQR(Wl[i].By - Wr[i].By) + SQR(Wl[i].Bz - Wr[i].Bz))/
+      (SQR(sqrtdl + sqrtdr));
+    y = 0.5*(Wl[i].d + Wr[i].d)/droe;
+    pbl = 0.5*(SQR(Bx) + SQR(Wl[i].By) + SQR(Wl[i].Bz));
+    pbr = 0.5*(SQR(Bx) + SQR(Wr[i].By) + SQR(Wr[i].Bz));
 #endif
 
 /*
@@ -116,157 +122,220 @@ void HLLE_FUNCTION(const Cons1DS Ul, const Cons1DS Ur,
  */
 
 #ifndef ISOTHERMAL
-  hroe  = ((Ul.E + Wl.P + pbl)/sqrtdl + (Ur.E + Wr.P + pbr)/sqrtdr)*isdlpdr;
+    hroe  = ((Ul[i].E + Wl[i].P + pbl)/sqrtdl +
+             (Ur[i].E + Wr[i].P + pbr)/sqrtdr)*isdlpdr;
 #endif
 
-/*--- Step 3. ------------------------------------------------------------------
- * Compute eigenvalues using Roe-averaged values, needed in step 4.
+/*--- Step 2. ------------------------------------------------------------------
+ * Compute the fastest Roe eigenvalues, needed in step 3.  These are the same
+ * expressions as in esys_roe_*() in esystem_roe.c, which are not called here
+ * since only ev[0] and ev[NWAVE-1] are needed.
  */
 
 #ifdef HYDRO
 #ifdef ISOTHERMAL
-  esys_roe_iso_hyd(v1roe, v2roe, v3roe,       ev, NULL, NULL);
+    cfroe = Iso_csound;
 #else
-  esys_roe_adb_hyd(v1roe, v2roe, v3roe, hroe, ev, NULL, NULL);
+    vsq = v1roe*v1roe + v2roe*v2roe + v3roe*v3roe;
+    asq = Gamma_1*MAX((hroe-0.5*vsq), TINY_NUMBER);
+    cfroe = sqrt(asq);
 #endif /* ISOTHERMAL */
 #endif /* HYDRO */
 
 #ifdef MHD
+    di = 1.0/droe;
+    btsq = b2roe*b2roe + b3roe*b3roe;
+    vaxsq = Bx*Bx*di;
 #ifdef ISOTHERMAL
- esys_roe_iso_mhd(droe,v1roe,v2roe,v3roe,     Bxi,b2roe,b3roe,x,y,ev,NULL,NULL);
+    bt_starsq = btsq*y;
+    twid_asq = Iso_csound2 + x;
 #else
- esys_roe_adb_mhd(droe,v1roe,v2roe,v3roe,hroe,Bxi,b2roe,b3roe,x,y,ev,NULL,NULL);
+    vsq = v1roe*v1roe + v2roe*v2roe + v3roe*v3roe;
+    bt_starsq = (Gamma_1 - Gamma_2*y)*btsq;
+    tmp = hroe - (vaxsq + btsq*di);
+    twid_asq = MAX((Gamma_1*(tmp-0.5*vsq)-Gamma_2*x), TINY_NUMBER);
 #endif /* ISOTHERMAL */
+    ct2 = bt_starsq*di;
+    tsum = vaxsq + ct2 + twid_asq;
+    tdif = vaxsq + ct2 - twid_asq;
+    cfsq = 0.5*(tsum + sqrt((double)(tdif*tdif + 4.0*twid_asq*ct2)));
+    cfroe = sqrt((double)cfsq);
 #endif /* MHD */
 
-/*--- Step 4. ------------------------------------------------------------------
+    evl = v1roe - cfroe;
+    evr = v1roe + cfroe;
+
+/*--- Step 3. ------------------------------------------------------------------
  * Compute the max and min wave speeds
  */
 
 /* left state */
 #ifdef ISOTHERMAL
-  asq = Iso_csound2;
+    asq = Iso_csound2;
 #else
-  asq = Gamma*Wl.P/Wl.d;
+    asq = Gamma*Wl[i].P/Wl[i].d;
 #endif
 #ifdef MHD
-  vaxsq = Bxi*Bxi/Wl.d;
-  ct2 = (Ul.By*Ul.By + Ul.Bz*Ul.Bz)/Wl.d;
+    vaxsq = Bx*Bx/Wl[i].d;
+    ct2 = (Ul[i].By*Ul[i].By + Ul[i].Bz*Ul[i].Bz)/Wl[i].d;
 #endif
-  qsq = vaxsq + ct2 + asq;
-  tmp = vaxsq + ct2 - asq;
-  cfsq = 0.5*(qsq + sqrt((double)(tmp*tmp + 4.0*asq*ct2)));
-  cfl = sqrt((double)cfsq);
+    qsq = vaxsq + ct2 + asq;
+    tmp = vaxsq + ct2 - asq;
+    cfsq = 0.5*(qsq + sqrt((double)(tmp*tmp + 4.0*asq*ct2)));
+    cfl = sqrt((double)cfsq);
 
 /* right state */
 #ifdef ISOTHERMAL
-  asq = Iso_csound2;
+    asq = Iso_csound2;
 #else
-  asq = Gamma*Wr.P/Wr.d; 
+    asq = Gamma*Wr[i].P/Wr[i].d;
 #endif
 #ifdef MHD
-  vaxsq = Bxi*Bxi/Wr.d;
-  ct2 = (Ur.By*Ur.By + Ur.Bz*Ur.Bz)/Wr.d;
+    vaxsq = Bx*Bx/Wr[i].d;
+    ct2 = (Ur[i].By*Ur[i].By + Ur[i].Bz*Ur[i].Bz)/Wr[i].d;
 #endif
-  qsq = vaxsq + ct2 + asq;
-  tmp = vaxsq + ct2 - asq;
-  cfsq = 0.5*(qsq + sqrt((double)(tmp*tmp + 4.0*asq*ct2)));
-  cfr = sqrt((double)cfsq);
+    qsq = vaxsq + ct2 + asq;
+    tmp = vaxsq + ct2 - asq;
+    cfsq = 0.5*(qsq + sqrt((double)(tmp*tmp + 4.0*asq*ct2)));
+    cfr = sqrt((double)cfsq);
 
 /* take max/min of Roe eigenvalues and L/R state wave speeds */
-  ar = MAX(ev[NWAVE-1],(Wr.Vx + cfr));
-  al = MIN(ev[0]      ,(Wl.Vx - cfl));
+    ar = MAX(evr,(Wr[i].Vx + cfr));
+    al = MIN(evl,(Wl[i].Vx - cfl));
 
-  bp = MAX(ar, 0.0);
-  bm = MIN(al, 0.0);
+    bp = MAX(ar, 0.0);
+    bm = MIN(al, 0.0);
 
-/*--- Step 5. ------------------------------------------------------------------
+/*--- Step 4. ------------------------------------------------------------------
  * Compute L/R fluxes along the lines bm/bp: F_{L}-S_{L}U_{L}; F_{R}-S_{R}U_{R}
  */
 
-  Fl.d  = Ul.Mx - bm*Ul.d;
-  Fr.d  = Ur.Mx - bp*Ur.d;
+    Fl.d  = Ul[i].Mx - bm*Ul[i].d;
+    Fr.d  = Ur[i].Mx - bp*Ur[i].d;
 
-  Fl.Mx = Ul.Mx*(Wl.Vx - bm);
-  Fr.Mx = Ur.Mx*(Wr.Vx - bp);
+    Fl.Mx = Ul[i].Mx*(Wl[i].Vx - bm);
+    Fr.Mx = Ur[i].Mx*(Wr[i].Vx - bp);
 
-  Fl.My = Ul.My*(Wl.Vx - bm);
-  Fr.My = Ur.My*(Wr.Vx - bp);
+    Fl.My = Ul[i].My*(Wl[i].Vx - bm);
+    Fr.My = Ur[i].My*(Wr[i].Vx - bp);
 
-  Fl.Mz = Ul.Mz*(Wl.Vx - bm);
-  Fr.Mz = Ur.Mz*(Wr.Vx - bp);
+    Fl.Mz = Ul[i].Mz*(Wl[i].Vx - bm);
+    Fr.Mz = Ur[i].Mz*(Wr[i].Vx - bp);
 
 #ifdef ISOTHERMAL
-  Fl.Mx += Wl.d*Iso_csound2;
-  Fr.Mx += Wr.d*Iso_csound2;
+    Fl.Mx += Wl[i].d*Iso_csound2;
+    Fr.Mx += Wr[i].d*Iso_csound2;
 #else
-  Fl.Mx += Wl.P;
-  Fr.Mx += Wr.P;
+    Fl.Mx += Wl[i].P;
+    Fr.Mx += Wr[i].P;
 
-  Fl.E  = Ul.E*(Wl.Vx - bm) + Wl.P*Wl.Vx;
-  Fr.E  = Ur.E*(Wr.Vx - bp) + Wr.P*Wr.Vx;
+    Fl.E  = Ul[i].E*(Wl[i].Vx - bm) + Wl[i].P*Wl[i].Vx;
+    Fr.E  = Ur[i].E*(Wr[i].Vx - bp) + Wr[i].P*Wr[i].Vx;
 #endif /* ISOTHERMAL */
 
 #ifdef MHD
-  Fl.Mx -= 0.5*(Bxi*Bxi - SQR(Wl.By) - SQR(Wl.Bz));
-  Fr.Mx -= 0.5*(Bxi*Bxi - SQR(Wr.By) - SQR(Wr.Bz));
+    Fl.Mx -= 0.5*(Bx*Bx - SQR(Wl[i].By) - SQR(Wl[i].Bz));
+    Fr.Mx -= 0.5*(Bx*Bx - SQR(Wr[i].By) - SQR(Wr[i].Bz));
 
-  Fl.My -= Bxi*Wl.By;
-  Fr.My -= Bxi*Wr.By;
-    
-  Fl.Mz -= Bxi*Wl.Bz;
-  Fr.Mz -= Bxi*Wr.Bz;
+    Fl.My -= Bx*Wl[i].By;
+    Fr.My -= Bx*Wr[i].By;
+
+    Fl.Mz -= Bx*Wl[i].Bz;
+    Fr.Mz -= Bx*Wr[i].Bz;
 
 #ifndef ISOTHERMAL
-  Fl.E += (pbl*Wl.Vx - Bxi*(Bxi*Wl.Vx + Wl.By*Wl.Vy + Wl.Bz*Wl.Vz));
-  Fr.E += (pbr*Wr.Vx - Bxi*(Bxi*Wr.Vx + Wr.By*Wr.Vy + Wr.Bz*Wr.Vz));
+    Fl.E += (pbl*Wl[i].Vx - Bx*(Bx*Wl[i].Vx + Wl[i].By*Wl[i].Vy
+                                            + Wl[i].Bz*Wl[i].Vz));
+    Fr.E += (pbr*Wr[i].Vx - Bx*(Bx*Wr[i].Vx + Wr[i].By*Wr[i].Vy
+                                            + Wr[i].Bz*Wr[i].Vz));
 #endif /* ISOTHERMAL */
 
-  Fl.By = Wl.By*(Wl.Vx - bm) - Bxi*Wl.Vy;
-  Fr.By = Wr.By*(Wr.Vx - bp) - Bxi*Wr.Vy;
+    Fl.By = Wl[i].By*(Wl[i].Vx - bm) - Bx*Wl[i].Vy;
+    Fr.By = Wr[i].By*(Wr[i].Vx - bp) - Bx*Wr[i].Vy;
 
-  Fl.Bz = Wl.Bz*(Wl.Vx - bm) - Bxi*Wl.Vz;
-  Fr.Bz = Wr.Bz*(Wr.Vx - bp) - Bxi*Wr.Vz;
+    Fl.Bz = Wl[i].Bz*(Wl[i].Vx - bm) - Bx*Wl[i].Vz;
+    Fr.Bz = Wr[i].Bz*(Wr[i].Vx - bp) - Bx*Wr[i].Vz;
 #endif /* MHD */
 
 #ifdef CYLINDRICAL
 #ifndef ISOTHERMAL
-  Fl.Pflux = Wl.P;
-  Fr.Pflux = Wr.P;
+    Fl.Pflux = Wl[i].P;
+    Fr.Pflux = Wr[i].P;
 #ifdef MHD
-  Fl.Pflux += pbl;
-  Fr.Pflux += pbr;
+    Fl.Pflux += pbl;
+    Fr.Pflux += pbr;
 #endif /* MHD */
 #endif /* ISOTHERMAL */
 #endif /* CYLINDRICAL */
 
-/*--- Step 6. ------------------------------------------------------------------
+/*--- Step 5. ------------------------------------------------------------------
  * Compute the HLLE flux at interface.
  */
 
-  pFl = (Real *)&(Fl);
-  pFr = (Real *)&(Fr);
-  pF  = (Real *)pFlux;
-  tmp = 0.5*(bp + bm)/(bp - bm);
-  for (n=0; n<NWAVE; n++){
-    pF[n] = 0.5*(pFl[n] + pFr[n]) + (pFl[n] - pFr[n])*tmp;
-  }
+    pFl = (Real *)&(Fl);
+    pFr = (Real *)&(Fr);
+    pF  = (Real *)&(pFlux[i]);
+    tmp = 0.5*(bp + bm)/(bp - bm);
+    for (n=0; n<NWAVE; n++){
+      pF[n] = 0.5*(pFl[n] + pFr[n]) + (pFl[n] - pFr[n])*tmp;
+    }
 
 /* Fluxes of passively advected scalars, computed from density flux */
 #if (NSCALARS > 0)
-  if (pFlux->d >= 0.0) {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wl.r[n];
-  } else {
-    for (n=0; n<NSCALARS; n++) pFlux->s[n] = pFlux->d*Wr.r[n];
-  }
+    for (n=0; n<NSCALARS; n++) {
+      pFlux[i].s[n] = pFlux[i].d*(pFlux[i].d >= 0.0 ? Wl[i].r[n] : Wr[i].r[n]);
+    }
 #endif
 
 #ifdef CYLINDRICAL
-  n = NWAVE+NSCALARS;
-  pF[n] = 0.5*(pFl[n] + pFr[n]) + (pFl[n] - pFr[n])*tmp;
-#endif 
+    n = NWAVE+NSCALARS;
+    pF[n] = 0.5*(pFl[n] + pFr[n]) + (pFl[n] - pFr[n])*tmp;
+#endif
+  }
 
   return;
 }
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void HLLE_FUNCTION(const Cons1DS Ul, const Cons1DS Ur,
+ *                     const Prim1DS Wl, const Prim1DS Wr,
+ *                   const Real Bxi, Cons1DS *pFlux)
+ *  \brief HLLE flux function wrapper.
+ *
+ * - HLLE_FUNCTION=fluxes if HLLE_FLUX defined
+ * - HLLE_FUNCTION=hlle_flux if ROE_FLUX defined
+ *   Input Arguments:
+ *  -  Bxi = B in direction of 1D slice at cell interface
+ *  -  Ul,Ur = L/R-states of CONSERVED variables at cell interface
+ *   Output Arguments:
+ *  -  pFlux = pointer to fluxes of CONSERVED variables at cell interface
+ */
+
+void HLLE_FUNCTION(const Cons1DS Ul, const Cons1DS Ur,
+                   const Prim1DS Wl, const Prim1DS Wr,
+                   const Real Bxi, Cons1DS *pFlux)
+{
+  hlle_pencil(&Ul,&Ur,&Wl,&Wr,&Bxi,pFlux,0,0);
+  return;
+}
+
+#ifdef HLLE_FLUX
+/*----------------------------------------------------------------------------*/
+/*! \fn void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+ *                   const Prim1DS *Wl, const Prim1DS *Wr,
+ *                   const Real *Bxi, Cons1DS *pFlux,
+ *                   const int il, const int iu)
+ *  \brief Computes HLLE fluxes at interfaces il..iu of a 1D pencil.
+ */
+
+void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                   const Prim1DS *Wl, const Prim1DS *Wr,
+                   const Real *Bxi, Cons1DS *pFlux,
+                   const int il, const int iu)
+{
+  hlle_pencil(Ul,Ur,Wl,Wr,Bxi,pFlux,il,iu);
+  return;
+}
+#endif /* HLLE_FLUX */
 #endif /* HLLE_FLUX */
 #endif
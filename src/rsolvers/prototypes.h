@@ -37,6 +37,16 @@ void fluxes(const Cons1DS Ul, const Cons1DS Ur,
             const Prim1DS Wl, const Prim1DS Wr,
             const Real Bxi, Cons1DS *pF);
 
+/* Fluxes at interfaces il..iu of a 1D pencil of contiguous L/R states.  Bxi
+ * is only referenced for MHD.  Defined in hlle.c, hllc.c and hlld.c, and for
+ * all other solvers in fluxes_pencil.c.  The H-correction passes etah to the
+ * Roe solver as a global that changes from one interface to the next, so the
+ * integrators still call fluxes() per interface when H_CORRECTION is set. */
+void fluxes_pencil(const Cons1DS *Ul, const Cons1DS *Ur,
+                   const Prim1DS *Wl, const Prim1DS *Wr,
+                   const Real *Bxi, Cons1DS *pF,
+                   const int il, const int iu);
+
 #ifdef SPECIAL_RELATIVITY
 void entropy_flux (const Cons1DS Ul, const Cons1DS Ur,
 		   const Prim1DS Wl, const Prim1DS Wr,
@@ -141,6 +141,30 @@ void show_config(void)
   ath_pout(0," Precision:               DOUBLE_PREC\n");
 #endif
 
+#ifdef MIXED_PREC
+  ath_pout(0," Mixed precision storage: ON\n");
+#else
+  ath_pout(0," Mixed precision storage: OFF\n");
+#endif
+
+#if defined(CONS_SOA)
+  ath_pout(0," Conserved var storage:   SoA\n");
+#else
+  ath_pout(0," Conserved var storage:   AoS\n");
+#endif
+
+#ifdef SIMD
+  ath_pout(0," SIMD kernels:            ON\n");
+#else
+  ath_pout(0," SIMD kernels:            OFF\n");
+#endif
+
+#ifdef PRIM_CACHE
+  ath_pout(0," Primitive cache:         ON\n");
+#else
+  ath_pout(0," Primitive cache:         OFF\n");
+#endif
+
 #ifdef WRITE_GHOST_CELLS
   ath_pout(0," Ghost cell Output:       ON\n");
 #else
@@ -153,6 +177,30 @@ void show_config(void)
   ath_pout(0," Parallel Modes: MPI:     OFF\n");
 #endif
 
+#if defined(OPENMP)
+  ath_pout(0," Parallel Modes: OpenMP:  ON\n");
+#else
+  ath_pout(0," Parallel Modes: OpenMP:  OFF\n");
+#endif
+
+#ifdef ARRAY_PADDING
+  ath_pout(0," Array padding:           ON\n");
+#else
+  ath_pout(0," Array padding:           OFF\n");
+#endif
+
+#ifdef HUGE_PAGES
+  ath_pout(0," Huge pages:              ON\n");
+#else
+  ath_pout(0," Huge pages:              OFF\n");
+#endif
+
+#ifdef PERF_COUNTERS
+  ath_pout(0," Performance counters:    ON\n");
+#else
+  ath_pout(0," Performance counters:    OFF\n");
+#endif
+
 #ifdef H_CORRECTION
   ath_pout(0," H-correction:            ON\n");
 #else
@@ -165,6 +213,12 @@ void show_config(void)
   ath_pout(0," FFT:                     OFF\n");
 #endif
 
+#ifdef FFT_PENCIL
+  ath_pout(0," FFT pencil transposes:   ON\n");
+#else
+  ath_pout(0," FFT pencil transposes:   OFF\n");
+#endif
+
 #ifdef SHEARING_BOX
   ath_pout(0," Shearing Box:            ON\n");
 #else
@@ -307,6 +361,30 @@ void show_config_par(void)
   par_sets("configure","precision","double","Type of Real variables");
 #endif
 
+#ifdef MIXED_PREC
+  par_sets("configure","mixed","yes","Single-precision storage of Grid arrays?");
+#else
+  par_sets("configure","mixed","no","Single-precision storage of Grid arrays?");
+#endif
+
+#if defined(CONS_SOA)
+  par_sets("configure","storage","soa","Storage of conserved variables");
+#else
+  par_sets("configure","storage","aos","Storage of conserved variables");
+#endif
+
+#ifdef SIMD
+  par_sets("configure","simd","yes","Explicitly vectorized kernels?");
+#else
+  par_sets("configure","simd","no","Explicitly vectorized kernels?");
+#endif
+
+#ifdef PRIM_CACHE
+  par_sets("configure","prim_cache","yes","Cache of primitive variables?");
+#else
+  par_sets("configure","prim_cache","no","Cache of primitive variables?");
+#endif
+
 #ifdef WRITE_GHOST_CELLS
   par_sets("configure","write_ghost","yes","Ghost cells included in output?");
 #else
@@ -319,6 +397,30 @@ void show_config_par(void)
   par_sets("configure","mpi","no","Is code MPI parallel enabled?");
 #endif
 
+#if defined(OPENMP)
+  par_sets("configure","openmp","yes","Is code OpenMP threaded?");
+#else
+  par_sets("configure","openmp","no","Is code OpenMP threaded?");
+#endif
+
+#ifdef ARRAY_PADDING
+  par_sets("configure","array_padding","yes","Rows of 3D arrays padded?");
+#else
+  par_sets("configure","array_padding","no","Rows of 3D arrays padded?");
+#endif
+
+#ifdef HUGE_PAGES
+  par_sets("configure","hugepages","yes","Huge pages for large arrays?");
+#else
+  par_sets("configure","hugepages","no","Huge pages for large arrays?");
+#endif
+
+#ifdef PERF_COUNTERS
+  par_sets("configure","perf_counters","yes","Hardware counters per kernel?");
+#else
+  par_sets("configure","perf_counters","no","Hardware counters per kernel?");
+#endif
+
 #ifdef H_CORRECTION
   par_sets("configure","H-correction","yes","H-correction enabled?");
 #else
@@ -331,6 +433,12 @@ void show_config_par(void)
   par_sets("configure","FFT","no","FFT enabled?");
 #endif
 
+#ifdef FFT_PENCIL
+  par_sets("configure","FFTPencil","yes","FFT pencil transposes enabled?");
+#else
+  par_sets("configure","FFTPencil","no","FFT pencil transposes enabled?");
+#endif
+
 #ifdef SHEARING_BOX
   par_sets("configure","ShearingBox","yes","Shearing box enabled?");
 #else
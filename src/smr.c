@@ -168,7 +168,9 @@ void RestrictCorrect(MeshS *pM)
  * in any order. */
 
         mCount = pG->NCGrid - pG->NmyCGrid - nZeroRC;
+        ath_trace_begin("RestCorr_wait");
         ierr = MPI_Waitany(mCount,recv_rq[nl][nd],&mIndex,MPI_STATUS_IGNORE);
+        ath_trace_end("RestCorr_wait");
         if(mIndex == MPI_UNDEFINED){
           ath_error("[RestCorr]: Invalid request index nl=%i nd=%i\n",nl,nd);
         }
@@ -206,20 +208,20 @@ void RestrictCorrect(MeshS *pM)
       for (k=kcs; k<=kce; k++) {
         for (j=jcs; j<=jce; j++) {
           for (i=ics; i<=ice; i++) {
-            pG->U[k][j][i].d  = *(pRcv++);
-            pG->U[k][j][i].M1 = *(pRcv++);
-            pG->U[k][j][i].M2 = *(pRcv++);
-            pG->U[k][j][i].M3 = *(pRcv++);
+            UVAR(pG->U,k,j,i,d)  = *(pRcv++);
+            UVAR(pG->U,k,j,i,M1) = *(pRcv++);
+            UVAR(pG->U,k,j,i,M2) = *(pRcv++);
+            UVAR(pG->U,k,j,i,M3) = *(pRcv++);
 #ifndef BAROTROPIC
-            pG->U[k][j][i].E  = *(pRcv++);
+            UVAR(pG->U,k,j,i,E)  = *(pRcv++);
 #endif /* BAROTROPIC */
 #ifdef MHD
-            pG->U[k][j][i].B1c = *(pRcv++);
-            pG->U[k][j][i].B2c = *(pRcv++);
-            pG->U[k][j][i].B3c = *(pRcv++);
+            UVAR(pG->U,k,j,i,B1c) = *(pRcv++);
+            UVAR(pG->U,k,j,i,B2c) = *(pRcv++);
+            UVAR(pG->U,k,j,i,B3c) = *(pRcv++);
 #endif /* MHD */
 #if (NSCALARS > 0)
-            for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] = *(pRcv++);
+            for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) = *(pRcv++);
 #endif
           }
         }
@@ -233,9 +235,9 @@ void RestrictCorrect(MeshS *pM)
 
       if (nDim == 1){ /* 1D problem - set face-centered to cell-centered */
         for (i=ics; i<=ice; i++) {
-          pG->B1i[kcs][jcs][i] = pG->U[kcs][jcs][i].B1c;
-          pG->B2i[kcs][jcs][i] = pG->U[kcs][jcs][i].B2c;
-          pG->B3i[kcs][jcs][i] = pG->U[kcs][jcs][i].B3c;
+          pG->B1i[kcs][jcs][i] = UVAR(pG->U,kcs,jcs,i,B1c);
+          pG->B2i[kcs][jcs][i] = UVAR(pG->U,kcs,jcs,i,B2c);
+          pG->B3i[kcs][jcs][i] = UVAR(pG->U,kcs,jcs,i,B3c);
         }
       } else {
 
@@ -287,9 +289,9 @@ void RestrictCorrect(MeshS *pM)
 /* Set cell-centered fields */
           for (j=jcs; j<=jce; j++) {
           for (i=ics; i<=ice; i++) {
-            pG->U[kcs][j][i].B1c=0.5*(pG->B1i[kcs][j][i] +pG->B1i[kcs][j][i+1]);
-            pG->U[kcs][j][i].B2c=0.5*(pG->B2i[kcs][j][i] +pG->B2i[kcs][j+1][i]);
-            pG->B3i[kcs][j][i] = pG->U[kcs][j][i].B3c;
+            UVAR(pG->U,kcs,j,i,B1c)=0.5*(pG->B1i[kcs][j][i] +pG->B1i[kcs][j][i+1]);
+            UVAR(pG->U,kcs,j,i,B2c)=0.5*(pG->B2i[kcs][j][i] +pG->B2i[kcs][j+1][i]);
+            pG->B3i[kcs][j][i] = UVAR(pG->U,kcs,j,i,B3c);
           }}
 
         } else { /* 3D problem */
@@ -368,9 +370,9 @@ void RestrictCorrect(MeshS *pM)
           for (k=kcs; k<=kce; k++) {
           for (j=jcs; j<=jce; j++) {
           for (i=ics; i<=ice; i++) {
-            pG->U[k][j][i].B1c = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
-            pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
-            pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
+            UVAR(pG->U,k,j,i,B1c) = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
+            UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
+            UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
           }}}
 
         }
@@ -392,20 +394,20 @@ void RestrictCorrect(MeshS *pM)
           if (dim == 1) {i=ice+1; q1= (pG->dt/pG->dx1);}
           for (k=kcs, kk=0; k<=kce; k++, kk++) {
           for (j=jcs, jj=0; j<=jce; j++, jj++) {
-            pG->U[k][j][i].d  -= q1*(pCO->myFlx[dim][kk][jj].d  - *(pRcv++));
-            pG->U[k][j][i].M1 -= q1*(pCO->myFlx[dim][kk][jj].M1 - *(pRcv++));
-            pG->U[k][j][i].M2 -= q1*(pCO->myFlx[dim][kk][jj].M2 - *(pRcv++));
-            pG->U[k][j][i].M3 -= q1*(pCO->myFlx[dim][kk][jj].M3 - *(pRcv++));
+            UVAR(pG->U,k,j,i,d)  -= q1*(pCO->myFlx[dim][kk][jj].d  - *(pRcv++));
+            UVAR(pG->U,k,j,i,M1) -= q1*(pCO->myFlx[dim][kk][jj].M1 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M2) -= q1*(pCO->myFlx[dim][kk][jj].M2 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M3) -= q1*(pCO->myFlx[dim][kk][jj].M3 - *(pRcv++));
 #ifndef BAROTROPIC
-            pG->U[k][j][i].E  -= q1*(pCO->myFlx[dim][kk][jj].E  - *(pRcv++));
+            UVAR(pG->U,k,j,i,E)  -= q1*(pCO->myFlx[dim][kk][jj].E  - *(pRcv++));
 #endif /* BAROTROPIC */
 #ifdef MHD
-            pG->U[k][j][i].B1c -= q1*(pCO->myFlx[dim][kk][jj].B1c - *(pRcv++));
-            pG->U[k][j][i].B2c -= q1*(pCO->myFlx[dim][kk][jj].B2c - *(pRcv++));
-            pG->U[k][j][i].B3c -= q1*(pCO->myFlx[dim][kk][jj].B3c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B1c) -= q1*(pCO->myFlx[dim][kk][jj].B1c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B2c) -= q1*(pCO->myFlx[dim][kk][jj].B2c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B3c) -= q1*(pCO->myFlx[dim][kk][jj].B3c - *(pRcv++));
 #endif /* MHD */
 #if (NSCALARS > 0)
-            for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] -= 
+            for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) -= 
               q1*(pCO->myFlx[dim][kk][jj].s[n] - *(pRcv++));
 #endif
           }}
@@ -420,20 +422,20 @@ void RestrictCorrect(MeshS *pM)
           if (dim == 3) {j=jce+1; q2= (pG->dt/pG->dx2);}
           for (k=kcs, kk=0; k<=kce; k++, kk++) {
           for (i=ics, ii=0; i<=ice; i++, ii++) {
-            pG->U[k][j][i].d  -= q2*(pCO->myFlx[dim][kk][ii].d  - *(pRcv++));
-            pG->U[k][j][i].M1 -= q2*(pCO->myFlx[dim][kk][ii].M1 - *(pRcv++));
-            pG->U[k][j][i].M2 -= q2*(pCO->myFlx[dim][kk][ii].M2 - *(pRcv++));
-            pG->U[k][j][i].M3 -= q2*(pCO->myFlx[dim][kk][ii].M3 - *(pRcv++));
+            UVAR(pG->U,k,j,i,d)  -= q2*(pCO->myFlx[dim][kk][ii].d  - *(pRcv++));
+            UVAR(pG->U,k,j,i,M1) -= q2*(pCO->myFlx[dim][kk][ii].M1 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M2) -= q2*(pCO->myFlx[dim][kk][ii].M2 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M3) -= q2*(pCO->myFlx[dim][kk][ii].M3 - *(pRcv++));
 #ifndef BAROTROPIC
-            pG->U[k][j][i].E  -= q2*(pCO->myFlx[dim][kk][ii].E  - *(pRcv++));
+            UVAR(pG->U,k,j,i,E)  -= q2*(pCO->myFlx[dim][kk][ii].E  - *(pRcv++));
 #endif /* BAROTROPIC */
 #ifdef MHD
-            pG->U[k][j][i].B1c -= q2*(pCO->myFlx[dim][kk][ii].B1c - *(pRcv++));
-            pG->U[k][j][i].B2c -= q2*(pCO->myFlx[dim][kk][ii].B2c - *(pRcv++));
-            pG->U[k][j][i].B3c -= q2*(pCO->myFlx[dim][kk][ii].B3c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B1c) -= q2*(pCO->myFlx[dim][kk][ii].B1c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B2c) -= q2*(pCO->myFlx[dim][kk][ii].B2c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B3c) -= q2*(pCO->myFlx[dim][kk][ii].B3c - *(pRcv++));
 #endif /* MHD */
 #if (NSCALARS > 0)
-            for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] -= 
+            for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) -= 
               q2*(pCO->myFlx[dim][kk][ii].s[n] - *(pRcv++));
 #endif
           }}
@@ -448,20 +450,20 @@ void RestrictCorrect(MeshS *pM)
           if (dim == 5) {k=kce+1; q3= (pG->dt/pG->dx3);}
           for (j=jcs, jj=0; j<=jce; j++, jj++) {
           for (i=ics, ii=0; i<=ice; i++, ii++) {
-            pG->U[k][j][i].d  -= q3*(pCO->myFlx[dim][jj][ii].d  - *(pRcv++));
-            pG->U[k][j][i].M1 -= q3*(pCO->myFlx[dim][jj][ii].M1 - *(pRcv++));
-            pG->U[k][j][i].M2 -= q3*(pCO->myFlx[dim][jj][ii].M2 - *(pRcv++));
-            pG->U[k][j][i].M3 -= q3*(pCO->myFlx[dim][jj][ii].M3 - *(pRcv++));
+            UVAR(pG->U,k,j,i,d)  -= q3*(pCO->myFlx[dim][jj][ii].d  - *(pRcv++));
+            UVAR(pG->U,k,j,i,M1) -= q3*(pCO->myFlx[dim][jj][ii].M1 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M2) -= q3*(pCO->myFlx[dim][jj][ii].M2 - *(pRcv++));
+            UVAR(pG->U,k,j,i,M3) -= q3*(pCO->myFlx[dim][jj][ii].M3 - *(pRcv++));
 #ifndef BAROTROPIC
-            pG->U[k][j][i].E  -= q3*(pCO->myFlx[dim][jj][ii].E  - *(pRcv++));
+            UVAR(pG->U,k,j,i,E)  -= q3*(pCO->myFlx[dim][jj][ii].E  - *(pRcv++));
 #endif /* BAROTROPIC */
 #ifdef MHD
-            pG->U[k][j][i].B1c -= q3*(pCO->myFlx[dim][jj][ii].B1c - *(pRcv++));
-            pG->U[k][j][i].B2c -= q3*(pCO->myFlx[dim][jj][ii].B2c - *(pRcv++));
-            pG->U[k][j][i].B3c -= q3*(pCO->myFlx[dim][jj][ii].B3c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B1c) -= q3*(pCO->myFlx[dim][jj][ii].B1c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B2c) -= q3*(pCO->myFlx[dim][jj][ii].B2c - *(pRcv++));
+            UVAR(pG->U,k,j,i,B3c) -= q3*(pCO->myFlx[dim][jj][ii].B3c - *(pRcv++));
 #endif /* MHD */
 #if (NSCALARS > 0)
-            for (n=0; n<NSCALARS; n++) pG->U[k][j][i].s[n] -= 
+            for (n=0; n<NSCALARS; n++) UVAR(pG->U,k,j,i,s[n]) -= 
               q3*(pCO->myFlx[dim][jj][ii].s[n] - *(pRcv++));
 #endif
           }}
@@ -576,18 +578,18 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
 
             for (k=kcs-1; k<=kce+1; k++) {
             for (j=jcs; j<=jce; j++) {
-              pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
+              UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
             }}
 
           }
 
           for (k=kcs; k<=kce; k++) {
             for (j=jcs; j<=jce; j++) {
-              pG->U[k][j][ib  ].B1c=0.5*(pG->B1i[k][j][ib]+pG->B1i[k][j][ib+1]);
-              pG->U[k][j][ib-1].B1c=0.5*(pG->B1i[k][j][ib-1]+pG->B1i[k][j][ib]);
+              UVAR(pG->U,k,j,ib,B1c)=0.5*(pG->B1i[k][j][ib]+pG->B1i[k][j][ib+1]);
+              UVAR(pG->U,k,j,ib-1,B1c)=0.5*(pG->B1i[k][j][ib-1]+pG->B1i[k][j][ib]);
             }
             for (j=jcs-1; j<=jce+1; j++) {
-              pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
+              UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
             }
           }
         }
@@ -686,18 +688,18 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
 
             for (k=kcs-1; k<=kce+1; k++) {
             for (i=ics; i<=ice; i++) {
-              pG->U[k][j][i].B3c = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
+              UVAR(pG->U,k,j,i,B3c) = 0.5*(pG->B3i[k][j][i] + pG->B3i[k+1][j][i]);
             }}
 
           }
 
           for (k=kcs; k<=kce; k++) {
             for (i=ics-1; i<=ice+1; i++) {
-              pG->U[k][j][i].B1c = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
+              UVAR(pG->U,k,j,i,B1c) = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
             }
             for (i=ics; i<=ice; i++) {
-              pG->U[k][jb  ][i].B2c=0.5*(pG->B2i[k][jb][i]+pG->B2i[k][jb+1][i]);
-              pG->U[k][jb-1][i].B2c=0.5*(pG->B2i[k][jb-1][i]+pG->B2i[k][jb][i]);
+              UVAR(pG->U,k,jb,i,B2c)=0.5*(pG->B2i[k][jb][i]+pG->B2i[k][jb+1][i]);
+              UVAR(pG->U,k,jb-1,i,B2c)=0.5*(pG->B2i[k][jb-1][i]+pG->B2i[k][jb][i]);
             }
           }
         }
@@ -786,18 +788,18 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
 
           for (j=jcs; j<=jce; j++) {
           for (i=ics-1; i<=ice+1; i++) {
-            pG->U[k][j][i].B1c = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
+            UVAR(pG->U,k,j,i,B1c) = 0.5*(pG->B1i[k][j][i] + pG->B1i[k][j][i+1]);
           }}
 
           for (j=jcs-1; j<=jce+1; j++) {
           for (i=ics; i<=ice; i++) {
-            pG->U[k][j][i].B2c = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
+            UVAR(pG->U,k,j,i,B2c) = 0.5*(pG->B2i[k][j][i] + pG->B2i[k][j+1][i]);
           }}
 
           for (j=jcs; j<=jce; j++) {
           for (i=ics; i<=ice; i++) {
-            pG->U[kb  ][j][i].B3c=0.5*(pG->B3i[kb][j][i] + pG->B3i[kb+1][j][i]);
-            pG->U[kb-1][j][i].B3c=0.5*(pG->B3i[kb-1][j][i] + pG->B3i[kb][j][i]);
+            UVAR(pG->U,kb,j,i,B3c)=0.5*(pG->B3i[kb][j][i] + pG->B3i[kb+1][j][i]);
+            UVAR(pG->U,kb-1,j,i,B3c)=0.5*(pG->B3i[kb-1][j][i] + pG->B3i[kb][j][i]);
           }}
         }
       }
@@ -850,21 +852,21 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
       for (k=kps; k<=kpe; k+=2) {
       for (j=jps; j<=jpe; j+=2) {
       for (i=ips; i<=ipe; i+=2) {
-        *(pSnd++) = pG->U[k][j][i].d  + pG->U[k][j][i+1].d;
-        *(pSnd++) = pG->U[k][j][i].M1 + pG->U[k][j][i+1].M1;
-        *(pSnd++) = pG->U[k][j][i].M2 + pG->U[k][j][i+1].M2;
-        *(pSnd++) = pG->U[k][j][i].M3 + pG->U[k][j][i+1].M3;
+        *(pSnd++) = UVAR(pG->U,k,j,i,d)  + UVAR(pG->U,k,j,i+1,d);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M1) + UVAR(pG->U,k,j,i+1,M1);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M2) + UVAR(pG->U,k,j,i+1,M2);
+        *(pSnd++) = UVAR(pG->U,k,j,i,M3) + UVAR(pG->U,k,j,i+1,M3);
 #ifndef BAROTROPIC
-        *(pSnd++) = pG->U[k][j][i].E  + pG->U[k][j][i+1].E;
+        *(pSnd++) = UVAR(pG->U,k,j,i,E)  + UVAR(pG->U,k,j,i+1,E);
 #endif
 #ifdef MHD
-        *(pSnd++) = pG->U[k][j][i].B1c + pG->U[k][j][i+1].B1c;
-        *(pSnd++) = pG->U[k][j][i].B2c + pG->U[k][j][i+1].B2c;
-        *(pSnd++) = pG->U[k][j][i].B3c + pG->U[k][j][i+1].B3c;
+        *(pSnd++) = UVAR(pG->U,k,j,i,B1c) + UVAR(pG->U,k,j,i+1,B1c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B2c) + UVAR(pG->U,k,j,i+1,B2c);
+        *(pSnd++) = UVAR(pG->U,k,j,i,B3c) + UVAR(pG->U,k,j,i+1,B3c);
 #endif
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++) 
-          *(pSnd++) = pG->U[k][j][i].s[n] + pG->U[k][j][i+1].s[n];
+          *(pSnd++) = UVAR(pG->U,k,j,i,s[n]) + UVAR(pG->U,k,j,i+1,s[n]);
 #endif
       }}}
       fact = 0.5;
@@ -877,21 +879,21 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
         for (k=kps; k<=kpe; k+=2) {
         for (j=jps; j<=jpe; j+=2) {
         for (i=ips; i<=ipe; i+=2) {
-          *(pSnd++) += pG->U[k][j+1][i].d  + pG->U[k][j+1][i+1].d;
-          *(pSnd++) += pG->U[k][j+1][i].M1 + pG->U[k][j+1][i+1].M1;
-          *(pSnd++) += pG->U[k][j+1][i].M2 + pG->U[k][j+1][i+1].M2;
-          *(pSnd++) += pG->U[k][j+1][i].M3 + pG->U[k][j+1][i+1].M3;
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,d)  + UVAR(pG->U,k,j+1,i+1,d);
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,M1) + UVAR(pG->U,k,j+1,i+1,M1);
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,M2) + UVAR(pG->U,k,j+1,i+1,M2);
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,M3) + UVAR(pG->U,k,j+1,i+1,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) += pG->U[k][j+1][i].E  + pG->U[k][j+1][i+1].E;
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,E)  + UVAR(pG->U,k,j+1,i+1,E);
 #endif
 #ifdef MHD
-          *(pSnd++) += pG->U[k][j+1][i].B1c + pG->U[k][j+1][i+1].B1c;
-          *(pSnd++) += pG->U[k][j+1][i].B2c + pG->U[k][j+1][i+1].B2c;
-          *(pSnd++) += pG->U[k][j+1][i].B3c + pG->U[k][j+1][i+1].B3c;
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,B1c) + UVAR(pG->U,k,j+1,i+1,B1c);
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,B2c) + UVAR(pG->U,k,j+1,i+1,B2c);
+          *(pSnd++) += UVAR(pG->U,k,j+1,i,B3c) + UVAR(pG->U,k,j+1,i+1,B3c);
 #endif
 #if (NSCALARS > 0)
           for (n=0; n<NSCALARS; n++) 
-            *(pSnd++) += pG->U[k][j+1][i].s[n] + pG->U[k][j+1][i+1].s[n];
+            *(pSnd++) += UVAR(pG->U,k,j+1,i,s[n]) + UVAR(pG->U,k,j+1,i+1,s[n]);
 #endif
         }}}
         fact = 0.25;
@@ -905,30 +907,30 @@ printf("js,je = %i %i jcs/jce = %i %i\n",pG->js,pG->je,jcs,jce);
         for (k=kps; k<=kpe; k+=2) {
         for (j=jps; j<=jpe; j+=2) {
         for (i=ips; i<=ipe; i+=2) {
-          *(pSnd++) += pG->U[k+1][j  ][i].d  + pG->U[k+1][j  ][i+1].d +
-                       pG->U[k+1][j+1][i].d  + pG->U[k+1][j+1][i+1].d;
-          *(pSnd++) += pG->U[k+1][j  ][i].M1 + pG->U[k+1][j  ][i+1].M1 +
-                       pG->U[k+1][j+1][i].M1 + pG->U[k+1][j+1][i+1].M1;
-          *(pSnd++) += pG->U[k+1][j  ][i].M2 + pG->U[k+1][j  ][i+1].M2 +
-                       pG->U[k+1][j+1][i].M2 + pG->U[k+1][j+1][i+1].M2;
-          *(pSnd++) += pG->U[k+1][j  ][i].M3 + pG->U[k+1][j  ][i+1].M3 +
-                       pG->U[k+1][j+1][i].M3 + pG->U[k+1][j+1][i+1].M3;
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,d)  + UVAR(pG->U,k+1,j,i+1,d) +
+                       UVAR(pG->U,k+1,j+1,i,d)  + UVAR(pG->U,k+1,j+1,i+1,d);
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,M1) + UVAR(pG->U,k+1,j,i+1,M1) +
+                       UVAR(pG->U,k+1,j+1,i,M1) + UVAR(pG->U,k+1,j+1,i+1,M1);
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,M2) + UVAR(pG->U,k+1,j,i+1,M2) +
+                       UVAR(pG->U,k+1,j+1,i,M2) + UVAR(pG->U,k+1,j+1,i+1,M2);
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,M3) + UVAR(pG->U,k+1,j,i+1,M3) +
+                       UVAR(pG->U,k+1,j+1,i,M3) + UVAR(pG->U,k+1,j+1,i+1,M3);
 #ifndef BAROTROPIC
-          *(pSnd++) += pG->U[k+1][j  ][i].E  + pG->U[k+1][j  ][i+1].E +
-                       pG->U[k+1][j+1][i].E  + pG->U[k+1][j+1][i+1].E;
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,E)  + UVAR(pG->U,k+1,j,i+1,E) +
+                       UVAR(pG->U,k+1,j+1,i,E)  + UVAR(pG->U,k+1,j+1,i+1,E);
 #endif
 #ifdef MHD
-          *(pSnd++) += pG->U[k+1][j  ][i].B1c + pG->U[k+1][j  ][i+1].B1c +
-                       pG->U[k+1][j+1][i].B1c + pG->U[k+1][j+1][i+1].B1c;
-          *(pSnd++) += pG->U[k+1][j  ][i].B2c + pG->U[k+1][j  ][i+1].B2c +
-                       pG->U[k+1][j+1][i].B2c + pG->U[k+1][j+1][i+1].B2c;
-          *(pSnd++) += pG->U[k+1][j  ][i].B3c + pG->U[k+1][j  ][i+1].B3c +
-                       pG->U[k+1][j+1][i].B3c + pG->U[k+1][j+1][i+1].B3c;
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,B1c) + UVAR(pG->U,k+1,j,i+1,B1c) +
+                       UVAR(pG->U,k+1,j+1,i,B1c) + UVAR(pG->U,k+1,j+1,i+1,B1c);
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,B2c) + UVAR(pG->U,k+1,j,i+1,B2c) +
+                       UVAR(pG->U,k+1,j+1,i,B2c) + UVAR(pG->U,k+1,j+1,i+1,B2c);
+          *(pSnd++) += UVAR(pG->U,k+1,j,i,B3c) + UVAR(pG->U,k+1,j,i+1,B3c) +
+                       UVAR(pG->U,k+1,j+1,i,B3c) + UVAR(pG->U,k+1,j+1,i+1,B3c);
 #endif
 #if (NSCALARS > 0)
           for (n=0; n<NSCALARS; n++) 
-            *(pSnd++) += pG->U[k+1][j  ][i].s[n] + pG->U[k+1][j  ][i+1].s[n] +
-                         pG->U[k+1][j+1][i].s[n] + pG->U[k+1][j+1][i+1].s[n];
+            *(pSnd++) += UVAR(pG->U,k+1,j,i,s[n]) + UVAR(pG->U,k+1,j,i+1,s[n]) +
+                         UVAR(pG->U,k+1,j+1,i,s[n]) + UVAR(pG->U,k+1,j+1,i+1,s[n]);
 #endif
         }}}
         fact = 0.125;
@@ -1344,7 +1346,9 @@ printf("cnt = %i\n", cnt);
 
       if (pG->NPGrid > pG->NmyPGrid) {
         mCount = pG->NPGrid - pG->NmyPGrid -nZeroRC;
+        ath_trace_begin("RestCorr_waitsend");
         ierr = MPI_Waitall(mCount, send_rq[nd], MPI_STATUS_IGNORE);
+        ath_trace_end("RestCorr_waitsend");
       }
     }
   }
@@ -1487,24 +1491,24 @@ void Prolongate(MeshS *pM)
           for (k=kcs; k<=kce; k++) {
           for (j=jcs; j<=jce; j++) {
           for (i=ics; i<=ice; i++) {
-            *(pSnd++) = pG->U[k][j][i].d;
-            *(pSnd++) = pG->U[k][j][i].M1;
-            *(pSnd++) = pG->U[k][j][i].M2;
-            *(pSnd++) = pG->U[k][j][i].M3;
+            *(pSnd++) = UVAR(pG->U,k,j,i,d);
+            *(pSnd++) = UVAR(pG->U,k,j,i,M1);
+            *(pSnd++) = UVAR(pG->U,k,j,i,M2);
+            *(pSnd++) = UVAR(pG->U,k,j,i,M3);
 #ifndef BAROTROPIC
-            *(pSnd++) = pG->U[k][j][i].E;
+            *(pSnd++) = UVAR(pG->U,k,j,i,E);
 #endif
 #ifdef MHD
-            *(pSnd++) = pG->U[k][j][i].B1c;
-            *(pSnd++) = pG->U[k][j][i].B2c;
-            *(pSnd++) = pG->U[k][j][i].B3c;
+            *(pSnd++) = UVAR(pG->U,k,j,i,B1c);
+            *(pSnd++) = UVAR(pG->U,k,j,i,B2c);
+            *(pSnd++) = UVAR(pG->U,k,j,i,B3c);
             *(pSnd++) = pG->B1i[k][j][i];
             *(pSnd++) = pG->B2i[k][j][i];
             *(pSnd++) = pG->B3i[k][j][i];
 #endif
 #if (NSCALARS > 0)
             for (ns=0; ns<NSCALARS; ns++) {
-               *(pSnd++) = pG->U[k][j][i].s[ns];
+               *(pSnd++) = UVAR(pG->U,k,j,i,s[ns]);
             }
 #endif
           }}}
@@ -1557,7 +1561,9 @@ void Prolongate(MeshS *pM)
  * Grids, sent in Step 1.  Accept messages in any order. */
 
         mCount = pG->NPGrid - pG->NmyPGrid - nZeroP;
+        ath_trace_begin("Prolong_wait");
         ierr = MPI_Waitany(mCount,recv_rq[nl][nd],&mIndex,MPI_STATUS_IGNORE);
+        ath_trace_end("Prolong_wait");
         if(mIndex == MPI_UNDEFINED){
           ath_error("[Prolong]: Invalid request index nl=%i nd=%i\n",nl,nd);
         }
@@ -1730,21 +1736,21 @@ void Prolongate(MeshS *pM)
             for (n=0; n<=nend; n++) {
             for (m=0; m<=mend; m++) {
             for (l=0; l<=1; l++) {
-              pG->U[k+n][j+m][i+l].d  = ProlongedC[n][m][l].d;
-              pG->U[k+n][j+m][i+l].M1 = ProlongedC[n][m][l].M1;
-              pG->U[k+n][j+m][i+l].M2 = ProlongedC[n][m][l].M2;
-              pG->U[k+n][j+m][i+l].M3 = ProlongedC[n][m][l].M3;
+              UVAR(pG->U,k+n,j+m,i+l,d)  = ProlongedC[n][m][l].d;
+              UVAR(pG->U,k+n,j+m,i+l,M1) = ProlongedC[n][m][l].M1;
+              UVAR(pG->U,k+n,j+m,i+l,M2) = ProlongedC[n][m][l].M2;
+              UVAR(pG->U,k+n,j+m,i+l,M3) = ProlongedC[n][m][l].M3;
 #ifndef BAROTROPIC
-              pG->U[k+n][j+m][i+l].E  = ProlongedC[n][m][l].E;
+              UVAR(pG->U,k+n,j+m,i+l,E)  = ProlongedC[n][m][l].E;
 #endif
 #ifdef MHD
-              pG->U[k+n][j+m][i+l].B1c = ProlongedC[n][m][l].B1c;
-              pG->U[k+n][j+m][i+l].B2c = ProlongedC[n][m][l].B2c;
-              pG->U[k+n][j+m][i+l].B3c = ProlongedC[n][m][l].B3c;
+              UVAR(pG->U,k+n,j+m,i+l,B1c) = ProlongedC[n][m][l].B1c;
+              UVAR(pG->U,k+n,j+m,i+l,B2c) = ProlongedC[n][m][l].B2c;
+              UVAR(pG->U,k+n,j+m,i+l,B3c) = ProlongedC[n][m][l].B3c;
 #endif
 #if (NSCALARS > 0)
               for (ns=0; ns<NSCALARS; ns++) 
-                pG->U[k+n][j+m][i+l].s[ns] = ProlongedC[n][m][l].s[ns];
+                UVAR(pG->U,k+n,j+m,i+l,s[ns]) = ProlongedC[n][m][l].s[ns];
 #endif
             }}}
 
@@ -1754,9 +1760,9 @@ void Prolongate(MeshS *pM)
 
             if (nDim == 1) {
               for (l=0; l<=1; l++) {
-                pG->B1i[k][j][i+l] = pG->U[k][j][i+l].B1c;
-                pG->B2i[k][j][i+l] = pG->U[k][j][i+l].B2c;
-                pG->B3i[k][j][i+l] = pG->U[k][j][i+l].B3c;
+                pG->B1i[k][j][i+l] = UVAR(pG->U,k,j,i+l,B1c);
+                pG->B2i[k][j][i+l] = UVAR(pG->U,k,j,i+l,B2c);
+                pG->B3i[k][j][i+l] = UVAR(pG->U,k,j,i+l,B3c);
               }
             } else {
               for (n=0; n<3; n++) {
@@ -1890,11 +1896,11 @@ void Prolongate(MeshS *pM)
                 if (dim != 5 || (k+n) != kps)
                   pG->B3i[k+n][j+m][i+l] = ProlongedF[n][m][l].x3;
 
-                pG->U[k+n][j+m][i+l].B1c = 
+                UVAR(pG->U,k+n,j+m,i+l,B1c) = 
                   0.5*(ProlongedF[n][m][l].x1 + ProlongedF[n][m][l+1].x1);
-                pG->U[k+n][j+m][i+l].B2c = 
+                UVAR(pG->U,k+n,j+m,i+l,B2c) = 
                   0.5*(ProlongedF[n][m][l].x2 + ProlongedF[n][m+1][l].x2);
-                pG->U[k+n][j+m][i+l].B3c = 
+                UVAR(pG->U,k+n,j+m,i+l,B3c) = 
                   0.5*(ProlongedF[n][m][l].x3 + ProlongedF[n+1][m][l].x3);
               }}}
             }
@@ -1943,7 +1949,9 @@ void Prolongate(MeshS *pM)
 
       if (pG->NCGrid > pG->NmyCGrid) {
         mCount = pG->NCGrid - pG->NmyCGrid - nZeroP;
+        ath_trace_begin("Prolong_waitsend");
         ierr = MPI_Waitall(mCount, send_rq[nd], MPI_STATUS_IGNORE);
+        ath_trace_end("Prolong_waitsend");
       }
     }
   }
@@ -14,6 +14,8 @@
  * - minmax1()        - fast Min/Max for a 1d array using registers
  * - minmax2()        - fast Min/Max for a 2d array using registers
  * - minmax3()        - fast Min/Max for a 3d array using registers
+ * - cons_gather()    - copies one cell of SoA conserved variables into ConsS
+ * - cons_scatter()   - copies a ConsS into one cell of SoA conserved variables
  *============================================================================*/
 
 #include <stdio.h>
@@ -196,6 +198,43 @@ void minmax3(Real ***data, int nx3, int nx2, int nx1, Real *dmino, Real *dmaxo)
   *dmaxo = dmax;
 }
 
+#ifdef CONS_SOA
+/*----------------------------------------------------------------------------*/
+/*! \fn ConsS cons_gather(const ConsArrS *pU, const int k, const int j,
+ *                        const int i)
+ *  \brief Returns the conserved variables of cell (k,j,i) as a ConsS, for
+ *   code that needs a whole cell (e.g. Cons_to_Prim()) when GridS.U is
+ *   stored as structure-of-arrays.
+ */
+ConsS cons_gather(const ConsArrS *pU, const int k, const int j, const int i)
+{
+  ConsS U;
+  Real *pC = (Real*)&U;
+  GReal ***const *pA = (GReal ***const *)pU;
+  int n;
+
+  for (n=0; n<NCONS; n++) pC[n] = pA[n][k][j][i];
+  return U;
+}
+
+/*----------------------------------------------------------------------------*/
+/*! \fn void cons_scatter(ConsArrS *pU, const int k, const int j,
+ *                        const int i, const ConsS U)
+ *  \brief Stores ConsS U into cell (k,j,i) of structure-of-arrays conserved
+ *   variables.
+ */
+void cons_scatter(ConsArrS *pU, const int k, const int j, const int i,
+                  const ConsS U)
+{
+  const Real *pC = (const Real*)&U;
+  GReal ****pA = (GReal****)pU;
+  int n;
+
+  for (n=0; n<NCONS; n++) pA[n][k][j][i] = pC[n];
+  return;
+}
+#endif /* CONS_SOA */
+
 /*----------------------------------------------------------------------------*/
 /*! \fn  void do_nothing_bc(GridS *pG)
  *
@@ -314,21 +353,21 @@ void compute_l1_error(const char *problem, const MeshS *pM,
 #endif
 
         /* Sum local L1 error for each grid cell I own */
-        error.d   += dVol*fabs(pG->U[k][j][i].d   - RootSoln[k][j][i].d );
-        error.M1  += dVol*fabs(pG->U[k][j][i].M1  - RootSoln[k][j][i].M1);
-        error.M2  += dVol*fabs(pG->U[k][j][i].M2  - RootSoln[k][j][i].M2);
-        error.M3  += dVol*fabs(pG->U[k][j][i].M3  - RootSoln[k][j][i].M3); 
+        error.d   += dVol*fabs(UVAR(pG->U,k,j,i,d)   - RootSoln[k][j][i].d );
+        error.M1  += dVol*fabs(UVAR(pG->U,k,j,i,M1)  - RootSoln[k][j][i].M1);
+        error.M2  += dVol*fabs(UVAR(pG->U,k,j,i,M2)  - RootSoln[k][j][i].M2);
+        error.M3  += dVol*fabs(UVAR(pG->U,k,j,i,M3)  - RootSoln[k][j][i].M3); 
 #ifdef MHD
-        error.B1c += dVol*fabs(pG->U[k][j][i].B1c - RootSoln[k][j][i].B1c);
-        error.B2c += dVol*fabs(pG->U[k][j][i].B2c - RootSoln[k][j][i].B2c);
-        error.B3c += dVol*fabs(pG->U[k][j][i].B3c - RootSoln[k][j][i].B3c);
+        error.B1c += dVol*fabs(UVAR(pG->U,k,j,i,B1c) - RootSoln[k][j][i].B1c);
+        error.B2c += dVol*fabs(UVAR(pG->U,k,j,i,B2c) - RootSoln[k][j][i].B2c);
+        error.B3c += dVol*fabs(UVAR(pG->U,k,j,i,B3c) - RootSoln[k][j][i].B3c);
 #endif /* MHD */
 #ifndef ISOTHERMAL
-        error.E   += dVol*fabs(pG->U[k][j][i].E   - RootSoln[k][j][i].E );
+        error.E   += dVol*fabs(UVAR(pG->U,k,j,i,E)   - RootSoln[k][j][i].E );
 #endif /* ISOTHERMAL */
 #if (NSCALARS > 0)
         for (n=0; n<NSCALARS; n++)
-          error.s[n] += dVol*fabs(pG->U[k][j][i].s[n] - RootSoln[k][j][i].s[n]);;
+          error.s[n] += dVol*fabs(UVAR(pG->U,k,j,i,s[n]) - RootSoln[k][j][i].s[n]);;
 #endif
       }
 